@@ -2576,6 +2576,13 @@ void LIR_Assembler::emit_lock(LIR_OpLock* op) {
   Register lock = op->lock_opr()->as_register();
   if (!UseFastLocking) {
     __ b(*op->stub()->entry());
+  } else if (UseLightweightLocking) {
+    // Lightweight locking is done by the runtime.
+    if (op->code() == lir_lock && op->info() != NULL) {
+      add_debug_info_for_null_check_here(op->info());
+      __ null_check(obj);
+    }
+    __ b(*op->stub()->entry());
   } else if (op->code() == lir_lock) {
     assert(BasicLock::displaced_header_offset_in_bytes() == 0, "lock_reg must point to the displaced header");
     // add debug info for NullPointerException only if one is possible
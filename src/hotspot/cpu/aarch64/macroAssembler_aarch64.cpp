@@ -47,6 +47,7 @@
 #include "runtime/icache.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/jniHandles.inline.hpp"
+#include "runtime/lockStack.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/thread.hpp"
@@ -308,6 +309,89 @@ void MacroAssembler::safepoint_poll(Label& slow_path, bool at_return, bool acqui
   }
 }
 
+void MacroAssembler::lightweight_lock(Register obj, Register hdr, Register t1, Register t2, Label& slow) {
+  assert(UseLightweightLocking, "must be");
+  assert_different_registers(obj, hdr, t1, t2, rscratch1);
+
+  Label not_recursive, push;
+  const Address top(rthread, JavaThread::lock_stack_top_offset());
+  const int base_offset = in_bytes(JavaThread::lock_stack_base_offset());
+
+  // Check if there is room on the lock stack.
+  ldrw(t1, top);
+  cmpw(t1, (unsigned)LockStack::CAPACITY);
+  br(Assembler::GE, slow);
+
+  // A recursive enter if obj is the innermost entry. Entries further down
+  // are left to the runtime.
+  lea(t2, Address(rthread, t1, Address::uxtw(LogBytesPerWord)));
+  cbzw(t1, not_recursive);
+  ldr(rscratch1, Address(t2, base_offset - wordSize));
+  cmp(obj, rscratch1);
+  br(Assembler::EQ, push);
+  bind(not_recursive);
+
+  // Swing the lock bits from unlocked (01) to fast-locked (00).
+  assert(oopDesc::mark_offset_in_bytes() == 0, "offset of _mark is not 0");
+  orr(hdr, hdr, markWord::unlocked_value);
+  eor(t2, hdr, markWord::unlocked_value);
+  cmpxchg(obj, hdr, t2, Assembler::xword, /*acquire*/ true,
+          /*release*/ true, /*weak*/ false, noreg);
+  br(Assembler::NE, slow);
+  lea(t2, Address(rthread, t1, Address::uxtw(LogBytesPerWord)));
+
+  bind(push);
+  str(obj, Address(t2, base_offset));
+  addw(t1, t1, 1);
+  strw(t1, top);
+}
+
+void MacroAssembler::lightweight_unlock(Register obj, Register hdr, Register t1, Register t2, Label& slow) {
+  assert(UseLightweightLocking, "must be");
+  assert_different_registers(obj, hdr, t1, t2, rscratch1);
+
+  Label loop, not_recursive, pop;
+  const Address top(rthread, JavaThread::lock_stack_top_offset());
+  const int base_offset = in_bytes(JavaThread::lock_stack_base_offset());
+
+  // Only the innermost entry is popped here; unlocking out of order is
+  // left to the runtime.
+  ldrw(t1, top);
+  cbzw(t1, slow);
+  lea(t2, Address(rthread, t1, Address::uxtw(LogBytesPerWord)));
+  ldr(hdr, Address(t2, base_offset - wordSize));
+  cmp(obj, hdr);
+  br(Assembler::NE, slow);
+
+  // Another entry for obj further down makes this a recursive exit.
+  bind(loop);
+  subw(t1, t1, 1);
+  cbzw(t1, not_recursive);
+  sub(t2, t2, wordSize);
+  ldr(hdr, Address(t2, base_offset - wordSize));
+  cmp(obj, hdr);
+  br(Assembler::EQ, pop);
+  b(loop);
+  bind(not_recursive);
+
+  // Swing the lock bits from fast-locked (00) back to unlocked (01). This
+  // fails if another thread has inflated the lock in the meantime, in which
+  // case the entry has to stay for the runtime to hand over the monitor.
+  assert(oopDesc::mark_offset_in_bytes() == 0, "offset of _mark is not 0");
+  ldr(hdr, Address(obj, oopDesc::mark_offset_in_bytes()));
+  tst(hdr, markWord::lock_mask_in_place);
+  br(Assembler::NE, slow);
+  orr(t2, hdr, markWord::unlocked_value);
+  cmpxchg(obj, hdr, t2, Assembler::xword, /*acquire*/ false,
+          /*release*/ true, /*weak*/ false, noreg);
+  br(Assembler::NE, slow);
+
+  bind(pop);
+  ldrw(t1, top);
+  subw(t1, t1, 1);
+  strw(t1, top);
+}
+
 void MacroAssembler::reset_last_Java_frame(bool clear_fp) {
   // we must set sp to zero to clear frame
   str(zr, Address(rthread, JavaThread::last_Java_sp_offset()));
@@ -105,6 +105,13 @@ class MacroAssembler: public Assembler {
 
   void safepoint_poll(Label& slow_path, bool at_return, bool acquire, bool in_nmethod);
 
+  // Lightweight locking fast paths, see ObjectSynchronizer::fast_lock()
+  // and fast_unlock(). lightweight_lock() expects hdr to hold the mark word
+  // of obj. Both branch to slow when the runtime has to take over, e.g. when
+  // the lock stack is full or obj has been inflated. Clobber rscratch1.
+  void lightweight_lock(Register obj, Register hdr, Register t1, Register t2, Label& slow);
+  void lightweight_unlock(Register obj, Register hdr, Register t1, Register t2, Label& slow);
+
   // Helper functions for statistics gathering.
   // Unconditional atomic increment.
   void atomic_incw(Register counter_addr, Register tmp, Register tmp2);
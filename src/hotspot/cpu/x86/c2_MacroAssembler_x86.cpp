@@ -493,23 +493,44 @@ void C2_MacroAssembler::fast_lock(Register objReg, Register boxReg, Register tmp
 
   movptr(tmpReg, Address(objReg, oopDesc::mark_offset_in_bytes()));          // [FETCH]
   testptr(tmpReg, markWord::monitor_value); // inflated vs stack-locked|neutral
-  jccb(Assembler::notZero, IsInflated);
+  if (UseLightweightLocking) {
+#ifdef _LP64
+    Label slow;
+    jcc(Assembler::notZero, IsInflated);
+
+    // The box is not used, keep it looking inflated to any code that
+    // inspects it, e.g. BasicLock::move_to().
+    // Without cast to int32_t this style of movptr will destroy r10 which is typically obj.
+    movptr(Address(boxReg, 0), (int32_t)intptr_t(markWord::unused_mark().value()));
+    lightweight_lock(objReg, tmpReg, r15_thread, scrReg, slow);
+    xorptr(tmpReg, tmpReg);                      // Set ZF = 1 (success)
+    jmp(DONE_LABEL);
+
+    bind(slow);
+    testptr(objReg, objReg);                     // Set ZF = 0 (failure), objReg is non-null
+    jmp(DONE_LABEL);
+#else
+    ShouldNotReachHere(); // See Arguments::check_vm_args_consistency()
+#endif
+  } else {
+    jccb(Assembler::notZero, IsInflated);
 
-  // Attempt stack-locking ...
-  orptr (tmpReg, markWord::unlocked_value);
-  movptr(Address(boxReg, 0), tmpReg);          // Anticipate successful CAS
-  lock();
-  cmpxchgptr(boxReg, Address(objReg, oopDesc::mark_offset_in_bytes()));      // Updates tmpReg
-  jcc(Assembler::equal, DONE_LABEL);           // Success
-
-  // Recursive locking.
-  // The object is stack-locked: markword contains stack pointer to BasicLock.
-  // Locked by current thread if difference with current SP is less than one page.
-  subptr(tmpReg, rsp);
-  // Next instruction set ZFlag == 1 (Success) if difference is less then one page.
-  andptr(tmpReg, (int32_t) (NOT_LP64(0xFFFFF003) LP64_ONLY(7 - os::vm_page_size())) );
-  movptr(Address(boxReg, 0), tmpReg);
-  jmp(DONE_LABEL);
+    // Attempt stack-locking ...
+    orptr (tmpReg, markWord::unlocked_value);
+    movptr(Address(boxReg, 0), tmpReg);          // Anticipate successful CAS
+    lock();
+    cmpxchgptr(boxReg, Address(objReg, oopDesc::mark_offset_in_bytes()));      // Updates tmpReg
+    jcc(Assembler::equal, DONE_LABEL);           // Success
+
+    // Recursive locking.
+    // The object is stack-locked: markword contains stack pointer to BasicLock.
+    // Locked by current thread if difference with current SP is less than one page.
+    subptr(tmpReg, rsp);
+    // Next instruction set ZFlag == 1 (Success) if difference is less then one page.
+    andptr(tmpReg, (int32_t) (NOT_LP64(0xFFFFF003) LP64_ONLY(7 - os::vm_page_size())) );
+    movptr(Address(boxReg, 0), tmpReg);
+    jmp(DONE_LABEL);
+  }
 
   bind(IsInflated);
   // The object is inflated. tmpReg contains pointer to ObjectMonitor* + markWord::monitor_value
@@ -644,11 +665,38 @@ void C2_MacroAssembler::fast_unlock(Register objReg, Register boxReg, Register t
   }
 #endif
 
-  cmpptr(Address(boxReg, 0), (int32_t)NULL_WORD);                   // Examine the displaced header
-  jcc   (Assembler::zero, DONE_LABEL);                              // 0 indicates recursive stack-lock
-  movptr(tmpReg, Address(objReg, oopDesc::mark_offset_in_bytes())); // Examine the object's markword
-  testptr(tmpReg, markWord::monitor_value);                         // Inflated?
-  jccb  (Assembler::zero, Stacked);
+  if (UseLightweightLocking) {
+#ifdef _LP64
+    Label IsInflated, slow;
+    movptr(tmpReg, Address(objReg, oopDesc::mark_offset_in_bytes())); // Examine the object's markword
+    testptr(tmpReg, markWord::monitor_value);                         // Inflated?
+    jcc   (Assembler::notZero, IsInflated);
+
+    // The lock stack and the markword record the lock, the box is not used.
+    lightweight_unlock(objReg, boxReg, r15_thread, tmpReg, slow);
+    xorptr(boxReg, boxReg);                                           // Set ZF = 1 (success)
+    jmp   (DONE_LABEL);
+
+    bind  (slow);
+    testptr(objReg, objReg);                                          // Set ZF = 0 (failure), objReg is non-null
+    jmp   (DONE_LABEL);
+
+    bind  (IsInflated);
+    // A monitor inflated over a lightweight lock is owned anonymously
+    // until the runtime hands it to the locking thread, so unlike stack
+    // locking this cannot elide the m->owner == Self check.
+    cmpptr(r15_thread, Address(tmpReg, OM_OFFSET_NO_MONITOR_VALUE_TAG(owner)));
+    jcc   (Assembler::notEqual, DONE_LABEL);
+#else
+    ShouldNotReachHere(); // See Arguments::check_vm_args_consistency()
+#endif
+  } else {
+    cmpptr(Address(boxReg, 0), (int32_t)NULL_WORD);                   // Examine the displaced header
+    jcc   (Assembler::zero, DONE_LABEL);                              // 0 indicates recursive stack-lock
+    movptr(tmpReg, Address(objReg, oopDesc::mark_offset_in_bytes())); // Examine the object's markword
+    testptr(tmpReg, markWord::monitor_value);                         // Inflated?
+    jccb  (Assembler::zero, Stacked);
+  }
 
   // It's inflated.
 #if INCLUDE_RTM_OPT
@@ -2810,6 +2858,130 @@ void C2_MacroAssembler::string_indexof(Register str1, Register str2,
 
 } // string_indexof
 
+// Latin1 substring search with AVX2: compare the first and the last
+// bytes of the substring at 32 consecutive positions of the string at
+// a time and only check the whole substring at the positions where
+// both match. Strings with less than 32 possible positions use the
+// pcmpestri based string_indexof().
+void C2_MacroAssembler::string_indexof_avx2(Register str1, Register str2,
+                                            Register cnt1, Register cnt2, Register result,
+                                            XMMRegister vec1, XMMRegister vec2,
+                                            XMMRegister vec3, XMMRegister vec4,
+                                            Register tmp, Register tmp2, Register tmp3, Register tmp4) {
+  assert(UseAVX >= 2, "AVX2 intrinsics are required");
+  //
+  // Note, inline_string_indexOf() generates checks:
+  // if (substr.count > string.count) return -1;
+  // if (substr.count == 0) return 0;
+  //
+  // Register usage:
+  //   cnt1   - number of positions where the substring may start
+  //   result - first of the 32 positions being scanned
+  //   tmp    - positions where the first and the last bytes match
+  //   tmp2   - address of the last substring byte for position 0
+  //   tmp3   - address of the candidate match
+  //   tmp4   - offset of the substring bytes being compared
+  //   vec1   - first substring byte broadcast
+  //   vec2   - last substring byte broadcast
+  //   vec4   - positions left to check while a candidate is verified
+  //
+  int stride = 32;
+  Label SCAN_LOOP, NEXT_BLOCK, CANDIDATE_LOOP, VERIFY_VEC, VERIFY_TAIL, VERIFY_BYTE,
+        NEXT_CANDIDATE, RET_FOUND, RET_NOT_FOUND, SHORT_STRING, DONE;
+
+  subl(cnt1, cnt2);
+  incrementl(cnt1);
+  cmpl(cnt1, stride);
+  jcc(Assembler::less, SHORT_STRING);
+
+  load_unsigned_byte(tmp, Address(str2, 0));
+  movdl(vec1, tmp);
+  vpbroadcastb(vec1, vec1, Assembler::AVX_256bit);
+  load_unsigned_byte(tmp, Address(str2, cnt2, Address::times_1, -1));
+  movdl(vec2, tmp);
+  vpbroadcastb(vec2, vec2, Assembler::AVX_256bit);
+  lea(tmp2, Address(str1, cnt2, Address::times_1, -1));
+  xorl(result, result);
+
+  bind(SCAN_LOOP);
+  // result + stride <= cnt1: all loads are within the string
+  vmovdqu(vec3, Address(str1, result, Address::times_1));
+  vpcmpeqb(vec3, vec3, vec1, Assembler::AVX_256bit);
+  vmovdqu(vec4, Address(tmp2, result, Address::times_1));
+  vpcmpeqb(vec4, vec4, vec2, Assembler::AVX_256bit);
+  vpand(vec3, vec3, vec4, Assembler::AVX_256bit);
+  vpmovmskb(tmp, vec3, Assembler::AVX_256bit);
+  testl(tmp, tmp);
+  jcc(Assembler::notZero, CANDIDATE_LOOP);
+
+  bind(NEXT_BLOCK);
+  addl(result, stride);
+  lea(tmp3, Address(result, stride));
+  cmpl(tmp3, cnt1);
+  jcc(Assembler::lessEqual, SCAN_LOOP);
+  cmpl(result, cnt1);
+  jcc(Assembler::greaterEqual, RET_NOT_FOUND);
+  // Scan the last stride positions. The ones already scanned don't match.
+  movl(result, cnt1);
+  subl(result, stride);
+  jmp(SCAN_LOOP);
+
+  bind(CANDIDATE_LOOP);
+  bsfl(tmp3, tmp);
+  addl(tmp3, result);
+  lea(tmp3, Address(str1, tmp3, Address::times_1));
+  // Clear the candidate's bit and free tmp and tmp2 for the comparison
+  lea(tmp4, Address(tmp, -1));
+  andl(tmp, tmp4);
+  movdl(vec4, tmp);
+  movl(tmp4, 1);
+
+  bind(VERIFY_VEC);
+  addl(tmp4, stride);
+  cmpl(tmp4, cnt2);
+  jccb(Assembler::greater, VERIFY_TAIL);
+  vmovdqu(vec3, Address(str2, tmp4, Address::times_1, -stride));
+  vpxor(vec3, vec3, Address(tmp3, tmp4, Address::times_1, -stride), Assembler::AVX_256bit);
+  vptest(vec3, vec3, Assembler::AVX_256bit);
+  jccb(Assembler::notZero, NEXT_CANDIDATE);
+  jmpb(VERIFY_VEC);
+
+  bind(VERIFY_TAIL);
+  subl(tmp4, stride);
+  bind(VERIFY_BYTE);
+  cmpl(tmp4, cnt2);
+  jccb(Assembler::greaterEqual, RET_FOUND);
+  load_unsigned_byte(tmp, Address(str2, tmp4, Address::times_1));
+  load_unsigned_byte(tmp2, Address(tmp3, tmp4, Address::times_1));
+  cmpl(tmp, tmp2);
+  jccb(Assembler::notEqual, NEXT_CANDIDATE);
+  incrementl(tmp4);
+  jmpb(VERIFY_BYTE);
+
+  bind(NEXT_CANDIDATE);
+  lea(tmp2, Address(str1, cnt2, Address::times_1, -1));
+  movdl(tmp, vec4);
+  testl(tmp, tmp);
+  jcc(Assembler::notZero, CANDIDATE_LOOP);
+  jmp(NEXT_BLOCK);
+
+  bind(RET_FOUND);
+  movptr(result, tmp3);
+  subptr(result, str1);
+  jmp(DONE);
+
+  bind(RET_NOT_FOUND);
+  movl(result, -1);
+  jmp(DONE);
+
+  bind(SHORT_STRING);
+  addl(cnt1, cnt2);
+  decrementl(cnt1);
+  string_indexof(str1, str2, cnt1, cnt2, -1, result, vec1, tmp, StrIntrinsicNode::LL);
+
+  bind(DONE);
+} // string_indexof_avx2
+
 void C2_MacroAssembler::string_indexof_char(Register str1, Register cnt1, Register ch, Register result,
                                             XMMRegister vec1, XMMRegister vec2, XMMRegister vec3, Register tmp) {
   ShortBranchVerifier sbv(this);
@@ -242,6 +242,13 @@ public:
                       XMMRegister vec, Register tmp,
                       int ae);
 
+  // IndexOf Latin1 strings with AVX2 first and last byte filtering.
+  void string_indexof_avx2(Register str1, Register str2,
+                           Register cnt1, Register cnt2, Register result,
+                           XMMRegister vec1, XMMRegister vec2,
+                           XMMRegister vec3, XMMRegister vec4,
+                           Register tmp, Register tmp2, Register tmp3, Register tmp4);
+
   // IndexOf for constant substrings with size >= 8 elements
   // which don't need to be loaded through stack.
   void string_indexofC8(Register str1, Register str2,
@@ -215,6 +215,12 @@ define_pd_global(intx, InitArrayShortSize, 8*BytesPerLong);
              range(0, max_jint)                                             \
              constraint(AVX3ThresholdConstraintFunc,AfterErgo)              \
                                                                             \
+  product(intx, ArrayCopyNonTemporalThreshold, -1, DIAGNOSTIC,              \
+             "Minimum size in bytes of an AVX512 array copy or fill to use "\
+             "non-temporal stores. 0 disables non-temporal stores, -1 "     \
+             "derives the threshold from the last level cache size")        \
+             range(-1, max_jint)                                            \
+                                                                            \
   product(bool, IntelJccErratumMitigation, true, DIAGNOSTIC,                \
              "Turn off JVM mitigations related to Intel micro code "        \
              "mitigations for the Intel JCC erratum")
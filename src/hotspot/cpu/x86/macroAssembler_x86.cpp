@@ -43,6 +43,7 @@
 #include "runtime/flags/flagSetting.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/jniHandles.hpp"
+#include "runtime/lockStack.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/os.hpp"
 #include "runtime/safepoint.hpp"
@@ -2823,6 +2824,84 @@ void MacroAssembler::safepoint_poll(Label& slow_path, Register thread_reg, bool
   jcc(Assembler::notZero, slow_path); // handshake bit set implies poll
 }
 
+void MacroAssembler::lightweight_lock(Register obj, Register hdr, Register thread, Register tmp, Label& slow) {
+  assert(UseLightweightLocking, "must be");
+  assert(hdr == rax, "header must be in rax for cmpxchg");
+  assert_different_registers(obj, hdr, thread, tmp);
+
+  Label not_recursive, push;
+  const Address top(thread, JavaThread::lock_stack_top_offset());
+  const int base_offset = in_bytes(JavaThread::lock_stack_base_offset());
+
+  // Check if there is room on the lock stack.
+  movl(tmp, top);
+  cmpl(tmp, LockStack::CAPACITY);
+  jcc(Assembler::greaterEqual, slow);
+
+  // A recursive enter if obj is the innermost entry. Entries further down
+  // are left to the runtime.
+  testl(tmp, tmp);
+  jccb(Assembler::zero, not_recursive);
+  cmpptr(obj, Address(thread, tmp, Address::times_ptr, base_offset - oopSize));
+  jccb(Assembler::equal, push);
+  bind(not_recursive);
+
+  // Swing the lock bits from unlocked (01) to fast-locked (00).
+  orptr(hdr, markWord::unlocked_value);
+  movptr(tmp, hdr);
+  andptr(tmp, ~(int32_t)markWord::lock_mask_in_place);
+  lock();
+  cmpxchgptr(tmp, Address(obj, oopDesc::mark_offset_in_bytes()));
+  jcc(Assembler::notEqual, slow);
+  movl(tmp, top);
+
+  bind(push);
+  movptr(Address(thread, tmp, Address::times_ptr, base_offset), obj);
+  incrementl(top);
+}
+
+void MacroAssembler::lightweight_unlock(Register obj, Register hdr, Register thread, Register tmp, Label& slow) {
+  assert(UseLightweightLocking, "must be");
+  assert(hdr == rax, "header must be in rax for cmpxchg");
+  assert_different_registers(obj, hdr, thread, tmp);
+
+  Label loop, not_recursive, pop;
+  const Address top(thread, JavaThread::lock_stack_top_offset());
+  const int base_offset = in_bytes(JavaThread::lock_stack_base_offset());
+
+  // Only the innermost entry is popped here; unlocking out of order is
+  // left to the runtime.
+  movl(tmp, top);
+  testl(tmp, tmp);
+  jcc(Assembler::zero, slow);
+  cmpptr(obj, Address(thread, tmp, Address::times_ptr, base_offset - oopSize));
+  jcc(Assembler::notEqual, slow);
+
+  // Another entry for obj further down makes this a recursive exit.
+  bind(loop);
+  decrementl(tmp);
+  jccb(Assembler::zero, not_recursive);
+  cmpptr(obj, Address(thread, tmp, Address::times_ptr, base_offset - oopSize));
+  jccb(Assembler::equal, pop);
+  jmpb(loop);
+  bind(not_recursive);
+
+  // Swing the lock bits from fast-locked (00) back to unlocked (01). This
+  // fails if another thread has inflated the lock in the meantime, in which
+  // case the entry has to stay for the runtime to hand over the monitor.
+  movptr(hdr, Address(obj, oopDesc::mark_offset_in_bytes()));
+  testptr(hdr, markWord::lock_mask_in_place);
+  jcc(Assembler::notZero, slow);
+  movptr(tmp, hdr);
+  orptr(tmp, markWord::unlocked_value);
+  lock();
+  cmpxchgptr(tmp, Address(obj, oopDesc::mark_offset_in_bytes()));
+  jcc(Assembler::notEqual, slow);
+
+  bind(pop);
+  decrementl(top);
+}
+
 // Calls to C land
 //
 // When entering C land, the rbp, & rsp of the last Java frame have to be recorded
@@ -3644,6 +3723,32 @@ void MacroAssembler::lookup_interface_method(Register recv_klass,
   Address::ScaleFactor times_vte_scale = Address::times_ptr;
   assert(vte_size == wordSize, "else adjust times_vte_scale");
 
+  Label search, found_method;
+
+  if (UseItableSelectorTable) {
+    // Probe the selector table first, if the receiver klass has one.
+    // Misses, including slots taken by a colliding interface, fall back
+    // to the linear scan.
+    Label L_scan;
+    cmpl(Address(recv_klass, Klass::itable_selector_base_offset()), 0);
+    jcc(Assembler::equal, L_scan);
+    movl(scan_temp, Address(intf_klass, Klass::itable_selector_offset()));
+    andl(scan_temp, Address(recv_klass, Klass::itable_selector_mask_offset()));
+    addl(scan_temp, Address(recv_klass, Klass::itable_selector_base_offset()));
+    movl(scan_temp, Address(recv_klass, scan_temp, Address::times_4));
+    testl(scan_temp, scan_temp);
+    jcc(Assembler::zero, L_scan);
+    cmpptr(intf_klass, Address(recv_klass, scan_temp, Address::times_1, itableOffsetEntry::interface_offset_in_bytes()));
+    jcc(Assembler::notEqual, L_scan);
+    lea(scan_temp, Address(recv_klass, scan_temp, Address::times_1));
+    if (return_method) {
+      assert(itableMethodEntry::size() * wordSize == wordSize, "adjust the scaling in the code below");
+      lea(recv_klass, Address(recv_klass, itable_index, Address::times_ptr, itentry_off));
+    }
+    jmp(found_method);
+    bind(L_scan);
+  }
+
   movl(scan_temp, Address(recv_klass, Klass::vtable_length_offset()));
 
   // %%% Could store the aligned, prescaled offset in the klassoop.
@@ -3660,7 +3765,6 @@ void MacroAssembler::lookup_interface_method(Register recv_klass,
   //     result = (klass + scan->offset() + itable_index);
   //   }
   // }
-  Label search, found_method;
 
   for (int peel = 1; peel >= 0; peel--) {
     movptr(method_result, Address(scan_temp, itableOffsetEntry::interface_offset_in_bytes()));
@@ -3853,6 +3957,8 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
 
   assert(sub_klass != rax, "killed reg"); // killed by mov(rax, super)
   assert(sub_klass != rcx, "killed reg"); // killed by lea(rcx, &pst_counter)
+  // sub_klass may be rdi (rlocals of the 32-bit interpreter). It is last
+  // read when rdi is loaded with the secondary supers.
 
   // Get super_klass value into rax (even if it was in rdi or rcx).
   bool pushed_rax = false, pushed_rcx = false, pushed_rdi = false;
@@ -3871,8 +3977,24 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   LP64_ONLY( incrementl(Address(rcx, 0)) );
 #endif //PRODUCT
 
-  // We will consult the secondary-super array.
-  movptr(rdi, secondary_supers_addr);
+  Label L_scan_done;
+  if (UseSecondarySupersBitmap) {
+    // Skip the scan if the hash bit of the super is not in the bitmap.
+    // rdi is still loaded, because the AD files expect it to be non-zero
+    // on failure; movptr leaves the condition codes alone.
+    Label L_scan;
+    movptr(rcx, Address(rax, Klass::hash_bit_offset()));
+    testptr(rcx, Address(sub_klass, Klass::secondary_supers_bitmap_offset()));
+    movptr(rdi, secondary_supers_addr);
+    jccb(Assembler::notZero, L_scan);
+    testptr(rax, rax); // Set Z = 0
+    jmpb(L_scan_done);
+    bind(L_scan);
+  } else {
+    // We will consult the secondary-super array.
+    movptr(rdi, secondary_supers_addr);
+  }
+
   // Load the array length.  (Positive movl does right thing on LP64.)
   movl(rcx, Address(rdi, Array<Klass*>::length_offset_in_bytes()));
   // Skip to start of data.
@@ -3887,6 +4009,8 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
     testptr(rax,rax); // Set Z = 0
     repne_scan();
 
+  bind(L_scan_done);
+
   // Unspill the temp. registers:
   if (pushed_rdi)  pop(rdi);
   if (pushed_rcx)  pop(rcx);
@@ -5301,10 +5425,43 @@ void MacroAssembler::generate_fill(BasicType t, bool aligned,
 
           // If number of bytes to fill < AVX3Threshold, perform fill using AVX2
           cmpl(count, AVX3Threshold);
-          jccb(Assembler::below, L_check_fill_64_bytes_avx2);
+          jcc(Assembler::below, L_check_fill_64_bytes_avx2);
 
           vpbroadcastd(xtmp, xtmp, Assembler::AVX_512bit);
 
+#ifdef _LP64
+          if (ArrayCopyNonTemporalThreshold > 0) {
+            // Stream fills that are large compared to the last level cache
+            // past it, the non-temporal stores need a 64 byte aligned destination.
+            Label L_fill_64_bytes_loop_nt, L_temporal;
+            // At least two vectors so that the aligning store stays in bounds
+            intx nt_bytes = MAX2(ArrayCopyNonTemporalThreshold, (intx)128);
+            cmpl(count, (int)((nt_bytes << shift) >> 2));
+            jccb(Assembler::below, L_temporal);
+            evmovdqul(Address(to, 0), xtmp, Assembler::AVX_512bit);
+            movl(rtmp, to);
+            negl(rtmp);
+            andl(rtmp, 63);             // bytes up to the next 64 byte boundary
+            addptr(to, rtmp);
+            shll(rtmp, shift);
+            shrl(rtmp, 2);              // in elements
+            subl(count, rtmp);
+
+            subl(count, 16 << shift);
+            align(16);
+
+            BIND(L_fill_64_bytes_loop_nt);
+            evmovntdq(Address(to, 0), xtmp, Assembler::AVX_512bit);
+            addptr(to, 64);
+            subl(count, 16 << shift);
+            jcc(Assembler::greaterEqual, L_fill_64_bytes_loop_nt);
+            sfence();
+            jmp(L_check_fill_32_bytes);
+
+            BIND(L_temporal);
+          }
+#endif // _LP64
+
           subl(count, 16 << shift);
           jccb(Assembler::less, L_check_fill_32_bytes);
           align(16);
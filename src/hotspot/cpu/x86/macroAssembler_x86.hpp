@@ -669,6 +669,13 @@ class MacroAssembler: public Assembler {
 
   void safepoint_poll(Label& slow_path, Register thread_reg, bool at_return, bool in_nmethod);
 
+  // Lightweight locking fast paths, see ObjectSynchronizer::fast_lock()
+  // and fast_unlock(). hdr must be rax; lightweight_lock() expects it to
+  // hold the mark word of obj. Both branch to slow when the runtime has to
+  // take over, e.g. when the lock stack is full or obj has been inflated.
+  void lightweight_lock(Register obj, Register hdr, Register thread, Register tmp, Label& slow);
+  void lightweight_unlock(Register obj, Register hdr, Register thread, Register tmp, Label& slow);
+
   void verify_tlab();
 
   Condition negate_condition(Condition cond);
@@ -1875,7 +1882,7 @@ public:
 
   void copy64_avx(Register dst, Register src, Register index, XMMRegister xmm,
                   bool conjoint, int shift = Address::times_1, int offset = 0,
-                  bool use64byteVector = false);
+                  bool use64byteVector = false, bool non_temporal = false);
 #endif // COMPILER2_OR_JVMCI
 
 #endif // _LP64
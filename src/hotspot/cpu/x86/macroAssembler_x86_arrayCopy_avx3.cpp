@@ -229,8 +229,10 @@ void MacroAssembler::copy32_avx(Register dst, Register src, Register index, XMMR
 
 
 void MacroAssembler::copy64_avx(Register dst, Register src, Register index, XMMRegister xmm,
-                                bool conjoint, int shift, int offset, bool use64byteVector) {
+                                bool conjoint, int shift, int offset, bool use64byteVector,
+                                bool non_temporal) {
   assert(MaxVectorSize == 64 || MaxVectorSize == 32, "vector length mismatch");
+  assert(!non_temporal || use64byteVector, "non-temporal copies need 64 byte vectors");
   if (!use64byteVector) {
     if (conjoint) {
       copy32_avx(dst, src, index, xmm, shift, offset+32);
@@ -242,7 +244,11 @@ void MacroAssembler::copy64_avx(Register dst, Register src, Register index, XMMR
   } else {
     Address::ScaleFactor scale = (Address::ScaleFactor)(shift);
     evmovdquq(xmm, Address(src, index, scale, offset), Assembler::AVX_512bit);
-    evmovdquq(Address(dst, index, scale, offset), xmm, Assembler::AVX_512bit);
+    if (non_temporal) {
+      evmovntdq(Address(dst, index, scale, offset), xmm, Assembler::AVX_512bit);
+    } else {
+      evmovdquq(Address(dst, index, scale, offset), xmm, Assembler::AVX_512bit);
+    }
   }
 }
 
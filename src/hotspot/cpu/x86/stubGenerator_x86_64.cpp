@@ -1549,6 +1549,26 @@ class StubGenerator: public StubCodeGenerator {
         __ BIND(L_main_pre_loop_64bytes);
         __ subq(temp1, loop_size[shift]);
 
+        Label L_main_loop_64bytes_done;
+        if (ArrayCopyNonTemporalThreshold > 0 && !is_oop) {
+          // Stream copies that are large compared to the last level cache
+          // past it. The destination is 64 byte aligned here.
+          Label L_main_loop_64bytes_nt, L_temporal;
+          __ cmpq(temp1, ArrayCopyNonTemporalThreshold >> shift);
+          __ jcc(Assembler::less, L_temporal);
+          __ align(32);
+          __ BIND(L_main_loop_64bytes_nt);
+             __ copy64_avx(to, from, temp4, xmm1, false, shift, 0 , true, true);
+             __ copy64_avx(to, from, temp4, xmm1, false, shift, 64, true, true);
+             __ copy64_avx(to, from, temp4, xmm1, false, shift, 128, true, true);
+             __ addptr(temp4, loop_size[shift]);
+             __ subq(temp1, loop_size[shift]);
+             __ jcc(Assembler::greater, L_main_loop_64bytes_nt);
+          __ sfence();
+          __ jmp(L_main_loop_64bytes_done);
+          __ BIND(L_temporal);
+        }
+
         // Main loop with aligned copy block size of 192 bytes at
         // 64 byte copy granularity.
         __ align(32);
@@ -1560,6 +1580,7 @@ class StubGenerator: public StubCodeGenerator {
            __ subq(temp1, loop_size[shift]);
            __ jcc(Assembler::greater, L_main_loop_64bytes);
 
+        __ BIND(L_main_loop_64bytes_done);
         __ addq(temp1, loop_size[shift]);
         // Zero length check.
         __ jcc(Assembler::lessEqual, L_exit);
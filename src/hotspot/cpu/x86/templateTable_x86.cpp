@@ -1720,6 +1720,15 @@ void TemplateTable::iinc() {
   __ addl(iaddress(rbx), rdx);
 }
 
+// iinc followed by goto (see Rewriter::scan_method)
+void TemplateTable::fast_iinc_goto() {
+  transition(vtos, vtos);
+  iinc();
+  // continue with the goto
+  __ addptr(rbcp, Bytecodes::length_for(Bytecodes::_iinc));
+  branch(false, false);
+}
+
 void TemplateTable::wide_iinc() {
   transition(vtos, vtos);
   __ movl(rdx, at_bcp(4)); // get constant
@@ -3779,6 +3788,36 @@ void TemplateTable::invokeinterface(int byte_no) {
 
   Label no_such_method;
 
+#ifdef _LP64
+  if (UseInterpreterInterfaceCache) {
+    // Monomorphic inline cache: if the receiver klass matches the one
+    // recorded for this call site, dispatch through the cached itable slot.
+    Label ic_miss;
+    __ get_cache_index_at_bcp(rlocals, 1, sizeof(u2));
+    __ movptr(rbcp, Address(rbp, frame::interpreter_frame_cache_offset * wordSize));
+    __ movptr(rbcp, Address(rbcp, ConstantPoolCache::interface_ics_offset_in_bytes()));
+    __ testptr(rbcp, rbcp);
+    __ jcc(Assembler::zero, ic_miss);
+    __ movq(rbcp, Address(rbcp, rlocals, Address::times_8));
+    __ cmpl(rbcp, Address(rcx, oopDesc::klass_offset_in_bytes()));
+    __ jcc(Assembler::notEqual, ic_miss);
+    __ shrq(rbcp, BitsPerInt);
+    __ movptr(rlocals, Address(rdx, rbcp, Address::times_1));
+    // An empty slot throws AbstractMethodError from the full lookup below
+    __ testptr(rlocals, rlocals);
+    __ jcc(Assembler::zero, ic_miss);
+    __ mov(rbx, rlocals);
+
+    __ restore_bcp();
+    __ profile_virtual_call(rdx, rbcp, rlocals);
+    __ profile_arguments_type(rdx, rbx, rbcp, true);
+    __ jump_from_interpreted(rbx, rdx);
+    __ should_not_reach_here();
+
+    __ bind(ic_miss);
+  }
+#endif // _LP64
+
   // Preserve method for throw_AbstractMethodErrorVerbose.
   __ mov(rcx, rbx);
   // Receiver subtype check against REFC.
@@ -3817,6 +3856,30 @@ void TemplateTable::invokeinterface(int byte_no) {
   __ testptr(rbx, rbx);
   __ jcc(Assembler::zero, no_such_method);
 
+#ifdef _LP64
+  if (UseInterpreterInterfaceCache) {
+    // Record the receiver klass and the offset of the selected itable
+    // method slot from it. rlocals holds recvKlass plus the scaled itable
+    // index and rbcp the offset of the itable method block.
+    Label no_ics;
+    __ subptr(rlocals, rdx);
+    __ addptr(rlocals, rbcp);
+    __ shlq(rlocals, BitsPerInt);
+    __ mov(rax, rdx);
+    __ encode_klass_not_null(rax, rscratch1);
+    __ orq(rlocals, rax);
+
+    __ restore_bcp();
+    __ get_cache_index_at_bcp(rax, 1, sizeof(u2));
+    __ movptr(rcx, Address(rbp, frame::interpreter_frame_cache_offset * wordSize));
+    __ movptr(rcx, Address(rcx, ConstantPoolCache::interface_ics_offset_in_bytes()));
+    __ testptr(rcx, rcx);
+    __ jcc(Assembler::zero, no_ics);
+    __ movq(Address(rcx, rax, Address::times_8), rlocals);
+    __ bind(no_ics);
+  }
+#endif // _LP64
+
   __ profile_arguments_type(rdx, rbx, rbcp, true);
 
   // do the call
@@ -211,7 +211,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ bind(std_cpuid4);
     __ movl(rax, 4);
     __ cmpl(rax, Address(rbp, in_bytes(VM_Version::std_cpuid0_offset()))); // Is cpuid(0x4) supported?
-    __ jccb(Assembler::greater, std_cpuid1);
+    __ jcc(Assembler::greater, std_cpuid1);
 
     __ xorl(rcx, rcx);   // L1 cache
     __ cpuid();
@@ -219,7 +219,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ andl(rax, 0x1f);  // Determine if valid cache parameters used
     __ orl(rax, rax);    // eax[4:0] == 0 indicates invalid cache
     __ pop(rax);
-    __ jccb(Assembler::equal, std_cpuid1);
+    __ jcc(Assembler::equal, std_cpuid1);
 
     __ lea(rsi, Address(rbp, in_bytes(VM_Version::dcp_cpuid4_offset())));
     __ movl(Address(rsi, 0), rax);
@@ -227,6 +227,25 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ movl(Address(rsi, 8), rcx);
     __ movl(Address(rsi,12), rdx);
 
+    // Walk the cache levels and keep the parameters of the last valid one
+    Label llc_loop, llc_done;
+    __ movl(rsi, -1);
+    __ bind(llc_loop);
+    __ incrementl(rsi);
+    __ cmpl(rsi, 8);
+    __ jccb(Assembler::equal, llc_done);
+    __ movl(rax, 4);
+    __ movl(rcx, rsi);
+    __ cpuid();
+    __ testl(rax, 0x1f); // eax[4:0] == 0 indicates no more caches
+    __ jccb(Assembler::zero, llc_done);
+    __ movl(Address(rbp, in_bytes(VM_Version::llc_cpuid4_offset()) + 0), rax);
+    __ movl(Address(rbp, in_bytes(VM_Version::llc_cpuid4_offset()) + 4), rbx);
+    __ movl(Address(rbp, in_bytes(VM_Version::llc_cpuid4_offset()) + 8), rcx);
+    __ movl(Address(rbp, in_bytes(VM_Version::llc_cpuid4_offset()) + 12), rdx);
+    __ jmpb(llc_loop);
+    __ bind(llc_done);
+
     //
     // Standard cpuid(0x1)
     //
@@ -1017,6 +1036,10 @@ void VM_Version::get_processor_features() {
 
 #if INCLUDE_RTM_OPT
   if (UseRTMLocking) {
+    if (UseLightweightLocking) {
+      // RTM locking elides stack-locks, which lightweight locking replaces.
+      vm_exit_during_initialization("UseRTMLocking is not supported with UseLightweightLocking");
+    }
     if (!CompilerConfig::is_c2_enabled()) {
       // Only C2 does RTM locking optimization.
       vm_exit_during_initialization("RTM locking optimization is not supported in this VM");
@@ -1637,6 +1660,34 @@ void VM_Version::get_processor_features() {
   if (FLAG_IS_DEFAULT(PrefetchFieldsAhead)) {
     FLAG_SET_DEFAULT(PrefetchFieldsAhead, 1);
   }
+
+  // The interpreter interface cache compares the narrow klass in the
+  // receiver header against the low half of a single cache word.
+  if (UseInterpreterInterfaceCache && !UseCompressedClassPointers) {
+    warning("UseInterpreterInterfaceCache requires UseCompressedClassPointers");
+    FLAG_SET_DEFAULT(UseInterpreterInterfaceCache, false);
+  }
+#endif
+
+#ifdef _LP64
+  if (ArrayCopyNonTemporalThreshold < 0) {
+    // Stream copies and fills that are large compared to the last level
+    // cache, they would evict most of it anyway.
+    size_t llc_size = last_level_cache_size();
+    intx threshold = 0;
+    if (llc_size > 0 && UseAVX > 2) {
+      threshold = (intx)MIN2(llc_size / 4 * 3, (size_t)max_jint);
+    }
+    FLAG_SET_ERGO(ArrayCopyNonTemporalThreshold, threshold);
+  }
+  if (ArrayCopyNonTemporalThreshold > 0 && UseAVX <= 2) {
+    if (!FLAG_IS_DEFAULT(ArrayCopyNonTemporalThreshold)) {
+      warning("Non-temporal array copies require AVX512");
+    }
+    FLAG_SET_DEFAULT(ArrayCopyNonTemporalThreshold, 0);
+  }
+#else
+  FLAG_SET_DEFAULT(ArrayCopyNonTemporalThreshold, 0);
 #endif
 
   if (FLAG_IS_DEFAULT(ContendedPaddingWidth) &&
@@ -416,6 +416,12 @@ enum Extended_Family {
     uint32_t     dcp_cpuid4_ecx; // unused currently
     uint32_t     dcp_cpuid4_edx; // unused currently
 
+    // cpuid function 4 for the last valid cache level
+    DcpCpuid4Eax llc_cpuid4_eax;
+    DcpCpuid4Ebx llc_cpuid4_ebx;
+    uint32_t     llc_cpuid4_ecx; // number of sets - 1
+    uint32_t     llc_cpuid4_edx; // unused currently
+
     // cpuid function 7 (structured extended features)
     SefCpuid7Eax sef_cpuid7_eax;
     SefCpuid7Ebx sef_cpuid7_ebx;
@@ -714,6 +720,7 @@ public:
   static ByteSize std_cpuid0_offset() { return byte_offset_of(CpuidInfo, std_max_function); }
   static ByteSize std_cpuid1_offset() { return byte_offset_of(CpuidInfo, std_cpuid1_eax); }
   static ByteSize dcp_cpuid4_offset() { return byte_offset_of(CpuidInfo, dcp_cpuid4_eax); }
+  static ByteSize llc_cpuid4_offset() { return byte_offset_of(CpuidInfo, llc_cpuid4_eax); }
   static ByteSize sef_cpuid7_offset() { return byte_offset_of(CpuidInfo, sef_cpuid7_eax); }
   static ByteSize ext_cpuid1_offset() { return byte_offset_of(CpuidInfo, ext_cpuid1_eax); }
   static ByteSize ext_cpuid5_offset() { return byte_offset_of(CpuidInfo, ext_cpuid5_eax); }
@@ -841,6 +848,20 @@ public:
     return result;
   }
 
+  // Size in bytes of the last level cache, 0 if unknown
+  static size_t last_level_cache_size() {
+    if (!is_intel() && !is_zx()) {
+      return 0;
+    }
+    if (_cpuid_info.llc_cpuid4_eax.bits.cache_type == 0) {
+      return 0;
+    }
+    return (size_t)(_cpuid_info.llc_cpuid4_ebx.bits.associativity + 1) *
+           (_cpuid_info.llc_cpuid4_ebx.bits.partitions + 1) *
+           (_cpuid_info.llc_cpuid4_ebx.bits.L1_line_size + 1) *
+           (_cpuid_info.llc_cpuid4_ecx + 1);
+  }
+
   static intx prefetch_data_size()  {
     return L1_line_size();
   }
@@ -225,7 +225,7 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   // We expect we need index_dependent_slop extra bytes. Reason:
   // The emitted code in lookup_interface_method changes when itable_index exceeds 31.
   // For windows, a narrow estimate was found to be 104. Other OSes not tested.
-  const ptrdiff_t estimate = 104;
+  const ptrdiff_t estimate = 104 + (UseItableSelectorTable ? 2 * 64 : 0);
   const ptrdiff_t codesize = typecheckSize + lookupSize + index_dependent_slop;
   slop_delta  = (int)(estimate - codesize);
   slop_bytes += slop_delta;
@@ -1922,12 +1922,19 @@ bool os::remove_stack_guard_pages(char* addr, size_t size) {
 void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
 }
 
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  return false;
+}
+
 void os::pd_free_memory(char *addr, size_t bytes, size_t alignment_hint) {
 }
 
 void os::numa_make_global(char *addr, size_t bytes) {
 }
 
+void os::numa_make_first_touch(char *addr, size_t bytes) {
+}
+
 void os::numa_make_local(char *addr, size_t bytes, int lgrp_hint) {
 }
 
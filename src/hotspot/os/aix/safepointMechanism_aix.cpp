@@ -102,7 +102,7 @@ void SafepointMechanism::pd_initialize() {
   _polling_page = (address)(map_address);
 
   // Register polling page with NMT.
-  MemTracker::record_virtual_memory_reserve_and_commit(map_address, map_size, CALLER_PC, mtSafepoint);
+  MemTracker::record_virtual_memory_reserve_and_commit(map_address, map_size, CALLER_PC_UNSAMPLED, mtSafepoint);
 
   // Use same page for thread local handshakes without SIGTRAP
   if (!os::guard_memory((char*)_polling_page, page_size)) {
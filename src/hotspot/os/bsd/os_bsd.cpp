@@ -1622,6 +1622,10 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size,
 void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
 }
 
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  return false;
+}
+
 void os::pd_free_memory(char *addr, size_t bytes, size_t alignment_hint) {
   ::madvise(addr, bytes, MADV_DONTNEED);
 }
@@ -1629,6 +1633,9 @@ void os::pd_free_memory(char *addr, size_t bytes, size_t alignment_hint) {
 void os::numa_make_global(char *addr, size_t bytes) {
 }
 
+void os::numa_make_first_touch(char *addr, size_t bytes) {
+}
+
 void os::numa_make_local(char *addr, size_t bytes, int lgrp_hint) {
 }
 
@@ -189,6 +189,12 @@ jlong CgroupV1Subsystem::memory_max_usage_in_bytes() {
   return memmaxusage;
 }
 
+double CgroupV1Subsystem::memory_pressure() {
+  // Pressure stall information is only available per cgroup with cgroups v2.
+  log_trace(os, container)("Memory Pressure is not supported.");
+  return OSCONTAINER_ERROR; // not supported
+}
+
 char * CgroupV1Subsystem::cpu_cpuset_cpus() {
   GET_CONTAINER_INFO_CPTR(cptr, _cpuset, "/cpuset.cpus",
                      "cpuset.cpus is: %s", "%1023s", cpus, 1024);
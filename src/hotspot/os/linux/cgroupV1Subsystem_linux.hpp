@@ -79,6 +79,7 @@ class CgroupV1Subsystem: public CgroupSubsystem {
     jlong memory_soft_limit_in_bytes();
     jlong memory_usage_in_bytes();
     jlong memory_max_usage_in_bytes();
+    double memory_pressure();
     char * cpu_cpuset_cpus();
     char * cpu_cpuset_memory_nodes();
 
@@ -77,6 +77,7 @@ class CgroupV2Subsystem: public CgroupSubsystem {
     jlong memory_soft_limit_in_bytes();
     jlong memory_usage_in_bytes();
     jlong memory_max_usage_in_bytes();
+    double memory_pressure();
     char * cpu_cpuset_cpus();
     char * cpu_cpuset_memory_nodes();
     const char * container_type() {
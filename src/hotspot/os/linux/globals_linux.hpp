@@ -50,6 +50,13 @@
   product(bool, UseTransparentHugePages, false,                         \
           "Use MADV_HUGEPAGE for large pages")                          \
                                                                         \
+  product(bool, UseMadvPopulateWrite, true, DIAGNOSTIC,                 \
+          "Use MADV_POPULATE_WRITE to pre-touch memory, if available")  \
+                                                                        \
+  product(bool, UseTransparentHugePagesForCodeCache, false,             \
+          "Use MADV_HUGEPAGE for the code cache only, independently of "\
+          "UseLargePages")                                              \
+                                                                        \
   product(bool, LoadExecStackDllInVMThread, true,                       \
           "Load DLLs with executable-stack attribute in the VM Thread") \
                                                                         \
@@ -59,6 +66,12 @@
   product(bool, UseContainerSupport, true,                              \
           "Enable detection and runtime container configuration support") \
                                                                         \
+  product(uintx, ContainerCacheTimeout, 20, DIAGNOSTIC,                 \
+          "Number of milliseconds for which the container memory limit "\
+          "and active processor count are cached before being re-read " \
+          "from the cgroup file system")                                \
+          range(0, max_jint)                                            \
+                                                                        \
   product(bool, PreferContainerQuotaForCPUCount, true,                  \
           "Calculate the container CPU availability based on the value" \
           " of quotas (if set), when true. Otherwise, use the CPU"      \
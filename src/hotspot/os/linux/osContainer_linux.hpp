@@ -31,8 +31,10 @@
 
 #define OSCONTAINER_ERROR (-2)
 
-// 20ms timeout between re-reads of memory limit and _active_processor_count.
-#define OSCONTAINER_CACHE_TIMEOUT (NANOSECS_PER_SEC/50)
+// Timeout between re-reads of memory limit and _active_processor_count,
+// in os::elapsed_counter() ticks (see ContainerCacheTimeout).
+#define OSCONTAINER_CACHE_TIMEOUT \
+  ((jlong)ContainerCacheTimeout * (os::elapsed_frequency() / MILLIUNITS))
 
 class OSContainer: AllStatic {
 
@@ -51,6 +53,10 @@ class OSContainer: AllStatic {
   static jlong memory_soft_limit_in_bytes();
   static jlong memory_usage_in_bytes();
   static jlong memory_max_usage_in_bytes();
+  // Percentage of the last 10 seconds in which some task of the container
+  // was stalled on memory. Note: this is only reported, with the other
+  // container metrics. No GC or heap sizing policy acts on it.
+  static double memory_pressure();
 
   static int active_processor_count();
 
@@ -165,6 +165,7 @@ bool os::Linux::_supports_fast_thread_cpu_time = false;
 const char * os::Linux::_libc_version = NULL;
 const char * os::Linux::_libpthread_version = NULL;
 size_t os::Linux::_default_large_page_size = 0;
+size_t os::Linux::_code_cache_large_page_size = 0;
 
 #ifdef __GLIBC__
 os::Linux::mallinfo_func_t os::Linux::_mallinfo = NULL;
@@ -2308,6 +2309,14 @@ bool os::Linux::print_container_info(outputStream* st) {
     st->print_cr("%s", j == OSCONTAINER_ERROR ? "not supported" : "unlimited");
   }
 
+  double pressure = OSContainer::memory_pressure();
+  st->print("memory_pressure: ");
+  if (pressure >= 0) {
+    st->print_cr("%.2f%%", pressure);
+  } else {
+    st->print_cr("not supported");
+  }
+
   return true;
 }
 
@@ -2706,6 +2715,11 @@ static void warn_fail_commit_memory(char* addr, size_t size,
           alignment_hint, exec, os::strerror(err), err);
 }
 
+// Define MADV_HUGEPAGE here so we can build HotSpot on old systems.
+#ifndef MADV_HUGEPAGE
+  #define MADV_HUGEPAGE 14
+#endif
+
 // NOTE: Linux kernel does not really reserve the pages for us.
 //       All it does is to check if there are enough free pages
 //       left at the time of mmap(). This could be a potential
@@ -2718,6 +2732,12 @@ int os::Linux::commit_memory_impl(char* addr, size_t size, bool exec) {
     if (UseNUMAInterleaving) {
       numa_make_global(addr, size);
     }
+    if (exec && _code_cache_large_page_size != 0) {
+      // The mmap above replaced the mapping, so the advice has to be
+      // given again for every commit. We don't check the return value,
+      // the memory simply stays backed by small pages.
+      ::madvise(addr, size, MADV_HUGEPAGE);
+    }
     return 0;
   }
 
@@ -2760,11 +2780,6 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size, bool exec,
   #define MAP_HUGE_SHIFT 26
 #endif
 
-// Define MADV_HUGEPAGE here so we can build HotSpot on old systems.
-#ifndef MADV_HUGEPAGE
-  #define MADV_HUGEPAGE 14
-#endif
-
 int os::Linux::commit_memory_impl(char* addr, size_t size,
                                   size_t alignment_hint, bool exec) {
   int err = os::Linux::commit_memory_impl(addr, size, exec);
@@ -2799,6 +2814,37 @@ void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
   }
 }
 
+// Define MADV_POPULATE_WRITE here so we can build HotSpot on old systems.
+#ifndef MADV_POPULATE_WRITE
+  #define MADV_POPULATE_WRITE 23
+#endif
+
+// Set once madvise(MADV_POPULATE_WRITE) has been found to be unsupported.
+static volatile bool madv_populate_write_unsupported = false;
+
+bool os::pd_pretouch_memory(void* start, void* end, size_t page_size) {
+  if (!UseMadvPopulateWrite || madv_populate_write_unsupported) {
+    return false;
+  }
+  // Populating the range write-faults all of its pages in the kernel,
+  // without a user space store to each one. This also works for THP and
+  // hugetlbfs backed ranges, independent of the page size used by callers.
+  char* first = align_down((char*)start, os::vm_page_size());
+  size_t len = pointer_delta((char*)end, first, sizeof(char));
+  if (::madvise(first, len, MADV_POPULATE_WRITE) == 0) {
+    return true;
+  }
+  int err = errno;
+  if (err == EINVAL) {
+    // Kernels before 5.14 do not know MADV_POPULATE_WRITE.
+    madv_populate_write_unsupported = true;
+  } else {
+    log_info(os)("::madvise(" PTR_FORMAT ", " SIZE_FORMAT ", MADV_POPULATE_WRITE) failed; "
+                 "error='%s' (errno=%d)", p2i(first), len, os::strerror(err), err);
+  }
+  return false;
+}
+
 void os::pd_free_memory(char *addr, size_t bytes, size_t alignment_hint) {
   // This method works by doing an mmap over an existing mmaping and effectively discarding
   // the existing pages. However it won't work for SHM-based large pages that cannot be
@@ -2814,6 +2860,10 @@ void os::numa_make_global(char *addr, size_t bytes) {
   Linux::numa_interleave_memory(addr, bytes);
 }
 
+void os::numa_make_first_touch(char *addr, size_t bytes) {
+  Linux::numa_setlocal_memory(addr, bytes);
+}
+
 // Define for numa_set_bind_policy(int). Setting the argument to 0 will set the
 // bind policy to MPOL_PREFERRED for the current thread.
 #define USE_MPOL_PREFERRED 0
@@ -2998,6 +3048,8 @@ bool os::Linux::libnuma_init() {
                                             libnuma_dlsym(handle, "numa_tonode_memory")));
       set_numa_interleave_memory(CAST_TO_FN_PTR(numa_interleave_memory_func_t,
                                                 libnuma_dlsym(handle, "numa_interleave_memory")));
+      set_numa_setlocal_memory(CAST_TO_FN_PTR(numa_setlocal_memory_func_t,
+                                              libnuma_dlsym(handle, "numa_setlocal_memory")));
       set_numa_interleave_memory_v2(CAST_TO_FN_PTR(numa_interleave_memory_v2_func_t,
                                                 libnuma_v2_dlsym(handle, "numa_interleave_memory")));
       set_numa_set_bind_policy(CAST_TO_FN_PTR(numa_set_bind_policy_func_t,
@@ -3174,6 +3226,7 @@ os::Linux::numa_available_func_t os::Linux::_numa_available;
 os::Linux::numa_tonode_memory_func_t os::Linux::_numa_tonode_memory;
 os::Linux::numa_interleave_memory_func_t os::Linux::_numa_interleave_memory;
 os::Linux::numa_interleave_memory_v2_func_t os::Linux::_numa_interleave_memory_v2;
+os::Linux::numa_setlocal_memory_func_t os::Linux::_numa_setlocal_memory;
 os::Linux::numa_set_bind_policy_func_t os::Linux::_numa_set_bind_policy;
 os::Linux::numa_bitmask_isbitset_func_t os::Linux::_numa_bitmask_isbitset;
 os::Linux::numa_distance_func_t os::Linux::_numa_distance;
@@ -3692,6 +3745,47 @@ size_t os::Linux::default_large_page_size() {
   return _default_large_page_size;
 }
 
+size_t os::Linux::scan_transparent_huge_page_size() {
+  // The transparent huge page size is the PMD size, which usually but not
+  // necessarily matches the default hugetlbfs page size.
+  size_t page_size = 0;
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+  if (fp != NULL) {
+    size_t value = 0;
+    if (fscanf(fp, SIZE_FORMAT, &value) == 1 && is_power_of_2(value)) {
+      page_size = value;
+    }
+    fclose(fp);
+  }
+  if (page_size == 0) {
+    page_size = scan_default_large_page_size();
+  }
+  return page_size;
+}
+
+void os::Linux::code_cache_large_page_init() {
+  if (!UseTransparentHugePagesForCodeCache) {
+    return;
+  }
+  if (UseLargePages && (UseTransparentHugePages || UseHugeTLBFS)) {
+    // The global large page setup already applies to the code cache.
+    log_info(pagesize)("UseTransparentHugePagesForCodeCache ignored, UseLargePages already applies to the code cache");
+    UseTransparentHugePagesForCodeCache = false;
+    return;
+  }
+  size_t page_size = scan_transparent_huge_page_size();
+  if (page_size <= (size_t)os::vm_page_size() ||
+      !transparent_huge_pages_sanity_check(false, page_size)) {
+    warning("UseTransparentHugePagesForCodeCache disabled, transparent huge pages are not supported by the operating system.");
+    UseTransparentHugePagesForCodeCache = false;
+    return;
+  }
+  _code_cache_large_page_size = page_size;
+  log_info(pagesize)("Using transparent huge pages for the code cache: " SIZE_FORMAT "%s",
+                     byte_size_in_exact_unit(page_size),
+                     exact_unit_for_byte_size(page_size));
+}
+
 void warn_no_large_pages_configured() {
   if (!FLAG_IS_DEFAULT(UseLargePages)) {
     log_warning(pagesize)("UseLargePages disabled, no large pages configured and available on the system.");
@@ -4001,7 +4095,8 @@ static void warn_on_commit_special_failure(char* req_addr, size_t bytes,
 bool os::Linux::commit_memory_special(size_t bytes,
                                       size_t page_size,
                                       char* req_addr,
-                                      bool exec) {
+                                      bool exec,
+                                      bool warn) {
   assert(UseLargePages && UseHugeTLBFS, "Should only get here when HugeTLBFS large pages are used");
   assert(is_aligned(bytes, page_size), "Unaligned size");
   assert(is_aligned(req_addr, page_size), "Unaligned address");
@@ -4017,7 +4112,16 @@ bool os::Linux::commit_memory_special(size_t bytes,
   char* addr = (char*)::mmap(req_addr, bytes, prot, flags, -1, 0);
 
   if (addr == MAP_FAILED) {
-    warn_on_commit_special_failure(req_addr, bytes, page_size, errno);
+    if (warn) {
+      warn_on_commit_special_failure(req_addr, bytes, page_size, errno);
+    } else {
+      log_debug(pagesize)("Failed to commit special mapping: " PTR_FORMAT ", size=" SIZE_FORMAT "%s, page size="
+                          SIZE_FORMAT "%s (errno = %d)",
+                          p2i(req_addr), byte_size_in_exact_unit(bytes),
+                          exact_unit_for_byte_size(bytes),
+                          byte_size_in_exact_unit(page_size),
+                          exact_unit_for_byte_size(page_size), errno);
+    }
     return false;
   }
 
@@ -4068,22 +4172,43 @@ char* os::Linux::reserve_memory_special_huge_tlbfs(size_t bytes,
     return aligned_start;
   }
 
-  // The requested size requires some small pages as well.
-  char* small_start = aligned_start + large_bytes;
-  size_t small_size = bytes - large_bytes;
+  // The requested size requires some smaller pages as well.
+  char* tail_start = aligned_start + large_bytes;
+  size_t tail_size = bytes - large_bytes;
   if (!large_committed) {
     // Failed to commit large pages, so we need to unmap the
     // reminder of the orinal reservation.
-    ::munmap(small_start, small_size);
+    ::munmap(tail_start, tail_size);
     return NULL;
   }
 
+  // Commit the remaining bytes using the next smaller page sizes, largest
+  // first, so that the tail gets the best TLB reach available. A smaller
+  // large page size that is larger than the remaining tail, or that cannot
+  // be committed (e.g. because its pool is empty), is skipped in favor of
+  // the next one. Such a failure is expected, so it is not warned about.
+  for (size_t tail_page_size = _page_sizes.next_smaller(page_size);
+       tail_page_size > (size_t)os::vm_page_size();
+       tail_page_size = _page_sizes.next_smaller(tail_page_size)) {
+    if (tail_size < tail_page_size) {
+      continue;
+    }
+    size_t tail_large_bytes = align_down(tail_size, tail_page_size);
+    if (commit_memory_special(tail_large_bytes, tail_page_size, tail_start, exec, false /* warn */)) {
+      tail_start += tail_large_bytes;
+      tail_size -= tail_large_bytes;
+    }
+  }
+  if (tail_size == 0) {
+    return aligned_start;
+  }
+
   // Commit the remaining bytes using small pages.
-  bool small_committed = commit_memory_special(small_size, os::vm_page_size(), small_start, exec);
+  bool small_committed = commit_memory_special(tail_size, os::vm_page_size(), tail_start, exec);
   if (!small_committed) {
     // Failed to commit the remaining size, need to unmap
     // the large pages part of the reservation.
-    ::munmap(aligned_start, large_bytes);
+    ::munmap(aligned_start, tail_start - aligned_start);
     return NULL;
   }
   return aligned_start;
@@ -4541,6 +4666,8 @@ jint os::init_2(void) {
     Linux::numa_init();
   }
 
+  Linux::code_cache_large_page_init();
+
   if (MaxFDLimit) {
     // set the number of file descriptors to max. print out error
     // if getrlimit/setrlimit fails but continue regardless.
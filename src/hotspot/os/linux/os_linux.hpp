@@ -51,6 +51,7 @@ class Linux {
   static GrowableArray<int>* _nindex_to_node;
 
   static size_t _default_large_page_size;
+  static size_t _code_cache_large_page_size;
 
  protected:
 
@@ -79,6 +80,7 @@ class Linux {
 
   static size_t default_large_page_size();
   static size_t scan_default_large_page_size();
+  static size_t scan_transparent_huge_page_size();
   static os::PageSizes scan_multiple_page_support();
 
   static bool setup_large_page_type(size_t page_size);
@@ -90,7 +92,7 @@ class Linux {
 
   static char* reserve_memory_special_shm(size_t bytes, size_t alignment, char* req_addr, bool exec);
   static char* reserve_memory_special_huge_tlbfs(size_t bytes, size_t alignment, size_t page_size, char* req_addr, bool exec);
-  static bool commit_memory_special(size_t bytes, size_t page_size, char* req_addr, bool exec);
+  static bool commit_memory_special(size_t bytes, size_t page_size, char* req_addr, bool exec, bool warn = true);
 
   static bool release_memory_special_impl(char* base, size_t bytes);
   static bool release_memory_special_shm(char* base, size_t bytes);
@@ -135,6 +137,11 @@ class Linux {
   static int page_size(void)                                        { return _page_size; }
   static void set_page_size(int val)                                { _page_size = val; }
 
+  // Transparent huge pages for executable memory (UseTransparentHugePagesForCodeCache).
+  // code_cache_large_page_size() is 0 if they are not used.
+  static void code_cache_large_page_init();
+  static size_t code_cache_large_page_size()                        { return _code_cache_large_page_size; }
+
   static intptr_t* ucontext_get_sp(const ucontext_t* uc);
   static intptr_t* ucontext_get_fp(const ucontext_t* uc);
 
@@ -191,6 +198,7 @@ class Linux {
   typedef int (*numa_tonode_memory_func_t)(void *start, size_t size, int node);
   typedef void (*numa_interleave_memory_func_t)(void *start, size_t size, unsigned long *nodemask);
   typedef void (*numa_interleave_memory_v2_func_t)(void *start, size_t size, struct bitmask* mask);
+  typedef void (*numa_setlocal_memory_func_t)(void *start, size_t size);
   typedef struct bitmask* (*numa_get_membind_func_t)(void);
   typedef struct bitmask* (*numa_get_interleave_mask_func_t)(void);
   typedef long (*numa_move_pages_func_t)(int pid, unsigned long count, void **pages, const int *nodes, int *status, int flags);
@@ -208,6 +216,7 @@ class Linux {
   static numa_tonode_memory_func_t _numa_tonode_memory;
   static numa_interleave_memory_func_t _numa_interleave_memory;
   static numa_interleave_memory_v2_func_t _numa_interleave_memory_v2;
+  static numa_setlocal_memory_func_t _numa_setlocal_memory;
   static numa_set_bind_policy_func_t _numa_set_bind_policy;
   static numa_bitmask_isbitset_func_t _numa_bitmask_isbitset;
   static numa_distance_func_t _numa_distance;
@@ -230,6 +239,7 @@ class Linux {
   static void set_numa_tonode_memory(numa_tonode_memory_func_t func) { _numa_tonode_memory = func; }
   static void set_numa_interleave_memory(numa_interleave_memory_func_t func) { _numa_interleave_memory = func; }
   static void set_numa_interleave_memory_v2(numa_interleave_memory_v2_func_t func) { _numa_interleave_memory_v2 = func; }
+  static void set_numa_setlocal_memory(numa_setlocal_memory_func_t func) { _numa_setlocal_memory = func; }
   static void set_numa_set_bind_policy(numa_set_bind_policy_func_t func) { _numa_set_bind_policy = func; }
   static void set_numa_bitmask_isbitset(numa_bitmask_isbitset_func_t func) { _numa_bitmask_isbitset = func; }
   static void set_numa_distance(numa_distance_func_t func) { _numa_distance = func; }
@@ -326,6 +336,11 @@ class Linux {
       _numa_interleave_memory(start, size, _numa_all_nodes);
     }
   }
+  static void numa_setlocal_memory(void *start, size_t size) {
+    if (_numa_setlocal_memory != NULL) {
+      _numa_setlocal_memory(start, size);
+    }
+  }
   static void numa_set_preferred(int node) {
     if (_numa_set_preferred != NULL) {
       _numa_set_preferred(node);
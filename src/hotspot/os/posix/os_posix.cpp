@@ -61,6 +61,7 @@
 #include <sys/resource.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/utsname.h>
 #include <sys/wait.h>
 #include <time.h>
@@ -251,7 +252,7 @@ static char* reserve_mmapped_memory(size_t bytes, char* requested_addr) {
                        flags, -1, 0);
 
   if (addr != MAP_FAILED) {
-    MemTracker::record_virtual_memory_reserve((address)addr, bytes, CALLER_PC);
+    MemTracker::record_virtual_memory_reserve((address)addr, bytes, CALLER_PC_UNSAMPLED);
     return addr;
   }
   return NULL;
@@ -379,7 +380,7 @@ char* os::map_memory_to_file_aligned(size_t size, size_t alignment, int file_des
   if (replace_existing_mapping_with_file_mapping(aligned_base, size, file_desc) == NULL) {
     vm_exit_during_initialization(err_msg("Error in mapping Java heap at the given filesystem directory"));
   }
-  MemTracker::record_virtual_memory_commit((address)aligned_base, size, CALLER_PC);
+  MemTracker::record_virtual_memory_commit((address)aligned_base, size, CALLER_PC_UNSAMPLED);
   return aligned_base;
 }
 
@@ -722,6 +723,32 @@ struct hostent* os::get_host_by_name(char* name) {
   return ::gethostbyname(name);
 }
 
+int os::connect_unix_domain_socket(const char* path) {
+  struct sockaddr_un addr;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+
+  int fd = os::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+
+  if (os::connect(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) {
+    int saved_errno = errno;
+    os::socket_close(fd);
+    errno = saved_errno;
+    return -1;
+  }
+
+  return fd;
+}
+
 void os::exit(int num) {
   ::exit(num);
 }
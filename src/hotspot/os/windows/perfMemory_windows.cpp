@@ -1497,7 +1497,7 @@ static char* mapping_create_shared(size_t size) {
 
   // it does not go through os api, the operation has to record from here
   MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress,
-    size, CURRENT_PC, mtInternal);
+    size, CURRENT_PC_UNSAMPLED, mtInternal);
 
   return (char*) mapAddress;
 }
@@ -1681,7 +1681,7 @@ static void open_file_mapping(const char* user, int vmid,
 
   // it does not go through os api, the operation has to record from here
   MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size,
-    CURRENT_PC, mtInternal);
+    CURRENT_PC_UNSAMPLED, mtInternal);
 
 
   *addrp = (char*)mapAddress;
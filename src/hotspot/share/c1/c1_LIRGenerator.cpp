@@ -921,6 +921,17 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
       not_taken_count_offset = t;
     }
 
+    // The sampling check kills the condition codes of the compare emitted
+    // just before, so the compare is repeated after the profile update.
+    LIR_Op2* cmp = NULL;
+    if (C1ProfileSampleInterval > 1) {
+      LIR_OpList* ops = lir()->instructions_list();
+      LIR_Op* last = ops->is_empty() ? NULL : ops->last();
+      if (last != NULL && last->code() == lir_cmp && last->info() == NULL) {
+        cmp = last->as_Op2();
+      }
+    }
+
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
@@ -930,17 +941,73 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
              LIR_OprFact::intptrConst(not_taken_count_offset),
              data_offset_reg, as_BasicType(if_instr->x()->type()));
 
+    LabelObj* skip = (cmp != NULL) ? begin_sampled_profile() : NULL;
+
     // MDO cells are intptr_t, so the data_reg width is arch-dependent.
     LIR_Opr data_reg = new_pointer_register();
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
     // Use leal instead of add to avoid destroying condition codes on x86
-    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment, T_INT);
+    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment * sampled_profile_increment(skip), T_INT);
     __ leal(LIR_OprFact::address(fake_incr_value), data_reg);
     __ move(data_reg, data_addr);
+
+    if (skip != NULL) {
+      end_sampled_profile(skip);
+      __ cmp(cmp->condition(), cmp->in_opr1(), cmp->in_opr2());
+    }
   }
 }
 
+// Sampled profiling: with C1ProfileSampleInterval = n > 1 only one in n
+// profile updates of a thread on average is done, by n, so the counters
+// keep their expected values. The gap to the next sampled update is
+// drawn from a per-thread xorshift generator: a fixed period would alias
+// with periodic control flow and could miss a branch direction entirely.
+// The countdown is thread local, so the check doesn't touch shared cache
+// lines. Kills the condition codes.
+// Returns the label to bind after the update, or NULL if not sampling.
+LabelObj* LIRGenerator::begin_sampled_profile() {
+  if (C1ProfileSampleInterval <= 1) {
+    return NULL;
+  }
+  LabelObj* skip = new LabelObj();
+  LIR_Address* countdown_addr = new LIR_Address(getThreadPointer(),
+                                                in_bytes(JavaThread::profile_sample_countdown_offset()), T_INT);
+  LIR_Opr countdown = new_register(T_INT);
+  __ move(countdown_addr, countdown);
+  __ sub(countdown, LIR_OprFact::intConst(1), countdown);
+  __ move(countdown, countdown_addr);
+  __ cmp(lir_cond_greater, countdown, LIR_OprFact::intConst(0));
+  __ branch(lir_cond_greater, skip->label());
+
+  // Advance the xorshift32 state
+  LIR_Address* seed_addr = new LIR_Address(getThreadPointer(),
+                                           in_bytes(JavaThread::profile_sample_seed_offset()), T_INT);
+  LIR_Opr seed = new_register(T_INT);
+  LIR_Opr tmp = new_register(T_INT);
+  __ move(seed_addr, seed);
+  shift_op(Bytecodes::_ishl, tmp, seed, LIR_OprFact::intConst(13), LIR_OprFact::illegalOpr);
+  logic_op(Bytecodes::_ixor, seed, seed, tmp);
+  shift_op(Bytecodes::_iushr, tmp, seed, LIR_OprFact::intConst(17), LIR_OprFact::illegalOpr);
+  logic_op(Bytecodes::_ixor, seed, seed, tmp);
+  shift_op(Bytecodes::_ishl, tmp, seed, LIR_OprFact::intConst(5), LIR_OprFact::illegalOpr);
+  logic_op(Bytecodes::_ixor, seed, seed, tmp);
+  __ move(seed, seed_addr);
+
+  // The next countdown is the sum of two uniform values in [0, n - 1],
+  // plus one. It is in [1, 2n - 1] with a mean of exactly n.
+  LIR_Opr mask = LIR_OprFact::intConst((jint)C1ProfileSampleInterval - 1);
+  LIR_Opr next = new_register(T_INT);
+  shift_op(Bytecodes::_iushr, tmp, seed, LIR_OprFact::intConst(16), LIR_OprFact::illegalOpr);
+  logic_op(Bytecodes::_iand, tmp, tmp, mask);
+  logic_op(Bytecodes::_iand, next, seed, mask);
+  arithmetic_op_int(Bytecodes::_iadd, next, next, tmp, LIR_OprFact::illegalOpr);
+  arithmetic_op_int(Bytecodes::_iadd, next, next, LIR_OprFact::intConst(1), LIR_OprFact::illegalOpr);
+  __ move(next, countdown_addr);
+  return skip;
+}
+
 // Phi technique:
 // This is about passing live values from one basic block to the other.
 // In code generated with Java it is rather rare that more than one
@@ -2456,6 +2523,7 @@ void LIRGenerator::do_TableSwitch(TableSwitch* x) {
     assert(data != NULL, "must have profiling data");
     assert(data->is_MultiBranchData(), "bad profile data?");
     int default_count_offset = md->byte_offset_of_slot(data, MultiBranchData::default_count_offset());
+    LabelObj* skip = begin_sampled_profile();
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
     LIR_Opr data_offset_reg = new_pointer_register();
@@ -2475,8 +2543,9 @@ void LIRGenerator::do_TableSwitch(TableSwitch* x) {
     LIR_Opr data_reg = new_pointer_register();
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
-    __ add(data_reg, LIR_OprFact::intptrConst(1), data_reg);
+    __ add(data_reg, LIR_OprFact::intptrConst(sampled_profile_increment(skip)), data_reg);
     __ move(data_reg, data_addr);
+    end_sampled_profile(skip);
   }
 
   if (UseTableRanges) {
@@ -2514,6 +2583,7 @@ void LIRGenerator::do_LookupSwitch(LookupSwitch* x) {
     assert(data != NULL, "must have profiling data");
     assert(data->is_MultiBranchData(), "bad profile data?");
     int default_count_offset = md->byte_offset_of_slot(data, MultiBranchData::default_count_offset());
+    LabelObj* skip = begin_sampled_profile();
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
     LIR_Opr data_offset_reg = new_pointer_register();
@@ -2533,8 +2603,9 @@ void LIRGenerator::do_LookupSwitch(LookupSwitch* x) {
     LIR_Opr data_reg = new_pointer_register();
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
-    __ add(data_reg, LIR_OprFact::intptrConst(1), data_reg);
+    __ add(data_reg, LIR_OprFact::intptrConst(sampled_profile_increment(skip)), data_reg);
     __ move(data_reg, data_addr);
+    end_sampled_profile(skip);
   }
 
   if (UseTableRanges) {
@@ -2596,8 +2667,11 @@ void LIRGenerator::do_Goto(Goto* x) {
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
+    LabelObj* skip = begin_sampled_profile();
     increment_counter(new LIR_Address(md_reg, offset,
-                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment);
+                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)),
+                      DataLayout::counter_increment * sampled_profile_increment(skip));
+    end_sampled_profile(skip);
   }
 
   // emit phi-instruction move after safepoint since this simplifies
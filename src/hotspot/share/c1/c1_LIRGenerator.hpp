@@ -392,6 +392,15 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
   LIR_Opr safepoint_poll_register();
 
   void profile_branch(If* if_instr, If::Condition cond);
+  LabelObj* begin_sampled_profile();
+  void end_sampled_profile(LabelObj* skip) {
+    if (skip != NULL) {
+      lir()->branch_destination(skip->label());
+    }
+  }
+  int sampled_profile_increment(LabelObj* skip) const {
+    return skip != NULL ? (int)C1ProfileSampleInterval : 1;
+  }
   void increment_event_counter_impl(CodeEmitInfo* info,
                                     ciMethod *method, LIR_Opr step, int frequency,
                                     int bci, bool backedge, bool notify);
@@ -739,7 +739,7 @@ JRT_BLOCK_ENTRY(void, Runtime1::monitorenter(JavaThread* current, oopDesc* obj,
     _monitorenter_slowcase_cnt++;
   }
 #endif
-  if (!UseFastLocking) {
+  if (!UseFastLocking || UseLightweightLocking) {
     lock->set_obj(obj);
   }
   assert(obj == lock->obj(), "must match");
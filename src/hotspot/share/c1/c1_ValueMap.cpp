@@ -265,8 +265,9 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
   GlobalValueNumbering* _gvn;
   BlockList             _loop_blocks;
   bool                  _too_complicated_loop;
-  bool                  _has_field_store[T_VOID];
+  bool                  _has_field_store[T_VOID];   // stores to fields that need patching
   bool                  _has_indexed_store[T_VOID];
+  GrowableArray<ciField*> _stored_fields;           // stores to resolved fields
 
   // simplified access to methods of GlobalValueNumbering
   ValueMap* current_map()                        { return _gvn->current_map(); }
@@ -277,7 +278,13 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
   void      kill_field(ciField* field, bool all_offsets)  {
     current_map()->kill_field(field, all_offsets);
     assert(field->type()->basic_type() >= 0 && field->type()->basic_type() < T_VOID, "Invalid type");
-    _has_field_store[field->type()->basic_type()] = true;
+    if (all_offsets) {
+      // the holder of an unresolved field is not necessarily the declaring
+      // class, so only the type is known to be affected
+      _has_field_store[field->type()->basic_type()] = true;
+    } else {
+      _stored_fields.append(field);
+    }
   }
   void      kill_array(ValueType* type)                   {
     current_map()->kill_array(type);
@@ -290,16 +297,34 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
     : _gvn(gvn)
     , _loop_blocks(ValueMapMaxLoopSize)
     , _too_complicated_loop(false)
+    , _stored_fields(4)
   {
+    clear_stores();
+  }
+
+  // the stores of one loop must not prevent code motion in the next one
+  void clear_stores() {
     for (int i = 0; i < T_VOID; i++) {
       _has_field_store[i] = false;
       _has_indexed_store[i] = false;
     }
+    _stored_fields.clear();
   }
 
-  bool has_field_store(BasicType type) {
+  bool has_field_store(ciField* field) {
+    BasicType type = field->type()->basic_type();
     assert(type >= 0 && type < T_VOID, "Invalid type");
-    return _has_field_store[type];
+    if (_has_field_store[type]) {
+      return true;
+    }
+    // ciField's are not unique; must compare their contents (see MUST_KILL_FIELD)
+    for (int i = 0; i < _stored_fields.length(); i++) {
+      ciField* stored = _stored_fields.at(i);
+      if (stored->holder() == field->holder() && stored->offset() == field->offset()) {
+        return true;
+      }
+    }
+    return false;
   }
 
   bool has_indexed_store(BasicType type) {
@@ -372,14 +397,14 @@ void LoopInvariantCodeMotion::process_block(BlockBegin* block) {
 
     if (cur->as_Constant() != NULL) {
       cur_invariant = !cur->can_trap();
-    } else if (cur->as_ArithmeticOp() != NULL || cur->as_LogicOp() != NULL || cur->as_ShiftOp() != NULL) {
+    } else if (cur->as_ArithmeticOp() != NULL || cur->as_LogicOp() != NULL || cur->as_ShiftOp() != NULL || cur->as_CompareOp() != NULL) {
       assert(cur->as_Op2() != NULL, "must be Op2");
       Op2* op2 = (Op2*)cur;
       cur_invariant = !op2->can_trap() && is_invariant(op2->x()) && is_invariant(op2->y());
     } else if (cur->as_LoadField() != NULL) {
       LoadField* lf = (LoadField*)cur;
       // deoptimizes on NullPointerException
-      cur_invariant = !lf->needs_patching() && !lf->field()->is_volatile() && !_short_loop_optimizer->has_field_store(lf->field()->type()->basic_type()) && is_invariant(lf->obj()) && _insert_is_pred;
+      cur_invariant = !lf->needs_patching() && !lf->field()->is_volatile() && !_short_loop_optimizer->has_field_store(lf->field()) && is_invariant(lf->obj()) && _insert_is_pred;
     } else if (cur->as_ArrayLength() != NULL) {
       ArrayLength *length = cur->as_ArrayLength();
       cur_invariant = is_invariant(length->array());
@@ -439,6 +464,7 @@ bool ShortLoopOptimizer::process(BlockBegin* loop_header) {
   _too_complicated_loop = false;
   _loop_blocks.clear();
   _loop_blocks.append(loop_header);
+  clear_stores();
 
   for (int i = 0; i < _loop_blocks.length(); i++) {
     BlockBegin* block = _loop_blocks.at(i);
@@ -319,6 +319,13 @@
   product(bool, C1ProfileBranches, true,                                    \
           "Profile branches when generating code for updating MDOs")        \
                                                                             \
+  product(intx, C1ProfileSampleInterval, 1,                                 \
+          "Update branch and switch profiles in C1 code on average once "   \
+          "in n times, by n, using a randomized per-thread countdown "      \
+          "(1 = every time). Must be a power of 2")                         \
+          range(1, 1024)                                                    \
+          constraint(C1ProfileSampleIntervalConstraintFunc, AfterErgo)      \
+                                                                            \
   product(bool, C1ProfileCheckcasts, true,                                  \
           "Profile checkcasts when generating code for updating MDOs")      \
                                                                             \
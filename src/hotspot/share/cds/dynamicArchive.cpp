@@ -30,18 +30,25 @@
 #include "cds/lambdaFormInvokers.hpp"
 #include "cds/metaspaceShared.hpp"
 #include "classfile/classLoaderData.inline.hpp"
+#include "classfile/javaClasses.inline.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionaryShared.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "code/relocInfo.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/gcVMOperations.hpp"
 #include "gc/shared/gc_globals.hpp"
 #include "logging/log.hpp"
+#include "logging/logStream.hpp"
 #include "memory/metaspaceClosure.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/klass.inline.hpp"
+#include "oops/objArrayKlass.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
@@ -87,6 +94,7 @@ public:
   void sort_methods(InstanceKlass* ik) const;
   void remark_pointers_for_instance_klass(InstanceKlass* k, bool should_mark) const;
   void write_archive(char* serialized_data);
+  void report_archivable_nmethods();
 
 public:
   DynamicArchiveBuilder() : ArchiveBuilder() { }
@@ -111,6 +119,9 @@ public:
     // Block concurrent class unloading from changing the _dumptime_table
     MutexLocker ml(DumpTimeTable_lock, Mutex::_no_safepoint_check_flag);
     SystemDictionaryShared::check_excluded_classes();
+    if (log_is_enabled(Info, cds, nmethod)) {
+      report_archivable_nmethods();
+    }
 
     init_header();
     gather_source_objs();
@@ -312,6 +323,113 @@ void DynamicArchiveBuilder::write_archive(char* serialized_data) {
   log_info(cds, dynamic)("%d klasses; %d symbols", klasses()->length(), symbols()->length());
 }
 
+static bool is_archived_klass(Klass* k) {
+  if (k->is_objArray_klass()) {
+    k = ObjArrayKlass::cast(k)->bottom_klass();
+  }
+  if (!k->is_instance_klass()) {
+    return true;
+  }
+  InstanceKlass* ik = InstanceKlass::cast(k);
+  return ik->is_shared() || !SystemDictionaryShared::is_excluded_class(ik);
+}
+
+// Returns NULL if the nmethod could be stored in the archive next to its
+// class: it only refers to strings, mirrors and archived metadata through
+// its OopRecorder tables, and its calls and addresses outside itself point
+// into the code cache or are resolved symbolically. Otherwise returns the
+// first reason why it could not.
+static const char* archive_incompatibility(nmethod* nm) {
+  if (!is_archived_klass(nm->method()->method_holder())) {
+    return "class is not archived";
+  }
+  for (int i = 1; i < nm->oops_count(); i++) {
+    oop o = nm->oop_at(i);
+    if (o != NULL && o != Universe::non_oop_word() &&
+        !java_lang_String::is_instance(o) && !java_lang_Class::is_instance(o)) {
+      return "embeds a heap object";
+    }
+  }
+  for (int i = 1; i < nm->metadata_count(); i++) {
+    Metadata* md = nm->metadata_at(i);
+    if (md == NULL || md == (Metadata*)Universe::non_oop_word()) {
+      continue;
+    }
+    if (md->is_klass()) {
+      if (!is_archived_klass((Klass*)md)) {
+        return "refers to a class that is not archived";
+      }
+    } else if (md->is_method()) {
+      if (!is_archived_klass(((Method*)md)->method_holder())) {
+        return "refers to a method that is not archived";
+      }
+    } else {
+      return "refers to profile data";
+    }
+  }
+  RelocIterator iter(nm);
+  while (iter.next()) {
+    switch (iter.type()) {
+    case relocInfo::oop_type:
+      if (iter.oop_reloc()->oop_index() == 0) {
+        return "embeds an immediate oop";
+      }
+      break;
+    case relocInfo::metadata_type:
+      if (iter.metadata_reloc()->metadata_index() == 0) {
+        return "embeds immediate metadata";
+      }
+      break;
+    case relocInfo::runtime_call_type:
+      if (!CodeCache::contains(iter.runtime_call_reloc()->destination())) {
+        return "calls a VM function directly";
+      }
+      break;
+    case relocInfo::runtime_call_w_cp_type:
+      if (!CodeCache::contains(iter.runtime_call_w_cp_reloc()->destination())) {
+        return "calls a VM function directly";
+      }
+      break;
+    case relocInfo::external_word_type:
+      if (!CodeCache::contains(iter.external_word_reloc()->target())) {
+        return "refers to a VM address";
+      }
+      break;
+    default:
+      // Calls to Java methods go through inline caches and resolution
+      // stubs, and the rest is either relative or recreated at install.
+      break;
+    }
+  }
+  return NULL;
+}
+
+// This is the first step towards storing C2 code next to the archived
+// classes: report how much of the code compiled in this run could be
+// relocated when loaded into a later one.
+void DynamicArchiveBuilder::report_archivable_nmethods() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  ResourceMark rm;
+  int total = 0;
+  int archivable = 0;
+  LogStreamHandle(Debug, cds, nmethod) log;
+  NMethodIterator iter(NMethodIterator::only_alive_and_not_unloading);
+  while (iter.next()) {
+    nmethod* nm = iter.method();
+    if (!nm->is_in_use() || !nm->is_compiled_by_c2() || nm->is_osr_method()) {
+      continue;
+    }
+    total++;
+    const char* reason = archive_incompatibility(nm);
+    if (reason == NULL) {
+      archivable++;
+    } else if (log.is_enabled()) {
+      log.print_cr("Not archivable: %s: %s", nm->method()->name_and_sig_as_C_string(), reason);
+    }
+  }
+  log_info(cds, nmethod)("%d of %d C2 compiled methods could be archived", archivable, total);
+}
+
 class VM_PopulateDynamicDumpSharedSpace: public VM_GC_Sync_Operation {
   DynamicArchiveBuilder builder;
 public:
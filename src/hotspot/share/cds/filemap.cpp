@@ -40,6 +40,8 @@
 #include "classfile/systemDictionaryShared.hpp"
 #include "classfile/vmClasses.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "logging/logMessage.hpp"
@@ -54,6 +56,7 @@
 #include "oops/oop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/java.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
@@ -1686,6 +1689,38 @@ char* FileMapInfo::map_bitmap_region() {
   return bitmap_base;
 }
 
+// Relocates the pointers marked in the archive pointer bitmap, with the
+// workers claiming fixed-size slices of the bitmap. SharedDataRelocator has
+// no mutable state, so a single instance is shared by all workers.
+class SharedDataRelocationTask : public AbstractGangTask {
+  // 64K bits cover 512KB of archive space on 64-bit platforms.
+  static const BitMap::idx_t SliceSizeInBits = 64 * K;
+
+  BitMapView* _ptrmap;
+  SharedDataRelocator* _patcher;
+  volatile BitMap::idx_t _next_slice;
+
+ public:
+  SharedDataRelocationTask(BitMapView* ptrmap, SharedDataRelocator* patcher) :
+    AbstractGangTask("Shared Data Relocation"),
+    _ptrmap(ptrmap), _patcher(patcher), _next_slice(0) { }
+
+  static bool should_run_in_parallel(BitMap::idx_t size_in_bits) {
+    return size_in_bits > 2 * SliceSizeInBits;
+  }
+
+  void work(uint worker_id) {
+    BitMap::idx_t size = _ptrmap->size();
+    while (true) {
+      BitMap::idx_t beg = Atomic::fetch_and_add(&_next_slice, SliceSizeInBits);
+      if (beg >= size) {
+        return;
+      }
+      _ptrmap->iterate(_patcher, beg, MIN2(beg + SliceSizeInBits, size));
+    }
+  }
+};
+
 // This is called when we cannot map the archive at the requested[ base address (usually 0x800000000).
 // We relocate all pointers in the 2 core regions (ro, rw).
 bool FileMapInfo::relocate_pointers_in_core_regions(intx addr_delta) {
@@ -1718,7 +1753,23 @@ bool FileMapInfo::relocate_pointers_in_core_regions(intx addr_delta) {
 
     SharedDataRelocator patcher((address*)patch_base, (address*)patch_end, valid_old_base, valid_old_end,
                                 valid_new_base, valid_new_end, addr_delta);
-    ptrmap.iterate(&patcher);
+
+    // The relocation is done very early during VM start-up, but after the
+    // heap has been initialized, so the GC worker threads can be used.
+    jlong start = os::javaTimeNanos();
+    uint num_workers = 1;
+    WorkGang* workers = UseParallelArchiveRelocation ? Universe::heap()->safepoint_workers() : NULL;
+    if (workers != NULL && SharedDataRelocationTask::should_run_in_parallel(ptrmap_size_in_bits)) {
+      SharedDataRelocationTask task(&ptrmap, &patcher);
+      num_workers = workers->total_workers();
+      workers->run_task(&task, num_workers);
+    } else {
+      ptrmap.iterate(&patcher);
+    }
+    log_info(cds)("Relocated %s archive pointers by " INTX_FORMAT " bytes in %.3f ms using %u thread%s",
+                  is_static() ? "static" : "dynamic", addr_delta,
+                  (double)(os::javaTimeNanos() - start) / NANOSECS_PER_MILLISEC,
+                  num_workers, num_workers > 1 ? "s" : "");
 
     // The MetaspaceShared::bm region will be unmapped in MetaspaceShared::initialize_shared_spaces().
 
@@ -1753,6 +1804,9 @@ static MemRegion *closed_archive_heap_ranges = NULL;
 static MemRegion *open_archive_heap_ranges = NULL;
 static int num_closed_archive_heap_ranges = 0;
 static int num_open_archive_heap_ranges = 0;
+// Heap space allocated by load_heap_regions() that could not be filled
+// with archived objects, and must be made parseable by fixup_mapped_heap_regions().
+static MemRegion unused_loaded_archive_space;
 
 #if INCLUDE_CDS_JAVA_HEAP
 bool FileMapInfo::has_heap_regions() {
@@ -1920,9 +1974,121 @@ void FileMapInfo::map_heap_regions_impl() {
   }
 }
 
+//
+// Load the closed and open archive heap objects into the runtime java heap.
+//
+// Collectors other than G1 cannot map the archived heap regions at a fixed
+// location. For those collectors that support it, a single block of the
+// old generation is allocated and the contents of all archived heap regions
+// are read into it, one after another. The loaded objects are ordinary heap
+// objects: the GC is free to move or collect them, so there is no distinction
+// between the closed and the open regions after loading. The embedded
+// pointers are always patched, using the dump-time to loaded address
+// translation recorded in HeapShared::add_loaded_region().
+void FileMapInfo::load_heap_regions() {
+  if (narrow_klass_base() != CompressedKlassPointers::base() ||
+      narrow_klass_shift() != CompressedKlassPointers::shift()) {
+    log_info(cds)("CDS heap data cannot be loaded because the archive was created with an incompatible narrow klass encoding mode.");
+    return;
+  }
+  if (map_bitmap_region() == NULL) {
+    log_info(cds)("CDS heap data cannot be loaded because the bitmap region cannot be mapped.");
+    return;
+  }
+
+  // Decode the region bases with the dump-time encoding, before any loaded
+  // region is registered with HeapShared.
+  HeapShared::init_narrow_oop_decoding(narrow_oop_base(), narrow_oop_shift());
+  address dumptime_bases[MetaspaceShared::last_valid_region + 1];
+  size_t total_bytes = 0;
+  for (int i = MetaspaceShared::first_closed_archive_heap_region;
+           i <= MetaspaceShared::last_valid_region; i++) {
+    FileMapRegion* si = space_at(i);
+    dumptime_bases[i] = si->used() > 0 ? start_address_as_decoded_from_archive(si) : NULL;
+    total_bytes += si->used();
+  }
+  assert(total_bytes > 0, "must have at least one used heap region");
+
+  HeapWord* loaded_base = Universe::heap()->allocate_loaded_archive_space(total_bytes / HeapWordSize);
+  if (loaded_base == NULL) {
+    log_info(cds)("CDS heap data cannot be loaded because " SIZE_FORMAT " bytes cannot be allocated in the java heap.",
+                  total_bytes);
+    return;
+  }
+  MemRegion loaded_heap(loaded_base, total_bytes / HeapWordSize);
+
+  closed_archive_heap_ranges = MemRegion::create_array(MetaspaceShared::max_closed_archive_heap_region, mtInternal);
+  open_archive_heap_ranges = MemRegion::create_array(MetaspaceShared::max_open_archive_heap_region, mtInternal);
+
+  // The used regions of each kind form a prefix, as they are written at dump
+  // time, so a range is stored at the index of its region within its kind,
+  // as with the mapped regions.
+  address loaded_bases[MetaspaceShared::last_valid_region + 1];
+  char* addr = (char*)loaded_base;
+  for (int i = MetaspaceShared::first_closed_archive_heap_region;
+           i <= MetaspaceShared::last_valid_region; i++) {
+    FileMapRegion* si = space_at(i);
+    size_t size = si->used();
+    loaded_bases[i] = NULL;
+    if (size == 0) {
+      continue;
+    }
+    log_info(cds)("Loading heap data: region[%d] at " INTPTR_FORMAT ", size = " SIZE_FORMAT_W(8) " bytes",
+                  i, p2i(addr), size);
+    if (lseek(_fd, (long)si->file_offset(), SEEK_SET) != (int)si->file_offset() ||
+        read_bytes(addr, size) != size ||
+        (VerifySharedSpaces && !region_crc_check(addr, size, si->crc()))) {
+      log_info(cds)("UseSharedSpaces: Unable to load heap region %d", i);
+      unused_loaded_archive_space = loaded_heap;
+      MemRegion::destroy_array(closed_archive_heap_ranges, MetaspaceShared::max_closed_archive_heap_region);
+      MemRegion::destroy_array(open_archive_heap_ranges, MetaspaceShared::max_open_archive_heap_region);
+      closed_archive_heap_ranges = NULL;
+      open_archive_heap_ranges = NULL;
+      num_closed_archive_heap_ranges = 0;
+      num_open_archive_heap_ranges = 0;
+      return;
+    }
+    MemRegion r((HeapWord*)addr, size / HeapWordSize);
+    if (i <= MetaspaceShared::last_closed_archive_heap_region) {
+      int idx = i - MetaspaceShared::first_closed_archive_heap_region;
+      assert(idx == num_closed_archive_heap_ranges, "used closed regions must be a prefix");
+      closed_archive_heap_ranges[idx] = r;
+      num_closed_archive_heap_ranges = idx + 1;
+    } else {
+      int idx = i - MetaspaceShared::first_open_archive_heap_region;
+      assert(idx == num_open_archive_heap_ranges, "used open regions must be a prefix");
+      open_archive_heap_ranges[idx] = r;
+      num_open_archive_heap_ranges = idx + 1;
+    }
+    loaded_bases[i] = (address)addr;
+    addr += size;
+  }
+
+  for (int i = MetaspaceShared::first_closed_archive_heap_region;
+           i <= MetaspaceShared::last_valid_region; i++) {
+    if (loaded_bases[i] != NULL) {
+      HeapShared::add_loaded_region(dumptime_bases[i], space_at(i)->used(), loaded_bases[i]);
+    }
+  }
+
+  // The loaded objects still contain narrowOops encoded at dump time.
+  _heap_pointers_need_patching = true;
+  HeapShared::set_loaded_heap(loaded_heap);
+  HeapShared::set_roots(header()->heap_obj_roots());
+  log_info(cds)("Loaded " SIZE_FORMAT " bytes of CDS heap data at " INTPTR_FORMAT,
+                total_bytes, p2i(loaded_base));
+}
+
 void FileMapInfo::map_heap_regions() {
   if (has_heap_regions()) {
-    map_heap_regions_impl();
+    if (HeapShared::is_heap_object_archiving_allowed()) {
+      map_heap_regions_impl();
+    } else if (HeapShared::can_load()) {
+      load_heap_regions();
+    } else {
+      log_info(cds)("CDS heap data is being ignored. UseCompressedOops and UseCompressedClassPointers "
+                    "are required, and the collector must support mapping or loading the archived heap.");
+    }
   }
 
   if (!HeapShared::closed_archive_heap_region_mapped()) {
@@ -2048,6 +2214,18 @@ void FileMapInfo::patch_archived_heap_embedded_pointers(MemRegion* ranges, int n
 // must be called after the Object_klass is loaded
 void FileMapInfo::fixup_mapped_heap_regions() {
   assert(vmClasses::Object_klass_loaded(), "must be");
+  if (!unused_loaded_archive_space.is_empty()) {
+    CollectedHeap::fill_with_objects(unused_loaded_archive_space.start(),
+                                     unused_loaded_archive_space.word_size());
+    Universe::heap()->complete_loaded_archive_space(unused_loaded_archive_space);
+    unused_loaded_archive_space = MemRegion();
+    return;
+  }
+  if (HeapShared::is_loaded()) {
+    // The loaded objects are contiguous and parseable; there are no gaps to fill.
+    Universe::heap()->complete_loaded_archive_space(HeapShared::loaded_heap());
+    return;
+  }
   // If any closed regions were found, call the fill routine to make them parseable.
   // Note that closed_archive_heap_ranges may be non-NULL even if no ranges were found.
   if (num_closed_archive_heap_ranges != 0) {
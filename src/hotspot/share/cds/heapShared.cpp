@@ -72,6 +72,11 @@ bool HeapShared::_open_archive_heap_region_mapped = false;
 bool HeapShared::_archive_heap_region_fixed = false;
 address   HeapShared::_narrow_oop_base;
 int       HeapShared::_narrow_oop_shift;
+uintptr_t HeapShared::_loaded_region_dumptime_base[MAX_LOADED_REGIONS];
+size_t    HeapShared::_loaded_region_byte_size[MAX_LOADED_REGIONS];
+intx      HeapShared::_loaded_region_runtime_offset[MAX_LOADED_REGIONS];
+int       HeapShared::_num_loaded_regions = 0;
+MemRegion HeapShared::_loaded_heap;
 DumpedInternedStrings *HeapShared::_dumped_interned_strings = NULL;
 
 //
@@ -434,6 +439,34 @@ void HeapShared::init_narrow_oop_decoding(address base, int shift) {
   _narrow_oop_shift = shift;
 }
 
+bool HeapShared::can_load() {
+  return UseCompressedOops && UseCompressedClassPointers &&
+         Universe::heap()->can_load_archived_objects();
+}
+
+void HeapShared::add_loaded_region(address dumptime_base, size_t byte_size, address runtime_base) {
+  assert(_num_loaded_regions < MAX_LOADED_REGIONS, "too many loaded regions");
+  // Keep the regions sorted by decreasing dump-time base, so that the first
+  // region whose base is not above an address is the one that contains it.
+  int i = _num_loaded_regions++;
+  while (i > 0 && _loaded_region_dumptime_base[i - 1] < (uintptr_t)dumptime_base) {
+    _loaded_region_dumptime_base[i] = _loaded_region_dumptime_base[i - 1];
+    _loaded_region_byte_size[i] = _loaded_region_byte_size[i - 1];
+    _loaded_region_runtime_offset[i] = _loaded_region_runtime_offset[i - 1];
+    i--;
+  }
+  _loaded_region_dumptime_base[i] = (uintptr_t)dumptime_base;
+  _loaded_region_byte_size[i] = byte_size;
+  _loaded_region_runtime_offset[i] = runtime_base - dumptime_base;
+}
+
+void HeapShared::set_loaded_heap(MemRegion loaded_heap) {
+  assert(_num_loaded_regions > 0, "must have loaded regions");
+  _loaded_heap = loaded_heap;
+  set_closed_archive_heap_region_mapped();
+  set_open_archive_heap_region_mapped();
+}
+
 //
 // Subgraph archiving support
 //
@@ -230,6 +230,20 @@ private:
   static address _narrow_oop_base;
   static int     _narrow_oop_shift;
 
+  // When the archived heap regions are loaded (copied) into the heap instead
+  // of being mapped, each region is placed at an address unrelated to its
+  // dump-time address. decode_from_archive uses these entries to translate
+  // the dump-time address of an archived object to its loaded address.
+  static const int MAX_LOADED_REGIONS = MetaspaceShared::max_closed_archive_heap_region +
+                                        MetaspaceShared::max_open_archive_heap_region;
+  static uintptr_t _loaded_region_dumptime_base[MAX_LOADED_REGIONS];
+  static size_t    _loaded_region_byte_size[MAX_LOADED_REGIONS];
+  static intx      _loaded_region_runtime_offset[MAX_LOADED_REGIONS];
+  static int       _num_loaded_regions;
+  static MemRegion _loaded_heap;
+
+  inline static uintptr_t dumptime_to_loaded_address(uintptr_t dumptime_addr);
+
   typedef ResourceHashtable<oop, bool,
       HeapShared::oop_hash,
       HeapShared::oop_equals,
@@ -382,6 +396,20 @@ private:
     return closed_archive_heap_region_mapped() && open_archive_heap_region_mapped();
   }
 
+  // Can the archived heap regions be loaded (copied) into the heap of a
+  // collector that does not support mapping them?
+  static bool can_load() NOT_CDS_JAVA_HEAP_RETURN_(false);
+  static void add_loaded_region(address dumptime_base, size_t byte_size, address runtime_base) NOT_CDS_JAVA_HEAP_RETURN;
+  static void set_loaded_heap(MemRegion loaded_heap) NOT_CDS_JAVA_HEAP_RETURN;
+  static bool is_loaded() {
+    CDS_JAVA_HEAP_ONLY(return !_loaded_heap.is_empty();)
+    NOT_CDS_JAVA_HEAP_RETURN_(false);
+  }
+  static MemRegion loaded_heap() {
+    CDS_JAVA_HEAP_ONLY(return _loaded_heap;)
+    NOT_CDS_JAVA_HEAP_RETURN_(MemRegion());
+  }
+
   static void fixup_mapped_heap_regions() NOT_CDS_JAVA_HEAP_RETURN;
 
   inline static bool is_archived_object(oop p) NOT_CDS_JAVA_HEAP_RETURN_(false);
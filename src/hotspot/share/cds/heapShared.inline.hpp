@@ -37,9 +37,26 @@ bool HeapShared::is_archived_object(oop p) {
   return Universe::heap()->is_archived_object(p);
 }
 
+// The regions are sorted by decreasing dump-time base, and there are at most
+// MAX_LOADED_REGIONS of them, so this takes a few compares.
+inline uintptr_t HeapShared::dumptime_to_loaded_address(uintptr_t dumptime_addr) {
+  int i = 0;
+  while (dumptime_addr < _loaded_region_dumptime_base[i]) {
+    i++;
+    assert(i < _num_loaded_regions, "archived object " INTPTR_FORMAT " is below the loaded regions", dumptime_addr);
+  }
+  assert(dumptime_addr < _loaded_region_dumptime_base[i] + _loaded_region_byte_size[i],
+         "archived object " INTPTR_FORMAT " is not in any loaded region", dumptime_addr);
+  return dumptime_addr + _loaded_region_runtime_offset[i];
+}
+
 inline oop HeapShared::decode_from_archive(narrowOop v) {
   assert(!CompressedOops::is_null(v), "narrow oop value can never be zero");
-  oop result = cast_to_oop((uintptr_t)_narrow_oop_base + ((uintptr_t)v << _narrow_oop_shift));
+  uintptr_t p = (uintptr_t)_narrow_oop_base + ((uintptr_t)v << _narrow_oop_shift);
+  if (_num_loaded_regions > 0) {
+    p = dumptime_to_loaded_address(p);
+  }
+  oop result = cast_to_oop(p);
   assert(is_object_aligned(result), "address not aligned: " INTPTR_FORMAT, p2i((void*) result));
   return result;
 }
@@ -656,39 +656,41 @@ void MetaspaceShared::preload_and_dump() {
   }
 }
 
-void MetaspaceShared::preload_classes(TRAPS) {
-  char default_classlist[JVM_MAXPATHLEN];
-  const char* classlist_path;
-
-  if (SharedClassListFile == NULL) {
-    // Construct the path to the class list (in jre/lib)
-    // Walk up two directories from the location of the VM and
-    // optionally tack on "lib" (depending on platform)
-    os::jvm_path(default_classlist, sizeof(default_classlist));
-    for (int i = 0; i < 3; i++) {
-      char *end = strrchr(default_classlist, *os::file_separator());
-      if (end != NULL) *end = '\0';
-    }
-    int classlist_path_len = (int)strlen(default_classlist);
-    if (classlist_path_len >= 3) {
-      if (strcmp(default_classlist + classlist_path_len - 3, "lib") != 0) {
-        if (classlist_path_len < JVM_MAXPATHLEN - 4) {
-          jio_snprintf(default_classlist + classlist_path_len,
-                       sizeof(default_classlist) - classlist_path_len,
-                       "%slib", os::file_separator());
-          classlist_path_len += 4;
-        }
+const char* MetaspaceShared::classlist_path(char* buf, size_t buf_len) {
+  if (SharedClassListFile != NULL) {
+    return SharedClassListFile;
+  }
+  // Construct the path to the class list (in jre/lib)
+  // Walk up two directories from the location of the VM and
+  // optionally tack on "lib" (depending on platform)
+  os::jvm_path(buf, (jint)buf_len);
+  for (int i = 0; i < 3; i++) {
+    char *end = strrchr(buf, *os::file_separator());
+    if (end != NULL) *end = '\0';
+  }
+  size_t classlist_path_len = strlen(buf);
+  if (classlist_path_len >= 3) {
+    if (strcmp(buf + classlist_path_len - 3, "lib") != 0) {
+      if (classlist_path_len < buf_len - 4) {
+        jio_snprintf(buf + classlist_path_len,
+                     buf_len - classlist_path_len,
+                     "%slib", os::file_separator());
+        classlist_path_len += 4;
       }
     }
-    if (classlist_path_len < JVM_MAXPATHLEN - 10) {
-      jio_snprintf(default_classlist + classlist_path_len,
-                   sizeof(default_classlist) - classlist_path_len,
-                   "%sclasslist", os::file_separator());
-    }
-    classlist_path = default_classlist;
-  } else {
-    classlist_path = SharedClassListFile;
   }
+  if (classlist_path_len < buf_len - 10) {
+    jio_snprintf(buf + classlist_path_len,
+                 buf_len - classlist_path_len,
+                 "%sclasslist", os::file_separator());
+  }
+  return buf;
+}
+
+void MetaspaceShared::preload_classes(TRAPS) {
+  char default_classlist[JVM_MAXPATHLEN];
+  const char* classlist_path = MetaspaceShared::classlist_path(default_classlist,
+                                                               sizeof(default_classlist));
 
   log_info(cds)("Loading classes to share ...");
   _has_error_classes = false;
@@ -78,6 +78,8 @@ class MetaspaceShared : AllStatic {
 
   static void prepare_for_dumping() NOT_CDS_RETURN;
   static void preload_and_dump() NOT_CDS_RETURN;
+  // The class list to use: SharedClassListFile or the classlist of the JDK.
+  static const char* classlist_path(char* buf, size_t buf_len) NOT_CDS_RETURN_(NULL);
 
 private:
   static void preload_and_dump_impl(TRAPS) NOT_CDS_RETURN;
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/backgroundVerifier.hpp"
+#include "classfile/classLoaderData.inline.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/verifier.hpp"
+#include "classfile/vmClasses.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/java.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
+
+GrowableArray<InstanceKlass*>* BackgroundVerifier::_queue = NULL;
+int BackgroundVerifier::_next = 0;
+
+void BackgroundVerifier::initialize() {
+  assert(BackgroundVerificationThreads > 0, "sanity");
+  EXCEPTION_MARK;
+
+  {
+    MutexLocker ml(BackgroundVerifier_lock, Mutex::_no_safepoint_check_flag);
+    _queue = new (ResourceObj::C_HEAP, mtClass) GrowableArray<InstanceKlass*>(256, mtClass);
+  }
+
+  for (uint i = 0; i < BackgroundVerificationThreads; i++) {
+    char name[64];
+    jio_snprintf(name, sizeof(name), "Background Verifier Thread#%u", i);
+    Handle string = java_lang_String::create_from_str(name, CHECK);
+
+    // Initialize thread_oop to put it into the system threadGroup
+    Handle thread_group (THREAD, Universe::system_thread_group());
+    Handle thread_oop = JavaCalls::construct_new_instance(
+                            vmClasses::Thread_klass(),
+                            vmSymbols::threadgroup_string_void_signature(),
+                            thread_group,
+                            string,
+                            CHECK);
+
+    MutexLocker mu(THREAD, Threads_lock);
+    BackgroundVerifierThread* thread = new BackgroundVerifierThread(&background_verifier_thread_entry);
+
+    if (thread == NULL || thread->osthread() == NULL) {
+      vm_exit_during_initialization("java.lang.OutOfMemoryError",
+                                    os::native_thread_creation_failed_msg());
+    }
+
+    java_lang_Thread::set_thread(thread_oop(), thread);
+    java_lang_Thread::set_priority(thread_oop(), NormPriority);
+    java_lang_Thread::set_daemon(thread_oop());
+    thread->set_threadObj(thread_oop());
+
+    Threads::add(thread);
+    Thread::start(thread);
+  }
+}
+
+// Only classes of the platform and the default application loaders are
+// queued: those loaders are parallel capable, so linking on another thread
+// cannot deadlock on a loader lock, and they are never unloaded, so the queue
+// needs no handles. A custom system loader (-Djava.system.class.loader) may
+// be neither, so the application loader is recognized by its class.
+static bool is_queued_loader(ClassLoaderData* loader_data) {
+  if (loader_data->is_platform_class_loader_data()) {
+    return true;
+  }
+  oop loader = loader_data->class_loader();
+  return loader != NULL &&
+         loader->klass() == vmClasses::jdk_internal_loader_ClassLoaders_AppClassLoader_klass();
+}
+
+// Linking posts the JVMTI ClassPrepare event on the linking thread, which
+// agents expect to be the thread that loaded the class. Classes are not
+// linked in the background while that event is enabled.
+void BackgroundVerifier::enqueue(InstanceKlass* ik) {
+  if (ik->is_shared() || ik->is_linked() ||
+      JvmtiExport::should_post_class_prepare() ||
+      !is_queued_loader(ik->class_loader_data()) ||
+      !Verifier::should_verify_for(ik->class_loader(), true)) {
+    return;
+  }
+  MonitorLocker ml(BackgroundVerifier_lock, Mutex::_no_safepoint_check_flag);
+  if (_queue != NULL) {
+    _queue->append(ik);
+    ml.notify();
+  }
+}
+
+InstanceKlass* BackgroundVerifier::dequeue(JavaThread* current) {
+  // Need state transition ThreadBlockInVM so that this thread
+  // will be handled by safepoint correctly when this thread is
+  // notified at a safepoint.
+  ThreadBlockInVM tbivm(current);
+
+  MonitorLocker ml(BackgroundVerifier_lock, Mutex::_no_safepoint_check_flag);
+  while (_next == _queue->length()) {
+    _queue->clear();
+    _next = 0;
+    ml.wait();
+  }
+  return _queue->at(_next++);
+}
+
+void BackgroundVerifier::background_verifier_thread_entry(JavaThread* jt, TRAPS) {
+  while (true) {
+    InstanceKlass* ik = dequeue(jt);
+    if (!ik->is_linked() && !JvmtiExport::should_post_class_prepare()) {
+      ik->link_class(THREAD);
+      if (HAS_PENDING_EXCEPTION) {
+        CLEAR_PENDING_EXCEPTION;
+      }
+    }
+  }
+}
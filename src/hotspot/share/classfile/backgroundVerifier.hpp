@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_CLASSFILE_BACKGROUNDVERIFIER_HPP
+#define SHARE_CLASSFILE_BACKGROUNDVERIFIER_HPP
+
+#include "memory/allStatic.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/growableArray.hpp"
+
+class InstanceKlass;
+
+// Links (and so verifies) classes defined by the platform and the default
+// application class loaders on a small pool of JavaThreads, so that a thread
+// which later needs one of these classes usually finds it already linked.
+// Linking errors are discarded here; the thread that actually needs the class
+// links it again and sees the error as usual.
+
+class BackgroundVerifier : AllStatic {
+ private:
+  static GrowableArray<InstanceKlass*>* _queue;
+  static int _next;
+
+  static InstanceKlass* dequeue(JavaThread* current);
+
+ public:
+  static void initialize();
+  static void enqueue(InstanceKlass* ik);
+
+  static void background_verifier_thread_entry(JavaThread* thread, TRAPS);
+};
+
+class BackgroundVerifierThread : public JavaThread {
+  friend class BackgroundVerifier;
+ private:
+  BackgroundVerifierThread(ThreadFunction entry_point) : JavaThread(entry_point) {};
+};
+
+#endif // SHARE_CLASSFILE_BACKGROUNDVERIFIER_HPP
@@ -5374,6 +5374,11 @@ void ClassFileParser::fill_instance_klass(InstanceKlass* ik,
   // Initialize itable offset tables
   klassItable::setup_itable_offset_table(ik);
 
+  if (UseItableSelectorTable && ik->is_interface()) {
+    // Selects the slot of this interface in the selector tables of its implementors
+    ik->set_itable_selector(StressItableSelectorCollisions ? 0 : (juint)os::random());
+  }
+
   // Compute transitive closure of interfaces this class implements
   // Do final class setup
   OopMapBlocksBuilder* oop_map_blocks = _field_info->oop_map_blocks;
@@ -31,6 +31,7 @@
 #include "classfile/classLoaderData.inline.hpp"
 #include "classfile/classLoaderExt.hpp"
 #include "classfile/classLoadInfo.hpp"
+#include "classfile/classPrefetcher.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
 #include "classfile/modules.hpp"
@@ -107,6 +108,7 @@ static JImageOpen_t                    JImageOpen             = NULL;
 static JImageClose_t                   JImageClose            = NULL;
 static JImageFindResource_t            JImageFindResource     = NULL;
 static JImageGetResource_t             JImageGetResource      = NULL;
+static JImagePrefetchResources_t       JImagePrefetchResources = NULL;
 
 // JimageFile pointer, or null if exploded JDK build.
 static JImageFile*                     JImage_file            = NULL;
@@ -123,6 +125,8 @@ PerfCounter*    ClassLoader::_perf_class_verify_selftime = NULL;
 PerfCounter*    ClassLoader::_perf_classes_linked = NULL;
 PerfCounter*    ClassLoader::_perf_class_link_time = NULL;
 PerfCounter*    ClassLoader::_perf_class_link_selftime = NULL;
+PerfCounter*    ClassLoader::_perf_itables_deferred = NULL;
+PerfCounter*    ClassLoader::_perf_deferred_itables_initialized = NULL;
 PerfCounter*    ClassLoader::_perf_sys_class_lookup_time = NULL;
 PerfCounter*    ClassLoader::_perf_shared_classload_time = NULL;
 PerfCounter*    ClassLoader::_perf_sys_classload_time = NULL;
@@ -435,6 +439,16 @@ JImageLocationRef ClassLoader::jimage_find_resource(JImageFile* jf,
   return ((*JImageFindResource)(jf, module_name, get_jimage_version_string(), file_name, &size));
 }
 
+void ClassLoader::jimage_get_resource(JImageFile* jf, JImageLocationRef location,
+                                      char* buf, jlong size) {
+  (*JImageGetResource)(jf, location, buf, size);
+}
+
+jint ClassLoader::jimage_prefetch_resources(JImageFile* jf, const JImageLocationRef* locations,
+                                            jint count) {
+  return (*JImagePrefetchResources)(jf, locations, count);
+}
+
 bool ClassPathImageEntry::is_modules_image() const {
   assert(this == _singleton, "VM supports a single jimage");
   assert(this == (ClassPathImageEntry*)ClassLoader::get_jrt_entry(), "must be used for jrt entry");
@@ -968,6 +982,7 @@ void ClassLoader::load_jimage_library() {
   JImageClose = CAST_TO_FN_PTR(JImageClose_t, dll_lookup(handle, "JIMAGE_Close", path));
   JImageFindResource = CAST_TO_FN_PTR(JImageFindResource_t, dll_lookup(handle, "JIMAGE_FindResource", path));
   JImageGetResource = CAST_TO_FN_PTR(JImageGetResource_t, dll_lookup(handle, "JIMAGE_GetResource", path));
+  JImagePrefetchResources = CAST_TO_FN_PTR(JImagePrefetchResources_t, dll_lookup(handle, "JIMAGE_PrefetchResources", path));
 }
 
 int ClassLoader::crc32(int crc, const char* buf, int len) {
@@ -1148,6 +1163,7 @@ InstanceKlass* ClassLoader::load_class(Symbol* name, bool search_append_only, TR
   ClassFileStream* stream = NULL;
   s2 classpath_index = 0;
   ClassPathEntry* e = NULL;
+  u1* prefetched = NULL;
 
   // If search_append_only is true, boot loader visibility boundaries are
   // set to be _first_append_entry to the end. This includes:
@@ -1185,7 +1201,23 @@ InstanceKlass* ClassLoader::load_class(Symbol* name, bool search_append_only, TR
   if (!search_append_only && (NULL == stream)) {
     if (has_jrt_entry()) {
       e = _jrt_entry;
-      stream = _jrt_entry->open_stream(THREAD, file_name);
+      // The ClassPrefetcher looks up names the same way as the first
+      // JImageFindResource call in open_stream(), so what it read can be
+      // used as is.
+      jlong size;
+      prefetched = ClassPrefetcher::take(file_name, &size);
+      if (prefetched != NULL) {
+        if (UsePerfData) {
+          ClassLoader::perf_sys_classfile_bytes_read()->inc(size);
+        }
+        stream = new ClassFileStream(prefetched,
+                                     (int)size,
+                                     _jrt_entry->name(),
+                                     ClassFileStream::verify,
+                                     true); // from_boot_loader_modules_image
+      } else {
+        stream = _jrt_entry->open_stream(THREAD, file_name);
+      }
     } else {
       // Exploded build - attempt to locate class in its defining module's location.
       assert(_exploded_entries != NULL, "No exploded build entries present");
@@ -1226,7 +1258,14 @@ InstanceKlass* ClassLoader::load_class(Symbol* name, bool search_append_only, TR
                                                            name,
                                                            loader_data,
                                                            cl_info,
-                                                           CHECK_NULL);
+                                                           THREAD);
+  if (prefetched != NULL) {
+    // The parser copies what it keeps of the class file.
+    FREE_C_HEAP_ARRAY(u1, prefetched);
+  }
+  if (HAS_PENDING_EXCEPTION) {
+    return NULL;
+  }
   result->set_classpath_index(classpath_index);
   return result;
 }
@@ -1381,6 +1420,8 @@ void ClassLoader::initialize(TRAPS) {
     NEWPERFEVENTCOUNTER(_perf_classes_inited, SUN_CLS, "initializedClasses");
     NEWPERFEVENTCOUNTER(_perf_classes_linked, SUN_CLS, "linkedClasses");
     NEWPERFEVENTCOUNTER(_perf_classes_verified, SUN_CLS, "verifiedClasses");
+    NEWPERFEVENTCOUNTER(_perf_itables_deferred, SUN_CLS, "deferredItables");
+    NEWPERFEVENTCOUNTER(_perf_deferred_itables_initialized, SUN_CLS, "deferredItablesInitialized");
 
     NEWPERFTICKCOUNTER(_perf_sys_class_lookup_time, SUN_CLS, "lookupSysClassTime");
     NEWPERFTICKCOUNTER(_perf_shared_classload_time, SUN_CLS, "sharedClassLoadTime");
@@ -1534,6 +1575,8 @@ void ClassLoader::classLoader_init2(JavaThread* current) {
     _exploded_entries = new (ResourceObj::C_HEAP, mtModule)
       GrowableArray<ModuleClassPathList*>(EXPLODED_ENTRY_SIZE, mtModule);
     add_to_exploded_build_list(current, vmSymbols::java_base());
+  } else {
+    ClassPrefetcher::initialize();
   }
 }
 
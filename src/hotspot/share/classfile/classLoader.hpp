@@ -169,6 +169,8 @@ class ClassLoader: AllStatic {
   static PerfCounter* _perf_classes_linked;
   static PerfCounter* _perf_class_link_time;
   static PerfCounter* _perf_class_link_selftime;
+  static PerfCounter* _perf_itables_deferred;
+  static PerfCounter* _perf_deferred_itables_initialized;
   static PerfCounter* _perf_sys_class_lookup_time;
   static PerfCounter* _perf_shared_classload_time;
   static PerfCounter* _perf_sys_classload_time;
@@ -287,6 +289,8 @@ class ClassLoader: AllStatic {
   static PerfCounter* perf_classes_linked()           { return _perf_classes_linked; }
   static PerfCounter* perf_class_link_time()          { return _perf_class_link_time; }
   static PerfCounter* perf_class_link_selftime()      { return _perf_class_link_selftime; }
+  static PerfCounter* perf_itables_deferred()         { return _perf_itables_deferred; }
+  static PerfCounter* perf_deferred_itables_initialized() { return _perf_deferred_itables_initialized; }
   static PerfCounter* perf_sys_class_lookup_time()    { return _perf_sys_class_lookup_time; }
   static PerfCounter* perf_shared_classload_time()    { return _perf_shared_classload_time; }
   static PerfCounter* perf_sys_classload_time()       { return _perf_sys_classload_time; }
@@ -372,6 +376,10 @@ class ClassLoader: AllStatic {
 
   static JImageLocationRef jimage_find_resource(JImageFile* jf, const char* module_name,
                                                 const char* file_name, jlong &size);
+  static void jimage_get_resource(JImageFile* jf, JImageLocationRef location,
+                                  char* buf, jlong size);
+  static jint jimage_prefetch_resources(JImageFile* jf, const JImageLocationRef* locations,
+                                        jint count);
 
   static void  trace_class_path(const char* msg, const char* name = NULL);
 
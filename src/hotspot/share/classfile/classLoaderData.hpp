@@ -99,6 +99,7 @@ class ClassLoaderData : public CHeapObj<mtClass> {
 
   friend class ClassLoaderDataGraph;
   friend class ClassLoaderDataGraphIterator;
+  friend class ClassLoaderDataGraphCLDIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorStatic;
   friend class ClassLoaderDataGraphMetaspaceIterator;
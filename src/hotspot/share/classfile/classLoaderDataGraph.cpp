@@ -571,7 +571,11 @@ void ClassLoaderDataGraph::purge(bool at_safepoint) {
     classes_unloaded = true;
   }
   if (classes_unloaded) {
-    Metaspace::purge();
+    if (MetaspaceUncommitDelay > 0) {
+      Metaspace::request_purge();
+    } else {
+      Metaspace::purge();
+    }
     set_metaspace_oom(false);
   }
   DependencyContext::purge_dependency_contexts();
@@ -662,6 +666,37 @@ Klass* ClassLoaderDataGraphKlassIteratorAtomic::next_klass() {
   return NULL;
 }
 
+ClassLoaderDataGraphCLDIteratorAtomic::ClassLoaderDataGraphCLDIteratorAtomic()
+    : _next_cld(ClassLoaderDataGraph::_head) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+}
+
+ClassLoaderData* ClassLoaderDataGraphCLDIteratorAtomic::next_cld() {
+  ClassLoaderData* head = Atomic::load(&_next_cld);
+
+  while (head != NULL) {
+    ClassLoaderData* old_head = Atomic::cmpxchg(&_next_cld, head, head->next());
+
+    if (old_head == head) {
+      return head; // Won the CAS.
+    }
+
+    head = old_head;
+  }
+
+  // Nothing more for the iterator to hand out.
+  return NULL;
+}
+
+void ClassLoaderDataGraphCLDIteratorAtomic::roots_cld_do(CLDClosure* strong, CLDClosure* weak) {
+  while (ClassLoaderData* cld = next_cld()) {
+    CLDClosure* closure = cld->keep_alive() ? strong : weak;
+    if (closure != NULL) {
+      closure->do_cld(cld);
+    }
+  }
+}
+
 void ClassLoaderDataGraph::verify() {
   ClassLoaderDataGraphIterator iter;
   while (ClassLoaderData* cld = iter.get_next()) {
@@ -37,6 +37,7 @@ class ClassLoaderDataGraph : public AllStatic {
   friend class ClassLoaderDataGraphMetaspaceIterator;
   friend class ClassLoaderDataGraphKlassIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorStatic;
+  friend class ClassLoaderDataGraphCLDIteratorAtomic;
   friend class ClassLoaderDataGraphIterator;
   friend class VMStructs;
  private:
@@ -162,4 +163,17 @@ class ClassLoaderDataGraphKlassIteratorAtomic : public StackObj {
   static Klass* next_klass_in_cldg(Klass* klass);
 };
 
+// An iterator that distributes ClassLoaderDatas to parallel worker threads.
+// Must be created and used at a safepoint.
+class ClassLoaderDataGraphCLDIteratorAtomic : public StackObj {
+  ClassLoaderData* volatile _next_cld;
+ public:
+  ClassLoaderDataGraphCLDIteratorAtomic();
+  ClassLoaderData* next_cld();
+
+  // Parallel version of ClassLoaderDataGraph::roots_cld_do, applying the
+  // closures to the CLDs claimed by the calling worker.
+  void roots_cld_do(CLDClosure* strong, CLDClosure* weak);
+};
+
 #endif // SHARE_CLASSFILE_CLASSLOADERDATAGRAPH_HPP
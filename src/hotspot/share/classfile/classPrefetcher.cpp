@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "cds/metaspaceShared.hpp"
+#include "classfile/classLoader.hpp"
+#include "classfile/classPrefetcher.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionaryShared.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/resourceHash.hpp"
+
+// Upper bound for the bytes that have been prefetched but not taken yet.
+static const size_t max_prefetched_bytes = 16 * M;
+// How long to wait for a loader to take a class before giving up.
+static const int64_t max_wait_millis = 1000;
+
+struct PrefetchedClass {
+  char* _name;
+  u1* _data;
+  jlong _size;
+};
+
+static unsigned int name_hash(const char* const& name) {
+  return java_lang_String::hash_code((const jbyte*)name, (int)strlen(name));
+}
+
+static bool name_equals(const char* const& a, const char* const& b) {
+  return strcmp(a, b) == 0;
+}
+
+typedef ResourceHashtable<const char*, PrefetchedClass,
+                          name_hash, name_equals, 1031,
+                          ResourceObj::C_HEAP, mtClass> PrefetchTable;
+
+// Protected by ClassPrefetcher::_lock.
+static PrefetchTable* _table = NULL;
+static size_t _prefetched_bytes = 0;
+
+ClassPrefetcher* volatile ClassPrefetcher::_instance = NULL;
+Monitor* ClassPrefetcher::_lock = NULL;
+
+ClassPrefetcher::ClassPrefetcher(const char* classlist_path) :
+  NonJavaThread(), _classlist_path(os::strdup(classlist_path, mtClass)) {}
+
+void ClassPrefetcher::initialize() {
+  if (!PrefetchBootClasses) {
+    return;
+  }
+  // With a CDS archive mapped, the classes it contains are not read from
+  // the runtime image, and prefetch() skips them. The default class list
+  // is the one the default archive was dumped from, so only a class list
+  // given with SharedClassListFile can name anything else.
+  char default_classlist[JVM_MAXPATHLEN];
+  const char* path = SharedClassListFile;
+  if (path == NULL && !UseSharedSpaces) {
+    path = MetaspaceShared::classlist_path(default_classlist, sizeof(default_classlist));
+  }
+  if (path == NULL) {
+    log_info(class, load)("PrefetchBootClasses needs SharedClassListFile");
+    return;
+  }
+
+  _lock = new Monitor(Mutex::leaf, "ClassPrefetcher_lock", true, Monitor::_safepoint_check_never);
+  _table = new (ResourceObj::C_HEAP, mtClass) PrefetchTable();
+
+  ClassPrefetcher* thread = new ClassPrefetcher(path);
+  if (os::create_thread(thread, os::os_thread)) {
+    Atomic::release_store(&_instance, thread);
+    os::start_thread(thread);
+  } else {
+    log_warning(class, load)("Failed to create the class prefetcher thread");
+  }
+}
+
+u1* ClassPrefetcher::take(const char* name, jlong* size) {
+  if (Atomic::load_acquire(&_instance) == NULL) {
+    return NULL;
+  }
+  PrefetchedClass entry;
+  {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    if (_table == NULL) {
+      // The prefetcher has finished and released what was not taken.
+      return NULL;
+    }
+    PrefetchedClass* p = _table->get(name);
+    if (p == NULL) {
+      return NULL;
+    }
+    entry = *p;
+    _table->remove(name);
+    _prefetched_bytes -= (size_t)entry._size;
+    ml.notify();
+  }
+  os::free(entry._name);
+  *size = entry._size;
+  return entry._data;
+}
+
+#if INCLUDE_CDS
+// The name is as in the class list, without the .class suffix.
+static bool is_archived(const char* name, size_t len) {
+  if (!UseSharedSpaces) {
+    return false;
+  }
+  // Archived classes have their names in the shared symbol table, so a
+  // name that is not a symbol yet cannot be in the archive.
+  Symbol* class_name = SymbolTable::probe(name, (int)len);
+  return class_name != NULL && SystemDictionaryShared::find_builtin_class(class_name) != NULL;
+}
+#endif
+
+
+// Returns false when the loaders stopped taking classes.
+bool ClassPrefetcher::prefetch(const char* name, JImageLocationRef location, jlong size) {
+  if (location == 0) {
+    return true;
+  }
+  JImageFile* jimage = ClassLoader::get_jrt_entry()->jimage();
+  u1* data = NEW_C_HEAP_ARRAY(u1, size, mtClass);
+  ClassLoader::jimage_get_resource(jimage, location, (char*)data, size);
+
+  MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  while (_prefetched_bytes > 0 && _prefetched_bytes + (size_t)size > max_prefetched_bytes) {
+    if (ml.wait(max_wait_millis)) {
+      // Timed out: the class list does not match what is being loaded.
+      FREE_C_HEAP_ARRAY(u1, data);
+      return false;
+    }
+  }
+  if (_table->get(name) != NULL) {
+    // Listed twice.
+    FREE_C_HEAP_ARRAY(u1, data);
+    return true;
+  }
+  PrefetchedClass entry;
+  entry._name = os::strdup(name, mtClass);
+  entry._data = data;
+  entry._size = size;
+  _table->put(entry._name, entry);
+  _prefetched_bytes += (size_t)size;
+  return true;
+}
+
+class FreePrefetchedClass : public StackObj {
+ public:
+  bool do_entry(const char* name, PrefetchedClass& entry) {
+    FREE_C_HEAP_ARRAY(u1, entry._data);
+    os::free(entry._name);
+    return true;
+  }
+};
+
+void ClassPrefetcher::release() {
+  MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  // Give the loaders time to take what was prefetched last; stop waiting
+  // as soon as they stop taking classes.
+  while (_prefetched_bytes > 0) {
+    if (ml.wait(max_wait_millis)) {
+      break;
+    }
+  }
+  FreePrefetchedClass free_entry;
+  _table->iterate(&free_entry);
+  delete _table;
+  _table = NULL;
+  _prefetched_bytes = 0;
+  Atomic::release_store(&_instance, (ClassPrefetcher*)NULL);
+}
+
+// Ask the image to read ahead all the listed class files, in file order
+// and coalesced into few ranges, so that the reads in prefetch() seldom
+// wait for I/O.
+static void advise_readahead(const char* const* names, JImageLocationRef* locations,
+                             jlong* sizes, int count) {
+  JImageFile* jimage = ClassLoader::get_jrt_entry()->jimage();
+  for (int i = 0; i < count; i++) {
+    locations[i] = ClassLoader::jimage_find_resource(jimage, "", names[i], sizes[i]);
+  }
+  jint ranges = ClassLoader::jimage_prefetch_resources(jimage, locations, count);
+  log_info(class, load)("Advised readahead of %d class list entries in %d ranges", count, ranges);
+}
+
+void ClassPrefetcher::run() {
+  FILE* file = os::fopen(_classlist_path, "r");
+  if (file == NULL) {
+    log_info(class, load)("Cannot open class list %s for prefetching", _classlist_path);
+    release();
+    os::free((void*)_classlist_path);
+    _classlist_path = NULL;
+    return;
+  }
+
+  GrowableArrayCHeap<char*, mtClass> names;
+  int skipped = 0;
+  char line[JVM_MAXPATHLEN];
+  bool line_start = true;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    size_t len = strlen(line);
+    bool continued = !line_start;
+    line_start = (len > 0 && line[len - 1] == '\n');
+    if (continued) {
+      // Rest of an overlong line.
+      continue;
+    }
+    // Only plain class names; skip comments, @ directives and options
+    // after the name.
+    if (line[0] == '#' || line[0] == '@') {
+      continue;
+    }
+    len = strcspn(line, " \t\r\n");
+    if (len == 0 || len + sizeof(".class") > sizeof(line)) {
+      continue;
+    }
+    if (CDS_ONLY(is_archived(line, len)) NOT_CDS(false)) {
+      skipped++;
+      continue;
+    }
+    strcpy(line + len, ".class");
+    names.append(os::strdup(line, mtClass));
+  }
+  fclose(file);
+
+  const int n = names.length();
+  JImageLocationRef* locations = NEW_C_HEAP_ARRAY(JImageLocationRef, n, mtClass);
+  jlong* sizes = NEW_C_HEAP_ARRAY(jlong, n, mtClass);
+  if (n > 0) {
+    advise_readahead(names.adr_at(0), locations, sizes, n);
+  }
+
+  int count = 0;
+  while (count < n && prefetch(names.at(count), locations[count], sizes[count])) {
+    count++;
+  }
+  log_info(class, load)("Prefetched %d class list entries from %s, %d are archived",
+                        count, _classlist_path, skipped);
+  release();
+
+  for (int i = 0; i < n; i++) {
+    os::free(names.at(i));
+  }
+  FREE_C_HEAP_ARRAY(JImageLocationRef, locations);
+  FREE_C_HEAP_ARRAY(jlong, sizes);
+  os::free((void*)_classlist_path);
+  _classlist_path = NULL;
+}
+
+void ClassPrefetcher::post_run() {
+  this->NonJavaThread::post_run();
+  delete this;
+}
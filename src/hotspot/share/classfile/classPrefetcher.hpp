@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CLASSFILE_CLASSPREFETCHER_HPP
+#define SHARE_CLASSFILE_CLASSPREFETCHER_HPP
+
+#include "jimage.hpp"
+#include "runtime/nonJavaThread.hpp"
+
+class Monitor;
+
+// With PrefetchBootClasses, the ClassPrefetcher thread walks the class
+// list and reads the named class files from the runtime image, so that
+// the boot loader finds them already read and decompressed when it gets
+// to them. Classes in a mapped CDS archive are skipped. Parsing and
+// defining the classes still happen on the loading thread. The
+// prefetched bytes are bounded; the thread waits for the loaders to
+// catch up and gives up when they stop taking classes.
+class ClassPrefetcher : public NonJavaThread {
+  static ClassPrefetcher* volatile _instance;
+  static Monitor* _lock;
+
+  const char* _classlist_path;
+
+  ClassPrefetcher(const char* classlist_path);
+
+  bool prefetch(const char* name, JImageLocationRef location, jlong size);
+  // Free what the loaders did not take, once they stopped taking classes.
+  void release();
+  void run() override;
+  void post_run() override;
+
+ public:
+  const char* name() const override { return "Class Prefetcher"; }
+  const char* type_name() const override { return "ClassPrefetcher"; }
+  void print_on(outputStream* st) const override {
+    st->print("\"%s\" ", name());
+    Thread::print_on(st);
+    st->cr();
+  }
+
+  static void initialize();
+
+  // If the class file 'name' (e.g. "java/lang/Object.class") was
+  // prefetched, return its bytes and set *size. The caller owns the
+  // C heap buffer and frees it with FREE_C_HEAP_ARRAY once the class
+  // is parsed. Otherwise return NULL.
+  static u1* take(const char* name, jlong* size);
+};
+
+#endif // SHARE_CLASSFILE_CLASSPREFETCHER_HPP
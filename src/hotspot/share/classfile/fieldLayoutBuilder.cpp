@@ -26,6 +26,7 @@
 #include "jvm.h"
 #include "classfile/classFileParser.hpp"
 #include "classfile/fieldLayoutBuilder.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/array.hpp"
 #include "oops/fieldStreams.inline.hpp"
@@ -505,6 +506,7 @@ FieldLayoutBuilder::FieldLayoutBuilder(const Symbol* classname, const InstanceKl
   _constant_pool(constant_pool),
   _fields(fields),
   _info(info),
+  _hot_group(NULL),
   _root_group(NULL),
   _contended_groups(GrowableArray<FieldGroup*>(8)),
   _static_fields(NULL),
@@ -538,6 +540,7 @@ void FieldLayoutBuilder::prologue() {
   _static_layout = new FieldLayout(_fields, _constant_pool);
   _static_layout->initialize_static_layout();
   _static_fields = new FieldGroup();
+  _hot_group = new FieldGroup();
   _root_group = new FieldGroup();
 }
 
@@ -546,6 +549,8 @@ void FieldLayoutBuilder::prologue() {
 //   - non-static fields are also sorted according to their contention group
 //     (support of the @Contended annotation)
 //   - @Contended annotation is ignored for static fields
+//   - non-contended fields listed in the field layout profile are put in
+//     the hot group, which is allocated first
 void FieldLayoutBuilder::regular_field_sorting() {
   for (AllFieldStream fs(_fields, _constant_pool); !fs.done(); fs.next()) {
     FieldGroup* group = NULL;
@@ -561,6 +566,8 @@ void FieldLayoutBuilder::regular_field_sorting() {
         } else {
           group = get_or_create_contended_group(g);
         }
+      } else if (FieldLayoutProfile::is_hot_field(_classname, fs.name())) {
+        group = _hot_group;
       } else {
         group = _root_group;
       }
@@ -587,6 +594,7 @@ void FieldLayoutBuilder::regular_field_sorting() {
         fatal("Something wrong?");
     }
   }
+  _hot_group->sort_by_size();
   _root_group->sort_by_size();
   _static_fields->sort_by_size();
   if (!_contended_groups.is_empty()) {
@@ -608,6 +616,8 @@ void FieldLayoutBuilder::insert_contended_padding(LayoutRawBlock* slot) {
 //   - primitive fields are allocated first (from the biggest to the smallest)
 //   - then oop fields are allocated, either in existing gaps or at the end of
 //     the layout
+//   - hot fields from the field layout profile are allocated the same way,
+//     but before all other fields, so they are close to the object header
 void FieldLayoutBuilder::compute_regular_layout() {
   bool need_tail_padding = false;
   prologue();
@@ -620,6 +630,8 @@ void FieldLayoutBuilder::compute_regular_layout() {
     insert_contended_padding(_layout->start());
     need_tail_padding = true;
   }
+  _layout->add(_hot_group->primitive_fields());
+  _layout->add(_hot_group->oop_fields());
   _layout->add(_root_group->primitive_fields());
   _layout->add(_root_group->oop_fields());
 
@@ -656,6 +668,13 @@ void FieldLayoutBuilder::epilogue() {
     _super_klass->nonstatic_oop_map_count());
   }
 
+  if (_hot_group->oop_fields() != NULL) {
+    for (int i = 0; i < _hot_group->oop_fields()->length(); i++) {
+      LayoutRawBlock* b = _hot_group->oop_fields()->at(i);
+      nonstatic_oop_maps->add(b->offset(), 1);
+    }
+  }
+
   if (_root_group->oop_fields() != NULL) {
     for (int i = 0; i < _root_group->oop_fields()->length(); i++) {
       LayoutRawBlock* b = _root_group->oop_fields()->at(i);
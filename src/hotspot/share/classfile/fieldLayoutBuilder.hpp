@@ -232,6 +232,7 @@ class FieldLayoutBuilder : public ResourceObj {
   ConstantPool* _constant_pool;
   Array<u2>* _fields;
   FieldLayoutInfo* _info;
+  FieldGroup* _hot_group;   // fields listed in the FieldLayoutProfileFile
   FieldGroup* _root_group;
   GrowableArray<FieldGroup*> _contended_groups;
   FieldGroup* _static_fields;
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
+#include "classfile/symbolTable.hpp"
+#include "interpreter/bytecodeStream.hpp"
+#include "logging/log.hpp"
+#include "memory/iterator.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/constantPool.hpp"
+#include "oops/cpCache.inline.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/profileFile.hpp"
+#include "runtime/signature.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+static const char* const profile_kind = "field layout profile";
+static const int profile_version = 1;
+
+struct HotFieldKey {
+  const Symbol* _klass;
+  const Symbol* _name;
+
+  static unsigned hash(const HotFieldKey& k) {
+    return k._klass->identity_hash() ^ (k._name->identity_hash() * 31);
+  }
+
+  static bool equals(const HotFieldKey& a, const HotFieldKey& b) {
+    return a._klass == b._klass && a._name == b._name;
+  }
+};
+
+typedef ResourceHashtable<HotFieldKey, bool,
+                          HotFieldKey::hash, HotFieldKey::equals, 1031,
+                          ResourceObj::C_HEAP, mtClass> HotFieldTable;
+
+// Filled in at startup and only read afterwards.
+static HotFieldTable* _table = NULL;
+
+void fieldLayoutProfile_init() {
+  FieldLayoutProfile::initialize();
+}
+
+void FieldLayoutProfile::initialize() {
+  if (FieldLayoutProfileFile == NULL) {
+    return;
+  }
+  parse_from_file(FieldLayoutProfileFile);
+}
+
+void FieldLayoutProfile::parse_from_file(const char* path) {
+  ProfileFileReader reader(path, profile_kind, profile_version);
+  if (reader.status() == ProfileFileReader::cannot_open) {
+    log_info(class)("Cannot open field layout profile %s", path);
+    return;
+  }
+  if (reader.status() == ProfileFileReader::different_vm) {
+    log_info(class)("Ignoring field layout profile %s written by a different VM", path);
+    return;
+  }
+
+  char klass[1024];
+  char name[256];
+  _table = new (ResourceObj::C_HEAP, mtClass) HotFieldTable();
+  int count = 0;
+  const char* line;
+  while ((line = reader.next_entry()) != NULL) {
+    if (sscanf(line, "%1023s %255s", klass, name) != 2) {
+      continue;
+    }
+    HotFieldKey key;
+    key._klass = SymbolTable::new_permanent_symbol(klass);
+    key._name = SymbolTable::new_permanent_symbol(name);
+    if (_table->put(key, true)) {
+      count++;
+    }
+  }
+  log_info(class)("Read %d fields from field layout profile %s", count, path);
+}
+
+bool FieldLayoutProfile::is_hot_field(const Symbol* klass_name, const Symbol* name) {
+  if (_table == NULL) {
+    return false;
+  }
+  HotFieldKey key;
+  key._klass = klass_name;
+  key._name = name;
+  return _table->contains(key);
+}
+
+// Estimated number of accesses of one instance field
+struct FieldAccessKey {
+  InstanceKlass* _holder;
+  int _index;
+
+  static unsigned hash(const FieldAccessKey& k) {
+    return (unsigned)((uintptr_t)k._holder >> LogBytesPerWord) ^ (unsigned)(k._index * 31);
+  }
+
+  static bool equals(const FieldAccessKey& a, const FieldAccessKey& b) {
+    return a._holder == b._holder && a._index == b._index;
+  }
+};
+
+typedef ResourceHashtable<FieldAccessKey, jlong,
+                          FieldAccessKey::hash, FieldAccessKey::equals, 4099> FieldAccessTable;
+
+class FieldAccessClosure : public KlassClosure {
+  Thread* _thread;
+  FieldAccessTable* _accesses;
+
+  void record_accesses(InstanceKlass* ik, Method* m, jlong weight) {
+    ConstantPoolCache* cache = ik->constants()->cache();
+    methodHandle mh(_thread, m);
+    BytecodeStream bcs(mh);
+    Bytecodes::Code code;
+    while ((code = bcs.next()) >= 0) {
+      if (code != Bytecodes::_getfield && code != Bytecodes::_putfield) {
+        continue;
+      }
+      // Unresolved entries were never executed
+      ConstantPoolCacheEntry* e = cache->entry_at(ConstantPool::decode_cpcache_index(bcs.get_index_u2_cpcache()));
+      if (!e->is_resolved(code)) {
+        continue;
+      }
+      FieldAccessKey key;
+      key._holder = InstanceKlass::cast(e->f1_as_klass());
+      key._index = e->field_index();
+      jlong* count = _accesses->get(key);
+      if (count != NULL) {
+        *count += weight;
+      } else {
+        _accesses->put(key, weight);
+      }
+    }
+  }
+
+ public:
+  FieldAccessClosure(Thread* thread, FieldAccessTable* accesses) : _thread(thread), _accesses(accesses) {}
+
+  void do_klass(Klass* k) {
+    if (!k->is_instance_klass() || !InstanceKlass::cast(k)->is_rewritten()) {
+      return;
+    }
+    InstanceKlass* ik = InstanceKlass::cast(k);
+    HandleMark hm(_thread);
+    Array<Method*>* methods = ik->methods();
+    for (int i = 0; i < methods->length(); i++) {
+      Method* m = methods->at(i);
+      if (m->is_native() || m->is_abstract()) {
+        continue;
+      }
+      jlong weight = (jlong)MAX2(m->invocation_count(), 0) + MAX2(m->backedge_count(), 0);
+      if (weight > 0) {
+        record_accesses(ik, m, weight);
+      }
+    }
+  }
+};
+
+struct HotField {
+  InstanceKlass* _holder;
+  int _index;
+  jlong _count;
+};
+
+class HotFieldCollector : public StackObj {
+  GrowableArray<HotField>* _fields;
+
+ public:
+  HotFieldCollector(GrowableArray<HotField>* fields) : _fields(fields) {}
+
+  bool do_entry(const FieldAccessKey& key, const jlong& count) {
+    // Only classes whose instances don't fit into one cache line benefit
+    if (key._holder->size_helper() * wordSize > DEFAULT_CACHE_LINE_SIZE) {
+      HotField f = { key._holder, key._index, count };
+      _fields->append(f);
+    }
+    return true;
+  }
+};
+
+// By holder, then by decreasing access count
+static int compare_hot_fields(HotField* a, HotField* b) {
+  if (a->_holder != b->_holder) {
+    return (uintptr_t)a->_holder < (uintptr_t)b->_holder ? -1 : 1;
+  }
+  if (a->_count != b->_count) {
+    return a->_count > b->_count ? -1 : 1;
+  }
+  return a->_index - b->_index;
+}
+
+static int field_size(InstanceKlass* ik, int index) {
+  BasicType type = Signature::basic_type(ik->field_signature(index));
+  return is_reference_type(type) ? heapOopSize : type2aelembytes(type);
+}
+
+int FieldLayoutProfile::dump(const char* path) {
+  ProfileFileWriter fs(path, profile_kind, profile_version);
+  if (!fs.is_open()) {
+    log_warning(class)("Failed to create field layout profile %s", path);
+    return -1;
+  }
+
+  Thread* thread = Thread::current();
+  ResourceMark rm(thread);
+  int count = 0;
+  {
+    MutexLocker ml(ClassLoaderDataGraph_lock);
+    FieldAccessTable accesses;
+    FieldAccessClosure cl(thread, &accesses);
+    ClassLoaderDataGraph::loaded_classes_do(&cl);
+
+    GrowableArray<HotField> fields;
+    HotFieldCollector collector(&fields);
+    accesses.iterate(&collector);
+    fields.sort(compare_hot_fields);
+
+    // Write the hottest fields of each class that fit into the first cache
+    // line together with the object header
+    const int budget = DEFAULT_CACHE_LINE_SIZE - instanceOopDesc::base_offset_in_bytes();
+    InstanceKlass* holder = NULL;
+    int used = 0;
+    for (int i = 0; i < fields.length(); i++) {
+      HotField* f = fields.adr_at(i);
+      if (f->_holder != holder) {
+        holder = f->_holder;
+        used = 0;
+      }
+      int size = field_size(holder, f->_index);
+      if (used + size > budget) {
+        continue;
+      }
+      used += size;
+      fs.print("%s ", holder->name()->as_C_string());
+      fs.print_cr("%s", holder->field_name(f->_index)->as_C_string());
+      count++;
+    }
+  }
+  log_info(class)("Wrote %d fields to field layout profile %s", count, path);
+  return count;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_CLASSFILE_FIELDLAYOUTPROFILE_HPP
+#define SHARE_CLASSFILE_FIELDLAYOUTPROFILE_HPP
+
+#include "memory/allocation.hpp"
+
+class Symbol;
+
+// A field layout profile lists, per class, the instance fields that were
+// accessed most in one run. The access counts are estimated from the
+// getfield and putfield bytecodes of the methods executed, weighted by the
+// invocation and backedge counts of those methods. A later run reads the
+// profile with FieldLayoutProfileFile and FieldLayoutBuilder allocates the
+// listed fields before the other fields of the class, so they share the
+// first cache line of the object. The file is written at exit
+// (DumpFieldLayoutProfileAtExit) and is only read by the VM release that
+// wrote it:
+//
+//   # field layout profile <version> <vm release>
+//   <class name> <field name>
+class FieldLayoutProfile : AllStatic {
+  static void parse_from_file(const char* path);
+
+ public:
+  static void initialize();
+
+  // Is the instance field name of the class klass_name a hot field?
+  static bool is_hot_field(const Symbol* klass_name, const Symbol* name);
+
+  // Write the hot fields of the loaded classes to path. Returns the
+  // number of fields written, or -1 if the file could not be opened.
+  static int dump(const char* path);
+};
+
+#endif // SHARE_CLASSFILE_FIELDLAYOUTPROFILE_HPP
@@ -46,6 +46,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
@@ -89,6 +90,8 @@ OopStorage*   StringTable::_oop_storage;
 
 static size_t _current_size = 0;
 static volatile size_t _items_count = 0;
+// First range of the table not visited by an unfinished cleaning pass.
+static size_t _clean_resume_task = 0;
 
 volatile bool _alt_hash = false;
 static uint64_t _alt_hash_seed = 0;
@@ -99,10 +102,42 @@ uintx hash_string(const jchar* s, int len, bool useAlt) {
     java_lang_String::hash_code(s, len);
 }
 
+// The table entry is the WeakHandle to the String plus an access bit. The bit
+// is set by lookups that find the entry and cleared by the cleaning pass, so
+// a live entry found with the bit clear has not been looked up or interned
+// since the previous cleaning pass.
+class StringTableEntry {
+  WeakHandle    _handle;
+  volatile bool _accessed;
+
+ public:
+  StringTableEntry(const WeakHandle& handle) : _handle(handle), _accessed(true) {}
+
+  oop peek() const                      { return _handle.peek(); }
+  oop resolve() const                   { return _handle.resolve(); }
+  void release(OopStorage* storage) const { _handle.release(storage); }
+
+  void mark_accessed() {
+    // Avoid dirtying the cache line on every lookup of a hot string.
+    if (!Atomic::load(&_accessed)) {
+      Atomic::store(&_accessed, true);
+    }
+  }
+
+  // Returns true if the entry was accessed since the last call.
+  bool clear_accessed() {
+    bool accessed = Atomic::load(&_accessed);
+    if (accessed) {
+      Atomic::store(&_accessed, false);
+    }
+    return accessed;
+  }
+};
+
 class StringTableConfig : public StackObj {
  private:
  public:
-  typedef WeakHandle Value;
+  typedef StringTableEntry Value;
 
   static uintx get_hash(Value const& value, bool* is_dead) {
     oop val_oop = value.peek();
@@ -148,7 +183,7 @@ class StringTableLookupJchar : StackObj {
   uintx get_hash() const {
     return _hash;
   }
-  bool equals(WeakHandle* value, bool* is_dead) {
+  bool equals(StringTableEntry* value, bool* is_dead) {
     oop val_oop = value->peek();
     if (val_oop == NULL) {
       // dead oop, mark this hash dead for cleaning
@@ -180,7 +215,7 @@ class StringTableLookupOop : public StackObj {
     return _hash;
   }
 
-  bool equals(WeakHandle* value, bool* is_dead) {
+  bool equals(StringTableEntry* value, bool* is_dead) {
     oop val_oop = value->peek();
     if (val_oop == NULL) {
       // dead oop, mark this hash dead for cleaning
@@ -264,9 +299,10 @@ class StringTableGet : public StackObj {
   Handle  _return;
  public:
   StringTableGet(Thread* thread) : _thread(thread) {}
-  void operator()(WeakHandle* val) {
+  void operator()(StringTableEntry* val) {
     oop result = val->resolve();
     assert(result != NULL, "Result should be reachable");
+    val->mark_accessed();
     _return = Handle(_thread, result);
   }
   oop get_res_oop() {
@@ -364,7 +400,7 @@ oop StringTable::do_intern(Handle string_or_null_h, const jchar* name,
     // Callers have already looked up the String using the jchar* name, so just go to add.
     WeakHandle wh(_oop_storage, string_h);
     // The hash table takes ownership of the WeakHandle, even if it's not inserted.
-    if (_local_table->insert(THREAD, lookup, wh, &rehash_warning)) {
+    if (_local_table->insert(THREAD, lookup, StringTableEntry(wh), &rehash_warning)) {
       update_needs_rehash(rehash_warning);
       return wh.resolve();
     }
@@ -396,11 +432,13 @@ void StringTable::grow(JavaThread* jt) {
   }
   gt.done(jt);
   _current_size = table_size();
+  // Growing removed the dead entries, a partial cleaning pass starts over.
+  _clean_resume_task = 0;
   log_debug(stringtable)("Grown to size:" SIZE_FORMAT, _current_size);
 }
 
 struct StringTableDoDelete : StackObj {
-  void operator()(WeakHandle* val) {
+  void operator()(StringTableEntry* val) {
     /* do nothing */
   }
 };
@@ -408,39 +446,57 @@ struct StringTableDoDelete : StackObj {
 struct StringTableDeleteCheck : StackObj {
   long _count;
   long _item;
-  StringTableDeleteCheck() : _count(0), _item(0) {}
-  bool operator()(WeakHandle* val) {
+  long _idle;
+  StringTableDeleteCheck() : _count(0), _item(0), _idle(0) {}
+  bool operator()(StringTableEntry* val) {
     ++_item;
     oop tmp = val->peek();
     if (tmp == NULL) {
       ++_count;
       return true;
     } else {
+      if (!val->clear_accessed()) {
+        ++_idle;
+      }
       return false;
     }
   }
 };
 
-void StringTable::clean_dead_entries(JavaThread* jt) {
+// Returns false if the pass stopped early because StringTableCleaningSliceMillis
+// ran out, the next call resumes at the first range not yet visited.
+bool StringTable::clean_dead_entries(JavaThread* jt) {
   StringTableHash::BulkDeleteTask bdt(_local_table);
   if (!bdt.prepare(jt)) {
-    return;
+    return true;
   }
+  bdt.resume_at(_clean_resume_task);
+
+  const jlong slice_end = StringTableCleaningSliceMillis > 0 ?
+    os::javaTimeNanos() + StringTableCleaningSliceMillis * NANOSECS_PER_MILLISEC : 0;
+  bool completed = true;
 
   StringTableDeleteCheck stdc;
   StringTableDoDelete stdd;
   {
     TraceTime timer("Clean", TRACETIME_LOG(Debug, stringtable, perf));
     while(bdt.do_task(jt, stdc, stdd)) {
+      if (slice_end != 0 && os::javaTimeNanos() >= slice_end) {
+        completed = false;
+        break;
+      }
       bdt.pause(jt);
       {
         ThreadBlockInVM tbivm(jt);
       }
       bdt.cont(jt);
     }
+    _clean_resume_task = completed ? 0 : bdt.next_task();
     bdt.done(jt);
   }
-  log_debug(stringtable)("Cleaned %ld of %ld", stdc._count, stdc._item);
+  log_debug(stringtable)("Cleaned %ld of %ld, %ld idle%s", stdc._count, stdc._item,
+                         stdc._idle, completed ? "" : " (partial)");
+  return completed;
 }
 
 void StringTable::gc_notification(size_t num_dead) {
@@ -474,8 +530,10 @@ void StringTable::do_concurrent_work(JavaThread* jt) {
   // We prefer growing, since that also removes dead items
   if (load_factor > PREF_AVG_LIST_LEN && !_local_table->is_max_size_reached()) {
     grow(jt);
-  } else {
-    clean_dead_entries(jt);
+  } else if (!clean_dead_entries(jt)) {
+    // Leave the work flag set so the service thread comes back for the next
+    // slice after it has looked at its other tasks.
+    return;
   }
   Atomic::release_store(&_has_work, false);
 }
@@ -551,7 +609,7 @@ static int literal_size(oop obj) {
 }
 
 struct SizeFunc : StackObj {
-  size_t operator()(WeakHandle* val) {
+  size_t operator()(StringTableEntry* val) {
     oop s = val->peek();
     if (s == NULL) {
       // Dead
@@ -577,7 +635,7 @@ void StringTable::print_table_statistics(outputStream* st,
 // Verification
 class VerifyStrings : StackObj {
  public:
-  bool operator()(WeakHandle* val) {
+  bool operator()(StringTableEntry* val) {
     oop s = val->peek();
     if (s != NULL) {
       assert(java_lang_String::length(s) >= 0, "Length on string must work.");
@@ -601,7 +659,7 @@ class VerifyCompStrings : StackObj {
  public:
   size_t _errors;
   VerifyCompStrings(GrowableArray<oop>* oops) : _oops(oops), _errors(0) {}
-  bool operator()(WeakHandle* val) {
+  bool operator()(StringTableEntry* val) {
     oop s = val->resolve();
     if (s == NULL) {
       return true;
@@ -639,7 +697,7 @@ class PrintString : StackObj {
   outputStream* _st;
  public:
   PrintString(Thread* thr, outputStream* st) : _thr(thr), _st(st) {}
-  bool operator()(WeakHandle* val) {
+  bool operator()(StringTableEntry* val) {
     oop s = val->peek();
     if (s == NULL) {
       return true;
@@ -771,6 +829,38 @@ void StringTable::write_to_archive(const DumpedInternedStrings* dumped_interned_
   writer.dump(&_shared_table, "string");
 }
 
+class TransferSharedStrings : StackObj {
+  JavaThread* _current;
+ public:
+  TransferSharedStrings(JavaThread* current) : _current(current) {}
+  void do_value(oop s) {
+    JavaThread* THREAD = _current;
+    if (HAS_PENDING_EXCEPTION) {
+      return;
+    }
+    ResourceMark rm(THREAD);
+    Handle string_h(THREAD, s);
+    int length;
+    jchar* chars = java_lang_String::as_unicode_string(string_h(), length, CHECK);
+    uintx hash = java_lang_String::hash_code(chars, length);
+    if (_alt_hash) {
+      hash = hash_string(chars, length, true);
+    }
+    StringTable::do_intern(string_h, chars, length, hash, CHECK);
+  }
+};
+
+// When the archived heap objects are loaded rather than mapped, the GC may
+// move or reclaim the shared strings, so the narrowOops recorded in the shared
+// table can go stale. Intern the shared strings in the local table instead.
+void StringTable::transfer_shared_strings(TRAPS) {
+  assert(HeapShared::is_loaded(), "only for loaded archived heap objects");
+  TransferSharedStrings transfer(THREAD);
+  _shared_table.iterate(&transfer);
+  log_info(cds)("Transferred " SIZE_FORMAT " shared strings to the string table", _shared_table.entry_count());
+  _shared_table.reset();
+}
+
 void StringTable::serialize_shared_table_header(SerializeClosure* soc) {
   _shared_table.serialize_header(soc);
 
@@ -39,12 +39,14 @@ class SerializeClosure;
 class StringTable;
 class StringTableConfig;
 class StringTableCreateEntry;
+class TransferSharedStrings;
 
 class StringTable : public CHeapObj<mtSymbol>{
   friend class VMStructs;
   friend class Symbol;
   friend class StringTableConfig;
   friend class StringTableCreateEntry;
+  friend class TransferSharedStrings;
 
   static volatile bool _has_work;
 
@@ -54,7 +56,7 @@ class StringTable : public CHeapObj<mtSymbol>{
   static OopStorage* _oop_storage;
 
   static void grow(JavaThread* jt);
-  static void clean_dead_entries(JavaThread* jt);
+  static bool clean_dead_entries(JavaThread* jt);
 
   static double get_load_factor();
   static double get_dead_factor(size_t num_dead);
@@ -112,6 +114,7 @@ class StringTable : public CHeapObj<mtSymbol>{
   static oop create_archived_string(oop s) NOT_CDS_JAVA_HEAP_RETURN_(NULL);
   static void write_to_archive(const DumpedInternedStrings* dumped_interned_strings) NOT_CDS_JAVA_HEAP_RETURN;
   static void serialize_shared_table_header(SerializeClosure* soc) NOT_CDS_JAVA_HEAP_RETURN;
+  static void transfer_shared_strings(TRAPS) NOT_CDS_JAVA_HEAP_RETURN;
 
   // Jcmd
   static void dump(outputStream* st, bool verbose=false);
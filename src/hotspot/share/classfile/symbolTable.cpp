@@ -118,17 +118,52 @@ static uintx hash_shared_symbol(const char* s, int len) {
 }
 #endif
 
+// The value of a node in the SymbolTable. The hash and the length of the
+// Symbol are kept in the node next to the Symbol* so that a lookup can
+// reject the other nodes in its bucket without loading the Symbol, and
+// so that growing the table does not have to rehash the Symbol bytes.
+class SymbolTableEntry {
+  Symbol* _symbol;
+  // The hash is cached for the hashing algorithm selected by _alt_hash
+  // when it was computed; rehashing switches the algorithm and refreshes
+  // the cached value while the nodes are moved (see get_hash() below).
+  mutable uint32_t _hash;
+  mutable bool _alt;
+  u2 _length;
+
+ public:
+  SymbolTableEntry(Symbol* symbol, uintx hash) :
+    _symbol(symbol), _hash((uint32_t)hash), _alt(_alt_hash),
+    _length((u2)symbol->utf8_length()) {}
+
+  Symbol* symbol() const { return _symbol; }
+  Symbol** symbol_addr() { return &_symbol; }
+
+  // Cheap pre-check for a lookup of str/len with the given hash.
+  bool may_equal(uintx hash, int len) const {
+    return _length == len && _hash == (uint32_t)hash;
+  }
+
+  uintx hash() const {
+    if (_alt != _alt_hash) {
+      _hash = (uint32_t)hash_symbol((const char*)_symbol->bytes(), _length, _alt_hash);
+      _alt = _alt_hash;
+    }
+    return _hash;
+  }
+};
+
 class SymbolTableConfig : public AllStatic {
 private:
 public:
-  typedef Symbol* Value;  // value of the Node in the hashtable
+  typedef SymbolTableEntry Value;  // value of the Node in the hashtable
 
   static uintx get_hash(Value const& value, bool* is_dead) {
-    *is_dead = (value->refcount() == 0);
+    *is_dead = (value.symbol()->refcount() == 0);
     if (*is_dead) {
       return 0;
     } else {
-      return hash_symbol((const char*)value->bytes(), value->utf8_length(), _alt_hash);
+      return value.hash();
     }
   }
   // We use default allocation/deallocation but counted
@@ -142,13 +177,14 @@ public:
     // If #1, then the symbol can be either permanent,
     // or regular newly created one (refcount==1)
     // If #2, then the symbol is dead (refcount==0)
-    assert(value->is_permanent() || (value->refcount() == 1) || (value->refcount() == 0),
-           "refcount %d", value->refcount());
-    if (value->refcount() == 1) {
-      value->decrement_refcount();
-      assert(value->refcount() == 0, "expected dead symbol");
+    Symbol* sym = value.symbol();
+    assert(sym->is_permanent() || (sym->refcount() == 1) || (sym->refcount() == 0),
+           "refcount %d", sym->refcount());
+    if (sym->refcount() == 1) {
+      sym->decrement_refcount();
+      assert(sym->refcount() == 0, "expected dead symbol");
     }
-    SymbolTable::delete_symbol(value);
+    SymbolTable::delete_symbol(sym);
     FreeHeap(memory);
     SymbolTable::item_removed();
   }
@@ -245,10 +281,10 @@ class SymbolsDo : StackObj {
   SymbolClosure *_cl;
 public:
   SymbolsDo(SymbolClosure *cl) : _cl(cl) {}
-  bool operator()(Symbol** value) {
+  bool operator()(SymbolTableEntry* value) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
-    _cl->do_symbol(value);
+    assert(value->symbol() != NULL, "value should point to a symbol");
+    _cl->do_symbol(value->symbol_addr());
     return true;
   };
 };
@@ -364,10 +400,15 @@ public:
   uintx get_hash() const {
     return _hash;
   }
-  bool equals(Symbol** value, bool* is_dead) {
+  bool equals(SymbolTableEntry* value, bool* is_dead) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
-    Symbol *sym = *value;
+    assert(value->symbol() != NULL, "value should point to a symbol");
+    if (!value->may_equal(_hash, _len)) {
+      // Rejected without touching the Symbol. Dead Symbols with another
+      // key are left for the next cleaning.
+      return false;
+    }
+    Symbol *sym = value->symbol();
     if (sym->equals(_str, _len)) {
       if (sym->try_increment_refcount()) {
         // something is referencing this symbol now.
@@ -388,10 +429,10 @@ class SymbolTableGet : public StackObj {
   Symbol* _return;
 public:
   SymbolTableGet() : _return(NULL) {}
-  void operator()(Symbol** value) {
+  void operator()(SymbolTableEntry* value) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
-    _return = *value;
+    assert(value->symbol() != NULL, "value should point to a symbol");
+    _return = value->symbol();
   }
   Symbol* get_res_sym() const {
     return _return;
@@ -477,7 +518,7 @@ Symbol* SymbolTable::do_add_if_needed(const char* name, int len, uintx hash, boo
   do {
     // Callers have looked up the symbol once, insert the symbol.
     sym = allocate_symbol(name, len, heap);
-    if (_local_table->insert(current, lookup, sym, &rehash_warning, &clean_hint)) {
+    if (_local_table->insert(current, lookup, SymbolTableEntry(sym, hash), &rehash_warning, &clean_hint)) {
       break;
     }
     // In case another thread did a concurrent add, return value already in the table.
@@ -514,10 +555,10 @@ Symbol* SymbolTable::new_permanent_symbol(const char* name) {
 }
 
 struct SizeFunc : StackObj {
-  size_t operator()(Symbol** value) {
+  size_t operator()(SymbolTableEntry* value) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
-    return (*value)->size() * HeapWordSize;
+    assert(value->symbol() != NULL, "value should point to a symbol");
+    return value->symbol()->size() * HeapWordSize;
   };
 };
 
@@ -537,12 +578,15 @@ void SymbolTable::print_table_statistics(outputStream* st,
 // Verification
 class VerifySymbols : StackObj {
 public:
-  bool operator()(Symbol** value) {
+  bool operator()(SymbolTableEntry* value) {
     guarantee(value != NULL, "expected valid value");
-    guarantee(*value != NULL, "value should point to a symbol");
-    Symbol* sym = *value;
+    guarantee(value->symbol() != NULL, "value should point to a symbol");
+    Symbol* sym = value->symbol();
     guarantee(sym->equals((const char*)sym->bytes(), sym->utf8_length()),
               "symbol must be internally consistent");
+    guarantee(value->may_equal(hash_symbol((const char*)sym->bytes(), sym->utf8_length(), _alt_hash),
+                               sym->utf8_length()),
+              "cached hash and length must match the symbol");
     return true;
   };
 };
@@ -561,10 +605,10 @@ class DumpSymbol : StackObj {
   outputStream* _st;
 public:
   DumpSymbol(Thread* thr, outputStream* st) : _thr(thr), _st(st) {}
-  bool operator()(Symbol** value) {
+  bool operator()(SymbolTableEntry* value) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
-    Symbol* sym = *value;
+    assert(value->symbol() != NULL, "value should point to a symbol");
+    Symbol* sym = value->symbol();
     const char* utf8_string = (const char*)sym->bytes();
     int utf8_length = sym->utf8_length();
     _st->print("%d %d: ", utf8_length, sym->refcount());
@@ -660,10 +704,10 @@ void SymbolTable::grow(JavaThread* jt) {
 struct SymbolTableDoDelete : StackObj {
   size_t _deleted;
   SymbolTableDoDelete() : _deleted(0) {}
-  void operator()(Symbol** value) {
+  void operator()(SymbolTableEntry* value) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
-    Symbol *sym = *value;
+    assert(value->symbol() != NULL, "value should point to a symbol");
+    Symbol *sym = value->symbol();
     assert(sym->refcount() == 0, "refcount");
     _deleted++;
   }
@@ -672,11 +716,11 @@ struct SymbolTableDoDelete : StackObj {
 struct SymbolTableDeleteCheck : StackObj {
   size_t _processed;
   SymbolTableDeleteCheck() : _processed(0) {}
-  bool operator()(Symbol** value) {
+  bool operator()(SymbolTableEntry* value) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
+    assert(value->symbol() != NULL, "value should point to a symbol");
     _processed++;
-    Symbol *sym = *value;
+    Symbol *sym = value->symbol();
     return (sym->refcount() == 0);
   }
 };
@@ -814,10 +858,10 @@ public:
       sizes[i] = 0;
     }
   }
-  bool operator()(Symbol** value) {
+  bool operator()(SymbolTableEntry* value) {
     assert(value != NULL, "expected valid value");
-    assert(*value != NULL, "value should point to a symbol");
-    Symbol* sym = *value;
+    assert(value->symbol() != NULL, "value should point to a symbol");
+    Symbol* sym = value->symbol();
     size_t size = sym->size();
     size_t len = sym->utf8_length();
     if (len < results_length) {
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "cds/heapShared.hpp"
+#include "classfile/backgroundVerifier.hpp"
 #include "classfile/classFileParser.hpp"
 #include "classfile/classFileStream.hpp"
 #include "classfile/classLoader.hpp"
@@ -1445,6 +1446,10 @@ void SystemDictionary::define_instance_class(InstanceKlass* k, Handle class_load
   }
   k->eager_initialize(THREAD);
 
+  if (BackgroundVerificationThreads > 0) {
+    BackgroundVerifier::enqueue(k);
+  }
+
   // notify jvmti
   if (JvmtiExport::should_post_class_load()) {
     JvmtiExport::post_class_load(THREAD, k);
@@ -27,6 +27,7 @@
 #include "classfile/classLoader.hpp"
 #include "classfile/classLoaderData.hpp"
 #include "classfile/dictionary.hpp"
+#include "classfile/stringTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmClasses.hpp"
 #include "classfile/vmSymbols.hpp"
@@ -140,6 +141,9 @@ void vmClasses::resolve_all(TRAPS) {
     // call. No mirror objects are accessed/restored in the above call.
     // Mirrors are restored after java.lang.Class is loaded.
     HeapShared::fixup_mapped_heap_regions();
+    if (HeapShared::is_loaded()) {
+      StringTable::transfer_shared_strings(CHECK);
+    }
 
     // Initialize the constant pool for the Object_class
     assert(Object_klass()->is_shared(), "must be");
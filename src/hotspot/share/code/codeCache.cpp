@@ -285,15 +285,26 @@ void CodeCache::initialize_heaps() {
         non_nmethod_size/K, min_code_cache_size/K));
   }
 
+  // If large page support is enabled, align code heaps according to large
+  // page size to make sure that code cache is covered by large pages.
+  size_t alignment = MAX2(page_size(false, 8), (size_t) os::vm_allocation_granularity());
+  LINUX_ONLY(alignment = MAX2(alignment, os::Linux::code_cache_large_page_size());)
+
+  // The hot code heap is taken from the non-profiled one, which keeps at
+  // least half of its size
+  size_t hot_size = 0;
+  if (heap_available(CodeBlobType::MethodHot)) {
+    hot_size = align_down(MIN2((size_t)HotCodeHeapSize, non_profiled_size / 2), alignment);
+    non_profiled_size -= hot_size;
+  }
+
   // Verify sizes and update flag values
-  assert(non_profiled_size + profiled_size + non_nmethod_size == cache_size, "Invalid code heap sizes");
+  assert(non_profiled_size + hot_size + profiled_size + non_nmethod_size == cache_size, "Invalid code heap sizes");
   FLAG_SET_ERGO(NonNMethodCodeHeapSize, non_nmethod_size);
   FLAG_SET_ERGO(ProfiledCodeHeapSize, profiled_size);
   FLAG_SET_ERGO(NonProfiledCodeHeapSize, non_profiled_size);
+  FLAG_SET_ERGO(HotCodeHeapSize, hot_size);
 
-  // If large page support is enabled, align code heaps according to large
-  // page size to make sure that code cache is covered by large pages.
-  const size_t alignment = MAX2(page_size(false, 8), (size_t) os::vm_allocation_granularity());
   non_nmethod_size = align_up(non_nmethod_size, alignment);
   profiled_size    = align_down(profiled_size, alignment);
 
@@ -301,6 +312,7 @@ void CodeCache::initialize_heaps() {
   // parts for the individual heaps. The memory layout looks like this:
   // ---------- high -----------
   //    Non-profiled nmethods
+  //        Hot nmethods
   //      Profiled nmethods
   //         Non-nmethods
   // ---------- low ------------
@@ -308,7 +320,9 @@ void CodeCache::initialize_heaps() {
   ReservedSpace non_method_space    = rs.first_part(non_nmethod_size);
   ReservedSpace rest                = rs.last_part(non_nmethod_size);
   ReservedSpace profiled_space      = rest.first_part(profiled_size);
-  ReservedSpace non_profiled_space  = rest.last_part(profiled_size);
+  ReservedSpace method_space        = rest.last_part(profiled_size);
+  ReservedSpace hot_space           = method_space.first_part(hot_size);
+  ReservedSpace non_profiled_space  = method_space.last_part(hot_size);
 
   // Non-nmethods (stubs, adapters, ...)
   add_heap(non_method_space, "CodeHeap 'non-nmethods'", CodeBlobType::NonNMethod);
@@ -316,6 +330,10 @@ void CodeCache::initialize_heaps() {
   add_heap(profiled_space, "CodeHeap 'profiled nmethods'", CodeBlobType::MethodProfiled);
   // Tier 1 and tier 4 (non-profiled) methods and native methods
   add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
+  // Tier 4 code of hot methods
+  if (hot_size > 0) {
+    add_heap(hot_space, "CodeHeap 'hot nmethods'", CodeBlobType::MethodHot);
+  }
 }
 
 size_t CodeCache::page_size(bool aligned, size_t min_pages) {
@@ -334,7 +352,10 @@ size_t CodeCache::page_size(bool aligned, size_t min_pages) {
 ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size) {
   // Align and reserve space for code cache
   const size_t rs_ps = page_size();
-  const size_t rs_align = MAX2(rs_ps, (size_t) os::vm_allocation_granularity());
+  size_t rs_align = MAX2(rs_ps, (size_t) os::vm_allocation_granularity());
+  // Transparent huge pages are only used for the parts of the code cache
+  // that are aligned to the huge page size
+  LINUX_ONLY(rs_align = MAX2(rs_align, os::Linux::code_cache_large_page_size());)
   const size_t rs_size = align_up(size, rs_align);
   ReservedCodeSpace rs(rs_size, rs_align, rs_ps);
   if (!rs.is_reserved()) {
@@ -350,7 +371,11 @@ ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size) {
 
 // Heaps available for allocation
 bool CodeCache::heap_available(int code_blob_type) {
-  if (!SegmentedCodeCache) {
+  if (code_blob_type == CodeBlobType::MethodHot) {
+    // Only C2 code goes there
+    return SegmentedCodeCache && HotCodeHeapSize > 0 &&
+           !Arguments::is_interpreter_only() && CompilerConfig::is_c2_or_jvmci_compiler_enabled();
+  } else if (!SegmentedCodeCache) {
     // No segmentation: use a single code heap
     return (code_blob_type == CodeBlobType::All);
   } else if (Arguments::is_interpreter_only()) {
@@ -377,6 +402,9 @@ const char* CodeCache::get_code_heap_flag_name(int code_blob_type) {
   case CodeBlobType::MethodProfiled:
     return "ProfiledCodeHeapSize";
     break;
+  case CodeBlobType::MethodHot:
+    return "HotCodeHeapSize";
+    break;
   }
   ShouldNotReachHere();
   return NULL;
@@ -472,6 +500,15 @@ CodeBlob* CodeCache::first_blob(int code_blob_type) {
   }
 }
 
+int CodeCache::get_code_blob_type(const methodHandle& method, int comp_level) {
+  int code_blob_type = get_code_blob_type(comp_level);
+  if (comp_level == CompLevel_full_optimization && heap_available(CodeBlobType::MethodHot) &&
+      method->invocation_count() + method->backedge_count() >= (int)HotCodeHeapThreshold) {
+    code_blob_type = CodeBlobType::MethodHot;
+  }
+  return code_blob_type;
+}
+
 CodeBlob* CodeCache::next_blob(CodeHeap* heap, CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
   assert(heap != NULL, "heap is null");
@@ -486,8 +523,11 @@ CodeBlob* CodeCache::next_blob(CodeHeap* heap, CodeBlob* cb) {
  * instantiating.
  */
 CodeBlob* CodeCache::allocate(int size, int code_blob_type, bool handle_alloc_failure, int orig_code_blob_type) {
-  // Possibly wakes up the sweeper thread.
-  NMethodSweeper::report_allocation(code_blob_type);
+  // Possibly wakes up the sweeper thread. A full hot code heap is not a
+  // reason to sweep, its methods just go to the non-profiled heap.
+  if (code_blob_type != CodeBlobType::MethodHot) {
+    NMethodSweeper::report_allocation(code_blob_type);
+  }
   assert_locked_or_safepoint(CodeCache_lock);
   assert(size > 0, "Code cache allocation request must be > 0 but is %d", size);
   if (size <= 0) {
@@ -515,6 +555,9 @@ CodeBlob* CodeCache::allocate(int size, int code_blob_type, bool handle_alloc_fa
         // and force stack scanning if less than 10% of the code heap are free.
         int type = code_blob_type;
         switch (type) {
+        case CodeBlobType::MethodHot:
+          // Not a code cache full condition
+          return allocate(size, CodeBlobType::MethodNonProfiled, handle_alloc_failure);
         case CodeBlobType::NonNMethod:
           type = CodeBlobType::MethodNonProfiled;
           break;
@@ -1518,7 +1561,14 @@ void CodeCache::print_summary(outputStream* st, bool detailed) {
     st->print_cr("              stopped_count=%d, restarted_count=%d",
                  CompileBroker::get_total_compiler_stopped_count(),
                  CompileBroker::get_total_compiler_restarted_count());
-    st->print_cr(" full_count=%d", full_count);
+    st->print(" full_count=%d", full_count);
+#ifdef LINUX
+    if (os::Linux::code_cache_large_page_size() != 0) {
+      st->print(" transparent_huge_pages=" SIZE_FORMAT "Kb",
+                os::Linux::code_cache_large_page_size() / K);
+    }
+#endif
+    st->cr();
   }
 }
 
@@ -47,6 +47,10 @@
 //    executed at level 2 or 3
 //  - Non-Profiled nmethods: nmethods that are not profiled, i.e., those
 //    executed at level 1 or 4 and native methods
+//  - Hot nmethods: level 4 nmethods of methods that were already hot when
+//    compiled, kept together to reduce instruction TLB and cache misses.
+//    Only present with HotCodeHeapSize; its space is taken from the
+//    non-profiled code heap, which also takes its methods when it is full.
 //  - All: Used for code of all types if code cache segmentation is disabled.
 //
 // In the rare case of the non-nmethod code heap getting full, non-nmethod code
@@ -225,16 +229,18 @@ class CodeCache : AllStatic {
   }
 
   static bool code_blob_type_accepts_compiled(int type) {
-    bool result = type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    bool result = type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled ||
+                  type == CodeBlobType::MethodHot;
     return result;
   }
 
   static bool code_blob_type_accepts_nmethod(int type) {
-    return type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    return type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled ||
+           type == CodeBlobType::MethodHot;
   }
 
   static bool code_blob_type_accepts_allocable(int type) {
-    return type <= CodeBlobType::All;
+    return type <= CodeBlobType::All || type == CodeBlobType::MethodHot;
   }
 
 
@@ -254,6 +260,10 @@ class CodeCache : AllStatic {
     return 0;
   }
 
+  // Returns the CodeBlobType for the given method compiled at the given
+  // compilation level: C2 code of hot methods goes to the hot code heap
+  static int get_code_blob_type(const methodHandle& method, int comp_level);
+
   static void verify_clean_inline_caches();
   static void verify_icholder_relocations();
 
@@ -34,6 +34,7 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/compileTask.hpp"
 #include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.inline.hpp"
 #include "oops/klass.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/objArrayKlass.hpp"
@@ -1555,6 +1556,9 @@ bool LinkedConcreteMethodFinder::is_concrete_klass(InstanceKlass* ik) {
   if (!ik->is_linked()) {
     return false; // not yet linked classes don't have instances
   }
+  if (ik->is_itable_pending()) {
+    return false; // no instances before link_pending_itable(); it flushes dependents
+  }
   return true;
 }
 
@@ -319,7 +319,7 @@ class nmethod : public CompiledMethod {
           );
 
   // helper methods
-  void* operator new(size_t size, int nmethod_size, int comp_level) throw();
+  void* operator new(size_t size, int nmethod_size, int code_blob_type) throw();
 
   const char* reloc_string_for(u_char* begin, u_char* end);
 
@@ -142,7 +142,11 @@ int VtableStubs::code_size_limit(bool is_vtable_stub) {
   if (is_vtable_stub) {
     return _vtab_stub_size > 0 ? _vtab_stub_size : first_vtableStub_size;
   } else { // itable stub
-    return _itab_stub_size > 0 ? _itab_stub_size : first_itableStub_size;
+    if (_itab_stub_size > 0) {
+      return _itab_stub_size;
+    }
+    // Leave room for the itable selector table probes in the first stub
+    return first_itableStub_size + (UseItableSelectorTable ? 160 : 0);
   }
 }   // code_size_limit
 
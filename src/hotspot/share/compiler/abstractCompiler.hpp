@@ -57,6 +57,7 @@ class CompilerStatistics {
   Data _osr;       // stats for OSR compilations
   int _nmethods_size; //
   int _nmethods_code_size;
+  jlong _cpu_time;    // thread CPU time spent compiling, in nanoseconds, including bailouts
 
   double total_time() { return _standard._time.seconds() + _osr._time.seconds(); }
 
@@ -69,7 +70,7 @@ class CompilerStatistics {
     return seconds == 0.0 ? 0.0 : (bytes / seconds);
   }
 
-  CompilerStatistics() : _nmethods_size(0), _nmethods_code_size(0) {}
+  CompilerStatistics() : _nmethods_size(0), _nmethods_code_size(0), _cpu_time(0) {}
 };
 
 class AbstractCompiler : public CHeapObj<mtCompiler> {
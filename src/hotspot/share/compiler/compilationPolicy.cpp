@@ -614,12 +614,18 @@ CompileTask* CompilationPolicy::select_task(CompileQueue* compile_queue) {
   CompileTask *max_blocking_task = NULL;
   CompileTask *max_task = NULL;
   Method* max_method = NULL;
+  // The weights of the current candidates, so that each task's weight is
+  // computed only once per scan.
+  double max_weight = 0;
+  double max_blocking_weight = 0;
+  int scanned = 0;
 
   jlong t = nanos_to_millis(os::javaTimeNanos());
   // Iterate through the queue and find a method with a maximum rate.
   for (CompileTask* task = compile_queue->first(); task != NULL;) {
     CompileTask* next_task = task->next();
     Method* method = task->method();
+    scanned++;
     // If a method was unloaded or has been stale for some time, remove it from the queue.
     // Blocking tasks and tasks submitted from whitebox API don't become stale
     if (task->is_unloaded() || (task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method))) {
@@ -634,20 +640,24 @@ CompileTask* CompilationPolicy::select_task(CompileQueue* compile_queue) {
       continue;
     }
     update_rate(t, method);
-    if (max_task == NULL || compare_methods(method, max_method)) {
+    double w = weight(method);
+    if (max_task == NULL || compare_methods(method, w, max_method, max_weight)) {
       // Select a method with the highest rate
       max_task = task;
       max_method = method;
+      max_weight = w;
     }
 
     if (task->is_blocking()) {
-      if (max_blocking_task == NULL || compare_methods(method, max_blocking_task->method())) {
+      if (max_blocking_task == NULL || compare_methods(method, w, max_blocking_task->method(), max_blocking_weight)) {
         max_blocking_task = task;
+        max_blocking_weight = w;
       }
     }
 
     task = next_task;
   }
+  compile_queue->record_selection(scanned);
 
   if (max_blocking_task != NULL) {
     // In blocking compilation mode, the CompileBroker will make
@@ -860,13 +870,13 @@ double CompilationPolicy::weight(Method* method) {
 }
 
 // Apply heuristics and return true if x should be compiled before y
-bool CompilationPolicy::compare_methods(Method* x, Method* y) {
+bool CompilationPolicy::compare_methods(Method* x, double wx, Method* y, double wy) {
   if (x->highest_comp_level() > y->highest_comp_level()) {
     // recompilation after deopt
     return true;
   } else
     if (x->highest_comp_level() == y->highest_comp_level()) {
-      if (weight(x) > weight(y)) {
+      if (wx > wy) {
         return true;
       }
     }
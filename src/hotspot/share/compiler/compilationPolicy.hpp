@@ -194,8 +194,9 @@ class CompilationPolicy : AllStatic {
   inline static bool is_stale(jlong t, jlong timeout, Method* m);
   // Compute the weight of the method for the compilation scheduling
   inline static double weight(Method* method);
-  // Apply heuristics and return true if x should be compiled before y
-  inline static bool compare_methods(Method* x, Method* y);
+  // Apply heuristics and return true if x, of weight wx, should be compiled
+  // before y, of weight wy
+  inline static bool compare_methods(Method* x, double wx, Method* y, double wy);
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline static void update_rate(jlong t, Method* m);
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/symbolTable.hpp"
+#include "compiler/compilationProfile.hpp"
+#include "compiler/compilerDefinitions.hpp"
+#include "compiler/compiler_globals.hpp"
+#include "logging/log.hpp"
+#include "memory/iterator.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "oops/methodCounters.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/profileFile.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+static const char* const profile_kind = "compilation profile";
+static const int profile_version = 1;
+
+struct ProfileKey {
+  Symbol* _klass;
+  Symbol* _name;
+  Symbol* _signature;
+
+  static unsigned hash(const ProfileKey& k) {
+    return k._klass->identity_hash() ^
+           (k._name->identity_hash() * 31) ^
+           (k._signature->identity_hash() * 961);
+  }
+
+  static bool equals(const ProfileKey& a, const ProfileKey& b) {
+    return a._klass == b._klass && a._name == b._name && a._signature == b._signature;
+  }
+};
+
+struct ProfileCounts {
+  uint _invocations;
+  uint _backedges;
+};
+
+typedef ResourceHashtable<ProfileKey, ProfileCounts,
+                          ProfileKey::hash, ProfileKey::equals, 1031,
+                          ResourceObj::C_HEAP, mtCompiler> ProfileTable;
+
+// Filled in at startup and only read afterwards.
+static ProfileTable* _table = NULL;
+
+void compilationProfile_init() {
+  CompilationProfile::initialize();
+}
+
+void CompilationProfile::initialize() {
+  if (CompilationProfileFile == NULL || !CompilerConfig::is_c2_enabled()) {
+    return;
+  }
+  parse_from_file(CompilationProfileFile);
+}
+
+void CompilationProfile::parse_from_file(const char* path) {
+  ProfileFileReader reader(path, profile_kind, profile_version);
+  if (reader.status() == ProfileFileReader::cannot_open) {
+    log_info(jit, compilation)("Cannot open compilation profile %s", path);
+    return;
+  }
+  if (reader.status() == ProfileFileReader::different_vm) {
+    log_info(jit, compilation)("Ignoring compilation profile %s written by a different VM", path);
+    return;
+  }
+
+  char klass[1024];
+  char name[256];
+  char signature[1024];
+  _table = new (ResourceObj::C_HEAP, mtCompiler) ProfileTable();
+  int count = 0;
+  const char* line;
+  while ((line = reader.next_entry()) != NULL) {
+    ProfileCounts counts;
+    if (sscanf(line, "%1023s %255s %1023s %u %u", klass, name, signature,
+               &counts._invocations, &counts._backedges) != 5) {
+      continue;
+    }
+    ProfileKey key;
+    key._klass = SymbolTable::new_permanent_symbol(klass);
+    key._name = SymbolTable::new_permanent_symbol(name);
+    key._signature = SymbolTable::new_permanent_symbol(signature);
+    if (_table->put(key, counts)) {
+      count++;
+    }
+  }
+  log_info(jit, compilation)("Read %d methods from compilation profile %s", count, path);
+}
+
+void CompilationProfile::seed_counters(const methodHandle& mh, MethodCounters* counters) {
+  if (_table == NULL) {
+    return;
+  }
+  ProfileKey key;
+  key._klass = mh->method_holder()->name();
+  key._name = mh->name();
+  key._signature = mh->signature();
+  ProfileCounts* counts = _table->get(key);
+  if (counts == NULL) {
+    return;
+  }
+  // Stay below the overflow limit so that the counters keep counting.
+  const uint limit = InvocationCounter::count_limit - 1;
+  counters->invocation_counter()->set(MIN2(counts->_invocations, limit));
+  counters->backedge_counter()->set(MIN2(counts->_backedges, limit));
+}
+
+class ProfileDumpClosure : public KlassClosure {
+  outputStream* _st;
+  int _count;
+
+ public:
+  ProfileDumpClosure(outputStream* st) : _st(st), _count(0) {}
+
+  int count() const { return _count; }
+
+  void do_klass(Klass* k) {
+    if (!k->is_instance_klass()) {
+      return;
+    }
+    InstanceKlass* ik = InstanceKlass::cast(k);
+    Array<Method*>* methods = ik->methods();
+    for (int i = 0; i < methods->length(); i++) {
+      Method* m = methods->at(i);
+      if (m->highest_comp_level() != CompLevel_full_optimization &&
+          m->highest_osr_comp_level() != CompLevel_full_optimization) {
+        continue;
+      }
+      ResourceMark rm;
+      _st->print("%s ", ik->name()->as_C_string());
+      _st->print("%s ", m->name()->as_C_string());
+      _st->print_cr("%s %d %d", m->signature()->as_C_string(),
+                    MAX2(m->invocation_count(), 0), MAX2(m->backedge_count(), 0));
+      _count++;
+    }
+  }
+};
+
+int CompilationProfile::dump(const char* path) {
+  ProfileFileWriter fs(path, profile_kind, profile_version);
+  if (!fs.is_open()) {
+    log_warning(jit, compilation)("Failed to create compilation profile %s", path);
+    return -1;
+  }
+
+  ProfileDumpClosure cl(&fs);
+  {
+    MutexLocker ml(ClassLoaderDataGraph_lock);
+    ClassLoaderDataGraph::loaded_classes_do(&cl);
+  }
+  log_info(jit, compilation)("Wrote %d methods to compilation profile %s", cl.count(), path);
+  return cl.count();
+}
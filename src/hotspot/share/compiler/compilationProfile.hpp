@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_COMPILER_COMPILATIONPROFILE_HPP
+#define SHARE_COMPILER_COMPILATIONPROFILE_HPP
+
+#include "memory/allocation.hpp"
+
+class MethodCounters;
+class methodHandle;
+class outputStream;
+
+// A compilation profile lists the methods that reached C2 in one run
+// together with their invocation and backedge counts. A later run of the
+// same application reads it with CompilationProfileFile and seeds the
+// counters of the listed methods when they are first used. The tiered
+// policy then crosses its compile thresholds early. MethodData is not
+// carried over, so the methods still get a profiled tier before C2
+// compiles them. The file is written at exit (DumpCompilationProfileAtExit)
+// or by the Compiler.profile_dump diagnostic command, and is only read by
+// the VM release that wrote it:
+//
+//   # compilation profile <version> <vm release>
+//   <class name> <method name> <signature> <invocations> <backedges>
+class CompilationProfile : AllStatic {
+  static void parse_from_file(const char* path);
+
+ public:
+  static void initialize();
+
+  // Give counters that are being created for mh the counts recorded for
+  // the method, if any.
+  static void seed_counters(const methodHandle& mh, MethodCounters* counters);
+
+  // Write the profile of the C2 compiled methods to path. Returns the
+  // number of methods written, or -1 if the file could not be opened.
+  static int dump(const char* path);
+};
+
+#endif // SHARE_COMPILER_COMPILATIONPROFILE_HPP
@@ -164,6 +164,7 @@ PerfVariable*       CompileBroker::_perf_last_compile_type = NULL;
 PerfVariable*       CompileBroker::_perf_last_compile_size = NULL;
 PerfVariable*       CompileBroker::_perf_last_failed_type = NULL;
 PerfVariable*       CompileBroker::_perf_last_invalidated_type = NULL;
+PerfCounter*        CompileBroker::_perf_cpu_time_per_level[CompLevel_full_optimization] = { NULL };
 
 // Timers and counters for generating statistics
 elapsedTimer CompileBroker::_t_total_compilation;
@@ -189,6 +190,10 @@ long CompileBroker::_peak_compilation_time         = 0;
 
 CompilerStatistics CompileBroker::_stats_per_level[CompLevel_full_optimization];
 
+double CompileBroker::_cpu_budget_processors = 0;
+jlong  CompileBroker::_cpu_budget_tokens = 0;
+jlong  CompileBroker::_cpu_budget_refill_time = 0;
+
 CompileQueue* CompileBroker::_c2_compile_queue     = NULL;
 CompileQueue* CompileBroker::_c1_compile_queue     = NULL;
 
@@ -371,6 +376,7 @@ void CompileQueue::add(CompileTask* task) {
     _last = task;
   }
   ++_size;
+  _peak_size = MAX2(_peak_size, _size);
 
   // Mark the method as being in the compile queue.
   task->method()->set_queued_for_compilation();
@@ -525,6 +531,7 @@ void CompileQueue::remove(CompileTask* task) {
 void CompileQueue::remove_and_mark_stale(CompileTask* task) {
   assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
   remove(task);
+  _stale_removed++;
 
   // Enqueue the task for reclamation (should be done outside MCQ lock)
   task->set_next(_first_stale);
@@ -549,7 +556,7 @@ CompileQueue* CompileBroker::compile_queue(int comp_level) {
   return NULL;
 }
 
-void CompileBroker::print_compile_queues(outputStream* st) {
+void CompileBroker::print_compile_queues(outputStream* st, bool print_stats) {
   st->print_cr("Current compiles: ");
 
   char buf[2000];
@@ -558,16 +565,21 @@ void CompileBroker::print_compile_queues(outputStream* st) {
 
   st->cr();
   if (_c1_compile_queue != NULL) {
-    _c1_compile_queue->print(st);
+    _c1_compile_queue->print(st, print_stats);
   }
   if (_c2_compile_queue != NULL) {
-    _c2_compile_queue->print(st);
+    _c2_compile_queue->print(st, print_stats);
   }
 }
 
-void CompileQueue::print(outputStream* st) {
+void CompileQueue::print(outputStream* st, bool print_stats) {
   assert_locked_or_safepoint(MethodCompileQueue_lock);
   st->print_cr("%s:", name());
+  if (print_stats) {
+    st->print_cr("size: %d, peak: %d, selections: " JLONG_FORMAT ", tasks scanned per selection: %.1f, stale tasks removed: " JLONG_FORMAT,
+                 _size, _peak_size, _selections,
+                 _selections > 0 ? (double)_scanned / _selections : 0.0, _stale_removed);
+  }
   CompileTask* task = _first;
   if (task == NULL) {
     st->print_cr("Empty");
@@ -594,6 +606,9 @@ void CompileQueue::print_tty() {
 CompilerCounters::CompilerCounters() {
   _current_method[0] = '\0';
   _compile_type = CompileBroker::no_compile;
+  for (int i = 0; i < CompLevel_full_optimization; i++) {
+    _cpu_time[i] = 0;
+  }
 }
 
 #if INCLUDE_JFR && COMPILER2_OR_JVMCI
@@ -636,6 +651,12 @@ void CompileBroker::compilation_init_phase1(JavaThread* THREAD) {
   _c1_count = CompilationPolicy::c1_count();
   _c2_count = CompilationPolicy::c2_count();
 
+  if (CompilerCPUBudget > 0) {
+    _cpu_budget_processors = os::active_processor_count() * CompilerCPUBudget / 100.0;
+    _cpu_budget_tokens = (jlong)(_cpu_budget_processors * NANOSECS_PER_SEC);
+    _cpu_budget_refill_time = os::javaTimeNanos();
+  }
+
 #if INCLUDE_JVMCI
   if (EnableJVMCI) {
     // This is creating a JVMCICompiler singleton.
@@ -785,6 +806,14 @@ void CompileBroker::compilation_init_phase1(JavaThread* THREAD) {
                                           PerfData::U_None,
                                           (jlong)CompileBroker::no_compile,
                                           CHECK);
+
+    for (int i = 0; i < CompLevel_full_optimization; i++) {
+      char name[16];
+      jio_snprintf(name, sizeof(name), "tier%dCpuTime", i + 1);
+      _perf_cpu_time_per_level[i] =
+               PerfDataManager::create_counter(SUN_CI, name,
+                                               PerfData::U_Ticks, CHECK);
+    }
   }
 }
 
@@ -1060,6 +1089,46 @@ void CompileBroker::init_compiler_sweeper_threads() {
 #endif // defined(ASSERT) && COMPILER2_OR_JVMCI
 }
 
+// The number of C2 (or JVMCI) compiler threads that CompilerCPUBudget allows
+// to run. The budget only covers the top tier; C1 compilations are short and
+// are what gets a warming up application to reasonable speed, so they are
+// never held back.
+int CompileBroker::cpu_budget_thread_limit() {
+  if (CompilerCPUBudget == 0) {
+    return max_jint;
+  }
+  return MAX2(1, (int)ceil(_cpu_budget_processors));
+}
+
+// The budget is earned at the rate of _cpu_budget_processors and saved up
+// for at most one second.
+void CompileBroker::refill_cpu_budget(jlong now) {
+  assert_lock_strong(CompileStatistics_lock);
+  jlong capacity = (jlong)(_cpu_budget_processors * NANOSECS_PER_SEC);
+  jlong earned = (jlong)((now - _cpu_budget_refill_time) * _cpu_budget_processors);
+  _cpu_budget_tokens = MIN2(capacity, _cpu_budget_tokens + earned);
+  _cpu_budget_refill_time = now;
+}
+
+// Delay the next compilation on this thread until the compilations of the
+// recent past fit in CompilerCPUBudget again.
+void CompileBroker::wait_for_cpu_budget(CompilerThread* thread) {
+  while (!is_compilation_disabled_forever()) {
+    jlong deficit;
+    {
+      MutexLocker locker(thread, CompileStatistics_lock);
+      refill_cpu_budget(os::javaTimeNanos());
+      deficit = -_cpu_budget_tokens;
+    }
+    if (deficit <= 0) {
+      return;
+    }
+    jlong wait_ms = (jlong)(deficit / _cpu_budget_processors) / NANOSECS_PER_MILLISEC + 1;
+    ThreadBlockInVM tbivm(thread);
+    os::naked_short_sleep(MIN2(wait_ms, (jlong)100));
+  }
+}
+
 void CompileBroker::possibly_add_compiler_threads(JavaThread* THREAD) {
 
   julong available_memory = os::available_memory();
@@ -1071,11 +1140,13 @@ void CompileBroker::possibly_add_compiler_threads(JavaThread* THREAD) {
   if (!CompileThread_lock->try_lock()) return;
 
   if (_c2_compile_queue != NULL) {
+    int thread_limit = cpu_budget_thread_limit();
     int old_c2_count = _compilers[1]->num_compiler_threads();
     int new_c2_count = MIN4(_c2_count,
         _c2_compile_queue->size() / 2,
         (int)(available_memory / (200*M)),
         (int)(available_cc_np / (128*K)));
+    new_c2_count = MIN2(new_c2_count, thread_limit);
 
     for (int i = old_c2_count; i < new_c2_count; i++) {
 #if INCLUDE_JVMCI
@@ -1982,6 +2053,9 @@ void CompileBroker::compiler_thread_loop() {
       if (method()->number_of_breakpoints() == 0) {
         // Compile the method.
         if ((UseCompiler || AlwaysCompileLoopMethods) && CompileBroker::should_compile_new_jobs()) {
+          if (CompilerCPUBudget > 0 && task->comp_level() == CompLevel_full_optimization) {
+            wait_for_cpu_budget(thread);
+          }
           invoke_compiler_on_method(task);
           thread->start_idle_timer();
         } else {
@@ -2179,6 +2253,7 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     task->print_tty();
   }
   elapsedTimer time;
+  jlong cpu_start = os::is_thread_cpu_time_supported() ? os::current_thread_cpu_time() : 0;
 
   CompilerThread* thread = CompilerThread::current();
   ResourceMark rm(thread);
@@ -2362,7 +2437,8 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
 
   DTRACE_METHOD_COMPILE_END_PROBE(method, compiler_name(task_level), task->is_success());
 
-  collect_statistics(thread, time, task);
+  jlong cpu_time = os::is_thread_cpu_time_supported() ? os::current_thread_cpu_time() - cpu_start : 0;
+  collect_statistics(thread, time, cpu_time, task);
 
   nmethod* nm = task->code();
   if (nm != NULL) {
@@ -2539,7 +2615,7 @@ void CompileBroker::pop_jni_handle_block() {
 //
 // Collect statistics about the compilation.
 
-void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time, CompileTask* task) {
+void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time, jlong cpu_time, CompileTask* task) {
   bool success = task->is_success();
   methodHandle method (thread, task->method());
   uint compile_id = task->compile_id();
@@ -2551,6 +2627,22 @@ void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time
   assert(code == NULL || code->is_locked_by_vm(), "will survive the MutexLocker");
   MutexLocker locker(CompileStatistics_lock);
 
+  // CPU time is accounted for all compilations, including bailouts
+  if (comp_level > CompLevel_none && comp_level <= CompLevel_full_optimization) {
+    counters->add_cpu_time(comp_level, cpu_time);
+    _stats_per_level[comp_level-1]._cpu_time += cpu_time;
+    if (UsePerfData) {
+      _perf_cpu_time_per_level[comp_level-1]->inc((jlong)((double)cpu_time * os::elapsed_frequency() / NANOSECS_PER_SEC));
+    }
+  }
+  if (compiler(comp_level) != NULL) {
+    compiler(comp_level)->stats()->_cpu_time += cpu_time;
+  }
+  if (CompilerCPUBudget > 0 && comp_level == CompLevel_full_optimization) {
+    refill_cpu_budget(os::javaTimeNanos());
+    _cpu_budget_tokens -= cpu_time;
+  }
+
   // _perf variables are production performance counters which are
   // updated regardless of the setting of the CITime and CITimeEach flags
   //
@@ -2682,11 +2774,12 @@ jlong CompileBroker::total_compilation_ticks() {
 }
 
 void CompileBroker::print_times(const char* name, CompilerStatistics* stats) {
-  tty->print_cr("  %s {speed: %6.3f bytes/s; standard: %6.3f s, %d bytes, %d methods; osr: %6.3f s, %d bytes, %d methods; nmethods_size: %d bytes; nmethods_code_size: %d bytes}",
+  tty->print_cr("  %s {speed: %6.3f bytes/s; standard: %6.3f s, %d bytes, %d methods; osr: %6.3f s, %d bytes, %d methods; nmethods_size: %d bytes; nmethods_code_size: %d bytes; cpu: %6.3f s}",
                 name, stats->bytes_per_second(),
                 stats->_standard._time.seconds(), stats->_standard._bytes, stats->_standard._count,
                 stats->_osr._time.seconds(), stats->_osr._bytes, stats->_osr._count,
-                stats->_nmethods_size, stats->_nmethods_code_size);
+                stats->_nmethods_size, stats->_nmethods_code_size,
+                (double)stats->_cpu_time / NANOSECS_PER_SEC);
 }
 
 void CompileBroker::print_times(bool per_compiler, bool aggregate) {
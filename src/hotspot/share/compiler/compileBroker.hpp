@@ -55,6 +55,7 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 
     char _current_method[cmname_buffer_length];
     int  _compile_type;
+    jlong _cpu_time[CompLevel_full_optimization];  // thread CPU time spent compiling per tier, in nanoseconds
 
   public:
     CompilerCounters();
@@ -74,6 +75,15 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 
     int compile_type()                       { return _compile_type; }
 
+    void add_cpu_time(int comp_level, jlong nanos) {
+      assert(comp_level > CompLevel_none && comp_level <= CompLevel_full_optimization, "invalid level");
+      _cpu_time[comp_level-1] += nanos;
+    }
+    jlong cpu_time(int comp_level) const {
+      assert(comp_level > CompLevel_none && comp_level <= CompLevel_full_optimization, "invalid level");
+      return _cpu_time[comp_level-1];
+    }
+
 };
 
 // CompileQueue
@@ -90,6 +100,12 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   int _size;
 
+  // Statistics printed by Compiler.queue -stats
+  int     _peak_size;
+  jlong   _selections;        // number of times a task was selected
+  jlong   _scanned;           // tasks looked at while selecting
+  jlong   _stale_removed;     // tasks dropped without being compiled
+
   void purge_stale_tasks();
  public:
   CompileQueue(const char* name) {
@@ -98,6 +114,10 @@ class CompileQueue : public CHeapObj<mtCompiler> {
     _last = NULL;
     _size = 0;
     _first_stale = NULL;
+    _peak_size = 0;
+    _selections = 0;
+    _scanned = 0;
+    _stale_removed = 0;
   }
 
   const char*  name() const                      { return _name; }
@@ -113,12 +133,16 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   bool         is_empty() const                  { return _first == NULL; }
   int          size()     const                  { return _size;          }
 
+  // Called by the compilation policy after it looked at 'scanned' tasks
+  // to select the next one.
+  void record_selection(int scanned)             { _selections++; _scanned += scanned; }
+
 
   // Redefine Classes support
   void mark_on_stack();
   void free_all();
   void print_tty();
-  void print(outputStream* st = tty);
+  void print(outputStream* st = tty, bool print_stats = false);
 
   ~CompileQueue() {
     assert (is_empty(), " Compile Queue must be empty");
@@ -203,6 +227,7 @@ class CompileBroker: AllStatic {
   static PerfVariable*       _perf_last_compile_size;
   static PerfVariable*       _perf_last_failed_type;
   static PerfVariable*       _perf_last_invalidated_type;
+  static PerfCounter*        _perf_cpu_time_per_level[];
 
   // Timers and counters for generating statistics
   static elapsedTimer _t_total_compilation;
@@ -227,6 +252,13 @@ class CompileBroker: AllStatic {
 
   static CompilerStatistics _stats_per_level[];
 
+  // CompilerCPUBudget: the processors compiler threads may keep busy, and
+  // a token bucket of the compilation CPU time, in nanoseconds, that may
+  // still be spent. Protected by CompileStatistics_lock.
+  static double _cpu_budget_processors;
+  static jlong  _cpu_budget_tokens;
+  static jlong  _cpu_budget_refill_time;
+
   static volatile int _print_compilation_warning;
 
   enum ThreadType {
@@ -239,6 +271,9 @@ class CompileBroker: AllStatic {
   static JavaThread* make_thread(ThreadType type, jobject thread_oop, CompileQueue* queue, AbstractCompiler* comp, JavaThread* THREAD);
   static void init_compiler_sweeper_threads();
   static void possibly_add_compiler_threads(JavaThread* THREAD);
+  static int  cpu_budget_thread_limit();
+  static void refill_cpu_budget(jlong now);
+  static void wait_for_cpu_budget(CompilerThread* thread);
   static bool compilation_is_prohibited(const methodHandle& method, int osr_bci, int comp_level, bool excluded);
 
   static CompileTask* create_compile_task(CompileQueue*       queue,
@@ -262,7 +297,7 @@ class CompileBroker: AllStatic {
 
   static void push_jni_handle_block();
   static void pop_jni_handle_block();
-  static void collect_statistics(CompilerThread* thread, elapsedTimer time, CompileTask* task);
+  static void collect_statistics(CompilerThread* thread, elapsedTimer time, jlong cpu_time, CompileTask* task);
 
   static void compile_method_base(const methodHandle& method,
                                   int osr_bci,
@@ -291,7 +326,7 @@ public:
 
   static bool compilation_is_complete(const methodHandle& method, int osr_bci, int comp_level);
   static bool compilation_is_in_queue(const methodHandle& method);
-  static void print_compile_queues(outputStream* st);
+  static void print_compile_queues(outputStream* st, bool print_stats = false);
   static int queue_size(int comp_level) {
     CompileQueue *q = compile_queue(comp_level);
     return q != NULL ? q->size() : 0;
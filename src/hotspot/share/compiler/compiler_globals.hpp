@@ -307,6 +307,15 @@
           "File containing inlining replay information"                     \
           "[default: ./inline_pid%p.log] (%p replaced with pid)")           \
                                                                             \
+  product(ccstr, CompilationProfileFile, NULL, EXPERIMENTAL,                \
+          "Seed the invocation and backedge counters of the methods "       \
+          "listed in this compilation profile, so that they reach the "     \
+          "tiered compilation thresholds soon after their first use")       \
+                                                                            \
+  product(ccstr, DumpCompilationProfileAtExit, NULL, EXPERIMENTAL,          \
+          "Write the counters of the C2-compiled methods to this file "     \
+          "at exit, for use with CompilationProfileFile")                   \
+                                                                            \
   develop(intx, ReplaySuppressInitializers, 2,                              \
           "Control handling of class initialization during replay: "        \
           "0 - don't do anything special; "                                 \
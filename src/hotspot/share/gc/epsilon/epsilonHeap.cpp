@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, 2020, Red Hat, Inc. All rights reserved.
+ * Copyright (c) 2017, 2021, Red Hat, Inc. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,19 +23,39 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "code/codeCache.hpp"
+#include "compiler/oopMap.hpp"
 #include "gc/epsilon/epsilonHeap.hpp"
 #include "gc/epsilon/epsilonInitLogger.hpp"
 #include "gc/epsilon/epsilonMemoryPool.hpp"
 #include "gc/epsilon/epsilonThreadLocalData.hpp"
 #include "gc/shared/gcArguments.hpp"
+#include "gc/shared/gcId.hpp"
+#include "gc/shared/gcTraceTime.inline.hpp"
+#include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/isGCActiveMark.hpp"
 #include "gc/shared/locationPrinter.inline.hpp"
+#include "gc/shared/markBitMap.inline.hpp"
+#include "gc/shared/oopStorageSet.inline.hpp"
+#include "gc/shared/spaceDecorator.hpp"
+#include "gc/shared/weakProcessor.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/iterator.inline.hpp"
 #include "memory/metaspaceUtils.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "oops/compressedOops.inline.hpp"
+#include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/java.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vmThread.hpp"
+#include "services/memTracker.hpp"
+#include "services/memoryService.hpp"
+#include "utilities/stack.inline.hpp"
 
 jint EpsilonHeap::initialize() {
   size_t align = HeapAlignment;
@@ -53,6 +73,19 @@ jint EpsilonHeap::initialize() {
   _space = new ContiguousSpace();
   _space->initialize(committed_region, /* clear_space = */ true, /* mangle_space = */ true);
 
+  if (EpsilonResetTop) {
+    // Reserve the mark bitmap for the entire heap. It is only committed
+    // for the duration of reset_top().
+    size_t bitmap_size = MarkBitMap::compute_size(heap_rs.size());
+    ReservedSpace bitmap_rs(bitmap_size);
+    if (!bitmap_rs.is_reserved()) {
+      vm_exit_during_initialization("Could not reserve enough space for mark bitmap");
+    }
+    MemTracker::record_virtual_memory_type(bitmap_rs.base(), mtGC);
+    _bitmap_region = MemRegion((HeapWord*) bitmap_rs.base(), bitmap_rs.size() / HeapWordSize);
+    _bitmap.initialize(MemRegion((HeapWord*) heap_rs.base(), heap_rs.size() / HeapWordSize), _bitmap_region);
+  }
+
   // Precompute hot fields
   _max_tlab_size = MIN2(CollectedHeap::max_tlab_size(), align_object_size(EpsilonMaxTLABSize / HeapWordSize));
   _step_counter_update = MIN2<size_t>(max_byte_size / 16, EpsilonUpdateCountersStep);
@@ -263,8 +296,42 @@ HeapWord* EpsilonHeap::mem_allocate(size_t size, bool *gc_overhead_limit_was_exc
   return allocate_work(size);
 }
 
+class VM_EpsilonResetTop : public VM_GC_Operation {
+public:
+  VM_EpsilonResetTop(uint gc_count_before, uint full_gc_count_before, GCCause::Cause cause) :
+    VM_GC_Operation(gc_count_before, cause, full_gc_count_before, true /* full */) {}
+
+  virtual VMOp_Type type() const { return VMOp_EpsilonResetTop; }
+
+  virtual void doit() {
+    EpsilonHeap* heap = EpsilonHeap::heap();
+    SvcGCMarker sgcm(SvcGCMarker::FULL);
+    GCCauseSetter gccs(heap, _gc_cause);
+    heap->reset_top();
+  }
+};
+
 void EpsilonHeap::collect(GCCause::Cause cause) {
   switch (cause) {
+    case GCCause::_java_lang_system_gc:
+    case GCCause::_dcmd_gc_run:
+    case GCCause::_wb_full_gc:
+      if (EpsilonResetTop) {
+        // Application-requested GC: marking the heap costs only what the
+        // application asked for, and lets us reclaim the unreachable tail.
+        assert(!SafepointSynchronize::is_at_safepoint(), "Should not be at safepoint");
+        uint gc_count, full_gc_count;
+        {
+          MutexLocker ml(Heap_lock);
+          gc_count = total_collections();
+          full_gc_count = total_full_collections();
+        }
+        VM_EpsilonResetTop op(gc_count, full_gc_count, cause);
+        VMThread::execute(&op);
+        break;
+      }
+      log_info(gc)("GC request for \"%s\" is ignored", GCCause::to_string(cause));
+      break;
     case GCCause::_metadata_GC_threshold:
     case GCCause::_metadata_GC_clear_soft_refs:
       // Receiving these causes means the VM itself entered the safepoint for metadata collection.
@@ -286,6 +353,138 @@ void EpsilonHeap::do_full_collection(bool clear_all_soft_refs) {
   collect(gc_cause());
 }
 
+class EpsilonMarkClosure : public BasicOopIterateClosure {
+private:
+  MarkBitMap* const _bitmap;
+  Stack<oop, mtGC>* const _stack;
+
+  template <class T>
+  void do_oop_work(T* p) {
+    T o = RawAccess<>::oop_load(p);
+    if (!CompressedOops::is_null(o)) {
+      oop obj = CompressedOops::decode_not_null(o);
+      if (!_bitmap->is_marked(obj)) {
+        _bitmap->mark(obj);
+        _stack->push(obj);
+      }
+    }
+  }
+
+public:
+  EpsilonMarkClosure(MarkBitMap* bitmap, Stack<oop, mtGC>* stack) :
+    _bitmap(bitmap), _stack(stack) {}
+
+  // No reference discovery: referents are treated as strong.
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class EpsilonIsAliveClosure : public BoolObjectClosure {
+private:
+  MarkBitMap* const _bitmap;
+
+public:
+  EpsilonIsAliveClosure(MarkBitMap* bitmap) : _bitmap(bitmap) {}
+
+  virtual bool do_object_b(oop obj) {
+    return _bitmap->is_marked(obj);
+  }
+};
+
+void EpsilonHeap::reset_top() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
+  assert(Thread::current()->is_VM_thread(), "Should be in VM thread");
+
+  GCIdMark gc_id_mark;
+  GCTraceTime(Info, gc) time("Reset Top", NULL, gc_cause(), true);
+  TraceMemoryManagerStats tms(&_memory_manager, gc_cause());
+  IsGCActiveMark gc_active_mark;
+  increment_total_collections(true /* full */);
+
+  // Retire all TLABs, so that the heap is parsable and nobody allocates
+  // into the area we are about to reclaim.
+  ensure_parsability(true);
+
+  HeapWord* bottom  = _space->bottom();
+  HeapWord* old_top = _space->top();
+  size_t old_used = _space->used();
+
+  // Commit the part of the bitmap that covers the used heap.
+  MemRegion used_region(bottom, old_top);
+  size_t bitmap_bytes = MIN2(MarkBitMap::compute_size(old_used), _bitmap_region.byte_size());
+  os::commit_memory_or_exit((char*) _bitmap_region.start(), bitmap_bytes, false,
+                            "Could not commit native memory for mark bitmap");
+  if (!used_region.is_empty()) {
+    _bitmap.clear_range_large(used_region);
+  }
+
+  // Mark everything reachable from roots.
+  {
+#if COMPILER2_OR_JVMCI
+    DerivedPointerTable::clear();
+#endif
+
+    Stack<oop, mtGC> stack;
+    EpsilonMarkClosure cl(&_bitmap, &stack);
+    CLDToOopClosure cld_cl(&cl, ClassLoaderData::_claim_none);
+    CodeBlobToOopClosure blobs_cl(&cl, false /* fix_relocations */);
+
+    Threads::oops_do(&cl, &blobs_cl);
+    OopStorageSet::strong_oops_do(&cl);
+    ClassLoaderDataGraph::cld_do(&cld_cl);
+    CodeCache::blobs_do(&blobs_cl);
+
+    while (!stack.is_empty()) {
+      oop obj = stack.pop();
+      obj->oop_iterate(&cl);
+    }
+
+#if COMPILER2_OR_JVMCI
+    DerivedPointerTable::update_pointers();
+#endif
+  }
+
+  // Weak roots pointing to unreachable objects would dangle after the reset.
+  {
+    EpsilonIsAliveClosure is_alive(&_bitmap);
+    DoNothingClosure keep_alive;
+    WeakProcessor::weak_oops_do(&is_alive, &keep_alive);
+  }
+
+  // Find the end of the last reachable object. Unreachable objects below it
+  // are overwritten with fillers, so that nothing in the parsable heap refers
+  // to the reclaimed area.
+  HeapWord* new_top = bottom;
+  size_t live = 0;
+  while (new_top < old_top) {
+    HeapWord* next = _bitmap.get_next_marked_addr(new_top, old_top);
+    if (next >= old_top) {
+      break;
+    }
+    if (next > new_top) {
+      fill_with_objects(new_top, pointer_delta(next, new_top));
+    }
+    size_t size = cast_to_oop(next)->size();
+    live += size;
+    new_top = next + size;
+  }
+
+  _space->set_top(new_top);
+  SpaceMangler::mangle_region(MemRegion(new_top, old_top));
+
+  size_t new_used = _space->used();
+  _last_counter_update = new_used;
+  _last_heap_print = new_used;
+
+  os::uncommit_memory((char*) _bitmap_region.start(), bitmap_bytes);
+
+  log_info(gc)("Reset Top: " SIZE_FORMAT "%s live, " SIZE_FORMAT "%s reclaimed, "
+               SIZE_FORMAT "%s used",
+               byte_size_in_proper_unit(live * HeapWordSize), proper_unit_for_byte_size(live * HeapWordSize),
+               byte_size_in_proper_unit(old_used - new_used), proper_unit_for_byte_size(old_used - new_used),
+               byte_size_in_proper_unit(new_used), proper_unit_for_byte_size(new_used));
+}
+
 void EpsilonHeap::object_iterate(ObjectClosure *cl) {
   _space->object_iterate(cl);
 }
@@ -1,6 +1,6 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
- * Copyright (c) 2017, 2018, Red Hat, Inc. All rights reserved.
+ * Copyright (c) 2020, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2017, 2021, Red Hat, Inc. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -86,7 +86,14 @@
   product(size_t, EpsilonMinHeapExpand, 128 * M, EXPERIMENTAL,              \
           "Min expansion step for heap. Larger value improves performance " \
           "at the potential expense of memory waste.")                      \
-          range(1, max_intx)
+          range(1, max_intx)                                                \
+                                                                            \
+  product(bool, EpsilonResetTop, false, EXPERIMENTAL,                       \
+          "Handle explicit GC requests (System.gc(), GC.run) by marking "   \
+          "the heap from roots and moving the allocation top back to the "  \
+          "end of the last reachable object. This reclaims the space "      \
+          "allocated since the last reachable object, e.g. by an ended "    \
+          "batch phase, without adding any barriers.")
 
 // end of GC_EPSILON_FLAGS
 
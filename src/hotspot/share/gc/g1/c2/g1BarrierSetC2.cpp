@@ -318,16 +318,25 @@ bool G1BarrierSetC2::g1_can_remove_post_barrier(GraphKit* kit,
      return false; // No allocation found
   }
 
-  // Start search from Store node
-  Node* mem = store->in(MemNode::Control);
-  if (mem->is_Proj() && mem->in(0)->is_Initialize()) {
-
-    InitializeNode* st_init = mem->in(0)->as_Initialize();
-    AllocateNode*  st_alloc = st_init->allocation();
-
-    // Make sure we are looking at the same allocation
-    if (alloc == st_alloc) {
-      return true;
+  // Start search from Store node and walk up straight-line control.
+  // Branches and memory barriers cannot safepoint, so the object is
+  // still as freshly allocated as at the Initialize. Anything else,
+  // in particular calls, safepoints and merge points, ends the search.
+  const int max_steps = 20;
+  Node* ctrl = store->in(MemNode::Control);
+  for (int i = 0; i < max_steps && ctrl != NULL && !ctrl->is_top(); i++) {
+    if (ctrl->is_Proj() && ctrl->in(0)->is_Initialize()) {
+      InitializeNode* st_init = ctrl->in(0)->as_Initialize();
+      AllocateNode*  st_alloc = st_init->allocation();
+
+      // Make sure we are looking at the same allocation
+      return alloc == st_alloc;
+    }
+    if (ctrl->is_IfProj() ||
+        (ctrl->is_Proj() && ctrl->in(0)->is_MemBar())) {
+      ctrl = ctrl->in(0)->in(0);
+    } else {
+      break;
     }
   }
 
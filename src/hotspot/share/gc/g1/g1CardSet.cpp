@@ -32,6 +32,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/globals_extension.hpp"
 #include "runtime/mutex.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/concurrentHashTable.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -92,6 +93,17 @@ G1CardSetConfiguration::G1CardSetConfiguration(uint inline_ptr_bits_per_card,
   log_configuration();
 }
 
+void G1CardSetConfiguration::set_coarsen_to_full_percent(uint howl_percent, uint howl_bitmap_percent) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  assert(howl_percent >= 1 && howl_percent <= 100, "invalid percentage %u", howl_percent);
+  assert(howl_bitmap_percent >= 1 && howl_bitmap_percent <= 100, "invalid percentage %u", howl_bitmap_percent);
+
+  _cards_in_howl_threshold = _max_cards_in_card_set * (double)howl_percent / 100;
+  _cards_in_howl_bitmap_threshold = _num_cards_in_howl_bitmap * (double)howl_bitmap_percent / 100;
+
+  log_configuration();
+}
+
 void G1CardSetConfiguration::log_configuration() {
   log_debug_p(gc, remset)("Card Set container configuration: "
                           "InlinePtr #elems %u size %zu "
@@ -152,6 +164,11 @@ void G1CardSetCoarsenStats::record_coarsening(uint tag, bool collision) {
   }
 }
 
+size_t G1CardSetCoarsenStats::num_coarsened_to_full() const {
+  // Howl->Full and BitMap->Full, see print_on().
+  return _coarsen_from[3] + _coarsen_from[6];
+}
+
 void G1CardSetCoarsenStats::print_on(outputStream* out) {
   out->print_cr("Inline->AoC %zu (%zu) "
                 "AoC->Howl %zu (%zu) "
@@ -96,6 +96,12 @@ public:
   // Given a card index, return the bucket in the array of card sets.
   uint howl_bucket_index(uint card_idx) { return card_idx >> _log2_num_cards_in_howl_bitmap; }
 
+  // Change the occupancy in percent at which Howl and Howl Bitmap containers
+  // are coarsened to Full. Existing containers above the new thresholds are
+  // coarsened on their next insertion. Must be called at a safepoint, as
+  // concurrent card set operations read these thresholds.
+  void set_coarsen_to_full_percent(uint howl_percent, uint howl_bitmap_percent);
+
   // Full card configuration
   // Maximum number of cards in a non-full card set for a single region. Card sets
   // with more entries per region are coarsened to Full.
@@ -141,6 +147,9 @@ public:
   // this coarsening lost the race to do the coarsening of that category.
   void record_coarsening(uint tag, bool collision);
 
+  // Number of coarsenings of Howl and Howl Bitmap containers to Full.
+  size_t num_coarsened_to_full() const;
+
   void print_on(outputStream* out);
 };
 
@@ -1919,6 +1919,7 @@ bool G1CollectedHeap::should_do_concurrent_full_gc(GCCause::Cause cause) {
   switch (cause) {
     case GCCause::_g1_humongous_allocation: return true;
     case GCCause::_g1_periodic_collection:  return G1PeriodicGCInvokesConcurrent;
+    case GCCause::_codecache_GC_threshold:  return ClassUnloadingWithConcurrentMark;
     case GCCause::_wb_breakpoint:           return true;
     default:                                return is_user_requested_concurrent_full_gc(cause);
   }
@@ -3118,7 +3119,9 @@ void G1CollectedHeap::complete_cleaning(BoolObjectClosure* is_alive,
                                         bool class_unloading_occurred) {
   uint num_workers = workers()->active_workers();
   G1ParallelCleaningTask unlink_task(is_alive, num_workers, class_unloading_occurred);
+  phase_times()->reset_parallel_cleaning();
   workers()->run_task(&unlink_task);
+  phase_times()->print_parallel_cleaning();
 }
 
 // Weak Reference Processing support
@@ -3386,12 +3389,15 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       // structures don't support efficiently performing the needed
       // additional tests or scrubbing of the mark stack.
       //
-      // However, we presently only nominate is_typeArray() objects.
       // A humongous object containing references induces remembered
-      // set entries on other regions.  In order to reclaim such an
-      // object, those remembered sets would need to be cleaned up.
+      // set entries on other regions.  These entries become stale when
+      // the object is reclaimed, exactly like the entries of old regions
+      // freed by Cleanup.  Remembered set scanning and refinement already
+      // ignore stale cards in free or young regions, and trim cards in
+      // reallocated regions to the allocated part, so they need no
+      // clean up.
       //
-      // We also treat is_typeArray() objects specially, allowing them
+      // We treat is_typeArray() objects specially, allowing them
       // to be reclaimed even if allocated before the start of
       // concurrent mark.  For this we rely on mark stack insertion to
       // exclude is_typeArray() objects, preventing reclaiming an object
@@ -3401,8 +3407,12 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       // important use case for eager reclaim, and this special handling
       // may reduce needed headroom.
 
-      return obj->is_typeArray() &&
-             _g1h->is_potential_eager_reclaim_candidate(region);
+      if (!_g1h->is_potential_eager_reclaim_candidate(region)) {
+        return false;
+      }
+      return obj->is_typeArray() ||
+             !_g1h->collector_state()->mark_or_rebuild_in_progress() ||
+             region->obj_allocated_since_next_marking(obj);
     }
 
   public:
@@ -3805,6 +3815,7 @@ void G1CollectedHeap::post_evacuate_collection_set(G1EvacuationInfo& evacuation_
 
   policy()->print_age_table();
   rem_set()->print_coarsen_stats();
+  rem_set()->adjust_card_set_coarsening();
 }
 
 void G1CollectedHeap::record_obj_copy_mem_stats() {
@@ -1052,6 +1052,8 @@ public:
   G1Policy* policy() const { return _policy; }
   // The remembered set.
   G1RemSet* rem_set() const { return _rem_set; }
+  // The card set configuration shared by all remembered sets.
+  G1CardSetConfiguration* card_set_config() { return &_card_set_config; }
 
   inline G1GCPhaseTimes* phase_times() const;
 
@@ -1376,7 +1376,8 @@ public:
   G1CMKeepAliveAndDrainClosure(G1ConcurrentMark* cm, G1CMTask* task, bool is_serial) :
     _cm(cm), _task(task), _ref_counter_limit(G1RefProcDrainInterval),
     _ref_counter(_ref_counter_limit), _is_serial(is_serial) {
-    assert(!_is_serial || _task->worker_id() == 0, "only task 0 for serial code");
+    assert(!_is_serial || _task->worker_id() == 0 || _cm->concurrent(),
+           "only task 0 for serial code in a pause");
   }
 
   virtual void do_oop(narrowOop* p) { do_oop_work(p); }
@@ -1427,15 +1428,21 @@ public:
 // do_marking_step routine, with an unbelievably large timeout value,
 // to drain the marking data structures of the remaining entries
 // added by the 'keep alive' oop closure above.
+// Parallel precleaning runs several serial tasks at once without a
+// termination protocol; each one only drains what it can see, and the
+// last one to finish leaves the global mark stack empty.
 
 class G1CMDrainMarkingStackClosure : public VoidClosure {
   G1ConcurrentMark* _cm;
   G1CMTask*         _task;
   bool              _is_serial;
+  bool              _do_termination;
  public:
-  G1CMDrainMarkingStackClosure(G1ConcurrentMark* cm, G1CMTask* task, bool is_serial) :
-    _cm(cm), _task(task), _is_serial(is_serial) {
-    assert(!_is_serial || _task->worker_id() == 0, "only task 0 for serial code");
+  G1CMDrainMarkingStackClosure(G1ConcurrentMark* cm, G1CMTask* task, bool is_serial,
+                               bool do_termination = true) :
+    _cm(cm), _task(task), _is_serial(is_serial), _do_termination(do_termination) {
+    assert(!_is_serial || _task->worker_id() == 0 || !_do_termination,
+           "only task 0 for serial code with termination");
   }
 
   void do_void() {
@@ -1458,7 +1465,7 @@ class G1CMDrainMarkingStackClosure : public VoidClosure {
       // has_aborted() flag that the marking step has completed.
 
       _task->do_marking_step(1000000000.0 /* something very large */,
-                             true         /* do_termination */,
+                             _do_termination,
                              _is_serial);
     } while (_task->has_aborted() && !_cm->has_overflown());
   }
@@ -1589,9 +1596,85 @@ public:
   }
 };
 
+// Precleans the discovered lists owned by the id of the current worker
+// thread, see ReferenceProcessor::preclean_discovered_references(). Each
+// worker uses the marking task with its thread id in serial mode, so no
+// termination or overflow synchronization is needed between workers.
+class G1PrecleanTask : public AbstractGangTask {
+  G1ConcurrentMark* _cm;
+  ReferenceProcessor* _rp;
+  SubTasksDone* _owners;
+  uint _num_owners;
+
+public:
+  G1PrecleanTask(G1ConcurrentMark* cm, ReferenceProcessor* rp, SubTasksDone* owners, uint num_owners) :
+    AbstractGangTask("Preclean References"),
+    _cm(cm),
+    _rp(rp),
+    _owners(owners),
+    _num_owners(num_owners) { }
+
+  void work(uint worker_id) {
+    assert(Thread::current()->is_ConcurrentGC_thread(), "Not a concurrent GC thread");
+    uint owner = WorkerThread::current()->id();
+    assert(owner < _num_owners, "owner %u out of range %u", owner, _num_owners);
+    // A thread may be handed more than one work item.
+    if (!_owners->try_claim_task(owner)) {
+      return;
+    }
+
+    SuspendibleThreadSetJoiner sts_join;
+    G1CMTask* task = _cm->task(owner);
+    G1CMKeepAliveAndDrainClosure keep_alive(_cm, task, true /* is_serial */);
+    G1CMDrainMarkingStackClosure drain_mark_stack(_cm, task, true /* is_serial */, false /* do_termination */);
+    G1PrecleanYieldClosure yield_cl(_cm);
+    _rp->preclean_discovered_references(owner, _num_owners,
+                                        _rp->is_alive_non_header(),
+                                        &keep_alive,
+                                        &drain_mark_stack,
+                                        &yield_cl);
+  }
+};
+
+void G1ConcurrentMark::preclean_parallel() {
+  ReferenceProcessor* rp = _g1h->ref_processor_cm();
+  uint num_owners = _concurrent_workers->total_workers();
+  SubTasksDone owners(num_owners);
+
+  set_concurrency_and_phase(1, true);
+
+  {
+    G1PrecleanTask task(this, rp, &owners, num_owners);
+    _concurrent_workers->run_task(&task, _num_concurrent_workers);
+  }
+
+  // Lists whose owning thread did not take part are precleaned here. MT
+  // discovery is disabled, so this thread may add to any list it walks.
+  SuspendibleThreadSetJoiner joiner;
+  G1CMKeepAliveAndDrainClosure keep_alive(this, task(0), true /* is_serial */);
+  G1CMDrainMarkingStackClosure drain_mark_stack(this, task(0), true /* is_serial */);
+  G1PrecleanYieldClosure yield_cl(this);
+  ReferenceProcessorMTDiscoveryMutator rp_mut_discovery(rp, false);
+  for (uint owner = 0; owner < num_owners; owner++) {
+    if (owners.try_claim_task(owner)) {
+      rp->preclean_discovered_references(owner, num_owners,
+                                         rp->is_alive_non_header(),
+                                         &keep_alive,
+                                         &drain_mark_stack,
+                                         &yield_cl);
+    }
+  }
+  owners.all_tasks_claimed();
+}
+
 void G1ConcurrentMark::preclean() {
   assert(G1UseReferencePrecleaning, "Precleaning must be enabled.");
 
+  if (G1ParallelReferencePrecleaning && _max_concurrent_workers > 1) {
+    preclean_parallel();
+    return;
+  }
+
   SuspendibleThreadSetJoiner joiner;
 
   G1CMKeepAliveAndDrainClosure keep_alive(this, task(0), true /* is_serial */);
@@ -2240,14 +2323,52 @@ void G1CMTask::drain_local_queue(bool partially) {
   }
 
   if (_task_queue->size() > target_size) {
-    G1TaskQueueEntry entry;
-    bool ret = _task_queue->pop_local(entry);
-    while (ret) {
-      scan_task_entry(entry);
-      if (_task_queue->size() <= target_size || has_aborted()) {
-        ret = false;
+    const uint distance = G1MarkPrefetchDistance;
+    assert(distance <= MaxMarkPrefetchDistance, "invariant");
+    // Ring of entries popped but not yet scanned; position is the oldest.
+    G1TaskQueueEntry window[MaxMarkPrefetchDistance];
+    uint position = 0;
+
+    while (true) {
+      G1TaskQueueEntry entry;
+      if (!has_aborted() &&
+          _task_queue->size() > target_size &&
+          _task_queue->pop_local(entry)) {
+        if (distance == 0) {
+          scan_task_entry(entry);
+          continue;
+        }
+        Prefetch::read(entry.is_array_slice() ? (void*)entry.slice()
+                                              : (void*)cast_from_oop<HeapWord*>(entry.obj()), 0);
+        G1TaskQueueEntry oldest = window[position];
+        window[position] = entry;
+        position = (position + 1) % distance;
+        if (!oldest.is_null()) {
+          scan_task_entry(oldest);
+        }
+        continue;
+      }
+
+      // The queue is drained far enough, or we aborted. Take the oldest
+      // remaining entry from the window; scanning it may push new work
+      // onto the queue, in which case we continue popping.
+      uint i = 0;
+      for (; i < distance; i++) {
+        if (!window[position].is_null()) {
+          break;
+        }
+        position = (position + 1) % distance;
+      }
+      if (i == distance) {
+        break;
+      }
+      entry = window[position];
+      window[position] = G1TaskQueueEntry();
+      if (has_aborted()) {
+        // Return it to the queue so that it is not lost when restarting.
+        push(entry);
       } else {
-        ret = _task_queue->pop_local(entry);
+        scan_task_entry(entry);
       }
     }
   }
@@ -286,6 +286,7 @@ class G1ConcurrentMark : public CHeapObj<mtGC> {
   friend class G1CMRemarkTask;
   friend class G1CMTask;
   friend class G1ConcurrentMarkThread;
+  friend class G1PrecleanTask;
 
   G1ConcurrentMarkThread* _cm_thread;     // The thread doing the work
   G1CollectedHeap*        _g1h;           // The heap
@@ -555,6 +556,8 @@ public:
 
   // Do concurrent preclean work.
   void preclean();
+  // Parallel version of preclean() using the concurrent marking threads.
+  void preclean_parallel();
 
   void remark();
 
@@ -564,6 +567,9 @@ public:
   // Mark in the previous bitmap. Caution: the prev bitmap is usually read-only, so use
   // this carefully.
   inline void mark_in_prev_bitmap(oop p);
+  // Mark in the previous bitmap from several threads at once. Returns true
+  // if this call set the mark.
+  inline bool par_mark_in_prev_bitmap(oop p);
 
   // Clears marks for all objects in the given range, for the prev or
   // next bitmaps.  Caution: the previous bitmap is usually
@@ -794,9 +800,14 @@ public:
   // Move entries from the global stack, return true if we were successful to do so.
   bool get_entries_from_global_stack();
 
+  // Upper bound of G1MarkPrefetchDistance.
+  static const uint MaxMarkPrefetchDistance = 16;
+
   // Pops and scans objects from the local queue. If partially is
   // true, then it stops when the queue size is of a given limit. If
   // partially is false, then it stops when the queue is empty.
+  // Popped entries are prefetched and scanned G1MarkPrefetchDistance
+  // pops later, to overlap the cache misses on their headers.
   void drain_local_queue(bool partially);
   // Moves entries from the global stack to the local queue and
   // drains the local queue. If partially is true, then it stops when
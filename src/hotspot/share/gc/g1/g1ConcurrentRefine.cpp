@@ -325,7 +325,19 @@ static size_t calc_new_green_zone(size_t green,
                                   double logged_cards_scan_time,
                                   size_t processed_logged_cards,
                                   double goal_ms) {
-  // Adjust green zone based on whether we're meeting the time goal.
+  // The green zone is about the number of cards left for the pause to
+  // process. If enough cards were processed in this pause to measure the
+  // per-card cost, move halfway towards the number of cards that fits
+  // the time goal at that cost: far enough to follow a burst within a few
+  // pauses, but damped against noise in a single measurement.
+  if (processed_logged_cards >= G1UpdateBufferSize && logged_cards_scan_time > 0.0) {
+    double cost_per_card_ms = logged_cards_scan_time / processed_logged_cards;
+    double budget = MIN2(goal_ms / cost_per_card_ms, (double)max_green_zone);
+    log_trace( CTRL_TAGS )("Refinement green zone budget: %.0f cards at %.6fms per card",
+                           budget, cost_per_card_ms);
+    return static_cast<size_t>((green + budget) / 2.0);
+  }
+  // Otherwise adjust green zone based on whether we're meeting the time goal.
   // Limit to max_green_zone.
   const double inc_k = 1.1, dec_k = 0.9;
   if (logged_cards_scan_time > goal_ms) {
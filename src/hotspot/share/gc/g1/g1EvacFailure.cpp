@@ -117,11 +117,10 @@ public:
 
       zap_dead_objects(_last_forwarded_object_end, obj_addr);
       // We consider all objects that we find self-forwarded to be
-      // live. What we'll do is that we'll update the prev marking
-      // info so that they are all under PTAMS and explicitly marked.
-      if (!_cm->is_marked_in_prev_bitmap(obj)) {
-        _cm->mark_in_prev_bitmap(obj);
-      }
+      // live. They have been explicitly marked on the prev bitmap when
+      // they failed to move, and we'll update the prev marking info so
+      // that they are all under PTAMS.
+      assert(_cm->is_marked_in_prev_bitmap(obj), "self-forwarded objects must be marked");
       if (_during_concurrent_start) {
         // For the next marking info we'll only mark the
         // self-forwarded objects explicitly if we are during
@@ -226,7 +225,19 @@ public:
                                         &_log_buffer_cl,
                                         during_concurrent_start,
                                         _worker_id);
-    hr->object_iterate(&rspc);
+    // Objects that failed to move were marked on the prev bitmap during
+    // evacuation, so visit the marked objects only instead of every
+    // object in the region. Any other marks are left over from the last
+    // marking, for objects that have since been evacuated or died. The
+    // closure skips those, and their marks are cleared together with the
+    // dead space around them.
+    const G1CMBitMap* const bitmap = _g1h->concurrent_mark()->prev_mark_bitmap();
+    HeapWord* const limit = hr->top();
+    HeapWord* addr = bitmap->get_next_marked_addr(hr->bottom(), limit);
+    while (addr < limit) {
+      rspc.do_object(cast_to_oop(addr));
+      addr = bitmap->get_next_marked_addr(addr + 1, limit);
+    }
     // Need to zap the remainder area of the processed region.
     rspc.zap_remainder();
 
@@ -245,7 +256,6 @@ public:
 
       hr->note_self_forwarding_removal_start(during_concurrent_start,
                                              during_concurrent_mark);
-      _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
 
       hr->reset_bot();
 
@@ -255,6 +265,8 @@ public:
       hr->rem_set()->clear_locked(true);
 
       hr->note_self_forwarding_removal_end(live_bytes);
+      // Failed objects above the old PTAMS are marked until here.
+      _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
 
       Atomic::inc(_num_failed_regions, memory_order_relaxed);
     }
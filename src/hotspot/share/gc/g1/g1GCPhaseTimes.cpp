@@ -112,6 +112,8 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
 #endif
   _gc_par_phases[EagerlyReclaimHumongousObjects] = new WorkerDataArray<double>("EagerlyReclaimHumongousObjects", "Eagerly Reclaim Humongous Objects (ms):", max_gc_threads);
   _gc_par_phases[RestorePreservedMarks] = new WorkerDataArray<double>("RestorePreservedMarks", "Restore Preserved Marks (ms):", max_gc_threads);
+  _gc_par_phases[CodeCacheCleaning] = new WorkerDataArray<double>("CodeCacheCleaning", "Code Cache Cleaning (ms):", max_gc_threads);
+  _gc_par_phases[KlassCleaning] = new WorkerDataArray<double>("KlassCleaning", "Klass Cleaning (ms):", max_gc_threads);
 
   _gc_par_phases[ScanHR]->create_thread_work_items("Scanned Cards:", ScanHRScannedCards);
   _gc_par_phases[ScanHR]->create_thread_work_items("Scanned Blocks:", ScanHRScannedBlocks);
@@ -537,6 +539,16 @@ void G1GCPhaseTimes::print() {
   }
 }
 
+void G1GCPhaseTimes::reset_parallel_cleaning() {
+  _gc_par_phases[CodeCacheCleaning]->reset();
+  _gc_par_phases[KlassCleaning]->reset();
+}
+
+void G1GCPhaseTimes::print_parallel_cleaning() const {
+  debug_phase(_gc_par_phases[CodeCacheCleaning]);
+  debug_phase(_gc_par_phases[KlassCleaning]);
+}
+
 const char* G1GCPhaseTimes::phase_name(GCParPhases phase) {
   G1GCPhaseTimes* phase_times = G1CollectedHeap::heap()->phase_times();
   return phase_times->_gc_par_phases[phase]->short_name();
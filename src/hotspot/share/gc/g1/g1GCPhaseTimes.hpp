@@ -87,6 +87,8 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 #endif
     EagerlyReclaimHumongousObjects,
     RestorePreservedMarks,
+    CodeCacheCleaning,
+    KlassCleaning,
     GCParPhasesSentinel
   };
 
@@ -238,6 +240,12 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   void print();
   static const char* phase_name(GCParPhases phase);
 
+  // Parallel cleaning runs during remark and full GC, outside of the young
+  // pauses the other phases belong to, so its phases are reset and printed
+  // on their own.
+  void reset_parallel_cleaning();
+  void print_parallel_cleaning() const;
+
   // record the time a phase took in seconds
   void record_time_secs(GCParPhases phase, uint worker_id, double secs);
 
@@ -87,6 +87,8 @@ public:
     NewRegionAlloc,
     // Statistics of object processing during copy to survivor region.
     LocalObjProcessAtCopyToSurv,
+    // Statistics of the destination of objects copied to survivor region.
+    LocalObjDestAtCopyToSurv,
     NodeDataItemsSentinel
   };
 
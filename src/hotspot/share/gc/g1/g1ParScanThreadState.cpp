@@ -26,6 +26,7 @@
 #include "gc/g1/g1Allocator.inline.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
+#include "gc/g1/g1ConcurrentMark.inline.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
 #include "gc/g1/g1ParScanThreadState.inline.hpp"
 #include "gc/g1/g1RootClosures.hpp"
@@ -79,7 +80,9 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
     _string_dedup_requests(),
     _num_optional_regions(optional_cset_length),
     _numa(g1h->numa()),
-    _obj_alloc_stat(NULL)
+    _worker_node_index(g1h->numa()->index_of_current_thread()),
+    _obj_alloc_stat(NULL),
+    _obj_dest_stat(NULL)
 {
   // We allocate number of young gen regions in the collection set plus one
   // entries, since entry 0 keeps track of surviving bytes for non-young regions.
@@ -127,6 +130,7 @@ G1ParScanThreadState::~G1ParScanThreadState() {
   FREE_C_HEAP_ARRAY(size_t, _surviving_young_words_base);
   delete[] _oops_into_optional_regions;
   FREE_C_HEAP_ARRAY(size_t, _obj_alloc_stat);
+  FREE_C_HEAP_ARRAY(size_t, _obj_dest_stat);
 }
 
 size_t G1ParScanThreadState::lab_waste_words() const {
@@ -402,7 +406,7 @@ HeapWord* G1ParScanThreadState::allocate_copy_slow(G1HeapRegionAttr* dest_attr,
     }
   }
   if (obj_ptr != NULL) {
-    update_numa_stats(node_index);
+    update_numa_stats(old, node_index);
     if (_g1h->_gc_tracer_stw->should_report_promotion_events()) {
       // The events are checked individually as part of the actual commit
       report_promotion_event(*dest_attr, old, word_sz, age, obj_ptr, node_index);
@@ -436,13 +440,19 @@ oop G1ParScanThreadState::do_copy_to_survivor_space(G1HeapRegionAttr const regio
   uint age = 0;
   G1HeapRegionAttr dest_attr = next_region_attr(region_attr, old_mark, age);
   HeapRegion* const from_region = _g1h->heap_region_containing(old);
-  uint node_index = from_region->node_index();
+  uint node_index = G1EvacuateToWorkerNode ? _worker_node_index : from_region->node_index();
 
   HeapWord* obj_ptr = _plab_allocator->plab_allocate(dest_attr, word_sz, node_index);
 
   // PLAB allocations should succeed most of the time, so we'll
   // normally check against NULL once and that's it.
   if (obj_ptr == NULL) {
+    if (G1EvacuateToWorkerNode) {
+      // Worker threads are not bound to nodes. Pick up a migration before
+      // taking a new PLAB, which is then placed on the current node.
+      _worker_node_index = _numa->index_of_current_thread();
+      node_index = _worker_node_index;
+    }
     obj_ptr = allocate_copy_slow(&dest_attr, old, word_sz, age, node_index);
     if (obj_ptr == NULL) {
       // This will either forward-to-self, or detect that someone else has
@@ -611,6 +621,10 @@ oop G1ParScanThreadState::handle_evacuation_failure_par(oop old, markWord m) {
 
     _g1h->preserve_mark_during_evac_failure(_worker_id, old, m);
 
+    // Record the object on the prev bitmap so that self-forwarding
+    // removal only needs to visit marked objects of the region.
+    _g1h->concurrent_mark()->par_mark_in_prev_bitmap(old);
+
     G1ScanInYoungSetter x(&_scanner, r->is_young());
     old->oop_iterate_backwards(&_scanner);
 
@@ -636,6 +650,8 @@ void G1ParScanThreadState::initialize_numa_stats() {
       // Record only if there are multiple active nodes.
       _obj_alloc_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
       memset(_obj_alloc_stat, 0, sizeof(size_t) * num_nodes);
+      _obj_dest_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
+      memset(_obj_dest_stat, 0, sizeof(size_t) * num_nodes);
     }
   }
 }
@@ -644,12 +660,14 @@ void G1ParScanThreadState::flush_numa_stats() {
   if (_obj_alloc_stat != NULL) {
     uint node_index = _numa->index_of_current_thread();
     _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToSurv, node_index, _obj_alloc_stat);
+    _numa->copy_statistics(G1NUMAStats::LocalObjDestAtCopyToSurv, node_index, _obj_dest_stat);
   }
 }
 
-void G1ParScanThreadState::update_numa_stats(uint node_index) {
+void G1ParScanThreadState::update_numa_stats(oop old, uint dest_node_index) {
   if (_obj_alloc_stat != NULL) {
-    _obj_alloc_stat[node_index]++;
+    _obj_alloc_stat[_g1h->heap_region_containing(old)->node_index()]++;
+    _obj_dest_stat[dest_node_index]++;
   }
 }
 
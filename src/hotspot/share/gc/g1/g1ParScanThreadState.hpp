@@ -100,11 +100,18 @@ class G1ParScanThreadState : public CHeapObj<mtGC> {
   G1OopStarChunkedList* _oops_into_optional_regions;
 
   G1NUMA* _numa;
+  // Node index of the memory node the worker thread ran on when it last
+  // took a PLAB. Used as destination node for survivors with
+  // G1EvacuateToWorkerNode.
+  uint _worker_node_index;
 
   // Records how many object allocations happened at each node during copy to survivor.
   // Only starts recording when log of gc+heap+numa is enabled and its data is
   // transferred when flushed.
+  // _obj_alloc_stat is indexed by the node of the region the objects were copied
+  // from, _obj_dest_stat by the node of the PLAB they were copied to.
   size_t* _obj_alloc_stat;
+  size_t* _obj_dest_stat;
 
 public:
   G1ParScanThreadState(G1CollectedHeap* g1h,
@@ -209,7 +216,7 @@ private:
   // NUMA statistics related methods.
   void initialize_numa_stats();
   void flush_numa_stats();
-  inline void update_numa_stats(uint node_index);
+  inline void update_numa_stats(oop old, uint dest_node_index);
 
 public:
   oop copy_to_survivor_space(G1HeapRegionAttr region_attr, oop obj, markWord old_mark);
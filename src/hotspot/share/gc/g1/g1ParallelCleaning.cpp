@@ -24,6 +24,9 @@
 
 #include "precompiled.hpp"
 
+#include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/g1GCParPhaseTimesTracker.hpp"
+#include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1ParallelCleaning.hpp"
 #include "runtime/atomic.hpp"
 #if INCLUDE_JVMCI
@@ -67,13 +70,19 @@ void G1ParallelCleaningTask::work(uint worker_id) {
   // Execute this task first because it is serial task.
   JVMCI_ONLY(_jvmci_cleaning_task.work(_unloading_occurred);)
 
+  G1GCPhaseTimes* phase_times = G1CollectedHeap::heap()->phase_times();
+
   // Do first pass of code cache cleaning.
-  _code_cache_task.work(worker_id);
+  {
+    G1GCParPhaseTimesTracker x(phase_times, G1GCPhaseTimes::CodeCacheCleaning, worker_id);
+    _code_cache_task.work(worker_id);
+  }
 
   // Clean all klasses that were not unloaded.
   // The weak metadata in klass doesn't need to be
   // processed if there was no unloading.
   if (_unloading_occurred) {
+    G1GCParPhaseTimesTracker x(phase_times, G1GCPhaseTimes::KlassCleaning, worker_id);
     _klass_cleaning_task.work();
   }
 }
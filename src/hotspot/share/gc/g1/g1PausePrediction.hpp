@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1PAUSEPREDICTION_HPP
+#define SHARE_GC_G1_G1PAUSEPREDICTION_HPP
+
+#include "memory/allocation.hpp"
+
+// The times G1Analytics predicts for the main parts of a young collection
+// pause given the work that was actually done, next to the times measured
+// for these parts. Predictions are made using the predictor state from
+// before the pause, so they show how far off the model was.
+class G1PausePrediction : public StackObj {
+  double _pause_target_ms;
+  double _pause_time_ms;
+
+  double _predicted_merge_time_ms;
+  double _merge_time_ms;
+  double _predicted_scan_time_ms;
+  double _scan_time_ms;
+  double _predicted_copy_time_ms;
+  double _copy_time_ms;
+  double _predicted_other_time_ms;
+  double _other_time_ms;
+
+public:
+  G1PausePrediction(double pause_target_ms, double pause_time_ms) :
+    _pause_target_ms(pause_target_ms), _pause_time_ms(pause_time_ms),
+    _predicted_merge_time_ms(0.0), _merge_time_ms(0.0),
+    _predicted_scan_time_ms(0.0), _scan_time_ms(0.0),
+    _predicted_copy_time_ms(0.0), _copy_time_ms(0.0),
+    _predicted_other_time_ms(0.0), _other_time_ms(0.0) { }
+
+  void set_merge_time_ms(double predicted, double actual) {
+    _predicted_merge_time_ms = predicted;
+    _merge_time_ms = actual;
+  }
+
+  void set_scan_time_ms(double predicted, double actual) {
+    _predicted_scan_time_ms = predicted;
+    _scan_time_ms = actual;
+  }
+
+  void set_copy_time_ms(double predicted, double actual) {
+    _predicted_copy_time_ms = predicted;
+    _copy_time_ms = actual;
+  }
+
+  void set_other_time_ms(double predicted, double actual) {
+    _predicted_other_time_ms = predicted;
+    _other_time_ms = actual;
+  }
+
+  double pause_target_ms() const         { return _pause_target_ms; }
+  double pause_time_ms() const           { return _pause_time_ms; }
+  double predicted_merge_time_ms() const { return _predicted_merge_time_ms; }
+  double merge_time_ms() const           { return _merge_time_ms; }
+  double predicted_scan_time_ms() const  { return _predicted_scan_time_ms; }
+  double scan_time_ms() const            { return _scan_time_ms; }
+  double predicted_copy_time_ms() const  { return _predicted_copy_time_ms; }
+  double copy_time_ms() const            { return _copy_time_ms; }
+  double predicted_other_time_ms() const { return _predicted_other_time_ms; }
+  double other_time_ms() const           { return _other_time_ms; }
+};
+
+#endif // SHARE_GC_G1_G1PAUSEPREDICTION_HPP
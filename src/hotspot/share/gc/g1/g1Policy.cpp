@@ -36,13 +36,15 @@
 #include "gc/g1/g1HotCardCache.hpp"
 #include "gc/g1/g1IHOPControl.hpp"
 #include "gc/g1/g1GCPhaseTimes.hpp"
+#include "gc/g1/g1PausePrediction.hpp"
 #include "gc/g1/g1Policy.hpp"
+#include "gc/g1/g1PolicyCounters.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
+#include "gc/g1/g1Trace.hpp"
 #include "gc/g1/g1YoungGenSizer.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.inline.hpp"
 #include "gc/shared/concurrentGCBreakpoints.hpp"
-#include "gc/shared/gcPolicyCounters.hpp"
 #include "logging/log.hpp"
 #include "runtime/java.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -59,7 +61,7 @@ G1Policy::G1Policy(STWGCTimer* gc_timer) :
   _mmu_tracker(new G1MMUTracker(GCPauseIntervalMillis / 1000.0, MaxGCPauseMillis / 1000.0)),
   _old_gen_alloc_tracker(),
   _ihop_control(create_ihop_control(&_old_gen_alloc_tracker, &_predictor)),
-  _policy_counters(new GCPolicyCounters("GarbageFirst", 1, 2)),
+  _policy_counters(new G1PolicyCounters("GarbageFirst", 1, 2)),
   _full_collection_start_sec(0.0),
   _young_list_target_length(0),
   _young_list_fixed_length(0),
@@ -692,6 +694,8 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, bool concurrent
 
   _eden_surv_rate_group->start_adding_regions();
 
+  report_pause_prediction(this_pause, pause_time_ms);
+
   double merge_hcc_time_ms = average_time_ms(G1GCPhaseTimes::MergeHCC);
   if (update_stats) {
     size_t const total_log_buffer_cards = p->sum_thread_work_items(G1GCPhaseTimes::MergeHCC, G1GCPhaseTimes::MergeHCCDirtyCards) +
@@ -829,9 +833,63 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, bool concurrent
   log_debug(gc, ergo, refine)("Concurrent refinement times: Logged Cards Scan time goal: %1.2fms Logged Cards Scan time: %1.2fms HCC time: %1.2fms",
                               scan_logged_cards_time_goal_ms, logged_cards_time, merge_hcc_time_ms);
 
-  _g1h->concurrent_refine()->adjust(logged_cards_time,
-                                    phase_times()->sum_thread_work_items(G1GCPhaseTimes::MergeLB, G1GCPhaseTimes::MergeLBDirtyCards),
-                                    scan_logged_cards_time_goal_ms);
+  size_t const processed_logged_cards = phase_times()->sum_thread_work_items(G1GCPhaseTimes::MergeLB, G1GCPhaseTimes::MergeLBDirtyCards);
+  G1ConcurrentRefine* cr = _g1h->concurrent_refine();
+  cr->adjust(logged_cards_time, processed_logged_cards, scan_logged_cards_time_goal_ms);
+
+  // Number of refinement threads needed to keep up with the mutators,
+  // reported next to the new zones to make the adjustment visible.
+  double const dirtied_rate = _analytics->predict_dirtied_cards_rate_ms();
+  double const refine_rate = _analytics->predict_concurrent_refine_rate_ms();
+  uint threads_needed = 0;
+  if (refine_rate > 0.0) {
+    threads_needed = (uint)MIN2(ceil(dirtied_rate / refine_rate), (double)G1ConcurrentRefine::max_num_threads());
+  }
+  log_debug(gc, ergo, refine)("Concurrent refinement zones: green: " SIZE_FORMAT " yellow: " SIZE_FORMAT " red: " SIZE_FORMAT
+                              " dirtied cards rate: %.2f cards/ms refinement rate: %.2f cards/ms threads needed: %u",
+                              cr->green_zone(), cr->yellow_zone(), cr->red_zone(),
+                              dirtied_rate, refine_rate, threads_needed);
+  _g1h->gc_tracer_stw()->report_concurrent_refinement_zones(cr->green_zone(), cr->yellow_zone(), cr->red_zone(),
+                                                             processed_logged_cards, logged_cards_time,
+                                                             scan_logged_cards_time_goal_ms,
+                                                             dirtied_rate, refine_rate, threads_needed);
+}
+
+void G1Policy::report_pause_prediction(G1GCPauseType this_pause, double pause_time_ms) {
+  G1GCPhaseTimes* p = phase_times();
+  bool const for_young_gc = G1GCPauseTypeHelper::is_young_only_pause(this_pause);
+
+  G1PausePrediction prediction(max_pause_time_ms(), pause_time_ms);
+
+  size_t const total_cards_merged = p->sum_thread_work_items(G1GCPhaseTimes::MergeRS, G1GCPhaseTimes::MergeRSDirtyCards) +
+                                    p->sum_thread_work_items(G1GCPhaseTimes::OptMergeRS, G1GCPhaseTimes::MergeRSDirtyCards) +
+                                    p->sum_thread_work_items(G1GCPhaseTimes::MergeHCC, G1GCPhaseTimes::MergeHCCDirtyCards) +
+                                    p->sum_thread_work_items(G1GCPhaseTimes::MergeLB, G1GCPhaseTimes::MergeLBDirtyCards);
+  prediction.set_merge_time_ms(_analytics->predict_card_merge_time_ms(total_cards_merged, for_young_gc),
+                               average_time_ms(G1GCPhaseTimes::MergeER) +
+                               average_time_ms(G1GCPhaseTimes::MergeRS) +
+                               average_time_ms(G1GCPhaseTimes::MergeHCC) +
+                               average_time_ms(G1GCPhaseTimes::MergeLB) +
+                               average_time_ms(G1GCPhaseTimes::OptMergeRS));
+
+  size_t const total_cards_scanned = p->sum_thread_work_items(G1GCPhaseTimes::ScanHR, G1GCPhaseTimes::ScanHRScannedCards) +
+                                     p->sum_thread_work_items(G1GCPhaseTimes::OptScanHR, G1GCPhaseTimes::ScanHRScannedCards);
+  prediction.set_scan_time_ms(_analytics->predict_card_scan_time_ms(total_cards_scanned, for_young_gc),
+                              average_time_ms(G1GCPhaseTimes::ScanHR) +
+                              average_time_ms(G1GCPhaseTimes::OptScanHR));
+
+  size_t const copied_bytes = p->sum_thread_work_items(G1GCPhaseTimes::MergePSS, G1GCPhaseTimes::MergePSSCopiedBytes);
+  prediction.set_copy_time_ms(_analytics->predict_object_copy_time_ms(copied_bytes, collector_state()->mark_or_rebuild_in_progress()),
+                              average_time_ms(G1GCPhaseTimes::ObjCopy) +
+                              average_time_ms(G1GCPhaseTimes::OptObjCopy));
+
+  prediction.set_other_time_ms(_analytics->predict_constant_other_time_ms() +
+                               _analytics->predict_young_other_time_ms(_collection_set->young_region_length()) +
+                               _analytics->predict_non_young_other_time_ms(_collection_set->old_region_length()),
+                               other_time_ms(pause_time_ms));
+
+  _policy_counters->update_pause_prediction(prediction);
+  _g1h->gc_tracer_stw()->report_pause_prediction(prediction);
 }
 
 G1IHOPControl* G1Policy::create_ihop_control(const G1OldGenAllocationTracker* old_gen_alloc_tracker,
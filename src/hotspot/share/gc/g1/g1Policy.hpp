@@ -49,7 +49,7 @@ class G1CollectionSetChooser;
 class G1IHOPControl;
 class G1Analytics;
 class G1SurvivorRegions;
-class GCPolicyCounters;
+class G1PolicyCounters;
 class STWGCTimer;
 
 class G1Policy: public CHeapObj<mtGC> {
@@ -73,7 +73,7 @@ class G1Policy: public CHeapObj<mtGC> {
   G1OldGenAllocationTracker _old_gen_alloc_tracker;
   G1IHOPControl* _ihop_control;
 
-  GCPolicyCounters* _policy_counters;
+  G1PolicyCounters* _policy_counters;
 
   double _full_collection_start_sec;
 
@@ -179,6 +179,11 @@ private:
   double non_young_other_time_ms() const;
   double constant_other_time_ms(double pause_time_ms) const;
 
+  // Compare the times the analytics predict for the work done in the current
+  // pause with the measured times, and publish the result. Must be called
+  // before the analytics are updated with the samples of that pause.
+  void report_pause_prediction(G1GCPauseType this_pause, double pause_time_ms);
+
   G1CollectionSetChooser* cset_chooser() const;
 
   // Stash a pointer to the g1 heap.
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1PausePrediction.hpp"
+#include "gc/g1/g1PolicyCounters.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/os.hpp"
+
+static jlong ms_to_ticks(double ms) {
+  return (jlong)(ms * os::elapsed_frequency() / MILLIUNITS);
+}
+
+PerfVariable* G1PolicyCounters::create_time_variable(const char* name, TRAPS) {
+  char* cname = PerfDataManager::counter_name(name_space(), name);
+  return PerfDataManager::create_variable(SUN_GC, cname, PerfData::U_Ticks, THREAD);
+}
+
+G1PolicyCounters::G1PolicyCounters(const char* name, int collectors, int generations) :
+  GCPolicyCounters(name, collectors, generations),
+  _pause_target(NULL),
+  _pause_time(NULL),
+  _predicted_merge_time(NULL),
+  _merge_time(NULL),
+  _predicted_scan_time(NULL),
+  _scan_time(NULL),
+  _predicted_copy_time(NULL),
+  _copy_time(NULL),
+  _predicted_other_time(NULL),
+  _other_time(NULL) {
+
+  if (UsePerfData) {
+    EXCEPTION_MARK;
+    ResourceMark rm;
+
+    _pause_target = create_time_variable("pauseTarget", CHECK);
+    _pause_time = create_time_variable("lastPauseTime", CHECK);
+    _predicted_merge_time = create_time_variable("predictedMergeTime", CHECK);
+    _merge_time = create_time_variable("lastMergeTime", CHECK);
+    _predicted_scan_time = create_time_variable("predictedScanTime", CHECK);
+    _scan_time = create_time_variable("lastScanTime", CHECK);
+    _predicted_copy_time = create_time_variable("predictedCopyTime", CHECK);
+    _copy_time = create_time_variable("lastCopyTime", CHECK);
+    _predicted_other_time = create_time_variable("predictedOtherTime", CHECK);
+    _other_time = create_time_variable("lastOtherTime", CHECK);
+
+    _pause_target->set_value(ms_to_ticks((double)MaxGCPauseMillis));
+  }
+}
+
+void G1PolicyCounters::update_pause_prediction(const G1PausePrediction& prediction) {
+  if (UsePerfData) {
+    _pause_target->set_value(ms_to_ticks(prediction.pause_target_ms()));
+    _pause_time->set_value(ms_to_ticks(prediction.pause_time_ms()));
+    _predicted_merge_time->set_value(ms_to_ticks(prediction.predicted_merge_time_ms()));
+    _merge_time->set_value(ms_to_ticks(prediction.merge_time_ms()));
+    _predicted_scan_time->set_value(ms_to_ticks(prediction.predicted_scan_time_ms()));
+    _scan_time->set_value(ms_to_ticks(prediction.scan_time_ms()));
+    _predicted_copy_time->set_value(ms_to_ticks(prediction.predicted_copy_time_ms()));
+    _copy_time->set_value(ms_to_ticks(prediction.copy_time_ms()));
+    _predicted_other_time->set_value(ms_to_ticks(prediction.predicted_other_time_ms()));
+    _other_time->set_value(ms_to_ticks(prediction.other_time_ms()));
+  }
+}
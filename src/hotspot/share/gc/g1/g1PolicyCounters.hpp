@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1POLICYCOUNTERS_HPP
+#define SHARE_GC_G1_G1POLICYCOUNTERS_HPP
+
+#include "gc/shared/gcPolicyCounters.hpp"
+
+class G1PausePrediction;
+
+// G1PolicyCounters adds counters that show the pause time prediction of
+// the most recent young collection next to the measured times. All times
+// are in ticks.
+class G1PolicyCounters : public GCPolicyCounters {
+  PerfVariable* _pause_target;
+  PerfVariable* _pause_time;
+  PerfVariable* _predicted_merge_time;
+  PerfVariable* _merge_time;
+  PerfVariable* _predicted_scan_time;
+  PerfVariable* _scan_time;
+  PerfVariable* _predicted_copy_time;
+  PerfVariable* _copy_time;
+  PerfVariable* _predicted_other_time;
+  PerfVariable* _other_time;
+
+  PerfVariable* create_time_variable(const char* name, TRAPS);
+
+public:
+  G1PolicyCounters(const char* name, int collectors, int generations);
+
+  void update_pause_prediction(const G1PausePrediction& prediction);
+
+  virtual GCPolicyCounters::Name kind() const {
+    return GCPolicyCounters::G1PolicyCountersKind;
+  }
+};
+
+#endif // SHARE_GC_G1_G1POLICYCOUNTERS_HPP
@@ -601,7 +601,10 @@ G1RemSet::G1RemSet(G1CollectedHeap* g1h,
   _ct(ct),
   _g1p(_g1h->policy()),
   _hot_card_cache(hot_card_cache),
-  _sampling_task(NULL) {
+  _sampling_task(NULL),
+  _coarsen_howl_to_full_percent(G1RemSetCoarsenHowlToFullPercent),
+  _coarsen_howl_bitmap_to_full_percent(G1RemSetCoarsenHowlBitmapToHowlFullPercent),
+  _coarsen_stats_at_last_adjust() {
 }
 
 G1RemSet::~G1RemSet() {
@@ -1528,6 +1531,73 @@ void G1RemSet::print_coarsen_stats() {
   }
 }
 
+class G1RemSetFootprintClosure : public HeapRegionClosure {
+  size_t _mem_size;
+public:
+  G1RemSetFootprintClosure() : _mem_size(0) { }
+
+  bool do_heap_region(HeapRegion* hr) {
+    _mem_size += hr->rem_set()->mem_size();
+    return false;
+  }
+
+  size_t mem_size() const { return _mem_size; }
+};
+
+// Coarsening a container to Full frees its memory, and Full containers are
+// the cheapest to merge, at the cost of scanning more cards of the region.
+// So while the remembered sets are larger than the footprint target, lower
+// the occupancy at which containers are coarsened in steps. Raise it back
+// towards the configured values once the footprint is comfortably below the
+// target, but only as long as recent coarsenings show the lower thresholds
+// still take effect.
+void G1RemSet::adjust_card_set_coarsening() {
+  if (!G1UseAdaptiveRemSetCoarsening) {
+    return;
+  }
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+
+  const uint StepPercent = 10;
+  const uint MinPercent = 50;
+
+  G1CardSetCoarsenStats current = G1CardSet::coarsen_stats();
+  G1CardSetCoarsenStats recent = _coarsen_stats_at_last_adjust;
+  recent.subtract_from(current);
+  _coarsen_stats_at_last_adjust = current;
+
+  G1RemSetFootprintClosure cl;
+  _g1h->heap_region_iterate(&cl);
+  size_t const target = _g1h->capacity() / 100 * G1RemSetFootprintTargetPercent;
+
+  uint howl_percent = _coarsen_howl_to_full_percent;
+  uint bitmap_percent = _coarsen_howl_bitmap_to_full_percent;
+  if (cl.mem_size() > target) {
+    if (howl_percent > MinPercent) {
+      howl_percent = MAX2(howl_percent - StepPercent, MinPercent);
+    }
+    if (bitmap_percent > MinPercent) {
+      bitmap_percent = MAX2(bitmap_percent - StepPercent, MinPercent);
+    }
+  } else if (cl.mem_size() < target / 2 && recent.num_coarsened_to_full() > 0) {
+    howl_percent = MIN2(howl_percent + StepPercent, G1RemSetCoarsenHowlToFullPercent);
+    bitmap_percent = MIN2(bitmap_percent + StepPercent, G1RemSetCoarsenHowlBitmapToHowlFullPercent);
+  }
+
+  log_debug(gc, remset)("Card set coarsening: footprint " SIZE_FORMAT "B target " SIZE_FORMAT "B "
+                        "recent coarsenings to full " SIZE_FORMAT " "
+                        "Howl->Full %u%% -> %u%% BitMap->Full %u%% -> %u%%",
+                        cl.mem_size(), target, recent.num_coarsened_to_full(),
+                        _coarsen_howl_to_full_percent, howl_percent,
+                        _coarsen_howl_bitmap_to_full_percent, bitmap_percent);
+
+  if (howl_percent != _coarsen_howl_to_full_percent ||
+      bitmap_percent != _coarsen_howl_bitmap_to_full_percent) {
+    _coarsen_howl_to_full_percent = howl_percent;
+    _coarsen_howl_bitmap_to_full_percent = bitmap_percent;
+    _g1h->card_set_config()->set_coarsen_to_full_percent(howl_percent, bitmap_percent);
+  }
+}
+
 inline void check_card_ptr(CardTable::CardValue* card_ptr, G1CardTable* ct) {
 #ifdef ASSERT
   G1CollectedHeap* g1h = G1CollectedHeap::heap();
@@ -1724,11 +1794,70 @@ void G1RemSet::print_summary_info() {
   }
 }
 
+// Hands out the chunks of the old and humongous regions to rebuild to the
+// workers. Every worker visits all regions, starting at a different offset
+// each, and claims chunks of G1RebuildRemSetChunkSize from the region at
+// hand until there are none left. So a worker that runs out of regions of
+// its own keeps helping with the chunks of regions other workers are still
+// working on, instead of idling while a few densely populated regions are
+// still being processed.
+class G1RebuildRemSetChunkClaimer : public CHeapObj<mtGC> {
+  uint volatile* _next_chunk;   // Index of the next chunk to claim per region.
+  uint _num_regions;
+  uint _chunks_per_region;
+  size_t _chunk_size_in_words;
+  DEBUG_ONLY(size_t volatile* _marked_bytes;)  // Marked bytes found per region.
+
+public:
+  G1RebuildRemSetChunkClaimer(uint num_regions) :
+    _next_chunk(NEW_C_HEAP_ARRAY(uint, num_regions, mtGC)),
+    _num_regions(num_regions),
+    _chunks_per_region((uint)((HeapRegion::GrainWords * HeapWordSize + G1RebuildRemSetChunkSize - 1) / G1RebuildRemSetChunkSize)),
+    _chunk_size_in_words(G1RebuildRemSetChunkSize / HeapWordSize)
+    DEBUG_ONLY(COMMA _marked_bytes(NEW_C_HEAP_ARRAY(size_t, num_regions, mtGC))) {
+    ::memset((void*)_next_chunk, 0, num_regions * sizeof(*_next_chunk));
+    DEBUG_ONLY(::memset((void*)_marked_bytes, 0, num_regions * sizeof(*_marked_bytes));)
+  }
+
+  ~G1RebuildRemSetChunkClaimer() {
+    FREE_C_HEAP_ARRAY(uint, _next_chunk);
+    DEBUG_ONLY(FREE_C_HEAP_ARRAY(size_t, _marked_bytes);)
+  }
+
+  uint num_regions() const { return _num_regions; }
+  size_t chunk_size_in_words() const { return _chunk_size_in_words; }
+
+  bool has_unclaimed_chunks(uint region_idx) const {
+    return Atomic::load(&_next_chunk[region_idx]) < _chunks_per_region;
+  }
+
+  // Returns the start of the next unclaimed chunk of the given region,
+  // or NULL if all chunks have been claimed.
+  HeapWord* claim_chunk(HeapRegion* hr) {
+    uint chunk = Atomic::fetch_and_add(&_next_chunk[hr->hrm_index()], 1u);
+    if (chunk >= _chunks_per_region) {
+      return NULL;
+    }
+    return hr->bottom() + (size_t)chunk * _chunk_size_in_words;
+  }
+
+#ifdef ASSERT
+  void add_marked_bytes(uint region_idx, size_t marked_bytes) {
+    Atomic::add(&_marked_bytes[region_idx], marked_bytes);
+  }
+
+  size_t marked_bytes(uint region_idx) const {
+    return Atomic::load(&_marked_bytes[region_idx]);
+  }
+#endif
+};
+
 class G1RebuildRemSetTask: public AbstractGangTask {
   // Aggregate the counting data that was constructed concurrently
   // with marking.
   class G1RebuildRemSetHeapRegionClosure : public HeapRegionClosure {
     G1ConcurrentMark* _cm;
+    G1RebuildRemSetChunkClaimer* _claimer;
     G1RebuildRemSetClosure _update_cl;
 
     // Applies _update_cl to the references of the given object, limiting objArrays
@@ -1868,9 +1997,11 @@ class G1RebuildRemSetTask: public AbstractGangTask {
 public:
   G1RebuildRemSetHeapRegionClosure(G1CollectedHeap* g1h,
                                    G1ConcurrentMark* cm,
+                                   G1RebuildRemSetChunkClaimer* claimer,
                                    uint worker_id) :
     HeapRegionClosure(),
     _cm(cm),
+    _claimer(claimer),
     _update_cl(g1h, worker_id) { }
 
     bool do_heap_region(HeapRegion* hr) {
@@ -1885,13 +2016,11 @@ public:
              "A TARS (" PTR_FORMAT ") == bottom() (" PTR_FORMAT ") indicates the old region %u is empty (%s)",
              p2i(top_at_rebuild_start_check), p2i(hr->bottom()),  region_idx, hr->get_type_str());
 
-      size_t total_marked_bytes = 0;
-      size_t const chunk_size_in_words = G1RebuildRemSetChunkSize / HeapWordSize;
+      size_t const chunk_size_in_words = _claimer->chunk_size_in_words();
 
       HeapWord* const top_at_mark_start = hr->prev_top_at_mark_start();
 
-      HeapWord* cur = hr->bottom();
-      while (cur < hr->end()) {
+      while (_claimer->has_unclaimed_chunks(region_idx)) {
         // After every iteration (yield point) we need to check whether the region's
         // TARS changed due to e.g. eager reclaim.
         HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);
@@ -1899,8 +2028,15 @@ public:
           return false;
         }
 
+        HeapWord* const cur = _claimer->claim_chunk(hr);
+        if (cur == NULL) {
+          break;
+        }
+
         MemRegion next_chunk = MemRegion(hr->bottom(), top_at_rebuild_start).intersection(MemRegion(cur, chunk_size_in_words));
         if (next_chunk.is_empty()) {
+          // All further chunks are beyond TARS too, but other workers may
+          // still claim them; they will find them empty as well.
           break;
         }
 
@@ -1917,6 +2053,7 @@ public:
                                         "time %.3fms "
                                         "marked bytes " SIZE_FORMAT " "
                                         "bot " PTR_FORMAT " "
+                                        "chunk " PTR_FORMAT " "
                                         "TAMS " PTR_FORMAT " "
                                         "TARS " PTR_FORMAT,
                                         region_idx,
@@ -1924,45 +2061,36 @@ public:
                                         time.seconds() * 1000.0,
                                         marked_bytes,
                                         p2i(hr->bottom()),
+                                        p2i(cur),
                                         p2i(top_at_mark_start),
                                         p2i(top_at_rebuild_start));
 
-        if (marked_bytes > 0) {
-          total_marked_bytes += marked_bytes;
-        }
-        cur += chunk_size_in_words;
+        DEBUG_ONLY(_claimer->add_marked_bytes(region_idx, marked_bytes);)
 
         _cm->do_yield_check();
         if (_cm->has_aborted()) {
           return true;
         }
       }
-      // In the final iteration of the loop the region might have been eagerly reclaimed.
-      // Simply filter out those regions. We can not just use region type because there
-      // might have already been new allocations into these regions.
-      DEBUG_ONLY(HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);)
-      assert(top_at_rebuild_start == NULL ||
-             total_marked_bytes == hr->marked_bytes(),
-             "Marked bytes " SIZE_FORMAT " for region %u (%s) in [bottom, TAMS) do not match calculated marked bytes " SIZE_FORMAT " "
-             "(" PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT ")",
-             total_marked_bytes, hr->hrm_index(), hr->get_type_str(), hr->marked_bytes(),
-             p2i(hr->bottom()), p2i(top_at_mark_start), p2i(top_at_rebuild_start));
-       // Abort state may have changed after the yield check.
+      // Abort state may have changed after the yield check.
       return _cm->has_aborted();
     }
   };
 
-  HeapRegionClaimer _hr_claimer;
+  G1RebuildRemSetChunkClaimer* _claimer;
   G1ConcurrentMark* _cm;
 
+  uint _n_workers;
   uint _worker_id_offset;
 public:
   G1RebuildRemSetTask(G1ConcurrentMark* cm,
+                      G1RebuildRemSetChunkClaimer* claimer,
                       uint n_workers,
                       uint worker_id_offset) :
       AbstractGangTask("G1 Rebuild Remembered Set"),
-      _hr_claimer(n_workers),
+      _claimer(claimer),
       _cm(cm),
+      _n_workers(n_workers),
       _worker_id_offset(worker_id_offset) {
   }
 
@@ -1971,18 +2099,77 @@ public:
 
     G1CollectedHeap* g1h = G1CollectedHeap::heap();
 
-    G1RebuildRemSetHeapRegionClosure cl(g1h, _cm, _worker_id_offset + worker_id);
-    g1h->heap_region_par_iterate_from_worker_offset(&cl, &_hr_claimer, worker_id);
+    G1RebuildRemSetHeapRegionClosure cl(g1h, _cm, _claimer, _worker_id_offset + worker_id);
+
+    // Visit all regions, starting at an offset specific to this worker so that
+    // workers initially spread out over the heap. Regions that other workers
+    // already finished are skipped cheaply by the claimer.
+    uint const num_regions = _claimer->num_regions();
+    uint const start = (uint)((size_t)num_regions * worker_id / _n_workers);
+    for (uint count = 0; count < num_regions; count++) {
+      uint const index = (start + count) % num_regions;
+      if (!_claimer->has_unclaimed_chunks(index)) {
+        continue;
+      }
+      HeapRegion* hr = g1h->region_at_or_null(index);
+      if (hr == NULL) {
+        continue;
+      }
+      if (cl.do_heap_region(hr)) {
+        return;
+      }
+    }
   }
 };
 
+#ifdef ASSERT
+// The chunks of a region may have been rebuilt by different workers; check
+// that together they found the same marked bytes as marking did.
+class G1VerifyRebuildMarkedBytesClosure : public HeapRegionClosure {
+  G1ConcurrentMark* _cm;
+  G1RebuildRemSetChunkClaimer* _claimer;
+
+public:
+  G1VerifyRebuildMarkedBytesClosure(G1ConcurrentMark* cm, G1RebuildRemSetChunkClaimer* claimer) :
+    _cm(cm), _claimer(claimer) { }
+
+  bool do_heap_region(HeapRegion* hr) {
+    uint const region_idx = hr->hrm_index();
+    HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);
+    // Regions might have been eagerly reclaimed during the rebuild. Simply filter
+    // out those regions. We can not just use region type because there might have
+    // already been new allocations into these regions.
+    if (top_at_rebuild_start == NULL) {
+      return false;
+    }
+    size_t const total_marked_bytes = _claimer->marked_bytes(region_idx);
+    assert(total_marked_bytes == hr->marked_bytes(),
+           "Marked bytes " SIZE_FORMAT " for region %u (%s) in [bottom, TAMS) do not match calculated marked bytes " SIZE_FORMAT " "
+           "(" PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT ")",
+           total_marked_bytes, region_idx, hr->get_type_str(), hr->marked_bytes(),
+           p2i(hr->bottom()), p2i(hr->prev_top_at_mark_start()), p2i(top_at_rebuild_start));
+    return false;
+  }
+};
+#endif
+
 void G1RemSet::rebuild_rem_set(G1ConcurrentMark* cm,
                                WorkGang* workers,
                                uint worker_id_offset) {
   uint num_workers = workers->active_workers();
 
+  G1RebuildRemSetChunkClaimer claimer(G1CollectedHeap::heap()->max_reserved_regions());
   G1RebuildRemSetTask cl(cm,
+                         &claimer,
                          num_workers,
                          worker_id_offset);
   workers->run_task(&cl, num_workers);
+
+#ifdef ASSERT
+  if (!cm->has_aborted()) {
+    SuspendibleThreadSetJoiner sts_join;
+    G1VerifyRebuildMarkedBytesClosure verify_cl(cm, &claimer);
+    G1CollectedHeap::heap()->heap_region_iterate(&verify_cl);
+  }
+#endif
 }
@@ -25,6 +25,7 @@
 #ifndef SHARE_GC_G1_G1REMSET_HPP
 #define SHARE_GC_G1_G1REMSET_HPP
 
+#include "gc/g1/g1CardSet.hpp"
 #include "gc/g1/g1CardTable.hpp"
 #include "gc/g1/g1OopClosures.hpp"
 #include "gc/g1/g1GCPhaseTimes.hpp"
@@ -69,6 +70,12 @@ private:
   G1HotCardCache*        _hot_card_cache;
   G1RemSetSamplingTask*  _sampling_task;
 
+  // Current percentages at which Howl and Howl Bitmap card set containers
+  // are coarsened to Full, see adjust_card_set_coarsening().
+  uint _coarsen_howl_to_full_percent;
+  uint _coarsen_howl_bitmap_to_full_percent;
+  G1CardSetCoarsenStats _coarsen_stats_at_last_adjust;
+
   void print_merge_heap_roots_stats();
 
   void assert_scan_top_is_null(uint hrm_index) NOT_DEBUG_RETURN;
@@ -111,6 +118,9 @@ public:
   void cleanup_after_scan_heap_roots();
   // Print coarsening stats.
   void print_coarsen_stats();
+  // Adapt the card set coarsening thresholds to the remembered set footprint
+  // observed after a young collection.
+  void adjust_card_set_coarsening();
   // Creates a gang task for cleaining up temporary data structures and the
   // card table, removing temporary duplicate detection information.
   G1AbstractSubTask* create_cleanup_after_scan_heap_roots_task();
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1EvacuationInfo.hpp"
 #include "gc/g1/g1HeapRegionTraceType.hpp"
+#include "gc/g1/g1PausePrediction.hpp"
 #include "gc/g1/g1Trace.hpp"
 #include "gc/g1/g1GCPauseType.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
@@ -127,6 +128,30 @@ void G1NewTracer::report_adaptive_ihop_statistics(size_t threshold,
                                 prediction_active);
 }
 
+void G1NewTracer::report_pause_prediction(const G1PausePrediction& prediction) {
+  send_pause_prediction(prediction);
+}
+
+void G1NewTracer::report_concurrent_refinement_zones(size_t green_zone,
+                                                     size_t yellow_zone,
+                                                     size_t red_zone,
+                                                     size_t processed_cards,
+                                                     double processing_time_ms,
+                                                     double time_goal_ms,
+                                                     double dirtied_cards_rate,
+                                                     double refinement_rate,
+                                                     uint threads_needed) {
+  send_concurrent_refinement_zones(green_zone,
+                                   yellow_zone,
+                                   red_zone,
+                                   processed_cards,
+                                   processing_time_ms,
+                                   time_goal_ms,
+                                   dirtied_cards_rate,
+                                   refinement_rate,
+                                   threads_needed);
+}
+
 void G1NewTracer::send_g1_young_gc_event() {
   // Check that the pause type has been updated to something valid for this event.
   G1GCPauseTypeHelper::assert_is_young_pause(_pause);
@@ -248,6 +273,53 @@ void G1NewTracer::send_adaptive_ihop_statistics(size_t threshold,
   }
 }
 
+static jlong ms_to_ns(double ms) {
+  return (jlong)(ms * NANOSECS_PER_MILLISEC);
+}
+
+void G1NewTracer::send_pause_prediction(const G1PausePrediction& prediction) {
+  EventG1PausePrediction evt;
+  if (evt.should_commit()) {
+    evt.set_gcId(GCId::current());
+    evt.set_pauseTarget(ms_to_ns(prediction.pause_target_ms()));
+    evt.set_pauseTime(ms_to_ns(prediction.pause_time_ms()));
+    evt.set_predictedMergeTime(ms_to_ns(prediction.predicted_merge_time_ms()));
+    evt.set_mergeTime(ms_to_ns(prediction.merge_time_ms()));
+    evt.set_predictedScanTime(ms_to_ns(prediction.predicted_scan_time_ms()));
+    evt.set_scanTime(ms_to_ns(prediction.scan_time_ms()));
+    evt.set_predictedCopyTime(ms_to_ns(prediction.predicted_copy_time_ms()));
+    evt.set_copyTime(ms_to_ns(prediction.copy_time_ms()));
+    evt.set_predictedOtherTime(ms_to_ns(prediction.predicted_other_time_ms()));
+    evt.set_otherTime(ms_to_ns(prediction.other_time_ms()));
+    evt.commit();
+  }
+}
+
+void G1NewTracer::send_concurrent_refinement_zones(size_t green_zone,
+                                                   size_t yellow_zone,
+                                                   size_t red_zone,
+                                                   size_t processed_cards,
+                                                   double processing_time_ms,
+                                                   double time_goal_ms,
+                                                   double dirtied_cards_rate,
+                                                   double refinement_rate,
+                                                   uint threads_needed) {
+  EventG1ConcurrentRefinementZones evt;
+  if (evt.should_commit()) {
+    evt.set_gcId(GCId::current());
+    evt.set_greenZone(green_zone);
+    evt.set_yellowZone(yellow_zone);
+    evt.set_redZone(red_zone);
+    evt.set_processedCards(processed_cards);
+    evt.set_processingTime(ms_to_ns(processing_time_ms));
+    evt.set_timeGoal(ms_to_ns(time_goal_ms));
+    evt.set_dirtiedCardsRate(dirtied_cards_rate);
+    evt.set_refinementRate(refinement_rate);
+    evt.set_threadsNeeded(threads_needed);
+    evt.commit();
+  }
+}
+
 void G1OldTracer::report_gc_start_impl(GCCause::Cause cause, const Ticks& timestamp) {
   _shared_gc_info.set_start_timestamp(timestamp);
 }
@@ -31,6 +31,7 @@
 class G1EvacuationInfo;
 class G1HeapSummary;
 class G1EvacSummary;
+class G1PausePrediction;
 
 class G1NewTracer : public YoungGCTracer {
   G1GCPauseType _pause;
@@ -63,6 +64,16 @@ public:
                                        double predicted_allocation_rate,
                                        double predicted_marking_length,
                                        bool prediction_active);
+  void report_pause_prediction(const G1PausePrediction& prediction);
+  void report_concurrent_refinement_zones(size_t green_zone,
+                                          size_t yellow_zone,
+                                          size_t red_zone,
+                                          size_t processed_cards,
+                                          double processing_time_ms,
+                                          double time_goal_ms,
+                                          double dirtied_cards_rate,
+                                          double refinement_rate,
+                                          uint threads_needed);
 private:
   void send_g1_young_gc_event();
   void send_evacuation_info_event(G1EvacuationInfo* info);
@@ -84,6 +95,16 @@ private:
                                      double predicted_allocation_rate,
                                      double predicted_marking_length,
                                      bool prediction_active);
+  void send_pause_prediction(const G1PausePrediction& prediction);
+  void send_concurrent_refinement_zones(size_t green_zone,
+                                        size_t yellow_zone,
+                                        size_t red_zone,
+                                        size_t processed_cards,
+                                        double processing_time_ms,
+                                        double time_goal_ms,
+                                        double dirtied_cards_rate,
+                                        double refinement_rate,
+                                        uint threads_needed);
 };
 
 class G1OldTracer : public OldGCTracer {
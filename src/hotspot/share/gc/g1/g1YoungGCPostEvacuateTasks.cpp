@@ -135,7 +135,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
   // references will set the candidate state to false.
   // - there can be no references from within humongous starts regions referencing
   // the object because we never allocate other objects into them.
-  // (I.e. there can be no intra-region references)
+  // (I.e. the only intra-region references are those of an object array to
+  // itself, which do not keep it alive)
   //
   // It is not required to check whether the object has been found dead by marking
   // or not, in fact it would prevent reclamation within a concurrent cycle, as
@@ -148,12 +149,6 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
   // are completely up-to-date wrt to references to the humongous object.
   //
   // So there is no need to re-check remembered set size of the humongous region.
-  //
-  // Other implementation considerations:
-  // - never consider object arrays at this time because they would pose
-  // considerable effort for cleaning up the the remembered sets. This is
-  // required because stale remembered sets might reference locations that
-  // are currently allocated into.
   bool is_reclaimable(uint region_idx) const {
     return G1CollectedHeap::heap()->is_humongous_reclaim_candidate(region_idx);
   }
@@ -176,10 +171,6 @@ public:
     }
 
     oop obj = cast_to_oop(r->bottom());
-    guarantee(obj->is_typeArray(),
-              "Only eagerly reclaiming type arrays is supported, but the object "
-              PTR_FORMAT " is not.", p2i(r->bottom()));
-
     log_debug(gc, humongous)("Reclaimed humongous region %u (object size " SIZE_FORMAT " @ " PTR_FORMAT ")",
                              region_idx,
                              (size_t)obj->size() * HeapWordSize,
@@ -77,6 +77,11 @@
                "Concurrently preclean java.lang.ref.references instances "  \
                "before the Remark pause.")                                  \
                                                                             \
+  product(bool, G1ParallelReferencePrecleaning, false, EXPERIMENTAL,        \
+               "Use the concurrent marking threads to preclean "            \
+               "java.lang.ref.references instances in parallel. Only "      \
+               "has an effect with G1UseReferencePrecleaning.")             \
+                                                                            \
   product(double, G1LastPLABAverageOccupancy, 50.0, EXPERIMENTAL,           \
                "The expected average occupancy of the last PLAB in "        \
                "percent.")                                                  \
@@ -189,6 +194,18 @@
           "set container.")                                                 \
           range(1, 100)                                                     \
                                                                             \
+  product(bool, G1UseAdaptiveRemSetCoarsening, false, EXPERIMENTAL,         \
+          "Lower the percentages at which Howl and Howl bitmap card set "   \
+          "containers are coarsened to Full while the remembered sets use " \
+          "more than G1RemSetFootprintTargetPercent of the heap, and "      \
+          "raise them back towards G1RemSetCoarsenHowlToFullPercent and "   \
+          "G1RemSetCoarsenHowlBitmapToHowlFullPercent otherwise.")          \
+                                                                            \
+  product(uint, G1RemSetFootprintTargetPercent, 5, EXPERIMENTAL,            \
+          "Target maximum remembered set footprint in percent of the heap " \
+          "capacity used by G1UseAdaptiveRemSetCoarsening.")                \
+          range(1, 100)                                                     \
+                                                                            \
   develop(intx, G1MaxVerifyFailures, -1,                                    \
           "The maximum number of verification failures to print.  "         \
           "-1 means print all.")                                            \
@@ -264,6 +281,12 @@
           "Chunk size used for rebuilding the remembered set.")             \
           range(4 * K, 32 * M)                                              \
                                                                             \
+  product(uint, G1MarkPrefetchDistance, 8, EXPERIMENTAL,                    \
+          "Number of entries popped from the local mark queue and "         \
+          "prefetched ahead of scanning them during concurrent mark. "      \
+          "0 disables prefetching.")                                        \
+          range(0, 16)                                                      \
+                                                                            \
   product(uintx, G1OldCSetRegionThresholdPercent, 10, EXPERIMENTAL,         \
           "An upper bound for the number of old CSet regions expressed "    \
           "as a percentage of the heap size.")                              \
@@ -324,6 +347,11 @@
           "disables this check.")                                           \
           range(0.0, (double)max_uintx)                                     \
                                                                             \
+  product(bool, G1EvacuateToWorkerNode, false, EXPERIMENTAL,                \
+          "With UseNUMA, copy surviving young objects into survivor "       \
+          "regions on the memory node of the evacuating worker thread "     \
+          "instead of the node of the region they are copied from.")        \
+                                                                            \
   product(uint, G1RemSetFreeMemoryRescheduleDelayMillis, 10, EXPERIMENTAL,  \
           "Time after which the card set free memory task reschedules "     \
           "itself if there is work remaining.")                             \
@@ -200,6 +200,14 @@ bool ParallelScavengeHeap::is_maximal_no_gc() const {
   return old_gen()->is_maximal_no_gc() && young_gen()->is_maximal_no_gc();
 }
 
+HeapWord* ParallelScavengeHeap::allocate_loaded_archive_space(size_t word_size) {
+  return old_gen()->allocate(word_size);
+}
+
+void ParallelScavengeHeap::complete_loaded_archive_space(MemRegion archive_space) {
+  old_gen()->complete_loaded_archive_space(archive_space);
+}
+
 
 size_t ParallelScavengeHeap::max_capacity() const {
   size_t estimated = reserved_region().byte_size();
@@ -150,6 +150,10 @@ class ParallelScavengeHeap : public CollectedHeap {
   // collection.
   virtual bool is_maximal_no_gc() const;
 
+  virtual bool can_load_archived_objects() const { return true; }
+  virtual HeapWord* allocate_loaded_archive_space(size_t word_size);
+  virtual void complete_loaded_archive_space(MemRegion archive_space);
+
   virtual void register_nmethod(nmethod* nm);
   virtual void unregister_nmethod(nmethod* nm);
   virtual void verify_nmethod(nmethod* nm);
@@ -55,6 +55,17 @@
           "limiter (a number between 0-100)")                               \
           range(0, 100)                                                     \
                                                                             \
+  product(size_t, ParallelOldCompactionWindowSize, 0, EXPERIMENTAL,         \
+          "Upper bound on the size (in bytes) of the part of the old "      \
+          "generation that a full GC compacts, unless a maximum compaction "\
+          "is requested. Everything below the window becomes part of the "  \
+          "dense prefix (0 means no limit)")                                \
+                                                                            \
+  product(bool, PSNUMAPromotion, false, EXPERIMENTAL,                       \
+          "Place old generation memory on the NUMA node of the GC worker "  \
+          "that first promotes into it, instead of interleaving it. Only "  \
+          "effective with UseNUMA, without large pages and AlwaysPreTouch") \
+                                                                            \
   develop(uintx, GCWorkerDelayMillis, 0,                                    \
           "Delay in scheduling GC workers (in milliseconds)")               \
                                                                             \
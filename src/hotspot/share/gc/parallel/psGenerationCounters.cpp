@@ -33,7 +33,9 @@ PSGenerationCounters::PSGenerationCounters(const char* name,
                                        size_t min_capacity,
                                        size_t max_capacity,
                                        PSVirtualSpace* v):
-    _ps_virtual_space(v) {
+    _ps_virtual_space(v),
+    _numa_num_nodes(0),
+    _numa_promoted(NULL) {
 
   if (UsePerfData) {
 
@@ -65,3 +67,34 @@ PSGenerationCounters::PSGenerationCounters(const char* name,
        PerfData::U_Bytes, _ps_virtual_space->committed_size(), CHECK);
   }
 }
+
+void PSGenerationCounters::initialize_numa_counters(uint num_nodes, const int* node_ids) {
+  assert(_numa_promoted == NULL, "Attempt to initialize twice");
+
+  if (UsePerfData) {
+    EXCEPTION_MARK;
+    ResourceMark rm;
+
+    _numa_num_nodes = num_nodes;
+    _numa_promoted = NEW_C_HEAP_ARRAY(PerfVariable*, num_nodes, mtGC);
+
+    for (uint i = 0; i < num_nodes; i++) {
+      const char* ns = PerfDataManager::name_space(_name_space, "numa", i);
+
+      const char* cname = PerfDataManager::counter_name(ns, "id");
+      PerfDataManager::create_constant(SUN_GC, cname, PerfData::U_None,
+                                       node_ids[i], CHECK);
+
+      cname = PerfDataManager::counter_name(ns, "promoted");
+      _numa_promoted[i] = PerfDataManager::create_variable(SUN_GC, cname,
+                                                           PerfData::U_Bytes, CHECK);
+    }
+  }
+}
+
+void PSGenerationCounters::inc_numa_promoted(uint node_index, size_t bytes) {
+  if (_numa_promoted != NULL) {
+    assert(node_index < _numa_num_nodes, "Invalid node index %u", node_index);
+    _numa_promoted[node_index]->inc((jlong)bytes);
+  }
+}
@@ -38,6 +38,10 @@ class PSGenerationCounters: public GenerationCounters {
  private:
   PSVirtualSpace*      _ps_virtual_space;
 
+  // Bytes promoted into memory local to each NUMA node, see PSNUMAPromotion
+  uint                 _numa_num_nodes;
+  PerfVariable**       _numa_promoted;
+
  public:
   PSGenerationCounters(const char* name, int ordinal, int spaces,
                        size_t min_capacity, size_t max_capacity, PSVirtualSpace* v);
@@ -46,6 +50,9 @@ class PSGenerationCounters: public GenerationCounters {
     assert(_virtual_space == NULL, "Only one should be in use");
     _current_size->set_value(_ps_virtual_space->committed_size());
   }
+
+  void initialize_numa_counters(uint num_nodes, const int* node_ids);
+  void inc_numa_promoted(uint node_index, size_t bytes);
 };
 
 #endif // SHARE_GC_PARALLEL_PSGENERATIONCOUNTERS_HPP
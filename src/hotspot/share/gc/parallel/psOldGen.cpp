@@ -35,6 +35,7 @@
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
+#include "runtime/os.hpp"
 #include "utilities/align.hpp"
 
 PSOldGen::PSOldGen(ReservedSpace rs, size_t initial_size, size_t min_size,
@@ -92,6 +93,9 @@ void PSOldGen::initialize_work(const char* perf_data_name, int level) {
 
   MemRegion cmr((HeapWord*)virtual_space()->low(),
                 (HeapWord*)virtual_space()->high());
+  if (is_numa_first_touch()) {
+    os::numa_make_first_touch((char*)cmr.start(), cmr.byte_size());
+  }
   if (ZapUnusedHeapArea) {
     // Mangle newly committed space immediately rather than
     // waiting for the initialization of the space even though
@@ -124,7 +128,7 @@ void PSOldGen::initialize_work(const char* perf_data_name, int level) {
   object_space()->initialize(cmr,
                              SpaceDecorator::Clear,
                              SpaceDecorator::Mangle,
-                             MutableSpace::SetupPages,
+                             is_numa_first_touch() ? MutableSpace::DontSetupPages : MutableSpace::SetupPages,
                              &ParallelScavengeHeap::heap()->workers());
 
   // Update the start_array
@@ -237,12 +241,24 @@ bool PSOldGen::expand(size_t bytes) {
   return success;
 }
 
+bool PSOldGen::is_numa_first_touch() {
+  // UseNUMA may have been turned off during os initialization. Pretouching
+  // places all pages up front, and with large pages many LABs of different
+  // workers would share a page.
+  return PSNUMAPromotion && UseNUMA && !UseLargePages && !AlwaysPreTouch;
+}
+
 bool PSOldGen::expand_by(size_t bytes) {
   assert_lock_strong(ExpandHeap_lock);
   assert_locked_or_safepoint(Heap_lock);
   assert(bytes > 0, "precondition");
   bool result = virtual_space()->expand_by(bytes);
   if (result) {
+    if (is_numa_first_touch()) {
+      // Committing interleaves the new memory, undo that before it is touched
+      char* const virtual_space_high = virtual_space()->high();
+      os::numa_make_first_touch(virtual_space_high - bytes, bytes);
+    }
     if (ZapUnusedHeapArea) {
       // We need to mangle the newly expanded area. The memregion spans
       // end -> new_end, we assume that top -> end is already mangled.
@@ -368,7 +384,7 @@ void PSOldGen::post_resize() {
   object_space()->initialize(new_memregion,
                              SpaceDecorator::DontClear,
                              SpaceDecorator::DontMangle,
-                             MutableSpace::SetupPages,
+                             is_numa_first_touch() ? MutableSpace::DontSetupPages : MutableSpace::SetupPages,
                              workers);
 
   assert(new_word_size == heap_word_size(object_space()->capacity_in_bytes()),
@@ -414,6 +430,15 @@ class VerifyObjectStartArrayClosure : public ObjectClosure {
   }
 };
 
+void PSOldGen::complete_loaded_archive_space(MemRegion archive_space) {
+  assert(object_space()->used_region().contains(archive_space), "archive space not in the old gen");
+  HeapWord* cur = archive_space.start();
+  while (cur < archive_space.end()) {
+    _start_array.allocate_block(cur);
+    cur += cast_to_oop(cur)->size();
+  }
+}
+
 void PSOldGen::verify_object_start_array() {
   VerifyObjectStartArrayClosure check( this, &_start_array );
   object_iterate(&check);
@@ -114,10 +114,16 @@ class PSOldGen : public CHeapObj<mtGC> {
   MutableSpace*         object_space() const      { return _object_space; }
   ObjectStartArray*     start_array()             { return &_start_array; }
   PSVirtualSpace*       virtual_space() const     { return _virtual_space;}
+  PSGenerationCounters* gen_counters() const      { return _gen_counters; }
 
   // Has the generation been successfully allocated?
   bool is_allocated();
 
+  // With PSNUMAPromotion the old generation is not interleaved across the
+  // NUMA nodes. Its pages are placed on the node of the GC worker that
+  // first promotes into them, without binding each promotion LAB.
+  static bool is_numa_first_touch();
+
   // Size info
   size_t capacity_in_bytes() const        { return object_space()->capacity_in_bytes(); }
   size_t used_in_bytes() const            { return object_space()->used_in_bytes(); }
@@ -162,6 +168,10 @@ class PSOldGen : public CHeapObj<mtGC> {
   void verify();
   void verify_object_start_array();
 
+  // Record the objects of CDS archived heap regions copied into this
+  // generation in the object start array.
+  void complete_loaded_archive_space(MemRegion archive_space);
+
   // Performance Counter support
   void update_counters();
 
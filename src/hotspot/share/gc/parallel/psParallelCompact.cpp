@@ -715,52 +715,7 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
         return false;
       }
 
-      // Compute the destination_count for cur_region, and if necessary, update
-      // source_region for a destination region.  The source_region field is
-      // updated if cur_region is the first (left-most) region to be copied to a
-      // destination region.
-      //
-      // The destination_count calculation is a bit subtle.  A region that has
-      // data that compacts into itself does not count itself as a destination.
-      // This maintains the invariant that a zero count means the region is
-      // available and can be claimed and then filled.
-      uint destination_count = 0;
-      if (split_info.is_split(cur_region)) {
-        // The current region has been split:  the partial object will be copied
-        // to one destination space and the remaining data will be copied to
-        // another destination space.  Adjust the initial destination_count and,
-        // if necessary, set the source_region field if the partial object will
-        // cross a destination region boundary.
-        destination_count = split_info.destination_count();
-        if (destination_count == 2) {
-          size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
-          _region_data[dest_idx].set_source_region(cur_region);
-        }
-      }
-
-      HeapWord* const last_addr = dest_addr + words - 1;
-      const size_t dest_region_1 = addr_to_region_idx(dest_addr);
-      const size_t dest_region_2 = addr_to_region_idx(last_addr);
-
-      // Initially assume that the destination regions will be the same and
-      // adjust the value below if necessary.  Under this assumption, if
-      // cur_region == dest_region_2, then cur_region will be compacted
-      // completely into itself.
-      destination_count += cur_region == dest_region_2 ? 0 : 1;
-      if (dest_region_1 != dest_region_2) {
-        // Destination regions differ; adjust destination_count.
-        destination_count += 1;
-        // Data from cur_region will be copied to the start of dest_region_2.
-        _region_data[dest_region_2].set_source_region(cur_region);
-      } else if (is_region_aligned(dest_addr)) {
-        // Data from cur_region will be copied to the start of the destination
-        // region.
-        _region_data[dest_region_1].set_source_region(cur_region);
-      }
-
-      _region_data[cur_region].set_destination_count(destination_count);
-      _region_data[cur_region].set_data_location(region_to_addr(cur_region));
-      dest_addr += words;
+      dest_addr = summarize_region(split_info, cur_region, dest_addr);
     }
 
     ++cur_region;
@@ -770,6 +725,87 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
   return true;
 }
 
+HeapWord* ParallelCompactData::summarize_region(SplitInfo& split_info,
+                                                size_t cur_region,
+                                                HeapWord* dest_addr)
+{
+  const size_t words = _region_data[cur_region].data_size();
+  assert(words > 0, "only for regions with data");
+
+  // Compute the destination_count for cur_region, and if necessary, update
+  // source_region for a destination region.  The source_region field is
+  // updated if cur_region is the first (left-most) region to be copied to a
+  // destination region.
+  //
+  // The destination_count calculation is a bit subtle.  A region that has
+  // data that compacts into itself does not count itself as a destination.
+  // This maintains the invariant that a zero count means the region is
+  // available and can be claimed and then filled.
+  uint destination_count = 0;
+  if (split_info.is_split(cur_region)) {
+    // The current region has been split:  the partial object will be copied
+    // to one destination space and the remaining data will be copied to
+    // another destination space.  Adjust the initial destination_count and,
+    // if necessary, set the source_region field if the partial object will
+    // cross a destination region boundary.
+    destination_count = split_info.destination_count();
+    if (destination_count == 2) {
+      size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
+      _region_data[dest_idx].set_source_region(cur_region);
+    }
+  }
+
+  HeapWord* const last_addr = dest_addr + words - 1;
+  const size_t dest_region_1 = addr_to_region_idx(dest_addr);
+  const size_t dest_region_2 = addr_to_region_idx(last_addr);
+
+  // Initially assume that the destination regions will be the same and
+  // adjust the value below if necessary.  Under this assumption, if
+  // cur_region == dest_region_2, then cur_region will be compacted
+  // completely into itself.
+  destination_count += cur_region == dest_region_2 ? 0 : 1;
+  if (dest_region_1 != dest_region_2) {
+    // Destination regions differ; adjust destination_count.
+    destination_count += 1;
+    // Data from cur_region will be copied to the start of dest_region_2.
+    _region_data[dest_region_2].set_source_region(cur_region);
+  } else if (is_region_aligned(dest_addr)) {
+    // Data from cur_region will be copied to the start of the destination
+    // region.
+    _region_data[dest_region_1].set_source_region(cur_region);
+  }
+
+  _region_data[cur_region].set_destination_count(destination_count);
+  _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+
+  return dest_addr + words;
+}
+
+size_t ParallelCompactData::data_size(size_t beg_region, size_t end_region) const
+{
+  size_t words = 0;
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    words += _region_data[cur_region].data_size();
+  }
+  return words;
+}
+
+HeapWord* ParallelCompactData::summarize_range(SplitInfo& split_info,
+                                               size_t beg_region,
+                                               size_t end_region,
+                                               HeapWord* dest_addr)
+{
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    // The destination must be set even if the region has no data.
+    _region_data[cur_region].set_destination(dest_addr);
+
+    if (_region_data[cur_region].data_size() > 0) {
+      dest_addr = summarize_region(split_info, cur_region, dest_addr);
+    }
+  }
+  return dest_addr;
+}
+
 HeapWord* ParallelCompactData::calc_new_pointer(HeapWord* addr, ParCompactionManager* cm) const {
   assert(addr != NULL, "Should detect NULL oop earlier");
   assert(ParallelScavengeHeap::heap()->is_in(addr), "not in heap");
@@ -1384,9 +1420,27 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
   const size_t gcs_since_max = total_invocations() - _maximum_compaction_gc_num;
   const bool interval_ended = gcs_since_max > HeapMaximumCompactionInterval ||
     total_invocations() == HeapFirstMaximumCompactionCount;
+
+  // With a bounded compaction window only the regions at the end of the space
+  // are compacted, which bounds the copying done by the pause independently of
+  // the heap size.  The dense prefix must then start at or above the first
+  // region of the window, even if that leaves more dead wood than the dead
+  // wood limiter allows.  Requested maximum compactions ignore the window.
+  const RegionData* window_cp = full_cp;
+  if (ParallelOldCompactionWindowSize > 0 && !maximum_compaction) {
+    const size_t window_regions =
+      MAX2(ParallelOldCompactionWindowSize / (region_size * HeapWordSize), (size_t)1);
+    if (pointer_delta(top_cp, full_cp, sizeof(RegionData)) > window_regions) {
+      window_cp = top_cp - window_regions;
+      log_develop_debug(gc, compaction)(
+          "compaction window: " SIZE_FORMAT " regions starting at " PTR_FORMAT,
+          window_regions, p2i(sd.region_to_addr(window_cp)));
+    }
+  }
+
   if (maximum_compaction || full_cp == top_cp || interval_ended) {
     _maximum_compaction_gc_num = total_invocations();
-    return sd.region_to_addr(full_cp);
+    return sd.region_to_addr(window_cp);
   }
 
   const size_t space_live = pointer_delta(new_top, bottom);
@@ -1415,11 +1469,12 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
   const RegionData* const limit_cp =
     dead_wood_limit_region(full_cp, top_cp, dead_wood_limit);
 
-  // Scan from the first region with dead space to the limit region and find the
-  // one with the best (largest) reclaimed ratio.
+  // Scan from the first region with dead space (or the start of the compaction
+  // window) to the limit region and find the one with the best (largest)
+  // reclaimed ratio.
   double best_ratio = 0.0;
-  const RegionData* best_cp = full_cp;
-  for (const RegionData* cp = full_cp; cp < limit_cp; ++cp) {
+  const RegionData* best_cp = window_cp;
+  for (const RegionData* cp = window_cp; cp < limit_cp; ++cp) {
     double tmp_ratio = reclaimed_ratio(cp, bottom, top, new_top);
     if (tmp_ratio > best_ratio) {
       best_cp = cp;
@@ -1430,15 +1485,163 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
   return sd.region_to_addr(best_cp);
 }
 
+// Hands out fixed size chunks of a range of regions to GC worker threads.
+class PSSummaryChunkClaimer {
+  // Number of regions per chunk.
+  static const size_t ChunkRegions = 1024;
+
+  const size_t _beg_region;
+  const size_t _end_region;
+  volatile size_t _next_chunk;
+
+public:
+  PSSummaryChunkClaimer(size_t beg_region, size_t end_region) :
+    _beg_region(beg_region), _end_region(end_region), _next_chunk(0) { }
+
+  static size_t num_chunks(size_t beg_region, size_t end_region) {
+    return (end_region - beg_region + ChunkRegions - 1) / ChunkRegions;
+  }
+
+  size_t num_chunks() const { return num_chunks(_beg_region, _end_region); }
+  size_t chunk_beg(size_t chunk) const { return _beg_region + chunk * ChunkRegions; }
+  size_t chunk_end(size_t chunk) const { return MIN2(chunk_beg(chunk) + ChunkRegions, _end_region); }
+
+  bool claim(size_t* chunk) {
+    *chunk = Atomic::fetch_and_add(&_next_chunk, (size_t)1);
+    return *chunk < num_chunks();
+  }
+
+  void reset() { _next_chunk = 0; }
+};
+
+class PSSummarizeDensePrefixTask : public AbstractGangTask {
+  PSSummaryChunkClaimer _claimer;
+
+public:
+  PSSummarizeDensePrefixTask(size_t beg_region, size_t end_region) :
+    AbstractGangTask("PSSummarizeDensePrefixTask"),
+    _claimer(beg_region, end_region) { }
+
+  virtual void work(uint worker_id) {
+    ParallelCompactData& sd = PSParallelCompact::summary_data();
+    for (size_t chunk; _claimer.claim(&chunk); /* empty */) {
+      sd.summarize_dense_prefix(sd.region_to_addr(_claimer.chunk_beg(chunk)),
+                                sd.region_to_addr(_claimer.chunk_end(chunk)));
+    }
+  }
+};
+
+// Summarizes a range of regions in two passes.  The first pass sums the live
+// data of each chunk.  The prefix sum over those sizes gives the destination
+// of the first region of every chunk, so the second pass can summarize the
+// chunks independently.  Each destination region has its source_region set
+// by the single region whose data lands at its start, so the writes into
+// other chunks do not conflict.
+class PSSummarizeTask : public AbstractGangTask {
+  SplitInfo& _split_info;
+  PSSummaryChunkClaimer _claimer;
+  HeapWord* const _target_beg;
+  size_t* const _chunk_words;
+  bool _summarize;
+
+public:
+  PSSummarizeTask(SplitInfo& split_info, size_t beg_region, size_t end_region,
+                  HeapWord* target_beg) :
+    AbstractGangTask("PSSummarizeTask"),
+    _split_info(split_info),
+    _claimer(beg_region, end_region),
+    _target_beg(target_beg),
+    _chunk_words(NEW_C_HEAP_ARRAY(size_t, _claimer.num_chunks(), mtGC)),
+    _summarize(false) { }
+
+  ~PSSummarizeTask() {
+    FREE_C_HEAP_ARRAY(size_t, _chunk_words);
+  }
+
+  // Turn the per chunk sizes into offsets from the target start, and prepare
+  // for the second pass.  Returns the total size of the live data.
+  size_t prepare_summarize() {
+    size_t total = 0;
+    for (size_t chunk = 0; chunk < _claimer.num_chunks(); ++chunk) {
+      const size_t words = _chunk_words[chunk];
+      _chunk_words[chunk] = total;
+      total += words;
+    }
+    _claimer.reset();
+    _summarize = true;
+    return total;
+  }
+
+  virtual void work(uint worker_id) {
+    ParallelCompactData& sd = PSParallelCompact::summary_data();
+    for (size_t chunk; _claimer.claim(&chunk); /* empty */) {
+      const size_t beg = _claimer.chunk_beg(chunk);
+      const size_t end = _claimer.chunk_end(chunk);
+      if (_summarize) {
+        sd.summarize_range(_split_info, beg, end, _target_beg + _chunk_words[chunk]);
+      } else {
+        _chunk_words[chunk] = sd.data_size(beg, end);
+      }
+    }
+  }
+};
+
+bool PSParallelCompact::summarize_parallel(SpaceId id, HeapWord* source_beg,
+                                           HeapWord* source_end, HeapWord* target_beg)
+{
+  WorkGang& workers = ParallelScavengeHeap::heap()->workers();
+  SpaceInfo* const space_info = _space_info + id;
+  const size_t beg_region = _summary_data.addr_to_region_idx(source_beg);
+  const size_t end_region =
+    _summary_data.addr_to_region_idx(_summary_data.region_align_up(source_end));
+
+  if (workers.active_workers() == 1 ||
+      PSSummaryChunkClaimer::num_chunks(beg_region, end_region) < 2 ||
+      space_info->split_info().is_valid()) {
+    return false;
+  }
+
+  PSSummarizeTask task(space_info->split_info(), beg_region, end_region, target_beg);
+  workers.run_task(&task);
+
+  const size_t total = task.prepare_summarize();
+  if (total > pointer_delta(space_info->space()->end(), target_beg)) {
+    // Does not fit; the first pass did not modify the summary data.
+    return false;
+  }
+
+  workers.run_task(&task);
+  space_info->set_new_top(target_beg + total);
+  return true;
+}
+
+void PSParallelCompact::summarize_dense_prefix_parallel(HeapWord* beg, HeapWord* end)
+{
+  WorkGang& workers = ParallelScavengeHeap::heap()->workers();
+  const size_t beg_region = _summary_data.addr_to_region_idx(beg);
+  const size_t end_region = _summary_data.addr_to_region_idx(end);
+
+  if (workers.active_workers() == 1 ||
+      PSSummaryChunkClaimer::num_chunks(beg_region, end_region) < 2) {
+    _summary_data.summarize_dense_prefix(beg, end);
+    return;
+  }
+
+  PSSummarizeDensePrefixTask task(beg_region, end_region);
+  workers.run_task(&task);
+}
+
 void PSParallelCompact::summarize_spaces_quick()
 {
   for (unsigned int i = 0; i < last_space_id; ++i) {
     const MutableSpace* space = _space_info[i].space();
-    HeapWord** nta = _space_info[i].new_top_addr();
-    bool result = _summary_data.summarize(_space_info[i].split_info(),
-                                          space->bottom(), space->top(), NULL,
-                                          space->bottom(), space->end(), nta);
-    assert(result, "space must fit into itself");
+    if (!summarize_parallel(SpaceId(i), space->bottom(), space->top(), space->bottom())) {
+      HeapWord** nta = _space_info[i].new_top_addr();
+      bool result = _summary_data.summarize(_space_info[i].split_info(),
+                                            space->bottom(), space->top(), NULL,
+                                            space->bottom(), space->end(), nta);
+      assert(result, "space must fit into itself");
+    }
     _space_info[i].set_dense_prefix(space->bottom());
   }
 }
@@ -1543,11 +1746,13 @@ PSParallelCompact::summarize_space(SpaceId id, bool maximum_compaction)
       fill_dense_prefix_end(id);
 
       // Compute the destination of each Region, and thus each object.
-      _summary_data.summarize_dense_prefix(space->bottom(), dense_prefix_end);
-      _summary_data.summarize(_space_info[id].split_info(),
-                              dense_prefix_end, space->top(), NULL,
-                              dense_prefix_end, space->end(),
-                              _space_info[id].new_top_addr());
+      summarize_dense_prefix_parallel(space->bottom(), dense_prefix_end);
+      if (!summarize_parallel(id, dense_prefix_end, space->top(), dense_prefix_end)) {
+        _summary_data.summarize(_space_info[id].split_info(),
+                                dense_prefix_end, space->top(), NULL,
+                                dense_prefix_end, space->end(),
+                                _space_info[id].new_top_addr());
+      }
     }
   }
 
@@ -442,6 +442,16 @@ public:
                  HeapWord* target_beg, HeapWord* target_end,
                  HeapWord** target_next);
 
+  // Building blocks for summarizing a space in parallel.  data_size() returns
+  // the number of live words in the regions [beg_region, end_region).
+  // summarize_range() computes the summary data for those regions given the
+  // destination of the first region, and returns the destination following
+  // the last one.  The data must fit in the target, i.e., no split is done.
+  size_t data_size(size_t beg_region, size_t end_region) const;
+  HeapWord* summarize_range(SplitInfo& split_info,
+                            size_t beg_region, size_t end_region,
+                            HeapWord* dest_addr);
+
   void clear();
   void clear_range(size_t beg_region, size_t end_region);
   void clear_range(HeapWord* beg, HeapWord* end) {
@@ -493,6 +503,10 @@ public:
 #endif  // #ifdef ASSERT
 
 private:
+  // Summarize a region with live data that fits entirely in the target space.
+  HeapWord* summarize_region(SplitInfo& split_info, size_t cur_region,
+                             HeapWord* dest_addr);
+
   bool initialize_block_data();
   bool initialize_region_data(size_t region_size);
   PSVirtualSpace* create_vspace(size_t count, size_t element_size);
@@ -939,7 +953,12 @@ inline void ParMarkBitMapClosure::decrement_words_remaining(size_t words) {
 // dense prefix do need to have their object references updated.  See method
 // summarize_dense_prefix().
 //
-// The summary phase is done using 1 GC thread.
+// The summary phase uses multiple GC threads when summarizing a space into
+// itself, which is the case for the old generation.  The regions are divided
+// into chunks, the live data of each chunk is summed in parallel, and a
+// prefix sum over the chunks gives the destination of each chunk.  Summarizing
+// the young spaces into the old generation may require splitting a space and
+// is done using 1 GC thread.
 //
 // The compaction phase moves objects to their new location and updates all
 // references in the object.
@@ -1104,6 +1123,14 @@ class PSParallelCompact : AllStatic {
   // non-empty.
   static void fill_dense_prefix_end(SpaceId id);
 
+  // Summarize [source_beg, source_end) into the space id starting at
+  // target_beg, using the GC worker threads.  Returns false, without touching
+  // the summary data, if the source does not fit or the work is too small to
+  // be worth distributing.
+  static bool summarize_parallel(SpaceId id, HeapWord* source_beg,
+                                 HeapWord* source_end, HeapWord* target_beg);
+  static void summarize_dense_prefix_parallel(HeapWord* beg, HeapWord* end);
+
   static void summarize_spaces_quick();
   static void summarize_space(SpaceId id, bool maximum_compaction);
   static void summary_phase(ParCompactionManager* cm, bool maximum_compaction);
@@ -26,6 +26,7 @@
 #include "classfile/javaClasses.inline.hpp"
 #include "gc/parallel/mutableSpace.hpp"
 #include "gc/parallel/parallelScavengeHeap.hpp"
+#include "gc/parallel/psGenerationCounters.hpp"
 #include "gc/parallel/psOldGen.hpp"
 #include "gc/parallel/psPromotionManager.inline.hpp"
 #include "gc/parallel/psScavenge.inline.hpp"
@@ -41,12 +42,16 @@
 #include "memory/resourceArea.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/compressedOops.inline.hpp"
+#include "runtime/os.hpp"
 
 PaddedEnd<PSPromotionManager>* PSPromotionManager::_manager_array = NULL;
 PSPromotionManager::PSScannerTasksQueueSet* PSPromotionManager::_stack_array_depth = NULL;
 PreservedMarksSet*             PSPromotionManager::_preserved_marks_set = NULL;
 PSOldGen*                      PSPromotionManager::_old_gen = NULL;
 MutableSpace*                  PSPromotionManager::_young_space = NULL;
+size_t                         PSPromotionManager::_old_plab_size = 0;
+uint                           PSPromotionManager::_numa_num_nodes = 0;
+int*                           PSPromotionManager::_numa_node_ids = NULL;
 
 void PSPromotionManager::initialize() {
   ParallelScavengeHeap* heap = ParallelScavengeHeap::heap();
@@ -54,6 +59,9 @@ void PSPromotionManager::initialize() {
   _old_gen = heap->old_gen();
   _young_space = heap->young_gen()->to_space();
 
+  _old_plab_size = OldPLABSize;
+  initialize_numa();
+
   const uint promotion_manager_num = ParallelGCThreads + 1;
 
   // To prevent false sharing, we pad the PSPromotionManagers
@@ -78,6 +86,41 @@ void PSPromotionManager::initialize() {
   }
 }
 
+void PSPromotionManager::initialize_numa() {
+  if (!PSNUMAPromotion) {
+    return;
+  }
+
+  if (!PSOldGen::is_numa_first_touch()) {
+    log_info(gc, heap)("PSNUMAPromotion disabled, requires UseNUMA without large pages or AlwaysPreTouch");
+    return;
+  }
+
+  const size_t num_nodes = os::numa_get_groups_num();
+  int* const node_ids = NEW_C_HEAP_ARRAY(int, num_nodes, mtGC);
+  _numa_num_nodes = (uint)os::numa_get_leaf_groups(node_ids, num_nodes);
+  _numa_node_ids = node_ids;
+
+  // A LAB of four pages covers at least three whole pages, whatever its
+  // alignment, so that most pages are first touched by a single worker.
+  const size_t page_words = os::vm_page_size() / HeapWordSize;
+  _old_plab_size = MAX2(OldPLABSize, 4 * page_words);
+
+  old_gen()->gen_counters()->initialize_numa_counters(_numa_num_nodes, _numa_node_ids);
+
+  log_info(gc, heap)("NUMA-local promotion: %u nodes, old LAB size " SIZE_FORMAT " words",
+                     _numa_num_nodes, _old_plab_size);
+}
+
+uint PSPromotionManager::numa_node_index(int lgrp_id) {
+  for (uint i = 0; i < _numa_num_nodes; i++) {
+    if (_numa_node_ids[i] == lgrp_id) {
+      return i;
+    }
+  }
+  return _numa_num_nodes;
+}
+
 // Helper functions to get around the circular dependency between
 // psScavenge.inline.hpp and psPromotionManager.inline.hpp.
 bool PSPromotionManager::should_scavenge(oop* p, bool check_to_space) {
@@ -121,6 +164,12 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
       promotion_failure_occurred = true;
     }
     manager->flush_labs();
+    if (is_numa_promotion()) {
+      for (uint n = 0; n < _numa_num_nodes; n++) {
+        old_gen()->gen_counters()->inc_numa_promoted(n, manager->_numa_promoted_words[n] * HeapWordSize);
+        manager->_numa_promoted_words[n] = 0;
+      }
+    }
   }
   if (!promotion_failure_occurred) {
     // If there was no promotion failure, the preserved mark stacks
@@ -189,6 +238,15 @@ PSPromotionManager::PSPromotionManager() {
   // We set the old lab's start array.
   _old_lab.set_start_array(old_gen()->start_array());
 
+  _old_lab_node_index = _numa_num_nodes;
+  _numa_promoted_words = NULL;
+  if (is_numa_promotion()) {
+    _numa_promoted_words = NEW_C_HEAP_ARRAY(size_t, _numa_num_nodes, mtGC);
+    for (uint i = 0; i < _numa_num_nodes; i++) {
+      _numa_promoted_words[i] = 0;
+    }
+  }
+
   uint queue_size;
   claimed_stack_depth()->initialize();
   queue_size = claimed_stack_depth()->max_elems();
@@ -226,6 +284,7 @@ void PSPromotionManager::reset() {
   lab_base = old_gen()->object_space()->top();
   _old_lab.initialize(MemRegion(lab_base, (size_t)0));
   _old_gen_is_full = false;
+  _old_lab_node_index = _numa_num_nodes;
 
   _promotion_failed_info.reset();
 
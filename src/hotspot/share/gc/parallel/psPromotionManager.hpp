@@ -63,6 +63,13 @@ class PSPromotionManager {
   static PSOldGen*                      _old_gen;
   static MutableSpace*                  _young_space;
 
+  // NUMA-local promotion, see PSNUMAPromotion. When enabled, old LABs are
+  // large enough to cover whole pages, which are placed on the node of the
+  // promoting worker when it first copies into them.
+  static size_t                         _old_plab_size;
+  static uint                           _numa_num_nodes;
+  static int*                           _numa_node_ids;
+
 #if TASKQUEUE_STATS
   size_t                              _array_chunk_pushes;
   size_t                              _array_chunk_steals;
@@ -80,6 +87,12 @@ class PSPromotionManager {
   bool                                _young_gen_is_full;
   bool                                _old_gen_is_full;
 
+  // Node of the worker when the current old LAB was allocated, or
+  // _numa_num_nodes if unknown, and the words promoted into the LABs
+  // allocated on each node.
+  uint                                _old_lab_node_index;
+  size_t*                             _numa_promoted_words;
+
   PSScannerTasksQueue                 _claimed_stack_depth;
   OverflowTaskQueue<oop, mtGC>        _claimed_stack_breadth;
 
@@ -110,6 +123,11 @@ class PSPromotionManager {
 
   static PSScannerTasksQueueSet* stack_array_depth() { return _stack_array_depth; }
 
+  static void initialize_numa();
+  static bool is_numa_promotion()    { return _numa_node_ids != NULL; }
+  static uint numa_node_index(int lgrp_id);
+  inline void numa_record_promotion(oop new_obj, size_t new_obj_size);
+
   template<bool promote_immediately>
   oop copy_unmarked_to_survivor_space(oop o, markWord m);
 
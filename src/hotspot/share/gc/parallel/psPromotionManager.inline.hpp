@@ -128,6 +128,13 @@ inline void PSPromotionManager::push_contents(oop obj) {
   }
 }
 
+inline void PSPromotionManager::numa_record_promotion(oop new_obj, size_t new_obj_size) {
+  // Only objects copied into a LAB of a known node count as NUMA-local promotions.
+  if (_old_lab_node_index != _numa_num_nodes && _old_lab.contains(new_obj)) {
+    _numa_promoted_words[_old_lab_node_index] += new_obj_size;
+  }
+}
+
 template<bool promote_immediately>
 inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
   assert(should_scavenge(&o), "Sanity");
@@ -216,8 +223,12 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
           // Flush and fill
           _old_lab.flush();
 
-          HeapWord* lab_base = old_gen()->allocate(OldPLABSize);
+          HeapWord* lab_base = old_gen()->allocate(_old_plab_size);
           if(lab_base != NULL) {
+            if (is_numa_promotion()) {
+              // Looked up once per LAB, the worker may migrate meanwhile
+              _old_lab_node_index = numa_node_index(os::numa_get_group_id());
+            }
 #ifdef ASSERT
             // Delay the initialization of the promotion lab (plab).
             // This exposes uninitialized plabs to card table processing.
@@ -225,7 +236,7 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
               os::naked_sleep(GCWorkerDelayMillis);
             }
 #endif
-            _old_lab.initialize(MemRegion(lab_base, OldPLABSize));
+            _old_lab.initialize(MemRegion(lab_base, _old_plab_size));
             // Try the old lab allocation again.
             new_obj = cast_to_oop(_old_lab.allocate(new_obj_size));
             promotion_trace_event(new_obj, o, new_obj_size, age, true, &_old_lab);
@@ -264,6 +275,8 @@ inline oop PSPromotionManager::copy_unmarked_to_survivor_space(oop o,
     if (!new_obj_is_tenured) {
       new_obj->incr_age();
       assert(young_space()->contains(new_obj), "Attempt to push non-promoted obj");
+    } else if (is_numa_promotion()) {
+      numa_record_promotion(new_obj, new_obj_size);
     }
 
     log_develop_trace(gc, scavenge)("{%s %s " PTR_FORMAT " -> " PTR_FORMAT " (%d)}",
@@ -34,6 +34,7 @@
 #include "compiler/oopMap.hpp"
 #include "gc/serial/genMarkSweep.hpp"
 #include "gc/serial/serialGcRefProcProxyTask.hpp"
+#include "gc/serial/serialHeap.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcTimer.hpp"
@@ -45,19 +46,23 @@
 #include "gc/shared/modRefBarrierSet.hpp"
 #include "gc/shared/referencePolicy.hpp"
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
+#include "gc/shared/oopStorageSet.hpp"
 #include "gc/shared/space.hpp"
 #include "gc/shared/strongRootsScope.hpp"
 #include "gc/shared/weakProcessor.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/universe.hpp"
 #include "oops/instanceRefKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/events.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/stack.inline.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmci.hpp"
@@ -262,6 +267,78 @@ public:
   }
 };
 
+// Parallel version of the adjust phase. The roots are split into
+// sub-tasks and the spaces are handed out one at a time, old generation
+// first since it is usually the largest. Adjusting only reads the
+// forwarding pointers installed in phase 2, so workers never write to
+// the same location.
+class GenAdjustPointersTask : public AbstractGangTask {
+  enum AdjustSubTasks {
+    ADJUST_CLDS,
+    ADJUST_OOP_STORAGE,
+    ADJUST_CODE_CACHE,
+    ADJUST_WEAK_ROOTS,
+    ADJUST_PRESERVED_MARKS,
+    ADJUST_NUM_ELEMENTS
+  };
+
+  class CollectSpacesClosure : public SpaceClosure {
+    GrowableArray<Space*>* _spaces;
+  public:
+    CollectSpacesClosure(GrowableArray<Space*>* spaces) : _spaces(spaces) {}
+    void do_space(Space* sp) {
+      _spaces->append(sp);
+    }
+  };
+
+  SubTasksDone _sub_tasks;
+  GrowableArray<Space*> _spaces;
+  volatile int _next_space;
+
+public:
+  GenAdjustPointersTask() :
+      AbstractGangTask("GenAdjustPointersTask"),
+      _sub_tasks(ADJUST_NUM_ELEMENTS),
+      _spaces(4, mtGC),
+      _next_space(0) {
+    GenCollectedHeap* gch = GenCollectedHeap::heap();
+    CollectSpacesClosure blk(&_spaces);
+    gch->old_gen()->space_iterate(&blk, true);
+    gch->young_gen()->space_iterate(&blk, true);
+  }
+
+  void work(uint worker_id) {
+    GenCollectedHeap* gch = GenCollectedHeap::heap();
+
+    Threads::possibly_parallel_oops_do(true, &MarkSweep::adjust_pointer_closure, NULL);
+
+    if (_sub_tasks.try_claim_task(ADJUST_CLDS)) {
+      ClassLoaderDataGraph::cld_do(&MarkSweep::adjust_cld_closure);
+    }
+    if (_sub_tasks.try_claim_task(ADJUST_OOP_STORAGE)) {
+      OopStorageSet::strong_oops_do(&MarkSweep::adjust_pointer_closure);
+    }
+    if (_sub_tasks.try_claim_task(ADJUST_CODE_CACHE)) {
+      MarkingCodeBlobClosure adjust_code_closure(&MarkSweep::adjust_pointer_closure,
+                                                 CodeBlobToOopClosure::FixRelocations);
+      CodeCache::blobs_do(&adjust_code_closure);
+    }
+    if (_sub_tasks.try_claim_task(ADJUST_WEAK_ROOTS)) {
+      gch->gen_process_weak_roots(&MarkSweep::adjust_pointer_closure);
+    }
+    if (_sub_tasks.try_claim_task(ADJUST_PRESERVED_MARKS)) {
+      MarkSweep::adjust_marks();
+    }
+    _sub_tasks.all_tasks_claimed();
+
+    for (int i = Atomic::fetch_and_add(&_next_space, 1);
+         i < _spaces.length();
+         i = Atomic::fetch_and_add(&_next_space, 1)) {
+      _spaces.at(i)->adjust_pointers();
+    }
+  }
+};
+
 void GenMarkSweep::mark_sweep_phase3() {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
 
@@ -271,6 +348,15 @@ void GenMarkSweep::mark_sweep_phase3() {
   // Need new claim bits for the pointer adjustment tracing.
   ClassLoaderDataGraph::clear_claimed_marks();
 
+  WorkGang* workers = SerialHeap::heap()->full_gc_workers();
+  if (workers != NULL) {
+    uint num_workers = workers->update_active_workers(workers->total_workers());
+    StrongRootsScope srs(num_workers);
+    GenAdjustPointersTask task;
+    workers->run_task(&task);
+    return;
+  }
+
   {
     StrongRootsScope srs(0);
 
@@ -27,7 +27,9 @@
 #include "gc/serial/serialHeap.hpp"
 #include "gc/serial/tenuredGeneration.inline.hpp"
 #include "gc/shared/genMemoryPools.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/universe.hpp"
 #include "services/memoryManager.hpp"
 
@@ -41,11 +43,29 @@ SerialHeap::SerialHeap() :
                      "Copy:MSC"),
     _eden_pool(NULL),
     _survivor_pool(NULL),
-    _old_pool(NULL) {
+    _old_pool(NULL),
+    _full_gc_workers(NULL) {
   _young_manager = new GCMemoryManager("Copy", "end of minor GC");
   _old_manager = new GCMemoryManager("MarkSweepCompact", "end of major GC");
 }
 
+jint SerialHeap::initialize() {
+  jint status = GenCollectedHeap::initialize();
+  if (status != JNI_OK) {
+    return status;
+  }
+
+  if (SerialFullGCThreads > 1) {
+    // With UseDynamicNumberOfGCThreads the workers beyond the first are
+    // only created when a full GC activates them.
+    _full_gc_workers = new WorkGang("Serial Full GC Thread", SerialFullGCThreads,
+                                    true /* are_GC_task_threads */,
+                                    false /* are_ConcurrentGC_threads */);
+    _full_gc_workers->initialize_workers();
+  }
+  return JNI_OK;
+}
+
 void SerialHeap::initialize_serviceability() {
 
   DefNewGeneration* young = young_gen();
@@ -89,6 +109,25 @@ GrowableArray<MemoryPool*> SerialHeap::memory_pools() {
   return memory_pools;
 }
 
+HeapWord* SerialHeap::allocate_loaded_archive_space(size_t word_size) {
+  MutexLocker ml(Heap_lock);
+  HeapWord* result = old_gen()->allocate(word_size, false /* is_tlab */);
+  if (result == NULL) {
+    result = old_gen()->expand_and_allocate(word_size, false /* is_tlab */);
+  }
+  return result;
+}
+
+void SerialHeap::complete_loaded_archive_space(MemRegion archive_space) {
+  old_gen()->complete_loaded_archive_space(archive_space);
+}
+
+void SerialHeap::gc_threads_do(ThreadClosure* tc) const {
+  if (_full_gc_workers != NULL) {
+    _full_gc_workers->threads_do(tc);
+  }
+}
+
 void SerialHeap::young_process_roots(OopIterateClosure* root_closure,
                                      OopIterateClosure* old_gen_closure,
                                      CLDClosure* cld_closure) {
@@ -25,13 +25,18 @@
 #ifndef SHARE_GC_SERIAL_SERIAL_GLOBALS_HPP
 #define SHARE_GC_SERIAL_SERIAL_GLOBALS_HPP
 
-#define GC_SERIAL_FLAGS(develop,     \
-                        develop_pd,  \
-                        product,     \
-                        product_pd,  \
-                        notproduct,  \
-                        range,       \
-                        constraint)
+#define GC_SERIAL_FLAGS(develop,                                            \
+                        develop_pd,                                         \
+                        product,                                            \
+                        product_pd,                                         \
+                        notproduct,                                         \
+                        range,                                              \
+                        constraint)                                         \
+                                                                            \
+  product(uint, SerialFullGCThreads, 0, EXPERIMENTAL,                       \
+          "Number of worker threads used to adjust pointers during a "      \
+          "Serial full GC. 0 or 1 keeps the full GC single-threaded.")      \
+          range(0, 256)
 
 // end of GC_SERIAL_FLAGS
 
@@ -218,6 +218,21 @@ void TenuredGeneration::object_iterate(ObjectClosure* blk) {
   _the_space->object_iterate(blk);
 }
 
+void TenuredGeneration::complete_loaded_archive_space(MemRegion archive_space) {
+  // The archive space was allocated as a single block. Rebuild the offset
+  // table object by object from the bottom of the space, so that
+  // block_start() does not have to walk from the start of the archive.
+  TenuredSpace* space = (TenuredSpace*)_the_space;
+  assert(space->used_region().contains(archive_space), "archive space not in the old gen");
+  space->initialize_threshold();
+  HeapWord* start = space->bottom();
+  while (start < archive_space.end()) {
+    size_t word_size = cast_to_oop(start)->size();
+    space->alloc_block(start, start + word_size);
+    start += word_size;
+  }
+}
+
 void TenuredGeneration::save_marks() {
   _the_space->set_saved_mark();
 }
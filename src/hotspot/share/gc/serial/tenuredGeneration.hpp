@@ -74,6 +74,10 @@ class TenuredGeneration: public CardGeneration {
   // Iteration
   void object_iterate(ObjectClosure* blk);
 
+  // Record the objects of CDS archived heap regions copied into this
+  // generation in the block offset table.
+  void complete_loaded_archive_space(MemRegion archive_space);
+
   virtual inline HeapWord* allocate(size_t word_size, bool is_tlab);
   virtual inline HeapWord* par_allocate(size_t word_size, bool is_tlab);
 
@@ -481,6 +481,15 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Is the given object inside a CDS archive area?
   virtual bool is_archived_object(oop object) const;
 
+  // Support for copying the CDS archived heap regions into the heap at
+  // startup, for collectors that cannot map them at a fixed address.
+  // The space is allocated before any other object, and completed (e.g.
+  // block offset information recorded) once the copied objects are
+  // parseable.
+  virtual bool can_load_archived_objects() const { return false; }
+  virtual HeapWord* allocate_loaded_archive_space(size_t word_size) { return NULL; }
+  virtual void complete_loaded_archive_space(MemRegion archive_space) { }
+
   virtual bool is_oop(oop object) const;
   // Non product verification and debugging.
 #ifndef PRODUCT
@@ -81,6 +81,9 @@ const char* GCCause::to_string(GCCause::Cause cause) {
     case _metadata_GC_clear_soft_refs:
       return "Metadata GC Clear Soft References";
 
+    case _codecache_GC_threshold:
+      return "CodeCache GC Threshold";
+
     case _old_generation_expanded_on_last_scavenge:
       return "Old Generation Expanded On Last Scavenge";
 
@@ -65,6 +65,7 @@ class GCCause : public AllStatic {
     _tenured_generation_full,
     _metadata_GC_threshold,
     _metadata_GC_clear_soft_refs,
+    _codecache_GC_threshold,
 
     _old_generation_expanded_on_last_scavenge,
     _old_generation_too_full_to_scavenge,
@@ -50,7 +50,8 @@ public:
     NONE,
     GCPolicyCountersKind,
     GCAdaptivePolicyCountersKind,
-    PSGCAdaptivePolicyCountersKind
+    PSGCAdaptivePolicyCountersKind,
+    G1PolicyCountersKind
   };
 
   GCPolicyCounters(const char* name, int collectors, int generations);
@@ -166,7 +166,11 @@ void VM_GC_HeapInspection::doit() {
     }
   }
   HeapInspection inspect;
-  inspect.heap_inspection(_out, _parallel_thread_num);
+  if (_mode == HeapInspection::PrintHistogram) {
+    inspect.heap_inspection(_out, _parallel_thread_num);
+  } else {
+    inspect.heap_inspection_diff(_out, _mode == HeapInspection::RecordBaseline, _parallel_thread_num);
+  }
 }
 
 
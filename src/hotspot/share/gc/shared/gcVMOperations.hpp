@@ -27,6 +27,7 @@
 
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/genCollectedHeap.hpp"
+#include "memory/heapInspection.hpp"
 #include "memory/metaspace.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/handles.hpp"
@@ -162,14 +163,16 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
   outputStream* _out;
   bool _full_gc;
   uint _parallel_thread_num;
+  HeapInspection::Mode _mode;
  public:
   VM_GC_HeapInspection(outputStream* out, bool request_full_gc,
-                       uint parallel_thread_num = 1) :
+                       uint parallel_thread_num = 1,
+                       HeapInspection::Mode mode = HeapInspection::PrintHistogram) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_inspection /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     request_full_gc), _out(out), _full_gc(request_full_gc),
-                    _parallel_thread_num(parallel_thread_num) {}
+                    _parallel_thread_num(parallel_thread_num), _mode(mode) {}
 
   ~VM_GC_HeapInspection() {}
   virtual VMOp_Type type() const { return VMOp_GC_HeapInspection; }
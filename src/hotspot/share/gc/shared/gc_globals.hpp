@@ -279,6 +279,20 @@
   product(uintx, WorkStealingSpinToYieldRatio, 10, EXPERIMENTAL,            \
           "Ratio of hard spins to calls to yield")                          \
                                                                             \
+  product(bool, WorkStealingAdaptiveSpin, false, EXPERIMENTAL,              \
+          "Scale the number of spin steps before a terminating worker "     \
+          "sleeps by how long new work recently took to appear, bounded "   \
+          "below by the number of workers and above by "                    \
+          "WorkStealingYieldsBeforeSleep")                                  \
+                                                                            \
+  product(bool, TaskQueueBulkSteal, false, EXPERIMENTAL,                    \
+          "After a successful steal, move up to half of the victim's "      \
+          "remaining tasks to the queue of the stealing worker")            \
+                                                                            \
+  product(bool, TaskQueueNUMASteal, false, EXPERIMENTAL,                    \
+          "Prefer stealing from queues whose owner last ran on the same "   \
+          "NUMA node as the stealing worker. Requires UseNUMA")             \
+                                                                            \
   develop(uintx, ObjArrayMarkingStride, 2048,                               \
           "Number of object array elements to push onto the marking stack " \
           "before pushing a continuation entry")                            \
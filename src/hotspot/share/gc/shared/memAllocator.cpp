@@ -180,7 +180,7 @@ void MemAllocator::Allocation::notify_allocation_jvmti_sampler() {
   // support for JVMTI VMObjectAlloc event (no-op if not enabled)
   JvmtiExport::vm_object_alloc_event_collector(obj());
 
-  if (!JvmtiExport::should_post_sampled_object_alloc()) {
+  if (!JvmtiExport::should_post_sampled_object_alloc() && !HeapProfileSampling) {
     // Sampling disabled
     return;
   }
@@ -282,7 +282,7 @@ HeapWord* MemAllocator::allocate_inside_tlab_slow(Allocation& allocation) const
   HeapWord* mem = NULL;
   ThreadLocalAllocBuffer& tlab = _thread->tlab();
 
-  if (JvmtiExport::should_post_sampled_object_alloc()) {
+  if (JvmtiExport::should_post_sampled_object_alloc() || HeapProfileSampling) {
     tlab.set_back_allocation_end();
     mem = tlab.allocate(_word_size);
 
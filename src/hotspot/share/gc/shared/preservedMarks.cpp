@@ -29,7 +29,9 @@
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/stack.inline.hpp"
 
 void PreservedMarks::restore() {
   while (!_stack.is_empty()) {
@@ -92,9 +94,25 @@ void PreservedMarksSet::init(uint num) {
   assert_empty();
 }
 
+// Restores the preserved marks of all stacks. The stacks are cut into
+// chunks of one stack segment each, and workers claim chunks rather than
+// whole stacks, so that a single large stack does not leave one worker
+// with a long serial tail. Once all chunks are done, the destructor
+// releases the stack segments.
 class RestorePreservedMarksTask : public AbstractGangTask {
+  typedef PreservedMarks::OopAndMarkWord OopAndMarkWord;
+
+  struct Chunk {
+    const OopAndMarkWord* _elems;
+    size_t _count;
+
+    Chunk() : _elems(NULL), _count(0) { }
+    Chunk(const OopAndMarkWord* elems, size_t count) : _elems(elems), _count(count) { }
+  };
+
   PreservedMarksSet* const _preserved_marks_set;
-  SequentialSubTasksDone _sub_tasks;
+  GrowableArrayCHeap<Chunk, mtGC> _chunks;
+  volatile int _next_chunk;
   volatile size_t _total_size;
 #ifdef ASSERT
   size_t _total_size_before;
@@ -102,30 +120,49 @@ class RestorePreservedMarksTask : public AbstractGangTask {
 
 public:
   void work(uint worker_id) override {
-    uint task_id = 0;
-    while (_sub_tasks.try_claim_task(task_id)) {
-      _preserved_marks_set->get(task_id)->restore_and_increment(&_total_size);
+    size_t restored = 0;
+    for (int i = Atomic::fetch_and_add(&_next_chunk, 1);
+         i < _chunks.length();
+         i = Atomic::fetch_and_add(&_next_chunk, 1)) {
+      const Chunk& chunk = _chunks.at(i);
+      for (size_t j = 0; j < chunk._count; j++) {
+        chunk._elems[j].set_mark();
+      }
+      restored += chunk._count;
+    }
+    // Only do the atomic add if the size is > 0.
+    if (restored > 0) {
+      Atomic::add(&_total_size, restored);
     }
   }
 
   RestorePreservedMarksTask(PreservedMarksSet* preserved_marks_set)
     : AbstractGangTask("Restore Preserved Marks"),
       _preserved_marks_set(preserved_marks_set),
-      _sub_tasks(preserved_marks_set->num()),
+      _chunks(),
+      _next_chunk(0),
       _total_size(0)
       DEBUG_ONLY(COMMA _total_size_before(0)) {
-#ifdef ASSERT
-    // This is to make sure the total_size we'll calculate below is correct.
     for (uint i = 0; i < _preserved_marks_set->num(); ++i) {
-      _total_size_before += _preserved_marks_set->get(i)->size();
+      PreservedMarks* pm = _preserved_marks_set->get(i);
+      DEBUG_ONLY(_total_size_before += pm->size();)
+      StackIterator<OopAndMarkWord, mtGC> iter(pm->_stack);
+      while (!iter.is_empty()) {
+        size_t count;
+        const OopAndMarkWord* elems = iter.next_segment(count);
+        _chunks.append(Chunk(elems, count));
+      }
     }
-#endif // ASSERT
   }
 
   ~RestorePreservedMarksTask() {
     assert(_total_size == _total_size_before, "total_size = %zu before = %zu", _total_size, _total_size_before);
 
-    log_trace(gc)("Restored %zu marks", _total_size);
+    for (uint i = 0; i < _preserved_marks_set->num(); ++i) {
+      _preserved_marks_set->get(i)->_stack.clear(true /* clear_cache */);
+    }
+
+    log_trace(gc)("Restored %zu marks in %d chunks", _total_size, _chunks.length());
   }
 };
 
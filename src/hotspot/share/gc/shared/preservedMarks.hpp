@@ -35,6 +35,7 @@ class PreservedMarksSet;
 class WorkGang;
 
 class PreservedMarks {
+  friend class RestorePreservedMarksTask;
 private:
   class OopAndMarkWord {
   private:
@@ -1233,12 +1233,32 @@ void ReferenceProcessor::preclean_discovered_references(BoolObjectClosure* is_al
   }
 }
 
+void ReferenceProcessor::preclean_discovered_references(uint               owner,
+                                                        uint               stride,
+                                                        BoolObjectClosure* is_alive,
+                                                        OopClosure*        keep_alive,
+                                                        VoidClosure*       complete_gc,
+                                                        YieldClosure*      yield) {
+  assert(owner < stride, "owner %u out of range %u", owner, stride);
+  for (int type = 0; type < number_of_subclasses_of_ref(); type++) {
+    for (uint i = owner; i < _max_num_queues; i += stride) {
+      if (yield->should_return()) {
+        return;
+      }
+      if (preclean_discovered_reflist(_discovered_refs[type * _max_num_queues + i],
+                                      is_alive, keep_alive, complete_gc, yield)) {
+        return;
+      }
+    }
+  }
+}
+
 // Walk the given discovered ref list, and remove all reference objects
 // whose referents are still alive, whose referents are NULL or which
 // are not active (have a non-NULL next field). NOTE: When we are
-// thus precleaning the ref lists (which happens single-threaded today),
-// we do not disable refs discovery to honor the correct semantics of
-// java.lang.Reference. As a result, we need to be careful below
+// thus precleaning the ref lists (which happens in a single thread per
+// list), we do not disable refs discovery to honor the correct semantics
+// of java.lang.Reference. As a result, we need to be careful below
 // that ref removal steps interleave safely with ref discovery steps
 // (in this thread).
 bool ReferenceProcessor::preclean_discovered_reflist(DiscoveredList&    refs_list,
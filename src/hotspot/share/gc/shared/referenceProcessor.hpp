@@ -315,6 +315,18 @@ public:
                                       YieldClosure*      yield,
                                       GCTimer*           gc_timer);
 
+  // Parallel variant of the above. Precleans the discovered lists of every
+  // reference type whose index is congruent to owner modulo stride. With
+  // MT discovery, references discovered by the thread with id owner go to
+  // lists that owner precleans itself, so several owners running at once
+  // only interleave removal and discovery within their own lists.
+  void preclean_discovered_references(uint               owner,
+                                      uint               stride,
+                                      BoolObjectClosure* is_alive,
+                                      OopClosure*        keep_alive,
+                                      VoidClosure*       complete_gc,
+                                      YieldClosure*      yield);
+
 private:
   // Returns the name of the discovered reference list
   // occupying the i / _num_queues slot.
@@ -188,20 +188,33 @@ void SATBMarkQueueSet::set_active_all_threads(bool active, bool expected_active)
   class SetThreadActiveClosure : public ThreadClosure {
     SATBMarkQueueSet* _qset;
     bool _active;
+    size_t _released;
   public:
     SetThreadActiveClosure(SATBMarkQueueSet* qset, bool active) :
-      _qset(qset), _active(active) {}
+      _qset(qset), _active(active), _released(0) {}
     virtual void do_thread(Thread* t) {
       SATBMarkQueue& queue = _qset->satb_queue_for_thread(t);
       if (queue.buffer() != nullptr) {
         assert(!_active || queue.index() == _qset->buffer_size(),
                "queues should be empty when activated");
         queue.set_index(_qset->buffer_size());
+        if (!_active) {
+          // Inactive queues don't enqueue, so give the buffer back. A
+          // thread that runs during the next marking allocates a new
+          // one; threads that stay idle don't hold on to one.
+          _qset->flush_queue(queue);
+          _released++;
+        }
       }
       queue.set_active(_active);
     }
+    size_t released() const { return _released; }
   } closure(this, active);
   Threads::threads_do(&closure);
+
+  if (closure.released() > 0) {
+    allocator()->reduce_free_list(closure.released());
+  }
 }
 
 bool SATBMarkQueueSet::apply_closure_to_completed_buffer(SATBBufferClosure* cl) {
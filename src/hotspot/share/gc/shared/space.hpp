@@ -706,6 +706,9 @@ class OffsetTableContigSpace: public ContiguousSpace {
   virtual inline HeapWord* allocate(size_t word_size);
   inline HeapWord* par_allocate(size_t word_size);
 
+  // Offset table update for a block filled in by other means than allocation.
+  void alloc_block(HeapWord* start, HeapWord* end) { _offsets.alloc_block(start, end); }
+
   // MarkSweep support phase3
   virtual HeapWord* initialize_threshold();
   virtual HeapWord* cross_threshold(HeapWord* start, HeapWord* end);
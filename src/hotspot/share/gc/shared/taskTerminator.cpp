@@ -32,7 +32,8 @@
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.hpp"
 
-TaskTerminator::DelayContext::DelayContext() {
+TaskTerminator::DelayContext::DelayContext(uint spin_limit) {
+  _spin_limit = spin_limit;
   _yield_count = 0;
   reset_hard_spin_information();
 }
@@ -43,11 +44,11 @@ void TaskTerminator::DelayContext::reset_hard_spin_information() {
 }
 
 bool TaskTerminator::DelayContext::needs_sleep() const {
-  return _yield_count >= WorkStealingYieldsBeforeSleep;
+  return _yield_count >= _spin_limit;
 }
 
 void TaskTerminator::DelayContext::do_step() {
-  assert(_yield_count < WorkStealingYieldsBeforeSleep, "Number of yields too large");
+  assert(_yield_count < _spin_limit, "Number of yields too large");
   // Each spin iteration is counted as a yield for purposes of
   // deciding when to sleep.
   _yield_count++;
@@ -73,7 +74,8 @@ TaskTerminator::TaskTerminator(uint n_threads, TaskQueueSetSuper* queue_set) :
   _queue_set(queue_set),
   _offered_termination(0),
   _blocker(Mutex::leaf, "TaskTerminator", false, Monitor::_safepoint_check_never),
-  _spin_master(NULL) { }
+  _spin_master(NULL),
+  _avg_spin_steps((uint)WorkStealingYieldsBeforeSleep) { }
 
 TaskTerminator::~TaskTerminator() {
   if (_offered_termination != 0) {
@@ -103,6 +105,24 @@ void TaskTerminator::reset_for_reuse(uint n_threads) {
   _n_threads = n_threads;
 }
 
+uint TaskTerminator::spin_limit() const {
+  const uint max_limit = (uint)WorkStealingYieldsBeforeSleep;
+  if (!WorkStealingAdaptiveSpin) {
+    return max_limit;
+  }
+  // Spin for twice as long as it recently took for work to show up, but
+  // never less than a floor that grows with the number of workers: the
+  // more workers there are, the more likely one of them is about to push
+  // work, and the more a premature sleep costs.
+  const uint min_limit = MIN2(max_limit, 16 * _n_threads);
+  return clamp(2 * _avg_spin_steps, min_limit, max_limit);
+}
+
+void TaskTerminator::record_spin_success(uint steps) {
+  assert(_blocker.owned_by_self(), "must be");
+  _avg_spin_steps = (_avg_spin_steps * 7 + steps) / 8;
+}
+
 bool TaskTerminator::exit_termination(size_t tasks, TerminatorTerminator* terminator) {
   return tasks > 0 || (terminator != NULL && terminator->should_exit_termination());
 }
@@ -154,7 +174,7 @@ bool TaskTerminator::offer_termination(TerminatorTerminator* terminator) {
   for (;;) {
     if (_spin_master == NULL) {
       _spin_master = the_thread;
-      DelayContext delay_context;
+      DelayContext delay_context(spin_limit());
 
       while (!delay_context.needs_sleep()) {
         size_t tasks;
@@ -173,6 +193,7 @@ bool TaskTerminator::offer_termination(TerminatorTerminator* terminator) {
           assert_queue_set_empty();
           return true;
         } else if (should_exit_termination) {
+          record_spin_success(delay_context.steps());
           prepare_for_return(the_thread, tasks);
           _offered_termination--;
           return false;
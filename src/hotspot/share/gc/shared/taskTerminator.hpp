@@ -50,9 +50,17 @@ class Thread;
  * threads to compete for the role.
  * The intention of above enhancement is to reduce spin-master's latency on
  * detecting new tasks for stealing and termination condition.
+ *
+ * Note: all workers offer termination to this one terminator, also on
+ * multi-socket machines. A hierarchy of per-socket sub-terminators, that
+ * would keep most termination traffic on the local socket, is not
+ * implemented. It needs a worker to socket mapping that the work gangs do
+ * not provide. WorkStealingAdaptiveSpin only shortens the spinning.
  */
 class TaskTerminator : public CHeapObj<mtGC> {
   class DelayContext {
+    // Number of delay steps after which the caller should sleep.
+    uint _spin_limit;
     uint _yield_count;
     // Number of hard spin loops done since last yield
     uint _hard_spin_count;
@@ -61,12 +69,14 @@ class TaskTerminator : public CHeapObj<mtGC> {
 
     void reset_hard_spin_information();
   public:
-    DelayContext();
+    DelayContext(uint spin_limit);
 
     // Should the caller sleep (wait) or perform a spin step?
     bool needs_sleep() const;
     // Perform one delay iteration.
     void do_step();
+    // Number of delay iterations performed so far.
+    uint steps() const { return _yield_count; }
   };
 
   uint _n_threads;
@@ -79,6 +89,11 @@ class TaskTerminator : public CHeapObj<mtGC> {
   Monitor _blocker;
   Thread* _spin_master;
 
+  // Decaying average of the number of delay steps the spin master needed
+  // before it observed new work. Only used with WorkStealingAdaptiveSpin,
+  // protected by _blocker.
+  uint _avg_spin_steps;
+
   void assert_queue_set_empty() const NOT_DEBUG_RETURN;
 
   // Prepare for return from offer_termination. Gives up the spin master token
@@ -94,6 +109,11 @@ class TaskTerminator : public CHeapObj<mtGC> {
   // Perform one iteration of spin-master work.
   void do_delay_step(DelayContext& delay_context);
 
+  // Number of delay steps the spin master performs before it sleeps.
+  uint spin_limit() const;
+  // Record that the spin master found work after the given number of steps.
+  void record_spin_success(uint steps);
+
   NONCOPYABLE(TaskTerminator);
 
 public:
@@ -374,7 +374,11 @@ private:
   // Element array.
   E* _elems;
 
-  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(E*));
+  // NUMA node the owner last stole on, or -1 if unknown. Written by the
+  // owner, read racily by thieves choosing a victim.
+  volatile int _numa_node;
+
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(E*) + sizeof(int));
   // Queue owner local variables. Not to be accessed by other threads.
 
   static const uint InvalidQueueId = uint(-1);
@@ -390,10 +394,13 @@ public:
   uint last_stolen_queue_id() const          { return _last_stolen_queue_id; }
   bool is_last_stolen_queue_id_valid() const { return _last_stolen_queue_id != InvalidQueueId; }
   void invalidate_last_stolen_queue_id()     { _last_stolen_queue_id = InvalidQueueId; }
+
+  int numa_node() const                      { return Atomic::load(&_numa_node); }
+  void set_numa_node(int node)               { Atomic::store(&_numa_node, node); }
 };
 
 template<class E, MEMFLAGS F, unsigned int N>
-GenericTaskQueue<E, F, N>::GenericTaskQueue() : _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */) {
+GenericTaskQueue<E, F, N>::GenericTaskQueue() : _numa_node(-1), _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */) {
   assert(sizeof(Age) == sizeof(size_t), "Depends on this.");
 }
 
@@ -459,7 +466,15 @@ private:
   uint _n;
   T** _queues;
 
+  // Number of random draws used to find a steal victim on the same NUMA
+  // node before settling for a remote one.
+  static const uint NUMAStealProbes = 4;
+  // Upper bound on the number of extra tasks moved by one bulk steal.
+  static const uint MaxBulkSteal = 64;
+
   bool steal_best_of_2(uint queue_num, E& t);
+  uint select_victim(uint queue_num, uint exclude);
+  void steal_bulk(uint queue_num, uint victim);
 
 public:
   GenericTaskQueueSet(uint n);
@@ -473,6 +488,9 @@ public:
 
   // Try to steal a task from some other queue than queue_num. It may perform several attempts at doing so.
   // Returns if stealing succeeds, and sets "t" to the stolen task.
+  // With TaskQueueBulkSteal, a successful steal also moves part of the
+  // victim's remaining tasks into queue_num, so queue_num must be the
+  // queue of the calling worker.
   bool steal(uint queue_num, E& t);
 
   DEBUG_ONLY(virtual void assert_empty() const;)
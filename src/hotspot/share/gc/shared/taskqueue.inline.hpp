@@ -27,10 +27,13 @@
 
 #include "gc/shared/taskqueue.hpp"
 
+#include "gc/shared/gc_globals.hpp"
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/stack.inline.hpp"
 
@@ -266,6 +269,48 @@ int GenericTaskQueue<E, F, N>::next_random_queue_id() {
   return randomParkAndMiller(&_seed);
 }
 
+// Select a random queue other than queue_num and exclude. With
+// TaskQueueNUMASteal, up to NUMAStealProbes candidates are drawn and the
+// first one whose owner is on the same node as queue_num is taken.
+template<class T, MEMFLAGS F> uint
+GenericTaskQueueSet<T, F>::select_victim(uint queue_num, uint exclude) {
+  T* const local_queue = _queues[queue_num];
+  const int local_node = TaskQueueNUMASteal ? local_queue->numa_node() : -1;
+  uint k = queue_num;
+  for (uint probe = 0; probe < NUMAStealProbes; probe++) {
+    k = queue_num;
+    while (k == queue_num || k == exclude) {
+      k = local_queue->next_random_queue_id() % _n;
+    }
+    if (local_node == -1 || _queues[k]->numa_node() == local_node) {
+      break;
+    }
+  }
+  return k;
+}
+
+// Move up to half of the tasks left in the victim to queue_num, one
+// pop_global at a time. Each move is a separate CAS on the victim's age;
+// a single CAS claiming several elements would race with the owner's
+// pop_local fast path, which only tolerates one concurrent steal.
+template<class T, MEMFLAGS F> void
+GenericTaskQueueSet<T, F>::steal_bulk(uint queue_num, uint victim) {
+  T* const local_queue = _queues[queue_num];
+  T* const victim_queue = _queues[victim];
+  const uint space = local_queue->max_elems() - local_queue->size();
+  const uint n = MIN3(victim_queue->size() / 2, space, MaxBulkSteal);
+  for (uint i = 0; i < n; i++) {
+    E t;
+    if (!victim_queue->pop_global(t)) {
+      break;
+    }
+    TASKQUEUE_STATS_ONLY(local_queue->stats.record_steal_attempt());
+    TASKQUEUE_STATS_ONLY(local_queue->stats.record_steal());
+    bool pushed = local_queue->push(t);
+    assert(pushed, "space was checked above");
+  }
+}
+
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
   if (_n > 2) {
@@ -276,15 +321,10 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
       k1 = local_queue->last_stolen_queue_id();
       assert(k1 != queue_num, "Should not be the same");
     } else {
-      while (k1 == queue_num) {
-        k1 = local_queue->next_random_queue_id() % _n;
-      }
+      k1 = select_victim(queue_num, queue_num);
     }
 
-    uint k2 = queue_num;
-    while (k2 == queue_num || k2 == k1) {
-      k2 = local_queue->next_random_queue_id() % _n;
-    }
+    uint k2 = select_victim(queue_num, k1);
     // Sample both and try the larger.
     uint sz1 = _queues[k1]->size();
     uint sz2 = _queues[k2]->size();
@@ -302,6 +342,9 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
 
     if (suc) {
       local_queue->set_last_stolen_queue_id(sel_k);
+      if (TaskQueueBulkSteal) {
+        steal_bulk(queue_num, sel_k);
+      }
     } else {
       local_queue->invalidate_last_stolen_queue_id();
     }
@@ -310,7 +353,11 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
-    return _queues[k]->pop_global(t);
+    bool suc = _queues[k]->pop_global(t);
+    if (suc && TaskQueueBulkSteal) {
+      steal_bulk(queue_num, k);
+    }
+    return suc;
   } else {
     assert(_n == 1, "can't be zero.");
     return false;
@@ -319,6 +366,9 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
 
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
+  if (TaskQueueNUMASteal && UseNUMA) {
+    queue(queue_num)->set_numa_node(os::numa_get_group_id());
+  }
   for (uint i = 0; i < 2 * _n; i++) {
     TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal_attempt());
     if (steal_best_of_2(queue_num, t)) {
@@ -56,6 +56,9 @@ ThreadLocalAllocBuffer::ThreadLocalAllocBuffer() :
   _gc_waste(0),
   _slow_allocations(0),
   _allocated_size(0),
+  _total_refills(0),
+  _total_refill_waste(0),
+  _total_slow_allocations(0),
   _allocation_fraction(TLABAllocationWeight) {
 
   // do nothing. TLABs must be inited by initialize() calls
@@ -85,23 +88,27 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
 
   print_stats("gc");
 
-  if (_number_of_refills > 0) {
-    // Update allocation history if a reasonable amount of eden was allocated.
-    bool update_allocation_history = used > 0.5 * capacity;
-
-    if (update_allocation_history) {
-      // Average the fraction of eden allocated in a tlab by this
-      // thread for use in the next resize operation.
-      // _gc_waste is not subtracted because it's included in
-      // "used".
-      // The result can be larger than 1.0 due to direct to old allocations.
-      // These allocations should ideally not be counted but since it is not possible
-      // to filter them out here we just cap the fraction to be at most 1.0.
-      // Keep alloc_frac as float and not double to avoid the double to float conversion
-      float alloc_frac = MIN2(1.0f, allocated_since_last_gc / (float) used);
-      _allocation_fraction.sample(alloc_frac);
-    }
+  // Update allocation history if a reasonable amount of eden was allocated.
+  bool update_allocation_history = used > 0.5 * capacity;
+
+  if (update_allocation_history) {
+    // Average the fraction of eden allocated in a tlab by this
+    // thread for use in the next resize operation.
+    // _gc_waste is not subtracted because it's included in
+    // "used".
+    // The result can be larger than 1.0 due to direct to old allocations.
+    // These allocations should ideally not be counted but since it is not possible
+    // to filter them out here we just cap the fraction to be at most 1.0.
+    // This is also done for threads that did not refill since the last GC,
+    // so that the desired size of idle threads decays instead of keeping
+    // the size from their last busy period, which would mostly be wasted
+    // on their next allocation.
+    // Keep alloc_frac as float and not double to avoid the double to float conversion
+    float alloc_frac = MIN2(1.0f, allocated_since_last_gc / (float) used);
+    _allocation_fraction.sample(alloc_frac);
+  }
 
+  if (_number_of_refills > 0) {
     stats->update_fast_allocations(_number_of_refills,
                                    _allocated_size,
                                    _gc_waste,
@@ -149,6 +156,7 @@ void ThreadLocalAllocBuffer::retire(ThreadLocalAllocStats* stats) {
 
 void ThreadLocalAllocBuffer::retire_before_allocation() {
   _refill_waste += (unsigned int)remaining();
+  _total_refill_waste += remaining();
   retire();
 }
 
@@ -184,6 +192,7 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
                                   HeapWord* top,
                                   size_t    new_size) {
   _number_of_refills++;
+  _total_refills++;
   _allocated_size += new_size;
   print_stats("fill");
   assert(top <= start + new_size - alignment_reserve(), "size too small");
@@ -26,6 +26,7 @@
 #define SHARE_GC_SHARED_THREADLOCALALLOCBUFFER_HPP
 
 #include "gc/shared/gcUtil.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/perfDataTypes.hpp"
 #include "utilities/align.hpp"
 #include "utilities/sizes.hpp"
@@ -68,6 +69,10 @@ private:
   unsigned  _slow_allocations;
   size_t    _allocated_size;
 
+  size_t    _total_refills;                      // like the above, but not reset at GC
+  size_t    _total_refill_waste;
+  size_t    _total_slow_allocations;
+
   AdaptiveWeightedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
 
   void reset_statistics();
@@ -111,6 +116,13 @@ private:
 public:
   ThreadLocalAllocBuffer();
 
+  // Statistics since the thread started. They are never reset, and are
+  // updated only by the owning thread, so that other threads can sample
+  // them without synchronization. The waste figure is in words.
+  size_t total_refills() const                   { return Atomic::load(&_total_refills); }
+  size_t total_slow_allocations() const          { return Atomic::load(&_total_slow_allocations); }
+  size_t total_refill_waste() const              { return Atomic::load(&_total_refill_waste); }
+
   static size_t min_size();
   static size_t max_size()                       { assert(_max_size != 0, "max_size not set up"); return _max_size; }
   static size_t max_size_in_bytes()              { return max_size() * BytesPerWord; }
@@ -29,6 +29,7 @@
 #include "gc/shenandoah/shenandoahFreeSet.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahHeapRegion.inline.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 #include "logging/logTag.hpp"
 #include "utilities/quickSort.hpp"
@@ -54,11 +55,16 @@ const double ShenandoahAdaptiveHeuristics::HIGHEST_EXPECTED_AVAILABLE_AT_END = 0
 const double ShenandoahAdaptiveHeuristics::MINIMUM_CONFIDENCE = 0.319; // 25%
 const double ShenandoahAdaptiveHeuristics::MAXIMUM_CONFIDENCE = 3.291; // 99.9%
 
+// A handful of cycles is enough to notice that recent cycles take longer
+// than the long term average suggests.
+const int ShenandoahAdaptiveHeuristics::SHORT_CYCLE_WINDOW = 3;
+
 ShenandoahAdaptiveHeuristics::ShenandoahAdaptiveHeuristics() :
   ShenandoahHeuristics(),
   _margin_of_error_sd(ShenandoahAdaptiveInitialConfidence),
   _spike_threshold_sd(ShenandoahAdaptiveInitialSpikeThreshold),
-  _last_trigger(OTHER) { }
+  _last_trigger(OTHER),
+  _gc_time_short(SHORT_CYCLE_WINDOW, ShenandoahAdaptiveDecayFactor) { }
 
 ShenandoahAdaptiveHeuristics::~ShenandoahAdaptiveHeuristics() {}
 
@@ -128,6 +134,8 @@ void ShenandoahAdaptiveHeuristics::record_cycle_start() {
 void ShenandoahAdaptiveHeuristics::record_success_concurrent() {
   ShenandoahHeuristics::record_success_concurrent();
 
+  _gc_time_short.add(time_since_last_gc());
+
   size_t available = ShenandoahHeap::heap()->free_set()->available();
 
   _available.add(available);
@@ -257,9 +265,29 @@ bool ShenandoahAdaptiveHeuristics::should_start_gc() {
                        byte_size_in_proper_unit(allocation_headroom), proper_unit_for_byte_size(allocation_headroom));
 
     _last_trigger = RATE;
+    send_trigger_event(RATE, available, allocation_headroom, avg_cycle_time, avg_alloc_rate);
     return true;
   }
 
+  // The long window smooths out short bursts of allocation, e.g. when new
+  // traffic arrives. Check the upper confidence bound of the short window
+  // against the longer of the average and the recent cycle times.
+  double short_alloc_rate = _allocation_rate.short_upper_bound(_margin_of_error_sd);
+  if (short_alloc_rate > 0 && _gc_time_short.num() > 0) {
+    double short_cycle_time = _gc_time_short.avg() + (_margin_of_error_sd * _gc_time_short.sd());
+    double cycle_time = MAX2(avg_cycle_time, short_cycle_time);
+    if (cycle_time > allocation_headroom / short_alloc_rate) {
+      log_info(gc)("Trigger: Recent GC time (%.2f ms) is above the time for recent allocation rate (%.0f %sB/s) to deplete free headroom (" SIZE_FORMAT "%s) (margin of error = %.2f)",
+                   cycle_time * 1000,
+                   byte_size_in_proper_unit(short_alloc_rate), proper_unit_for_byte_size(short_alloc_rate),
+                   byte_size_in_proper_unit(allocation_headroom), proper_unit_for_byte_size(allocation_headroom),
+                   _margin_of_error_sd);
+      _last_trigger = BURST;
+      send_trigger_event(BURST, available, allocation_headroom, cycle_time, short_alloc_rate);
+      return true;
+    }
+  }
+
   bool is_spiking = _allocation_rate.is_spiking(rate, _spike_threshold_sd);
   if (is_spiking && avg_cycle_time > allocation_headroom / rate) {
     log_info(gc)("Trigger: Average GC time (%.2f ms) is above the time for instantaneous allocation rate (%.0f %sB/s) to deplete free headroom (" SIZE_FORMAT "%s) (spike threshold = %.2f)",
@@ -268,6 +296,7 @@ bool ShenandoahAdaptiveHeuristics::should_start_gc() {
                  byte_size_in_proper_unit(allocation_headroom), proper_unit_for_byte_size(allocation_headroom),
                  _spike_threshold_sd);
     _last_trigger = SPIKE;
+    send_trigger_event(SPIKE, available, allocation_headroom, avg_cycle_time, rate);
     return true;
   }
 
@@ -277,6 +306,8 @@ bool ShenandoahAdaptiveHeuristics::should_start_gc() {
 void ShenandoahAdaptiveHeuristics::adjust_last_trigger_parameters(double amount) {
   switch (_last_trigger) {
     case RATE:
+    case BURST:
+      // Both triggers use the margin of error as their confidence bound
       adjust_margin_of_error(amount);
       break;
     case SPIKE:
@@ -300,12 +331,44 @@ void ShenandoahAdaptiveHeuristics::adjust_spike_threshold(double amount) {
   log_debug(gc, ergo)("Spike threshold now: %.2f", _spike_threshold_sd);
 }
 
+const char* ShenandoahAdaptiveHeuristics::trigger_name(Trigger trigger) {
+  switch (trigger) {
+    case SPIKE:
+      return "Spike";
+    case RATE:
+      return "Rate";
+    case BURST:
+      return "Burst";
+    case OTHER:
+      return "Other";
+    default:
+      ShouldNotReachHere();
+      return NULL;
+  }
+}
+
+void ShenandoahAdaptiveHeuristics::send_trigger_event(Trigger trigger, size_t available, size_t allocation_headroom,
+                                                      double cycle_time, double alloc_rate) const {
+  EventShenandoahAdaptiveTrigger e;
+  if (e.should_commit()) {
+    e.set_trigger(trigger_name(trigger));
+    e.set_available(available);
+    e.set_allocationHeadroom(allocation_headroom);
+    e.set_cycleTime((s8)(cycle_time * NANOSECS_PER_SEC));
+    e.set_allocationRate(alloc_rate);
+    e.set_marginOfError(_margin_of_error_sd);
+    e.set_spikeThreshold(_spike_threshold_sd);
+    e.commit();
+  }
+}
+
 ShenandoahAllocationRate::ShenandoahAllocationRate() :
   _last_sample_time(os::elapsedTime()),
   _last_sample_value(0),
   _interval_sec(1.0 / ShenandoahAdaptiveSampleFrequencyHz),
   _rate(int(ShenandoahAdaptiveSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz), ShenandoahAdaptiveDecayFactor),
-  _rate_avg(int(ShenandoahAdaptiveSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz), ShenandoahAdaptiveDecayFactor) {
+  _rate_avg(int(ShenandoahAdaptiveSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz), ShenandoahAdaptiveDecayFactor),
+  _rate_short(MAX2(int(ShenandoahAdaptiveShortSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz), 1), ShenandoahAdaptiveDecayFactor) {
 }
 
 double ShenandoahAllocationRate::sample(size_t allocated) {
@@ -316,6 +379,7 @@ double ShenandoahAllocationRate::sample(size_t allocated) {
       rate = instantaneous_rate(now, allocated);
       _rate.add(rate);
       _rate_avg.add(_rate.avg());
+      _rate_short.add(rate);
     }
 
     _last_sample_time = now;
@@ -332,6 +396,17 @@ double ShenandoahAllocationRate::upper_bound(double sds) const {
   return _rate.davg() + (sds * _rate_avg.dsd());
 }
 
+double ShenandoahAllocationRate::short_upper_bound(double sds) const {
+  if (ShenandoahAdaptiveShortSampleSizeSeconds == 0 || _rate_short.num() < 2) {
+    // Disabled, or not enough samples to have a meaningful deviation
+    return 0.0;
+  }
+
+  // Unlike the long window, this uses the deviation of the samples
+  // themselves, since it is meant to capture the variance of bursts.
+  return _rate_short.avg() + (sds * _rate_short.sd());
+}
+
 void ShenandoahAllocationRate::allocation_counter_reset() {
   _last_sample_time = os::elapsedTime();
   _last_sample_value = 0;
@@ -38,6 +38,7 @@ class ShenandoahAllocationRate : public CHeapObj<mtGC> {
 
   double instantaneous_rate(size_t allocated) const;
   double upper_bound(double sds) const;
+  double short_upper_bound(double sds) const;
   bool is_spiking(double rate, double threshold) const;
 
  private:
@@ -49,6 +50,10 @@ class ShenandoahAllocationRate : public CHeapObj<mtGC> {
   double _interval_sec;
   TruncatedSeq _rate;
   TruncatedSeq _rate_avg;
+
+  // Samples over the short window, used to react to allocation bursts
+  // faster than the long moving average does.
+  TruncatedSeq _rate_short;
 };
 
 class ShenandoahAdaptiveHeuristics : public ShenandoahHeuristics {
@@ -85,6 +90,9 @@ public:
   const static double LOWEST_EXPECTED_AVAILABLE_AT_END;
   const static double HIGHEST_EXPECTED_AVAILABLE_AT_END;
 
+  // Number of recent cycles in the short window of cycle times.
+  const static int SHORT_CYCLE_WINDOW;
+
   friend class ShenandoahAllocationRate;
 
   // Used to record the last trigger that signaled to start a GC.
@@ -92,13 +100,18 @@ public:
   // error for the average cycle time and allocation rate or the allocation
   // spike detection threshold.
   enum Trigger {
-    SPIKE, RATE, OTHER
+    SPIKE, RATE, BURST, OTHER
   };
 
+  static const char* trigger_name(Trigger trigger);
+
   void adjust_last_trigger_parameters(double amount);
   void adjust_margin_of_error(double amount);
   void adjust_spike_threshold(double amount);
 
+  void send_trigger_event(Trigger trigger, size_t available, size_t allocation_headroom,
+                          double cycle_time, double alloc_rate) const;
+
   ShenandoahAllocationRate _allocation_rate;
 
   // The margin of error expressed in standard deviations to add to our
@@ -126,6 +139,11 @@ public:
   // establishes what is 'normal' for the application and is used as a
   // source of feedback to adjust trigger parameters.
   TruncatedSeq _available;
+
+  // Durations of the most recent concurrent cycles. Together with the short
+  // window of allocation rates, this is used to start a cycle when a burst
+  // of allocations would deplete the headroom before the cycle finishes.
+  TruncatedSeq _gc_time_short;
 };
 
 #endif // SHARE_GC_SHENANDOAH_HEURISTICS_SHENANDOAHADAPTIVEHEURISTICS_HPP
@@ -78,9 +78,15 @@ HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool&
     case ShenandoahAllocRequest::_alloc_tlab:
     case ShenandoahAllocRequest::_alloc_shared: {
 
-      // Try to allocate in the mutator view
-      for (size_t idx = _mutator_leftmost; idx <= _mutator_rightmost; idx++) {
-        if (is_mutator_free(idx)) {
+      // Try to allocate in the mutator view. Walk the set bits only, so that
+      // runs of non-free regions between the bounds are skipped a bitmap
+      // word at a time.
+      if (_mutator_leftmost <= _mutator_rightmost) {
+        const size_t end = _mutator_rightmost + 1;
+        for (size_t idx = _mutator_free_bitmap.get_next_one_offset(_mutator_leftmost, end);
+             idx < end;
+             idx = _mutator_free_bitmap.get_next_one_offset(idx + 1, end)) {
+          assert(is_mutator_free(idx), "must be");
           HeapWord* result = try_allocate_in(_heap->get_region(idx), req, in_new_region);
           if (result != NULL) {
             return result;
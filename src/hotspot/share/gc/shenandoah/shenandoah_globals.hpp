@@ -136,6 +136,14 @@
           "allocation rate is maintained. The total number of samples "     \
           "is the product of this number and the sample frequency.")        \
                                                                             \
+  product(uintx, ShenandoahAdaptiveShortSampleSizeSeconds, 0, EXPERIMENTAL, \
+          "The size of the short moving window over which the recent "      \
+          "allocation rate is maintained. The upper confidence bound of "   \
+          "the short window reacts to allocation bursts before the long "   \
+          "window does. Zero (the default) disables the short window "      \
+          "trigger.")                                                       \
+          range(0, 60)                                                      \
+                                                                            \
   product(double, ShenandoahAdaptiveInitialConfidence, 1.8, EXPERIMENTAL,   \
           "The number of standard deviations used to determine an initial " \
           "margin of error for the average cycle time and average "         \
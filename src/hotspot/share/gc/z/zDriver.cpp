@@ -240,6 +240,7 @@ void ZDriver::collect(const ZDriverRequest& request) {
   case GCCause::_z_proactive:
   case GCCause::_z_high_usage:
   case GCCause::_metadata_GC_threshold:
+  case GCCause::_codecache_GC_threshold:
     // Start asynchronous GC
     _gc_cycle_port.send_async(request);
     break;
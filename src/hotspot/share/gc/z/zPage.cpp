@@ -35,6 +35,7 @@ ZPage::ZPage(const ZVirtualMemory& vmem, const ZPhysicalMemory& pmem) :
 ZPage::ZPage(uint8_t type, const ZVirtualMemory& vmem, const ZPhysicalMemory& pmem) :
     _type(type),
     _numa_id((uint8_t)-1),
+    _age(0),
     _seqnum(0),
     _virtual(vmem),
     _top(start()),
@@ -62,6 +63,7 @@ void ZPage::reset() {
   _top = start();
   _livemap.reset();
   _last_used = 0;
+  _age = 0;
 }
 
 void ZPage::reset_for_in_place_relocation() {
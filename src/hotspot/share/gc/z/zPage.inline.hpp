@@ -145,6 +145,17 @@ inline uint8_t ZPage::numa_id() {
   return _numa_id;
 }
 
+inline uint8_t ZPage::age() const {
+  return _age;
+}
+
+inline void ZPage::inc_age() {
+  // Saturate at max age
+  if (_age < UINT8_MAX) {
+    _age++;
+  }
+}
+
 inline bool ZPage::is_allocating() const {
   return _seqnum == ZGlobalSeqNum;
 }
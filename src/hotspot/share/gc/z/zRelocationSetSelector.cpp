@@ -49,8 +49,10 @@ ZRelocationSetSelectorGroup::ZRelocationSetSelectorGroup(const char* name,
     _page_size(page_size),
     _object_size_limit(object_size_limit),
     _fragmentation_limit(page_size * (ZFragmentationLimit / 100)),
+    _stable_fragmentation_limit(page_size * (MIN2(ZFragmentationLimit * 2, 100.0) / 100)),
     _live_pages(),
     _forwarding_entries(0),
+    _stable_skipped(0),
     _stats() {}
 
 bool ZRelocationSetSelectorGroup::is_disabled() {
@@ -157,8 +159,10 @@ void ZRelocationSetSelectorGroup::select_inner() {
   // Update statistics
   _stats._relocate = selected_live_bytes;
 
-  log_trace(gc, reloc)("Relocation Set (%s Pages): %d->%d, %d skipped, " SIZE_FORMAT " forwarding entries",
-                       _name, selected_from, selected_to, npages - selected_from, selected_forwarding_entries);
+  log_trace(gc, reloc)("Relocation Set (%s Pages): %d->%d, %d skipped, " SIZE_FORMAT " stable skipped, "
+                       SIZE_FORMAT " forwarding entries",
+                       _name, selected_from, selected_to, npages - selected_from, _stable_skipped,
+                       selected_forwarding_entries);
 }
 
 void ZRelocationSetSelectorGroup::select() {
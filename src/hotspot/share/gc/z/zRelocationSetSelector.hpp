@@ -70,10 +70,14 @@ private:
   const size_t                     _page_size;
   const size_t                     _object_size_limit;
   const size_t                     _fragmentation_limit;
+  const size_t                     _stable_fragmentation_limit;
   ZArray<ZPage*>                   _live_pages;
   size_t                           _forwarding_entries;
+  size_t                           _stable_skipped;
   ZRelocationSetSelectorGroupStats _stats;
 
+  static bool is_stable(const ZPage* page);
+
   bool is_disabled();
   bool is_selectable();
   void semi_sort();
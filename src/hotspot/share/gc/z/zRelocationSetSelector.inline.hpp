@@ -26,6 +26,7 @@
 
 #include "gc/z/zRelocationSetSelector.hpp"
 
+#include "gc/shared/gc_globals.hpp"
 #include "gc/z/zArray.inline.hpp"
 #include "gc/z/zPage.inline.hpp"
 
@@ -61,16 +62,32 @@ inline const ZRelocationSetSelectorGroupStats& ZRelocationSetSelectorStats::larg
   return _large;
 }
 
+inline bool ZRelocationSetSelectorGroup::is_stable(const ZPage* page) {
+  return ZStablePageAge > 0 && page->age() >= ZStablePageAge;
+}
+
 inline void ZRelocationSetSelectorGroup::register_live_page(ZPage* page) {
   const uint8_t type = page->type();
   const size_t size = page->size();
   const size_t live = page->live_bytes();
   const size_t garbage = size - live;
 
-  if (garbage > _fragmentation_limit) {
+  // Pages whose contents have survived many cycles tend to keep their
+  // live objects, so we require more garbage before relocating them.
+  // This leaves stable pages alone in favor of pages with recently
+  // allocated, quickly dying objects.
+  const bool stable = is_stable(page);
+  const size_t fragmentation_limit = stable ? _stable_fragmentation_limit : _fragmentation_limit;
+
+  if (garbage > fragmentation_limit) {
     _live_pages.append(page);
+  } else if (stable && garbage > _fragmentation_limit) {
+    _stable_skipped++;
   }
 
+  // The page survived another cycle
+  page->inc_age();
+
   _stats._npages++;
   _stats._total += size;
   _stats._live += live;
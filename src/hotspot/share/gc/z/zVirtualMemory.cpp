@@ -177,7 +177,7 @@ bool ZVirtualMemoryManager::reserve(size_t max_capacity) {
 }
 
 void ZVirtualMemoryManager::nmt_reserve(uintptr_t start, size_t size) {
-  MemTracker::record_virtual_memory_reserve((void*)start, size, CALLER_PC);
+  MemTracker::record_virtual_memory_reserve((void*)start, size, CALLER_PC_UNSAMPLED);
   MemTracker::record_virtual_memory_type((void*)start, mtJavaHeap);
 }
 
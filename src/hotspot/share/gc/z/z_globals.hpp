@@ -38,6 +38,13 @@
   product(double, ZFragmentationLimit, 25.0,                                \
           "Maximum allowed heap fragmentation")                             \
                                                                             \
+  product(uint, ZStablePageAge, 0, EXPERIMENTAL,                            \
+          "Number of GC cycles a page must survive without being "          \
+          "relocated before it is considered stable. Stable pages are "     \
+          "only relocated when their fragmentation is twice the "           \
+          "ZFragmentationLimit (0 means disabled)")                         \
+          range(0, 255)                                                     \
+                                                                            \
   product(size_t, ZMarkStackSpaceLimit, 8*G,                                \
           "Maximum number of bytes allocated for mark stacks")              \
           range(32*M, 1024*G)                                               \
@@ -67,6 +67,9 @@ bool Bytecodes::check_must_rewrite(Bytecodes::Code code) {
   case Bytecodes::_lookupswitch:
     return false;  // the rewrite is not done by the interpreter
 
+  case Bytecodes::_iinc:
+    return false;  // only rewritten when followed by a _goto
+
   case Bytecodes::_new:
     // (Could actually look at the class here, but the profit would be small.)
     return false;  // the rewrite is not always done
@@ -515,6 +518,7 @@ void Bytecodes::initialize() {
   def(_fast_iload          , "fast_iload"          , "bi"   , NULL    , T_INT    ,  1, false, _iload);
   def(_fast_iload2         , "fast_iload2"         , "bi_i" , NULL    , T_INT    ,  2, false, _iload);
   def(_fast_icaload        , "fast_icaload"        , "bi_"  , NULL    , T_INT    ,  0, false, _iload);
+  def(_fast_iinc_goto      , "fast_iinc_goto"      , "bic"  , NULL    , T_VOID   ,  0, false, _iinc);
 
   // Faster method invocation.
   def(_fast_invokevfinal   , "fast_invokevfinal"   , "bJJ"  , NULL    , T_ILLEGAL, -1, true, _invokevirtual   );
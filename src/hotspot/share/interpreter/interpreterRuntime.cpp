@@ -54,6 +54,7 @@
 #include "prims/jvmtiExport.hpp"
 #include "prims/methodHandles.hpp"
 #include "prims/nativeLookup.hpp"
+#include "runtime/arguments.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
@@ -886,6 +887,9 @@ void InterpreterRuntime::resolve_invoke(JavaThread* current, Bytecodes::Code byt
       info.resolved_klass(),
       resolved_method,
       info.itable_index());
+    if (ConstantPoolCache::use_interface_ics() && !Arguments::is_dumping_archive()) {
+      pool->cache()->allocate_interface_ics();
+    }
     break;
   default:  ShouldNotReachHere();
   }
@@ -431,12 +431,16 @@ void InterpreterOopMap::resource_copy(OopMapCacheEntry* from) {
 }
 
 inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int bci) const {
-  // We use method->code_size() rather than method->identity_hash() below since
-  // the mark may not be present if a pointer to the method is already reversed.
+  // Methods of the same class often agree on max_locals, code_size and
+  // size_of_parameters, so also hash the Method* itself. Method*s live in
+  // metaspace and do not move while they are in the cache.
+  uintptr_t m = (uintptr_t) method();
   return   ((unsigned int) bci)
          ^ ((unsigned int) method->max_locals()         << 2)
          ^ ((unsigned int) method->code_size()          << 4)
-         ^ ((unsigned int) method->size_of_parameters() << 6);
+         ^ ((unsigned int) method->size_of_parameters() << 6)
+         ^ ((unsigned int) (m >> LogBytesPerWord))
+         ^ ((unsigned int) (m >> (LogBytesPerWord + 5)));
 }
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = NULL;
@@ -500,7 +504,7 @@ void OopMapCache::lookup(const methodHandle& method,
                          int bci,
                          InterpreterOopMap* entry_for) {
   assert(SafepointSynchronize::is_at_safepoint(), "called by GC in a safepoint");
-  int probe = hash_value_for(method, bci);
+  int probe = hash_value_for(method, bci) % _size;
   int i;
   OopMapCacheEntry* entry = NULL;
 
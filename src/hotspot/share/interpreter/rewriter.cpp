@@ -33,6 +33,7 @@
 #include "oops/constantPool.hpp"
 #include "oops/generateOopMap.hpp"
 #include "prims/methodHandles.hpp"
+#include "runtime/arguments.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/handles.inline.hpp"
 
@@ -424,6 +425,11 @@ void Rewriter::scan_method(Thread* thread, Method* method, bool reverse, bool* i
         break;
       }
 
+      case Bytecodes::_fast_iinc_goto : {
+        (*bcp) = Bytecodes::_iinc;
+        break;
+      }
+
       case Bytecodes::_invokespecial  : {
         rewrite_invokespecial(bcp, prefix_length+1, reverse, invokespecial_error);
         break;
@@ -521,6 +527,29 @@ methodHandle Rewriter::rewrite_jsrs(const methodHandle& method, TRAPS) {
   return new_method;
 }
 
+// Fuse the increment of a loop variable with the backward branch that
+// usually follows it. Done after rewrite_jsrs, which may widen or move the
+// goto. Not done for archived methods, which may later run with JVMTI
+// breakpoints (see RewriteFrequentPairs).
+void Rewriter::fuse_iinc_goto(Method* method) {
+#if defined(X86) && !defined(ZERO)
+  if (!RewriteFrequentPairs || Arguments::is_dumping_archive()) {
+    return;
+  }
+  const address code_base = method->code_base();
+  const int code_length = method->code_size();
+  int bc_length;
+  for (int bci = 0; bci < code_length; bci += bc_length) {
+    address bcp = code_base + bci;
+    bc_length = Bytecodes::length_at(method, bcp);
+    if (*bcp == Bytecodes::_iinc && bci + bc_length < code_length &&
+        bcp[bc_length] == Bytecodes::_goto) {
+      (*bcp) = Bytecodes::_fast_iinc_goto;
+    }
+  }
+#endif
+}
+
 void Rewriter::rewrite_bytecodes(TRAPS) {
   assert(_pool->cache() == NULL, "constant pool cache must not be set yet");
 
@@ -632,5 +661,6 @@ Rewriter::Rewriter(InstanceKlass* klass, const constantPoolHandle& cpool, Array<
       // Method might have gotten rewritten.
       methods->at_put(i, m());
     }
+    fuse_iinc_goto(m());
   }
 }
@@ -201,6 +201,7 @@ class Rewriter: public StackObj {
   void restore_bytecodes(Thread* thread);
 
   static methodHandle rewrite_jsrs(const methodHandle& m, TRAPS);
+  static void fuse_iinc_goto(Method* m);
  public:
   // Driver routine:
   static void rewrite(InstanceKlass* klass, TRAPS);
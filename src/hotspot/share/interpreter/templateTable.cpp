@@ -478,6 +478,12 @@ void TemplateTable::initialize() {
   def(Bytecodes::_fast_iload          , ubcp|____|____|____, vtos, itos, fast_iload          ,  _       );
   def(Bytecodes::_fast_iload2         , ubcp|____|____|____, vtos, itos, fast_iload2         ,  _       );
   def(Bytecodes::_fast_icaload        , ubcp|____|____|____, vtos, itos, fast_icaload        ,  _       );
+#ifdef X86
+  def(Bytecodes::_fast_iinc_goto      , ubcp|disp|clvm|____, vtos, vtos, fast_iinc_goto      ,  _       );
+#else
+  // never rewritten to (see Rewriter::scan_method)
+  def(Bytecodes::_fast_iinc_goto      , ____|____|____|____, vtos, vtos, shouldnotreachhere  ,  _       );
+#endif
 
   def(Bytecodes::_fast_invokevfinal   , ubcp|disp|clvm|____, vtos, vtos, fast_invokevfinal   , f2_byte      );
 
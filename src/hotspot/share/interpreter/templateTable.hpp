@@ -137,6 +137,7 @@ class TemplateTable: AllStatic {
   static void fast_iload();
   static void fast_iload2();
   static void fast_icaload();
+  static void fast_iinc_goto();  // x86 only
   static void lload();
   static void fload();
   static void dload();
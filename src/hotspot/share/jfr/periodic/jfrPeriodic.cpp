@@ -59,6 +59,7 @@
 #include "runtime/os_perf.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/sweeper.hpp"
+#include "runtime/synchronizer.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_version.hpp"
 #include "services/classLoadingService.hpp"
@@ -423,6 +424,9 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
   int initial_size = Threads::number_of_threads();
   GrowableArray<jlong> allocated(initial_size);
   GrowableArray<traceid> thread_ids(initial_size);
+  GrowableArray<size_t> refills(initial_size);
+  GrowableArray<size_t> slow_allocations(initial_size);
+  GrowableArray<size_t> refill_waste(initial_size);
   JfrTicks time_stamp = JfrTicks::now();
   JfrJavaThreadIterator iter;
   while (iter.has_next()) {
@@ -430,6 +434,10 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
     assert(jt != NULL, "invariant");
     allocated.append(jt->cooked_allocated_bytes());
     thread_ids.append(JFR_THREAD_ID(jt));
+    const ThreadLocalAllocBuffer& tlab = jt->tlab();
+    refills.append(tlab.total_refills());
+    slow_allocations.append(tlab.total_slow_allocations());
+    refill_waste.append(tlab.total_refill_waste() * HeapWordSize);
   }
 
   // Write allocation statistics to buffer.
@@ -437,6 +445,9 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
     EventThreadAllocationStatistics event(UNTIMED);
     event.set_allocated(allocated.at(i));
     event.set_thread(thread_ids.at(i));
+    event.set_tlabRefills(refills.at(i));
+    event.set_slowAllocations(slow_allocations.at(i));
+    event.set_tlabRefillWaste(refill_waste.at(i));
     event.set_endtime(time_stamp);
     event.commit();
   }
@@ -471,6 +482,15 @@ TRACE_REQUEST_FUNC(JavaThreadStatistics) {
   event.commit();
 }
 
+TRACE_REQUEST_FUNC(ObjectMonitorStatistics) {
+  EventObjectMonitorStatistics event;
+  event.set_inUseCount(ObjectSynchronizer::in_use_list_count());
+  event.set_maxInUseCount(ObjectSynchronizer::in_use_list_max());
+  event.set_inUseCeiling(ObjectSynchronizer::in_use_list_ceiling());
+  event.set_deflatedCount(ObjectSynchronizer::deflated_count_total());
+  event.commit();
+}
+
 TRACE_REQUEST_FUNC(ClassLoadingStatistics) {
   EventClassLoadingStatistics event;
   event.set_loadedClassCount(ClassLoadingService::loaded_class_count());
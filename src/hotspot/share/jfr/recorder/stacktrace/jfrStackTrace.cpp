@@ -239,7 +239,7 @@ void JfrStackTrace::resolve_linenos() const {
 }
 
 bool JfrStackTrace::record_safe(JavaThread* thread, int skip) {
-  assert(thread == Thread::current(), "Thread stack needs to be walkable");
+  assert(thread->is_handshake_safe_for(Thread::current()), "Thread stack needs to be walkable");
   vframeStream vfs(thread, false /* stop_at_java_call_stub */, false /* process_frames */);
   u4 count = 0;
   _reached_root = true;
@@ -26,6 +26,7 @@
 #include "jfr/metadata/jfrSerializer.hpp"
 #include "jfr/recorder/checkpoint/jfrCheckpointWriter.hpp"
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -166,6 +167,26 @@ traceid JfrStackTraceRepository::record(Thread* thread, int skip /* 0 */) {
   return instance().record_for(JavaThread::cast(thread), skip, frames, tl->stackdepth());
 }
 
+// Records the stack trace of a thread other than the current one. The current
+// thread must be executing a handshake operation on its behalf, so that its
+// stack is walkable. The target's own frame buffer may be in use, so a
+// temporary one is allocated.
+traceid JfrStackTraceRepository::record_for_handshakee(JavaThread* thread) {
+  assert(thread != NULL, "invariant");
+  assert(thread->is_handshake_safe_for(Thread::current()), "invariant");
+  if (thread->is_hidden_from_external_view() || thread->jfr_thread_local()->is_excluded()) {
+    return 0;
+  }
+  const u4 max_frames = JfrOptionSet::stackdepth();
+  JfrStackFrame* const frames = JfrCHeapObj::new_array<JfrStackFrame>(max_frames);
+  if (frames == NULL) {
+    return 0;
+  }
+  const traceid id = instance().record_for(thread, 0, frames, max_frames);
+  JfrCHeapObj::free(frames, sizeof(JfrStackFrame) * max_frames);
+  return id;
+}
+
 traceid JfrStackTraceRepository::record_for(JavaThread* thread, int skip, JfrStackFrame *frames, u4 max_frames) {
   JfrStackTrace stacktrace(frames, max_frames);
   return stacktrace.record_safe(thread, skip) ? add(instance(), stacktrace) : 0;
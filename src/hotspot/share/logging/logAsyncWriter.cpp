@@ -27,6 +27,7 @@
 #include "logging/logFileOutput.hpp"
 #include "logging/logHandle.hpp"
 #include "runtime/atomic.hpp"
+#include "utilities/growableArray.hpp"
 
 class AsyncLogWriter::AsyncLogLocker : public StackObj {
  public:
@@ -40,28 +41,32 @@ class AsyncLogWriter::AsyncLogLocker : public StackObj {
   }
 };
 
-void AsyncLogWriter::enqueue_locked(const AsyncLogMessage& msg) {
-  if (_buffer.size() >= _buffer_max_size)  {
+bool AsyncLogWriter::Buffer::push_back(LogFileOutput* output, const LogDecorations& decorations, const char* msg) {
+  const size_t len = strlen(msg);
+  const size_t sz = Message::calc_size(len);
+  if (_pos + sz > _capacity) {
+    return false;
+  }
+  new (_buf + _pos) Message(output, decorations, msg, len);
+  _pos += sz;
+  return true;
+}
+
+void AsyncLogWriter::enqueue_locked(LogFileOutput* output, const LogDecorations& decorations, const char* msg) {
+  if (!_buffer->push_back(output, decorations, msg)) {
     bool p_created;
-    uint32_t* counter = _stats.add_if_absent(msg.output(), 0, &p_created);
+    uint32_t* counter = _stats.add_if_absent(output, 0, &p_created);
     *counter = *counter + 1;
-    // drop the enqueueing message.
-    os::free(msg.message());
+    Atomic::store(&_dropped_total, _dropped_total + 1);
     return;
   }
 
-  assert(_buffer.size() < _buffer_max_size, "_buffer is over-sized.");
-  _buffer.push_back(msg);
   _sem.signal();
 }
 
 void AsyncLogWriter::enqueue(LogFileOutput& output, const LogDecorations& decorations, const char* msg) {
-  AsyncLogMessage m(output, decorations, os::strdup(msg));
-
-  { // critical area
-    AsyncLogLocker locker;
-    enqueue_locked(m);
-  }
+  AsyncLogLocker locker;
+  enqueue_locked(&output, decorations, msg);
 }
 
 // LogMessageBuffer consists of a multiple-part/multiple-line messsage.
@@ -70,79 +75,80 @@ void AsyncLogWriter::enqueue(LogFileOutput& output, LogMessageBuffer::Iterator m
   AsyncLogLocker locker;
 
   for (; !msg_iterator.is_at_end(); msg_iterator++) {
-    AsyncLogMessage m(output, msg_iterator.decorations(), os::strdup(msg_iterator.message()));
-    enqueue_locked(m);
+    enqueue_locked(&output, msg_iterator.decorations(), msg_iterator.message());
   }
 }
 
 AsyncLogWriter::AsyncLogWriter()
   : _lock(1), _sem(0), _io_sem(1),
     _initialized(false),
-    _stats(17 /*table_size*/) {
+    _stats(17 /*table_size*/),
+    _dropped_total(0) {
+  size_t size = AsyncLogBufferSize / 2;
+  _buffer = new Buffer(size);
+  _buffer_staging = new Buffer(size);
+  log_info(logging)("AsyncLogBuffer estimates memory use: " SIZE_FORMAT " bytes", size * 2);
   if (os::create_thread(this, os::asynclog_thread)) {
     _initialized = true;
   } else {
     log_warning(logging, thread)("AsyncLogging failed to create thread. Falling back to synchronous logging.");
   }
-
-  log_info(logging)("The maximum entries of AsyncLogBuffer: " SIZE_FORMAT ", estimated memory use: " SIZE_FORMAT " bytes",
-                    _buffer_max_size, AsyncLogBufferSize);
 }
 
 class AsyncLogMapIterator {
-  AsyncLogBuffer& _logs;
+  GrowableArray<LogFileOutput*>& _outputs;
+  GrowableArray<uint32_t>& _counters;
 
  public:
-  AsyncLogMapIterator(AsyncLogBuffer& logs) :_logs(logs) {}
-  bool do_entry(LogFileOutput* output, uint32_t* counter) {
-    using none = LogTagSetMapping<LogTag::__NO_TAG>;
+  AsyncLogMapIterator(GrowableArray<LogFileOutput*>& outputs, GrowableArray<uint32_t>& counters) :
+    _outputs(outputs), _counters(counters) {}
 
+  bool do_entry(LogFileOutput* output, uint32_t* counter) {
     if (*counter > 0) {
-      LogDecorations decorations(LogLevel::Warning, none::tagset(), output->decorators());
-      stringStream ss;
-      ss.print(UINT32_FORMAT_W(6) " messages dropped due to async logging", *counter);
-      AsyncLogMessage msg(*output, decorations, ss.as_string(true /*c_heap*/));
-      _logs.push_back(msg);
+      _outputs.append(output);
+      _counters.append(*counter);
       *counter = 0;
     }
-
     return true;
   }
 };
 
 void AsyncLogWriter::write() {
-  // Use kind of copy-and-swap idiom here.
-  // Empty 'logs' swaps the content with _buffer.
-  // Along with logs destruction, all processed messages are deleted.
-  //
-  // The operation 'pop_all()' is done in O(1). All I/O jobs are then performed without
-  // lock protection. This guarantees I/O jobs don't block logsites.
-  AsyncLogBuffer logs;
-  bool own_io = false;
+  // Swap the buffers under the lock, then perform all I/O from the staging
+  // buffer without it. This guarantees I/O jobs don't block logsites.
+  ResourceMark rm;
+  GrowableArray<LogFileOutput*> dropped_outputs;
+  GrowableArray<uint32_t> dropped_counters;
+
+  // Only the I/O owner may touch the staging buffer. Acquire it before
+  // the lock, so that logsites never wait for I/O.
+  _io_sem.wait();
 
   { // critical region
     AsyncLogLocker locker;
 
-    _buffer.pop_all(&logs);
-    // append meta-messages of dropped counters
-    AsyncLogMapIterator dropped_counters_iter(logs);
+    Buffer* t = _buffer_staging;
+    _buffer_staging = _buffer;
+    _buffer = t;
+    // collect the dropped counters, they are reported after the messages
+    AsyncLogMapIterator dropped_counters_iter(dropped_outputs, dropped_counters);
     _stats.iterate(&dropped_counters_iter);
-    own_io = _io_sem.trywait();
   }
 
-  LinkedListIterator<AsyncLogMessage> it(logs.head());
-  if (!own_io) {
-    _io_sem.wait();
+  Buffer::Iterator it = _buffer_staging->iterator();
+  while (it.has_next()) {
+    const Message* e = it.next();
+    e->output()->write_blocking(e->decorations(), e->message());
   }
-
-  while (!it.is_empty()) {
-    AsyncLogMessage* e = it.next();
-    char* msg = e->message();
-
-    if (msg != nullptr) {
-      e->output()->write_blocking(e->decorations(), msg);
-      os::free(msg);
-    }
+  _buffer_staging->reset();
+
+  using none = LogTagSetMapping<LogTag::__NO_TAG>;
+  for (int i = 0; i < dropped_outputs.length(); i++) {
+    LogFileOutput* output = dropped_outputs.at(i);
+    LogDecorations decorations(LogLevel::Warning, none::tagset(), output->decorators());
+    stringStream ss;
+    ss.print(UINT32_FORMAT_W(6) " messages dropped due to async logging", dropped_counters.at(i));
+    output->write_blocking(decorations, ss.as_string());
   }
   _io_sem.signal();
 }
@@ -188,3 +194,7 @@ void AsyncLogWriter::flush() {
     _instance->write();
   }
 }
+
+void AsyncLogWriter::print_statistics(outputStream* st) const {
+  st->print_cr("Async logging: " SIZE_FORMAT " messages dropped in total", Atomic::load(&_dropped_total));
+}
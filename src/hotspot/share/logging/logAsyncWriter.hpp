@@ -29,85 +29,9 @@
 #include "logging/logMessageBuffer.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/nonJavaThread.hpp"
+#include "utilities/align.hpp"
 #include "utilities/hashtable.hpp"
-#include "utilities/linkedlist.hpp"
 
-template <typename E, MEMFLAGS F>
-class LinkedListDeque : private LinkedListImpl<E, ResourceObj::C_HEAP, F> {
- private:
-  LinkedListNode<E>* _tail;
-  size_t _size;
-
- public:
-  LinkedListDeque() : _tail(NULL), _size(0) {}
-  void push_back(const E& e) {
-    if (!_tail) {
-      _tail = this->add(e);
-    } else {
-      _tail = this->insert_after(e, _tail);
-    }
-
-    ++_size;
-  }
-
-  // pop all elements to logs.
-  void pop_all(LinkedList<E>* logs) {
-    logs->move(static_cast<LinkedList<E>* >(this));
-    _tail = NULL;
-    _size = 0;
-  }
-
-  void pop_all(LinkedListDeque<E, F>* logs) {
-    logs->_size = _size;
-    logs->_tail = _tail;
-    pop_all(static_cast<LinkedList<E>* >(logs));
-  }
-
-  void pop_front() {
-    LinkedListNode<E>* h = this->unlink_head();
-    if (h == _tail) {
-      _tail = NULL;
-    }
-
-    if (h != NULL) {
-      --_size;
-      this->delete_node(h);
-    }
-  }
-
-  size_t size() const { return _size; }
-
-  const E* front() const {
-    return this->_head == NULL ? NULL : this->_head->peek();
-  }
-
-  const E* back() const {
-    return _tail == NULL ? NULL : _tail->peek();
-  }
-
-  LinkedListNode<E>* head() const {
-    return this->_head;
-  }
-};
-
-class AsyncLogMessage {
-  LogFileOutput& _output;
-  const LogDecorations _decorations;
-  char* _message;
-
-public:
-  AsyncLogMessage(LogFileOutput& output, const LogDecorations& decorations, char* msg)
-    : _output(output), _decorations(decorations), _message(msg) {}
-
-  // placeholder for LinkedListImpl.
-  bool equals(const AsyncLogMessage& o) const { return false; }
-
-  LogFileOutput* output() const { return &_output; }
-  const LogDecorations& decorations() const { return _decorations; }
-  char* message() const { return _message; }
-};
-
-typedef LinkedListDeque<AsyncLogMessage, mtLogging> AsyncLogBuffer;
 typedef KVHashtable<LogFileOutput*, uint32_t, mtLogging> AsyncLogMap;
 
 //
@@ -133,8 +57,86 @@ typedef KVHashtable<LogFileOutput*, uint32_t, mtLogging> AsyncLogMap;
 // times. It is no-op if async logging is not established.
 //
 class AsyncLogWriter : public NonJavaThread {
+  friend class AsyncLogTest_logBuffer_vm_Test;
   class AsyncLogLocker;
 
+  // A Message is a log line together with its output and decorations. It
+  // is variable-sized, the NUL-terminated text directly follows it, so it
+  // only ever lives inside a Buffer:
+  //
+  // |_output|_decorations|"a log line"|pad|_output|_decorations|"next"|pad|...
+  //                                         ^ aligned to alignof(Message)
+  class Message {
+    NONCOPYABLE(Message);
+    ~Message() = delete;
+
+    LogFileOutput* const _output;
+    const LogDecorations _decorations;
+
+   public:
+    Message(LogFileOutput* output, const LogDecorations& decorations, const char* msg, size_t len)
+      : _output(output), _decorations(decorations) {
+      char* text = reinterpret_cast<char*>(this + 1);
+      memcpy(text, msg, len);
+      text[len] = '\0';
+    }
+
+    // The space a Message with a text of message_len characters takes in a Buffer.
+    static size_t calc_size(size_t message_len) {
+      return align_up(sizeof(Message) + message_len + 1, alignof(Message));
+    }
+
+    size_t size() const { return calc_size(strlen(message())); }
+    LogFileOutput* output() const { return _output; }
+    const LogDecorations& decorations() const { return _decorations; }
+    const char* message() const { return reinterpret_cast<const char*>(this + 1); }
+  };
+
+  // A fixed-capacity, contiguous buffer of Messages. Appending copies the
+  // text in place, so enqueueing a message does not allocate.
+  class Buffer : public CHeapObj<mtLogging> {
+    char* const _buf;
+    const size_t _capacity;
+    size_t _pos;
+
+   public:
+    Buffer(size_t capacity) :
+      _buf(NEW_C_HEAP_ARRAY(char, capacity, mtLogging)),
+      _capacity(capacity),
+      _pos(0) {
+      assert(is_aligned(_buf, alignof(Message)), "must be");
+    }
+
+    ~Buffer() {
+      FREE_C_HEAP_ARRAY(char, _buf);
+    }
+
+    // Returns false, and appends nothing, if the message does not fit.
+    bool push_back(LogFileOutput* output, const LogDecorations& decorations, const char* msg);
+
+    void reset()           { _pos = 0; }
+    bool is_empty() const  { return _pos == 0; }
+
+    class Iterator {
+      const Buffer& _buf;
+      size_t _curr;
+
+     public:
+      Iterator(const Buffer& buffer) : _buf(buffer), _curr(0) {}
+
+      bool has_next() const { return _curr < _buf._pos; }
+
+      const Message* next() {
+        assert(has_next(), "sanity check");
+        const Message* msg = reinterpret_cast<const Message*>(_buf._buf + _curr);
+        _curr += msg->size();
+        return msg;
+      }
+    };
+
+    Iterator iterator() const { return Iterator(*this); }
+  };
+
   static AsyncLogWriter* _instance;
   // _lock(1) denotes a critional region.
   Semaphore _lock;
@@ -146,14 +148,16 @@ class AsyncLogWriter : public NonJavaThread {
 
   volatile bool _initialized;
   AsyncLogMap _stats; // statistics for dropped messages
-  AsyncLogBuffer _buffer;
+  volatile size_t _dropped_total;
 
-  // The memory use of each AsyncLogMessage (payload) consists of itself and a variable-length c-str message.
-  // A regular logging message is smaller than vwrite_buffer_size, which is defined in logtagset.cpp
-  const size_t _buffer_max_size = {AsyncLogBufferSize / (sizeof(AsyncLogMessage) + vwrite_buffer_size)};
+  // Logsites append to _buffer. The writer swaps it with _buffer_staging
+  // under the lock and does all I/O from the staging buffer without it.
+  // Each one gets half of AsyncLogBufferSize.
+  Buffer* _buffer;
+  Buffer* _buffer_staging;
 
   AsyncLogWriter();
-  void enqueue_locked(const AsyncLogMessage& msg);
+  void enqueue_locked(LogFileOutput* output, const LogDecorations& decorations, const char* msg);
   void write();
   void run() override;
   void pre_run() override {
@@ -175,6 +179,9 @@ class AsyncLogWriter : public NonJavaThread {
   static AsyncLogWriter* instance();
   static void initialize();
   static void flush();
+
+  // Print the total number of messages dropped because the buffer was full.
+  void print_statistics(outputStream* st) const;
 };
 
 #endif // SHARE_LOGGING_LOGASYNCWRITER_HPP
@@ -507,6 +507,10 @@ void LogConfiguration::describe_current_configuration(outputStream* out) {
     }
     out->cr();
   }
+  AsyncLogWriter* async = AsyncLogWriter::instance();
+  if (async != nullptr) {
+    async->print_statistics(out);
+  }
 }
 
 void LogConfiguration::describe(outputStream* out) {
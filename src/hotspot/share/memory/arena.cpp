@@ -28,6 +28,7 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
@@ -37,11 +38,19 @@
 
 // MT-safe pool of chunks to reduce malloc/free thrashing
 // NB: not using Mutex because pools are used before Threads are initialized
+//
+// Compiler threads and non-Java threads (GC workers etc.) churn through
+// ResourceMarks, and would contend on ThreadCritical. They cache one free
+// chunk per pool in the Thread, which only the owning thread accesses; the
+// global pool is used only when that slot is empty (allocate) or taken
+// (free). A cached chunk counts as checked out, and is not subject to the
+// periodic cleaning of the global pools.
 class ChunkPool: public CHeapObj<mtInternal> {
   Chunk*       _first;        // first cached Chunk; its first word points to next chunk
   size_t       _num_chunks;   // number of unused chunks in pool
   size_t       _num_used;     // number of chunks currently checked out
   const size_t _size;         // size of each chunk (must be uniform)
+  const int    _cache_index;  // index of this pool's slot in Thread::cached_chunks()
 
   // Our four static pools
   static ChunkPool* _large_pool;
@@ -59,13 +68,42 @@ class ChunkPool: public CHeapObj<mtInternal> {
     return c;
   }
 
+  // The chunk cache of the current thread, or NULL if it does not cache chunks.
+  static Chunk** thread_chunk_cache() {
+    Thread* thread = Thread::current_or_null();
+    if (thread == NULL || !thread->chunk_cache_enabled() ||
+        (thread->is_Java_thread() && !thread->is_Compiler_thread())) {
+      return NULL;
+    }
+    return thread->cached_chunks();
+  }
+
+  // Return a chunk to the global pool
+  void free_to_pool(Chunk* chunk) {
+    ThreadCritical tc;
+    _num_used--;
+
+    // Add chunk to list
+    chunk->set_next(_first);
+    _first = chunk;
+    _num_chunks++;
+  }
+
  public:
   // All chunks in a ChunkPool has the same size
-   ChunkPool(size_t size) : _size(size) { _first = NULL; _num_chunks = _num_used = 0; }
+   ChunkPool(size_t size, int cache_index) : _size(size), _cache_index(cache_index) {
+     _first = NULL; _num_chunks = _num_used = 0;
+   }
 
   // Allocate a new chunk from the pool (might expand the pool)
   NOINLINE void* allocate(size_t bytes, AllocFailType alloc_failmode) {
     assert(bytes == _size, "bad size");
+    Chunk** cache = thread_chunk_cache();
+    if (cache != NULL && cache[_cache_index] != NULL) {
+      Chunk* c = cache[_cache_index];
+      cache[_cache_index] = NULL;
+      return c;
+    }
     void* p = NULL;
     // No VM lock can be taken inside ThreadCritical lock, so os::malloc
     // should be done outside ThreadCritical lock due to NMT
@@ -83,13 +121,21 @@ class ChunkPool: public CHeapObj<mtInternal> {
   // Return a chunk to the pool
   void free(Chunk* chunk) {
     assert(chunk->length() + Chunk::aligned_overhead_size() == _size, "bad size");
-    ThreadCritical tc;
-    _num_used--;
+    Chunk** cache = thread_chunk_cache();
+    if (cache != NULL && cache[_cache_index] == NULL) {
+      cache[_cache_index] = chunk;
+      return;
+    }
+    free_to_pool(chunk);
+  }
 
-    // Add chunk to list
-    chunk->set_next(_first);
-    _first = chunk;
-    _num_chunks++;
+  // Return the chunk cached by the given thread, if any, to the global pool
+  void release_cached_chunk(Thread* thread) {
+    Chunk* c = thread->cached_chunks()[_cache_index];
+    if (c != NULL) {
+      thread->cached_chunks()[_cache_index] = NULL;
+      free_to_pool(c);
+    }
   }
 
   // Prune the pool
@@ -129,10 +175,19 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
 
   static void initialize() {
-    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
-    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
-    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
-    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
+    STATIC_ASSERT(Thread::num_cached_chunks == 4);
+    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size(), 0);
+    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size(), 1);
+    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size(), 2);
+    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size(), 3);
+  }
+
+  static void release_thread_cached_chunks(Thread* thread) {
+    thread->set_chunk_cache_enabled(false);
+    _large_pool->release_cached_chunk(thread);
+    _medium_pool->release_cached_chunk(thread);
+    _small_pool->release_cached_chunk(thread);
+    _tiny_pool->release_cached_chunk(thread);
   }
 
   static void clean() {
@@ -226,6 +281,14 @@ void Chunk::next_chop() {
   _next = NULL;
 }
 
+void Chunk::release_thread_cached_chunks(Thread* thread) {
+  ChunkPool::release_thread_cached_chunks(thread);
+}
+
+void Chunk::clean_chunk_pools() {
+  ChunkPool::clean();
+}
+
 void Chunk::start_chunk_pool_cleaner_task() {
 #ifdef ASSERT
   static bool task_created = false;
@@ -85,6 +85,13 @@ class Chunk: CHeapObj<mtChunk> {
 
   // Start the chunk_pool cleaner task
   static void start_chunk_pool_cleaner_task();
+
+  // Prune the global chunk pools, as the cleaner task does periodically
+  static void clean_chunk_pools();
+
+  // Return the chunks cached by the given thread to the global pools, and stop
+  // caching for it. Called when the thread is destroyed.
+  static void release_thread_cached_chunks(Thread* thread);
 };
 
 //------------------------------Arena------------------------------------------
@@ -274,6 +274,72 @@ bool KlassInfoTable::merge(KlassInfoTable* table) {
   return closure.success();
 }
 
+KlassInfoBaseline::Entry::Entry(const KlassInfoEntry* cie) :
+  _klass(cie->klass()), _name(cie->klass()->name()),
+  _count(cie->count()), _words(cie->words()), _matched(false) {
+  if (_name != NULL) {
+    _name->increment_refcount();
+  }
+}
+
+class KlassInfoBaselineClosure : public KlassInfoClosure {
+ private:
+  GrowableArray<KlassInfoBaseline::Entry>* _entries;
+ public:
+  KlassInfoBaselineClosure(GrowableArray<KlassInfoBaseline::Entry>* entries) : _entries(entries) {}
+
+  void do_cinfo(KlassInfoEntry* cie) {
+    _entries->append(KlassInfoBaseline::Entry(cie));
+  }
+};
+
+KlassInfoBaseline::KlassInfoBaseline(KlassInfoTable* cit) :
+  _total_count(0), _total_words(cit->size_of_instances_in_words()) {
+  _entries = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<Entry>(KlassInfoBaseline::_initial_size, mtServiceability);
+  KlassInfoBaselineClosure closure(_entries);
+  cit->iterate(&closure);
+  _entries->sort(KlassInfoBaseline::sort_helper);
+  for (int i = 0; i < _entries->length(); i++) {
+    _total_count += _entries->at(i)._count;
+  }
+}
+
+KlassInfoBaseline::~KlassInfoBaseline() {
+  for (int i = 0; i < _entries->length(); i++) {
+    Symbol* name = _entries->at(i)._name;
+    if (name != NULL) {
+      name->decrement_refcount();
+    }
+  }
+  delete _entries;
+}
+
+int KlassInfoBaseline::compare_klass(Klass* const& k, const Entry& e) {
+  if (k < e._klass) {
+    return -1;
+  } else if (k > e._klass) {
+    return 1;
+  }
+  return 0;
+}
+
+int KlassInfoBaseline::sort_helper(Entry* e1, Entry* e2) {
+  return compare_klass(e1->_klass, *e2);
+}
+
+KlassInfoBaseline::Entry* KlassInfoBaseline::lookup(Klass* k) {
+  bool found = false;
+  int pos = _entries->find_sorted<Klass*, KlassInfoBaseline::compare_klass>(k, found);
+  if (found) {
+    Entry* e = _entries->adr_at(pos);
+    // A Klass* of an unloaded class may have been reused for a new class.
+    if (e->_name == k->name()) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -634,6 +700,133 @@ void HeapInspection::heap_inspection(outputStream* st, uint parallel_thread_num)
   st->flush();
 }
 
+// The baseline used by heap_inspection_diff(). It is only accessed by
+// the VM thread, during a safepoint.
+static KlassInfoBaseline* _histogram_baseline = NULL;
+
+// Change in instance count and size of one class since the baseline.
+class KlassInfoDelta {
+ public:
+  const char* _name;
+  int64_t     _count;
+  int64_t     _bytes;
+
+  KlassInfoDelta() : _name(NULL), _count(0), _bytes(0) {}
+  KlassInfoDelta(const char* name, int64_t count, int64_t bytes) :
+    _name(name), _count(count), _bytes(bytes) {}
+
+  static int compare(KlassInfoDelta* d1, KlassInfoDelta* d2) {
+    uint64_t b1 = d1->_bytes < 0 ? -(uint64_t)d1->_bytes : (uint64_t)d1->_bytes;
+    uint64_t b2 = d2->_bytes < 0 ? -(uint64_t)d2->_bytes : (uint64_t)d2->_bytes;
+    if (b1 > b2) {
+      return -1;
+    } else if (b1 < b2) {
+      return 1;
+    }
+    return strcmp(d1->_name, d2->_name);
+  }
+};
+
+// Collects the classes whose count or size differ from the baseline.
+// Unchanged classes are dropped here, so they are neither sorted nor printed.
+class KlassInfoDiffClosure : public KlassInfoClosure {
+ private:
+  KlassInfoBaseline* _baseline;
+  GrowableArray<KlassInfoDelta>* _deltas;
+  uintx _unchanged;
+ public:
+  KlassInfoDiffClosure(KlassInfoBaseline* baseline, GrowableArray<KlassInfoDelta>* deltas) :
+    _baseline(baseline), _deltas(deltas), _unchanged(0) {}
+
+  void do_cinfo(KlassInfoEntry* cie) {
+    int64_t count = (int64_t)cie->count();
+    int64_t words = (int64_t)cie->words();
+    KlassInfoBaseline::Entry* e = _baseline->lookup(cie->klass());
+    if (e != NULL) {
+      e->_matched = true;
+      count -= (int64_t)e->_count;
+      words -= (int64_t)e->_words;
+    }
+    if (count == 0 && words == 0) {
+      _unchanged++;
+      return;
+    }
+    _deltas->append(KlassInfoDelta(cie->name(), count, words * HeapWordSize));
+  }
+
+  // Add the baseline classes that no longer have any instances, or that
+  // have been unloaded.
+  void add_removed() {
+    for (int i = 0; i < _baseline->length(); i++) {
+      KlassInfoBaseline::Entry* e = _baseline->at(i);
+      if (!e->_matched && (e->_count != 0 || e->_words != 0)) {
+        const char* name = e->_name != NULL ? e->_name->as_klass_external_name() : "<no name>";
+        _deltas->append(KlassInfoDelta(name, -(int64_t)e->_count, -(int64_t)(e->_words * HeapWordSize)));
+      }
+    }
+  }
+
+  uintx unchanged() const { return _unchanged; }
+};
+
+void HeapInspection::heap_inspection_diff(outputStream* st, bool record_only, uint parallel_thread_num) {
+  assert(SafepointSynchronize::is_at_safepoint(), "baseline is only accessed at a safepoint");
+  ResourceMark rm;
+
+  KlassInfoTable cit(false);
+  if (cit.allocation_failed()) {
+    st->print_cr("ERROR: Ran out of C-heap; histogram not generated");
+    st->flush();
+    return;
+  }
+  // populate table with object allocation info
+  uintx missed_count = populate_table(&cit, NULL, parallel_thread_num);
+  if (missed_count != 0) {
+    log_info(gc, classhisto)("WARNING: Ran out of C-heap; undercounted " UINTX_FORMAT
+                             " total instances in data below",
+                             missed_count);
+  }
+
+  KlassInfoBaseline* baseline = new (std::nothrow) KlassInfoBaseline(&cit);
+  if (baseline == NULL) {
+    st->print_cr("ERROR: Ran out of C-heap; baseline not recorded");
+    st->flush();
+    return;
+  }
+
+  if (record_only || _histogram_baseline == NULL) {
+    if (!record_only) {
+      st->print_cr("No baseline histogram recorded; using the current histogram as the baseline");
+    }
+    st->print_cr("Baseline: %d classes, " UINT64_FORMAT " instances, " UINT64_FORMAT " bytes",
+                 baseline->length(), baseline->total_count(),
+                 (uint64_t)baseline->total_words() * HeapWordSize);
+  } else {
+    GrowableArray<KlassInfoDelta> deltas(KlassInfoBaseline::_initial_size);
+    KlassInfoDiffClosure dc(_histogram_baseline, &deltas);
+    cit.iterate(&dc);
+    dc.add_removed();
+    deltas.sort(KlassInfoDelta::compare);
+
+    st->print_cr(" num    #instances(+/-)      #bytes(+/-)  class name");
+    st->print_cr("-------------------------------------------------------");
+    int64_t total = 0;
+    int64_t totalb = 0;
+    for (int i = 0; i < deltas.length(); i++) {
+      KlassInfoDelta* d = deltas.adr_at(i);
+      st->print_cr("%4d: " INT64_FORMAT_W(17) "  " INT64_FORMAT_W(15) "  %s",
+                   i + 1, d->_count, d->_bytes, d->_name);
+      total += d->_count;
+      totalb += d->_bytes;
+    }
+    st->print_cr("Total " INT64_FORMAT_W(17) "  " INT64_FORMAT_W(15), total, totalb);
+    st->print_cr(UINTX_FORMAT " classes unchanged", dc.unchanged());
+    delete _histogram_baseline;
+  }
+  _histogram_baseline = baseline;
+  st->flush();
+}
+
 class FindInstanceClosure : public ObjectClosure {
  private:
   Klass* _klass;
@@ -132,6 +132,48 @@ class KlassInfoTable: public StackObj {
   friend class KlassHierarchy;
 };
 
+// KlassInfoBaseline is a snapshot of the counts in a KlassInfoTable that
+// is kept between heap inspections, so that a later inspection can report
+// only the per-class changes. The entries are sorted by Klass* and hold a
+// reference to the class name, which lets classes that were unloaded since
+// the snapshot still be reported, and keeps a Klass* that has been reused
+// for a different class from being matched against the old entry.
+class KlassInfoBaseline : public CHeapObj<mtServiceability> {
+ public:
+  class Entry {
+   public:
+    Klass*   _klass;
+    Symbol*  _name;
+    uint64_t _count;
+    size_t   _words;
+    bool     _matched;
+
+    Entry() : _klass(NULL), _name(NULL), _count(0), _words(0), _matched(false) {}
+    Entry(const KlassInfoEntry* cie);
+  };
+
+ private:
+  GrowableArray<Entry>* _entries;
+  uint64_t _total_count;
+  size_t   _total_words;
+
+  static int compare_klass(Klass* const& k, const Entry& e);
+  static int sort_helper(Entry* e1, Entry* e2);
+
+ public:
+  static const int _initial_size = 1000;
+
+  KlassInfoBaseline(KlassInfoTable* cit);
+  ~KlassInfoBaseline();
+
+  // Returns the entry recorded for k, or NULL if there is none.
+  Entry* lookup(Klass* k);
+  int length() const           { return _entries->length(); }
+  Entry* at(int i) const       { return _entries->adr_at(i); }
+  uint64_t total_count() const { return _total_count; }
+  size_t total_words() const   { return _total_words; }
+};
+
 class KlassHierarchy : AllStatic {
  public:
   static void print_class_hierarchy(outputStream* st, bool print_interfaces,  bool print_subclasses,
@@ -216,7 +258,15 @@ class KlassInfoClosure;
 
 class HeapInspection : public StackObj {
  public:
+  enum Mode {
+    PrintHistogram,     // Print the full class histogram.
+    RecordBaseline,     // Record the histogram as the baseline for later diffs.
+    PrintDiff           // Print the changes since the baseline, then make the
+                        // current histogram the new baseline.
+  };
+
   void heap_inspection(outputStream* st, uint parallel_thread_num = 1) NOT_SERVICES_RETURN;
+  void heap_inspection_diff(outputStream* st, bool record_only, uint parallel_thread_num = 1) NOT_SERVICES_RETURN;
   uintx populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL, uint parallel_thread_num = 1) NOT_SERVICES_RETURN_(0);
   static void find_instances_at_safepoint(Klass* k, GrowableArray<oop>* result) NOT_SERVICES_RETURN;
  private:
@@ -52,6 +52,9 @@
 #include "runtime/globals_extension.hpp"
 #include "runtime/init.hpp"
 #include "runtime/java.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/task.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/debug.hpp"
@@ -862,8 +865,21 @@ void Metaspace::global_initialize() {
 
 }
 
+// Periodically checks whether a deferred metaspace purge is due.
+class MetaspacePurgeTask : public PeriodicTask {
+ public:
+  MetaspacePurgeTask(size_t interval_ms) : PeriodicTask(interval_ms) { }
+  virtual void task() { Metaspace::trigger_purge_if_needed(); }
+};
+
 void Metaspace::post_initialize() {
   MetaspaceGC::post_initialize();
+  if (MetaspaceUncommitDelay > 0) {
+    size_t interval = align_down(MIN2(MetaspaceUncommitDelay, (uintx)PeriodicTask::max_interval),
+                                 (uintx)PeriodicTask::interval_gran);
+    interval = MAX2(interval, (size_t)PeriodicTask::min_interval);
+    (new MetaspacePurgeTask(interval))->enroll();
+  }
 }
 
 size_t Metaspace::max_allocation_word_size() {
@@ -1009,6 +1025,50 @@ void Metaspace::purge() {
   }
 }
 
+// Deferred purging.
+//
+// With MetaspaceUncommitDelay > 0, class unloading does not return free
+// metaspace memory to the OS itself, but records a purge request. A periodic
+// task notifies the service thread once the most recent request is older than
+// the delay, and the service thread then does the purge. This moves the
+// uncommit work out of GC pauses, and keeps memory freed by a burst of class
+// unloading committed for a while in case it is needed again soon.
+
+// Time of the most recent purge request, or 0 if there is none.
+static volatile jlong purge_request_time = 0;
+
+// Flag for avoiding duplicate notifications, protected by Service_lock.
+static bool purge_triggered = false;
+
+void Metaspace::request_purge() {
+  assert(MetaspaceUncommitDelay > 0, "purge requests are only recorded if deferred");
+  Atomic::store(&purge_request_time, os::javaTimeNanos());
+  metaspace::InternalStats::inc_num_purges_deferred();
+}
+
+void Metaspace::trigger_purge_if_needed() {
+  MonitorLocker ml(Service_lock, Monitor::_no_safepoint_check_flag);
+  jlong request_time = Atomic::load(&purge_request_time);
+  if (request_time != 0 && !purge_triggered &&
+      (os::javaTimeNanos() - request_time) >= (jlong)MetaspaceUncommitDelay * NANOSECS_PER_MILLISEC) {
+    purge_triggered = true;
+    ml.notify_all();
+  }
+}
+
+bool Metaspace::has_purge_work_and_reset() {
+  assert_lock_strong(Service_lock);
+  if (!purge_triggered) {
+    return false;
+  }
+  // A request made after this point will be satisfied by the purge the
+  // service thread is about to do, but is harmless: it only causes another
+  // purge after the delay.
+  purge_triggered = false;
+  Atomic::store(&purge_request_time, (jlong)0);
+  return true;
+}
+
 bool Metaspace::contains(const void* ptr) {
   if (MetaspaceShared::is_in_shared_metaspace(ptr)) {
     return true;
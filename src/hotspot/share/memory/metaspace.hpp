@@ -123,6 +123,11 @@ public:
   // Free empty virtualspaces
   static void purge();
 
+  // Deferred purging, see MetaspaceUncommitDelay.
+  static void request_purge();
+  static void trigger_purge_if_needed();
+  static bool has_purge_work_and_reset();
+
   static void report_metadata_oome(ClassLoaderData* loader_data, size_t word_size,
                                    MetaspaceObj::Type type, MetadataType mdtype, TRAPS);
 
@@ -29,6 +29,7 @@
 #include "memory/metaspace/chunkManager.hpp"
 #include "memory/metaspace/internalStats.hpp"
 #include "memory/metaspace/metachunk.hpp"
+#include "memory/metaspace/metachunkList.hpp"
 #include "memory/metaspace/metaspaceArenaGrowthPolicy.hpp"
 #include "memory/metaspace/metaspaceCommon.hpp"
 #include "memory/metaspace/metaspaceContext.hpp"
@@ -236,6 +237,16 @@ void ChunkManager::return_chunk(Metachunk* c) {
   return_chunk_locked(c);
 }
 
+void ChunkManager::return_chunks(MetachunkList* chunks) {
+  MutexLocker fcl(Metaspace_lock, Mutex::_no_safepoint_check_flag);
+  Metachunk* c = chunks->remove_first();
+  while (c != NULL) {
+    return_chunk_locked(c);
+    // c may be invalid after return_chunk_locked(c) was called. Don't access anymore.
+    c = chunks->remove_first();
+  }
+}
+
 // See return_chunk().
 void ChunkManager::return_chunk_locked(Metachunk* c) {
   assert_lock_strong(Metaspace_lock);
@@ -34,6 +34,7 @@
 
 namespace metaspace {
 
+class MetachunkList;
 class VirtualSpaceList;
 struct ChunkManagerStats;
 
@@ -140,6 +141,12 @@ public:
   //       calling this method.
   void return_chunk(Metachunk* c);
 
+  // Return all chunks in the given list to the ChunkManager, taking the lock only once.
+  //  The list is empty afterwards. Used when an arena dies: class loaders, and hidden
+  //  classes in particular, tend to be unloaded in large batches, and an arena typically
+  //  holds many small chunks.
+  void return_chunks(MetachunkList* chunks);
+
   // Given a chunk c, which must be "in use" and must not be a root chunk, attempt to
   // enlarge it in place by claiming its trailing buddy.
   //
@@ -94,6 +94,9 @@ class InternalStats : public AllStatic {
                                                     \
   /* Number of times we did a purge */              \
   x(num_purges)                                     \
+  /* Number of times a purge was deferred to */     \
+  /*  the service thread */                         \
+  x_atomic(num_purges_deferred)                     \
                                                     \
   /* Number of times we read inconsistent stats. */ \
   x(num_inconsistent_stats)                         \
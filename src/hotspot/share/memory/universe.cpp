@@ -71,6 +71,7 @@
 #include "runtime/jniHandles.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/timerTrace.hpp"
+#include "services/heapSampleProfiler.hpp"
 #include "services/memoryService.hpp"
 #include "utilities/align.hpp"
 #include "utilities/autoRestore.hpp"
@@ -435,7 +436,7 @@ void Universe::initialize_basic_type_mirrors(TRAPS) {
     if (UseSharedSpaces &&
         HeapShared::open_archive_heap_region_mapped() &&
         _mirrors[T_INT].resolve() != NULL) {
-      assert(HeapShared::is_heap_object_archiving_allowed(), "Sanity");
+      assert(HeapShared::is_heap_object_archiving_allowed() || HeapShared::is_loaded(), "Sanity");
 
       // check that all mirrors are mapped also
       for (int i = T_BOOLEAN; i < T_VOID+1; i++) {
@@ -866,6 +867,7 @@ OopStorage* Universe::vm_global() {
 void Universe::oopstorage_init() {
   Universe::_vm_global = OopStorageSet::create_strong("VM Global", mtInternal);
   Universe::_vm_weak = OopStorageSet::create_weak("VM Weak", mtInternal);
+  HeapSampleProfiler::create_oop_storage();
 }
 
 void universe_oopstorage_init() {
@@ -409,6 +409,9 @@ void ConstantPool::remove_unshareable_info() {
         // index. We cannot clear it. See comments in ClassFileParser::fill_instance_klass.
         clear_it = false;
       }
+      if (clear_it && DynamicDumpSharedSpaces && can_archive_resolved_klass(index)) {
+        clear_it = false;
+      }
       if (clear_it) {
         CPKlassSlot kslot = klass_slot_at(index);
         int resolved_klass_index = kslot.resolved_klass_index();
@@ -425,6 +428,33 @@ void ConstantPool::remove_unshareable_info() {
   }
 }
 
+// A resolved class entry can be kept in the dynamic archive if it names the
+// pool holder itself or one of its supertypes. Those are loaded, and checked
+// to be the archived classes, before the pool holder can be used at runtime,
+// so resolving the entry again would give the same Klass* and needs neither
+// class loading nor an access check that has not already succeeded.
+bool ConstantPool::can_archive_resolved_klass(int cp_index) {
+  assert(tag_at(cp_index).is_klass(), "must be resolved");
+  CPKlassSlot kslot = klass_slot_at(cp_index);
+  Klass* k = resolved_klasses()->at(kslot.resolved_klass_index());
+  InstanceKlass* holder = pool_holder();
+  if (k == holder) {
+    return true;
+  }
+  if (k == NULL || !k->is_instance_klass()) {
+    return false;
+  }
+  if (holder->is_subclass_of(k) || holder->implements_interface(k)) {
+    if (log_is_enabled(Trace, cds, resolve)) {
+      ResourceMark rm;
+      log_trace(cds, resolve)("archived resolved klass CP entry [%3d]: %s => %s", cp_index,
+                              holder->external_name(), k->external_name());
+    }
+    return true;
+  }
+  return false;
+}
+
 int ConstantPool::cp_to_object_index(int cp_index) {
   // this is harder don't do this so much.
   int i = reference_map()->find(cp_index);
@@ -38,9 +38,10 @@
 #include "memory/metaspaceClosure.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/access.inline.hpp"
-#include "oops/compressedOops.hpp"
+#include "oops/compressedOops.inline.hpp"
 #include "oops/constantPool.inline.hpp"
 #include "oops/cpCache.inline.hpp"
+#include "oops/klass.inline.hpp"
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/methodHandles.hpp"
@@ -711,6 +712,7 @@ void ConstantPoolCache::verify_just_initialized() {
 
 void ConstantPoolCache::remove_unshareable_info() {
   walk_entries_for_initialization(/*check_only = */ false);
+  assert(_interface_ics == NULL, "interface caches are not used when dumping");
 }
 
 void ConstantPoolCache::walk_entries_for_initialization(bool check_only) {
@@ -773,6 +775,47 @@ void ConstantPoolCache::deallocate_contents(ClassLoaderData* data) {
   set_resolved_references(OopHandle());
   MetadataFactory::free_array<u2>(data, _reference_map);
   set_reference_map(NULL);
+  if (_interface_ics != NULL) {
+    FREE_C_HEAP_ARRAY(intptr_t, _interface_ics);
+    _interface_ics = NULL;
+  }
+}
+
+void ConstantPoolCache::allocate_interface_ics() {
+  assert(use_interface_ics(), "sanity");
+  if (Atomic::load_acquire(&_interface_ics) != NULL) {
+    return;
+  }
+  intptr_t* ics = NEW_C_HEAP_ARRAY_RETURN_NULL(intptr_t, length(), mtClass);
+  if (ics == NULL) {
+    // The interpreter simply does not cache without the array.
+    return;
+  }
+  memset(ics, 0, sizeof(intptr_t) * length());
+  if (Atomic::replace_if_null(&_interface_ics, ics)) {
+    return;
+  }
+  FREE_C_HEAP_ARRAY(intptr_t, ics);
+}
+
+// Clear the interface inline caches whose receiver klass is being unloaded,
+// its narrowKlass may subsequently be reused for an unrelated class.
+void ConstantPoolCache::clean_interface_ics() {
+  intptr_t* ics = Atomic::load_acquire(&_interface_ics);
+  if (ics == NULL) {
+    return;
+  }
+  for (int i = 0; i < length(); i++) {
+    intptr_t ic = Atomic::load(&ics[i]);
+    if (ic == 0) {
+      continue;
+    }
+    narrowKlass nk = (narrowKlass)(ic & right_n_bits(BitsPerInt));
+    Klass* k = CompressedKlassPointers::decode_not_null(nk);
+    if (!k->is_loader_alive()) {
+      Atomic::cmpxchg(&ics[i], ic, (intptr_t)0);
+    }
+  }
 }
 
 #if INCLUDE_CDS_JAVA_HEAP
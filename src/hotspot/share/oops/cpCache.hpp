@@ -412,6 +412,11 @@ class ConstantPoolCache: public MetaspaceObj {
   // object index to original constant pool index
   OopHandle            _resolved_references;
   Array<u2>*           _reference_map;
+  // Per-entry interpreter inline caches for invokeinterface, allocated on
+  // demand in C heap (see UseInterpreterInterfaceCache). Each word holds the
+  // receiver narrowKlass in the low half and the offset of the selected
+  // itable method slot from that klass in the high half; 0 means empty.
+  intptr_t* volatile   _interface_ics;
   // The narrowOop pointer to the archived resolved_references. Set at CDS dump
   // time when caching java heap object is supported.
   CDS_JAVA_HEAP_ONLY(int _archived_references_index;)
@@ -450,6 +455,18 @@ class ConstantPoolCache: public MetaspaceObj {
 
   // Assembly code support
   static int resolved_references_offset_in_bytes() { return offset_of(ConstantPoolCache, _resolved_references); }
+  static int interface_ics_offset_in_bytes()       { return offset_of(ConstantPoolCache, _interface_ics); }
+
+  // Interpreter invokeinterface inline caches
+  static bool use_interface_ics() {
+#if defined(AMD64) && !defined(ZERO)
+    return UseInterpreterInterfaceCache;
+#else
+    return false;
+#endif
+  }
+  void allocate_interface_ics();
+  void clean_interface_ics();
 
   // CDS support
   void remove_unshareable_info();
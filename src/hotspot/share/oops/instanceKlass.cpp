@@ -939,7 +939,16 @@ bool InstanceKlass::link_class_impl(TRAPS) {
       }
       if (need_init_table) {
         vtable().initialize_vtable_and_check_constraints(CHECK_false);
-        itable().initialize_itable_and_check_constraints(CHECK_false);
+        if (can_defer_itable_initialization()) {
+          // Filled in by link_pending_itable() before the class is initialized,
+          // i.e. before any instance can reach an interface dispatch.
+          Atomic::release_store(&_itable_pending, true);
+          if (UsePerfData) {
+            ClassLoader::perf_itables_deferred()->inc();
+          }
+        } else {
+          itable().initialize_itable_and_check_constraints(CHECK_false);
+        }
       }
 #ifdef ASSERT
       vtable().verify(tty, true);
@@ -965,6 +974,49 @@ bool InstanceKlass::link_class_impl(TRAPS) {
   return true;
 }
 
+// The itable is only read through instances of this class (interface dispatch)
+// or by lookups that treat a NULL entry as unresolved, and CHA ignores classes
+// whose itable is pending, so filling it in can wait until initialization.
+// Interfaces still need their itable indices assigned at link time, shared
+// classes come with a complete itable, and VM-internal allocations of boot
+// classes may bypass initialization.
+bool InstanceKlass::can_defer_itable_initialization() const {
+  return LazyItableInitialization &&
+         !is_interface() &&
+         !is_shared() &&
+         !Arguments::is_dumping_archive() &&
+         !class_loader_data()->is_boot_class_loader_data() &&
+         itable_length() > itableOffsetEntry::size();
+}
+
+void InstanceKlass::link_pending_itable(TRAPS) {
+  JavaThread* jt = THREAD;
+  Handle h_init_lock(THREAD, init_lock());
+  ObjectLocker ol(h_init_lock, jt);
+  if (!is_itable_pending()) {
+    return;
+  }
+  // If a loader constraint is violated this throws, leaving the itable
+  // pending, and every further attempt to initialize the class fails the
+  // same way, as it would have failed to link.
+  itable().initialize_itable_and_check_constraints(CHECK);
+  if (UseVtableBasedCHA) {
+    // CHA ignores classes with a pending itable, as it does classes that
+    // are not linked yet. Flush the code that assumed there are no
+    // instances of this class.
+    MutexLocker ml(THREAD, Compile_lock);
+    Atomic::release_store(&_itable_pending, false);
+    if (Universe::is_fully_initialized()) {
+      CodeCache::flush_dependents_on(this);
+    }
+  } else {
+    Atomic::release_store(&_itable_pending, false);
+  }
+  if (UsePerfData) {
+    ClassLoader::perf_deferred_itables_initialized()->inc();
+  }
+}
+
 // Rewrite the byte codes of all of the methods of a class.
 // The rewriter must be called exactly once. Rewriting must happen after
 // verification but before the first method of the class is executed.
@@ -1017,6 +1069,9 @@ void InstanceKlass::initialize_impl(TRAPS) {
   // Make sure klass is linked (verified) before initialization
   // A class could already be verified, since it has been reflected upon.
   link_class(CHECK);
+  if (is_itable_pending()) {
+    link_pending_itable(CHECK);
+  }
 
   DTRACE_CLASSINIT_PROBE(required, -1);
 
@@ -2302,6 +2357,18 @@ bool InstanceKlass::is_dependent_nmethod(nmethod* nm) {
 void InstanceKlass::clean_weak_instanceklass_links() {
   clean_implementors_list();
   clean_method_data();
+  if (ConstantPoolCache::use_interface_ics()) {
+    clean_interface_ics();
+  }
+}
+
+void InstanceKlass::clean_interface_ics() {
+  for (InstanceKlass* ik = this; ik != NULL; ik = ik->previous_versions()) {
+    ConstantPoolCache* cache = ik->constants()->cache();
+    if (cache != NULL) {
+      cache->clean_interface_ics();
+    }
+  }
 }
 
 void InstanceKlass::clean_implementors_list() {
@@ -3091,6 +3158,11 @@ Method* InstanceKlass::method_at_itable(InstanceKlass* holder, int index, TRAPS)
 }
 
 Method* InstanceKlass::method_at_itable_or_null(InstanceKlass* holder, int index, bool& implements_interface) {
+  itableOffsetEntry* selected = klassItable::selector_lookup(this, holder);
+  if (selected != NULL) {
+    implements_interface = true;
+    return selected->first_method_entry(this)[index].method();
+  }
   klassItable itable(this);
   for (int i = 0; i < itable.size_offset_table(); i++) {
     itableOffsetEntry* offset_entry = itable.offset_entry(i);
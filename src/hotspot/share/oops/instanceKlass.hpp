@@ -229,6 +229,10 @@ class InstanceKlass: public Klass {
   // _idnum_allocated_count.
   u1              _init_state;              // state of class
 
+  // Set when linking skipped filling in the itable (LazyItableInitialization);
+  // cleared under the init lock once the itable has been filled in.
+  volatile bool   _itable_pending;
+
   // This can be used to quickly discriminate among the four kinds of
   // InstanceKlass. This should be an enum (?)
   static const unsigned _kind_other        = 0; // concrete InstanceKlass
@@ -576,6 +580,8 @@ public:
   void link_class(TRAPS);
   bool link_class_or_fail(TRAPS); // returns false on failure
   void rewrite_class(TRAPS);
+  inline bool is_itable_pending() const;
+  void link_pending_itable(TRAPS);
   void link_methods(TRAPS);
   Method* class_initializer() const;
 
@@ -1085,6 +1091,7 @@ public:
  private:
   void clean_implementors_list();
   void clean_method_data();
+  void clean_interface_ics();
 
  public:
   // Explicit metaspace deallocation of fields
@@ -1199,6 +1206,7 @@ private:
   void fence_and_clear_init_lock();
 
   bool link_class_impl                           (TRAPS);
+  bool can_defer_itable_initialization           () const;
   bool verify_code                               (TRAPS);
   void initialize_impl                           (TRAPS);
   void initialize_super_interfaces               (TRAPS);
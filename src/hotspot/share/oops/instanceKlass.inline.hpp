@@ -62,6 +62,10 @@ inline InstanceKlass* volatile* InstanceKlass::adr_implementor() const {
   }
 }
 
+inline bool InstanceKlass::is_itable_pending() const {
+  return Atomic::load_acquire(&_itable_pending);
+}
+
 inline ObjArrayKlass* InstanceKlass::array_klasses_acquire() const {
   return Atomic::load_acquire(&_array_klasses);
 }
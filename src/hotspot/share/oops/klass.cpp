@@ -85,7 +85,10 @@ void Klass::set_is_cloneable() {
 
 void Klass::set_name(Symbol* n) {
   _name = n;
-  if (_name != NULL) _name->increment_refcount();
+  if (_name != NULL) {
+    _name->increment_refcount();
+    _hash_bit = right_n_bits(1) << (_name->identity_hash() % BitsPerWord);
+  }
 
   if (Arguments::is_dumping_archive() && is_instance_klass()) {
     SystemDictionaryShared::init_dumptime_info(InstanceKlass::cast(this));
@@ -116,6 +119,9 @@ bool Klass::search_secondary_supers(Klass* k) const {
   // This is necessary, since I am never in my own secondary_super list.
   if (this == k)
     return true;
+  if (!may_be_secondary_super(k)) {
+    return false;
+  }
   // Scan the array-of-objects for a match
   int cnt = secondary_supers()->length();
   for (int i = 0; i < cnt; i++) {
@@ -202,6 +208,7 @@ void* Klass::operator new(size_t size, ClassLoaderData* loader_data, size_t word
 // The constructor is also used from CppVtableCloner,
 // which doesn't zero out the memory before calling the constructor.
 Klass::Klass(KlassID id) : _id(id),
+                           _hash_bit(~(uintx)0),
                            _shared_class_path_index(-1) {
   CDS_ONLY(_shared_class_flags = 0;)
   CDS_JAVA_HEAP_ONLY(_archived_mirror_index = -1;)
@@ -351,6 +358,21 @@ void Klass::initialize_supers(Klass* k, Array<InstanceKlass*>* transitive_interf
   }
 }
 
+void Klass::set_secondary_supers(Array<Klass*>* k) {
+  _secondary_supers = k;
+  uintx bitmap = 0;
+  if (k == NULL || k == Universe::the_array_interfaces_array()) {
+    // The shared array interfaces are only filled in during bootstrapping,
+    // so do not filter on them.
+    bitmap = ~(uintx)0;
+  } else {
+    for (int i = 0; i < k->length(); i++) {
+      bitmap |= k->at(i)->hash_bit();
+    }
+  }
+  _secondary_supers_bitmap = bitmap;
+}
+
 GrowableArray<Klass*>* Klass::compute_secondary_supers(int num_extra_slots,
                                                        Array<InstanceKlass*>* transitive_interfaces) {
   assert(num_extra_slots == 0, "override for complex klasses");
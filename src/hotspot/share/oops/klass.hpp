@@ -136,6 +136,11 @@ class Klass : public Metadata {
   Klass*      _secondary_super_cache;
   // Array of all secondary supertypes
   Array<Klass*>* _secondary_supers;
+  // Union of the hash bits of all secondary supertypes. A clear bit means
+  // that no klass with that hash bit is among the secondary supers.
+  uintx       _secondary_supers_bitmap;
+  // The single bit selected by the hash of this klass' name
+  uintx       _hash_bit;
   // Ordered list of all primary supertypes
   Klass*      _primary_supers[_primary_super_limit];
   // java/lang/Class instance mirroring this class
@@ -157,6 +162,13 @@ class Klass : public Metadata {
   jint        _modifier_flags;  // Processed access flags, for use by Class.getModifiers.
   AccessFlags _access_flags;    // Access flags. The class/interface distinction is stored here.
 
+  // Itable selector table support (see klassItable). Interfaces carry a
+  // random selector; classes with a selector table record its mask and its
+  // position within the klass, in ints. Both are 0 if there is no table.
+  juint       _itable_selector;
+  juint       _itable_selector_mask;
+  juint       _itable_selector_base;
+
   JFR_ONLY(DEFINE_TRACE_ID_FIELD;)
 
 private:
@@ -215,11 +227,27 @@ protected:
   juint    super_check_offset() const  { return _super_check_offset; }
   void set_super_check_offset(juint o) { _super_check_offset = o; }
 
+  juint    itable_selector() const            { return _itable_selector; }
+  void set_itable_selector(juint s)           { _itable_selector = s; }
+  juint    itable_selector_mask() const       { return _itable_selector_mask; }
+  juint    itable_selector_base() const       { return _itable_selector_base; }
+  void set_itable_selector_table(juint mask, juint base) {
+    _itable_selector_mask = mask;
+    _itable_selector_base = base;
+  }
+
   Klass* secondary_super_cache() const     { return _secondary_super_cache; }
   void set_secondary_super_cache(Klass* k) { _secondary_super_cache = k; }
 
   Array<Klass*>* secondary_supers() const { return _secondary_supers; }
-  void set_secondary_supers(Array<Klass*>* k) { _secondary_supers = k; }
+  void set_secondary_supers(Array<Klass*>* k);
+
+  uintx secondary_supers_bitmap() const   { return _secondary_supers_bitmap; }
+  uintx hash_bit() const                  { return _hash_bit; }
+  // False if k is definitely not one of the secondary supers
+  bool may_be_secondary_super(const Klass* k) const {
+    return !UseSecondarySupersBitmap || (_secondary_supers_bitmap & k->hash_bit()) != 0;
+  }
 
   // Return the element of the _super chain of the given depth.
   // If there is no such element, return either NULL or this.
@@ -353,11 +381,16 @@ protected:
   static ByteSize primary_supers_offset()        { return in_ByteSize(offset_of(Klass, _primary_supers)); }
   static ByteSize secondary_super_cache_offset() { return in_ByteSize(offset_of(Klass, _secondary_super_cache)); }
   static ByteSize secondary_supers_offset()      { return in_ByteSize(offset_of(Klass, _secondary_supers)); }
+  static ByteSize secondary_supers_bitmap_offset() { return in_ByteSize(offset_of(Klass, _secondary_supers_bitmap)); }
+  static ByteSize hash_bit_offset()              { return in_ByteSize(offset_of(Klass, _hash_bit)); }
   static ByteSize java_mirror_offset()           { return in_ByteSize(offset_of(Klass, _java_mirror)); }
   static ByteSize class_loader_data_offset()     { return in_ByteSize(offset_of(Klass, _class_loader_data)); }
   static ByteSize modifier_flags_offset()        { return in_ByteSize(offset_of(Klass, _modifier_flags)); }
   static ByteSize layout_helper_offset()         { return in_ByteSize(offset_of(Klass, _layout_helper)); }
   static ByteSize access_flags_offset()          { return in_ByteSize(offset_of(Klass, _access_flags)); }
+  static ByteSize itable_selector_offset()       { return in_ByteSize(offset_of(Klass, _itable_selector)); }
+  static ByteSize itable_selector_mask_offset()  { return in_ByteSize(offset_of(Klass, _itable_selector_mask)); }
+  static ByteSize itable_selector_base_offset()  { return in_ByteSize(offset_of(Klass, _itable_selector_base)); }
 
   // Unpacking layout_helper:
   static const int _lh_neutral_value           = 0;  // neutral non-array non-instance value
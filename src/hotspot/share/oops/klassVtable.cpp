@@ -44,7 +44,9 @@
 #include "runtime/java.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/safepointVerifiers.hpp"
+#include "utilities/align.hpp"
 #include "utilities/copy.hpp"
+#include "utilities/powerOfTwo.hpp"
 
 inline InstanceKlass* klassVtable::ik() const {
   return InstanceKlass::cast(_klass);
@@ -1116,6 +1118,10 @@ klassItable::klassItable(InstanceKlass* klass) {
       // First offset entry points to the first method_entry
       intptr_t* method_entry  = (intptr_t *)(((address)klass) + offset_entry->offset());
       intptr_t* end         = klass->end_of_itable();
+      if (klass->itable_selector_base() != 0) {
+        // The selector table follows the method tables
+        end = (intptr_t*)((address)klass + klass->itable_selector_base() * BytesPerInt);
+      }
 
       _table_offset      = (intptr_t*)offset_entry - (intptr_t*)klass;
       _size_offset_table = (method_entry - ((intptr_t*)offset_entry)) / itableOffsetEntry::size();
@@ -1509,7 +1515,8 @@ int klassItable::compute_itable_size(Array<InstanceKlass*>* transitive_interface
   visit_all_interfaces(transitive_interfaces, &cic);
 
   // There's alway an extra itable entry so we can null-terminate it.
-  int itable_size = calc_itable_size(cic.nof_interfaces() + 1, cic.nof_methods());
+  int itable_size = calc_itable_size(cic.nof_interfaces() + 1, cic.nof_methods()) +
+                    selector_table_size(cic.nof_interfaces());
 
   // Statistics
   update_stats(itable_size * wordSize);
@@ -1529,17 +1536,19 @@ void klassItable::setup_itable_offset_table(InstanceKlass* klass) {
   int nof_methods    = cic.nof_methods();
   int nof_interfaces = cic.nof_interfaces();
 
+  int selector_size = selector_table_size(nof_interfaces);
+
   // Add one extra entry so we can null-terminate the table
   nof_interfaces++;
 
   assert(compute_itable_size(klass->transitive_interfaces()) ==
-         calc_itable_size(nof_interfaces, nof_methods),
+         calc_itable_size(nof_interfaces, nof_methods) + selector_size,
          "mismatch calculation of itable size");
 
   // Fill-out offset table
   itableOffsetEntry* ioe = (itableOffsetEntry*)klass->start_of_itable();
   itableMethodEntry* ime = (itableMethodEntry*)(ioe + nof_interfaces);
-  intptr_t* end               = klass->end_of_itable();
+  intptr_t* end               = klass->end_of_itable() - selector_size;
   assert((oop*)(ime + nof_methods) <= (oop*)klass->start_of_nonstatic_oop_maps(), "wrong offset calculation (1)");
   assert((oop*)(end) == (oop*)(ime + nof_methods),                      "wrong offset calculation (2)");
 
@@ -1549,9 +1558,50 @@ void klassItable::setup_itable_offset_table(InstanceKlass* klass) {
 
 #ifdef ASSERT
   ime  = sic.method_entry();
-  oop* v = (oop*) klass->end_of_itable();
+  oop* v = (oop*) end;
   assert( (oop*)(ime) == v, "wrong offset calculation (2)");
 #endif
+
+  if (selector_size > 0) {
+    // Fill-out selector table. On a collision the first interface keeps
+    // the slot, the others are found by the linear scan.
+    int slots = selector_table_slots(nof_interfaces - 1);
+    juint mask = (juint)(slots - 1);
+    juint* table = (juint*)end;
+    for (itableOffsetEntry* e = ioe; e->interface_klass() != NULL; e++) {
+      juint slot = e->interface_klass()->itable_selector() & mask;
+      if (table[slot] == 0) {
+        table[slot] = (juint)((address)e - (address)klass);
+      }
+    }
+    klass->set_itable_selector_table(mask, (juint)(((address)table - (address)klass) / BytesPerInt));
+  }
+}
+
+int klassItable::selector_table_slots(int num_interfaces) {
+  if (!UseItableSelectorTable || num_interfaces < ItableSelectorTableMinInterfaces) {
+    return 0;
+  }
+  // Keep the table sparse so that few interfaces collide
+  return round_up_power_of_2(4 * num_interfaces);
+}
+
+int klassItable::selector_table_size(int num_interfaces) {
+  return align_up(selector_table_slots(num_interfaces) * BytesPerInt, wordSize) / wordSize;
+}
+
+itableOffsetEntry* klassItable::selector_lookup(const Klass* klass, const Klass* intf) {
+  juint base = klass->itable_selector_base();
+  if (base == 0) {
+    return NULL;
+  }
+  juint* table = (juint*)((address)klass + base * BytesPerInt);
+  juint offset = table[intf->itable_selector() & klass->itable_selector_mask()];
+  if (offset == 0) {
+    return NULL;
+  }
+  itableOffsetEntry* e = (itableOffsetEntry*)((address)klass + offset);
+  return e->interface_klass() == intf ? e : NULL;
 }
 
 void klassVtable::verify(outputStream* st, bool forced) {
@@ -275,6 +275,16 @@ class itableMethodEntry {
 //    compiler entry point                / method table entry
 //    -- vtable for interface 2 ---
 //    ...
+//    --- selector table (optional) ---
+//    offset of offset table entry       \
+//    ...                                 / one int per slot, 0 if empty
+//
+// With UseItableSelectorTable, classes implementing many interfaces get a
+// power-of-two sized selector table after the method tables. Each interface
+// is entered at the slot given by its itable_selector() and the table mask,
+// so a lookup can usually find the offset table entry with a single probe.
+// Interfaces that collide with an earlier one are only found by the linear
+// scan of the offset table, which remains authoritative.
 //
 class klassItable {
  private:
@@ -319,6 +329,9 @@ class klassItable {
   static int compute_itable_size(Array<InstanceKlass*>* transitive_interfaces);
   static void setup_itable_offset_table(InstanceKlass* klass);
 
+  // Selector table lookup; returns NULL if intf is not found in the table
+  static itableOffsetEntry* selector_lookup(const Klass* klass, const Klass* intf);
+
   // Debugging/Statistics
   static void print_statistics() PRODUCT_RETURN;
  private:
@@ -327,6 +340,8 @@ class klassItable {
 
   // Helper methods
   static int  calc_itable_size(int num_interfaces, int num_methods) { return (num_interfaces * itableOffsetEntry::size()) + (num_methods * itableMethodEntry::size()); }
+  static int  selector_table_slots(int num_interfaces);
+  static int  selector_table_size(int num_interfaces);
 
   // Statistics
   NOT_PRODUCT(static int  _total_classes;)   // Total no. of classes with itables
@@ -171,13 +171,23 @@ class markWord {
   markWord set_unlocked() const {
     return markWord(value() | unlocked_value);
   }
+  // With UseLightweightLocking the locked_value bit pattern denotes a
+  // fast-locked header instead; no BasicLock pointer is ever installed.
   bool has_locker() const {
-    return ((value() & lock_mask_in_place) == locked_value);
+    return !UseLightweightLocking && ((value() & lock_mask_in_place) == locked_value);
   }
   BasicLock* locker() const {
     assert(has_locker(), "check");
     return (BasicLock*) value();
   }
+  // A fast-locked header is the unlocked header with the lock bits cleared,
+  // so hash and age stay in place.
+  bool is_fast_locked() const {
+    return UseLightweightLocking && ((value() & lock_mask_in_place) == locked_value);
+  }
+  markWord set_fast_locked() const {
+    return markWord(value() & ~lock_mask_in_place);
+  }
   bool has_monitor() const {
     return ((value() & monitor_value) != 0);
   }
@@ -187,6 +197,10 @@ class markWord {
     return (ObjectMonitor*) (value() ^ monitor_value);
   }
   bool has_displaced_mark_helper() const {
+    if (UseLightweightLocking) {
+      // Only inflated monitors displace the header.
+      return ((value() & lock_mask_in_place) == monitor_value);
+    }
     return ((value() & unlocked_value) == 0);
   }
   markWord displaced_mark_helper() const;
@@ -22,6 +22,7 @@
  *
  */
 #include "precompiled.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "compiler/compiler_globals.hpp"
 #include "oops/method.hpp"
 #include "oops/methodCounters.hpp"
@@ -49,6 +50,8 @@ MethodCounters::MethodCounters(const methodHandle& mh) :
 
   _invoke_mask = right_n_bits(CompilerConfig::scaled_freq_log(Tier0InvokeNotifyFreqLog, scale)) << InvocationCounter::count_shift;
   _backedge_mask = right_n_bits(CompilerConfig::scaled_freq_log(Tier0BackedgeNotifyFreqLog, scale)) << InvocationCounter::count_shift;
+
+  CompilationProfile::seed_counters(mh, this);
 }
 
 MethodCounters* MethodCounters::allocate_no_exception(const methodHandle& mh) {
@@ -283,6 +283,9 @@ class oopDesc {
 
   // identity hash; returns the identity hash key (computes it if necessary)
   inline intptr_t identity_hash();
+  // Returns true if the object has certainly no identity hash, without
+  // installing one.
+  inline bool fast_no_hash_check();
   intptr_t slow_identity_hash();
 
   // marks are forwarded to stack when object is locked
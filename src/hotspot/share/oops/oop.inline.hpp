@@ -374,6 +374,12 @@ intptr_t oopDesc::identity_hash() {
   }
 }
 
+bool oopDesc::fast_no_hash_check() {
+  markWord mrk = mark();
+  assert(!mrk.is_marked(), "should never be marked");
+  return mrk.is_unlocked() && mrk.has_no_hash();
+}
+
 bool oopDesc::has_displaced_mark() const {
   return mark().has_displaced_mark_helper();
 }
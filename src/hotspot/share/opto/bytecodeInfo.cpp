@@ -348,6 +348,19 @@ bool InlineTree::is_not_reached(ciMethod* callee_method, ciMethod* caller_method
   return true; // give up and treat the call site as not reached
 }
 
+//-----------------------------is_frequent_call_site---------------------------
+// Is the call site hot enough for its callee to be worth the node
+// budget once the inlining size limits are reached?
+bool InlineTree::is_frequent_call_site(ciCallProfile& profile) const {
+  if (profile.count() <= 0) {
+    return false;
+  }
+  int call_site_count = method()->scale_count(profile.count());
+  int invoke_count    = method()->interpreter_invocation_count();
+  return (call_site_count >= InlineFrequencyCount) ||
+         (invoke_count > 0 && call_site_count / invoke_count >= InlineFrequencyRatio);
+}
+
 //-----------------------------try_to_inline-----------------------------------
 // return true if ok
 // Relocated from "InliningClosure::try_to_inline"
@@ -355,8 +368,14 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
                                int caller_bci, JVMState* jvms, ciCallProfile& profile,
                                bool& should_delay) {
 
+  // Like force inlined methods, frequent call sites that hit the size
+  // limits are delayed rather than rejected: they then compete for the
+  // live node budget of incremental inlining, hottest first.
+  bool delay_if_too_big = callee_method->force_inline() ||
+                          (IncrementalInlineHotFirst && is_frequent_call_site(profile));
+
   if (ClipInlining && (int)count_inline_bcs() >= DesiredMethodLimit) {
-    if (!callee_method->force_inline() || !IncrementalInline) {
+    if (!delay_if_too_big || !IncrementalInline) {
       set_msg("size > DesiredMethodLimit");
       return false;
     } else if (!C->inlining_incrementally()) {
@@ -383,7 +402,7 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
 
     // don't inline into giant methods
     if (C->over_inlining_cutoff()) {
-      if ((!callee_method->force_inline() && !caller_method->is_compiled_lambda_form())
+      if ((!delay_if_too_big && !caller_method->is_compiled_lambda_form())
           || !IncrementalInline) {
         set_msg("NodeCountInliningCutoff");
         return false;
@@ -461,7 +480,7 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
   int size = callee_method->code_size_for_inlining();
 
   if (ClipInlining && (int)count_inline_bcs() + size >= DesiredMethodLimit) {
-    if (!callee_method->force_inline() || !IncrementalInline) {
+    if (!delay_if_too_big || !IncrementalInline) {
       set_msg("size > DesiredMethodLimit");
       return false;
     } else if (!C->inlining_incrementally()) {
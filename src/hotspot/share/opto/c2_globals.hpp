@@ -224,6 +224,10 @@
   product(bool, UseCountedLoopSafepoints, false,                            \
           "Force counted loops to keep a safepoint")                        \
                                                                             \
+  product(bool, ElideLeafReturnPolls, false, DIAGNOSTIC,                    \
+          "Omit the return safepoint poll in methods that have no loops, "  \
+          "calls or safepoints")                                            \
+                                                                            \
   product(bool, UseLoopPredicate, true,                                     \
           "Generate a predicate to select fast/slow loop versions")         \
                                                                             \
@@ -249,6 +253,11 @@
   develop(bool, OptoCoalesce, true,                                         \
           "Use Conservative Copy Coalescing in the Register Allocator")     \
                                                                             \
+  product(uint, ConservativeCoalesceLimit, 0, DIAGNOSTIC,                   \
+          "Skip conservative copy coalescing in the register allocator "    \
+          "when there are more live ranges than this (0 means no limit)")   \
+          range(0, max_juint)                                               \
+                                                                            \
   develop(bool, UseUniqueSubclasses, true,                                  \
           "Narrow an abstract reference to the unique concrete subclass")   \
                                                                             \
@@ -262,6 +271,10 @@
   product(bool, ReduceInitialCardMarks, true,                               \
           "When initializing fields, try to avoid needless card marks")     \
                                                                             \
+  product(bool, MergeStores, true, DIAGNOSTIC,                              \
+          "Merge adjacent narrow stores of constants or of pieces of "      \
+          "one value into a single wider store")                            \
+                                                                            \
   product(bool, ReduceBulkZeroing, true,                                    \
           "When bulk-initializing, try to avoid needless zeroing")          \
                                                                             \
@@ -394,6 +407,9 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(bool, UsePolymorphicInlining, false, EXPERIMENTAL,                \
+          "Profiling based inlining for up to TypeProfileWidth receivers")  \
+                                                                            \
   develop(bool, SubsumeLoads, true,                                         \
           "Attempt to compile while subsuming loads into machine "          \
           "instructions.")                                                  \
@@ -468,6 +484,10 @@
   product(bool, AggressiveUnboxing, true, DIAGNOSTIC,                       \
           "Control optimizations for aggressive boxing elimination")        \
                                                                             \
+  product(bool, SplitLoadsThroughAllocationMerges, true, DIAGNOSTIC,        \
+          "Split field loads through Phis that merge new objects so the "   \
+          "objects can be scalar replaced")                                 \
+                                                                            \
   develop(bool, TracePostallocExpand, false, "Trace expanding nodes after"  \
           " register allocation.")                                          \
                                                                             \
@@ -484,6 +504,10 @@
   notproduct(bool, PrintEscapeAnalysis, false,                              \
           "Print the results of escape analysis")                           \
                                                                             \
+  notproduct(bool, TraceEscapeAnalysis, false,                              \
+          "Trace escape state changes of escape analysis with the reason "  \
+          "for each change")                                                \
+                                                                            \
   product(bool, EliminateAllocations, true,                                 \
           "Use escape analysis to eliminate allocations")                   \
                                                                             \
@@ -682,6 +706,11 @@
   product(bool, IncrementalInlineForceCleanup, false, DIAGNOSTIC,           \
           "do cleanup after every iteration of incremental inlining")       \
                                                                             \
+  product(bool, IncrementalInlineHotFirst, false, DIAGNOSTIC,               \
+          "delay rather than reject inlining of frequent call sites that "  \
+          "hit the inlining size limits and inline the most frequent "      \
+          "call sites first during post parse inlining")                    \
+                                                                            \
   product(intx, LiveNodeCountInliningCutoff, 40000,                         \
           "max number of live nodes in a method")                           \
           range(0, max_juint / 8)                                           \
@@ -1884,6 +1884,89 @@ bool PhiNode::wait_for_region_igvn(PhaseGVN* phase) {
   return delay;
 }
 
+// Phi (VB ... VB) => VB (Phi ...) (Phi ...)
+// The inputs may also be Phis whose inputs are equivalent VectorBoxes or
+// other such Phis, including cycles through loop backedges. The whole Phi
+// graph is then cloned once for the boxes and once for the vectors, so that
+// vectors carried around loops are not kept boxed.
+static Node* merge_vector_boxes_through_phi(PhiNode* root_phi, PhaseIterGVN* igvn) {
+  Unique_Node_List phis;
+  VectorBoxNode* cached_vbox = NULL;
+  phis.push(root_phi);
+  for (uint next = 0; next < phis.size(); next++) {
+    Node* phi = phis.at(next);
+    if (phi->in(0) == NULL || !phi->in(0)->is_Region()) {
+      return NULL;
+    }
+    for (uint i = 1; i < phi->req(); i++) {
+      Node* in = phi->in(i);
+      if (in == NULL) {
+        return NULL;
+      } else if (in->is_Phi()) {
+        phis.push(in);
+      } else if (in->Opcode() == Op_VectorBox) {
+        VectorBoxNode* vbox = static_cast<VectorBoxNode*>(in);
+        if (cached_vbox == NULL) {
+          cached_vbox = vbox;
+        } else if (Type::cmp(vbox->in(VectorBoxNode::Value)->bottom_type(),
+                             cached_vbox->in(VectorBoxNode::Value)->bottom_type()) != 0 ||
+                   Type::cmp(vbox->in(VectorBoxNode::Box)->bottom_type(),
+                             cached_vbox->in(VectorBoxNode::Box)->bottom_type()) != 0) {
+          return NULL;
+        }
+      } else {
+        return NULL;
+      }
+    }
+  }
+  if (cached_vbox == NULL) {
+    return NULL; // Only Phis, e.g. a dead cycle.
+  }
+
+  const TypeInstPtr* box_type = cached_vbox->box_type();
+  const TypeVect* vec_type = cached_vbox->vec_type();
+  // Map each Phi of the graph, by _idx, to its box and vector clones.
+  Arena* arena = Thread::current()->resource_area();
+  Node_Array box_phis(arena);
+  Node_Array vect_phis(arena);
+  for (uint k = 0; k < phis.size(); k++) {
+    Node* phi = phis.at(k);
+    Node* region = phi->in(0);
+    box_phis.map(phi->_idx, new PhiNode(region, box_type));
+    vect_phis.map(phi->_idx, new PhiNode(region, vec_type));
+  }
+  for (uint k = 0; k < phis.size(); k++) {
+    Node* phi = phis.at(k);
+    Node* box_phi = box_phis[phi->_idx];
+    Node* vect_phi = vect_phis[phi->_idx];
+    for (uint i = 1; i < phi->req(); i++) {
+      Node* in = phi->in(i);
+      if (in->is_Phi()) {
+        box_phi->init_req(i, box_phis[in->_idx]);
+        vect_phi->init_req(i, vect_phis[in->_idx]);
+      } else {
+        box_phi->init_req(i, in->in(VectorBoxNode::Box));
+        vect_phi->init_req(i, in->in(VectorBoxNode::Value));
+      }
+    }
+  }
+  for (uint k = 0; k < phis.size(); k++) {
+    Node* phi = phis.at(k);
+    igvn->register_new_node_with_optimizer(box_phis[phi->_idx], phi);
+    igvn->register_new_node_with_optimizer(vect_phis[phi->_idx], phi);
+  }
+  // Replace the other Phis of the graph with boxes of their clones as well,
+  // so that none of them keeps using the old boxed values. The root Phi is
+  // replaced by the caller with the returned box.
+  for (uint k = 1; k < phis.size(); k++) {
+    Node* phi = phis.at(k);
+    Node* vbox = new VectorBoxNode(igvn->C, box_phis[phi->_idx], vect_phis[phi->_idx], box_type, vec_type);
+    igvn->register_new_node_with_optimizer(vbox, phi);
+    igvn->replace_node(phi, vbox);
+  }
+  return new VectorBoxNode(igvn->C, box_phis[root_phi->_idx], vect_phis[root_phi->_idx], box_type, vec_type);
+}
+
 //------------------------------Ideal------------------------------------------
 // Return a node which is more "ideal" than the current node.  Must preserve
 // the CFG, but we can still strip out dead paths.
@@ -2382,44 +2465,8 @@ Node *PhiNode::Ideal(PhaseGVN *phase, bool can_reshape) {
 #endif
 
   // Phi (VB ... VB) => VB (Phi ...) (Phi ...)
-  if (EnableVectorReboxing && can_reshape && progress == NULL) {
-    PhaseIterGVN* igvn = phase->is_IterGVN();
-
-    bool all_inputs_are_equiv_vboxes = true;
-    for (uint i = 1; i < req(); ++i) {
-      Node* n = in(i);
-      if (in(i)->Opcode() != Op_VectorBox) {
-        all_inputs_are_equiv_vboxes = false;
-        break;
-      }
-      // Check that vector type of vboxes is equivalent
-      if (i != 1) {
-        if (Type::cmp(in(i-0)->in(VectorBoxNode::Value)->bottom_type(),
-                      in(i-1)->in(VectorBoxNode::Value)->bottom_type()) != 0) {
-          all_inputs_are_equiv_vboxes = false;
-          break;
-        }
-        if (Type::cmp(in(i-0)->in(VectorBoxNode::Box)->bottom_type(),
-                      in(i-1)->in(VectorBoxNode::Box)->bottom_type()) != 0) {
-          all_inputs_are_equiv_vboxes = false;
-          break;
-        }
-      }
-    }
-
-    if (all_inputs_are_equiv_vboxes) {
-      VectorBoxNode* vbox = static_cast<VectorBoxNode*>(in(1));
-      PhiNode* new_vbox_phi = new PhiNode(r, vbox->box_type());
-      PhiNode* new_vect_phi = new PhiNode(r, vbox->vec_type());
-      for (uint i = 1; i < req(); ++i) {
-        VectorBoxNode* old_vbox = static_cast<VectorBoxNode*>(in(i));
-        new_vbox_phi->set_req(i, old_vbox->in(VectorBoxNode::Box));
-        new_vect_phi->set_req(i, old_vbox->in(VectorBoxNode::Value));
-      }
-      igvn->register_new_node_with_optimizer(new_vbox_phi, this);
-      igvn->register_new_node_with_optimizer(new_vect_phi, this);
-      progress = new VectorBoxNode(igvn->C, new_vbox_phi, new_vect_phi, vbox->box_type(), vbox->vec_type());
-    }
+  if (EnableVectorReboxing && can_reshape && progress == NULL && type()->isa_oopptr()) {
+    progress = merge_vector_boxes_through_phi(this, phase->is_IterGVN());
   }
 
   return progress;              // Return any progress
@@ -332,6 +332,15 @@ void PhaseChaitin::compact() {
   _lrg_map.reset_uf_map(j);
 }
 
+// The cost of conservative coalescing grows with the size of the
+// interference graph and it is repeated after every round of
+// splitting. For methods with a huge number of live ranges, leave the
+// copies to post_allocate_copy_removal() instead.
+bool PhaseChaitin::should_coalesce_conservatively() const {
+  return OptoCoalesce &&
+         (ConservativeCoalesceLimit == 0 || _lrg_map.max_lrg_id() <= ConservativeCoalesceLimit);
+}
+
 void PhaseChaitin::Register_Allocate() {
 
   // Above the OLD FP (and in registers) are the incoming arguments.  Stack
@@ -485,7 +494,7 @@ void PhaseChaitin::Register_Allocate() {
     _ifg->SquareUp();
     _ifg->Compute_Effective_Degree();
     // Only do conservative coalescing if requested
-    if (OptoCoalesce) {
+    if (should_coalesce_conservatively()) {
       Compile::TracePhase tp("chaitinCoalesce2", &timers[_t_chaitinCoalesce2]);
       // Conservative (and pessimistic) copy coalescing of those spills
       PhaseConservativeCoalesce coalesce(*this);
@@ -559,7 +568,7 @@ void PhaseChaitin::Register_Allocate() {
     _ifg->Compute_Effective_Degree();
 
     // Only do conservative coalescing if requested
-    if (OptoCoalesce) {
+    if (should_coalesce_conservatively()) {
       Compile::TracePhase tp("chaitinCoalesce3", &timers[_t_chaitinCoalesce3]);
       // Conservative (and pessimistic) copy coalescing
       PhaseConservativeCoalesce coalesce(*this);
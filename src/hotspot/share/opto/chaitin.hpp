@@ -681,6 +681,9 @@ private:
   // needs to be recursive for derived Phis.
   Node *find_base_for_derived( Node **derived_base_map, Node *derived, uint &maxlrg );
 
+  // Conservative coalescing is skipped when there are too many live ranges
+  bool should_coalesce_conservatively() const;
+
   // Set the was-lo-degree bit.  Conservative coalescing should not change the
   // colorability of the graph.  If any live range was of low-degree before
   // coalescing, it should Simplify.  This call sets the was-lo-degree bit.
@@ -1858,6 +1858,51 @@ void Compile::inline_boxing_calls(PhaseIterGVN& igvn) {
   }
 }
 
+// Late inline candidate and the profile count of its call site
+struct LateInlineRank {
+  CallGenerator* _cg;
+  int            _count;
+  int            _pos;
+};
+
+static int compare_late_inline_rank(LateInlineRank* r1, LateInlineRank* r2) {
+  if (r1->_count != r2->_count) {
+    return r1->_count > r2->_count ? -1 : 1;
+  }
+  // Keep the depth first order for call sites with the same count
+  return r1->_pos - r2->_pos;
+}
+
+// Order the late inline candidates by decreasing call site count so
+// the live node budget goes to the most frequent call sites first.
+void Compile::sort_late_inlines() {
+  assert(_late_inlines_pos == 0, "no incremental inlining in progress");
+  int length = _late_inlines.length();
+  if (length < 2) {
+    return;
+  }
+  ResourceMark rm;
+  GrowableArray<LateInlineRank> ranks(length);
+  for (int i = 0; i < length; i++) {
+    CallGenerator* cg = _late_inlines.at(i);
+    int count = 0;
+    CallNode* call = cg->call_node();
+    if (call != NULL && call->jvms() != NULL && call->jvms()->has_method()) {
+      ciMethod* caller = call->jvms()->method();
+      ciCallProfile profile = caller->call_profile_at_bci(call->jvms()->bci());
+      if (profile.count() > 0) {
+        count = caller->scale_count(profile.count());
+      }
+    }
+    LateInlineRank rank = { cg, count, i };
+    ranks.append(rank);
+  }
+  ranks.sort(compare_late_inline_rank);
+  for (int i = 0; i < length; i++) {
+    _late_inlines.at_put(i, ranks.at(i)._cg);
+  }
+}
+
 bool Compile::inline_incrementally_one() {
   assert(IncrementalInline, "incremental inlining should be on");
 
@@ -1954,6 +1999,10 @@ void Compile::inline_incrementally(PhaseIterGVN& igvn) {
     for_igvn()->clear();
     initial_gvn()->replace_with(&igvn);
 
+    if (IncrementalInlineHotFirst) {
+      sort_late_inlines();
+    }
+
     while (inline_incrementally_one()) {
       assert(!failing(), "inconsistent");
     }
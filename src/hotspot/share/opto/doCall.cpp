@@ -224,6 +224,13 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
           speculative_receiver_type = NULL;
         }
       }
+      if (receiver_method == NULL && UsePolymorphicInlining && !have_major_receiver) {
+        CallGenerator* cg = call_generator_for_polymorphic_site(callee, vtable_index, jvms, allow_inline,
+                                                                prof_factor, profile);
+        if (cg != NULL) {
+          return cg;
+        }
+      }
       if (receiver_method == NULL &&
           (have_major_receiver || morphism == 1 ||
            (morphism == 2 && UseBimorphicInlining))) {
@@ -372,6 +379,78 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
   }
 }
 
+// Polymorphic inlining: guard the methods of the profiled receivers of
+// a call site with a chain of type checks, most frequent receiver first.
+// If the profile saw no other receiver (morphism > 2), the residual path
+// is an uncommon trap. Otherwise (megamorphic call site) the most
+// frequent receivers that together account for
+// TypeProfileMajorReceiverPercent of the calls are inlined and the
+// residual path is a virtual call.
+CallGenerator* Compile::call_generator_for_polymorphic_site(ciMethod* callee, int vtable_index, JVMState* jvms,
+                                                            bool allow_inline, float prof_factor,
+                                                            ciCallProfile& profile) {
+  ciMethod* caller = jvms->method();
+  int       bci    = jvms->bci();
+  int morphism = profile.morphism();
+  int receivers = 0;
+  if (morphism > 2) {
+    receivers = morphism;
+  } else if (morphism == 0) {
+    float prob = 0;
+    for (int i = 0; profile.has_receiver(i); i++) {
+      prob += profile.receiver_prob(i);
+      if (100. * prob >= (float)TypeProfileMajorReceiverPercent) {
+        receivers = i + 1;
+        break;
+      }
+    }
+  }
+  if (receivers < 2) {
+    return NULL;
+  }
+
+  ciMethod*      receiver_methods[ciCallProfile::MorphismLimit];
+  CallGenerator* hit_cgs[ciCallProfile::MorphismLimit];
+  for (int i = 0; i < receivers; i++) {
+    receiver_methods[i] = callee->resolve_invoke(caller->holder(), profile.receiver(i));
+    if (receiver_methods[i] == NULL) {
+      return NULL;
+    }
+    hit_cgs[i] = call_generator(receiver_methods[i], vtable_index, false, jvms, allow_inline, prof_factor);
+    if (hit_cgs[i] == NULL || (UseOnlyInlinedBimorphic && !hit_cgs[i]->is_inline())) {
+      // Not worth a type switch if we can't inline all of them
+      return NULL;
+    }
+  }
+
+  CallGenerator* cg = NULL;
+  Deoptimization::DeoptReason reason = Deoptimization::Reason_bimorphic;
+  if (morphism > 0 && !too_many_traps_or_recompiles(caller, bci, reason)) {
+    cg = CallGenerator::for_uncommon_trap(callee, reason, Deoptimization::Action_maybe_recompile);
+  } else {
+    cg = (IncrementalInlineVirtual ? CallGenerator::for_late_inline_virtual(callee, vtable_index, prof_factor)
+                                   : CallGenerator::for_virtual_call(callee, vtable_index));
+  }
+  // Probability of reaching the type check of each receiver
+  float reach_prob[ciCallProfile::MorphismLimit];
+  reach_prob[0] = 1;
+  for (int i = 1; i < receivers; i++) {
+    reach_prob[i] = reach_prob[i-1] - profile.receiver_prob(i-1);
+  }
+  for (int i = receivers - 1; i >= 0 && cg != NULL; i--) {
+    float hit_prob = PROB_MAX;
+    if (reach_prob[i] > 0) {
+      hit_prob = MAX2(PROB_MIN, MIN2(PROB_MAX, profile.receiver_prob(i) / reach_prob[i]));
+    }
+    trace_type_profile(this, caller, jvms->depth() - 1, bci, receiver_methods[i], profile.receiver(i),
+                       profile.count(), profile.receiver_count(i));
+    // As for bimorphic inlining, the dependency on the receiver is
+    // added by Parse::Parse() when the method is inlined.
+    cg = CallGenerator::for_predicted_call(profile.receiver(i), cg, hit_cgs[i], hit_prob);
+  }
+  return cg;
+}
+
 // Return true for methods that shouldn't be inlined early so that
 // they are easier to analyze and optimize as intrinsics.
 bool Compile::should_delay_string_inlining(ciMethod* call_method, JVMState* jvms) {
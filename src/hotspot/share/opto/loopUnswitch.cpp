@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2006, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2006, 2021, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -50,6 +50,25 @@
 //                               endif
 //
 // Note: the "else" clause may be empty
+//
+// A loop may be unswitched on up to unswitch_max() invariant tests, one per
+// round. When the profile of the test is heavily biased, the version of the
+// loop for the cold branch is not unswitched any further, so that the loop
+// grows linearly rather than exponentially with the number of tests and
+// the hot version ends up with none of them.
+
+// Probability below which a branch of an unswitched test is considered cold
+#define UNSWITCH_COLD_PROB PROB_UNLIKELY_MAG(2)
+
+// Distance of the profile of 'iff' from always taking one branch; larger
+// than any known profile if the profile is unknown.
+static float unswitch_bias(const IfNode* iff) {
+  float prob = iff->_prob;
+  if (prob == PROB_UNKNOWN) {
+    return PROB_FAIR + 1.0f;
+  }
+  return MIN2(prob, 1.0f - prob);
+}
 
 //------------------------------policy_unswitching-----------------------------
 // Return TRUE or FALSE if the loop should be unswitched
@@ -83,10 +102,10 @@ bool IdealLoopTree::policy_unswitching( PhaseIdealLoop *phase ) const {
 }
 
 //------------------------------find_unswitching_candidate-----------------------------
-// Find candidate "if" for unswitching
+// Find candidate "if" for unswitching: the invariant test that doesn't exit
+// the loop with the most biased profile, the outermost one among equals.
 IfNode* PhaseIdealLoop::find_unswitching_candidate(const IdealLoopTree *loop) const {
 
-  // Find first invariant test that doesn't exit the loop
   LoopNode *head = loop->_head->as_Loop();
   IfNode* unswitch_iff = NULL;
   Node* n = head->in(LoopNode::LoopBackControl);
@@ -100,7 +119,8 @@ IfNode* PhaseIdealLoop::find_unswitching_candidate(const IdealLoopTree *loop) co
           if (bol->in(1)->is_Cmp()) {
             // If condition is invariant and not a loop exit,
             // then found reason to unswitch.
-            if (loop->is_invariant(bol) && !loop->is_loop_exit(iff)) {
+            if (loop->is_invariant(bol) && !loop->is_loop_exit(iff) &&
+                (unswitch_iff == NULL || unswitch_bias(iff) <= unswitch_bias(unswitch_iff))) {
               unswitch_iff = iff;
             }
           }
@@ -185,6 +205,16 @@ void PhaseIdealLoop::do_unswitching(IdealLoopTree *loop, Node_List &old_new) {
   head->set_unswitch_count(nct);
   head_clone->set_unswitch_count(nct);
 
+  // Don't unswitch the version of the loop for a cold branch again
+  float prob = unswitch_iff->_prob;
+  if (prob != PROB_UNKNOWN && nct < head->unswitch_max()) {
+    if (prob < UNSWITCH_COLD_PROB) {
+      head->set_unswitch_count(head->unswitch_max());
+    } else if (1.0f - prob < UNSWITCH_COLD_PROB) {
+      head_clone->set_unswitch_count(head_clone->unswitch_max());
+    }
+  }
+
   // Hoist invariant casts out of each loop to the appropriate
   // control projection.
 
@@ -229,9 +259,9 @@ void PhaseIdealLoop::do_unswitching(IdealLoopTree *loop, Node_List &old_new) {
 
 #ifndef PRODUCT
   if (TraceLoopUnswitching) {
-    tty->print_cr("Loop unswitching orig: %d @ %d  new: %d @ %d",
+    tty->print_cr("Loop unswitching orig: %d @ %d  new: %d @ %d  prob: %f",
                   head->_idx,                unswitch_iff->_idx,
-                  old_new[head->_idx]->_idx, unswitch_iff_clone->_idx);
+                  old_new[head->_idx]->_idx, unswitch_iff_clone->_idx, unswitch_iff->_prob);
   }
 #endif
 
@@ -713,6 +713,190 @@ SafePointNode* PhaseIdealLoop::find_safepoint(Node* back_control, Node* x, Ideal
   return safepoint;
 }
 
+// Return true if exp is a constant times the long induction variable iv
+static bool is_long_scaled_iv(Node* exp, Node* iv, jlong* p_scale) {
+  exp = exp->uncast();
+  if (exp == iv) {
+    *p_scale = 1;
+    return true;
+  }
+  int opc = exp->Opcode();
+  if (opc == Op_MulL) {
+    if (exp->in(1)->uncast() == iv && exp->in(2)->is_Con()) {
+      *p_scale = exp->in(2)->get_long();
+      return true;
+    }
+    if (exp->in(2)->uncast() == iv && exp->in(1)->is_Con()) {
+      *p_scale = exp->in(1)->get_long();
+      return true;
+    }
+  } else if (opc == Op_LShiftL) {
+    if (exp->in(1)->uncast() == iv && exp->in(2)->is_Con()) {
+      jint shift = exp->in(2)->get_int() & (BitsPerJavaLong - 1);
+      if (shift < BitsPerJavaInteger - 1) {
+        *p_scale = CONST64(1) << shift;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Return true if exp is a simple long induction variable expression:
+// scale*iv + offset (or scale*iv - offset when *p_negate_offset is set).
+// *p_offset is NULL if there's no offset.
+bool PhaseIdealLoop::is_long_scaled_iv_plus_offset(Node* exp, Node* iv, jlong* p_scale, Node** p_offset, bool* p_negate_offset) {
+  *p_offset = NULL;
+  *p_negate_offset = false;
+  if (is_long_scaled_iv(exp, iv, p_scale)) {
+    return true;
+  }
+  exp = exp->uncast();
+  int opc = exp->Opcode();
+  if (opc == Op_AddL) {
+    if (is_long_scaled_iv(exp->in(1), iv, p_scale)) {
+      *p_offset = exp->in(2);
+      return true;
+    }
+    if (is_long_scaled_iv(exp->in(2), iv, p_scale)) {
+      *p_offset = exp->in(1);
+      return true;
+    }
+  } else if (opc == Op_SubL) {
+    if (is_long_scaled_iv(exp->in(1), iv, p_scale)) {
+      *p_offset = exp->in(2);
+      *p_negate_offset = true;
+      return true;
+    }
+    if (is_long_scaled_iv(exp->in(2), iv, p_scale) && *p_scale != min_jlong) {
+      *p_scale = -*p_scale;
+      *p_offset = exp->in(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Collect the long range checks of the loop body that can be turned
+// into int range checks of the inner loop of the loop nest (see
+// transform_long_range_checks()). Returns the inner loop iteration
+// limit reduced so the int range checks can't overflow.
+int PhaseIdealLoop::extract_long_range_checks(IdealLoopTree* loop, Node* iv, jlong stride_con, int iters_limit, Node_List& range_checks) {
+  // |scale * inner iv| + |int offset| must fit in an int
+  const jlong max_scaled_iters = max_jint / 2 - 1;
+  int reduced_iters_limit = iters_limit;
+  for (uint i = 0; i < loop->_body.size(); i++) {
+    Node* n = loop->_body.at(i);
+    if (!n->is_RangeCheck()) {
+      continue;
+    }
+    RangeCheckNode* rc = n->as_RangeCheck();
+    Node* bol = rc->in(1);
+    if (!bol->is_Bool() || bol->as_Bool()->_test._test != BoolTest::lt ||
+        bol->in(1)->Opcode() != Op_CmpUL) {
+      continue;
+    }
+    // A failing check must deoptimize so it's fine for the int range
+    // check to fail in some corner cases where the long one wouldn't.
+    ProjNode* proj = rc->proj_out_or_null(1);
+    if (proj == NULL || proj->is_uncommon_trap_if_pattern(Deoptimization::Reason_none) == NULL) {
+      continue;
+    }
+    Node* cmp = bol->in(1);
+    Node* range = cmp->in(2);
+    if (loop->is_member(get_loop(get_ctrl(range)))) {
+      continue;
+    }
+    jlong scale = 0;
+    Node* offset = NULL;
+    bool negate_offset = false;
+    if (!is_long_scaled_iv_plus_offset(cmp->in(1), iv, &scale, &offset, &negate_offset) ||
+        (offset != NULL && loop->is_member(get_loop(get_ctrl(offset))))) {
+      continue;
+    }
+    if (scale == 0 || scale < -max_jint || scale > max_jint) {
+      continue;
+    }
+    jlong rc_iters_limit = max_scaled_iters / ABS(scale);
+    if (rc_iters_limit / ABS(stride_con) < 2) {
+      continue;
+    }
+    reduced_iters_limit = (int)MIN2((jlong)reduced_iters_limit, rc_iters_limit);
+    range_checks.push(rc);
+  }
+  return reduced_iters_limit;
+}
+
+// Rewrite the long range checks collected by
+// extract_long_range_checks() as int range checks on the inner loop
+// iv so range check elimination, predication and unrolling apply to
+// the inner loop:
+//
+// for (long i = init; i < limit; i += stride) {
+//   if (scale * i + offset <u range) { ... } else { trap }
+// }
+//
+// In the loop nest, i = outer_phi + inner_phi and inner_phi only takes
+// values with |scale * inner_phi| <= M, M = |scale| * iters_limit. With
+// Q = scale * outer_phi + offset, the check is
+//
+//  scale * inner_phi + Q <u range
+//
+// which is rewritten, for B = M + 1, as:
+//
+//  int Q' = clamp(Q, -B, B);
+//  int R' = clamp(range - Q + Q', 0, max_jint);
+//  if (scale * inner_phi + Q' <u R') { ... } else { trap }
+//
+// If -B <= Q <= B, both checks are equivalent. If Q > B, the first
+// one is scale * inner_phi < range - Q which is what the second one
+// checks. If Q < -B, the long check fails unless scale * inner_phi + Q
+// overflows and the int check always fails: execution then resumes
+// in the interpreter which performs the actual check.
+void PhaseIdealLoop::transform_long_range_checks(Node_List& range_checks, Node* iv, int iters_limit, Node* outer_phi, Node* inner_phi) {
+  for (uint i = 0; i < range_checks.size(); i++) {
+    RangeCheckNode* rc = range_checks.at(i)->as_RangeCheck();
+    Node* cmp = rc->in(1)->in(1);
+    Node* range = cmp->in(2);
+    jlong scale = 0;
+    Node* offset = NULL;
+    bool negate_offset = false;
+    bool ok = is_long_scaled_iv_plus_offset(cmp->in(1), iv, &scale, &offset, &negate_offset);
+    assert(ok, "checked by extract_long_range_checks()");
+
+    Node* q = outer_phi;
+    if (scale != 1) {
+      q = _igvn.transform(new MulLNode(q, _igvn.longcon(scale)));
+    }
+    if (offset != NULL) {
+      if (negate_offset) {
+        q = _igvn.transform(new SubLNode(q, offset));
+      } else {
+        q = _igvn.transform(new AddLNode(q, offset));
+      }
+    }
+    jlong b = ABS(scale) * iters_limit + 1;
+    Node* q_clamped = MaxNode::signed_max(q, _igvn.longcon(-b), TypeLong::make(-b, max_jlong, Type::WidenMax), _igvn);
+    q_clamped = MaxNode::signed_min(q_clamped, _igvn.longcon(b), TypeLong::make(-b, b, Type::WidenMax), _igvn);
+    Node* r = _igvn.transform(new SubLNode(range, q));
+    r = _igvn.transform(new AddLNode(r, q_clamped));
+    Node* r_clamped = MaxNode::signed_max(r, _igvn.longcon(0), TypeLong::make(0, max_jlong, Type::WidenMax), _igvn);
+    r_clamped = MaxNode::signed_min(r_clamped, _igvn.longcon(max_jint), TypeLong::make(0, max_jint, Type::WidenMax), _igvn);
+
+    Node* int_offset = _igvn.transform(new ConvL2INode(q_clamped));
+    Node* int_range = _igvn.transform(new ConvL2INode(r_clamped));
+    Node* int_index = inner_phi;
+    if (scale != 1) {
+      int_index = _igvn.transform(new MulINode(int_index, _igvn.intcon((jint)scale)));
+    }
+    int_index = _igvn.transform(new AddINode(int_index, int_offset));
+    Node* int_cmp = _igvn.transform(new CmpUNode(int_index, int_range));
+    Node* int_bol = _igvn.transform(new BoolNode(int_cmp, BoolTest::lt));
+    set_subtree_ctrl(int_bol, true);
+    _igvn.replace_input_of(rc, 1, int_bol);
+  }
+}
+
 // If the loop has the shape of a counted loop but with a long
 // induction variable, transform the loop in a loop nest: an inner
 // loop that iterates for at most max int iterations with an integer
@@ -817,6 +1001,9 @@ bool PhaseIdealLoop::transform_long_counted_loop(IdealLoopTree* loop, Node_List
   assert(phi_t->_hi >= phi_t->_lo, "dead phi?");
   iters_limit = (int)MIN2((julong)iters_limit, (julong)(phi_t->_hi - phi_t->_lo));
 
+  Node_List range_checks;
+  iters_limit = extract_long_range_checks(loop, phi, stride_con, iters_limit, range_checks);
+
   LongCountedLoopEndNode* exit_test = head->loopexit();
   BoolTest::mask bt = exit_test->test_trip();
 
@@ -901,6 +1088,9 @@ bool PhaseIdealLoop::transform_long_counted_loop(IdealLoopTree* loop, Node_List
 
   _igvn.replace_input_of(exit_test, 1, inner_bol);
 
+  // Turn long range checks into int range checks of the inner loop
+  transform_long_range_checks(range_checks, phi, iters_limit, outer_phi, inner_phi);
+
   // Clone inner loop phis to outer loop
   for (uint i = 0; i < head->outcnt(); i++) {
     Node* u = head->raw_out(i);
@@ -3305,6 +3495,14 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
       // Not a counted loop. Keep one safepoint.
       bool keep_one_sfpt = true;
       remove_safepoints(phase, keep_one_sfpt);
+#ifndef PRODUCT
+      // Such a loop can't be strip mined: unless a call on the dom-path
+      // already polls, it pays for a safepoint poll on every iteration.
+      if (TraceLoopOpts && !_has_sfpt) {
+        tty->print("Polled       ");
+        dump_head();
+      }
+#endif
     }
   }
 
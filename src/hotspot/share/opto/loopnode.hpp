@@ -1170,6 +1170,9 @@ public:
 
   void long_loop_replace_long_iv(Node* iv_to_replace, Node* inner_iv, Node* outer_phi, Node* inner_head);
   bool transform_long_counted_loop(IdealLoopTree* loop, Node_List &old_new);
+  bool is_long_scaled_iv_plus_offset(Node* exp, Node* iv, jlong* p_scale, Node** p_offset, bool* p_negate_offset);
+  int extract_long_range_checks(IdealLoopTree* loop, Node* iv, jlong stride_con, int iters_limit, Node_List& range_checks);
+  void transform_long_range_checks(Node_List& range_checks, Node* iv, int iters_limit, Node* outer_phi, Node* inner_phi);
 #ifdef ASSERT
   bool convert_to_long_loop(Node* cmp, Node* phi, IdealLoopTree* loop);
 #endif
@@ -47,6 +47,7 @@
 #include "opto/phaseX.hpp"
 #include "opto/regmask.hpp"
 #include "opto/rootnode.hpp"
+#include "opto/subnode.hpp"
 #include "opto/vectornode.hpp"
 #include "utilities/align.hpp"
 #include "utilities/copy.hpp"
@@ -1498,6 +1499,30 @@ static bool stable_phi(PhiNode* phi, PhaseGVN *phase) {
   }
   return true;
 }
+
+// Is address a field of a Phi which only merges new objects, as in
+// "p = cond ? new P(a) : new P(b)"? Loads split through such a Phi see
+// the initializing stores of each allocation.
+static bool is_field_of_allocation_merge(Node* address, PhaseGVN* phase) {
+  if (!SplitLoadsThroughAllocationMerges || !address->is_AddP()) {
+    return false;
+  }
+  Node* base = address->in(AddPNode::Base);
+  if (!base->is_Phi() || base != address->in(AddPNode::Address) ||
+      !phase->type(address->in(AddPNode::Offset))->singleton()) {
+    return false;
+  }
+  if (!stable_phi(base->as_Phi(), phase) || base->in(0)->is_Loop()) {
+    return false;
+  }
+  for (uint i = 1; i < base->req(); i++) {
+    if (AllocateNode::Ideal_allocation(base->in(i), phase) == NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //------------------------------split_through_phi------------------------------
 // Split instance or boxed field load through Phi.
 Node *LoadNode::split_through_phi(PhaseGVN *phase) {
@@ -1507,7 +1532,8 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
 
   assert((t_oop != NULL) &&
          (t_oop->is_known_instance_field() ||
-          t_oop->is_ptr_to_boxed_value()), "invalide conditions");
+          t_oop->is_ptr_to_boxed_value() ||
+          is_field_of_allocation_merge(address, phase)), "invalide conditions");
 
   Compile* C = phase->C;
   intptr_t ignore = 0;
@@ -1516,9 +1542,11 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   bool load_boxed_values = t_oop->is_ptr_to_boxed_value() && C->aggressive_unboxing() &&
                            (base != NULL) && (base == address->in(AddPNode::Base)) &&
                            phase->type(base)->higher_equal(TypePtr::NOTNULL);
+  bool load_merged_allocations = !t_oop->is_known_instance_field() && !load_boxed_values &&
+                                 is_field_of_allocation_merge(address, phase);
 
   if (!((mem->is_Phi() || base_is_phi) &&
-        (load_boxed_values || t_oop->is_known_instance_field()))) {
+        (load_boxed_values || load_merged_allocations || t_oop->is_known_instance_field()))) {
     return NULL; // memory is not Phi
   }
 
@@ -1598,13 +1626,16 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
     assert(base->in(0) == mem->in(0), "sanity");
     region = mem->in(0);
   }
+  if (load_merged_allocations && region != base->in(0)) {
+    return NULL; // Only a split of the base gets rid of the merge
+  }
 
   const Type* this_type = this->bottom_type();
   int this_index  = C->get_alias_index(t_oop);
   int this_offset = t_oop->offset();
   int this_iid    = t_oop->instance_id();
-  if (!t_oop->is_known_instance() && load_boxed_values) {
-    // Use _idx of address base for boxed values.
+  if (!t_oop->is_known_instance() && (load_boxed_values || load_merged_allocations)) {
+    // Use _idx of address base for boxed values and merged allocations.
     this_iid = base->_idx;
   }
   PhaseIterGVN* igvn = phase->is_IterGVN();
@@ -1761,7 +1792,8 @@ Node *LoadNode::Ideal(PhaseGVN *phase, bool can_reshape) {
     const TypeOopPtr *t_oop = addr_t->isa_oopptr();
     if ((t_oop != NULL) &&
         (t_oop->is_known_instance_field() ||
-         t_oop->is_ptr_to_boxed_value())) {
+         t_oop->is_ptr_to_boxed_value() ||
+         is_field_of_allocation_merge(address, phase))) {
       PhaseIterGVN *igvn = phase->is_IterGVN();
       assert(igvn != NULL, "must be PhaseIterGVN when can_reshape is true");
       if (igvn->_worklist.member(opt_mem)) {
@@ -2728,9 +2760,302 @@ Node *StoreNode::Ideal(PhaseGVN *phase, bool can_reshape) {
     }
   }
 
+  // Merge a chain of adjacent narrow stores into one wider store.
+  if (MergeStores) {
+    Node* merged = Ideal_merge_stores(phase);
+    if (merged != NULL) {
+      return merged;
+    }
+  }
+
   return NULL;                  // No further progress
 }
 
+//------------------------------StoreAddress-----------------------------------
+// Decomposition of a store address into base + (var << shift) + con, with at
+// most one variable term. Two stores into the same array are adjacent if
+// they agree on base and variable term and their constant offsets differ by
+// the store size.
+class StoreAddress : public StackObj {
+ private:
+  Node* _base;
+  Node* _var;
+  int   _shift;
+  jlong _con;
+  bool  _valid;
+
+  bool add_var(Node* var, int shift) {
+    if (_var != NULL) {
+      return false;
+    }
+    _var   = var;
+    _shift = shift;
+    return true;
+  }
+
+  bool add_term(Node* t, int shift, PhaseGVN* phase) {
+    const TypeLong* tl = phase->type(t)->isa_long();
+    if (tl != NULL && tl->is_con()) {
+      _con += tl->get_con() * ((jlong)1 << shift);
+      return true;
+    }
+    switch (t->Opcode()) {
+    case Op_AddL:
+      return add_term(t->in(1), shift, phase) &&
+             add_term(t->in(2), shift, phase);
+    case Op_LShiftL: {
+      const TypeInt* ts = phase->type(t->in(2))->isa_int();
+      if (ts == NULL || !ts->is_con()) {
+        return add_var(t, shift);
+      }
+      int s = shift + (ts->get_con() & (BitsPerJavaLong - 1));
+      return s < BitsPerJavaLong && add_term(t->in(1), s, phase);
+    }
+    case Op_ConvI2L: {
+      Node* i = t->in(1);
+      // ConvI2L(AddI(i, con)) == AddL(ConvI2L(i), con) holds for array
+      // indices: both i and i + con have passed a range check.
+      if (i->Opcode() == Op_AddI) {
+        const TypeInt* ti = phase->type(i->in(2))->isa_int();
+        if (ti != NULL && ti->is_con()) {
+          _con += (jlong)ti->get_con() * ((jlong)1 << shift);
+          i = i->in(1);
+        }
+      }
+      return add_var(i, shift);
+    }
+    default:
+      return add_var(t, shift);
+    }
+  }
+
+ public:
+  StoreAddress(Node* adr, PhaseGVN* phase)
+    : _base(NULL), _var(NULL), _shift(0), _con(0), _valid(false) {
+    Node* n = adr;
+    while (n->is_AddP()) {
+      Node* base = n->in(AddPNode::Base);
+      if (_base == NULL) {
+        _base = base;
+      } else if (_base != base) {
+        return;
+      }
+      if (!add_term(n->in(AddPNode::Offset), 0, phase)) {
+        return;
+      }
+      n = n->in(AddPNode::Address);
+    }
+    _valid = (_base != NULL && n == _base);
+  }
+
+  bool  is_valid() const { return _valid; }
+  bool  has_var()  const { return _var != NULL; }
+  jlong con()      const { return _con; }
+
+  bool same_region(const StoreAddress& other) const {
+    return _valid && other._valid && _base == other._base &&
+           _var == other._var && (_var == NULL || _shift == other._shift);
+  }
+};
+
+// Can 'def', the memory input of 'use', be merged with it?
+static bool is_mergeable_store_pair(const StoreNode* use, Node* def, PhaseGVN* phase) {
+  if (def->Opcode() != use->Opcode() || def->outcnt() != 1) {
+    return false;
+  }
+  const StoreNode* st = def->as_Store();
+  return st->in(MemNode::Control) == use->in(MemNode::Control) &&
+         st->is_unordered() && !st->is_mismatched_access() &&
+         phase->C->get_alias_index(st->adr_type()) == phase->C->get_alias_index(use->adr_type());
+}
+
+// Split a stored value into the value it was extracted from and the
+// shift (in bits) it was extracted at: x, x >> s, (int)l or (int)(l >> s).
+static Node* stored_value_source(Node* val, PhaseGVN* phase, int& shift) {
+  shift = 0;
+  int lshift_op = Op_RShiftI;
+  int ushift_op = Op_URShiftI;
+  int mask = BitsPerJavaInteger - 1;
+  if (val->Opcode() == Op_ConvL2I) {
+    val = val->in(1);
+    lshift_op = Op_RShiftL;
+    ushift_op = Op_URShiftL;
+    mask = BitsPerJavaLong - 1;
+  }
+  if (val->Opcode() == lshift_op || val->Opcode() == ushift_op) {
+    const TypeInt* t = phase->type(val->in(2))->isa_int();
+    if (t != NULL && t->is_con()) {
+      shift = t->get_con() & mask;
+      return val->in(1);
+    }
+  }
+  return val;
+}
+
+//------------------------------Ideal_merge_stores-----------------------------
+// Replace a chain of adjacent StoreB/StoreC/StoreI to array elements under
+// the same control, each only feeding the next one, by a single StoreC/StoreI/StoreL when the
+// stored values are all constants or are consecutive pieces of one value,
+// e.g.:
+//
+//   a[i] = (byte)v; a[i+1] = (byte)(v >> 8); a[i+2] = (byte)(v >> 16); ...
+//
+// Pieces stored in the opposite of the platform byte order are merged
+// through ReverseBytes. This is done after loop opts, once range check
+// smearing has removed the range checks between the stores.
+Node* StoreNode::Ideal_merge_stores(PhaseGVN* phase) {
+  int opc = Opcode();
+  if ((opc != Op_StoreB && opc != Op_StoreC && opc != Op_StoreI) ||
+      !is_unordered() || is_mismatched_access() ||
+      !is_mergeable_store_pair(this, in(MemNode::Memory), phase)) {
+    return NULL;
+  }
+  if (!phase->C->post_loop_opts_phase()) {
+    phase->C->record_for_post_loop_opts_igvn(this); // attempt the transformation once loop opts are over
+    return NULL;
+  }
+
+  // Stores to different fields have different alias indexes, so only the
+  // elements of an array can form a chain.
+  if (adr_type()->isa_aryptr() == NULL) {
+    return NULL;
+  }
+
+  const int size = memory_size();
+  StoreAddress adr(in(MemNode::Address), phase);
+  if (!adr.is_valid()) {
+    return NULL;
+  }
+
+  // Only the last store of the chain does the merge.
+  if (outcnt() == 1 && raw_out(0)->is_Store() && raw_out(0)->in(MemNode::Memory) == this &&
+      is_mergeable_store_pair(raw_out(0)->as_Store(), this, phase)) {
+    StoreAddress use_adr(raw_out(0)->in(MemNode::Address), phase);
+    jlong d = use_adr.con() - adr.con();
+    if (use_adr.same_region(adr) && (d == size || d == -size)) {
+      return NULL;
+    }
+  }
+
+  // Walk up the memory chain, collecting stores at consecutive offsets.
+  StoreNode* stores[BytesPerLong];
+  int count = 0;
+  jlong step = 0;
+  jlong last_con = adr.con();
+  stores[count++] = this;
+  for (Node* def = in(MemNode::Memory);
+       count < BytesPerLong / size && is_mergeable_store_pair(stores[count - 1], def, phase);
+       def = def->in(MemNode::Memory)) {
+    StoreAddress def_adr(def->in(MemNode::Address), phase);
+    jlong d = def_adr.con() - last_con;
+    if (!def_adr.same_region(adr) || (d != size && d != -size) || (step != 0 && d != step)) {
+      break;
+    }
+    step = d;
+    last_con = def_adr.con();
+    stores[count++] = def->as_Store();
+  }
+  const int n = round_down_power_of_2(count);
+  if (n < 2) {
+    return NULL;
+  }
+
+  // Order the pieces by address, lowest first.
+  StoreNode* pieces[BytesPerLong];
+  for (int j = 0; j < n; j++) {
+    pieces[j] = (step < 0) ? stores[n - 1 - j] : stores[j];
+  }
+  StoreNode* lowest = pieces[0];
+  const int merged_size = n * size;
+  if (!UseUnalignedAccesses) {
+    StoreAddress lowest_adr(lowest->in(MemNode::Address), phase);
+    if (lowest_adr.has_var() || (lowest_adr.con() % merged_size) != 0) {
+      return NULL;
+    }
+  }
+
+  const int bits = size * BitsPerByte;
+#ifdef VM_LITTLE_ENDIAN
+  const bool little_endian = true;
+#else
+  const bool little_endian = false;
+#endif
+
+  Node* val = NULL;
+  julong con = 0;
+  bool all_con = true;
+  for (int j = 0; j < n && all_con; j++) {
+    const TypeInt* t = phase->type(pieces[j]->in(MemNode::ValueIn))->isa_int();
+    if (t != NULL && t->is_con()) {
+      int sig = little_endian ? j : n - 1 - j;
+      con |= ((julong)t->get_con() & (((julong)1 << bits) - 1)) << (sig * bits);
+    } else {
+      all_con = false;
+    }
+  }
+  if (all_con) {
+    if (merged_size == BytesPerLong) {
+      val = phase->longcon((jlong)con);
+    } else {
+      val = phase->intcon((jint)con);
+    }
+  } else {
+    // All pieces must come from the same value, at consecutive shifts in
+    // either byte order.
+    int shift = 0;
+    Node* src = stored_value_source(lowest->in(MemNode::ValueIn), phase, shift);
+    const int width = (src->bottom_type()->isa_long() != NULL) ? BitsPerJavaLong : BitsPerJavaInteger;
+    bool in_le_order = true;
+    bool in_be_order = true;
+    for (int j = 0; j < n; j++) {
+      Node* s = stored_value_source(pieces[j]->in(MemNode::ValueIn), phase, shift);
+      if (s != src || shift + bits > width) {
+        return NULL;
+      }
+      in_le_order = in_le_order && (shift == j * bits);
+      in_be_order = in_be_order && (shift == (n - 1 - j) * bits);
+    }
+    if (!in_le_order && !in_be_order) {
+      return NULL;
+    }
+    if (merged_size == BytesPerLong) {
+      assert(width == BitsPerJavaLong, "pieces of a long");
+      val = src;
+    } else if (width == BitsPerJavaLong) {
+      val = phase->transform(new ConvL2INode(src));
+    } else {
+      val = src;
+    }
+    if (in_le_order != little_endian) {
+      // Reversing the bytes only reverses the order of byte pieces.
+      if (size != 1) {
+        return NULL;
+      }
+      switch (merged_size) {
+      case BytesPerShort:
+        if (!Matcher::match_rule_supported(Op_ReverseBytesUS)) return NULL;
+        val = phase->transform(new ReverseBytesUSNode(NULL, val));
+        break;
+      case BytesPerInt:
+        if (!Matcher::match_rule_supported(Op_ReverseBytesI)) return NULL;
+        val = phase->transform(new ReverseBytesINode(NULL, val));
+        break;
+      default:
+        if (!Matcher::match_rule_supported(Op_ReverseBytesL)) return NULL;
+        val = phase->transform(new ReverseBytesLNode(NULL, val));
+        break;
+      }
+    }
+  }
+
+  BasicType bt = (merged_size == BytesPerShort) ? T_CHAR : (merged_size == BytesPerInt) ? T_INT : T_LONG;
+  StoreNode* top = stores[n - 1];
+  StoreNode* st = StoreNode::make(*phase, in(MemNode::Control), top->in(MemNode::Memory),
+                                  lowest->in(MemNode::Address), lowest->adr_type(), val, bt, MemNode::unordered);
+  st->set_mismatched_access();
+  return st;
+}
+
 //------------------------------Value-----------------------------------------
 const Type* StoreNode::Value(PhaseGVN* phase) const {
   // Either input is TOP ==> the result is TOP
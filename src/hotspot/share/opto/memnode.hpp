@@ -566,6 +566,7 @@ protected:
 
   Node *Ideal_masked_input       (PhaseGVN *phase, uint mask);
   Node *Ideal_sign_extended_input(PhaseGVN *phase, int  num_bits);
+  Node* Ideal_merge_stores(PhaseGVN* phase);
 
 public:
   // We must ensure that stores of object references will be visible
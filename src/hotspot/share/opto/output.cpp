@@ -334,6 +334,27 @@ void PhaseOutput::perform_mach_node_analysis() {
   pd_perform_mach_node_analysis();
 }
 
+// A method without loops, calls or safepoints can never be the top frame at
+// a safepoint or handshake, and it always returns into the frame that called
+// it, which is running and so already processed by any stack watermark.
+// Its return poll can therefore be omitted: the time to safepoint is bounded
+// by the straight-line code until the caller's next poll.
+bool PhaseOutput::is_leaf_without_loops() const {
+  if (!C->is_method_compilation() || C->has_loops()) {
+    return false;
+  }
+  for (uint i = 0; i < C->cfg()->number_of_blocks(); i++) {
+    Block* block = C->cfg()->get_block(i);
+    for (uint j = 0; j < block->number_of_nodes(); j++) {
+      Node* n = block->get_node(j);
+      if (n->is_MachSafePoint()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 // Convert Nodes to instruction bits and pass off to the VM
 void PhaseOutput::Output() {
   // RootNode goes
@@ -384,12 +405,13 @@ void PhaseOutput::Output() {
   }
 
   // Insert epilogs before every return
+  bool return_poll = !ElideLeafReturnPolls || !is_leaf_without_loops();
   for (uint i = 0; i < C->cfg()->number_of_blocks(); i++) {
     Block* block = C->cfg()->get_block(i);
     if (!block->is_connector() && block->non_connector_successor(0) == C->cfg()->get_root_block()) { // Found a program exit point?
       Node* m = block->end();
       if (m->is_Mach() && m->as_Mach()->ideal_Opcode() != Op_Halt) {
-        MachEpilogNode* epilog = new MachEpilogNode(m->as_Mach()->ideal_Opcode() == Op_Return);
+        MachEpilogNode* epilog = new MachEpilogNode(return_poll && m->as_Mach()->ideal_Opcode() == Op_Return);
         block->add_inst(epilog);
         C->cfg()->map_node_to_block(epilog, block);
       }
@@ -145,6 +145,7 @@ private:
   uint                   _index;
 
   void perform_mach_node_analysis();
+  bool is_leaf_without_loops() const;
   void pd_perform_mach_node_analysis();
 
 public:
@@ -1868,7 +1868,8 @@ Node_List* CMoveKit::make_cmovevd_pack(Node_List* cmovd_pk) {
   if (!cmovd->is_CMove()) {
     return NULL;
   }
-  if (cmovd->Opcode() != Op_CMoveF && cmovd->Opcode() != Op_CMoveD) {
+  bool is_blend = cmovd->Opcode() == Op_CMoveI || cmovd->Opcode() == Op_CMoveL;
+  if (cmovd->Opcode() != Op_CMoveF && cmovd->Opcode() != Op_CMoveD && !is_blend) {
     return NULL;
   }
   if (pack(cmovd) != NULL) { // already in the cmov pack
@@ -1907,7 +1908,7 @@ Node_List* CMoveKit::make_cmovevd_pack(Node_List* cmovd_pk) {
     return NULL;
   }
 
-  if (!test_cmpd_pack(cmpd_pk, cmovd_pk)) {
+  if (is_blend ? !test_cmp_blend_pack(cmpd_pk, cmovd_pk) : !test_cmpd_pack(cmpd_pk, cmovd_pk)) {
     NOT_PRODUCT(if(_sw->is_trace_cmov()) {tty->print("CMoveKit::make_cmovevd_pack: cmpd pack for CmpD %d failed vectorization test", cmpd->_idx); cmpd->dump();})
     return NULL;
   }
@@ -1924,6 +1925,10 @@ Node_List* CMoveKit::make_cmovevd_pack(Node_List* cmovd_pk) {
     map(cmov, new_cmpd_pk);
     map(bol, new_cmpd_pk);
     map(cmp, new_cmpd_pk);
+    if (is_blend) {
+      // The compare operands become vectors of the selected type.
+      _sw->set_velt_type(cmp, _sw->velt_type(cmov));
+    }
 
     _sw->set_my_pack(cmov, new_cmpd_pk); // and keep old packs for cmp and bool
   }
@@ -1991,6 +1996,48 @@ bool CMoveKit::test_cmpd_pack(Node_List* cmpd_pk, Node_List* cmovd_pk) {
   return true;
 }
 
+// Integral CMoves are vectorized as a VectorMaskCmp feeding a VectorBlend, so
+// unlike test_cmpd_pack() the compared values need not be the selected ones.
+bool CMoveKit::test_cmp_blend_pack(Node_List* cmp_pk, Node_List* cmov_pk) {
+  Node* cmp0  = cmp_pk->at(0);
+  Node* cmov0 = cmov_pk->at(0);
+  assert(cmp0->is_Cmp(), "CMoveKit::test_cmp_blend_pack: should be CmpNode");
+  assert(cmov0->is_CMove(), "CMoveKit::test_cmp_blend_pack: should be CMove");
+  assert(cmp_pk->size() == cmov_pk->size(), "CMoveKit::test_cmp_blend_pack: should be same size");
+  BasicType bt = _sw->velt_basic_type(cmov0);
+  uint vlen = cmov_pk->size();
+
+  // The mask lanes must line up with the selected lanes.
+  if (!(cmp0->Opcode() == Op_CmpI && bt == T_INT) &&
+      !(cmp0->Opcode() == Op_CmpL && bt == T_LONG)) {
+    return false;
+  }
+  BoolTest::mask test = cmov0->in(CMoveNode::Condition)->as_Bool()->_test._test;
+  switch (test) {
+    case BoolTest::eq: case BoolTest::ne:
+    case BoolTest::lt: case BoolTest::le:
+    case BoolTest::gt: case BoolTest::ge:
+      break;
+    default:
+      return false;
+  }
+  for (uint j = 1; j < vlen; j++) {
+    if (cmov_pk->at(j)->in(CMoveNode::Condition)->as_Bool()->_test._test != test) {
+      return false;
+    }
+  }
+  if (!Matcher::match_rule_supported_vector(Op_VectorMaskCmp, vlen, bt) ||
+      !Matcher::match_rule_supported_vector(Op_VectorBlend, vlen, bt)) {
+    return false;
+  }
+  // Both compare operands must be packs of the same shape or the same scalar.
+  if (!_sw->is_vector_use(cmp0, 1) || !_sw->is_vector_use(cmp0, 2)) {
+    return false;
+  }
+  NOT_PRODUCT(if(_sw->is_trace_cmov()) { tty->print("CMoveKit::test_cmp_blend_pack: cmp pack for 1st Cmp %d is OK for vectorization: ", cmp0->_idx); cmp0->dump(); })
+  return true;
+}
+
 //------------------------------implemented---------------------------
 // Can code be generated for pack p?
 bool SuperWord::implemented(Node_List* p) {
@@ -2408,6 +2455,7 @@ void SuperWord::output() {
   if (cl->is_main_loop()) {
     // MUST ENSURE main loop's initial value is properly aligned:
     //  (iv_initial_value + min_iv_offset) % vector_width_in_bytes() == 0
+    // unless misaligned vectors are fine and the trip count is short.
 
     align_initial_loop_index(align_to_ref());
 
@@ -2584,13 +2632,6 @@ void SuperWord::output() {
           ShouldNotReachHere();
         }
 
-        int cond = (int)bol->as_Bool()->_test._test;
-        Node* in_cc  = _igvn.intcon(cond);
-        NOT_PRODUCT(if(is_trace_cmov()) {tty->print("SWPointer::output: created intcon in_cc node %d", in_cc->_idx); in_cc->dump();})
-        Node* cc = bol->clone();
-        cc->set_req(1, in_cc);
-        NOT_PRODUCT(if(is_trace_cmov()) {tty->print("SWPointer::output: created bool cc node %d", cc->_idx); cc->dump();})
-
         Node* src1 = vector_opd(p, 2); //2=CMoveNode::IfFalse
         if (src1 == NULL) {
           if (do_reserve_copy()) {
@@ -2609,12 +2650,36 @@ void SuperWord::output() {
         }
         BasicType bt = velt_basic_type(n);
         const TypeVect* vt = TypeVect::make(bt, vlen);
-        assert(bt == T_FLOAT || bt == T_DOUBLE, "Only vectorization for FP cmovs is supported");
-        if (bt == T_FLOAT) {
-          vn = new CMoveVFNode(cc, src1, src2, vt);
+        BoolTest::mask pred = bol->as_Bool()->_test._test;
+        if (bt == T_INT || bt == T_LONG) {
+          // Compare into a lane mask and blend the selected vectors with it.
+          Node_List* cmp_pk = my_pack(bol->in(1));
+          Node* cmp_in1 = (cmp_pk != NULL) ? vector_opd(cmp_pk, 1) : NULL;
+          Node* cmp_in2 = (cmp_pk != NULL) ? vector_opd(cmp_pk, 2) : NULL;
+          if (cmp_in1 == NULL || cmp_in2 == NULL) {
+            if (do_reserve_copy()) {
+              NOT_PRODUCT(if(is_trace_loop_reverse() || TraceLoopOpts) {tty->print_cr("SWPointer::output: compare operands should not be NULL, exiting SuperWord");})
+              return; //and reverse to backup IG
+            }
+            ShouldNotReachHere();
+          }
+          Node* mask = new VectorMaskCmpNode(pred, cmp_in1, cmp_in2, _igvn.intcon(pred), vt);
+          _igvn.register_new_node_with_optimizer(mask);
+          _phase->set_ctrl(mask, _phase->get_ctrl(p->at(0)));
+          NOT_PRODUCT(if(is_trace_cmov()) {tty->print("SWPointer::output: created new VectorMaskCmp node %d: ", mask->_idx); mask->dump();})
+          vn = new VectorBlendNode(src1, src2, mask);
         } else {
-          assert(bt == T_DOUBLE, "Expected double");
-          vn = new CMoveVDNode(cc, src1, src2, vt);
+          Node* in_cc  = _igvn.intcon((int)pred);
+          NOT_PRODUCT(if(is_trace_cmov()) {tty->print("SWPointer::output: created intcon in_cc node %d", in_cc->_idx); in_cc->dump();})
+          Node* cc = bol->clone();
+          cc->set_req(1, in_cc);
+          NOT_PRODUCT(if(is_trace_cmov()) {tty->print("SWPointer::output: created bool cc node %d", cc->_idx); cc->dump();})
+          if (bt == T_FLOAT) {
+            vn = new CMoveVFNode(cc, src1, src2, vt);
+          } else {
+            assert(bt == T_DOUBLE, "Expected double");
+            vn = new CMoveVDNode(cc, src1, src2, vt);
+          }
         }
         NOT_PRODUCT(if(is_trace_cmov()) {tty->print("SWPointer::output: created new CMove node %d: ", vn->_idx); vn->dump();})
       } else if (opc == Op_FmaD || opc == Op_FmaF) {
@@ -3581,6 +3646,26 @@ void SuperWord::align_initial_loop_index(MemNode* align_to_ref) {
   _igvn.register_new_node_with_optimizer(N);
   _phase->set_ctrl(N, pre_ctrl);
 
+  if (!vectors_should_be_aligned()) {
+    // Alignment only buys speed here. With a short trip count the up to
+    // V - 1 extra pre-loop iterations can leave too few iterations for the
+    // main loop to run at all, so only align if at least two main loop
+    // strides remain: |orig_limit - lim0| < 2 * |stride| ? 0 : N
+    Node* span = (stride > 0) ? (Node*) new SubINode(orig_limit, lim0)
+                              : (Node*) new SubINode(lim0, orig_limit);
+    _igvn.register_new_node_with_optimizer(span);
+    _phase->set_ctrl(span, pre_ctrl);
+    Node* cmp = new CmpINode(span, _igvn.intcon(2 * ABS(stride)));
+    _igvn.register_new_node_with_optimizer(cmp);
+    _phase->set_ctrl(cmp, pre_ctrl);
+    Node* bol = new BoolNode(cmp, BoolTest::lt);
+    _igvn.register_new_node_with_optimizer(bol);
+    _phase->set_ctrl(bol, pre_ctrl);
+    N = CMoveNode::make(NULL, bol, N, _igvn.intcon(0), TypeInt::INT);
+    _igvn.register_new_node_with_optimizer(N);
+    _phase->set_ctrl(N, pre_ctrl);
+  }
+
   //   substitute back into (1), so that new limit
   //     lim = lim0 + N
   Node* lim;
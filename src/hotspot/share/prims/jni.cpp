@@ -2422,6 +2422,13 @@ JNI_ENTRY_NO_PRESERVE(ElementType*, \
      * Return a pointer to something useless. \
      * Avoid asserts in typeArrayOop. */ \
     result = (ElementType*)get_bad_address(); \
+  } else if (PinJNIArrayElements && Universe::heap()->supports_object_pinning()) { \
+    /* Hand out the pinned array itself, see Release<Type>ArrayElements */ \
+    a = typeArrayOop(Universe::heap()->pin_object(thread, a)); \
+    result = a->Tag##_at_addr(0); \
+    if (isCopy != NULL) { \
+      *isCopy = JNI_FALSE; \
+    } \
   } else { \
     /* JNI Specification states return NULL on OOM */                    \
     result = NEW_C_HEAP_ARRAY_RETURN_NULL(ElementType, len, mtInternal); \
@@ -2474,7 +2481,12 @@ JNI_ENTRY_NO_PRESERVE(void, \
   EntryProbe; \
   typeArrayOop a = typeArrayOop(JNIHandles::resolve_non_null(array)); \
   int len = a->length(); \
-  if (len != 0) {   /* Empty array:  nothing to free or copy. */  \
+  if (len != 0 && buf == a->Tag##_at_addr(0)) { \
+    /* The array was pinned by Get<Type>ArrayElements, nothing to copy. */ \
+    if ((mode == 0) || (mode == JNI_ABORT)) { \
+      Universe::heap()->unpin_object(thread, a); \
+    } \
+  } else if (len != 0) {   /* Empty array:  nothing to free or copy. */  \
     if ((mode == 0) || (mode == JNI_COMMIT)) { \
       ArrayAccess<>::arraycopy_from_native(buf, a, typeArrayOopDesc::element_offset<ElementType>(0), len); \
     } \
@@ -978,11 +978,16 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
 
         if (mark.has_locker()) {
           owner = (address)mark.locker(); // save the address of the Lock word
+        } else if (mark.is_fast_locked()) {
+          owning_thread = Threads::owning_thread_from_object(tlh.list(), hobj());
         }
         // implied else: no owner
       } else {
         // this object has a heavyweight monitor
         mon = mark.monitor();
+        if (mon->is_owner_anonymous()) {
+          owning_thread = Threads::owning_thread_from_monitor(tlh.list(), mon);
+        }
 
         // The owner field of a heavyweight monitor may be NULL for no
         // owner, a JavaThread * or it may still be the address of the
@@ -994,15 +999,15 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
       }
     }
 
-    if (owner != NULL) {
+    if (owner != NULL && owning_thread == NULL) {
       // This monitor is owned so we have to find the owning JavaThread.
       owning_thread = Threads::owning_thread_from_monitor_owner(tlh.list(), owner);
       assert(owning_thread != NULL, "owning JavaThread must not be NULL");
+    }
+    if (owning_thread != NULL) {  // monitor is owned
       Handle     th(current_thread, owning_thread->threadObj());
       ret.owner = (jthread)jni_reference(calling_thread, th);
-    }
 
-    if (owning_thread != NULL) {  // monitor is owned
       // The recursions field of a monitor does not reflect recursions
       // as lightweight locks before inflating the monitor are not included.
       // We have to count the number of recursive monitor entries the hard way.
@@ -36,6 +36,8 @@
 #include "classfile/vmSymbols.hpp"
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "interpreter/oopMapCache.hpp"
 #include "interpreter/rewriter.hpp"
 #include "jfr/jfrEvents.hpp"
@@ -234,6 +236,26 @@ bool VM_RedefineClasses::doit_prologue() {
   return true;
 }
 
+class VM_RedefineClasses::AdjustAndCleanMetadataTask : public AbstractGangTask {
+  ClassLoaderDataGraphCLDIteratorAtomic _cld_iter;
+
+ public:
+  AdjustAndCleanMetadataTask() :
+    AbstractGangTask("Adjust And Clean Metadata"), _cld_iter() {}
+
+  void work(uint worker_id) {
+    // Each class only has its own vtable, itable, default methods,
+    // cpCaches and MethodData updated, so workers never touch the same
+    // metadata as long as they claim distinct CLDs.
+    AdjustAndCleanMetadata cl(Thread::current());
+    while (ClassLoaderData* cld = _cld_iter.next_cld()) {
+      if (cld->is_alive()) {
+        cld->classes_do(&cl);
+      }
+    }
+  }
+};
+
 void VM_RedefineClasses::doit() {
   Thread* current = Thread::current();
 
@@ -268,8 +290,13 @@ void VM_RedefineClasses::doit() {
   // that reference methods of the evolved classes.
   // Have to do this after all classes are redefined and all methods that
   // are redefined are marked as old.
-  AdjustAndCleanMetadata adjust_and_clean_metadata(current);
-  ClassLoaderDataGraph::classes_do(&adjust_and_clean_metadata);
+  WorkGang* workers = Universe::heap()->safepoint_workers();
+  AdjustAndCleanMetadataTask adjust_and_clean_metadata;
+  if (workers != NULL) {
+    workers->run_task(&adjust_and_clean_metadata);
+  } else {
+    adjust_and_clean_metadata.work(0);
+  }
 
   // JSR-292 support
   if (_any_class_has_resolved_methods) {
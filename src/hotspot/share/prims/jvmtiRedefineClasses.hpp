@@ -521,6 +521,10 @@ class VM_RedefineClasses: public VM_Operation {
     void do_klass(Klass* k);
   };
 
+  // Applies AdjustAndCleanMetadata to all loaded classes, with the CLDs
+  // claimed in parallel by the safepoint workers if the GC provides them.
+  class AdjustAndCleanMetadataTask;
+
  public:
   VM_RedefineClasses(jint class_count,
                      const jvmtiClassDefinition *class_defs,
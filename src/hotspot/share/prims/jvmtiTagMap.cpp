@@ -65,7 +65,9 @@
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
+#include "utilities/bitMap.inline.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/resourceHash.hpp"
 
 bool JvmtiTagMap::_has_object_free_events = false;
 
@@ -74,7 +76,6 @@ JvmtiTagMap::JvmtiTagMap(JvmtiEnv* env) :
   _env(env),
   _lock(Mutex::nonleaf+1, "JvmtiTagMap_lock", Mutex::_allow_vm_block_flag,
         Mutex::_safepoint_check_never),
-  _needs_rehashing(false),
   _needs_cleaning(false) {
 
   assert(JvmtiThreadState_lock->is_locked(), "sanity check");
@@ -133,9 +134,8 @@ bool JvmtiTagMap::is_empty() {
   return hashmap()->is_empty();
 }
 
-// This checks for posting and rehashing before operations that
-// this tagmap table.  The calls from a JavaThread only rehash, posting is
-// only done before heap walks.
+// This checks for posting before operations that use this tagmap table.
+// Posting is only done before heap walks.
 void JvmtiTagMap::check_hashmap(bool post_events) {
   assert(!post_events || SafepointSynchronize::is_at_safepoint(), "precondition");
   assert(is_locked(), "checking");
@@ -147,14 +147,9 @@ void JvmtiTagMap::check_hashmap(bool post_events) {
       env()->is_enabled(JVMTI_EVENT_OBJECT_FREE)) {
     remove_dead_entries_locked(true /* post_object_free */);
   }
-  if (_needs_rehashing) {
-    log_info(jvmti, table)("TagMap table needs rehashing");
-    hashmap()->rehash();
-    _needs_rehashing = false;
-  }
 }
 
-// This checks for posting and rehashing and is called from the heap walks.
+// This checks for posting and is called from the heap walks.
 void JvmtiTagMap::check_hashmaps_for_heapwalk() {
   assert(SafepointSynchronize::is_at_safepoint(), "called from safepoints");
 
@@ -1336,40 +1331,45 @@ jvmtiError JvmtiTagMap::get_objects_with_tags(const jlong* tags,
 // ObjectMarker is used to support the marking objects when walking the
 // heap.
 //
-// This implementation uses the existing mark bits in an object for
-// marking. Objects that are marked must later have their headers restored.
-// As most objects are unlocked and don't have their identity hash computed
-// we don't have to save their headers. Instead we save the headers that
-// are "interesting". Later when the headers are restored this implementation
-// restores all headers to their initial value and then restores the few
-// objects that had interesting headers.
-//
-// Future work: This implementation currently uses growable arrays to save
-// the oop and header of interesting objects. As an optimization we could
-// use the same technique as the GC and make use of the unused area
-// between top() and end().
-//
+// The marks are kept in a side bitmap rather than in the object headers,
+// so the headers and the identity hashes the tag map is keyed by stay
+// intact during the walk, and nothing has to be restored afterwards. The
+// bitmap is split into fragments that each cover an aligned granule of the
+// heap and are only allocated when an object in the granule is marked.
+class ObjectMarker : AllStatic {
+ private:
+  static const int    GranuleShift = 26;  // 64M
+  static const size_t GranuleSize = (size_t)1 << GranuleShift;
+
+  class Fragment : public CHeapObj<mtServiceability> {
+    CHeapBitMap _bits;
+   public:
+    Fragment() : _bits(GranuleSize >> LogMinObjAlignmentInBytes, mtServiceability) {}
+    CHeapBitMap* bits() { return &_bits; }
+  };
 
-// An ObjectClosure used to restore the mark bits of an object
-class RestoreMarksClosure : public ObjectClosure {
- public:
-  void do_object(oop o) {
-    if (o != NULL) {
-      markWord mark = o->mark();
-      if (mark.is_marked()) {
-        o->init_mark();
-      }
+  class FreeFragmentClosure : public StackObj {
+   public:
+    bool do_entry(const uintptr_t& granule, Fragment* const& fragment) {
+      delete fragment;
+      return true;
     }
-  }
-};
+  };
 
-// ObjectMarker provides the mark and visited functions
-class ObjectMarker : AllStatic {
- private:
-  // saved headers
-  static GrowableArray<oop>* _saved_oop_stack;
-  static GrowableArray<markWord>* _saved_mark_stack;
-  static bool _needs_reset;                  // do we need to reset mark bits?
+  typedef ResourceHashtable<uintptr_t, Fragment*,
+                            primitive_hash<uintptr_t>, primitive_equals<uintptr_t>,
+                            1031, ResourceObj::C_HEAP, mtServiceability> FragmentTable;
+
+  static FragmentTable* _fragments;
+  // The fragment used last, as objects are often visited near each other.
+  static uintptr_t      _last_granule;
+  static Fragment*      _last_fragment;
+
+  static Fragment* fragment(uintptr_t addr, bool create);
+
+  static BitMap::idx_t bit_index(uintptr_t addr) {
+    return (addr & (GranuleSize - 1)) >> LogMinObjAlignmentInBytes;
+  }
 
  public:
   static void init();                       // initialize
@@ -1377,14 +1377,11 @@ class ObjectMarker : AllStatic {
 
   static inline void mark(oop o);           // mark an object
   static inline bool visited(oop o);        // check if object has been visited
-
-  static inline bool needs_reset()            { return _needs_reset; }
-  static inline void set_needs_reset(bool v)  { _needs_reset = v; }
 };
 
-GrowableArray<oop>* ObjectMarker::_saved_oop_stack = NULL;
-GrowableArray<markWord>* ObjectMarker::_saved_mark_stack = NULL;
-bool ObjectMarker::_needs_reset = true;  // need to reset mark bits by default
+ObjectMarker::FragmentTable* ObjectMarker::_fragments = NULL;
+uintptr_t ObjectMarker::_last_granule = 0;
+ObjectMarker::Fragment* ObjectMarker::_last_fragment = NULL;
 
 // initialize ObjectMarker - prepares for object marking
 void ObjectMarker::init() {
@@ -1394,56 +1391,55 @@ void ObjectMarker::init() {
   // prepare heap for iteration
   Universe::heap()->ensure_parsability(false);  // no need to retire TLABs
 
-  // create stacks for interesting headers
-  _saved_mark_stack = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<markWord>(4000, mtServiceability);
-  _saved_oop_stack = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<oop>(4000, mtServiceability);
+  _fragments = new (ResourceObj::C_HEAP, mtServiceability) FragmentTable();
+  _last_granule = 0;
+  _last_fragment = NULL;
 }
 
-// Object marking is done so restore object headers
+// Object marking is done so free the bitmap
 void ObjectMarker::done() {
-  // iterate over all objects and restore the mark bits to
-  // their initial value
-  RestoreMarksClosure blk;
-  if (needs_reset()) {
-    Universe::heap()->object_iterate(&blk);
+  FreeFragmentClosure free_fragments;
+  _fragments->iterate(&free_fragments);
+  delete _fragments;
+  _fragments = NULL;
+  _last_fragment = NULL;
+}
+
+ObjectMarker::Fragment* ObjectMarker::fragment(uintptr_t addr, bool create) {
+  uintptr_t granule = addr >> GranuleShift;
+  if (_last_fragment != NULL && _last_granule == granule) {
+    return _last_fragment;
+  }
+
+  Fragment** found = _fragments->get(granule);
+  Fragment* result;
+  if (found != NULL) {
+    result = *found;
+  } else if (create) {
+    result = new Fragment();
+    _fragments->put(granule, result);
   } else {
-    // We don't need to reset mark bits on this call, but reset the
-    // flag to the default for the next call.
-    set_needs_reset(true);
+    return NULL;
   }
-
-  // now restore the interesting headers
-  for (int i = 0; i < _saved_oop_stack->length(); i++) {
-    oop o = _saved_oop_stack->at(i);
-    markWord mark = _saved_mark_stack->at(i);
-    o->set_mark(mark);
-  }
-
-  // free the stacks
-  delete _saved_oop_stack;
-  delete _saved_mark_stack;
+  _last_granule = granule;
+  _last_fragment = result;
+  return result;
 }
 
 // mark an object
 inline void ObjectMarker::mark(oop o) {
   assert(Universe::heap()->is_in(o), "sanity check");
-  assert(!o->mark().is_marked(), "should only mark an object once");
-
-  // object's mark word
-  markWord mark = o->mark();
-
-  if (o->mark_must_be_preserved(mark)) {
-    _saved_mark_stack->push(mark);
-    _saved_oop_stack->push(o);
-  }
+  assert(!visited(o), "should only mark an object once");
 
-  // mark the object
-  o->set_mark(markWord::prototype().set_marked());
+  uintptr_t addr = cast_from_oop<uintptr_t>(o);
+  fragment(addr, true /* create */)->bits()->set_bit(bit_index(addr));
 }
 
 // return true if object is marked
 inline bool ObjectMarker::visited(oop o) {
-  return o->mark().is_marked();
+  uintptr_t addr = cast_from_oop<uintptr_t>(o);
+  Fragment* f = fragment(addr, false /* create */);
+  return f != NULL && f->bits()->at(bit_index(addr));
 }
 
 // Stack allocated class to help ensure that ObjectMarker is used
@@ -2927,20 +2923,12 @@ void VM_HeapWalkOperation::doit() {
 
   // the heap walk starts with an initial object or the heap roots
   if (initial_object().is_null()) {
-    // If either collect_stack_roots() or collect_simple_roots()
-    // returns false at this point, then there are no mark bits
-    // to reset.
-    ObjectMarker::set_needs_reset(false);
-
     // Calling collect_stack_roots() before collect_simple_roots()
     // can result in a big performance boost for an agent that is
     // focused on analyzing references in the thread stacks.
     if (!collect_stack_roots()) return;
 
     if (!collect_simple_roots()) return;
-
-    // no early return so enable heap traversal to reset the mark bits
-    ObjectMarker::set_needs_reset(true);
   } else {
     visit_stack()->push(initial_object()());
   }
@@ -3009,21 +2997,6 @@ void JvmtiTagMap::follow_references(jint heap_filter,
   VMThread::execute(&op);
 }
 
-// Concurrent GC needs to call this in relocation pause, so after the objects are moved
-// and have their new addresses, the table can be rehashed.
-void JvmtiTagMap::set_needs_rehashing() {
-  assert(SafepointSynchronize::is_at_safepoint(), "called in gc pause");
-  assert(Thread::current()->is_VM_thread(), "should be the VM thread");
-
-  JvmtiEnvIterator it;
-  for (JvmtiEnv* env = it.first(); env != NULL; env = it.next(env)) {
-    JvmtiTagMap* tag_map = env->tag_map_acquire();
-    if (tag_map != NULL) {
-      tag_map->_needs_rehashing = true;
-    }
-  }
-}
-
 // Verify gc_notification follows set_needs_cleaning.
 DEBUG_ONLY(static bool notified_needs_cleaning = false;)
 
@@ -40,7 +40,6 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
   JvmtiEnv*             _env;                       // the jvmti environment
   Mutex                 _lock;                      // lock for this tag map
   JvmtiTagMapTable*     _hashmap;                   // the hashmap for tags
-  bool                  _needs_rehashing;
   bool                  _needs_cleaning;
 
   static bool           _has_object_free_events;
@@ -114,7 +113,6 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
   void remove_dead_entries_locked(bool post_object_free);
 
   static void check_hashmaps_for_heapwalk();
-  static void set_needs_rehashing() NOT_JVMTI_RETURN;
   static void set_needs_cleaning() NOT_JVMTI_RETURN;
   static void gc_notification(size_t num_dead_entries) NOT_JVMTI_RETURN;
 
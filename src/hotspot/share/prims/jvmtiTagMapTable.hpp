@@ -89,7 +89,6 @@ public:
 
   // Cleanup cleared entries and post
   void remove_dead_entries(JvmtiEnv* env, bool post_object_free);
-  void rehash();
   void clear();
 };
 
@@ -387,31 +387,53 @@ UNSAFE_ENTRY(void, Unsafe_FreeMemory0(JNIEnv *env, jobject unsafe, jlong addr))
   os::free(p);
 } UNSAFE_END
 
-UNSAFE_ENTRY(void, Unsafe_SetMemory0(JNIEnv *env, jobject unsafe, jobject obj, jlong offset, jlong size, jbyte value)) {
+static void copy_unsafe_memory(JavaThread* thread, void* src, void* dst, size_t sz) {
+  GuardUnsafeAccess guard(thread);
+  if (StubRoutines::unsafe_arraycopy() != NULL) {
+    MACOS_AARCH64_ONLY(ThreadWXEnable wx(WXExec, thread));
+    StubRoutines::UnsafeArrayCopy_stub()(src, dst, sz);
+  } else {
+    Copy::conjoint_memory_atomic(src, dst, sz);
+  }
+}
+
+// SetMemory0 and CopyMemory0 are leaves when only native memory is involved,
+// like CopySwapMemory0 below, so that large fills and copies don't hold off
+// safepoints. If the memory is on the heap they enter the VM.
+UNSAFE_LEAF(void, Unsafe_SetMemory0(JNIEnv *env, jobject unsafe, jobject obj, jlong offset, jlong size, jbyte value)) {
   size_t sz = (size_t)size;
 
-  oop base = JNIHandles::resolve(obj);
-  void* p = index_oop_from_field_offset_long(base, offset);
+  if (obj == NULL) {
+    JavaThread* thread = JavaThread::thread_from_jni_environment(env);
+    GuardUnsafeAccess guard(thread);
+    Copy::fill_to_memory_atomic(addr_from_java(offset), sz, value);
+  } else {
+    JVM_ENTRY_FROM_LEAF(env, void, Unsafe_SetMemory0) {
+      oop base = JNIHandles::resolve(obj);
+      void* p = index_oop_from_field_offset_long(base, offset);
 
-  Copy::fill_to_memory_atomic(p, sz, value);
+      GuardUnsafeAccess guard(thread);
+      Copy::fill_to_memory_atomic(p, sz, value);
+    } JVM_END
+  }
 } UNSAFE_END
 
-UNSAFE_ENTRY(void, Unsafe_CopyMemory0(JNIEnv *env, jobject unsafe, jobject srcObj, jlong srcOffset, jobject dstObj, jlong dstOffset, jlong size)) {
+UNSAFE_LEAF(void, Unsafe_CopyMemory0(JNIEnv *env, jobject unsafe, jobject srcObj, jlong srcOffset, jobject dstObj, jlong dstOffset, jlong size)) {
   size_t sz = (size_t)size;
 
-  oop srcp = JNIHandles::resolve(srcObj);
-  oop dstp = JNIHandles::resolve(dstObj);
+  if (srcObj == NULL && dstObj == NULL) {
+    // Both src & dst are in native memory
+    JavaThread* thread = JavaThread::thread_from_jni_environment(env);
+    copy_unsafe_memory(thread, addr_from_java(srcOffset), addr_from_java(dstOffset), sz);
+  } else {
+    JVM_ENTRY_FROM_LEAF(env, void, Unsafe_CopyMemory0) {
+      oop srcp = JNIHandles::resolve(srcObj);
+      oop dstp = JNIHandles::resolve(dstObj);
 
-  void* src = index_oop_from_field_offset_long(srcp, srcOffset);
-  void* dst = index_oop_from_field_offset_long(dstp, dstOffset);
-  {
-    GuardUnsafeAccess guard(thread);
-    if (StubRoutines::unsafe_arraycopy() != NULL) {
-      MACOS_AARCH64_ONLY(ThreadWXEnable wx(WXExec, thread));
-      StubRoutines::UnsafeArrayCopy_stub()(src, dst, sz);
-    } else {
-      Copy::conjoint_memory_atomic(src, dst, sz);
-    }
+      void* src = index_oop_from_field_offset_long(srcp, srcOffset);
+      void* dst = index_oop_from_field_offset_long(dstp, dstOffset);
+      copy_unsafe_memory(thread, src, dst, sz);
+    } JVM_END
   }
 } UNSAFE_END
 
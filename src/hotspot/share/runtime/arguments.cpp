@@ -2012,6 +2012,20 @@ bool Arguments::check_vm_args_consistency() {
   }
 #endif
 
+#if !(defined(AMD64) || defined(AARCH64)) || defined(ZERO)
+  if (UseLightweightLocking) {
+    FLAG_SET_CMDLINE(UseLightweightLocking, false);
+    warning("Lightweight locking not supported on this platform");
+  }
+#endif
+#if INCLUDE_JVMCI
+  if (UseLightweightLocking && EnableJVMCI) {
+    // JVMCI compilers emit their own stack-locking fast paths.
+    FLAG_SET_CMDLINE(UseLightweightLocking, false);
+    warning("Lightweight locking not supported with JVMCI");
+  }
+#endif
+
   return status;
 }
 
@@ -311,6 +311,18 @@ JVMFlag::Error InitArrayShortSizeConstraintFunc(intx value, bool verbose) {
   }
 }
 
+#ifdef COMPILER1
+JVMFlag::Error C1ProfileSampleIntervalConstraintFunc(intx value, bool verbose) {
+  if (!is_power_of_2(value)) {
+    JVMFlag::printError(verbose,
+                        "C1ProfileSampleInterval (" INTX_FORMAT ") must be "
+                        "a power of two\n", value);
+    return JVMFlag::VIOLATES_CONSTRAINT;
+  }
+  return JVMFlag::SUCCESS;
+}
+#endif // COMPILER1
+
 #ifdef COMPILER2
 JVMFlag::Error InteriorEntryAlignmentConstraintFunc(intx value, bool verbose) {
   if (InteriorEntryAlignment > CodeEntryAlignment) {
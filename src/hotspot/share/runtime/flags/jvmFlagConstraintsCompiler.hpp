@@ -53,6 +53,9 @@
   f(int ,  RTMTotalCountIncrRateConstraintFunc)         \
   f(ccstrlist, DisableIntrinsicConstraintFunc)          \
   f(ccstrlist, ControlIntrinsicConstraintFunc)          \
+COMPILER1_PRESENT(                                      \
+  f(intx,  C1ProfileSampleIntervalConstraintFunc)       \
+)                                                       \
 COMPILER2_PRESENT(                                      \
   f(intx,  InteriorEntryAlignmentConstraintFunc)        \
   f(intx,  NodeLimitFudgeFactorConstraintFunc)          \
@@ -291,6 +291,25 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseInlineCaches, true,                                      \
           "Use Inline Caches for virtual calls ")                           \
                                                                             \
+  product(bool, UseSecondarySupersBitmap, true, DIAGNOSTIC,                 \
+          "Consult a per-klass bitmap of the hashed secondary supers to "   \
+          "reject most failing subtype checks without scanning the "        \
+          "secondary supers array")                                         \
+                                                                            \
+  product(bool, UseItableSelectorTable, false, EXPERIMENTAL,                \
+          "Add a selector-indexed table of the implemented interfaces to "  \
+          "the itable of classes with many interfaces, so that itable "     \
+          "lookups can usually skip the linear scan")                       \
+                                                                            \
+  product(intx, ItableSelectorTableMinInterfaces, 8, EXPERIMENTAL,          \
+          "Minimum number of itable interfaces of a class for it to get "   \
+          "an itable selector table")                                       \
+          range(1, max_jint)                                                \
+                                                                            \
+  product(bool, StressItableSelectorCollisions, false, DIAGNOSTIC,          \
+          "Give all interfaces the same itable selector, so that all but "  \
+          "one interface of each class collide in its selector table")      \
+                                                                            \
   product(bool, InlineArrayCopy, true, DIAGNOSTIC,                          \
           "Inline arraycopy native that is known to be part of "            \
           "base library DLL")                                               \
@@ -537,7 +556,8 @@ const intx ObjectAlignmentInBytes = 8;
   product(ccstr, HeapDumpPath, NULL, MANAGEABLE,                            \
           "When HeapDumpOnOutOfMemoryError is on, the path (filename or "   \
           "directory) of the dump file (defaults to java_pid<pid>.hprof "   \
-          "in the working directory)")                                      \
+          "in the working directory). A named pipe, unix:<socket path> "    \
+          "or fd:<file descriptor> streams the dump instead")               \
                                                                             \
   product(intx, HeapDumpGzipLevel, 0, MANAGEABLE,                           \
           "When HeapDumpOnOutOfMemoryError is on, the gzip compression "    \
@@ -545,9 +565,24 @@ const intx ObjectAlignmentInBytes = 8;
           "compression. Otherwise the level must be between 1 and 9.")      \
           range(0, 9)                                                       \
                                                                             \
+  product(intx, HeapDumpZstdLevel, 0, MANAGEABLE,                           \
+          "When HeapDumpOnOutOfMemoryError is on, the zstd compression "    \
+          "level of the dump file. 0 (the default) disables zstd "          \
+          "compression. Otherwise the level must be between 1 and 19 and "  \
+          "takes precedence over HeapDumpGzipLevel. Requires the zstd "     \
+          "library of the system.")                                         \
+          range(0, 19)                                                      \
+                                                                            \
   product(ccstr, NativeMemoryTracking, "off",                               \
           "Native memory tracking options")                                 \
                                                                             \
+  product(uint, NMTMallocStackSamplingInterval, 1,                          \
+          "In NMT detail mode, capture the call stack of one in n mallocs " \
+          "on average, at random. Per call site figures are then scaled "   \
+          "estimates; the summary figures stay exact. 1 captures every "    \
+          "call stack")                                                     \
+          range(1, max_jint)                                                \
+                                                                            \
   product(bool, PrintNMTStatistics, false, DIAGNOSTIC,                      \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -681,6 +716,11 @@ const intx ObjectAlignmentInBytes = 8;
           "Allow parallel defineClass requests for class loaders "          \
           "registering as parallel capable")                                \
                                                                             \
+  product(bool, PrefetchBootClasses, false, EXPERIMENTAL,                   \
+          "Read the class files named in the class list from the runtime "  \
+          "image on a background thread ahead of the boot loader. Ignored " \
+          "when a CDS archive is mapped")                                   \
+                                                                            \
   product_pd(bool, DontYieldALot,                                           \
           "Throw away obvious excess yield calls")                          \
                                                                             \
@@ -707,6 +747,12 @@ const intx ObjectAlignmentInBytes = 8;
           "at one time (minimum is 1024).")                      \
           range(1024, max_jint)                                             \
                                                                             \
+  product(intx, MonitorDeflationSliceMillis, 0, DIAGNOSTIC,                 \
+          "Bound the time a deflation cycle spends walking the in-use "     \
+          "list; the next cycle resumes where the previous one stopped "    \
+          "(0 is off).")                                                    \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, MonitorUsedDeflationThreshold, 90, DIAGNOSTIC,              \
           "Percentage of used monitors before triggering deflation (0 is "  \
           "off). The check is performed on GuaranteedSafepointInterval "    \
@@ -752,6 +798,23 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, CheckJNICalls, false,                                       \
           "Verify all arguments to JNI calls")                              \
                                                                             \
+  product(uintx, JNIGlobalHandleCacheSize, 0, EXPERIMENTAL,                 \
+          "Number of global JNI handle entries each thread keeps for "      \
+          "reuse. Entries are allocated from and returned to the storage "  \
+          "in bulk. 0 disables the cache")                                  \
+          range(0, 64)                                                      \
+                                                                            \
+  product(uintx, JNIWeakGlobalHandleCacheSize, 0, EXPERIMENTAL,             \
+          "Number of weak global JNI handle entries each thread keeps for " \
+          "reuse. Entries are allocated from and returned to the storage "  \
+          "in bulk. 0 disables the cache")                                  \
+          range(0, 64)                                                      \
+                                                                            \
+  product(bool, PinJNIArrayElements, false, EXPERIMENTAL,                   \
+          "Let Get<Type>ArrayElements pin the array and return a "          \
+          "direct pointer instead of a copy when the GC supports "          \
+          "object pinning")                                                 \
+                                                                            \
   product(bool, UseFastJNIAccessors, true,                                  \
           "Use optimized versions of Get<Primitive>Field")                  \
                                                                             \
@@ -892,6 +955,10 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, PrintClassHistogram, false, MANAGEABLE,                     \
           "Print a histogram of class instances")                           \
                                                                             \
+  product(bool, HeapProfileSampling, false, MANAGEABLE,                     \
+          "Record sampled allocations for the GC.heap_profile diagnostic "  \
+          "command, using the JVMTI heap sampling interval")                \
+                                                                            \
   product(double, ObjectCountCutOffPercent, 0.5, EXPERIMENTAL,              \
           "The percentage of the used heap that the instances of a class "  \
           "must occupy for the class to generate a trace event")            \
@@ -918,6 +985,13 @@ const intx ObjectAlignmentInBytes = 8;
              "Reduce the number of parallel compiler threads when they "    \
              "are not used")                                                \
                                                                             \
+  product(uintx, CompilerCPUBudget, 0,                                      \
+          "Percentage of the processors available to the VM that top "      \
+          "tier compilations may keep busy. Caps the number of C2 threads " \
+          "and delays C2 compilations that would exceed it. C1 is not "     \
+          "limited. 0 means no limit")                                      \
+          range(0, 100)                                                     \
+                                                                            \
   product(bool, TraceCompilerThreads, false, DIAGNOSTIC,                    \
              "Trace creation and removal of compiler threads")              \
                                                                             \
@@ -962,6 +1036,17 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseVtableBasedCHA, true,  DIAGNOSTIC,                       \
           "Use vtable information during CHA")                              \
                                                                             \
+  product(uint, BackgroundVerificationThreads, 0, EXPERIMENTAL,             \
+          "Number of threads that link, and so verify, classes defined by " \
+          "the platform and system class loaders in the background; 0 "     \
+          "links them only on demand")                                      \
+          range(0, 16)                                                      \
+                                                                            \
+  product(bool, LazyItableInitialization, false, EXPERIMENTAL,              \
+          "Defer filling in the itable of a class loaded by a non-boot "    \
+          "loader, and checking its loader constraints, from linking "      \
+          "until the class is first initialized")                           \
+                                                                            \
   product(bool, UseTypeProfile, true,                                       \
           "Check interpreter profile for historically monomorphic calls")   \
                                                                             \
@@ -1070,6 +1155,11 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseHeavyMonitors, false,                                    \
           "use heavyweight instead of lightweight Java monitors")           \
                                                                             \
+  product(bool, UseLightweightLocking, false, EXPERIMENTAL,                 \
+          "Lock uncontended Java monitors by marking the object header "    \
+          "and recording the object on a per-thread lock stack instead "    \
+          "of stack-locking with displaced headers")                        \
+                                                                            \
   product(bool, PrintStringTableStatistics, false,                          \
           "print statistics about the StringTable and SymbolTable")         \
                                                                             \
@@ -1151,6 +1241,11 @@ const intx ObjectAlignmentInBytes = 8;
   product_pd(bool, RewriteFrequentPairs,                                    \
           "Rewrite frequently used bytecode pairs into a single bytecode")  \
                                                                             \
+  product(bool, UseInterpreterInterfaceCache, false, EXPERIMENTAL,          \
+          "Cache the receiver klass and itable slot of the last target "    \
+          "at each interpreted invokeinterface (x86_64 only; requires "     \
+          "UseCompressedClassPointers)")                                    \
+                                                                            \
   product(bool, PrintInterpreter, false, DIAGNOSTIC,                        \
           "Print the generated interpreter code")                           \
                                                                             \
@@ -1315,6 +1410,12 @@ const intx ObjectAlignmentInBytes = 8;
           "Delay in milliseconds for option SafepointTimeout")              \
           range(0, max_intx LP64_ONLY(/MICROUNITS))                         \
                                                                             \
+  product(intx, SafepointSyncSampleDelay, 0, DIAGNOSTIC,                    \
+          "Sample the code location of threads that have not reached a "    \
+          "safepoint after this many milliseconds and report it through "   \
+          "JFR and safepoint logging (0 means never)")                      \
+          range(0, max_intx LP64_ONLY(/MICROUNITS))                         \
+                                                                            \
   product(intx, NmethodSweepActivity, 10,                                   \
           "Removes cold nmethods from code cache if > 0. Higher values "    \
           "result in more aggressive sweeping")                             \
@@ -1437,6 +1538,12 @@ const intx ObjectAlignmentInBytes = 8;
   product(ccstr, MetaspaceReclaimPolicy, "balanced",                        \
           "options: balanced, aggressive, none")                            \
                                                                             \
+  product(uintx, MetaspaceUncommitDelay, 0,                                 \
+          "Delay in milliseconds after class unloading before free "        \
+          "metaspace memory is returned to the operating system by the "    \
+          "service thread. If 0, it is returned during class unloading.")   \
+          range(0, max_jint)                                                \
+                                                                            \
   product(bool, PrintMetaspaceStatisticsAtExit, false, DIAGNOSTIC,          \
           "Print metaspace statistics upon VM exit.")                       \
                                                                             \
@@ -1578,6 +1685,17 @@ const intx ObjectAlignmentInBytes = 8;
           "Size of code heap with non-nmethods (in bytes)")                 \
           constraint(VMPageSizeConstraintFunc, AtParse)                     \
                                                                             \
+  product(uintx, HotCodeHeapSize, 0,                                        \
+          "Size of the code heap, taken from the non-profiled one, that "   \
+          "keeps the C2 code of hot methods together (in bytes). Requires " \
+          "SegmentedCodeCache. 0 means no hot code heap")                   \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(uintx, HotCodeHeapThreshold, 100000, DIAGNOSTIC,                  \
+          "Invocations and backedges a method needs when it is compiled "   \
+          "by C2 to be placed in the hot code heap")                        \
+          range(0, max_jint)                                                \
+                                                                            \
   product_pd(uintx, CodeCacheExpansionSize,                                 \
           "Code cache expansion size (in bytes)")                           \
           range(32*K, max_uintx)                                            \
@@ -1603,6 +1721,11 @@ const intx ObjectAlignmentInBytes = 8;
           "Non-segmented code cache: X[%] of the total code cache")         \
           range(0, 100)                                                     \
                                                                             \
+  product(bool, CodeCacheUnloadingGC, false,                                \
+          "Request a GC that unloads classes, and with them their "         \
+          "nmethods, when aggressive sweeping starts and the code cache "   \
+          "has grown since the last such request")                          \
+                                                                            \
   /* interpreter debugging */                                               \
   develop(intx, BinarySwitchThreshold, 5,                                   \
           "Minimal number of lookupswitch entries for rewriting to binary " \
@@ -1902,6 +2025,12 @@ const intx ObjectAlignmentInBytes = 8;
           "(will be rounded to nearest higher power of 2)")                 \
           range(minimumStringTableSize, 16777216ul /* 2^24 */)              \
                                                                             \
+  product(intx, StringTableCleaningSliceMillis, 0, DIAGNOSTIC,              \
+          "Bound the time the service thread spends cleaning the String "   \
+          "table in one go; the next slice resumes where the previous one " \
+          "stopped (0 is off).")                                            \
+          range(0, max_jint)                                                \
+                                                                            \
   product(uintx, SymbolTableSize, defaultSymbolTableSize, EXPERIMENTAL,     \
           "Number of buckets in the JVM internal Symbol table")             \
           range(minimumSymbolTableSize, 16777216ul /* 2^24 */)              \
@@ -1970,6 +2099,10 @@ const intx ObjectAlignmentInBytes = 8;
            "do not map the archive")                                        \
            range(0, 2)                                                      \
                                                                             \
+  product(bool, UseParallelArchiveRelocation, true, DIAGNOSTIC,             \
+          "Use the GC worker threads, if any, to relocate the pointers "    \
+          "of a CDS archive that is not mapped at its requested address")   \
+                                                                            \
   product(size_t, ArrayAllocatorMallocLimit, (size_t)-1, EXPERIMENTAL,      \
           "Allocation less than this value will be allocated "              \
           "using malloc. Larger allocations will use mmap.")                \
@@ -2041,6 +2174,14 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseEmptySlotsInSupers, true,                                \
                 "Allow allocating fields in empty slots of super-classes")  \
                                                                             \
+  product(ccstr, FieldLayoutProfileFile, NULL, EXPERIMENTAL,                \
+          "Allocate the hot fields listed in this field layout profile "    \
+          "before the other fields of their class")                         \
+                                                                            \
+  product(ccstr, DumpFieldLayoutProfileAtExit, NULL, EXPERIMENTAL,          \
+          "Write the most accessed instance fields of the loaded classes "  \
+          "to this file at exit, for use with FieldLayoutProfileFile")      \
+                                                                            \
   product(bool, DeoptimizeNMethodBarriersALot, false, DIAGNOSTIC,           \
                 "Make nmethod barriers deoptimise a lot.")                  \
                                                                             \
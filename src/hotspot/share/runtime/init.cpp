@@ -83,6 +83,8 @@ void vmStructs_init() NOT_DEBUG_RETURN;
 void vtableStubs_init();
 void InlineCacheBuffer_init();
 void compilerOracle_init();
+void compilationProfile_init();
+void fieldLayoutProfile_init();
 bool compileBroker_init();
 void dependencyContext_init();
 void dependencies_init();
@@ -124,6 +126,7 @@ jint init_globals() {
   if (status != JNI_OK)
     return status;
 
+  fieldLayoutProfile_init(); // dependent on universe_init, before classes are loaded
   AsyncLogWriter::initialize();
   gc_barrier_stubs_init();  // depends on universe_init, must be before interpreter_init
   interpreter_init_stub();  // before methods get loaded
@@ -143,6 +146,7 @@ jint init_globals() {
   vtableStubs_init();
   InlineCacheBuffer_init();
   compilerOracle_init();
+  compilationProfile_init();
   dependencyContext_init();
   dependencies_init();
 
@@ -26,11 +26,13 @@
 #include "jvm.h"
 #include "cds/dynamicArchive.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "gc/shared/collectedHeap.hpp"
@@ -486,6 +488,14 @@ void before_exit(JavaThread* thread) {
   }
 #endif
 
+  if (DumpCompilationProfileAtExit != NULL) {
+    CompilationProfile::dump(DumpCompilationProfileAtExit);
+  }
+
+  if (DumpFieldLayoutProfileAtExit != NULL) {
+    FieldLayoutProfile::dump(DumpFieldLayoutProfileAtExit);
+  }
+
   if (JvmtiExport::should_post_thread_life()) {
     JvmtiExport::post_thread_end(thread);
   }
@@ -82,6 +82,77 @@ static void report_handle_allocation_failure(AllocFailType alloc_failmode,
   }
 }
 
+JNIGlobalHandleCache::JNIGlobalHandleCache(bool weak, size_t capacity) :
+  _storage(weak ? JNIHandles::weak_global_handles() : JNIHandles::global_handles()),
+  _entries(NEW_C_HEAP_ARRAY(oop*, capacity, mtInternal)),
+  _capacity(capacity),
+  _count(0) {
+  assert(capacity > 0, "invariant");
+}
+
+JNIGlobalHandleCache::~JNIGlobalHandleCache() {
+  flush();
+  FREE_C_HEAP_ARRAY(oop*, _entries);
+}
+
+void JNIGlobalHandleCache::flush() {
+  if (_count > 0) {
+    DEBUG_ONLY(verify();)
+    _storage->release(_entries, _count);
+    _count = 0;
+  }
+}
+
+#ifdef ASSERT
+void JNIGlobalHandleCache::verify() const {
+  for (size_t i = 0; i < _count; i++) {
+    assert(_storage->allocation_status(_entries[i]) == OopStorage::ALLOCATED_ENTRY,
+           "cached entry " PTR_FORMAT " not allocated in %s", p2i(_entries[i]), _storage->name());
+    assert(*_entries[i] == NULL, "cached entry " PTR_FORMAT " not cleared", p2i(_entries[i]));
+  }
+}
+#endif // ASSERT
+
+oop* JNIGlobalHandleCache::allocate() {
+  if (_count == 0) {
+    _count = _storage->allocate(_entries, MIN2(_capacity, OopStorage::bulk_allocate_limit));
+    if (_count == 0) {
+      return NULL;
+    }
+  }
+  return _entries[--_count];
+}
+
+void JNIGlobalHandleCache::release(oop* ptr) {
+  assert(*ptr == NULL, "must be cleared");
+  if (_count == _capacity) {
+    size_t n = (_capacity + 1) / 2;
+    _count -= n;
+    _storage->release(&_entries[_count], n);
+  }
+  _entries[_count++] = ptr;
+}
+
+static JNIGlobalHandleCache* current_global_handle_cache() {
+  if (JNIGlobalHandleCacheSize > 0) {
+    Thread* thread = Thread::current();
+    if (thread->is_Java_thread()) {
+      return JavaThread::cast(thread)->jni_global_handle_cache();
+    }
+  }
+  return NULL;
+}
+
+static JNIGlobalHandleCache* current_weak_global_handle_cache() {
+  if (JNIWeakGlobalHandleCacheSize > 0) {
+    Thread* thread = Thread::current();
+    if (thread->is_Java_thread()) {
+      return JavaThread::cast(thread)->jni_weak_global_handle_cache();
+    }
+  }
+  return NULL;
+}
+
 jobject JNIHandles::make_global(Handle obj, AllocFailType alloc_failmode) {
   assert(!Universe::heap()->is_gc_active(), "can't extend the root set during GC");
   assert(!current_thread_in_native(), "must not be in native");
@@ -89,7 +160,8 @@ jobject JNIHandles::make_global(Handle obj, AllocFailType alloc_failmode) {
   if (!obj.is_null()) {
     // ignore null handles
     assert(oopDesc::is_oop(obj()), "not an oop");
-    oop* ptr = global_handles()->allocate();
+    JNIGlobalHandleCache* cache = current_global_handle_cache();
+    oop* ptr = (cache != NULL) ? cache->allocate() : global_handles()->allocate();
     // Return NULL on allocation failure.
     if (ptr != NULL) {
       assert(*ptr == NULL, "invariant");
@@ -110,7 +182,8 @@ jobject JNIHandles::make_weak_global(Handle obj, AllocFailType alloc_failmode) {
   if (!obj.is_null()) {
     // ignore null handles
     assert(oopDesc::is_oop(obj()), "not an oop");
-    oop* ptr = weak_global_handles()->allocate();
+    JNIGlobalHandleCache* cache = current_weak_global_handle_cache();
+    oop* ptr = (cache != NULL) ? cache->allocate() : weak_global_handles()->allocate();
     // Return NULL on allocation failure.
     if (ptr != NULL) {
       assert(*ptr == NULL, "invariant");
@@ -149,7 +222,12 @@ void JNIHandles::destroy_global(jobject handle) {
     assert(!is_jweak(handle), "wrong method for detroying jweak");
     oop* oop_ptr = jobject_ptr(handle);
     NativeAccess<>::oop_store(oop_ptr, (oop)NULL);
-    global_handles()->release(oop_ptr);
+    JNIGlobalHandleCache* cache = current_global_handle_cache();
+    if (cache != NULL) {
+      cache->release(oop_ptr);
+    } else {
+      global_handles()->release(oop_ptr);
+    }
   }
 }
 
@@ -159,7 +237,12 @@ void JNIHandles::destroy_weak_global(jobject handle) {
     assert(is_jweak(handle), "JNI handle not jweak");
     oop* oop_ptr = jweak_ptr(handle);
     NativeAccess<ON_PHANTOM_OOP_REF>::oop_store(oop_ptr, (oop)NULL);
-    weak_global_handles()->release(oop_ptr);
+    JNIGlobalHandleCache* cache = current_weak_global_handle_cache();
+    if (cache != NULL) {
+      cache->release(oop_ptr);
+    } else {
+      weak_global_handles()->release(oop_ptr);
+    }
   }
 }
 
@@ -41,6 +41,7 @@ class JNIHandles : AllStatic {
   static OopStorage* _global_handles;
   static OopStorage* _weak_global_handles;
   friend void jni_handles_init();
+  friend class JNIGlobalHandleCache;
 
   static OopStorage* global_handles();
   static OopStorage* weak_global_handles();
@@ -132,6 +133,42 @@ class JNIHandles : AllStatic {
 
 
 
+// Thread local cache of global or weak global handle entries. Empty caches
+// are refilled from the storage with one bulk allocation, and entries
+// released by the owning thread are kept for its next allocation, returning
+// half of the cache to the storage in bulk when it overflows.
+// Cached entries are allocated in the storage and hold NULL. The caches
+// are flushed at safepoints, so that the storage can reclaim empty blocks.
+class JNIGlobalHandleCache : public CHeapObj<mtInternal> {
+  OopStorage* const _storage;
+  oop** _entries;
+  size_t _capacity;
+  size_t _count;
+
+  NONCOPYABLE(JNIGlobalHandleCache);
+
+public:
+  // Caches entries of the weak global storage if weak is true, or of the
+  // global storage otherwise.
+  JNIGlobalHandleCache(bool weak, size_t capacity);
+  // Releases all cached entries back to the storage.
+  ~JNIGlobalHandleCache();
+
+  // Returns an entry holding NULL, or NULL on allocation failure.
+  oop* allocate();
+  // precondition: ptr is an allocated entry of the storage holding NULL.
+  void release(oop* ptr);
+
+  // Releases all cached entries back to the storage.
+  void flush();
+
+  OopStorage* storage() const { return _storage; }
+  size_t count() const         { return _count; }
+
+  // Checks that the cached entries are allocated and hold NULL.
+  void verify() const NOT_DEBUG_RETURN;
+};
+
 // JNI handle blocks holding local/global JNI handles
 
 class JNIHandleBlock : public CHeapObj<mtInternal> {
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_LOCKSTACK_HPP
+#define SHARE_RUNTIME_LOCKSTACK_HPP
+
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/sizes.hpp"
+
+class OopClosure;
+
+// The lock stack of a JavaThread holds the objects it has locked with
+// lightweight locking (UseLightweightLocking), innermost last. Every enter
+// pushes the object, so a recursive enter shows up as a repeated entry.
+// Only the owning thread modifies its lock stack; the GC visits the entries
+// as part of the thread's roots.
+class LockStack {
+ public:
+  static const int CAPACITY = 8;
+
+ private:
+  int _top;
+  oop _base[CAPACITY];
+
+ public:
+  LockStack() : _top(0) {}
+
+  bool can_push() const { return _top < CAPACITY; }
+  bool is_empty() const { return _top == 0; }
+
+  inline void push(oop o);
+  // Removes the innermost entry for o, which must be present.
+  inline void pop(oop o);
+  // Removes all entries for o. Returns the number of entries removed.
+  inline int remove(oop o);
+  inline bool contains(oop o) const;
+
+  void oops_do(OopClosure* cl);
+
+  // Offsets used by the generated fast paths
+  static ByteSize top_offset()  { return byte_offset_of(LockStack, _top); }
+  static ByteSize base_offset() { return byte_offset_of(LockStack, _base); }
+};
+
+#endif // SHARE_RUNTIME_LOCKSTACK_HPP
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_LOCKSTACK_INLINE_HPP
+#define SHARE_RUNTIME_LOCKSTACK_INLINE_HPP
+
+#include "runtime/lockStack.hpp"
+
+#include "utilities/debug.hpp"
+
+inline void LockStack::push(oop o) {
+  assert(can_push(), "lock stack overflow");
+  _base[_top++] = o;
+}
+
+inline void LockStack::pop(oop o) {
+  for (int i = _top - 1; i >= 0; i--) {
+    if (_base[i] == o) {
+      for (int j = i + 1; j < _top; j++) {
+        _base[j - 1] = _base[j];
+      }
+      _top--;
+      return;
+    }
+  }
+  ShouldNotReachHere();
+}
+
+inline int LockStack::remove(oop o) {
+  int removed = 0;
+  int dst = 0;
+  for (int i = 0; i < _top; i++) {
+    if (_base[i] == o) {
+      removed++;
+    } else {
+      _base[dst++] = _base[i];
+    }
+  }
+  _top = dst;
+  return removed;
+}
+
+inline bool LockStack::contains(oop o) const {
+  for (int i = _top - 1; i >= 0; i--) {
+    if (_base[i] == o) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#endif // SHARE_RUNTIME_LOCKSTACK_INLINE_HPP
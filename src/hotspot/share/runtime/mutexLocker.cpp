@@ -117,6 +117,7 @@ Monitor* RootRegionScan_lock          = NULL;
 
 Mutex*   Management_lock              = NULL;
 Monitor* MonitorDeflation_lock        = NULL;
+Monitor* BackgroundVerifier_lock      = NULL;
 Monitor* Service_lock                 = NULL;
 Monitor* Notification_lock            = NULL;
 Monitor* PeriodicTask_lock            = NULL;
@@ -143,6 +144,7 @@ Monitor* ThreadsSMRDelete_lock        = NULL;
 Mutex*   ThreadIdTableCreate_lock     = NULL;
 Mutex*   SharedDecoder_lock           = NULL;
 Mutex*   DCmdFactory_lock             = NULL;
+Mutex*   HeapSampleProfiler_lock      = NULL;
 #if INCLUDE_NMT
 Mutex*   NMTQuery_lock                = NULL;
 #endif
@@ -245,6 +247,7 @@ void mutex_init() {
   def(CompiledMethod_lock          , PaddedMutex  , special-1,   true,  _safepoint_check_never);
   def(MonitorDeflation_lock        , PaddedMonitor, tty-2,       true,  _safepoint_check_never);      // used for monitor deflation thread operations
   def(Service_lock                 , PaddedMonitor, tty-2,       true,  _safepoint_check_never);      // used for service thread operations
+  def(BackgroundVerifier_lock      , PaddedMonitor, tty-2,       true,  _safepoint_check_never);      // used for background verifier thread operations
 
   if (UseNotificationThread) {
     def(Notification_lock            , PaddedMonitor, special,     true,  _safepoint_check_never);  // used for notification thread operations
@@ -335,6 +338,7 @@ void mutex_init() {
   def(ThreadIdTableCreate_lock     , PaddedMutex  , leaf,        false, _safepoint_check_always);
   def(SharedDecoder_lock           , PaddedMutex  , native,      true,  _safepoint_check_never);
   def(DCmdFactory_lock             , PaddedMutex  , leaf,        true,  _safepoint_check_never);
+  def(HeapSampleProfiler_lock      , PaddedMutex  , leaf,        true,  _safepoint_check_never);
 #if INCLUDE_NMT
   def(NMTQuery_lock                , PaddedMutex  , max_nonleaf, false, _safepoint_check_always);
 #endif
@@ -56,7 +56,10 @@
 #include "utilities/macros.hpp"
 #include "utilities/preserveException.hpp"
 #if INCLUDE_JFR
+#include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/support/jfrFlush.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/threadSMR.hpp"
 #endif
 
 #ifdef DTRACE_ENABLED
@@ -234,7 +237,7 @@ OopStorage* ObjectMonitor::_oop_storage = NULL;
 
 
 void* ObjectMonitor::operator new (size_t size) throw() {
-  return AllocateHeap(size, mtInternal);
+  return AllocateHeap(size, mtSynchronizer);
 }
 void* ObjectMonitor::operator new[] (size_t size) throw() {
   return operator new (size);
@@ -282,10 +285,13 @@ ObjectMonitor::ObjectMonitor(oop object) :
   _Responsible(NULL),
   _Spinner(0),
   _SpinDuration(ObjectMonitor::Knob_SpinLimit),
+  _spin_successes(0),
+  _spin_failures(0),
   _contentions(0),
   _WaitSet(NULL),
   _waiters(0),
   _WaitSetLock(0)
+  JFR_ONLY(COMMA _owner_sample_nanos(0))
 { }
 
 ObjectMonitor::~ObjectMonitor() {
@@ -396,6 +402,8 @@ bool ObjectMonitor::enter(JavaThread* current) {
     return false;
   }
 
+  JFR_ONLY(post_contended_owner_event(current);)
+
   JFR_ONLY(JfrConditionalFlushWithStacktrace<EventJavaMonitorEnter> flush(current);)
   EventJavaMonitorEnter event;
   if (event.is_started()) {
@@ -492,6 +500,65 @@ bool ObjectMonitor::enter(JavaThread* current) {
   return true;
 }
 
+#if INCLUDE_JFR
+class JfrOwnerStackTraceClosure : public HandshakeClosure {
+  traceid _stack_trace_id;
+ public:
+  JfrOwnerStackTraceClosure() : HandshakeClosure("JfrOwnerStackTrace"), _stack_trace_id(0) {}
+  void do_thread(Thread* thread) {
+    _stack_trace_id = JfrStackTraceRepository::record_for_handshakee(JavaThread::cast(thread));
+  }
+  traceid stack_trace_id() const { return _stack_trace_id; }
+};
+
+// Minimum time between two owner stack samples of the same monitor, and
+// of any two monitors. A monitor that is released and re-contended in a
+// tight loop starts a new episode every time, and each episode would
+// otherwise cost a handshake with the owner.
+static const jlong OwnerSampleMonitorIntervalNanos = 20 * NANOSECS_PER_MILLISEC;
+static const jlong OwnerSampleGlobalIntervalNanos  = NANOSECS_PER_MILLISEC;
+static volatile jlong _owner_sample_global_nanos = 0;
+
+static bool claim_owner_sample(volatile jlong* last, jlong now, jlong interval) {
+  const jlong prev = Atomic::load(last);
+  return now - prev >= interval && Atomic::cmpxchg(last, prev, now) == prev;
+}
+
+// The first thread to block on the monitor records what the owner is
+// doing, once per contention episode. The owner's stack is captured with
+// a handshake, so this delays the contending thread, which is about to
+// block anyway, and the owner only for the duration of the stack walk.
+// Samples are rate limited per monitor and globally, see above.
+void ObjectMonitor::post_contended_owner_event(JavaThread* current) {
+  if (!EventJavaMonitorContendedOwner::is_enabled() || contentions() != 1) {
+    return;
+  }
+  EventJavaMonitorContendedOwner event;
+  if (!event.should_commit()) {
+    return;
+  }
+  const jlong now = os::javaTimeNanos();
+  if (!claim_owner_sample(&_owner_sample_nanos, now, OwnerSampleMonitorIntervalNanos) ||
+      !claim_owner_sample(&_owner_sample_global_nanos, now, OwnerSampleGlobalIntervalNanos)) {
+    return;
+  }
+  Klass* const monitor_class = object()->klass();
+  ThreadsListHandle tlh(current);
+  JavaThread* const owner = Threads::owning_thread_from_monitor(tlh.list(), this);
+  if (owner == NULL || owner == current) {
+    // The monitor was released in the meantime.
+    return;
+  }
+  JfrOwnerStackTraceClosure cl;
+  Handshake::execute(&cl, owner);
+  event.set_monitorClass(monitor_class);
+  event.set_owner(JFR_THREAD_ID(owner));
+  event.set_ownerStackTrace(cl.stack_trace_id());
+  event.set_address((uintptr_t)this);
+  event.commit();
+}
+#endif
+
 // Caveat: TryLock() is not necessarily serializing if it returns failure.
 // Callers must compensate as needed.
 
@@ -1838,6 +1905,20 @@ void ObjectMonitor::notifyAll(TRAPS) {
 
 // Spinning: Fixed frequency (100%), vary duration
 int ObjectMonitor::TrySpin(JavaThread* current) {
+  int ret = TrySpinImpl(current);
+  // Per-monitor and global spin statistics. Like _SpinDuration the
+  // per-monitor counts are updated without atomics and are advisory.
+  if (ret > 0) {
+    _spin_successes++;
+    OM_PERFDATA_OP(SpinSuccesses, inc());
+  } else {
+    _spin_failures++;
+    OM_PERFDATA_OP(SpinFailures, inc());
+  }
+  return ret;
+}
+
+int ObjectMonitor::TrySpinImpl(JavaThread* current) {
   // Dumb, brutal spin.  Good for comparative measurements against adaptive spinning.
   int ctr = Knob_FixedSpin;
   if (ctr != 0) {
@@ -1848,6 +1929,12 @@ int ObjectMonitor::TrySpin(JavaThread* current) {
     return 0;
   }
 
+  // Don't even sample if the owner is not running: it cannot drop the
+  // lock until it is back on a CPU.
+  if (NotRunnable(current, (JavaThread*) owner_raw())) {
+    return 0;
+  }
+
   for (ctr = Knob_PreSpin + 1; --ctr >= 0;) {
     if (TryLock(current) > 0) {
       // Increase _SpinDuration ...
@@ -2041,6 +2128,10 @@ int ObjectMonitor::NotRunnable(JavaThread* current, JavaThread* ox) {
   // Check ox->TypeTag == 2BAD.
   if (ox == NULL) return 0;
 
+  // An anonymous owner is a lightweight locker that has not claimed the
+  // monitor yet. It is not a thread pointer, so nothing can be sampled.
+  if (ox == ANONYMOUS_OWNER) return 0;
+
   // Avoid transitive spinning ...
   // Say T1 spins or blocks trying to acquire L.  T1._Stalled is set to L.
   // Immediately after T1 acquires L it's possible that T2, also
@@ -2148,6 +2239,8 @@ PerfCounter * ObjectMonitor::_sync_Notifications               = NULL;
 PerfCounter * ObjectMonitor::_sync_Inflations                  = NULL;
 PerfCounter * ObjectMonitor::_sync_Deflations                  = NULL;
 PerfLongVariable * ObjectMonitor::_sync_MonExtant              = NULL;
+PerfCounter * ObjectMonitor::_sync_SpinSuccesses               = NULL;
+PerfCounter * ObjectMonitor::_sync_SpinFailures                = NULL;
 
 // One-shot global initialization for the sync subsystem.
 // We could also defer initialization and initialize on-demand
@@ -2183,6 +2276,8 @@ void ObjectMonitor::Initialize() {
     NEWPERFCOUNTER(_sync_Parks);
     NEWPERFCOUNTER(_sync_Notifications);
     NEWPERFVARIABLE(_sync_MonExtant);
+    NEWPERFCOUNTER(_sync_SpinSuccesses);
+    NEWPERFCOUNTER(_sync_SpinFailures);
 #undef NEWPERFCOUNTER
 #undef NEWPERFVARIABLE
   }
@@ -2227,6 +2322,8 @@ void ObjectMonitor::print() const { print_on(tty); }
 //   _Responsible = 0x0000000000000000
 //   _Spinner = 0
 //   _SpinDuration = 5000
+//   _spin_successes = 0
+//   _spin_failures = 0
 //   _contentions = 0
 //   _WaitSet = 0x0000700009756248
 //   _waiters = 1
@@ -2257,6 +2354,8 @@ void ObjectMonitor::print_debug_style_on(outputStream* st) const {
   st->print_cr("  _Responsible = " INTPTR_FORMAT, p2i(_Responsible));
   st->print_cr("  _Spinner = %d", _Spinner);
   st->print_cr("  _SpinDuration = %d", _SpinDuration);
+  st->print_cr("  _spin_successes = %u", _spin_successes);
+  st->print_cr("  _spin_failures = %u", _spin_failures);
   st->print_cr("  _contentions = %d", contentions());
   st->print_cr("  _WaitSet = " INTPTR_FORMAT, p2i(_WaitSet));
   st->print_cr("  _waiters = %d", _waiters);
@@ -147,6 +147,9 @@ class ObjectMonitor : public CHeapObj<mtInternal> {
                         sizeof(WeakHandle));
   // Used by async deflation as a marker in the _owner field:
   #define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+  // Owner of a monitor inflated over a lightweight lock by a thread other
+  // than the locker, until the locker claims it:
+  #define ANONYMOUS_OWNER reinterpret_cast<void*>(1)
   void* volatile _owner;            // pointer to owning thread OR BasicLock
   volatile uint64_t _previous_owner_tid;  // thread id of the previous owner of the monitor
   // Separate _owner and _next_om on different cache lines since
@@ -167,6 +170,8 @@ class ObjectMonitor : public CHeapObj<mtInternal> {
 
   volatile int _Spinner;            // for exit->spinner handoff optimization
   volatile int _SpinDuration;
+  volatile uint _spin_successes;    // spin attempts that acquired the monitor (advisory)
+  volatile uint _spin_failures;     // spin attempts that gave up (advisory)
 
   int _contentions;                 // Number of active contentions in enter(). It is used by is_busy()
                                     // along with other fields to determine if an ObjectMonitor can be
@@ -177,6 +182,7 @@ class ObjectMonitor : public CHeapObj<mtInternal> {
   volatile int  _waiters;           // number of waiting threads
  private:
   volatile int _WaitSetLock;        // protects Wait Queue - simple spinlock
+  JFR_ONLY(volatile jlong _owner_sample_nanos;)  // last owner stack sample, see post_contended_owner_event()
 
  public:
   static void Initialize();
@@ -200,6 +206,8 @@ class ObjectMonitor : public CHeapObj<mtInternal> {
   static PerfCounter * _sync_Inflations;
   static PerfCounter * _sync_Deflations;
   static PerfLongVariable * _sync_MonExtant;
+  static PerfCounter * _sync_SpinSuccesses;
+  static PerfCounter * _sync_SpinFailures;
 
   static int Knob_SpinLimit;
 
@@ -268,6 +276,10 @@ class ObjectMonitor : public CHeapObj<mtInternal> {
   // old_value, using Atomic::cmpxchg(). Otherwise, does not change the
   // _owner field. Returns the prior value of the _owner field.
   void*     try_set_owner_from(void* old_value, void* new_value);
+  // Returns true if owner field == ANONYMOUS_OWNER and false otherwise.
+  bool      is_owner_anonymous() const;
+  // Simply set _owner field to ANONYMOUS_OWNER; current value must be NULL.
+  void      set_owner_anonymous();
 
   // Simply get _next_om field.
   ObjectMonitor* next_om() const;
@@ -348,7 +360,9 @@ class ObjectMonitor : public CHeapObj<mtInternal> {
   int       TryLock(JavaThread* current);
   int       NotRunnable(JavaThread* current, JavaThread* Owner);
   int       TrySpin(JavaThread* current);
+  int       TrySpinImpl(JavaThread* current);
   void      ExitEpilog(JavaThread* current, ObjectWaiter* Wakee);
+  JFR_ONLY(void post_contended_owner_event(JavaThread* current);)
 
   // Deflation support
   bool      deflate_monitor();
@@ -66,6 +66,14 @@ inline void* ObjectMonitor::owner_raw() const {
   return Atomic::load(&_owner);
 }
 
+inline bool ObjectMonitor::is_owner_anonymous() const {
+  return owner_raw() == ANONYMOUS_OWNER;
+}
+
+inline void ObjectMonitor::set_owner_anonymous() {
+  set_owner_from(NULL, ANONYMOUS_OWNER);
+}
+
 // Returns true if owner field == DEFLATER_MARKER and false otherwise.
 // This accessor is called when we really need to know if the owner
 // field == DEFLATER_MARKER and any non-NULL value won't do the trick.
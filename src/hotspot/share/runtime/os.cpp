@@ -1734,7 +1734,7 @@ bool os::create_stack_guard_pages(char* addr, size_t bytes) {
 char* os::reserve_memory(size_t bytes, bool executable, MEMFLAGS flags) {
   char* result = pd_reserve_memory(bytes, executable);
   if (result != NULL) {
-    MemTracker::record_virtual_memory_reserve(result, bytes, CALLER_PC);
+    MemTracker::record_virtual_memory_reserve(result, bytes, CALLER_PC_UNSAMPLED);
     if (flags != mtOther) {
       MemTracker::record_virtual_memory_type(result, flags);
     }
@@ -1746,7 +1746,7 @@ char* os::reserve_memory(size_t bytes, bool executable, MEMFLAGS flags) {
 char* os::attempt_reserve_memory_at(char* addr, size_t bytes, bool executable) {
   char* result = pd_attempt_reserve_memory_at(addr, bytes, executable);
   if (result != NULL) {
-    MemTracker::record_virtual_memory_reserve((address)result, bytes, CALLER_PC);
+    MemTracker::record_virtual_memory_reserve((address)result, bytes, CALLER_PC_UNSAMPLED);
   } else {
     log_debug(os)("Attempt to reserve memory at " INTPTR_FORMAT " for "
                  SIZE_FORMAT " bytes failed, errno %d", p2i(addr), bytes, get_last_error());
@@ -1757,7 +1757,7 @@ char* os::attempt_reserve_memory_at(char* addr, size_t bytes, bool executable) {
 bool os::commit_memory(char* addr, size_t bytes, bool executable) {
   bool res = pd_commit_memory(addr, bytes, executable);
   if (res) {
-    MemTracker::record_virtual_memory_commit((address)addr, bytes, CALLER_PC);
+    MemTracker::record_virtual_memory_commit((address)addr, bytes, CALLER_PC_UNSAMPLED);
   }
   return res;
 }
@@ -1766,7 +1766,7 @@ bool os::commit_memory(char* addr, size_t size, size_t alignment_hint,
                               bool executable) {
   bool res = os::pd_commit_memory(addr, size, alignment_hint, executable);
   if (res) {
-    MemTracker::record_virtual_memory_commit((address)addr, size, CALLER_PC);
+    MemTracker::record_virtual_memory_commit((address)addr, size, CALLER_PC_UNSAMPLED);
   }
   return res;
 }
@@ -1774,13 +1774,13 @@ bool os::commit_memory(char* addr, size_t size, size_t alignment_hint,
 void os::commit_memory_or_exit(char* addr, size_t bytes, bool executable,
                                const char* mesg) {
   pd_commit_memory_or_exit(addr, bytes, executable, mesg);
-  MemTracker::record_virtual_memory_commit((address)addr, bytes, CALLER_PC);
+  MemTracker::record_virtual_memory_commit((address)addr, bytes, CALLER_PC_UNSAMPLED);
 }
 
 void os::commit_memory_or_exit(char* addr, size_t size, size_t alignment_hint,
                                bool executable, const char* mesg) {
   os::pd_commit_memory_or_exit(addr, size, alignment_hint, executable, mesg);
-  MemTracker::record_virtual_memory_commit((address)addr, size, CALLER_PC);
+  MemTracker::record_virtual_memory_commit((address)addr, size, CALLER_PC_UNSAMPLED);
 }
 
 bool os::uncommit_memory(char* addr, size_t bytes, bool executable) {
@@ -1821,6 +1821,9 @@ void os::print_memory_mappings(outputStream* st) {
 }
 
 void os::pretouch_memory(void* start, void* end, size_t page_size) {
+  if (start >= end || pd_pretouch_memory(start, end, page_size)) {
+    return;
+  }
   for (volatile char *p = (char*)start; p < (char*)end; p += page_size) {
     // Note: this must be a store, not a load. On many OSes loads from fresh
     // memory would be satisfied from a single mapped page containing all zeros.
@@ -1836,7 +1839,7 @@ char* os::map_memory_to_file(size_t bytes, int file_desc) {
   // On all current implementations NULL is interpreted as any available address.
   char* result = os::map_memory_to_file(NULL /* addr */, bytes, file_desc);
   if (result != NULL) {
-    MemTracker::record_virtual_memory_reserve_and_commit(result, bytes, CALLER_PC);
+    MemTracker::record_virtual_memory_reserve_and_commit(result, bytes, CALLER_PC_UNSAMPLED);
   }
   return result;
 }
@@ -1844,7 +1847,7 @@ char* os::map_memory_to_file(size_t bytes, int file_desc) {
 char* os::attempt_map_memory_to_file_at(char* addr, size_t bytes, int file_desc) {
   char* result = pd_attempt_map_memory_to_file_at(addr, bytes, file_desc);
   if (result != NULL) {
-    MemTracker::record_virtual_memory_reserve_and_commit((address)result, bytes, CALLER_PC);
+    MemTracker::record_virtual_memory_reserve_and_commit((address)result, bytes, CALLER_PC_UNSAMPLED);
   }
   return result;
 }
@@ -1854,7 +1857,7 @@ char* os::map_memory(int fd, const char* file_name, size_t file_offset,
                            bool allow_exec, MEMFLAGS flags) {
   char* result = pd_map_memory(fd, file_name, file_offset, addr, bytes, read_only, allow_exec);
   if (result != NULL) {
-    MemTracker::record_virtual_memory_reserve_and_commit((address)result, bytes, CALLER_PC, flags);
+    MemTracker::record_virtual_memory_reserve_and_commit((address)result, bytes, CALLER_PC_UNSAMPLED, flags);
   }
   return result;
 }
@@ -1896,7 +1899,7 @@ char* os::reserve_memory_special(size_t size, size_t alignment, size_t page_size
   char* result = pd_reserve_memory_special(size, alignment, page_size, addr, executable);
   if (result != NULL) {
     // The memory is committed
-    MemTracker::record_virtual_memory_reserve_and_commit((address)result, size, CALLER_PC);
+    MemTracker::record_virtual_memory_reserve_and_commit((address)result, size, CALLER_PC_UNSAMPLED);
   }
 
   return result;
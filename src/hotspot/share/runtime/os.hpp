@@ -158,6 +158,9 @@ class os: AllStatic {
   static bool   pd_unmap_memory(char *addr, size_t bytes);
   static void   pd_free_memory(char *addr, size_t bytes, size_t alignment_hint);
   static void   pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint);
+  // Platform specific bulk pretouch of the memory range from start to end
+  // (exclusive). Returns false if the range has to be touched page by page.
+  static bool   pd_pretouch_memory(void* start, void* end, size_t page_size);
 
   static char*  pd_reserve_memory_special(size_t size, size_t alignment, size_t page_size,
 
@@ -413,6 +416,8 @@ class os: AllStatic {
   static bool   numa_has_group_homing();
   static void   numa_make_local(char *addr, size_t bytes, int lgrp_hint);
   static void   numa_make_global(char *addr, size_t bytes);
+  // Place each page on the node of the thread that first touches it
+  static void   numa_make_first_touch(char *addr, size_t bytes);
   static size_t numa_get_groups_num();
   static size_t numa_get_leaf_groups(int *ids, size_t size);
   static bool   numa_topology_changed();
@@ -804,6 +809,9 @@ class os: AllStatic {
   static int raw_send(int fd, char* buf, size_t nBytes, uint flags);
   static int connect(int fd, struct sockaddr* him, socklen_t len);
   static struct hostent* get_host_by_name(char* name);
+  // Connects a new stream socket to the UNIX domain socket at the given path.
+  // Returns the socket or -1 with errno set if that is not possible.
+  static int connect_unix_domain_socket(const char* path);
 
   // Support for signals (see JVM_RaiseSignal, JVM_RegisterSignal)
   static void  initialize_jdk_signal_support(TRAPS);
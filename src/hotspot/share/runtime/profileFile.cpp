@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/os.hpp"
+#include "runtime/profileFile.hpp"
+#include "runtime/vm_version.hpp"
+
+ProfileFileReader::ProfileFileReader(const char* path, const char* kind, int version) :
+  _file(os::fopen(path, "r")), _status(ok) {
+  if (_file == NULL) {
+    _status = cannot_open;
+    return;
+  }
+  char release[256];
+  int file_version = 0;
+  size_t kind_len = strlen(kind);
+  if (fgets(_line, sizeof(_line), _file) == NULL ||
+      strncmp(_line, "# ", 2) != 0 ||
+      strncmp(_line + 2, kind, kind_len) != 0 || _line[2 + kind_len] != ' ' ||
+      sscanf(_line + 2 + kind_len, "%d %255s", &file_version, release) != 2 ||
+      file_version != version || strcmp(release, VM_Version::vm_release()) != 0) {
+    _status = different_vm;
+  }
+}
+
+ProfileFileReader::~ProfileFileReader() {
+  if (_file != NULL) {
+    fclose(_file);
+  }
+}
+
+const char* ProfileFileReader::next_entry() {
+  if (_status != ok) {
+    return NULL;
+  }
+  while (fgets(_line, sizeof(_line), _file) != NULL) {
+    if (_line[0] == '#') {
+      continue;
+    }
+    _line[strcspn(_line, "\r\n")] = '\0';
+    return _line;
+  }
+  return NULL;
+}
+
+ProfileFileWriter::ProfileFileWriter(const char* path, const char* kind, int version) :
+  fileStream(path, "w") {
+  if (is_open()) {
+    print_cr("# %s %d %s", kind, version, VM_Version::vm_release());
+  }
+}
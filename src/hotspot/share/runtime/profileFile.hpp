@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_PROFILEFILE_HPP
+#define SHARE_RUNTIME_PROFILEFILE_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/ostream.hpp"
+
+// Profile files are written by one run of an application to tune a later
+// run, like the compilation profile and the field layout profile. They are
+// text files that start with a header line naming the kind of profile, its
+// format version and the VM release that wrote it:
+//
+//   # <kind> <version> <vm release>
+//
+// followed by one entry per line. Other lines starting with '#' are
+// comments. A profile is only read by the VM release that wrote it.
+
+// Reads the entries of a profile file after checking its header.
+class ProfileFileReader : public StackObj {
+ public:
+  enum Status {
+    ok,
+    cannot_open,      // the file could not be opened
+    different_vm      // bad header, or written by another version or VM release
+  };
+
+ private:
+  FILE*  _file;
+  Status _status;
+  char   _line[2048];
+
+ public:
+  ProfileFileReader(const char* path, const char* kind, int version);
+  ~ProfileFileReader();
+
+  Status status() const { return _status; }
+
+  // The next entry, without its line terminator, or NULL at the end of
+  // the file. Valid until the next call.
+  const char* next_entry();
+};
+
+// Creates a profile file and writes its header.
+class ProfileFileWriter : public fileStream {
+ public:
+  ProfileFileWriter(const char* path, const char* kind, int version);
+};
+
+#endif // SHARE_RUNTIME_PROFILEFILE_HPP
@@ -28,6 +28,7 @@
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "code/codeCache.hpp"
+#include "code/debugInfoRec.hpp"
 #include "code/icBuffer.hpp"
 #include "code/nmethod.hpp"
 #include "code/pcDesc.hpp"
@@ -40,6 +41,7 @@
 #include "gc/shared/workgroup.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
@@ -68,6 +70,7 @@
 #include "runtime/timerTrace.hpp"
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
 
 static void post_safepoint_begin_event(EventSafepointBegin& event,
@@ -205,6 +208,117 @@ static void back_off(int64_t start_time) {
   }
 }
 
+// Captures the pc of a thread that is still running while the VM thread tries to
+// synchronize. The thread is suspended while do_task runs, which therefore must
+// not allocate or take locks; the pc is decoded after the thread is resumed.
+class SafepointSyncSampleTask : public os::SuspendedThreadTask {
+  address _pc;
+  CodeBlob* _blob;
+
+public:
+  SafepointSyncSampleTask(JavaThread* thread) :
+    os::SuspendedThreadTask(thread), _pc(NULL), _blob(NULL) {}
+
+  address pc() const { return _pc; }
+  CodeBlob* blob() const { return _blob; }
+
+  void do_task(const os::SuspendedThreadTaskContext& context) {
+    JavaThread* thread = JavaThread::cast(context.thread());
+    if (thread->thread_state() != _thread_in_Java) {
+      // Moved on since the last check; it will not hold up the safepoint.
+      return;
+    }
+    intptr_t* sp;
+    intptr_t* fp;
+    _pc = os::fetch_frame_from_context(context.ucontext(), &sp, &fp);
+    if (_pc != NULL && CodeCache::contains(_pc)) {
+      _blob = CodeCache::find_blob_unsafe(_pc);
+    }
+  }
+};
+
+static void post_safepoint_sync_sample_event(uint64_t safepoint_id,
+                                             JavaThread* thread,
+                                             CodeBlob* blob,
+                                             address pc) {
+  ResourceMark rm;
+  const Method* method = NULL;
+  int bci = -1;
+  int compile_id = -1;
+  nmethod* nm = blob != NULL ? blob->as_nmethod_or_null() : NULL;
+  if (nm != NULL) {
+    compile_id = nm->compile_id();
+    // The sampled pc is usually not a safepoint, e.g. inside a counted loop
+    // without a poll, so attribute it to the next recorded scope.
+    PcDesc* pd = nm->pc_desc_near(pc);
+    if (pd != NULL && pd->scope_decode_offset() != DebugInformationRecorder::serialized_null) {
+      ScopeDesc sd(nm, pd);
+      method = sd.method();
+      bci = sd.bci();
+    } else {
+      method = nm->method();
+    }
+  }
+
+  log_info(safepoint)("Thread " INTPTR_FORMAT " late for safepoint at pc " INTPTR_FORMAT " in %s%s%s bci %d",
+                      p2i(thread), p2i(pc),
+                      blob != NULL ? blob->name() : "unknown code",
+                      method != NULL ? " " : "",
+                      method != NULL ? method->name_and_sig_as_C_string() : "",
+                      bci);
+
+  EventSafepointSyncSample event;
+  if (event.should_commit()) {
+    event.set_safepointId(safepoint_id);
+    event.set_sampledThread(JFR_THREAD_ID(thread));
+    event.set_codeBlob(blob != NULL ? blob->name() : NULL);
+    event.set_method(method);
+    event.set_bci(bci);
+    event.set_compileId(compile_id);
+    event.commit();
+  }
+}
+
+// Samples every thread on the list of threads that are still running.
+// Holding the CodeCache_lock keeps the sampled blobs from being flushed
+// while they are looked up; sampled nmethods are then locked so that they
+// can be decoded, logged and posted after the lock is released. The
+// Threads_lock, held by the caller, keeps the JFR thread sampler from
+// suspending the same threads concurrently.
+void SafepointSynchronize::sample_running_threads(ThreadSafepointState* tss_head) {
+  assert(Threads_lock->owned_by_self(), "must hold Threads_lock");
+  struct Sample {
+    JavaThread* _thread;
+    CodeBlob*   _blob;
+    address     _pc;
+  };
+  ResourceMark rm;
+  GrowableArray<Sample> samples;
+  {
+    MutexLocker ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    for (ThreadSafepointState* cur_tss = tss_head; cur_tss != NULL; cur_tss = cur_tss->get_next()) {
+      JavaThread* thread = cur_tss->thread();
+      SafepointSyncSampleTask task(thread);
+      task.run();
+      if (task.pc() != NULL) {
+        CodeBlob* blob = task.blob();
+        if (blob != NULL && blob->is_nmethod()) {
+          nmethodLocker::lock_nmethod(blob->as_nmethod());
+        }
+        Sample sample = { thread, blob, task.pc() };
+        samples.append(sample);
+      }
+    }
+  }
+  for (int i = 0; i < samples.length(); i++) {
+    const Sample& sample = samples.at(i);
+    post_safepoint_sync_sample_event(_safepoint_id + 1, sample._thread, sample._blob, sample._pc);
+    if (sample._blob != NULL && sample._blob->is_nmethod()) {
+      nmethodLocker::unlock_nmethod(sample._blob->as_nmethod());
+    }
+  }
+}
+
 int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int nof_threads, int* initial_running)
 {
   JavaThreadIteratorWithHandle jtiwh;
@@ -244,6 +358,8 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
 
   int iterations = 1; // The first iteration is above.
   int64_t start_time = os::javaTimeNanos();
+  int64_t sample_time = SafepointSyncSampleDelay > 0 ?
+    SafepointTracing::start_of_safepoint() + (int64_t)SafepointSyncSampleDelay * (NANOUNITS / MILLIUNITS) : 0;
 
   do {
     // Check if this has taken too long:
@@ -251,6 +367,12 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
       print_safepoint_timeout();
     }
 
+    // Find out where the threads holding us up are, once per safepoint.
+    if (sample_time != 0 && sample_time < os::javaTimeNanos()) {
+      sample_running_threads(tss_head);
+      sample_time = 0;
+    }
+
     p_prev = &tss_head;
     ThreadSafepointState *cur_tss = tss_head;
     while (cur_tss != NULL) {
@@ -515,11 +637,22 @@ public:
   }
 };
 
+class FlushJNIHandleCachesClosure : public ThreadClosure {
+public:
+  void do_thread(Thread* thread) {
+    JavaThread::cast(thread)->flush_jni_global_handle_caches();
+  }
+};
+
 class ParallelSPCleanupTask : public AbstractGangTask {
 private:
   SubTasksDone _subtasks;
   uint _num_workers;
   bool _do_lazy_roots;
+  // Per worker times of lazy root processing, reported together by
+  // report_lazy_roots() once all workers are done.
+  Ticks* _lazy_roots_start;
+  Ticks* _lazy_roots_end;
 
   class Tracer {
   private:
@@ -543,15 +676,74 @@ public:
     _subtasks(SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS),
     _num_workers(num_workers),
     _do_lazy_roots(!VMThread::vm_operation()->skip_thread_oop_barriers() &&
-                   Universe::heap()->uses_stack_watermark_barrier()) {}
+                   Universe::heap()->uses_stack_watermark_barrier()),
+    _lazy_roots_start(NULL),
+    _lazy_roots_end(NULL) {
+    if (_do_lazy_roots) {
+      _lazy_roots_start = NEW_C_HEAP_ARRAY(Ticks, _num_workers, mtInternal);
+      _lazy_roots_end = NEW_C_HEAP_ARRAY(Ticks, _num_workers, mtInternal);
+      for (uint i = 0; i < _num_workers; i++) {
+        ::new (&_lazy_roots_start[i]) Ticks();
+        ::new (&_lazy_roots_end[i]) Ticks();
+      }
+      if (_num_workers > 1) {
+        Threads::change_thread_claim_token();
+      }
+    }
+  }
 
-  void work(uint worker_id) {
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_LAZY_ROOT_PROCESSING)) {
-      if (_do_lazy_roots) {
-        Tracer t("lazy partial thread root processing");
-        ParallelSPCleanupThreadClosure cl;
-        Threads::threads_do(&cl);
+  ~ParallelSPCleanupTask() {
+    FREE_C_HEAP_ARRAY(Ticks, _lazy_roots_start);
+    FREE_C_HEAP_ARRAY(Ticks, _lazy_roots_end);
+  }
+
+  // Lazy root processing is logged and posted as one task, from the
+  // earliest start to the latest end over the workers. The log line
+  // also gives the time summed over the workers.
+  void report_lazy_roots() {
+    if (!_do_lazy_roots) {
+      return;
+    }
+    Ticks start;
+    Ticks end;
+    Tickspan total;
+    uint workers = 0;
+    for (uint i = 0; i < _num_workers; i++) {
+      if (_lazy_roots_start[i].value() == 0) {
+        // This worker did not get to run the task.
+        continue;
       }
+      if (workers == 0 || _lazy_roots_start[i] < start) {
+        start = _lazy_roots_start[i];
+      }
+      if (workers == 0 || _lazy_roots_end[i] > end) {
+        end = _lazy_roots_end[i];
+      }
+      total += _lazy_roots_end[i] - _lazy_roots_start[i];
+      workers++;
+    }
+    if (workers == 0) {
+      return;
+    }
+    const char* name = "lazy partial thread root processing";
+    log_info(safepoint, cleanup)("%s, %3.7f secs (%3.7f secs in %u workers)",
+                                 name, (end - start).seconds(), total.seconds(), workers);
+    EventSafepointCleanupTask event(UNTIMED);
+    event.set_starttime(start);
+    event.set_endtime(end);
+    post_safepoint_cleanup_task_event(event, SafepointSynchronize::safepoint_id(), name);
+  }
+
+  void work(uint worker_id) {
+    // All workers claim threads for lazy root processing, as its cost
+    // grows with the number of threads. Each worker records its own
+    // times, see report_lazy_roots().
+    if (_do_lazy_roots) {
+      assert(worker_id < _num_workers, "invariant");
+      _lazy_roots_start[worker_id] = Ticks::now();
+      ParallelSPCleanupThreadClosure cl;
+      Threads::possibly_parallel_threads_do(_num_workers > 1, &cl);
+      _lazy_roots_end[worker_id] = Ticks::now();
     }
 
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES)) {
@@ -585,12 +777,30 @@ public:
       }
     }
 
+    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_FLUSH_JNI_HANDLE_CACHES)) {
+      if (JNIGlobalHandleCacheSize > 0 || JNIWeakGlobalHandleCacheSize > 0) {
+        // Cached entries keep their blocks from being deleted
+        Tracer t("flushing JNI handle caches");
+        FlushJNIHandleCachesClosure cl;
+        Threads::java_threads_do(&cl);
+      }
+    }
+
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_REQUEST_OOPSTORAGE_CLEANUP)) {
       // Don't bother reporting event or time for this very short operation.
       // To have any utility we'd also want to report whether needed.
       OopStorage::trigger_cleanup_if_needed();
     }
 
+    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_MONITOR_AUDIT)) {
+      if (log_is_enabled(Debug, monitorinflation)) {
+        // The VMThread calls do_final_audit_and_print_stats() which calls
+        // audit_and_print_stats() at the Info level at VM exit time.
+        Tracer t("auditing object monitors");
+        ObjectSynchronizer::audit_and_print_stats(false /* on_exit */);
+      }
+    }
+
     _subtasks.all_tasks_claimed();
   }
 };
@@ -608,19 +818,15 @@ void SafepointSynchronize::do_cleanup_tasks() {
     uint num_cleanup_workers = cleanup_workers->active_workers();
     ParallelSPCleanupTask cleanup(num_cleanup_workers);
     cleanup_workers->run_task(&cleanup);
+    cleanup.report_lazy_roots();
   } else {
     // Serial cleanup using VMThread.
     ParallelSPCleanupTask cleanup(1);
     cleanup.work(0);
+    cleanup.report_lazy_roots();
   }
 
   assert(InlineCacheBuffer::is_empty(), "should have cleaned up ICBuffer");
-
-  if (log_is_enabled(Debug, monitorinflation)) {
-    // The VMThread calls do_final_audit_and_print_stats() which calls
-    // audit_and_print_stats() at the Info level at VM exit time.
-    ObjectSynchronizer::audit_and_print_stats(false /* on_exit */);
-  }
 }
 
 // Methods for determining if a JavaThread is safepoint safe.
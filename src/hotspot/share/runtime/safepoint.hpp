@@ -69,14 +69,17 @@ class SafepointSynchronize : AllStatic {
   };
 
   // The enums are listed in the order of the tasks when done serially.
+  // Lazy root processing comes first and is shared by all workers, so
+  // it is not a claimed task.
   enum SafepointCleanupTasks {
-    SAFEPOINT_CLEANUP_LAZY_ROOT_PROCESSING,
     SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES,
     SAFEPOINT_CLEANUP_COMPILATION_POLICY,
     SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH,
     SAFEPOINT_CLEANUP_STRING_TABLE_REHASH,
     SAFEPOINT_CLEANUP_SYSTEM_DICTIONARY_RESIZE,
+    SAFEPOINT_CLEANUP_FLUSH_JNI_HANDLE_CACHES,
     SAFEPOINT_CLEANUP_REQUEST_OOPSTORAGE_CLEANUP,
+    SAFEPOINT_CLEANUP_MONITOR_AUDIT,
     // Leave this one last.
     SAFEPOINT_CLEANUP_NUM_TASKS
   };
@@ -112,6 +115,8 @@ class SafepointSynchronize : AllStatic {
 
   // For debug long safepoint
   static void print_safepoint_timeout();
+  // For attributing long time to safepoint
+  static void sample_running_threads(ThreadSafepointState* tss_head);
 
   // Helper methods for safepoint procedure:
   static void arm_safepoint();
@@ -114,6 +114,9 @@ size_t   NMethodSweeper::_sweep_threshold_bytes        = 0;    // Threshold for
 
 volatile bool NMethodSweeper::_should_sweep            = false;// Indicates if a normal sweep will be done
 volatile bool NMethodSweeper::_force_sweep             = false;// Indicates if a forced sweep will be done
+volatile bool NMethodSweeper::_should_unload           = false;// Indicates if an unloading GC should be requested
+uint     NMethodSweeper::_unloading_gc_count           = max_juint; // Total collections at the last unloading GC request
+size_t   NMethodSweeper::_unloading_gc_used            = 0;    // Code cache bytes in use at the last unloading GC request
 volatile size_t NMethodSweeper::_bytes_changed         = 0;    // Counts the total nmethod size if the nmethod changed from:
                                                                //   1) alive       -> not_entrant
                                                                //   2) not_entrant -> zombie
@@ -220,6 +223,9 @@ void NMethodSweeper::sweeper_loop() {
       const long wait_time = 60*60*24 * 1000;
       timeout = waiter.wait(wait_time);
     }
+    if (!timeout && _should_unload) {
+      possibly_request_unloading_gc();
+    }
     if (!timeout && (_should_sweep || _force_sweep)) {
       sweep();
     }
@@ -233,10 +239,33 @@ void NMethodSweeper::report_allocation(int code_blob_type) {
   if (should_start_aggressive_sweep(code_blob_type)) {
     MonitorLocker waiter(CodeSweeper_lock, Mutex::_no_safepoint_check_flag);
     _should_sweep = true;
+    _should_unload = CodeCacheUnloadingGC;
     CodeSweeper_lock->notify();
   }
 }
 
+/**
+  * The sweeper only reclaims nmethods that were made not entrant, while the
+  * nmethods of dead classes are only freed by a GC that unloads classes.
+  * Ask for one when the code cache runs low. Back off unless a GC has
+  * happened and the code cache has grown since the last request, so that a
+  * code cache that stays full of live code does not trigger a GC each time
+  * aggressive sweeping starts. Concurrent collectors start a cycle and return.
+  */
+void NMethodSweeper::possibly_request_unloading_gc() {
+  _should_unload = false;
+  CollectedHeap* heap = Universe::heap();
+  uint gc_count = heap->total_collections();
+  size_t used = CodeCache::capacity() - CodeCache::unallocated_capacity();
+  if (gc_count == _unloading_gc_count || used <= _unloading_gc_used) {
+    return;
+  }
+  _unloading_gc_count = gc_count;
+  _unloading_gc_used = used;
+  log_info(codecache)("Code cache is running low, requesting a GC to unload code");
+  heap->collect(GCCause::_codecache_GC_threshold);
+}
+
 bool NMethodSweeper::should_start_aggressive_sweep(int code_blob_type) {
   // Makes sure that we do not invoke the sweeper too often during startup.
   double start_threshold = 100.0 / (double)StartAggressiveSweepingAt;
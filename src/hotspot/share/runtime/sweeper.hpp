@@ -74,6 +74,9 @@ class NMethodSweeper : public AllStatic {
 
   static volatile bool _should_sweep;             // Indicates if a normal sweep will be done
   static volatile bool _force_sweep;              // Indicates if a forced sweep will be done
+  static volatile bool _should_unload;            // Indicates if an unloading GC should be requested
+  static uint      _unloading_gc_count;           // Total collections when the last unloading GC was requested
+  static size_t    _unloading_gc_used;            // Code cache bytes in use when the last unloading GC was requested
   static volatile size_t _bytes_changed;          // Counts the total nmethod size if the nmethod changed from:
                                                   //   1) alive       -> not_entrant
                                                   //   2) not_entrant -> zombie
@@ -95,6 +98,7 @@ class NMethodSweeper : public AllStatic {
   static void sweep_code_cache();
   static void handle_safepoint_request();
   static void do_stack_scanning();
+  static void possibly_request_unloading_gc();
   static void sweep();
  public:
   static long traversal_count()                    { return _traversals; }
@@ -37,6 +37,7 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/lockStack.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
@@ -78,15 +79,17 @@ size_t MonitorList::max() const {
   return Atomic::load(&_max);
 }
 
-// Walk the in-use list and unlink (at most MonitorDeflationMax) deflated
-// ObjectMonitors. Returns the number of unlinked ObjectMonitors.
+// Walk the in-use list after start_prev (from the head if start_prev is
+// NULL) and unlink (at most max) deflated ObjectMonitors. Returns the
+// number of unlinked ObjectMonitors.
 size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
                                     elapsedTimer* timer_p,
+                                    ObjectMonitor* start_prev, size_t max,
                                     GrowableArray<ObjectMonitor*>* unlinked_list) {
   size_t unlinked_count = 0;
-  ObjectMonitor* prev = NULL;
+  ObjectMonitor* prev = start_prev;
   ObjectMonitor* head = Atomic::load_acquire(&_head);
-  ObjectMonitor* m = head;
+  ObjectMonitor* m = (prev == NULL) ? head : prev->next_om();
   // The in-use list head can be NULL during the final audit.
   while (m != NULL) {
     if (m->is_being_async_deflated()) {
@@ -97,7 +100,7 @@ size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
         unlinked_count++;
         unlinked_list->append(next);
         next = next_next;
-        if (unlinked_count >= (size_t)MonitorDeflationMax) {
+        if (unlinked_count >= max) {
           // Reached the max so bail out on the gathering loop.
           break;
         }
@@ -114,7 +117,7 @@ size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
       } else {
         prev->set_next_om(next);
       }
-      if (unlinked_count >= (size_t)MonitorDeflationMax) {
+      if (unlinked_count >= max) {
         // Reached the max so bail out on the searching loop.
         break;
       }
@@ -239,8 +242,18 @@ static size_t _in_use_list_ceiling = 0;
 bool volatile ObjectSynchronizer::_is_async_deflation_requested = false;
 bool volatile ObjectSynchronizer::_is_final_audit = false;
 jlong ObjectSynchronizer::_last_async_deflation_time_ns = 0;
+size_t ObjectSynchronizer::_deflated_count_total = 0;
 static uintx _no_progress_cnt = 0;
 
+// A deflation cycle that stops early because of MonitorDeflationMax or
+// MonitorDeflationSliceMillis remembers the last ObjectMonitor it left
+// in place and the next cycle resumes right after it. Only the thread
+// doing the deflation deflates, unlinks and deletes ObjectMonitors, and
+// new ObjectMonitors are only added at the head of the in-use list, so
+// the anchor and its next field stay valid between cycles. NULL means
+// that the next cycle starts at the head of the in-use list.
+static ObjectMonitor* _deflation_anchor = NULL;
+
 // =====================> Quick functions
 
 // The quick_* forms are special fast-path variants used to improve
@@ -275,6 +288,12 @@ bool ObjectSynchronizer::quick_notify(oopDesc* obj, JavaThread* current, bool al
     return true;
   }
 
+  if (mark.is_fast_locked() && current->lock_stack().contains(cast_to_oop(obj))) {
+    // Degenerate notify
+    // fast-locked by caller so by definition the implied waitset is empty.
+    return true;
+  }
+
   if (mark.has_monitor()) {
     ObjectMonitor* const mon = mark.monitor();
     assert(mon->object() == oop(obj), "invariant");
@@ -322,6 +341,15 @@ bool ObjectSynchronizer::quick_enter(oop obj, JavaThread* current,
 
   const markWord mark = obj->mark();
 
+  if (UseLightweightLocking && !mark.has_monitor()) {
+    // The compiled fast paths only handle the common cases, e.g. not a
+    // recursive enter below the innermost lock stack entry. Take the lock
+    // here without a thread state transition if that needs nothing more
+    // than a CAS of the header.
+    lock->set_displaced_header(markWord::unused_mark());
+    return fast_lock(obj, current);
+  }
+
   if (mark.has_monitor()) {
     ObjectMonitor* const m = mark.monitor();
     // An async deflation or GC can race us before we manage to make
@@ -423,11 +451,97 @@ void ObjectSynchronizer::handle_sync_on_value_based_class(Handle obj, JavaThread
 // of this algorithm. Make sure to update that code if the following function is
 // changed. The implementation is extremely sensitive to race condition. Be careful.
 
+// Attempts to lightweight-lock obj for current. This succeeds if obj is
+// unlocked or already fast-locked by current, and there is room on the lock
+// stack. Never blocks or safepoints.
+bool ObjectSynchronizer::fast_lock(oop obj, JavaThread* current) {
+  assert(UseLightweightLocking, "must be");
+  LockStack& lock_stack = current->lock_stack();
+  if (!lock_stack.can_push()) {
+    return false;
+  }
+  markWord mark = obj->mark();
+  while (mark.is_neutral()) {
+    const markWord old_mark = obj->cas_set_mark(mark.set_fast_locked(), mark);
+    if (old_mark == mark) {
+      lock_stack.push(obj);
+      return true;
+    }
+    // Lost a race with another locker or a hash code installation.
+    mark = old_mark;
+  }
+  if (mark.is_fast_locked() && lock_stack.contains(obj)) {
+    // Recursive enter, recorded as another entry.
+    lock_stack.push(obj);
+    return true;
+  }
+  return false;
+}
+
+// Releases one lightweight lock on obj held by current. Returns false if obj
+// was inflated in the meantime, leaving the entry on the lock stack so that
+// inflate() hands ownership of the monitor to current.
+bool ObjectSynchronizer::fast_unlock(oop obj, JavaThread* current) {
+  assert(UseLightweightLocking, "must be");
+  LockStack& lock_stack = current->lock_stack();
+  markWord mark = obj->mark();
+  if (!mark.is_fast_locked() || !lock_stack.contains(obj)) {
+    return false;
+  }
+  lock_stack.pop(obj);
+  if (lock_stack.contains(obj)) {
+    // Recursive exit.
+    return true;
+  }
+  do {
+    // The header may change under us when another thread installs a hash
+    // code, or when it inflates the monitor to wait for the lock.
+    const markWord old_mark = obj->cas_set_mark(mark.set_unlocked(), mark);
+    if (old_mark == mark) {
+      return true;
+    }
+    mark = old_mark;
+  } while (mark.is_fast_locked());
+  lock_stack.push(obj);
+  return false;
+}
+
+// A monitor inflated over a lightweight lock is owned anonymously until the
+// locking thread, the one with obj on its lock stack, claims it. The lock
+// stack entries become recursions of the monitor.
+void ObjectSynchronizer::claim_anonymous_owner(Thread* current, ObjectMonitor* m, oop obj) {
+  assert(UseLightweightLocking, "must be");
+  if (current->is_Java_thread() && m->is_owner_anonymous()) {
+    LockStack& lock_stack = JavaThread::cast(current)->lock_stack();
+    if (lock_stack.contains(obj)) {
+      int entries = lock_stack.remove(obj);
+      m->set_owner_from(ANONYMOUS_OWNER, current);
+      m->_recursions = entries - 1;
+    }
+  }
+}
+
 void ObjectSynchronizer::enter(Handle obj, BasicLock* lock, JavaThread* current) {
   if (obj->klass()->is_value_based()) {
     handle_sync_on_value_based_class(obj, current);
   }
 
+  if (UseLightweightLocking) {
+    // The BasicLock is not used, keep it looking inflated to any code
+    // that inspects it, e.g. BasicLock::move_to().
+    lock->set_displaced_header(markWord::unused_mark());
+    if (fast_lock(obj(), current)) {
+      return;
+    }
+    // Contended, lock stack full or already inflated.
+    while (true) {
+      ObjectMonitor* monitor = inflate(current, obj(), inflate_cause_monitor_enter);
+      if (monitor->enter(current)) {
+        return;
+      }
+    }
+  }
+
   markWord mark = obj->mark();
   if (mark.is_neutral()) {
     // Anticipate successful CAS -- the ST of the displaced mark must
@@ -462,6 +576,17 @@ void ObjectSynchronizer::enter(Handle obj, BasicLock* lock, JavaThread* current)
 }
 
 void ObjectSynchronizer::exit(oop object, BasicLock* lock, JavaThread* current) {
+  if (UseLightweightLocking) {
+    if (fast_unlock(object, current)) {
+      return;
+    }
+    // The ObjectMonitor* can't be async deflated until ownership is
+    // dropped inside exit() and the ObjectMonitor* must be !is_busy().
+    ObjectMonitor* monitor = inflate(current, object, inflate_cause_vm_internal);
+    monitor->exit(current);
+    return;
+  }
+
   markWord mark = object->mark();
 
   markWord dhw = lock->displaced_header();
@@ -643,6 +768,10 @@ void ObjectSynchronizer::notify(Handle obj, TRAPS) {
     // Not inflated so there can't be any waiters to notify.
     return;
   }
+  if (mark.is_fast_locked() && current->lock_stack().contains(obj())) {
+    // Not inflated so there can't be any waiters to notify.
+    return;
+  }
   // The ObjectMonitor* can't be async deflated until ownership is
   // dropped by the calling thread.
   ObjectMonitor* monitor = inflate(current, obj(), inflate_cause_notify);
@@ -658,6 +787,10 @@ void ObjectSynchronizer::notifyall(Handle obj, TRAPS) {
     // Not inflated so there can't be any waiters to notify.
     return;
   }
+  if (mark.is_fast_locked() && current->lock_stack().contains(obj())) {
+    // Not inflated so there can't be any waiters to notify.
+    return;
+  }
   // The ObjectMonitor* can't be async deflated until ownership is
   // dropped by the calling thread.
   ObjectMonitor* monitor = inflate(current, obj(), inflate_cause_notify);
@@ -848,6 +981,21 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread* current, oop obj) {
       }
       // Fall thru so we only have one place that installs the hash in
       // the ObjectMonitor.
+    } else if (mark.is_fast_locked()) {
+      // The header is in place, so the hash can be installed without
+      // inflating. The owner retries its unlocking CAS if it races us.
+      hash = mark.hash();
+      if (hash != 0) {
+        return hash;
+      }
+      hash = get_next_hash(current, obj);
+      temp = mark.copy_set_hash(hash);
+      test = obj->cas_set_mark(temp, mark);
+      if (test == mark) {
+        return hash;
+      }
+      // Unlocked, relocked or inflated meanwhile; start over.
+      continue;
     } else if (current->is_lock_owned((address)mark.locker())) {
       // This is a stack lock owned by the calling thread so fetch the
       // displaced markWord from the BasicLock on the stack.
@@ -924,11 +1072,18 @@ bool ObjectSynchronizer::current_thread_holds_lock(JavaThread* current,
   if (mark.has_locker()) {
     return current->is_lock_owned((address)mark.locker());
   }
+  // Uncontended case, object on the lock stack
+  if (mark.is_fast_locked()) {
+    return current->lock_stack().contains(obj);
+  }
   // Contended case, header points to ObjectMonitor (tagged pointer)
   if (mark.has_monitor()) {
     // The first stage of async deflation does not affect any field
     // used by this comparison so the ObjectMonitor* is usable here.
     ObjectMonitor* monitor = mark.monitor();
+    if (monitor->is_owner_anonymous()) {
+      return current->lock_stack().contains(obj);
+    }
     return monitor->is_entered(current) != 0;
   }
   // Unlocked case, header in place
@@ -948,13 +1103,18 @@ JavaThread* ObjectSynchronizer::get_lock_owner(ThreadsList * t_list, Handle h_ob
     owner = (address) mark.locker();
   }
 
+  // Uncontended case, object on the owner's lock stack
+  else if (mark.is_fast_locked()) {
+    return Threads::owning_thread_from_object(t_list, obj);
+  }
+
   // Contended case, header points to ObjectMonitor (tagged pointer)
   else if (mark.has_monitor()) {
     // The first stage of async deflation does not affect any field
     // used by this comparison so the ObjectMonitor* is usable here.
     ObjectMonitor* monitor = mark.monitor();
     assert(monitor != NULL, "monitor should be non-null");
-    owner = (address) monitor->owner();
+    return Threads::owning_thread_from_monitor(t_list, monitor);
   }
 
   if (owner != NULL) {
@@ -1130,6 +1290,9 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* current, oop object,
       ObjectMonitor* inf = mark.monitor();
       markWord dmw = inf->header();
       assert(dmw.is_neutral(), "invariant: header=" INTPTR_FORMAT, dmw.value());
+      if (UseLightweightLocking) {
+        claim_anonymous_owner(current, inf, object);
+      }
       return inf;
     }
 
@@ -1156,6 +1319,37 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* current, oop object,
 
     LogStreamHandle(Trace, monitorinflation) lsh;
 
+    // CASE: fast-locked
+    // Could be fast-locked either by this thread or by some other thread.
+    // The header is in place, so the monitor can be installed with a single
+    // CAS; the locking thread notices and takes over the anonymous owner.
+    if (mark.is_fast_locked()) {
+      ObjectMonitor* m = new ObjectMonitor(object);
+      m->set_header(mark.set_unlocked());
+      m->set_owner_anonymous();
+      if (object->cas_set_mark(markWord::encode(m), mark) != mark) {
+        delete m;
+        continue;       // Interference -- just retry
+      }
+
+      // Once the ObjectMonitor is configured and object is associated
+      // with the ObjectMonitor, it is safe to allow async deflation:
+      _in_use_list.add(m);
+
+      OM_PERFDATA_OP(Inflations, inc());
+      if (log_is_enabled(Trace, monitorinflation)) {
+        ResourceMark rm(current);
+        lsh.print_cr("inflate(fast-locked): object=" INTPTR_FORMAT ", mark="
+                     INTPTR_FORMAT ", type='%s'", p2i(object),
+                     object->mark().value(), object->klass()->external_name());
+      }
+      if (event.should_commit()) {
+        post_monitor_inflate_event(&event, object, cause);
+      }
+      claim_anonymous_owner(current, m, object);
+      return m;
+    }
+
     if (mark.has_locker()) {
       ObjectMonitor* m = new ObjectMonitor(object);
       // Optimistically prepare the ObjectMonitor - anticipate successful CAS
@@ -1313,20 +1507,40 @@ void ObjectSynchronizer::chk_for_block_req(JavaThread* current, const char* op_n
   }
 }
 
-// Walk the in-use list and deflate (at most MonitorDeflationMax) idle
-// ObjectMonitors. Returns the number of deflated ObjectMonitors.
+// Walk the in-use list after *anchor_p (from the head if it is NULL) and
+// deflate (at most MonitorDeflationMax) idle ObjectMonitors, spending at
+// most MonitorDeflationSliceMillis unless this is the final audit. On
+// return *anchor_p is the last ObjectMonitor that was left in place and
+// *reached_end_p tells if the walk got to the end of the list. Returns
+// the number of deflated ObjectMonitors.
 size_t ObjectSynchronizer::deflate_monitor_list(Thread* current, LogStream* ls,
-                                                elapsedTimer* timer_p) {
-  MonitorList::Iterator iter = _in_use_list.iterator();
+                                                elapsedTimer* timer_p,
+                                                ObjectMonitor** anchor_p,
+                                                bool* reached_end_p) {
+  ObjectMonitor* anchor = *anchor_p;
+  MonitorList::Iterator iter = (anchor == NULL) ? _in_use_list.iterator()
+                                                : MonitorList::Iterator(anchor->next_om());
   size_t deflated_count = 0;
+  size_t visited_count = 0;
+  jlong slice_end_ns = 0;
+  if (MonitorDeflationSliceMillis > 0 && !is_final_audit()) {
+    slice_end_ns = os::javaTimeNanos() + MonitorDeflationSliceMillis * NANOSECS_PER_MILLISEC;
+  }
 
   while (iter.has_next()) {
     if (deflated_count >= (size_t)MonitorDeflationMax) {
       break;
     }
+    // Reading the clock for every ObjectMonitor would dominate the walk.
+    if (slice_end_ns != 0 && (++visited_count % 128) == 0 &&
+        os::javaTimeNanos() >= slice_end_ns) {
+      break;
+    }
     ObjectMonitor* mid = iter.next();
     if (mid->deflate_monitor()) {
       deflated_count++;
+    } else {
+      anchor = mid;
     }
 
     if (current->is_Java_thread()) {
@@ -1336,6 +1550,8 @@ size_t ObjectSynchronizer::deflate_monitor_list(Thread* current, LogStream* ls,
     }
   }
 
+  *anchor_p = anchor;
+  *reached_end_p = !iter.has_next();
   return deflated_count;
 }
 
@@ -1376,8 +1592,15 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
     timer.start();
   }
 
-  // Deflate some idle ObjectMonitors.
-  size_t deflated_count = deflate_monitor_list(current, ls, &timer);
+  // Deflate some idle ObjectMonitors, resuming after the anchor left by
+  // the previous cycle. The final audit always walks the whole list.
+  if (is_final_audit()) {
+    _deflation_anchor = NULL;
+  }
+  ObjectMonitor* start_anchor = _deflation_anchor;
+  ObjectMonitor* anchor = start_anchor;
+  bool reached_end = false;
+  size_t deflated_count = deflate_monitor_list(current, ls, &timer, &anchor, &reached_end);
   if (deflated_count > 0 || is_final_audit()) {
     // There are ObjectMonitors that have been deflated or this is the
     // final audit and all the remaining ObjectMonitors have been
@@ -1387,8 +1610,18 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
     // Unlink deflated ObjectMonitors from the in-use list.
     ResourceMark rm;
     GrowableArray<ObjectMonitor*> delete_list((int)deflated_count);
-    size_t unlinked_count = _in_use_list.unlink_deflated(current, ls, &timer,
-                                                         &delete_list);
+    // Everything deflated in this cycle is after start_anchor. The final
+    // audit also needs to pick up ObjectMonitors that were deflated
+    // before the MonitorDeflationThread blocked for the final safepoint.
+    size_t unlinked_count;
+    if (is_final_audit()) {
+      unlinked_count = _in_use_list.unlink_deflated(current, ls, &timer, NULL,
+                                                    (size_t)MonitorDeflationMax,
+                                                    &delete_list);
+    } else {
+      unlinked_count = _in_use_list.unlink_deflated(current, ls, &timer, start_anchor,
+                                                    deflated_count, &delete_list);
+    }
     if (current->is_Java_thread()) {
       if (ls != NULL) {
         timer.stop();
@@ -1439,15 +1672,29 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
 
   OM_PERFDATA_OP(MonExtant, set_value(_in_use_list.count()));
   OM_PERFDATA_OP(Deflations, inc(deflated_count));
+  _deflated_count_total += deflated_count;
 
   GVars.stw_random = os::random();
 
   if (deflated_count != 0) {
     _no_progress_cnt = 0;
-  } else {
+  } else if (reached_end) {
+    // Only a walk that got to the end of the list without deflating
+    // anything counts as no progress.
     _no_progress_cnt++;
   }
 
+  if (reached_end) {
+    _deflation_anchor = NULL;
+  } else {
+    // The cycle ran out of budget; resume after the anchor right away
+    // instead of waiting for the next threshold check.
+    _deflation_anchor = anchor;
+    if (current->is_Java_thread()) {
+      set_is_async_deflation_requested(true);
+    }
+  }
+
   return deflated_count;
 }
 
@@ -46,6 +46,7 @@ private:
 public:
   void add(ObjectMonitor* monitor);
   size_t unlink_deflated(Thread* current, LogStream* ls, elapsedTimer* timer_p,
+                         ObjectMonitor* start_prev, size_t max,
                          GrowableArray<ObjectMonitor*>* unlinked_list);
   size_t count() const;
   size_t max() const;
@@ -147,7 +148,12 @@ class ObjectSynchronizer : AllStatic {
                                 const char* cnt_name, size_t cnt, LogStream* ls,
                                 elapsedTimer* timer_p);
   static size_t deflate_monitor_list(Thread* current, LogStream* ls,
-                                     elapsedTimer* timer_p);
+                                     elapsedTimer* timer_p,
+                                     ObjectMonitor** anchor_p,
+                                     bool* reached_end_p);
+  static size_t in_use_list_count() { return _in_use_list.count(); }
+  static size_t in_use_list_max() { return _in_use_list.max(); }
+  static size_t deflated_count_total() { return _deflated_count_total; }
   static size_t in_use_list_ceiling();
   static void dec_in_use_list_ceiling();
   static void inc_in_use_list_ceiling();
@@ -176,6 +182,7 @@ class ObjectSynchronizer : AllStatic {
   static volatile bool _is_async_deflation_requested;
   static volatile bool _is_final_audit;
   static jlong         _last_async_deflation_time_ns;
+  static size_t        _deflated_count_total;
 
   // Support for SynchronizerTest access to GVars fields:
   static u_char* get_gvars_addr();
@@ -184,6 +191,11 @@ class ObjectSynchronizer : AllStatic {
   static u_char* get_gvars_stw_random_addr();
 
   static void handle_sync_on_value_based_class(Handle obj, JavaThread* current);
+
+  // Lightweight locking support (UseLightweightLocking)
+  static bool fast_lock(oop obj, JavaThread* current);
+  static bool fast_unlock(oop obj, JavaThread* current);
+  static void claim_anonymous_owner(Thread* current, ObjectMonitor* m, oop obj);
 };
 
 // ObjectLocker enforces balanced locking and can never throw an
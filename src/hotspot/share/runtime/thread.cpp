@@ -27,6 +27,7 @@
 #include "jvm.h"
 #include "cds/dynamicArchive.hpp"
 #include "cds/metaspaceShared.hpp"
+#include "classfile/backgroundVerifier.hpp"
 #include "classfile/classLoader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/javaThreadStatus.hpp"
@@ -87,11 +88,12 @@
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.inline.hpp"
+#include "runtime/lockStack.inline.hpp"
 #include "runtime/jniPeriodicChecker.hpp"
 #include "runtime/monitorDeflationThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/nonJavaThread.hpp"
-#include "runtime/objectMonitor.hpp"
+#include "runtime/objectMonitor.inline.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/prefetch.inline.hpp"
@@ -217,6 +219,10 @@ Thread::Thread() {
 
   // allocated data structures
   set_osthread(NULL);
+  for (int i = 0; i < num_cached_chunks; i++) {
+    _cached_chunks[i] = NULL;
+  }
+  _chunk_cache_enabled = true;
   set_resource_area(new (mtThread)ResourceArea());
   DEBUG_ONLY(_current_resource_mark = NULL;)
   set_handle_area(new (mtThread) HandleArea(NULL));
@@ -402,6 +408,7 @@ Thread::~Thread() {
   assert(last_handle_mark() != NULL, "check we have an element");
   delete last_handle_mark();
   assert(last_handle_mark() == NULL, "check we have reached the end");
+  Chunk::release_thread_cached_chunks(this);
 
   ParkEvent::Release(_ParkEvent);
   // Set to NULL as a termination indicator for has_terminated().
@@ -1021,6 +1028,9 @@ JavaThread::JavaThread() :
 
   _jni_active_critical(0),
   _pending_jni_exception_check_fn(nullptr),
+  _jni_global_handle_cache(nullptr),
+  _jni_weak_global_handle_cache(nullptr),
+  _lock_stack(),
   _depth_first_number(0),
 
   // JVMTI PopFrame support
@@ -1035,6 +1045,9 @@ JavaThread::JavaThread() :
   _jvmti_thread_state(nullptr),
   _interp_only_mode(0),
   _should_post_on_exceptions_flag(JNI_FALSE),
+  _profile_sample_countdown(1),
+  // xorshift needs a non-zero state
+  _profile_sample_seed((juint)os::random() | 1),
   _thread_stat(new ThreadStatistics()),
 
   _parker(),
@@ -1425,6 +1438,15 @@ void JavaThread::exit(bool destroy_vm, ExitType exit_type) {
     JNIHandleBlock::release_block(block);
   }
 
+  if (_jni_global_handle_cache != NULL) {
+    delete _jni_global_handle_cache;
+    _jni_global_handle_cache = NULL;
+  }
+  if (_jni_weak_global_handle_cache != NULL) {
+    delete _jni_weak_global_handle_cache;
+    _jni_weak_global_handle_cache = NULL;
+  }
+
   // These have to be removed while this is still a valid thread.
   _stack_overflow_state.remove_stack_guard_pages();
 
@@ -1482,6 +1504,32 @@ void JavaThread::exit(bool destroy_vm, ExitType exit_type) {
   }
 }
 
+JNIGlobalHandleCache* JavaThread::jni_global_handle_cache() {
+  assert(JNIGlobalHandleCacheSize > 0, "cache not enabled");
+  if (_jni_global_handle_cache == NULL) {
+    _jni_global_handle_cache = new JNIGlobalHandleCache(false /* weak */, JNIGlobalHandleCacheSize);
+  }
+  return _jni_global_handle_cache;
+}
+
+JNIGlobalHandleCache* JavaThread::jni_weak_global_handle_cache() {
+  assert(JNIWeakGlobalHandleCacheSize > 0, "cache not enabled");
+  if (_jni_weak_global_handle_cache == NULL) {
+    _jni_weak_global_handle_cache = new JNIGlobalHandleCache(true /* weak */, JNIWeakGlobalHandleCacheSize);
+  }
+  return _jni_weak_global_handle_cache;
+}
+
+void JavaThread::flush_jni_global_handle_caches() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (_jni_global_handle_cache != NULL) {
+    _jni_global_handle_cache->flush();
+  }
+  if (_jni_weak_global_handle_cache != NULL) {
+    _jni_weak_global_handle_cache->flush();
+  }
+}
+
 void JavaThread::cleanup_failed_attach_current_thread(bool is_daemon) {
   if (active_handles() != NULL) {
     JNIHandleBlock* block = active_handles();
@@ -1495,6 +1543,15 @@ void JavaThread::cleanup_failed_attach_current_thread(bool is_daemon) {
     JNIHandleBlock::release_block(block);
   }
 
+  if (_jni_global_handle_cache != NULL) {
+    delete _jni_global_handle_cache;
+    _jni_global_handle_cache = NULL;
+  }
+  if (_jni_weak_global_handle_cache != NULL) {
+    delete _jni_weak_global_handle_cache;
+    _jni_weak_global_handle_cache = NULL;
+  }
+
   // These have to be removed while this is still a valid thread.
   _stack_overflow_state.remove_stack_guard_pages();
 
@@ -1958,6 +2015,8 @@ void JavaThread::oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf) {
   f->do_oop((oop*) &_jvmci_reserved_oop0);
 #endif
 
+  _lock_stack.oops_do(f);
+
   if (jvmti_thread_state() != NULL) {
     jvmti_thread_state()->oops_do(f, cf);
   }
@@ -2075,6 +2134,14 @@ void JavaThread::print_on(outputStream *st, bool print_extended_info) const {
       st->print("   No compile task");
     }
     st->cr();
+    CompilerCounters* counters = ((CompilerThread*)this)->counters();
+    if (counters != NULL) {
+      st->print("   Compilation CPU time:");
+      for (int level = CompLevel_simple; level <= CompLevel_full_optimization; level++) {
+        st->print(" tier%d=%.3fs", level, (double)counters->cpu_time(level) / NANOSECS_PER_SEC);
+      }
+      st->cr();
+    }
   }
 }
 
@@ -2970,6 +3037,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // cache the system and platform class loaders
   SystemDictionary::compute_java_loaders(CHECK_JNI_ERR);
 
+  if (BackgroundVerificationThreads > 0) {
+    BackgroundVerifier::initialize();
+  }
+
 #if INCLUDE_CDS
   // capture the module path info from the ModuleEntryTable
   ClassLoader::initialize_module_path(THREAD);
@@ -3666,6 +3737,25 @@ JavaThread *Threads::owning_thread_from_monitor_owner(ThreadsList * t_list,
   return the_owner;
 }
 
+JavaThread* Threads::owning_thread_from_monitor(ThreadsList* t_list, ObjectMonitor* monitor) {
+  if (UseLightweightLocking && monitor->is_owner_anonymous()) {
+    return owning_thread_from_object(t_list, monitor->object());
+  }
+  return owning_thread_from_monitor_owner(t_list, (address)monitor->owner());
+}
+
+JavaThread* Threads::owning_thread_from_object(ThreadsList* t_list, oop obj) {
+  assert(UseLightweightLocking, "only lightweight locks are on lock stacks");
+  // Lock stacks are only stable for this lookup at a safepoint or for the
+  // current thread; like the search above this may miss a racing owner.
+  DO_JAVA_THREADS(t_list, q) {
+    if (q->lock_stack().contains(obj)) {
+      return q;
+    }
+  }
+  return NULL;
+}
+
 class PrintOnClosure : public ThreadClosure {
 private:
   outputStream* _st;
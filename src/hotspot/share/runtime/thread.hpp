@@ -36,6 +36,7 @@
 #include "runtime/globals.hpp"
 #include "runtime/handshake.hpp"
 #include "runtime/javaFrameAnchor.hpp"
+#include "runtime/lockStack.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/park.hpp"
@@ -61,6 +62,7 @@ class ThreadsList;
 class ThreadsSMRSupport;
 
 class JNIHandleBlock;
+class JNIGlobalHandleCache;
 class JvmtiRawMonitor;
 class JvmtiSampledObjectAllocEventCollector;
 class JvmtiThreadState;
@@ -80,6 +82,7 @@ class JvmtiDeferredUpdates;
 class ThreadClosure;
 class ICRefillVerifier;
 
+class Chunk;
 class Metadata;
 class ResourceArea;
 
@@ -166,7 +169,7 @@ class Thread: public ThreadShadow {
 
   // JavaThread lifecycle support:
   friend class SafeThreadsListPtr;  // for _threads_list_ptr, cmpxchg_threads_hazard_ptr(), {dec_,inc_,}nested_threads_hazard_ptr_cnt(), {g,s}et_threads_hazard_ptr(), inc_nested_handle_cnt(), tag_hazard_ptr() access
-  friend class ScanHazardPtrGatherProtectedThreadsClosure;  // for cmpxchg_threads_hazard_ptr(), get_threads_hazard_ptr(), is_hazard_ptr_tagged() access
+  friend class ScanHazardPtrFindProtectedThreadClosure;  // for cmpxchg_threads_hazard_ptr(), get_threads_hazard_ptr(), is_hazard_ptr_tagged() access
   friend class ScanHazardPtrGatherThreadsListClosure;  // for get_threads_hazard_ptr(), untag_hazard_ptr() access
   friend class ScanHazardPtrPrintMatchingThreadsClosure;  // for get_threads_hazard_ptr(), is_hazard_ptr_tagged() access
   friend class ThreadsSMRSupport;  // for _nested_threads_hazard_ptr_cnt, _threads_hazard_ptr, _threads_list_ptr access
@@ -417,6 +420,11 @@ class Thread: public ThreadShadow {
   ResourceArea* resource_area() const            { return _resource_area; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
 
+  // Arena chunk cache
+  Chunk** cached_chunks()                        { return _cached_chunks; }
+  bool chunk_cache_enabled() const               { return _chunk_cache_enabled; }
+  void set_chunk_cache_enabled(bool enabled)     { _chunk_cache_enabled = enabled; }
+
   OSThread* osthread() const                     { return _osthread;   }
   void set_osthread(OSThread* thread)            { _osthread = thread; }
 
@@ -546,6 +554,14 @@ protected:
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
 
+  // Free arena chunks cached by this thread, one per chunk pool; managed by
+  // the ChunkPool implementation (see arena.cpp).
+ public:
+  static const int num_cached_chunks = 4;
+ protected:
+  Chunk* _cached_chunks[num_cached_chunks];
+  bool   _chunk_cache_enabled;
+
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
   // Thread local handle area for allocation of handles within the VM
@@ -991,6 +1007,15 @@ class JavaThread: public Thread {
   // Checked JNI: function name requires exception check
   char* _pending_jni_exception_check_fn;
 
+  // Global and weak global JNI handle entries kept for reuse by this thread,
+  // created on first use when JNIGlobalHandleCacheSize or
+  // JNIWeakGlobalHandleCacheSize is > 0
+  JNIGlobalHandleCache* _jni_global_handle_cache;
+  JNIGlobalHandleCache* _jni_weak_global_handle_cache;
+
+  // Objects locked by this thread with lightweight locking
+  LockStack _lock_stack;
+
   // For deadlock detection.
   int _depth_first_number;
 
@@ -1265,6 +1290,12 @@ class JavaThread: public Thread {
   static ByteSize polling_page_offset()          { return byte_offset_of(JavaThread, _poll_data) + byte_offset_of(SafepointMechanism::ThreadData, _polling_page);}
   static ByteSize saved_exception_pc_offset()    { return byte_offset_of(JavaThread, _saved_exception_pc); }
   static ByteSize osthread_offset()              { return byte_offset_of(JavaThread, _osthread); }
+  static ByteSize lock_stack_top_offset() {
+    return byte_offset_of(JavaThread, _lock_stack) + LockStack::top_offset();
+  }
+  static ByteSize lock_stack_base_offset() {
+    return byte_offset_of(JavaThread, _lock_stack) + LockStack::base_offset();
+  }
 #if INCLUDE_JVMCI
   static ByteSize pending_deoptimization_offset() { return byte_offset_of(JavaThread, _pending_deoptimization); }
   static ByteSize pending_monitorenter_offset()  { return byte_offset_of(JavaThread, _pending_monitorenter); }
@@ -1295,6 +1326,12 @@ class JavaThread: public Thread {
   static ByteSize should_post_on_exceptions_flag_offset() {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
+  static ByteSize profile_sample_countdown_offset() {
+    return byte_offset_of(JavaThread, _profile_sample_countdown);
+  }
+  static ByteSize profile_sample_seed_offset() {
+    return byte_offset_of(JavaThread, _profile_sample_seed);
+  }
   static ByteSize doing_unsafe_access_offset() { return byte_offset_of(JavaThread, _doing_unsafe_access); }
   NOT_PRODUCT(static ByteSize requires_cross_modify_fence_offset()  { return byte_offset_of(JavaThread, _requires_cross_modify_fence); })
 
@@ -1333,6 +1370,13 @@ class JavaThread: public Thread {
   const char* get_pending_jni_exception_check() const { return _pending_jni_exception_check_fn; }
   void set_pending_jni_exception_check(const char* fn_name) { _pending_jni_exception_check_fn = (char*) fn_name; }
 
+  JNIGlobalHandleCache* jni_global_handle_cache();
+  JNIGlobalHandleCache* jni_weak_global_handle_cache();
+  // Returns the cached entries to the storages, at a safepoint.
+  void flush_jni_global_handle_caches();
+
+  LockStack& lock_stack() { return _lock_stack; }
+
   // For deadlock detection
   int depth_first_number() { return _depth_first_number; }
   void set_depth_first_number(int dfn) { _depth_first_number = dfn; }
@@ -1534,6 +1578,11 @@ class JavaThread: public Thread {
  private:
   int    _should_post_on_exceptions_flag;
 
+  // countdown to the next sampled profile update in C1 code (C1ProfileSampleInterval),
+  // and the xorshift state the countdown is randomized with
+  int    _profile_sample_countdown;
+  juint  _profile_sample_seed;
+
  public:
   int   should_post_on_exceptions_flag()  { return _should_post_on_exceptions_flag; }
   void  set_should_post_on_exceptions_flag(int val)  { _should_post_on_exceptions_flag = val; }
@@ -1689,6 +1738,10 @@ class Threads: AllStatic {
   // Get owning Java thread from the monitor's owner field.
   static JavaThread *owning_thread_from_monitor_owner(ThreadsList * t_list,
                                                       address owner);
+  // Get owning Java thread of a monitor, including one owned anonymously.
+  static JavaThread* owning_thread_from_monitor(ThreadsList* t_list, ObjectMonitor* monitor);
+  // Get Java thread that has obj on its lock stack.
+  static JavaThread* owning_thread_from_object(ThreadsList* t_list, oop obj);
 
   // Number of threads on the active threads list
   static int number_of_threads()                 { return _number_of_threads; }
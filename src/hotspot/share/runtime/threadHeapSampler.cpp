@@ -31,6 +31,7 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/threadHeapSampler.hpp"
+#include "services/heapSampleProfiler.hpp"
 
 // Cheap random number generator.
 uint64_t ThreadHeapSampler::_rnd;
@@ -425,6 +426,9 @@ void ThreadHeapSampler::check_for_sampling(oop obj, size_t allocation_size, size
   }
 
   JvmtiExport::sampled_object_alloc_event_collector(obj);
+  if (HeapProfileSampling) {
+    HeapSampleProfiler::record(obj, allocation_size);
+  }
 
   size_t overflow_bytes = total_allocated_bytes - _bytes_until_sample;
   pick_next_sample(overflow_bytes);
@@ -217,38 +217,26 @@ class ThreadScanHashtable : public CHeapObj<mtThread> {
   }
 };
 
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 2
-// of the dance - adding all the JavaThreads referenced by the hazard
-// pointer (ThreadsList reference) to the hash table.
+// Closure to determine if a specific JavaThread is indirectly referenced
+// by a hazard ptr (ThreadsList reference).
 //
-class AddThreadHazardPointerThreadClosure : public ThreadClosure {
+// Many JavaThreads usually have the same ThreadsList as their hazard ptr
+// (typically the current _java_thread_list), so each distinct ThreadsList
+// is only searched once. The distinct ThreadsLists are tracked in a hash
+// table. Gathering every JavaThread of every hazard ptr would be
+// O(hazard ptrs * threads) hash table operations instead.
+//
+class ScanHazardPtrFindProtectedThreadClosure : public ThreadClosure {
  private:
-  ThreadScanHashtable *_table;
+  JavaThread* const _target;
+  ThreadScanHashtable* _lists;
+  bool _found;
 
  public:
-  AddThreadHazardPointerThreadClosure(ThreadScanHashtable *table) : _table(table) {}
-
-  virtual void do_thread(Thread *thread) {
-    if (!_table->has_entry((void*)thread)) {
-      // The same JavaThread might be on more than one ThreadsList or
-      // more than one thread might be using the same ThreadsList. In
-      // either case, we only need a single entry for a JavaThread.
-      _table->add_entry((void*)thread);
-    }
-  }
-};
+  ScanHazardPtrFindProtectedThreadClosure(JavaThread* target, ThreadScanHashtable* lists) :
+    _target(target), _lists(lists), _found(false) {}
 
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 1
-// of the dance - hazard ptr chain walking and dispatch to another
-// closure.
-//
-class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
- private:
-  ThreadScanHashtable *_table;
- public:
-  ScanHazardPtrGatherProtectedThreadsClosure(ThreadScanHashtable *table) : _table(table) {}
+  bool found() const { return _found; }
 
   virtual void do_thread(Thread *thread) {
     assert_locked_or_safepoint(Threads_lock);
@@ -283,13 +271,22 @@ class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
     assert(ThreadsList::is_valid(current_list), "current_list="
            INTPTR_FORMAT " is not valid!", p2i(current_list));
 
+    // Invalidating unverified hazard ptrs above has to happen for every
+    // JavaThread, so keep going after a match has been found; only the
+    // search of the ThreadsList can be skipped.
+    if (_found || _lists->has_entry((void*)current_list)) {
+      return;
+    }
+    _lists->add_entry((void*)current_list);
+
     // The current JavaThread has a hazard ptr (ThreadsList reference)
     // which might be _java_thread_list or it might be an older
     // ThreadsList that has been removed but not freed. In either case,
     // the hazard ptr is protecting all the JavaThreads on that
     // ThreadsList.
-    AddThreadHazardPointerThreadClosure add_cl(_table);
-    current_list->threads_do(&add_cl);
+    if (current_list->includes(_target)) {
+      _found = true;
+    }
   }
 };
 
@@ -925,10 +922,10 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
 bool ThreadsSMRSupport::is_a_protected_JavaThread(JavaThread *thread) {
   assert_locked_or_safepoint(Threads_lock);
 
-  // Gather a hash table of the JavaThreads indirectly referenced by
-  // hazard ptrs.
+  // Search the distinct ThreadsLists referenced by hazard ptrs for
+  // the JavaThread.
   ThreadScanHashtable *scan_table = new ThreadScanHashtable();
-  ScanHazardPtrGatherProtectedThreadsClosure scan_cl(scan_table);
+  ScanHazardPtrFindProtectedThreadClosure scan_cl(thread, scan_table);
   threads_do(&scan_cl);
   OrderAccess::acquire(); // Must order reads of hazard ptr before reads of
                           // nested reference counters
@@ -936,21 +933,17 @@ bool ThreadsSMRSupport::is_a_protected_JavaThread(JavaThread *thread) {
   // Walk through the linked list of pending freeable ThreadsLists
   // and include the ones that are currently in use by a nested
   // ThreadsListHandle in the search set.
+  bool thread_is_protected = scan_cl.found();
   ThreadsList* current = _to_delete_list;
-  while (current != NULL) {
-    if (current->_nested_handle_cnt != 0) {
+  while (!thread_is_protected && current != NULL) {
+    if (current->_nested_handle_cnt != 0 && !scan_table->has_entry((void*)current)) {
       // 'current' is in use by a nested ThreadsListHandle so the hazard
       // ptr is protecting all the JavaThreads on that ThreadsList.
-      AddThreadHazardPointerThreadClosure add_cl(scan_table);
-      current->threads_do(&add_cl);
+      thread_is_protected = current->includes(thread);
     }
     current = current->next_list();
   }
 
-  bool thread_is_protected = false;
-  if (scan_table->has_entry((void*)thread)) {
-    thread_is_protected = true;
-  }
   delete scan_table;
   return thread_is_protected;
 }
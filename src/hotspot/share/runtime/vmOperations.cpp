@@ -489,7 +489,7 @@ void VM_Exit::wait_if_vm_exited() {
 }
 
 void VM_PrintCompileQueue::doit() {
-  CompileBroker::print_compile_queues(_out);
+  CompileBroker::print_compile_queues(_out, _print_stats);
 }
 
 #if INCLUDE_SERVICES
@@ -255,9 +255,11 @@ class VM_Exit: public VM_Operation {
 class VM_PrintCompileQueue: public VM_Operation {
  private:
   outputStream* _out;
+  bool _print_stats;
 
  public:
-  VM_PrintCompileQueue(outputStream* st) : _out(st) {}
+  VM_PrintCompileQueue(outputStream* st, bool print_stats = false) :
+    _out(st), _print_stats(print_stats) {}
   VMOp_Type type() const { return VMOp_PrintCompileQueue; }
   void doit();
 };
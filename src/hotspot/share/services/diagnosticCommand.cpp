@@ -30,6 +30,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmClasses.hpp"
 #include "code/codeCache.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
 #include "gc/shared/gcVMOperations.hpp"
@@ -52,7 +53,9 @@
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
 #include "services/heapDumper.hpp"
+#include "services/heapSampleProfiler.hpp"
 #include "services/management.hpp"
+#include "services/threadService.hpp"
 #include "services/writeableFlags.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/events.hpp"
@@ -97,6 +100,7 @@ void DCmdRegistrant::register_dcmds(){
 #if INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassHistogramDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapProfileDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SystemDictionaryDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassHierarchyDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SymboltableDCmd>(full_export, true, false));
@@ -116,6 +120,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilationProfileDumpDCmd>(full_export, true, false));
 #ifdef LINUX
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<PerfMapDCmd>(full_export, true, false));
 #endif // LINUX
@@ -463,20 +468,38 @@ void FinalizerInfoDCmd::execute(DCmdSource source, TRAPS) {
 #if INCLUDE_SERVICES // Heap dumping/inspection supported
 HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
-  _filename("filename","Name of the dump file", "STRING",true),
+  _filename("filename","Name of the dump file. A named pipe, unix:<socket path> "
+            "or fd:<file descriptor> of the target VM streams the dump instead", "STRING",true),
   _all("-all", "Dump all objects, including unreachable objects",
        "BOOLEAN", false, "false"),
   _gzip("-gz", "If specified, the heap dump is written in gzipped format "
                "using the given compression level. 1 (recommended) is the fastest, "
-               "9 the strongest compression.", "INT", false, "1") {
+               "9 the strongest compression.", "INT", false, "1"),
+  _zstd("-zstd", "If specified, the heap dump is written in zstd format "
+                 "using the given compression level. 1 (recommended) is the fastest, "
+                 "19 the strongest compression. Requires the zstd library "
+                 "of the system.", "INT", false, "1"),
+  _parallel("-parallel", "Number of parallel threads to use for heap dump. "
+            "0 means let the VM determine the number of threads to use. "
+            "1 (the default) means use one thread (disable parallelism). "
+            "For any other value the VM will try to use the specified number of "
+            "threads, but might use fewer.",
+            "INT", false, "1") {
   _dcmdparser.add_dcmd_option(&_all);
   _dcmdparser.add_dcmd_argument(&_filename);
   _dcmdparser.add_dcmd_option(&_gzip);
+  _dcmdparser.add_dcmd_option(&_zstd);
+  _dcmdparser.add_dcmd_option(&_parallel);
 }
 
 void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
   jlong level = -1; // -1 means no compression.
 
+  if (_gzip.is_set() && _zstd.is_set()) {
+    output()->print_cr("Only one of -gz and -zstd can be specified");
+    return;
+  }
+
   if (_gzip.is_set()) {
     level = _gzip.value();
 
@@ -486,11 +509,27 @@ void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
     }
   }
 
+  if (_zstd.is_set()) {
+    level = _zstd.value();
+
+    if (level < 1 || level > 19) {
+      output()->print_cr("Compression level out of range (1-19): " JLONG_FORMAT, level);
+      return;
+    }
+  }
+
+  jlong num = _parallel.value();
+  if (num < 0) {
+    output()->print_cr("Parallel thread number out of range (>=0): " JLONG_FORMAT, num);
+    return;
+  }
+  uint num_dump_threads = num == 0 ? HeapDumper::default_num_of_dump_threads() : (uint) num;
+
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  dumper.dump(_filename.value(), output(), (int) level);
+  dumper.dump(_filename.value(), output(), (int) level, num_dump_threads, _zstd.is_set());
 }
 
 ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
@@ -503,9 +542,43 @@ ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
        "1 means use one thread (disable parallelism). "
        "For any other value the VM will try to use the specified number of "
        "threads, but might use fewer.",
-       "INT", false, "0") {
+       "INT", false, "0"),
+  _baseline("-baseline", "Record the histogram as the baseline for a later -diff "
+       "instead of printing it",
+       "BOOLEAN", false, "false"),
+  _diff("-diff", "Print only the classes whose instance count or size changed "
+       "since the baseline, then make the current histogram the new baseline",
+       "BOOLEAN", false, "false") {
   _dcmdparser.add_dcmd_option(&_all);
   _dcmdparser.add_dcmd_option(&_parallel_thread_num);
+  _dcmdparser.add_dcmd_option(&_baseline);
+  _dcmdparser.add_dcmd_option(&_diff);
+}
+
+HeapProfileDCmd::HeapProfileDCmd(outputStream* output, bool heap) :
+                                 DCmdWithParser(output, heap),
+  _max_classes("-max", "Maximum number of classes to print",
+       "INT", false, "50"),
+  _live("-live", "Only print classes with sampled objects that are still live, "
+       "largest estimated live size first",
+       "BOOLEAN", false, "false"),
+  _reset("-reset", "Discard the recorded samples after printing",
+       "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_max_classes);
+  _dcmdparser.add_dcmd_option(&_live);
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void HeapProfileDCmd::execute(DCmdSource source, TRAPS) {
+  jlong max = _max_classes.value();
+  if (max < 0) {
+    output()->print_cr("Maximum number of classes out of range (>=0): " JLONG_FORMAT, max);
+    return;
+  }
+  HeapSampleProfiler::print_profile(output(), (size_t)max, _live.value());
+  if (_reset.value()) {
+    HeapSampleProfiler::reset();
+  }
 }
 
 void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
@@ -517,9 +590,17 @@ void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
   uint parallel_thread_num = num == 0
       ? MAX2<uint>(1, (uint)os::initial_active_processor_count() * 3 / 8)
       : num;
+  if (_baseline.value() && _diff.value()) {
+    output()->print_cr("Only one of -baseline and -diff can be specified");
+    return;
+  }
+  HeapInspection::Mode mode = _baseline.value() ? HeapInspection::RecordBaseline
+                            : _diff.value()     ? HeapInspection::PrintDiff
+                                                : HeapInspection::PrintHistogram;
   VM_GC_HeapInspection heapop(output(),
                               !_all.value(), /* request full gc if false */
-                              parallel_thread_num);
+                              parallel_thread_num,
+                              mode);
   VMThread::execute(&heapop);
 }
 
@@ -528,12 +609,22 @@ void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
 ThreadDumpDCmd::ThreadDumpDCmd(outputStream* output, bool heap) :
                                DCmdWithParser(output, heap),
   _locks("-l", "print java.util.concurrent locks", "BOOLEAN", false, "false"),
-  _extended("-e", "print extended thread information", "BOOLEAN", false, "false") {
+  _extended("-e", "print extended thread information", "BOOLEAN", false, "false"),
+  _handshake("-handshake", "capture each thread in its own handshake instead of "
+             "at a safepoint; threads are not consistent with each other and "
+             "concurrent locks, JNI handles and deadlocks are not reported",
+             "BOOLEAN", false, "false") {
   _dcmdparser.add_dcmd_option(&_locks);
   _dcmdparser.add_dcmd_option(&_extended);
+  _dcmdparser.add_dcmd_option(&_handshake);
 }
 
 void ThreadDumpDCmd::execute(DCmdSource source, TRAPS) {
+  if (_handshake.value()) {
+    ThreadService::print_threads_with_handshakes(output(), _extended.value());
+    return;
+  }
+
   // thread stacks and JNI global handles
   VM_PrintThreads op1(output(), _locks.value(), _extended.value(), true /* print JNI handle info */);
   VMThread::execute(&op1);
@@ -807,8 +898,15 @@ void VMDynamicLibrariesDCmd::execute(DCmdSource source, TRAPS) {
   output()->cr();
 }
 
+CompileQueueDCmd::CompileQueueDCmd(outputStream* output, bool heap) :
+                                   DCmdWithParser(output, heap),
+  _stats("-stats", "Print the size and selection statistics of each queue.",
+         "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_stats);
+}
+
 void CompileQueueDCmd::execute(DCmdSource source, TRAPS) {
-  VM_PrintCompileQueue printCompileQueueOp(output());
+  VM_PrintCompileQueue printCompileQueueOp(output(), _stats.value());
   VMThread::execute(&printCompileQueueOp);
 }
 
@@ -826,6 +924,21 @@ void PerfMapDCmd::execute(DCmdSource source, TRAPS) {
 }
 #endif // LINUX
 
+CompilationProfileDumpDCmd::CompilationProfileDumpDCmd(outputStream* output, bool heap) :
+                                                       DCmdWithParser(output, heap),
+  _filename("filename", "Name of the compilation profile file", "STRING", true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void CompilationProfileDumpDCmd::execute(DCmdSource source, TRAPS) {
+  int count = CompilationProfile::dump(_filename.value());
+  if (count < 0) {
+    output()->print_cr("Could not create %s", _filename.value());
+  } else {
+    output()->print_cr("Wrote %d methods to %s", count, _filename.value());
+  }
+}
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 CodeHeapAnalyticsDCmd::CodeHeapAnalyticsDCmd(outputStream* output, bool heap) :
                                              DCmdWithParser(output, heap),
@@ -314,6 +314,8 @@ protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
   DCmdArgument<jlong> _gzip;
+  DCmdArgument<jlong> _zstd;
+  DCmdArgument<jlong> _parallel;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -340,6 +342,8 @@ class ClassHistogramDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
   DCmdArgument<jlong> _parallel_thread_num;
+  DCmdArgument<bool> _baseline;
+  DCmdArgument<bool> _diff;
 public:
   ClassHistogramDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -359,6 +363,31 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class HeapProfileDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _max_classes;
+  DCmdArgument<bool> _live;
+  DCmdArgument<bool> _reset;
+public:
+  HeapProfileDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.heap_profile";
+  }
+  static const char* description() {
+    return "Print a per-class profile of the allocations sampled when "
+           "HeapProfileSampling is enabled, with the part still live.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class ClassHierarchyDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _print_interfaces; // true if inherited interfaces should be printed.
@@ -431,6 +460,7 @@ class ThreadDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _locks;
   DCmdArgument<bool> _extended;
+  DCmdArgument<bool> _handshake;
 public:
   ThreadDumpDCmd(outputStream* output, bool heap);
   static const char* name() { return "Thread.print"; }
@@ -558,9 +588,11 @@ public:
 
 };
 
-class CompileQueueDCmd : public DCmd {
+class CompileQueueDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _stats; // true if the queue statistics should be printed.
 public:
-  CompileQueueDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  CompileQueueDCmd(outputStream* output, bool heap);
   static const char* name() {
     return "Compiler.queue";
   }
@@ -640,6 +672,29 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class CompilationProfileDumpDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  CompilationProfileDumpDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.profile_dump";
+  }
+  static const char* description() {
+    return "Write the counters of C2 compiled methods to a compilation profile "
+           "for use with -XX:CompilationProfileFile.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of loaded classes.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 class CodeHeapAnalyticsDCmd : public DCmdWithParser {
 protected:
@@ -30,10 +30,12 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/vmClasses.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/gcVMOperations.hpp"
 #include "gc/shared/workgroup.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -380,10 +382,10 @@ enum {
   INITIAL_CLASS_COUNT = 200
 };
 
-// Supports I/O operations for a dump
-
-class DumpWriter : public StackObj {
- private:
+// Base class of the dump writers. Encodes the HPROF records into a buffer
+// and leaves it to the subclasses where the buffered bytes go.
+class AbstractDumpWriter : public StackObj {
+ protected:
   enum {
     io_buffer_max_size = 1*M,
     io_buffer_max_waste = 10*K,
@@ -399,9 +401,9 @@ class DumpWriter : public StackObj {
   DEBUG_ONLY(size_t _sub_record_left;) // The bytes not written for the current sub-record.
   DEBUG_ONLY(bool _sub_record_ended;) // True if we have called the end_sub_record().
 
-  CompressionBackend _backend; // Does the actual writing.
-
-  void flush();
+  // Hands the buffered bytes to the underlying sink and sets up an empty buffer.
+  // 'force' is true when the current dump segment is complete.
+  virtual void flush(bool force = false) = 0;
 
   char* buffer() const                          { return _buffer; }
   size_t buffer_size() const                    { return _size; }
@@ -415,15 +417,15 @@ class DumpWriter : public StackObj {
   bool can_write_fast(size_t len);
 
  public:
-  // Takes ownership of the writer and compressor.
-  DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor);
-
-  ~DumpWriter();
+  AbstractDumpWriter() :
+    _buffer(NULL),
+    _size(0),
+    _pos(0),
+    _in_dump_segment(false) { }
 
   // total number of bytes written to the disk
-  julong bytes_written() const          { return (julong) _backend.get_written(); }
-
-  char const* error() const             { return _backend.error(); }
+  virtual julong bytes_written() const = 0;
+  virtual char const* error() const = 0;
 
   // writer functions
   void write_raw(void* s, size_t len);
@@ -442,28 +444,9 @@ class DumpWriter : public StackObj {
   void end_sub_record();
   // Finishes the current dump segment if not already finished.
   void finish_dump_segment();
-
-  // Called by threads used for parallel writing.
-  void writer_loop()                    { _backend.thread_loop(); }
-  // Called when finished to release the threads.
-  void deactivate()                     { flush(); _backend.deactivate(); }
 };
 
-// Check for error after constructing the object and destroy it in case of an error.
-DumpWriter::DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor) :
-  _buffer(NULL),
-  _size(0),
-  _pos(0),
-  _in_dump_segment(false),
-  _backend(writer, compressor, io_buffer_max_size, io_buffer_max_waste) {
-  flush();
-}
-
-DumpWriter::~DumpWriter() {
-  flush();
-}
-
-void DumpWriter::write_fast(void* s, size_t len) {
+void AbstractDumpWriter::write_fast(void* s, size_t len) {
   assert(!_in_dump_segment || (_sub_record_left >= len), "sub-record too large");
   assert(buffer_size() - position() >= len, "Must fit");
   debug_only(_sub_record_left -= len);
@@ -472,12 +455,12 @@ void DumpWriter::write_fast(void* s, size_t len) {
   set_position(position() + len);
 }
 
-bool DumpWriter::can_write_fast(size_t len) {
+bool AbstractDumpWriter::can_write_fast(size_t len) {
   return buffer_size() - position() >= len;
 }
 
 // write raw bytes
-void DumpWriter::write_raw(void* s, size_t len) {
+void AbstractDumpWriter::write_raw(void* s, size_t len) {
   assert(!_in_dump_segment || (_sub_record_left >= len), "sub-record too large");
   debug_only(_sub_record_left -= len);
 
@@ -498,38 +481,33 @@ void DumpWriter::write_raw(void* s, size_t len) {
   set_position(position() + len);
 }
 
-// flush any buffered bytes to the file
-void DumpWriter::flush() {
-  _backend.get_new_buffer(&_buffer, &_pos, &_size);
-}
-
 // Makes sure we inline the fast write into the write_u* functions. This is a big speedup.
 #define WRITE_KNOWN_TYPE(p, len) do { if (can_write_fast((len))) write_fast((p), (len)); \
                                       else write_raw((p), (len)); } while (0)
 
-void DumpWriter::write_u1(u1 x) {
+void AbstractDumpWriter::write_u1(u1 x) {
   WRITE_KNOWN_TYPE((void*) &x, 1);
 }
 
-void DumpWriter::write_u2(u2 x) {
+void AbstractDumpWriter::write_u2(u2 x) {
   u2 v;
   Bytes::put_Java_u2((address)&v, x);
   WRITE_KNOWN_TYPE((void*)&v, 2);
 }
 
-void DumpWriter::write_u4(u4 x) {
+void AbstractDumpWriter::write_u4(u4 x) {
   u4 v;
   Bytes::put_Java_u4((address)&v, x);
   WRITE_KNOWN_TYPE((void*)&v, 4);
 }
 
-void DumpWriter::write_u8(u8 x) {
+void AbstractDumpWriter::write_u8(u8 x) {
   u8 v;
   Bytes::put_Java_u8((address)&v, x);
   WRITE_KNOWN_TYPE((void*)&v, 8);
 }
 
-void DumpWriter::write_objectID(oop o) {
+void AbstractDumpWriter::write_objectID(oop o) {
   address a = cast_from_oop<address>(o);
 #ifdef _LP64
   write_u8((u8)a);
@@ -538,7 +516,7 @@ void DumpWriter::write_objectID(oop o) {
 #endif
 }
 
-void DumpWriter::write_symbolID(Symbol* s) {
+void AbstractDumpWriter::write_symbolID(Symbol* s) {
   address a = (address)((uintptr_t)s);
 #ifdef _LP64
   write_u8((u8)a);
@@ -547,7 +525,7 @@ void DumpWriter::write_symbolID(Symbol* s) {
 #endif
 }
 
-void DumpWriter::write_id(u4 x) {
+void AbstractDumpWriter::write_id(u4 x) {
 #ifdef _LP64
   write_u8((u8) x);
 #else
@@ -556,11 +534,11 @@ void DumpWriter::write_id(u4 x) {
 }
 
 // We use java mirror as the class ID
-void DumpWriter::write_classID(Klass* k) {
+void AbstractDumpWriter::write_classID(Klass* k) {
   write_objectID(k->java_mirror());
 }
 
-void DumpWriter::finish_dump_segment() {
+void AbstractDumpWriter::finish_dump_segment() {
   if (_in_dump_segment) {
     assert(_sub_record_left == 0, "Last sub-record not written completely");
     assert(_sub_record_ended, "sub-record must have ended");
@@ -573,12 +551,12 @@ void DumpWriter::finish_dump_segment() {
                          (u4) (position() - dump_segment_header_size));
     }
 
-    flush();
+    flush(true /* the segment is complete */);
     _in_dump_segment = false;
   }
 }
 
-void DumpWriter::start_sub_record(u1 tag, u4 len) {
+void AbstractDumpWriter::start_sub_record(u1 tag, u4 len) {
   if (!_in_dump_segment) {
     if (position() > 0) {
       flush();
@@ -608,20 +586,121 @@ void DumpWriter::start_sub_record(u1 tag, u4 len) {
   write_u1(tag);
 }
 
-void DumpWriter::end_sub_record() {
+void AbstractDumpWriter::end_sub_record() {
   assert(_in_dump_segment, "must be in dump segment");
   assert(_sub_record_left == 0, "sub-record not written completely");
   assert(!_sub_record_ended, "Must not have ended yet");
   debug_only(_sub_record_ended = true);
 }
 
+// Supports I/O operations for a dump
+
+class DumpWriter : public AbstractDumpWriter {
+ private:
+  CompressionBackend _backend; // Does the actual writing.
+
+ protected:
+  virtual void flush(bool force = false);
+
+ public:
+  // Takes ownership of the writer and compressor.
+  DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor);
+
+  ~DumpWriter();
+
+  // total number of bytes written to the disk
+  virtual julong bytes_written() const  { return (julong) _backend.get_written(); }
+
+  virtual char const* error() const     { return _backend.error(); }
+
+  // Called by threads used for parallel writing.
+  void writer_loop()                    { _backend.thread_loop(); }
+  // Called when finished to release the threads.
+  void deactivate()                     { flush(); _backend.deactivate(); }
+};
+
+// Check for error after constructing the object and destroy it in case of an error.
+DumpWriter::DumpWriter(AbstractWriter* writer, AbstractCompressor* compressor) :
+  AbstractDumpWriter(),
+  _backend(writer, compressor, io_buffer_max_size, io_buffer_max_waste) {
+  flush();
+}
+
+DumpWriter::~DumpWriter() {
+  flush();
+}
+
+// flush any buffered bytes to the file
+void DumpWriter::flush(bool force) {
+  _backend.get_new_buffer(&_buffer, &_pos, &_size);
+}
+
+// A dump writer used by the heap dumper threads of a parallel heap dump.
+// Every thread fills its own buffer with complete HPROF_HEAP_DUMP_SEGMENT
+// records and hands them over to the shared DumpWriter, so the segments of
+// different threads never interleave in the resulting file.
+class ParDumpWriter : public AbstractDumpWriter {
+ private:
+  DumpWriter* const _global_writer;
+  Mutex* const      _global_lock;
+  bool              _holds_global_lock;
+
+ protected:
+  virtual void flush(bool force = false);
+
+ public:
+  // The buffer must be io_buffer_size bytes long and is owned by the caller.
+  ParDumpWriter(DumpWriter* global_writer, Mutex* global_lock, char* buffer);
+
+  ~ParDumpWriter();
+
+  virtual julong bytes_written() const  { return _global_writer->bytes_written(); }
+
+  virtual char const* error() const     { return _global_writer->error(); }
+
+  static size_t io_buffer_size()        { return io_buffer_max_size; }
+};
+
+ParDumpWriter::ParDumpWriter(DumpWriter* global_writer, Mutex* global_lock, char* buffer) :
+  AbstractDumpWriter(),
+  _global_writer(global_writer),
+  _global_lock(global_lock),
+  _holds_global_lock(false) {
+  assert(buffer != NULL, "Must have a buffer");
+  _buffer = buffer;
+  _size = io_buffer_max_size;
+}
+
+ParDumpWriter::~ParDumpWriter() {
+  assert(!_in_dump_segment, "Must have finished the last dump segment");
+  flush(true);
+}
+
+void ParDumpWriter::flush(bool force) {
+  if (position() > 0) {
+    if (!_holds_global_lock) {
+      _global_lock->lock_without_safepoint_check();
+      _holds_global_lock = true;
+    }
+    _global_writer->write_raw(buffer(), position());
+    set_position(0);
+  }
+
+  // A huge sub-record spans several buffers. Keep the global writer locked
+  // until its segment is complete, so no other segment gets mixed into it.
+  if (_holds_global_lock && (force || !_in_dump_segment || !_is_huge_sub_record)) {
+    _holds_global_lock = false;
+    _global_lock->unlock();
+  }
+}
+
 // Support class with a collection of functions used when dumping the heap
 
 class DumperSupport : AllStatic {
  public:
 
   // write a header of the given type
-  static void write_header(DumpWriter* writer, hprofTag tag, u4 len);
+  static void write_header(AbstractDumpWriter* writer, hprofTag tag, u4 len);
 
   // returns hprof tag for the given type signature
   static hprofTag sig2tag(Symbol* sig);
@@ -634,42 +713,42 @@ class DumperSupport : AllStatic {
   static u4 instance_size(Klass* k);
 
   // dump a jfloat
-  static void dump_float(DumpWriter* writer, jfloat f);
+  static void dump_float(AbstractDumpWriter* writer, jfloat f);
   // dump a jdouble
-  static void dump_double(DumpWriter* writer, jdouble d);
+  static void dump_double(AbstractDumpWriter* writer, jdouble d);
   // dumps the raw value of the given field
-  static void dump_field_value(DumpWriter* writer, char type, oop obj, int offset);
+  static void dump_field_value(AbstractDumpWriter* writer, char type, oop obj, int offset);
   // returns the size of the static fields; also counts the static fields
   static u4 get_static_fields_size(InstanceKlass* ik, u2& field_count);
   // dumps static fields of the given class
-  static void dump_static_fields(DumpWriter* writer, Klass* k);
+  static void dump_static_fields(AbstractDumpWriter* writer, Klass* k);
   // dump the raw values of the instance fields of the given object
-  static void dump_instance_fields(DumpWriter* writer, oop o);
+  static void dump_instance_fields(AbstractDumpWriter* writer, oop o);
   // get the count of the instance fields for a given class
   static u2 get_instance_fields_count(InstanceKlass* ik);
   // dumps the definition of the instance fields for a given class
-  static void dump_instance_field_descriptors(DumpWriter* writer, Klass* k);
+  static void dump_instance_field_descriptors(AbstractDumpWriter* writer, Klass* k);
   // creates HPROF_GC_INSTANCE_DUMP record for the given object
-  static void dump_instance(DumpWriter* writer, oop o);
+  static void dump_instance(AbstractDumpWriter* writer, oop o);
   // creates HPROF_GC_CLASS_DUMP record for the given class and each of its
   // array classes
-  static void dump_class_and_array_classes(DumpWriter* writer, Klass* k);
+  static void dump_class_and_array_classes(AbstractDumpWriter* writer, Klass* k);
   // creates HPROF_GC_CLASS_DUMP record for a given primitive array
   // class (and each multi-dimensional array class too)
-  static void dump_basic_type_array_class(DumpWriter* writer, Klass* k);
+  static void dump_basic_type_array_class(AbstractDumpWriter* writer, Klass* k);
 
   // creates HPROF_GC_OBJ_ARRAY_DUMP record for the given object array
-  static void dump_object_array(DumpWriter* writer, objArrayOop array);
+  static void dump_object_array(AbstractDumpWriter* writer, objArrayOop array);
   // creates HPROF_GC_PRIM_ARRAY_DUMP record for the given type array
-  static void dump_prim_array(DumpWriter* writer, typeArrayOop array);
+  static void dump_prim_array(AbstractDumpWriter* writer, typeArrayOop array);
   // create HPROF_FRAME record for the given method and bci
-  static void dump_stack_frame(DumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
+  static void dump_stack_frame(AbstractDumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
 
   // check if we need to truncate an array
-  static int calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size);
+  static int calculate_array_max_length(AbstractDumpWriter* writer, arrayOop array, short header_size);
 
   // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
-  static void end_of_dump(DumpWriter* writer);
+  static void end_of_dump(AbstractDumpWriter* writer);
 
   static oop mask_dormant_archived_object(oop o) {
     if (o != NULL && o->klass()->java_mirror() == NULL) {
@@ -683,7 +762,7 @@ class DumperSupport : AllStatic {
 };
 
 // write a header of the given type
-void DumperSupport:: write_header(DumpWriter* writer, hprofTag tag, u4 len) {
+void DumperSupport:: write_header(AbstractDumpWriter* writer, hprofTag tag, u4 len) {
   writer->write_u1((u1)tag);
   writer->write_u4(0);                  // current ticks
   writer->write_u4(len);
@@ -737,7 +816,7 @@ u4 DumperSupport::sig2size(Symbol* sig) {
 }
 
 // dump a jfloat
-void DumperSupport::dump_float(DumpWriter* writer, jfloat f) {
+void DumperSupport::dump_float(AbstractDumpWriter* writer, jfloat f) {
   if (g_isnan(f)) {
     writer->write_u4(0x7fc00000);    // collapsing NaNs
   } else {
@@ -751,7 +830,7 @@ void DumperSupport::dump_float(DumpWriter* writer, jfloat f) {
 }
 
 // dump a jdouble
-void DumperSupport::dump_double(DumpWriter* writer, jdouble d) {
+void DumperSupport::dump_double(AbstractDumpWriter* writer, jdouble d) {
   union {
     jlong l;
     double d;
@@ -766,7 +845,7 @@ void DumperSupport::dump_double(DumpWriter* writer, jdouble d) {
 }
 
 // dumps the raw value of the given field
-void DumperSupport::dump_field_value(DumpWriter* writer, char type, oop obj, int offset) {
+void DumperSupport::dump_field_value(AbstractDumpWriter* writer, char type, oop obj, int offset) {
   switch (type) {
     case JVM_SIGNATURE_CLASS :
     case JVM_SIGNATURE_ARRAY : {
@@ -884,7 +963,7 @@ u4 DumperSupport::get_static_fields_size(InstanceKlass* ik, u2& field_count) {
 }
 
 // dumps static fields of the given class
-void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_static_fields(AbstractDumpWriter* writer, Klass* k) {
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // dump the field descriptors and raw values
@@ -927,7 +1006,7 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
 }
 
 // dump the raw values of the instance fields of the given object
-void DumperSupport::dump_instance_fields(DumpWriter* writer, oop o) {
+void DumperSupport::dump_instance_fields(AbstractDumpWriter* writer, oop o) {
   InstanceKlass* ik = InstanceKlass::cast(o->klass());
 
   for (FieldStream fld(ik, false, false); !fld.eos(); fld.next()) {
@@ -950,7 +1029,7 @@ u2 DumperSupport::get_instance_fields_count(InstanceKlass* ik) {
 }
 
 // dumps the definition of the instance fields for a given class
-void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_instance_field_descriptors(AbstractDumpWriter* writer, Klass* k) {
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // dump the field descriptors
@@ -965,7 +1044,7 @@ void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k
 }
 
 // creates HPROF_GC_INSTANCE_DUMP record for the given object
-void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
+void DumperSupport::dump_instance(AbstractDumpWriter* writer, oop o) {
   InstanceKlass* ik = InstanceKlass::cast(o->klass());
   u4 is = instance_size(ik);
   u4 size = 1 + sizeof(address) + 4 + sizeof(address) + 4 + is;
@@ -988,7 +1067,7 @@ void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
 
 // creates HPROF_GC_CLASS_DUMP record for the given class and each of
 // its array classes
-void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_class_and_array_classes(AbstractDumpWriter* writer, Klass* k) {
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // We can safepoint and do a heap dump at a point where we have a Klass,
@@ -1077,7 +1156,7 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
 
 // creates HPROF_GC_CLASS_DUMP record for a given primitive array
 // class (and each multi-dimensional array class too)
-void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
+void DumperSupport::dump_basic_type_array_class(AbstractDumpWriter* writer, Klass* k) {
  // array classes
  while (k != NULL) {
     Klass* klass = k;
@@ -1112,7 +1191,7 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
 
 // Hprof uses an u4 as record length field,
 // which means we need to truncate arrays that are too long.
-int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size) {
+int DumperSupport::calculate_array_max_length(AbstractDumpWriter* writer, arrayOop array, short header_size) {
   BasicType type = ArrayKlass::cast(array->klass())->element_type();
   assert(type >= T_BOOLEAN && type <= T_OBJECT, "invalid array element type");
 
@@ -1139,7 +1218,7 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
 }
 
 // creates HPROF_GC_OBJ_ARRAY_DUMP record for the given object array
-void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
+void DumperSupport::dump_object_array(AbstractDumpWriter* writer, objArrayOop array) {
   // sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID) + sizeof(classID)
   short header_size = 1 + 2 * 4 + 2 * sizeof(address);
   int length = calculate_array_max_length(writer, array, header_size);
@@ -1173,7 +1252,7 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
   for (int i = 0; i < Length; i++) { writer->write_##Size((Size)Array->Type##_at(i)); }
 
 // creates HPROF_GC_PRIM_ARRAY_DUMP record for the given type array
-void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
+void DumperSupport::dump_prim_array(AbstractDumpWriter* writer, typeArrayOop array) {
   BasicType type = TypeArrayKlass::cast(array->klass())->element_type();
 
   // 2 * sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID)
@@ -1267,7 +1346,7 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
 }
 
 // create a HPROF_FRAME record of the given Method* and bci
-void DumperSupport::dump_stack_frame(DumpWriter* writer,
+void DumperSupport::dump_stack_frame(AbstractDumpWriter* writer,
                                      int frame_serial_num,
                                      int class_serial_num,
                                      Method* m,
@@ -1296,10 +1375,10 @@ void DumperSupport::dump_stack_frame(DumpWriter* writer,
 
 class SymbolTableDumper : public SymbolClosure {
  private:
-  DumpWriter* _writer;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* _writer;
+  AbstractDumpWriter* writer() const                { return _writer; }
  public:
-  SymbolTableDumper(DumpWriter* writer)     { _writer = writer; }
+  SymbolTableDumper(AbstractDumpWriter* writer)     { _writer = writer; }
   void do_symbol(Symbol** p);
 };
 
@@ -1319,12 +1398,12 @@ void SymbolTableDumper::do_symbol(Symbol** p) {
 
 class JNILocalsDumper : public OopClosure {
  private:
-  DumpWriter* _writer;
+  AbstractDumpWriter* _writer;
   u4 _thread_serial_num;
   int _frame_num;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* writer() const                { return _writer; }
  public:
-  JNILocalsDumper(DumpWriter* writer, u4 thread_serial_num) {
+  JNILocalsDumper(AbstractDumpWriter* writer, u4 thread_serial_num) {
     _writer = writer;
     _thread_serial_num = thread_serial_num;
     _frame_num = -1;  // default - empty stack
@@ -1353,11 +1432,11 @@ void JNILocalsDumper::do_oop(oop* obj_p) {
 
 class JNIGlobalsDumper : public OopClosure {
  private:
-  DumpWriter* _writer;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* _writer;
+  AbstractDumpWriter* writer() const                { return _writer; }
 
  public:
-  JNIGlobalsDumper(DumpWriter* writer) {
+  JNIGlobalsDumper(AbstractDumpWriter* writer) {
     _writer = writer;
   }
   void do_oop(oop* obj_p);
@@ -1384,10 +1463,10 @@ void JNIGlobalsDumper::do_oop(oop* obj_p) {
 
 class StickyClassDumper : public KlassClosure {
  private:
-  DumpWriter* _writer;
-  DumpWriter* writer() const                { return _writer; }
+  AbstractDumpWriter* _writer;
+  AbstractDumpWriter* writer() const                { return _writer; }
  public:
-  StickyClassDumper(DumpWriter* writer) {
+  StickyClassDumper(AbstractDumpWriter* writer) {
     _writer = writer;
   }
   void do_klass(Klass* k) {
@@ -1408,12 +1487,12 @@ class VM_HeapDumper;
 
 class HeapObjectDumper : public ObjectClosure {
  private:
-  DumpWriter* _writer;
+  AbstractDumpWriter* _writer;
 
-  DumpWriter* writer()                  { return _writer; }
+  AbstractDumpWriter* writer()                  { return _writer; }
 
  public:
-  HeapObjectDumper(DumpWriter* writer) {
+  HeapObjectDumper(AbstractDumpWriter* writer) {
     _writer = writer;
   }
 
@@ -1446,6 +1525,60 @@ void HeapObjectDumper::do_object(oop o) {
   }
 }
 
+// Coordinates the heap dumper threads of a parallel heap dump. The gang
+// workers dumping the heap wait until the VM thread has written all
+// non-heap records, and the VM thread waits for all of them to complete
+// before it writes the GC roots.
+class DumperController : public CHeapObj<mtServiceability> {
+ private:
+  bool     _started;
+  Monitor* _lock;
+  uint     _dumper_number;
+  uint     _complete_number;
+
+ public:
+  DumperController(uint number) :
+    _started(false),
+    _lock(new (std::nothrow) PaddedMonitor(Mutex::leaf, "Heap Dumper Controller",
+                                           true, Mutex::_safepoint_check_never)),
+    _dumper_number(number),
+    _complete_number(0) { }
+
+  ~DumperController() { delete _lock; }
+
+  bool is_valid() const { return _lock != NULL; }
+
+  void wait_for_start_signal() {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    while (!_started) {
+      ml.wait();
+    }
+  }
+
+  void start_dump() {
+    assert(!_started, "start dump with wrong state");
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    _started = true;
+    ml.notify_all();
+  }
+
+  void dumper_complete() {
+    assert(_started, "dumper complete with wrong state");
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    _complete_number++;
+    ml.notify();
+  }
+
+  void wait_all_dumpers_complete() {
+    assert(_started, "wrong state when wait for dumper complete");
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    while (_complete_number != _dumper_number) {
+      ml.wait();
+    }
+    _started = false;
+  }
+};
+
 // The VM operation that performs the heap dump
 class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
  private:
@@ -1459,6 +1592,14 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
   ThreadStackTrace** _stack_traces;
   int _num_threads;
 
+  // parallel heap dump support
+  uint _num_dumper_threads;                // heap dumper threads, including the VM thread
+  ParallelObjectIterator* _poi;
+  DumperController* _dumper_controller;
+  Mutex* _par_writer_lock;                 // serializes the segments written by the dumper threads
+  char** _par_buffers;                     // one ParDumpWriter buffer per dumper thread
+  uint _num_par_buffers;
+
   // accessors and setters
   static VM_HeapDumper* dumper()         {  assert(_global_dumper != NULL, "Error"); return _global_dumper; }
   static DumpWriter* writer()            {  assert(_global_writer != NULL, "Error"); return _global_writer; }
@@ -1498,8 +1639,20 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  bool is_parallel_dump() const { return _num_dumper_threads > 1; }
+
+  // Sets up the state needed by the dumper threads. Falls back to a serial
+  // dump if the GC does not support parallel object iteration or if memory
+  // for the per-thread buffers cannot be allocated.
+  void prepare_parallel_dump(uint num_active_workers);
+  void finish_parallel_dump();
+
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and HPROF_GC_PRIM_ARRAY_DUMP
+  // records for the part of the heap claimed by the given dumper thread
+  void dump_heap_objects(uint dumper_id);
+
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
+  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome, uint num_dump_threads) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
@@ -1510,6 +1663,12 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
     _klass_map = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, mtServiceability);
     _stack_traces = NULL;
     _num_threads = 0;
+    _num_dumper_threads = MAX2(num_dump_threads, 1u);
+    _poi = NULL;
+    _dumper_controller = NULL;
+    _par_writer_lock = NULL;
+    _par_buffers = NULL;
+    _num_par_buffers = 0;
     if (oome) {
       assert(!Thread::current()->is_VM_thread(), "Dump from OutOfMemoryError cannot be called by the VMThread");
       // get OutOfMemoryError zero-parameter constructor
@@ -1547,7 +1706,7 @@ bool VM_HeapDumper::skip_operation() const {
 }
 
 // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
-void DumperSupport::end_of_dump(DumpWriter* writer) {
+void DumperSupport::end_of_dump(AbstractDumpWriter* writer) {
   writer->finish_dump_segment();
 
   writer->write_u1(HPROF_HEAP_DUMP_END);
@@ -1769,9 +1928,12 @@ void VM_HeapDumper::doit() {
   WorkGang* gang = ch->safepoint_workers();
 
   if (gang == NULL) {
+    _num_dumper_threads = 1;
     work(0);
   } else {
+    prepare_parallel_dump(gang->active_workers());
     gang->run_task(this, gang->active_workers(), true);
+    finish_parallel_dump();
   }
 
   // Now we clear the global variables, so that a future dumper can run.
@@ -1779,9 +1941,90 @@ void VM_HeapDumper::doit() {
   clear_global_writer();
 }
 
+void VM_HeapDumper::prepare_parallel_dump(uint num_active_workers) {
+  // The VM thread and all but one of the gang workers can dump the heap. The
+  // remaining gang workers compress and write the data in the background.
+  uint num_dumpers = MIN2(_num_dumper_threads, num_active_workers);
+  _num_dumper_threads = 1;
+
+  if (num_dumpers <= 1) {
+    return;
+  }
+
+  _par_buffers = NEW_C_HEAP_ARRAY_RETURN_NULL(char*, num_dumpers, mtServiceability);
+  if (_par_buffers == NULL) {
+    return;
+  }
+
+  bool success = true;
+  while (success && (_num_par_buffers < num_dumpers)) {
+    char* buffer = (char*) os::malloc(ParDumpWriter::io_buffer_size(), mtServiceability);
+    if (buffer != NULL) {
+      _par_buffers[_num_par_buffers++] = buffer;
+    } else {
+      success = false;
+    }
+  }
+
+  if (success) {
+    _par_writer_lock = new (std::nothrow) PaddedMutex(Mutex::leaf + 1, "HProf Parallel Dump",
+                                                      true, Mutex::_safepoint_check_never);
+    _dumper_controller = new (std::nothrow) DumperController(num_dumpers - 1);
+    success = (_par_writer_lock != NULL) && (_dumper_controller != NULL) && _dumper_controller->is_valid();
+  }
+
+  if (success) {
+    _poi = Universe::heap()->parallel_object_iterator(num_dumpers);
+    success = (_poi != NULL);
+  }
+
+  if (success) {
+    _num_dumper_threads = num_dumpers;
+  } else {
+    // Not enough resources or no GC support, dump the heap with the VM thread only.
+    finish_parallel_dump();
+  }
+  log_debug(heapdump)("Using %u heap dumper threads", _num_dumper_threads);
+}
+
+void VM_HeapDumper::finish_parallel_dump() {
+  delete _poi;
+  _poi = NULL;
+  delete _dumper_controller;
+  _dumper_controller = NULL;
+  delete _par_writer_lock;
+  _par_writer_lock = NULL;
+
+  if (_par_buffers != NULL) {
+    for (uint i = 0; i < _num_par_buffers; i++) {
+      os::free(_par_buffers[i]);
+    }
+    FREE_C_HEAP_ARRAY(char*, _par_buffers);
+    _par_buffers = NULL;
+    _num_par_buffers = 0;
+  }
+}
+
+void VM_HeapDumper::dump_heap_objects(uint dumper_id) {
+  assert(is_parallel_dump(), "Must be a parallel dump");
+  assert(dumper_id < _num_dumper_threads, "Invalid dumper id %u", dumper_id);
+
+  ParDumpWriter local_writer(writer(), _par_writer_lock, _par_buffers[dumper_id]);
+  HeapObjectDumper obj_dumper(&local_writer);
+  _poi->object_iterate(&obj_dumper, dumper_id);
+  local_writer.finish_dump_segment();
+}
+
 void VM_HeapDumper::work(uint worker_id) {
   if (!Thread::current()->is_VM_thread()) {
-    writer()->writer_loop();
+    if (is_parallel_dump() && (worker_id < _num_dumper_threads - 1)) {
+      // This gang worker dumps a part of the heap. The VM thread is dumper 0.
+      _dumper_controller->wait_for_start_signal();
+      dump_heap_objects(worker_id + 1);
+      _dumper_controller->dumper_complete();
+    } else {
+      writer()->writer_loop();
+    }
     return;
   }
 
@@ -1823,8 +2066,17 @@ void VM_HeapDumper::work(uint worker_id) {
   // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(writer());
-  Universe::heap()->object_iterate(&obj_dumper);
+  if (is_parallel_dump()) {
+    // The dumper threads append complete dump segments to the file, so
+    // the current segment has to be finished before they start.
+    writer()->finish_dump_segment();
+    _dumper_controller->start_dump();
+    dump_heap_objects(0);
+    _dumper_controller->wait_all_dumpers_complete();
+  } else {
+    HeapObjectDumper obj_dumper(writer());
+    Universe::heap()->object_iterate(&obj_dumper);
+  }
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
@@ -1905,7 +2157,8 @@ void VM_HeapDumper::dump_stack_traces() {
 }
 
 // dump the heap to given path.
-int HeapDumper::dump(const char* path, outputStream* out, int compression) {
+int HeapDumper::dump(const char* path, outputStream* out, int compression,
+                     uint num_dump_threads, bool zstd) {
   assert(path != NULL && strlen(path) > 0, "path missing");
 
   // print message in interactive case
@@ -1920,15 +2173,28 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression) {
   AbstractCompressor* compressor = NULL;
 
   if (compression > 0) {
-    compressor = new (std::nothrow) GZipCompressor(compression);
+    if (zstd) {
+      compressor = new (std::nothrow) ZstdCompressor(compression);
+    } else {
+      compressor = new (std::nothrow) GZipCompressor(compression);
+    }
 
     if (compressor == NULL) {
-      set_error("Could not allocate gzip compressor");
+      set_error(zstd ? "Could not allocate zstd compressor" : "Could not allocate gzip compressor");
       return -1;
     }
   }
 
-  DumpWriter writer(new (std::nothrow) FileWriter(path), compressor);
+  // Pipes, sockets and file descriptors are streamed to; anything else is
+  // written to a newly created file.
+  AbstractWriter* file_writer = NULL;
+  if (StreamWriter::is_stream_target(path)) {
+    file_writer = new (std::nothrow) StreamWriter(path);
+  } else {
+    file_writer = new (std::nothrow) FileWriter(path);
+  }
+
+  DumpWriter writer(file_writer, compressor);
 
   if (writer.error() != NULL) {
     set_error(writer.error());
@@ -1940,7 +2206,7 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression) {
   }
 
   // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
+  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome, num_dump_threads);
   if (Thread::current()->is_VM_thread()) {
     assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
     dumper.doit();
@@ -1974,6 +2240,10 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression) {
   return (writer.error() == NULL) ? 0 : -1;
 }
 
+uint HeapDumper::default_num_of_dump_threads() {
+  return MAX2<uint>(1, (uint)os::initial_active_processor_count() * 3 / 8);
+}
+
 // stop timer (if still active), and free any error string we might be holding
 HeapDumper::~HeapDumper() {
   if (timer()->is_active()) {
@@ -2029,7 +2299,8 @@ void HeapDumper::dump_heap(bool oome) {
   const int max_digit_chars = 20;
 
   const char* dump_file_name = "java_pid";
-  const char* dump_file_ext  = HeapDumpGzipLevel > 0 ? ".hprof.gz" : ".hprof";
+  const char* dump_file_ext  = HeapDumpZstdLevel > 0 ? ".hprof.zst" :
+                               HeapDumpGzipLevel > 0 ? ".hprof.gz" : ".hprof";
 
   // The dump file defaults to java_pid<pid>.hprof in the current working
   // directory. HeapDumpPath=<file> can be used to specify an alternative
@@ -2052,7 +2323,7 @@ void HeapDumper::dump_heap(bool oome) {
     } else {
       strcpy(base_path, HeapDumpPath);
       // check if the path is a directory (must exist)
-      DIR* dir = os::opendir(base_path);
+      DIR* dir = StreamWriter::is_stream_target(base_path) ? NULL : os::opendir(base_path);
       if (dir == NULL) {
         use_default_filename = false;
       } else {
@@ -2082,6 +2353,15 @@ void HeapDumper::dump_heap(bool oome) {
       return;
     }
     strncpy(my_path, base_path, len);
+  } else if (StreamWriter::is_stream_target(base_path)) {
+    // A stream target is reused as it is for the following dumps.
+    const size_t len = strlen(base_path) + 1;
+    my_path = (char*)os::malloc(len, mtInternal);
+    if (my_path == NULL) {
+      warning("Cannot create heap dump file.  Out of system memory.");
+      return;
+    }
+    strncpy(my_path, base_path, len);
   } else {
     // Append a sequence number id for dumps following the first
     const size_t len = strlen(base_path) + max_digit_chars + 2; // for '.' and \0
@@ -2096,6 +2376,10 @@ void HeapDumper::dump_heap(bool oome) {
 
   HeapDumper dumper(false /* no GC before heap dump */,
                     oome  /* pass along out-of-memory-error flag */);
-  dumper.dump(my_path, tty, HeapDumpGzipLevel);
+  if (HeapDumpZstdLevel > 0) {
+    dumper.dump(my_path, tty, HeapDumpZstdLevel, default_num_of_dump_threads(), true /* zstd */);
+  } else {
+    dumper.dump(my_path, tty, HeapDumpGzipLevel, default_num_of_dump_threads());
+  }
   os::free(my_path);
 }
@@ -70,8 +70,14 @@ class HeapDumper : public StackObj {
 
   // dumps the heap to the specified file, returns 0 if success.
   // additional info is written to out if not NULL.
-  // compression >= 0 creates a gzipped file with the given compression level.
-  int dump(const char* path, outputStream* out = NULL, int compression = -1);
+  // compression >= 0 creates a gzipped file with the given compression level,
+  // or a zstd compressed file if zstd is true.
+  // num_dump_threads > 1 lets up to that many threads walk the heap in parallel.
+  int dump(const char* path, outputStream* out = NULL, int compression = -1,
+           uint num_dump_threads = 1, bool zstd = false);
+
+  // number of heap dumper threads used when the VM decides
+  static uint default_num_of_dump_threads();
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
@@ -63,6 +63,86 @@ char const* FileWriter::write_buf(char* buf, ssize_t size) {
   return NULL;
 }
 
+static const char stream_fd_prefix[] = "fd:";
+static const char stream_unix_socket_prefix[] = "unix:";
+
+static bool has_prefix(char const* str, char const* prefix) {
+  return strncmp(str, prefix, strlen(prefix)) == 0;
+}
+
+static bool is_fifo(char const* path) {
+#ifdef S_ISFIFO
+  struct stat st;
+  return (os::stat(path, &st) == 0) && S_ISFIFO(st.st_mode);
+#else
+  return false;
+#endif
+}
+
+bool StreamWriter::is_stream_target(char const* path) {
+  return has_prefix(path, stream_fd_prefix) ||
+         has_prefix(path, stream_unix_socket_prefix) ||
+         is_fifo(path);
+}
+
+char const* StreamWriter::open_writer() {
+  assert(_fd < 0, "Must not already be open");
+
+  if (has_prefix(_target, stream_fd_prefix)) {
+    char const* num_str = _target + strlen(stream_fd_prefix);
+    char* end = NULL;
+    errno = 0;
+    long fd = strtol(num_str, &end, 10);
+
+    if ((errno != 0) || (end == num_str) || (*end != '\0') || (fd < 0) || (fd > INT_MAX)) {
+      return "Invalid file descriptor";
+    }
+
+    _fd = (int) fd;
+    _owns_fd = false;
+  } else if (has_prefix(_target, stream_unix_socket_prefix)) {
+    _fd = os::connect_unix_domain_socket(_target + strlen(stream_unix_socket_prefix));
+    _owns_fd = true;
+  } else {
+    // A named pipe. Opening it blocks until a reader is attached.
+    _fd = os::open(_target, O_WRONLY, 0);
+    _owns_fd = true;
+  }
+
+  if (_fd < 0) {
+    return os::strerror(errno);
+  }
+
+  return NULL;
+}
+
+StreamWriter::~StreamWriter() {
+  if (_owns_fd && (_fd >= 0)) {
+    os::close(_fd);
+  }
+  _fd = -1;
+}
+
+char const* StreamWriter::write_buf(char* buf, ssize_t size) {
+  assert(_fd >= 0, "Must be open");
+  assert(size > 0, "Must write at least one byte");
+
+  // Pipes and sockets can accept less than requested, so continue until
+  // the consumer has taken everything.
+  while (size > 0) {
+    ssize_t n = (ssize_t) os::write(_fd, buf, (uint) size);
+
+    if (n <= 0) {
+      return os::strerror(errno);
+    }
+
+    buf += n;
+    size -= n;
+  }
+
+  return NULL;
+}
+
 
 typedef char const* (*GzipInitFunc)(size_t, size_t*, size_t*, int);
 typedef size_t(*GzipCompressFunc)(char*, size_t, char*, size_t, char*, size_t,
@@ -136,6 +216,116 @@ char const* GZipCompressor::compress(char* in, size_t in_size, char* out, size_t
   return msg;
 }
 
+typedef size_t (*ZstdCompressBoundFunc)(size_t);
+typedef size_t (*ZstdCompressFunc)(void*, size_t, const void*, size_t, int);
+typedef unsigned (*ZstdIsErrorFunc)(size_t);
+typedef char const* (*ZstdGetErrorNameFunc)(size_t);
+
+static ZstdCompressBoundFunc zstd_compress_bound_func;
+static ZstdCompressFunc zstd_compress_func;
+static ZstdIsErrorFunc zstd_is_error_func;
+static ZstdGetErrorNameFunc zstd_get_error_name_func;
+
+// The names the zstd library is installed under.
+static char const* const zstd_lib_names[] = {
+  JNI_LIB_PREFIX "zstd" JNI_LIB_SUFFIX,
+#ifdef LINUX
+  "libzstd.so.1",
+#endif
+#ifdef __APPLE__
+  "libzstd.1.dylib",
+#endif
+  NULL
+};
+
+// A zstd skippable frame holding the block size comment.
+static const u4 zstd_skippable_frame_magic = 0x184D2A50;
+static const size_t zstd_skippable_frame_header_size = 8;
+static const size_t zstd_max_comment_size = 128;
+
+void* ZstdCompressor::load_zstd_func(void* handle, char const* name) {
+  return os::dll_lookup(handle, name);
+}
+
+char const* ZstdCompressor::init(size_t block_size, size_t* needed_out_size,
+                                 size_t* needed_tmp_size) {
+  _block_size = block_size;
+  _is_first = true;
+
+  {
+    MutexLocker locker(Zip_lock, Monitor::_no_safepoint_check_flag);
+
+    if (zstd_compress_func == NULL) {
+      char ebuf[1024];
+      void* handle = NULL;
+
+      for (int i = 0; (handle == NULL) && (zstd_lib_names[i] != NULL); i++) {
+        handle = os::dll_load(zstd_lib_names[i], ebuf, sizeof ebuf);
+      }
+
+      if (handle == NULL) {
+        return "Cannot load the zstd library";
+      }
+
+      zstd_compress_bound_func = (ZstdCompressBoundFunc) load_zstd_func(handle, "ZSTD_compressBound");
+      zstd_is_error_func = (ZstdIsErrorFunc) load_zstd_func(handle, "ZSTD_isError");
+      zstd_get_error_name_func = (ZstdGetErrorNameFunc) load_zstd_func(handle, "ZSTD_getErrorName");
+
+      if ((zstd_compress_bound_func == NULL) || (zstd_is_error_func == NULL) ||
+          (zstd_get_error_name_func == NULL)) {
+        return "Cannot get zstd functions";
+      }
+
+      zstd_compress_func = (ZstdCompressFunc) load_zstd_func(handle, "ZSTD_compress");
+
+      if (zstd_compress_func == NULL) {
+        return "Cannot get ZSTD_compress function";
+      }
+    }
+  }
+
+  // Add extra space for the skippable frame with the comment in the first chunk.
+  *needed_out_size = zstd_compress_bound_func(block_size) +
+                     zstd_skippable_frame_header_size + zstd_max_comment_size;
+  *needed_tmp_size = 0;
+
+  return NULL;
+}
+
+char const* ZstdCompressor::compress(char* in, size_t in_size, char* out, size_t out_size,
+                                     char* tmp, size_t tmp_size, size_t* compressed_size) {
+  size_t header_size = 0;
+
+  if (_is_first) {
+    // Write the block size used into a skippable frame in front of the first
+    // chunk, so the code used to read it later can make a good choice of the
+    // buffer sizes it uses. Decompressors ignore skippable frames.
+    char buf[zstd_max_comment_size];
+    int len = jio_snprintf(buf, sizeof(buf), "HPROF BLOCKSIZE=" SIZE_FORMAT, _block_size);
+    assert(len > 0 && (size_t) len < sizeof(buf), "Comment must fit");
+
+    for (int i = 0; i < 4; i++) {
+      out[i] = (char) ((zstd_skippable_frame_magic >> (8 * i)) & 0xff);
+      out[4 + i] = (char) ((((u4) len) >> (8 * i)) & 0xff);
+    }
+    memcpy(out + zstd_skippable_frame_header_size, buf, len);
+    header_size = zstd_skippable_frame_header_size + len;
+    _is_first = false;
+  }
+
+  size_t result = zstd_compress_func(out + header_size, out_size - header_size,
+                                     in, in_size, _level);
+
+  if (zstd_is_error_func(result)) {
+    *compressed_size = 0;
+    return zstd_get_error_name_func(result);
+  }
+
+  *compressed_size = header_size + result;
+
+  return NULL;
+}
+
 WorkList::WorkList() {
   _head._next = &_head;
   _head._prev = &_head;
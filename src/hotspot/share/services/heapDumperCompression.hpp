@@ -76,6 +76,38 @@ public:
 };
 
 
+// A writer streaming the dump to a pipe, a UNIX domain socket or an already
+// opened file descriptor, so nothing is staged on disk. write_buf() blocks
+// until the consumer has taken all the data. Since the CompressionBackend
+// only creates a bounded number of WriteWork buffers, a slow consumer throttles
+// the dumper instead of letting the buffered data grow.
+//
+// Supported targets are:
+//   fd:<n>      an open file descriptor (not closed when done)
+//   unix:<path> a UNIX domain socket listening at <path>
+//   <path>      an existing named pipe (FIFO)
+class StreamWriter : public AbstractWriter {
+private:
+  char const* _target;
+  int _fd;
+  bool _owns_fd;
+
+public:
+  StreamWriter(char const* target) : _target(target), _fd(-1), _owns_fd(false) { }
+
+  ~StreamWriter();
+
+  // Returns true if the given dump path denotes a stream target.
+  static bool is_stream_target(char const* path);
+
+  // Opens the writer. Returns NULL on success and a static error message otherwise.
+  virtual char const* open_writer();
+
+  // Does the write. Returns NULL on success and a static error message otherwise.
+  virtual char const* write_buf(char* buf, ssize_t size);
+};
+
+
 // A compressor using the gzip format.
 class GZipCompressor : public AbstractCompressor {
 private:
@@ -97,6 +129,29 @@ public:
 };
 
 
+// A compressor using the zstd frame format. Every buffer is compressed into
+// its own frame, and the concatenated frames form a valid zstd stream. The
+// zstd library of the system is loaded on first use.
+class ZstdCompressor : public AbstractCompressor {
+private:
+  int _level;
+  size_t _block_size;
+  bool _is_first;
+
+  static void* load_zstd_func(void* handle, char const* name);
+
+public:
+  ZstdCompressor(int level) : _level(level), _block_size(0), _is_first(false) {
+  }
+
+  virtual char const* init(size_t block_size, size_t* needed_out_size,
+                           size_t* needed_tmp_size);
+
+  virtual char const* compress(char* in, size_t in_size, char* out, size_t out_size,
+                               char* tmp, size_t tmp_size, size_t* compressed_size);
+};
+
+
 // The data needed to write a single buffer (and compress it optionally).
 struct WriteWork {
   // The id of the work.
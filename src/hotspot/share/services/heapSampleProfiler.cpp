@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "gc/shared/oopStorage.hpp"
+#include "gc/shared/oopStorageSet.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/oop.inline.hpp"
+#include "oops/symbol.hpp"
+#include "oops/weakHandle.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/threadHeapSampler.hpp"
+#include "services/heapSampleProfiler.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+
+#include <math.h>
+
+OopStorage* HeapSampleProfiler::_oop_storage = NULL;
+HeapSampleProfiler::Sample* HeapSampleProfiler::_samples = NULL;
+size_t HeapSampleProfiler::_next = 0;
+size_t HeapSampleProfiler::_total = 0;
+GrowableArrayCHeap<HeapSampleProfiler::Sample, mtServiceability>* HeapSampleProfiler::_live_samples = NULL;
+volatile bool HeapSampleProfiler::_dead_samples = false;
+
+void HeapSampleProfiler::create_oop_storage() {
+  _oop_storage = OopStorageSet::create_weak("HeapSampleProfiler Weak", mtServiceability);
+  _oop_storage->register_num_dead_callback(&gc_notification);
+}
+
+void HeapSampleProfiler::gc_notification(size_t num_dead) {
+  if (num_dead > 0) {
+    // Prune the live set with the next sample or profile, there is no
+    // need for a separate cleanup task at the sampling rate.
+    Atomic::store(&_dead_samples, true);
+  }
+}
+
+void HeapSampleProfiler::release(Sample& s) {
+  s._obj.release(_oop_storage);
+  s._klass_name->decrement_refcount();
+  if (s._loader_name != NULL) {
+    s._loader_name->decrement_refcount();
+  }
+  s._obj = WeakHandle();
+  s._klass_name = NULL;
+  s._loader_name = NULL;
+}
+
+void HeapSampleProfiler::prune_live_samples() {
+  assert_lock_strong(HeapSampleProfiler_lock);
+  if (!Atomic::load(&_dead_samples)) {
+    return;
+  }
+  Atomic::store(&_dead_samples, false);
+  if (_live_samples == NULL) {
+    return;
+  }
+  int j = 0;
+  for (int i = 0; i < _live_samples->length(); i++) {
+    Sample& s = _live_samples->at(i);
+    if (s._obj.peek() == NULL) {
+      release(s);
+    } else {
+      _live_samples->at_put(j++, s);
+    }
+  }
+  _live_samples->trunc_to(j);
+}
+
+void HeapSampleProfiler::record(oop obj, size_t size_in_bytes) {
+  // Allocate the handle and pin the names outside the lock, the lock only
+  // protects the ring and the live set.
+  WeakHandle wh(_oop_storage, obj);
+  Symbol* name = obj->klass()->name();
+  name->increment_refcount();
+  Symbol* loader_name = obj->klass()->class_loader_data()->name_and_id();
+  if (loader_name != NULL) {
+    loader_name->increment_refcount();
+  }
+
+  Sample old;
+  {
+    MutexLocker ml(HeapSampleProfiler_lock, Mutex::_no_safepoint_check_flag);
+    if (_samples == NULL) {
+      _samples = NEW_C_HEAP_ARRAY(Sample, capacity, mtServiceability);
+      memset(_samples, 0, capacity * sizeof(Sample));
+      _live_samples = new GrowableArrayCHeap<Sample, mtServiceability>(0);
+    }
+    prune_live_samples();
+    Sample& s = _samples[_next];
+    old = s;
+    s._obj = wh;
+    s._klass_name = name;
+    s._loader_name = loader_name;
+    s._size = size_in_bytes;
+    _next = (_next + 1) % capacity;
+    _total++;
+    if (old._klass_name != NULL && old._obj.peek() != NULL) {
+      // Still live, keep it for the live profile
+      _live_samples->append(old);
+      old._klass_name = NULL;
+    }
+  }
+
+  if (old._klass_name != NULL) {
+    release(old);
+  }
+}
+
+void HeapSampleProfiler::reset() {
+  MutexLocker ml(HeapSampleProfiler_lock, Mutex::_no_safepoint_check_flag);
+  if (_samples == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < capacity; i++) {
+    Sample& s = _samples[i];
+    if (s._klass_name != NULL) {
+      release(s);
+    }
+  }
+  for (int i = 0; i < _live_samples->length(); i++) {
+    release(_live_samples->at(i));
+  }
+  _live_samples->clear();
+  _next = 0;
+  _total = 0;
+}
+
+namespace {
+
+struct SampleCopy {
+  Symbol* _name;
+  Symbol* _loader;
+  size_t  _size;
+  bool    _recent;   // still in the ring
+  bool    _live;
+};
+
+struct ClassProfile {
+  Symbol* _name;
+  Symbol* _loader;
+  size_t  _samples;
+  size_t  _live_samples;
+  double  _bytes;
+  double  _live_bytes;
+};
+
+int compare_by_class(SampleCopy* a, SampleCopy* b) {
+  uintptr_t x = (uintptr_t)a->_name;
+  uintptr_t y = (uintptr_t)b->_name;
+  if (x == y) {
+    x = (uintptr_t)a->_loader;
+    y = (uintptr_t)b->_loader;
+  }
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// Sort descending.
+int compare_by_bytes(ClassProfile* a, ClassProfile* b) {
+  return a->_bytes > b->_bytes ? -1 : (a->_bytes < b->_bytes ? 1 : 0);
+}
+
+int compare_by_live_bytes(ClassProfile* a, ClassProfile* b) {
+  return a->_live_bytes > b->_live_bytes ? -1 : (a->_live_bytes < b->_live_bytes ? 1 : 0);
+}
+
+// A sample of size s taken with mean interval I stands for an expected
+// s / (1 - exp(-s / I)) allocated bytes, the same unsampling pprof does.
+double unsampled_bytes(size_t size, int interval) {
+  if (interval <= 0) {
+    return (double)size;
+  }
+  double s = (double)size;
+  return s / (1.0 - exp(-s / interval));
+}
+
+void copy_sample(GrowableArray<SampleCopy>& copies, Symbol* name, Symbol* loader,
+                 size_t size, bool recent, bool live) {
+  name->increment_refcount();
+  if (loader != NULL) {
+    loader->increment_refcount();
+  }
+  SampleCopy c = { name, loader, size, recent, live };
+  copies.append(c);
+}
+
+} // anonymous namespace
+
+void HeapSampleProfiler::print_profile(outputStream* st, size_t max_classes, bool live_only) {
+  ResourceMark rm;
+  GrowableArray<SampleCopy> copies;
+  size_t total;
+  int recent = 0;
+  {
+    MutexLocker ml(HeapSampleProfiler_lock, Mutex::_no_safepoint_check_flag);
+    prune_live_samples();
+    total = _total;
+    if (_samples != NULL) {
+      for (size_t i = 0; i < capacity; i++) {
+        Sample& s = _samples[i];
+        if (s._klass_name != NULL) {
+          copy_sample(copies, s._klass_name, s._loader_name, s._size, true, s._obj.peek() != NULL);
+          recent++;
+        }
+      }
+      for (int i = 0; i < _live_samples->length(); i++) {
+        Sample& s = _live_samples->at(i);
+        copy_sample(copies, s._klass_name, s._loader_name, s._size, false, s._obj.peek() != NULL);
+      }
+    }
+  }
+
+  // The current interval is used for all samples, samples taken before
+  // an interval change are weighted approximately.
+  int interval = ThreadHeapSampler::get_sampling_interval();
+  st->print_cr("Heap profile: %d samples retained of " SIZE_FORMAT " recorded, "
+               "%d older live samples, sampling interval %d bytes",
+               recent, total, copies.length() - recent, interval);
+  if (!HeapProfileSampling) {
+    st->print_cr("HeapProfileSampling is disabled, no new samples are recorded.");
+  }
+
+  copies.sort(compare_by_class);
+  GrowableArray<ClassProfile> profiles;
+  for (int i = 0; i < copies.length(); i++) {
+    const SampleCopy& c = copies.at(i);
+    if (profiles.is_empty() || profiles.last()._name != c._name || profiles.last()._loader != c._loader) {
+      ClassProfile p = { c._name, c._loader, 0, 0, 0.0, 0.0 };
+      profiles.append(p);
+    }
+    ClassProfile& p = profiles.at(profiles.length() - 1);
+    double bytes = unsampled_bytes(c._size, interval);
+    if (c._recent) {
+      p._samples++;
+      p._bytes += bytes;
+    }
+    if (c._live) {
+      p._live_samples++;
+      p._live_bytes += bytes;
+    }
+  }
+  profiles.sort(live_only ? compare_by_live_bytes : compare_by_bytes);
+
+  st->print_cr(" num    #samples   est. bytes       #live  est. live bytes  class name (loader)");
+  st->print_cr("-----------------------------------------------------------------------");
+  size_t printed = 0;
+  for (int i = 0; i < profiles.length() && printed < max_classes; i++) {
+    const ClassProfile& p = profiles.at(i);
+    if (live_only && p._live_samples == 0) {
+      continue;
+    }
+    printed++;
+    st->print_cr(SIZE_FORMAT_W(4) ": " SIZE_FORMAT_W(11) " %12.0f " SIZE_FORMAT_W(11) " %16.0f  %s (%s)",
+                 printed, p._samples, p._bytes, p._live_samples, p._live_bytes,
+                 p._name->as_klass_external_name(),
+                 p._loader != NULL ? p._loader->as_C_string() : "'" BOOTSTRAP_LOADER_NAME "'");
+  }
+
+  for (int i = 0; i < copies.length(); i++) {
+    copies.at(i)._name->decrement_refcount();
+    if (copies.at(i)._loader != NULL) {
+      copies.at(i)._loader->decrement_refcount();
+    }
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_SERVICES_HEAPSAMPLEPROFILER_HPP
+#define SHARE_SERVICES_HEAPSAMPLEPROFILER_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "oops/weakHandle.hpp"
+
+class OopStorage;
+class outputStream;
+class Symbol;
+template <typename E, MEMFLAGS F> class GrowableArrayCHeap;
+
+// Agent-less consumer of the ThreadHeapSampler. When HeapProfileSampling
+// is enabled every sampled allocation is recorded in a fixed-size ring
+// together with a weak handle to the allocated object, so that a snapshot
+// can report both what was allocated and what of it is still live.
+//
+// A sample pushed out of the ring while its object is still alive moves
+// to a separate live set, so long lived objects stay in the live profile
+// however much is allocated after them. The live set is pruned of dead
+// samples after the GC has cleared their handles.
+class HeapSampleProfiler : AllStatic {
+ public:
+  static const size_t capacity = 16 * K;
+
+ private:
+  struct Sample {
+    WeakHandle _obj;
+    Symbol*    _klass_name;
+    // name_and_id() of the defining loader, NULL for the boot loader.
+    // Classes of the same name from different loaders are kept apart.
+    Symbol*    _loader_name;
+    size_t     _size;
+  };
+
+  static OopStorage*                  _oop_storage;
+  static Sample*                      _samples;
+  static size_t                       _next;
+  static size_t                       _total;
+  static GrowableArrayCHeap<Sample, mtServiceability>* _live_samples;
+  static volatile bool                _dead_samples;
+
+  static void gc_notification(size_t num_dead);
+  static void release(Sample& s);
+  static void prune_live_samples();
+
+ public:
+  static void create_oop_storage();
+
+  // Called by the allocating thread for each sampled allocation.
+  static void record(oop obj, size_t size_in_bytes);
+
+  // Aggregate the retained samples per class and print up to max_classes
+  // entries, largest estimated allocation first.
+  static void print_profile(outputStream* st, size_t max_classes, bool live_only);
+
+  static void reset();
+};
+
+#endif // SHARE_SERVICES_HEAPSAMPLEPROFILER_HPP
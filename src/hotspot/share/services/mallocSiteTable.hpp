@@ -31,6 +31,7 @@
 
 #include "memory/allocation.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "services/allocationSite.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/nmtCommon.hpp"
@@ -39,7 +40,7 @@
 // MallocSite represents a code path that eventually calls
 // os::malloc() to allocate memory
 class MallocSite : public AllocationSite {
-  MemoryCounter _c;
+  StripedMemoryCounter _c;
  public:
   MallocSite(const NativeCallStack& stack, MEMFLAGS flags) :
     AllocationSite(stack, flags) {}
@@ -47,10 +48,12 @@ class MallocSite : public AllocationSite {
   void allocate(size_t size)      { _c.allocate(size);   }
   void deallocate(size_t size)    { _c.deallocate(size); }
 
-  // Memory allocated from this code path
-  size_t size()  const { return _c.size(); }
+  // Memory allocated from this code path. With sampled call stacks
+  // each recorded allocation stands for NMTMallocStackSamplingInterval
+  // allocations on average, so these are estimates.
+  size_t size()  const { return _c.size() * NMTMallocStackSamplingInterval; }
   // The number of calls were made
-  size_t count() const { return _c.count(); }
+  size_t count() const { return _c.count() * NMTMallocStackSamplingInterval; }
 };
 
 // Malloc site hashtable entry
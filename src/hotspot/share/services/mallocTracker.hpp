@@ -28,6 +28,7 @@
 #if INCLUDE_NMT
 
 #include "memory/allocation.hpp"
+#include "memory/padded.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/nmtCommon.hpp"
@@ -89,6 +90,84 @@ class MemoryCounter {
 #endif // ASSERT
 };
 
+/*
+ * A MemoryCounter for counters updated on every malloc/free.
+ * A single counter pair becomes a contended cache line when many threads
+ * allocate concurrently, so the updates are spread over cache line padded
+ * stripes and folded when read. The stripe is picked from the caller's stack
+ * address: threads run on distinct stacks, and no thread-local state is
+ * needed (malloc tracking starts before any thread is attached).
+ * A block may be freed on another stripe than it was allocated on, so a
+ * single stripe can wrap below zero; the folded sums are still exact.
+ * Reads are not atomic across stripes and may observe a concurrent update
+ * only partially, as would be the case for reading _count and _size of a
+ * MemoryCounter.
+ */
+class StripedMemoryCounter {
+ private:
+  static const int log_num_stripes = 3;
+  static const int num_stripes = 1 << log_num_stripes;
+
+  struct Stripe {
+    volatile size_t _count;
+    volatile size_t _size;
+    DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, 2 * sizeof(size_t));
+  };
+
+  Stripe _stripes[num_stripes];
+
+  static inline Stripe* select(StripedMemoryCounter* c) {
+    volatile int anchor = 0;
+    // Fibonacci hashing of the 4K stack page; thread stacks are typically
+    // a power of two apart, so the low bits of the page number would collide.
+    uint32_t h = (uint32_t)((uintptr_t)&anchor >> 12) * 0x9E3779B9u;
+    return &c->_stripes[h >> (32 - log_num_stripes)];
+  }
+
+ public:
+  StripedMemoryCounter() {
+    for (int i = 0; i < num_stripes; i++) {
+      _stripes[i]._count = 0;
+      _stripes[i]._size = 0;
+    }
+  }
+
+  inline void allocate(size_t sz) {
+    Stripe* s = select(this);
+    Atomic::inc(&s->_count, memory_order_relaxed);
+    if (sz > 0) {
+      Atomic::add(&s->_size, sz, memory_order_relaxed);
+    }
+  }
+
+  // A stripe may go below zero when memory is freed on another stripe than
+  // it was allocated on; only the sums are meaningful. They are read without
+  // a snapshot of all stripes, so the deallocation is not checked against them.
+  inline void deallocate(size_t sz) {
+    Stripe* s = select(this);
+    Atomic::dec(&s->_count, memory_order_relaxed);
+    if (sz > 0) {
+      Atomic::sub(&s->_size, sz, memory_order_relaxed);
+    }
+  }
+
+  inline size_t count() const {
+    size_t sum = 0;
+    for (int i = 0; i < num_stripes; i++) {
+      sum += Atomic::load(&_stripes[i]._count);
+    }
+    return sum;
+  }
+
+  inline size_t size() const {
+    size_t sum = 0;
+    for (int i = 0; i < num_stripes; i++) {
+      sum += Atomic::load(&_stripes[i]._size);
+    }
+    return sum;
+  }
+};
+
 /*
  * Malloc memory used by a particular subsystem.
  * It includes the memory acquired through os::malloc()
@@ -96,8 +175,8 @@ class MemoryCounter {
  */
 class MallocMemory {
  private:
-  MemoryCounter _malloc;
-  MemoryCounter _arena;
+  StripedMemoryCounter _malloc;
+  MemoryCounter        _arena;
 
  public:
   MallocMemory() { }
@@ -127,7 +206,7 @@ class MallocMemory {
   inline size_t arena_size()   const { return _arena.size();  }
   inline size_t arena_count()  const { return _arena.count(); }
 
-  DEBUG_ONLY(inline const MemoryCounter& malloc_counter() const { return _malloc; })
+  DEBUG_ONLY(inline const StripedMemoryCounter& malloc_counter() const { return _malloc; })
   DEBUG_ONLY(inline const MemoryCounter& arena_counter()  const { return _arena;  })
 };
 
@@ -139,8 +218,8 @@ class MallocMemorySnapshot : public ResourceObj {
   friend class MallocMemorySummary;
 
  private:
-  MallocMemory      _malloc[mt_number_of_types];
-  MemoryCounter     _tracking_header;
+  MallocMemory         _malloc[mt_number_of_types];
+  StripedMemoryCounter _tracking_header;
 
 
  public:
@@ -149,7 +228,7 @@ class MallocMemorySnapshot : public ResourceObj {
     return &_malloc[index];
   }
 
-  inline MemoryCounter* malloc_overhead() {
+  inline StripedMemoryCounter* malloc_overhead() {
     return &_tracking_header;
   }
 
@@ -272,8 +351,12 @@ class MallocHeader {
     if (level == NMT_detail) {
       size_t bucket_idx;
       size_t pos_idx;
-      if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
-        assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
+      if (stack.is_empty()) {
+        // Call stack not sampled, only accounted in the summary
+        _bucket_idx = no_site_bucket;
+        _pos_idx = 0;
+      } else if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
+        assert(bucket_idx < no_site_bucket, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
         _pos_idx = pos_idx;
@@ -284,6 +367,9 @@ class MallocHeader {
     MallocMemorySummary::record_new_malloc_header(sizeof(MallocHeader));
   }
 
+  // Bucket index marking a block whose call stack was not recorded
+  static const size_t no_site_bucket = MAX_MALLOCSITE_TABLE_SIZE;
+
   inline size_t   size()  const { return _size; }
   inline MEMFLAGS flags() const { return (MEMFLAGS)_flags; }
   bool get_stack(NativeCallStack& stack) const;
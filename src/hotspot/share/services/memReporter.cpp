@@ -241,6 +241,10 @@ void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
   out->print_cr("Details:\n");
+  if (NMTMallocStackSamplingInterval > 1) {
+    out->print_cr("(Malloc call stacks sampled once in %u allocations on average, malloc site figures are estimates.)\n",
+                  NMTMallocStackSamplingInterval);
+  }
 
   int num_omitted =
       report_malloc_sites() +
@@ -26,6 +26,7 @@
 #include "memory/metaspaceUtils.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
 #include "services/memBaseline.hpp"
@@ -43,12 +44,29 @@
 
 volatile NMT_TrackingLevel MemTracker::_tracking_level = NMT_unknown;
 NMT_TrackingLevel MemTracker::_cmdline_tracking_level = NMT_unknown;
+NMT_SAMPLING_THREAD_LOCAL uint MemTracker::_malloc_stack_sample_countdown = 0;
+NMT_SAMPLING_THREAD_LOCAL julong MemTracker::_malloc_stack_sample_seed = 0;
 
 MemBaseline MemTracker::_baseline;
 bool MemTracker::_is_nmt_env_valid = true;
 
 static const size_t buffer_size = 64;
 
+uint MemTracker::next_malloc_stack_sample_countdown() {
+  julong x = _malloc_stack_sample_seed;
+  if (x == 0) {
+    // Seed each thread differently. xorshift needs a non-zero state.
+    x = ((julong)(juint)os::random() << 32) ^ (julong)p2i(&_malloc_stack_sample_seed) ^ 1;
+  }
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  _malloc_stack_sample_seed = x;
+  // Uniform in [1, 2n - 1], so the mean is n
+  julong n = NMTMallocStackSamplingInterval;
+  return (uint)(1 + x % (2 * n - 1));
+}
+
 NMT_TrackingLevel MemTracker::init_tracking_level() {
   // Memory type is encoded into tracking header as a byte field,
   // make sure that we don't overflow it.
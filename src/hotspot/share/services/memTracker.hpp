@@ -33,6 +33,8 @@
 
 #define CURRENT_PC   NativeCallStack::empty_stack()
 #define CALLER_PC    NativeCallStack::empty_stack()
+#define CURRENT_PC_UNSAMPLED NativeCallStack::empty_stack()
+#define CALLER_PC_UNSAMPLED  NativeCallStack::empty_stack()
 
 class Tracker : public StackObj {
  public:
@@ -80,17 +82,34 @@ class MemTracker : AllStatic {
 
 #else
 
+#include "runtime/globals.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/threadStackTracker.hpp"
 #include "services/virtualMemoryTracker.hpp"
 
-#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail) ? \
+// CURRENT_PC and CALLER_PC are subject to NMTMallocStackSamplingInterval: when
+// a stack is not sampled they yield the empty stack, and the allocation is only
+// accounted in the summary. Virtual memory and thread stack tracking need the
+// stack of every reservation and use the _UNSAMPLED variants instead.
+#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail &&          \
+                     MemTracker::should_sample_malloc_stack()) ?            \
                     NativeCallStack(0) : NativeCallStack::empty_stack())
-#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail) ?  \
+#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail &&          \
+                     MemTracker::should_sample_malloc_stack()) ?            \
+                    NativeCallStack(1) : NativeCallStack::empty_stack())
+#define CURRENT_PC_UNSAMPLED ((MemTracker::tracking_level() == NMT_detail) ? \
+                    NativeCallStack(0) : NativeCallStack::empty_stack())
+#define CALLER_PC_UNSAMPLED  ((MemTracker::tracking_level() == NMT_detail) ? \
                     NativeCallStack(1) : NativeCallStack::empty_stack())
 
+#ifndef USE_LIBRARY_BASED_TLS_ONLY
+#define NMT_SAMPLING_THREAD_LOCAL THREAD_LOCAL
+#else
+#define NMT_SAMPLING_THREAD_LOCAL
+#endif
+
 class MemBaseline;
 
 // Tracker is used for guarding 'release' semantics of virtual memory operation, to avoid
@@ -116,6 +135,29 @@ class MemTracker : AllStatic {
   friend class VirtualMemoryTrackerTest;
 
  public:
+  // Returns true if the call stack of the current allocation should be
+  // captured. Each thread counts down a random number of mallocs between
+  // two samples, with a mean of NMTMallocStackSamplingInterval, which is
+  // what MallocSite::size() and count() scale by. A fixed stride would
+  // alias with periodic allocation patterns. The countdown is thread
+  // local, so allocating threads don't share a cache line.
+  static inline bool should_sample_malloc_stack() {
+    if (NMTMallocStackSamplingInterval <= 1) {
+      return true;
+    }
+    uint countdown = _malloc_stack_sample_countdown;
+    if (countdown == 0) {
+      // First malloc of this thread
+      countdown = next_malloc_stack_sample_countdown();
+    }
+    if (countdown > 1) {
+      _malloc_stack_sample_countdown = countdown - 1;
+      return false;
+    }
+    _malloc_stack_sample_countdown = next_malloc_stack_sample_countdown();
+    return true;
+  }
+
   static inline NMT_TrackingLevel tracking_level() {
     if (_tracking_level == NMT_unknown) {
       // No fencing is needed here, since JVM is in single-threaded
@@ -267,7 +309,7 @@ class MemTracker : AllStatic {
   static void record_thread_stack(void* addr, size_t size) {
     if (tracking_level() < NMT_summary) return;
     if (addr != NULL) {
-      ThreadStackTracker::new_thread_stack((address)addr, size, CALLER_PC);
+      ThreadStackTracker::new_thread_stack((address)addr, size, CALLER_PC_UNSAMPLED);
     }
   }
 
@@ -306,6 +348,7 @@ class MemTracker : AllStatic {
  private:
   static NMT_TrackingLevel init_tracking_level();
   static void report(bool summary_only, outputStream* output, size_t scale);
+  static uint next_malloc_stack_sample_countdown();
 
  private:
   // Tracking level
@@ -315,6 +358,11 @@ class MemTracker : AllStatic {
   static bool                         _is_nmt_env_valid;
   // command line tracking level
   static NMT_TrackingLevel            _cmdline_tracking_level;
+  // Malloc call stack sampling countdown and its xorshift state, see
+  // should_sample_malloc_stack(). Shared by all threads on platforms
+  // that only have library based thread locals.
+  static NMT_SAMPLING_THREAD_LOCAL uint   _malloc_stack_sample_countdown;
+  static NMT_SAMPLING_THREAD_LOCAL julong _malloc_stack_sample_seed;
   // Stored baseline
   static MemBaseline      _baseline;
   // Query lock
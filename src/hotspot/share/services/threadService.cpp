@@ -41,6 +41,7 @@
 #include "prims/jvmtiRawMonitor.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/init.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/thread.inline.hpp"
@@ -48,6 +49,7 @@
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
+#include "runtime/vm_version.hpp"
 #include "services/threadService.hpp"
 
 // TODO: we need to define a naming convention for perf counters
@@ -367,6 +369,52 @@ void ThreadService::reset_contention_time_stat(JavaThread* thread) {
   }
 }
 
+// Prints a thread and its stack into a buffer from within a handshake with
+// that thread, so the stack is consistent without a global safepoint.
+class PrintThreadHandshakeClosure : public HandshakeClosure {
+ private:
+  stringStream _buffer;
+  bool _print_extended_info;
+
+ public:
+  PrintThreadHandshakeClosure(bool print_extended_info) :
+    HandshakeClosure("PrintThread"),
+    _print_extended_info(print_extended_info) {}
+
+  void do_thread(Thread* th) {
+    JavaThread* jt = JavaThread::cast(th);
+    ResourceMark rm;
+    jt->print_on(&_buffer, _print_extended_info);
+    jt->print_stack_on(&_buffer);
+  }
+
+  const char* output() const { return _buffer.base(); }
+  size_t size() const        { return _buffer.size(); }
+};
+
+void ThreadService::print_threads_with_handshakes(outputStream* st, bool print_extended_info) {
+  char buf[32];
+  st->print_raw_cr(os::local_time_string(buf, sizeof(buf)));
+
+  st->print_cr("Full thread dump %s (%s %s), captured per thread:",
+               VM_Version::vm_name(),
+               VM_Version::vm_release(),
+               VM_Version::vm_info_string());
+  st->cr();
+
+  ThreadsListHandle tlh;
+  for (uint i = 0; i < tlh.length(); i++) {
+    PrintThreadHandshakeClosure cl(print_extended_info);
+    Handshake::execute(&cl, tlh.thread_at(i));
+    // Threads that have exited in the meantime are skipped.
+    if (cl.size() > 0) {
+      st->print_raw(cl.output(), cl.size());
+      st->cr();
+    }
+  }
+  st->flush();
+}
+
 // Find deadlocks involving raw monitors, object monitors and concurrent locks
 // if concurrent_locks is true.
 DeadlockCycle* ThreadService::find_deadlocks_at_safepoint(ThreadsList * t_list, bool concurrent_locks) {
@@ -432,8 +480,8 @@ DeadlockCycle* ThreadService::find_deadlocks_at_safepoint(ThreadsList * t_list,
       } else if (waitingToLockMonitor != NULL) {
         address currentOwner = (address)waitingToLockMonitor->owner();
         if (currentOwner != NULL) {
-          currentThread = Threads::owning_thread_from_monitor_owner(t_list,
-                                                                    currentOwner);
+          currentThread = Threads::owning_thread_from_monitor(t_list,
+                                                              waitingToLockMonitor);
           if (currentThread == NULL) {
             // This function is called at a safepoint so the JavaThread
             // that owns waitingToLockMonitor should be findable, but
@@ -1005,8 +1053,7 @@ void DeadlockCycle::print_on_with(ThreadsList * t_list, outputStream* st) const
       if (!currentThread->current_pending_monitor_is_from_java()) {
         owner_desc = "\n  in JNI, which is held by";
       }
-      currentThread = Threads::owning_thread_from_monitor_owner(t_list,
-                                                                (address)waitingToLockMonitor->owner());
+      currentThread = Threads::owning_thread_from_monitor(t_list, waitingToLockMonitor);
       if (currentThread == NULL) {
         // The deadlock was detected at a safepoint so the JavaThread
         // that owns waitingToLockMonitor should be findable, but
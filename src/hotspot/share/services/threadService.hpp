@@ -114,6 +114,10 @@ public:
 
   static DeadlockCycle*       find_deadlocks_at_safepoint(ThreadsList * t_list, bool object_monitors_only);
 
+  // Print all Java threads with their stacks, capturing each thread in a
+  // handshake of its own instead of stopping all threads at a safepoint.
+  static void   print_threads_with_handshakes(outputStream* st, bool print_extended_info);
+
   static void   metadata_do(void f(Metadata*));
 };
 
@@ -50,6 +50,7 @@ void VirtualMemorySummary::snapshot(VirtualMemorySnapshot* s) {
 }
 
 SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>* VirtualMemoryTracker::_reserved_regions;
+ReservedMemoryRegion* VirtualMemoryTracker::_last_found_region = NULL;
 
 int compare_committed_region(const CommittedMemoryRegion& r1, const CommittedMemoryRegion& r2) {
   return r1.compare(r2);
@@ -335,13 +336,30 @@ bool VirtualMemoryTracker::late_initialize(NMT_TrackingLevel level) {
   return true;
 }
 
+// Lookups are usually clustered: a reservation gets committed and
+// uncommitted piecewise, so first check the region found last, before
+// walking the reserved region list. Reserved regions are disjoint, so if
+// the cached region contains the range, it is the region the list walk
+// would return.
+ReservedMemoryRegion* VirtualMemoryTracker::find_reserved_region(const ReservedMemoryRegion& rgn) {
+  ReservedMemoryRegion* last = _last_found_region;
+  if (last != NULL && last->contain_region(rgn.base(), rgn.size())) {
+    return last;
+  }
+  ReservedMemoryRegion* found = _reserved_regions->find(rgn);
+  if (found != NULL) {
+    _last_found_region = found;
+  }
+  return found;
+}
+
 bool VirtualMemoryTracker::add_reserved_region(address base_addr, size_t size,
     const NativeCallStack& stack, MEMFLAGS flag) {
   assert(base_addr != NULL, "Invalid address");
   assert(size > 0, "Invalid size");
   assert(_reserved_regions != NULL, "Sanity check");
   ReservedMemoryRegion  rgn(base_addr, size, stack, flag);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  ReservedMemoryRegion* reserved_rgn = find_reserved_region(rgn);
 
   log_debug(nmt)("Add reserved region \'%s\' (" INTPTR_FORMAT ", " SIZE_FORMAT ")",
                 rgn.flag_name(), p2i(rgn.base()), rgn.size());
@@ -416,7 +434,7 @@ void VirtualMemoryTracker::set_reserved_region_type(address addr, MEMFLAGS flag)
   assert(_reserved_regions != NULL, "Sanity check");
 
   ReservedMemoryRegion   rgn(addr, 1);
-  ReservedMemoryRegion*  reserved_rgn = _reserved_regions->find(rgn);
+  ReservedMemoryRegion*  reserved_rgn = find_reserved_region(rgn);
   if (reserved_rgn != NULL) {
     assert(reserved_rgn->contain_address(addr), "Containment");
     if (reserved_rgn->flag() != flag) {
@@ -434,7 +452,7 @@ bool VirtualMemoryTracker::add_committed_region(address addr, size_t size,
   assert(_reserved_regions != NULL, "Sanity check");
 
   ReservedMemoryRegion  rgn(addr, size);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  ReservedMemoryRegion* reserved_rgn = find_reserved_region(rgn);
 
   if (reserved_rgn == NULL) {
     log_debug(nmt)("Add committed region \'%s\', No reserved region found for  (" INTPTR_FORMAT ", " SIZE_FORMAT ")",
@@ -454,7 +472,7 @@ bool VirtualMemoryTracker::remove_uncommitted_region(address addr, size_t size)
   assert(_reserved_regions != NULL, "Sanity check");
 
   ReservedMemoryRegion  rgn(addr, size);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  ReservedMemoryRegion* reserved_rgn = find_reserved_region(rgn);
   assert(reserved_rgn != NULL, "No reserved region (" INTPTR_FORMAT ", " SIZE_FORMAT ")", p2i(addr), size);
   assert(reserved_rgn->contain_region(addr, size), "Not completely contained");
   const char* flag_name = reserved_rgn->flag_name();  // after remove, info is not complete
@@ -478,6 +496,8 @@ bool VirtualMemoryTracker::remove_released_region(ReservedMemoryRegion* rgn) {
   }
 
   VirtualMemorySummary::record_released_memory(rgn->size(), rgn->flag());
+  // The list node holding rgn is about to be freed
+  _last_found_region = NULL;
   result =  _reserved_regions->remove(*rgn);
   log_debug(nmt)("Removed region \'%s\' (" INTPTR_FORMAT ", " SIZE_FORMAT ") from _resvered_regions %s" ,
                 backup.flag_name(), p2i(backup.base()), backup.size(), (result ? "Succeeded" : "Failed"));
@@ -490,7 +510,7 @@ bool VirtualMemoryTracker::remove_released_region(address addr, size_t size) {
   assert(_reserved_regions != NULL, "Sanity check");
 
   ReservedMemoryRegion  rgn(addr, size);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  ReservedMemoryRegion* reserved_rgn = find_reserved_region(rgn);
 
   if (reserved_rgn == NULL) {
     log_debug(nmt)("No reserved region found for (" INTPTR_FORMAT ", " SIZE_FORMAT ")!",
@@ -519,7 +539,7 @@ bool VirtualMemoryTracker::remove_released_region(address addr, size_t size) {
       // so we release them altogether.
       ReservedMemoryRegion class_rgn(addr + reserved_rgn->size(),
                                      (size - reserved_rgn->size()));
-      ReservedMemoryRegion* cls_rgn = _reserved_regions->find(class_rgn);
+      ReservedMemoryRegion* cls_rgn = find_reserved_region(class_rgn);
       assert(cls_rgn != NULL, "Class space region  not recorded?");
       assert(cls_rgn->flag() == mtClass, "Must be class type");
       remove_released_region(reserved_rgn);
@@ -559,7 +579,7 @@ bool VirtualMemoryTracker::remove_released_region(address addr, size_t size) {
 bool VirtualMemoryTracker::split_reserved_region(address addr, size_t size, size_t split) {
 
   ReservedMemoryRegion  rgn(addr, size);
-  ReservedMemoryRegion* reserved_rgn = _reserved_regions->find(rgn);
+  ReservedMemoryRegion* reserved_rgn = find_reserved_region(rgn);
   assert(reserved_rgn->same_region(addr, size), "Must be identical region");
   assert(reserved_rgn != NULL, "No reserved region");
   assert(reserved_rgn->committed_size() == 0, "Splitting committed region?");
@@ -688,6 +708,7 @@ bool VirtualMemoryTracker::transition(NMT_TrackingLevel from, NMT_TrackingLevel
     if (_reserved_regions != NULL) {
       delete _reserved_regions;
       _reserved_regions = NULL;
+      _last_found_region = NULL;
     }
   }
 
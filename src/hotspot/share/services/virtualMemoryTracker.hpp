@@ -396,7 +396,12 @@ class VirtualMemoryTracker : AllStatic {
   static void snapshot_thread_stacks();
 
  private:
+  // Find the reserved region overlapping rgn
+  static ReservedMemoryRegion* find_reserved_region(const ReservedMemoryRegion& rgn);
+
   static SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>* _reserved_regions;
+  // Cache of the last region found by find_reserved_region()
+  static ReservedMemoryRegion* _last_found_region;
 };
 
 #endif // INCLUDE_NMT
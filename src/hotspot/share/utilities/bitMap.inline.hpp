@@ -212,6 +212,16 @@ inline BitMap::idx_t BitMap::get_next_bit_impl(idx_t l_index, idx_t r_index) con
       idx_t limit = aligned_right
         ? to_words_align_down(r_index) // Miniscule savings when aligned.
         : to_words_align_up(r_index);
+      // Sparse maps, such as mark bitmaps of mostly dead regions, have long
+      // runs of uninteresting words.  Skip those four words at a time with a
+      // single combined test before looking at individual words.
+      while (index + 4 < limit) {
+        if (((map(index + 1) ^ flip) | (map(index + 2) ^ flip) |
+             (map(index + 3) ^ flip) | (map(index + 4) ^ flip)) != 0) {
+          break;
+        }
+        index += 4;
+      }
       while (++index < limit) {
         cword = map(index) ^ flip;
         if (cword != 0) {
@@ -100,6 +100,19 @@ class ConcurrentHashTable<CONFIG, F>::BucketsOperation {
   }
 
 public:
+  // Index of the next range to be claimed. A single threaded operation that
+  // is stopped early can record this and pass it to resume_at() later.
+  size_t next_task() const {
+    return MIN2(Atomic::load(&_next_to_claim), _stop_task);
+  }
+
+  // Skips the ranges before task, must be called after prepare. Ranges skipped
+  // this way are not visited by this operation.
+  void resume_at(size_t task) {
+    assert(!_is_mt, "Only for single threaded operations");
+    Atomic::store(&_next_to_claim, MIN2(task, _stop_task));
+  }
+
   // Pauses for safepoint
   void pause(Thread* thread) {
     // This leaves internal state locked.
@@ -29,9 +29,11 @@
 #include "memory/allocation.inline.hpp"
 #include "utilities/elfFuncDescTable.hpp"
 #include "utilities/elfSymbolTable.hpp"
+#include "utilities/quickSort.hpp"
 
 ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
-  _next(NULL), _fd(file), _section(file, shdr) {
+  _next(NULL), _fd(file), _section(file, shdr),
+  _index(NULL), _index_length(0), _index_built(false) {
   assert(file != NULL, "null file handle");
   _status = _section.status();
 
@@ -41,22 +43,27 @@ ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
 }
 
 ElfSymbolTable::~ElfSymbolTable() {
+  if (_index != NULL) {
+    FREE_C_HEAP_ARRAY(IndexEntry, _index);
+  }
   if (_next != NULL) {
     delete _next;
   }
 }
 
+static address symbol_address(const Elf_Sym* sym, ElfFuncDescTable* funcDescTable) {
+  if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
+    // We need to go another step trough the function descriptor table (currently PPC64 only)
+    return funcDescTable->lookup(sym->st_value);
+  }
+  return (address)sym->st_value;
+}
+
 bool ElfSymbolTable::compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
   if (STT_FUNC == ELF_ST_TYPE(sym->st_info)) {
     Elf_Word st_size = sym->st_size;
     const Elf_Shdr* shdr = _section.section_header();
-    address sym_addr;
-    if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
-      // We need to go another step trough the function descriptor table (currently PPC64 only)
-      sym_addr = funcDescTable->lookup(sym->st_value);
-    } else {
-      sym_addr = (address)sym->st_value;
-    }
+    address sym_addr = symbol_address(sym, funcDescTable);
     if (sym_addr <= addr && (Elf_Word)(addr - sym_addr) < st_size) {
       *offset = (int)(addr - sym_addr);
       *posIndex = sym->st_name;
@@ -67,6 +74,87 @@ bool ElfSymbolTable::compare(const Elf_Sym* sym, address addr, int* stringtableI
   return false;
 }
 
+int ElfSymbolTable::compare_index_entries(const IndexEntry& a, const IndexEntry& b) {
+  if (a._start != b._start) {
+    return a._start < b._start ? -1 : 1;
+  }
+  return a._sym_index - b._sym_index;
+}
+
+void ElfSymbolTable::build_index(const Elf_Sym* symbols, int count, ElfFuncDescTable* funcDescTable) {
+  assert(!_index_built, "only once");
+  _index_built = true;
+
+  int length = 0;
+  for (int index = 0; index < count; index ++) {
+    if (STT_FUNC == ELF_ST_TYPE(symbols[index].st_info) && symbols[index].st_size > 0) {
+      length ++;
+    }
+  }
+  if (length == 0) {
+    return;
+  }
+
+  // Fall back to the linear scan if the index does not fit in memory.
+  IndexEntry* entries = NEW_C_HEAP_ARRAY_RETURN_NULL(IndexEntry, length, mtInternal);
+  if (entries == NULL) {
+    return;
+  }
+
+  int pos = 0;
+  for (int index = 0; index < count; index ++) {
+    const Elf_Sym* sym = &symbols[index];
+    if (STT_FUNC == ELF_ST_TYPE(sym->st_info) && sym->st_size > 0) {
+      entries[pos]._start = symbol_address(sym, funcDescTable);
+      entries[pos]._sym_index = index;
+      pos ++;
+    }
+  }
+  QuickSort::sort(entries, length, compare_index_entries, true);
+
+  address max_end = NULL;
+  for (int i = 0; i < length; i++) {
+    address end = entries[i]._start + symbols[entries[i]._sym_index].st_size;
+    max_end = MAX2(max_end, end);
+    entries[i]._max_end = max_end;
+  }
+
+  _index = entries;
+  _index_length = length;
+}
+
+bool ElfSymbolTable::lookup_in_index(const Elf_Sym* symbols, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
+  // Find the last entry starting at or below addr.
+  int lo = 0;
+  int hi = _index_length - 1;
+  int last = -1;
+  while (lo <= hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (_index[mid]._start <= addr) {
+      last = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  // Symbols may overlap. Like the linear scan, report the matching symbol
+  // that comes first in the section. Entries before one whose _max_end is
+  // at or below addr cannot match.
+  int found = -1;
+  for (int i = last; i >= 0 && _index[i]._max_end > addr; i--) {
+    const Elf_Sym* sym = &symbols[_index[i]._sym_index];
+    if ((Elf_Word)(addr - _index[i]._start) < sym->st_size &&
+        (found == -1 || _index[i]._sym_index < found)) {
+      found = _index[i]._sym_index;
+    }
+  }
+  if (found == -1) {
+    return false;
+  }
+  return compare(&symbols[found], addr, stringtableIndex, posIndex, offset, funcDescTable);
+}
+
 bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
   assert(stringtableIndex, "null string table index pointer");
   assert(posIndex, "null string table offset pointer");
@@ -81,6 +169,12 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   Elf_Sym* symbols = (Elf_Sym*)_section.section_data();
 
   if (symbols != NULL) {
+    if (!_index_built) {
+      build_index(symbols, count, funcDescTable);
+    }
+    if (_index != NULL) {
+      return lookup_in_index(symbols, addr, stringtableIndex, posIndex, offset, funcDescTable);
+    }
     for (int index = 0; index < count; index ++) {
       if (compare(&symbols[index], addr, stringtableIndex, posIndex, offset, funcDescTable)) {
         return true;
@@ -37,6 +37,10 @@
  * Whenever possible, it will load all symbols from the corresponding section
  * of the elf file into memory. Otherwise, it will walk the section in file
  * to look up the symbol that nearest the given address.
+ *
+ * When the symbols are in memory, the first lookup also builds an index of
+ * the function symbols sorted by address, so that lookups are binary searches
+ * instead of linear scans of the section.
  */
 class ElfSymbolTable: public CHeapObj<mtInternal> {
   friend class ElfFile;
@@ -50,6 +54,22 @@ private:
   ElfSection      _section;
 
   NullDecoder::decoder_status _status;
+
+  // Function symbol in the address index.
+  struct IndexEntry {
+    address _start;
+    address _max_end;   // highest end address among this and all preceding entries
+    int     _sym_index; // position in the symbol section
+  };
+
+  IndexEntry*      _index;
+  int              _index_length;
+  bool             _index_built;
+
+  static int compare_index_entries(const IndexEntry& a, const IndexEntry& b);
+  void build_index(const Elf_Sym* symbols, int count, ElfFuncDescTable* funcDescTable);
+  bool lookup_in_index(const Elf_Sym* symbols, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable);
+
 public:
   ElfSymbolTable(FILE* const file, Elf_Shdr& shdr);
   ~ElfSymbolTable();
@@ -127,24 +127,21 @@ void UnloadingEventLog::log(Thread* thread, InstanceKlass* ik) {
   if (!should_log()) return;
 
   double timestamp = fetch_timestamp();
-  // Unloading events are single threaded.
-  int index = compute_log_index();
-  _records[index].thread = thread;
-  _records[index].timestamp = timestamp;
+  int index = begin_record(thread, timestamp);
+  if (index < 0) return;
   stringStream st(_records[index].data.buffer(),
                   _records[index].data.size());
   st.print("Unloading class " INTPTR_FORMAT " ", p2i(ik));
   ik->name()->print_value_on(&st);
+  end_record(index);
 }
 
 void ExceptionsEventLog::log(Thread* thread, Handle h_exception, const char* message, const char* file, int line) {
   if (!should_log()) return;
 
   double timestamp = fetch_timestamp();
-  MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
-  int index = compute_log_index();
-  _records[index].thread = thread;
-  _records[index].timestamp = timestamp;
+  int index = begin_record(thread, timestamp);
+  if (index < 0) return;
   stringStream st(_records[index].data.buffer(),
                   _records[index].data.size());
   st.print("Exception <");
@@ -153,4 +150,5 @@ void ExceptionsEventLog::log(Thread* thread, Handle h_exception, const char* mes
            "thrown [%s, line %d]",
            message ? ": " : "", message ? message : "",
            p2i(h_exception()), file, line);
+  end_record(index);
 }
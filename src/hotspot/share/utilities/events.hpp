@@ -26,6 +26,7 @@
 #define SHARE_UTILITIES_EVENTS_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/formatBuffer.hpp"
@@ -78,34 +79,49 @@ class EventLog : public CHeapObj<mtInternal> {
 // providing a more featureful log function if the existing copy
 // semantics aren't appropriate.  The name is used as the label of the
 // log when it is dumped during a crash.
+//
+// The ring buffer is lock-free.  Every event takes the next sequence
+// number and owns the slot at that sequence number modulo the length
+// while it fills it in.  Each slot carries the state of its latest
+// event so that printing only shows completed events.  An event whose
+// slot is still busy, being written or printed, is dropped.
+//
+// Sequence numbers and slot states are word sized and wrap around, so
+// they are only ever compared through their signed difference.
 template <class T> class EventLogBase : public EventLog {
   template <class X> class EventRecord : public CHeapObj<mtInternal> {
    public:
+    // 0 if the slot was never used, 2 * seq + 2 once the event with
+    // sequence number seq is complete, and odd while the slot is busy,
+    // all modulo the word size.
+    volatile uintx state;
     double  timestamp;
     Thread* thread;
     X       data;
+
+    EventRecord() : state(0) {}
   };
 
  protected:
-  Mutex           _mutex;
   // Name is printed out as a header.
-  const char*     _name;
+  const char*       _name;
   // Handle is a short specifier used to select this particular event log
   // for printing (see VM.events command).
-  const char*     _handle;
-  int             _length;
-  int             _index;
-  int             _count;
-  EventRecord<T>* _records;
+  const char*       _handle;
+  int               _length;
+  volatile uintx    _next_seq;
+  // Set once the ring buffer has been filled, after which every slot
+  // holds an event even if _next_seq has wrapped around.
+  volatile bool     _full;
+  EventRecord<T>*   _records;
 
  public:
   EventLogBase<T>(const char* name, const char* handle, int length = LogEventsBufferEntries):
-    _mutex(Mutex::event, name, true, Mutex::_safepoint_check_never),
     _name(name),
     _handle(handle),
     _length(length),
-    _index(0),
-    _count(0) {
+    _next_seq(0),
+    _full(false) {
     _records = new EventRecord<T>[length];
   }
 
@@ -113,17 +129,38 @@ template <class T> class EventLogBase : public EventLog {
     return os::elapsedTime();
   }
 
-  // move the ring buffer to next open slot and return the index of
-  // the slot to use for the current message.  Should only be called
-  // while mutex is held.
-  int compute_log_index() {
-    int index = _index;
-    if (_count < _length) _count++;
-    _index++;
-    if (_index >= _length) _index = 0;
+  // Claim the ring buffer slot for the next event and fill in its thread
+  // and timestamp.  Returns the index of the slot, or -1 if the event has
+  // to be dropped because the slot is busy.  A successful claim must be
+  // completed with end_record() once the data has been written.
+  int begin_record(Thread* thread, double timestamp) {
+    uintx seq = Atomic::fetch_and_add(&_next_seq, (uintx)1);
+    if (seq == (uintx)_length - 1) {
+      // The slots for sequence numbers 0 to _length - 1 have all been
+      // claimed.
+      Atomic::store(&_full, true);
+    }
+    int index = (int)(seq % (uintx)_length);
+    EventRecord<T>* r = &_records[index];
+    uintx busy = 2 * seq + 1;
+    uintx old_state = Atomic::load(&r->state);
+    // Drop the event if the slot is busy, or if a writer that lapped us
+    // already claimed it for a later sequence number.
+    if ((old_state & 1) != 0 || (intx)(old_state - busy) > 0 ||
+        Atomic::cmpxchg(&r->state, old_state, busy) != old_state) {
+      return -1;
+    }
+    r->thread = thread;
+    r->timestamp = timestamp;
     return index;
   }
 
+  // Publish the event in the slot claimed by begin_record().
+  void end_record(int index) {
+    EventRecord<T>* r = &_records[index];
+    Atomic::release_store(&r->state, r->state + 1);
+  }
+
   bool should_log() {
     // Don't bother adding new entries when we're crashing.  This also
     // avoids mutating the ring buffer when printing the log.
@@ -140,8 +177,6 @@ template <class T> class EventLogBase : public EventLog {
   void print_names(outputStream* out) const;
 
  private:
-  void print_log_impl(outputStream* out, int max = -1);
-
   // Print a single element.  A templated implementation might need to
   // be declared by subclasses.
   void print(outputStream* out, T& e);
@@ -173,11 +208,10 @@ class FormatStringEventLog : public EventLogBase< FormatStringLogMessage<bufsz>
     if (!this->should_log()) return;
 
     double timestamp = this->fetch_timestamp();
-    MutexLocker ml(&this->_mutex, Mutex::_no_safepoint_check_flag);
-    int index = this->compute_log_index();
-    this->_records[index].thread = thread;
-    this->_records[index].timestamp = timestamp;
+    int index = this->begin_record(thread, timestamp);
+    if (index < 0) return;
     this->_records[index].data.printv(format, ap);
+    this->end_record(index);
   }
 
   void log(Thread* thread, const char* format, ...) ATTRIBUTE_PRINTF(3, 4) {
@@ -323,43 +357,6 @@ inline void Events::log_deopt_message(Thread* thread, const char* format, ...) {
   }
 }
 
-template <class T>
-inline void EventLogBase<T>::print_log_on(outputStream* out, int max) {
-  struct MaybeLocker {
-    Mutex* const _mutex;
-    bool         _proceed;
-    bool         _locked;
-
-    MaybeLocker(Mutex* mutex) : _mutex(mutex), _proceed(false), _locked(false) {
-      if (Thread::current_or_null() == NULL) {
-        _proceed = true;
-      } else if (VMError::is_error_reported()) {
-        if (_mutex->try_lock_without_rank_check()) {
-          _proceed = _locked = true;
-        }
-      } else {
-        _mutex->lock_without_safepoint_check();
-        _proceed = _locked = true;
-      }
-    }
-    ~MaybeLocker() {
-      if (_locked) {
-        _mutex->unlock();
-      }
-    }
-  };
-
-  MaybeLocker ml(&_mutex);
-
-  if (ml._proceed) {
-    print_log_impl(out, max);
-  } else {
-    out->print_cr("%s (%d events):", _name, _count);
-    out->print_cr("No events printed - crash while holding lock");
-    out->cr();
-  }
-}
-
 template <class T>
 inline bool EventLogBase<T>::matches_name_or_handle(const char* s) const {
   return ::strcasecmp(s, _name) == 0 ||
@@ -371,40 +368,35 @@ inline void EventLogBase<T>::print_names(outputStream* out) const {
   out->print("\"%s\" : %s", _handle, _name);
 }
 
-// Dump the ring buffer entries that current have entries.
+// Dump the ring buffer entries that currently hold completed events, oldest first.
 template <class T>
-inline void EventLogBase<T>::print_log_impl(outputStream* out, int max) {
-  out->print_cr("%s (%d events):", _name, _count);
-  if (_count == 0) {
+inline void EventLogBase<T>::print_log_on(outputStream* out, int max) {
+  uintx end = Atomic::load_acquire(&_next_seq);
+  int count = Atomic::load(&_full) ? _length : (int)MIN2(end, (uintx)_length);
+  out->print_cr("%s (%d events):", _name, count);
+  if (count == 0) {
     out->print_cr("No events");
     out->cr();
     return;
   }
 
   int printed = 0;
-  if (_count < _length) {
-    for (int i = 0; i < _count; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
-    }
-  } else {
-    for (int i = _index; i < _length; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+  for (int i = 0; i < count; i++) {
+    if (max > 0 && printed == max) {
+      break;
     }
-    for (int i = 0; i < _index; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+    uintx seq = end - count + i;
+    EventRecord<T>* r = &_records[seq % (uintx)_length];
+    uintx done = 2 * seq + 2;
+    // Hold the slot while printing it so that a racing writer drops its
+    // event instead of overwriting this one. Skip the slot if its event
+    // is still being written or has already been replaced.
+    if (Atomic::cmpxchg(&r->state, done, done - 1) != done) {
+      continue;
     }
+    print(out, *r);
+    Atomic::release_store(&r->state, done);
+    printed ++;
   }
 
   if (printed == max) {
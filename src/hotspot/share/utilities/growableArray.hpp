@@ -748,6 +748,50 @@ public:
   }
 };
 
+// GrowableArray with room for N elements embedded in the instance.
+//
+// The data array only moves to the resource area, or to the arena given at
+// construction, once more than N elements are needed. Intended for short-lived
+// stack-allocated arrays on hot paths that almost always stay tiny, where it
+// saves the allocation and keeps the elements next to the array header.
+//
+// Spilled data arrays are never freed explicitly; they are reclaimed together
+// with their resource area or arena.
+template <typename E, int N>
+class GrowableArrayInline : public GrowableArrayWithAllocator<E, GrowableArrayInline<E, N> > {
+  friend class GrowableArrayWithAllocator<E, GrowableArrayInline<E, N> >;
+
+  STATIC_ASSERT(N > 0);
+  STATIC_ASSERT(alignof(E) <= alignof(jlong));
+
+  Arena* const _arena;
+  jlong _inline_data[(N * sizeof(E) + sizeof(jlong) - 1) / sizeof(jlong)];
+
+  NONCOPYABLE(GrowableArrayInline);
+
+  // The data pointers would end up referring to the other instance's storage.
+  void swap(GrowableArrayInline<E, N>* other);
+
+  E* allocate() {
+    if (_arena != NULL) {
+      return (E*)GrowableArrayArenaAllocator::allocate(this->_max, sizeof(E), _arena);
+    }
+    return (E*)GrowableArrayResourceAllocator::allocate(this->_max, sizeof(E));
+  }
+
+  void deallocate(E* mem) {}
+
+public:
+  GrowableArrayInline(Arena* arena = NULL) :
+      GrowableArrayWithAllocator<E, GrowableArrayInline<E, N> >(
+          reinterpret_cast<E*>(_inline_data), N),
+      _arena(arena) {}
+
+  bool is_inline() const {
+    return this->_data == reinterpret_cast<const E*>(_inline_data);
+  }
+};
+
 // Custom STL-style iterator to iterate over GrowableArrays
 // It is constructed by invoking GrowableArray::begin() and GrowableArray::end()
 template <typename E>
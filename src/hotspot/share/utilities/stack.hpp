@@ -194,6 +194,10 @@ public:
   E  next() { return *next_addr(); }
   E* next_addr();
 
+  // Return the remaining elements of the current segment as an array and
+  // set count to their number, then move on to the next segment.
+  E* next_segment(size_t& count);
+
   void sync(); // Sync the iterator's state to the stack's current state.
 
 private:
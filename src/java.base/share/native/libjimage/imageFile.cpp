@@ -158,40 +158,45 @@ ImageModuleData::~ImageModuleData() {
 
 // Return the module in which a package resides.    Returns NULL if not found.
 const char* ImageModuleData::package_to_module(const char* package_name) {
-    // replace all '/' by '.'
-    char* replaced = new char[(int) strlen(package_name) + 1];
-    assert(replaced != NULL && "allocation failed");
-    int i;
-    for (i = 0; package_name[i] != '\0'; i++) {
-      replaced[i] = package_name[i] == '/' ? '.' : package_name[i];
-    }
-    replaced[i] = '\0';
-
-    // build path /packages/<package_name>
+    // build path /packages/<package_name> with all '/' replaced by '.'
     const char* radical = "/packages/";
-    char* path = new char[(int) strlen(radical) + (int) strlen(package_name) + 1];
-    assert(path != NULL && "allocation failed");
-    strcpy(path, radical);
-    strcat(path, replaced);
-    delete[] replaced;
+    size_t radical_length = strlen(radical);
+    size_t package_length = strlen(package_name);
+    char path_buffer[PATH_BUFFER_SIZE];
+    char* path = path_buffer;
+    if (radical_length + package_length + 1 > sizeof(path_buffer)) {
+        path = new char[radical_length + package_length + 1];
+        assert(path != NULL && "allocation failed");
+    }
+    memcpy(path, radical, radical_length);
+    for (size_t i = 0; i <= package_length; i++) {
+        char ch = package_name[i];
+        path[radical_length + i] = ch == '/' ? '.' : ch;
+    }
 
     // retrieve package location
     ImageLocation location;
     bool found = _image_file->find_location(path, location);
-    delete[] path;
+    if (path != path_buffer) {
+        delete[] path;
+    }
     if (!found) {
         return NULL;
     }
 
     // retrieve offsets to module name
     int size = (int)location.get_attribute(ImageLocation::ATTRIBUTE_UNCOMPRESSED);
-    u1* content = new u1[size];
-    assert(content != NULL && "allocation failed");
+    u4 content_buffer[CONTENT_BUFFER_WORDS];
+    u1* content = (u1*)content_buffer;
+    if (size > (int)sizeof(content_buffer)) {
+        content = new u1[size];
+        assert(content != NULL && "allocation failed");
+    }
     _image_file->get_resource(location, content);
     u1* ptr = content;
     // sequence of sizeof(8) isEmpty|offset. Use the first module that is not empty.
     u4 offset = 0;
-    for (i = 0; i < size; i+=8) {
+    for (int i = 0; i < size; i+=8) {
         u4 isEmpty = _endian->get(*((u4*)ptr));
         ptr += 4;
         if (!isEmpty) {
@@ -200,7 +205,9 @@ const char* ImageModuleData::package_to_module(const char* package_name) {
         }
         ptr += 4;
     }
-    delete[] content;
+    if (content != (u1*)content_buffer) {
+        delete[] content;
+    }
     return _image_file->get_strings().get(offset);
 }
 
@@ -565,6 +572,67 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
     }
 }
 
+// Resource ranges closer than this are advised as one range. Reading the
+// bytes in between costs less than another request.
+static const u8 prefetch_gap = 64 * 1024;
+
+// A range of image file bytes, for prefetch_resources.
+struct ImageFileRange {
+    u8 _start;
+    u8 _end;
+};
+
+static int compare_ranges(const void* a, const void* b) {
+    u8 start_a = ((const ImageFileRange*) a)->_start;
+    u8 start_b = ((const ImageFileRange*) b)->_start;
+    return start_a < start_b ? -1 : (start_a > start_b ? 1 : 0);
+}
+
+// Advise the system that the resources for the supplied location offsets
+// will be read soon. Zero offsets (not found) are skipped. The file ranges
+// are sorted and ranges less than prefetch_gap apart are merged, so that
+// each merged range is a single hint. Returns the number of hints given.
+s4 ImageFileReader::prefetch_resources(const s8* offsets, s4 count) const {
+    if (count <= 0) {
+        return 0;
+    }
+    ImageFileRange* ranges = new ImageFileRange[count];
+    s4 n = 0;
+    for (s4 i = 0; i < count; i++) {
+        if (offsets[i] == 0) {
+            continue;
+        }
+        ImageLocation location(get_location_offset_data((u4) offsets[i]));
+        u8 size = location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED);
+        if (size == 0) {
+            size = location.get_attribute(ImageLocation::ATTRIBUTE_UNCOMPRESSED);
+        }
+        if (size != 0) {
+            ranges[n]._start = _index_size + location.get_attribute(ImageLocation::ATTRIBUTE_OFFSET);
+            ranges[n]._end = ranges[n]._start + size;
+            n++;
+        }
+    }
+    qsort(ranges, (size_t) n, sizeof(ImageFileRange), compare_ranges);
+    s4 hints = 0;
+    s4 i = 0;
+    while (i < n) {
+        u8 start = ranges[i]._start;
+        u8 end = ranges[i]._end;
+        for (i++; i < n && ranges[i]._start <= end + prefetch_gap; i++) {
+            if (ranges[i]._end > end) {
+                end = ranges[i]._end;
+            }
+        }
+        // Resources are only memory mapped if the whole image is.
+        void* address = memory_map_image ? _index_data + start : NULL;
+        osSupport::prefetch(_fd, address, (size_t) start, (size_t) (end - start));
+        hints++;
+    }
+    delete[] ranges;
+    return hints;
+}
+
 // Return the ImageModuleData for this image
 ImageModuleData * ImageFileReader::get_image_module_data() {
     return _module_data;
@@ -305,6 +305,10 @@ public:
 //
 // Manage the image module meta data.
 class ImageModuleData {
+    // Stack buffer sizes used to avoid allocating in the common case.
+    static const int PATH_BUFFER_SIZE = 256;   // "/packages/<package>" path
+    static const int CONTENT_BUFFER_WORDS = 64; // package resource content
+
     const ImageFileReader* _image_file; // Source image file
     Endian* _endian;                    // Endian handler
 
@@ -578,6 +582,10 @@ public:
     // Return the resource for the supplied path.
     void get_resource(ImageLocation& location, u1* uncompressed_data) const;
 
+    // Advise the system that the resources for the supplied location
+    // offsets will be read soon. Returns the number of hints given.
+    s4 prefetch_resources(const s8* offsets, s4 count) const;
+
     // Return the ImageModuleData for this image
     ImageModuleData * get_image_module_data();
 
@@ -162,6 +162,26 @@ JIMAGE_GetResource(JImageFile* image, JImageLocationRef location,
     return size;
 }
 
+/*
+ * JImagePrefetchResources - Given an open image file (see JImageOpen) and an
+ * array of resource locations (see JImageFindResource), advise the system that
+ * the bytes of those resources will be read soon. Locations that were not
+ * found are skipped. Resources that are close together in the image are
+ * advised as one range. This is only a hint; it does not block on I/O and
+ * does not decompress anything. Returns the number of ranges advised.
+ *
+ * Ex.
+ *  JImageLocationRef locations[2];
+ *  locations[0] = (*JImageFindResource)(image, "java.base", "9.0", "java/lang/String.class", &size);
+ *  locations[1] = (*JImageFindResource)(image, "java.base", "9.0", "java/lang/Object.class", &size);
+ *  (*JImagePrefetchResources)(image, locations, 2);
+ */
+extern "C" JNIEXPORT jint
+JIMAGE_PrefetchResources(JImageFile* image, const JImageLocationRef* locations,
+        jint count) {
+    return ((ImageFileReader*) image)->prefetch_resources((const s8*) locations, count);
+}
+
 /*
  * JImageResourceIterator - Given an open image file (see JImageOpen), a visitor
  * function and a visitor argument, iterator through each of the image's resources.
@@ -71,6 +71,12 @@ public:
      * Unmap nBytes of memory at address.
      */
     static int unmap_memory(void* addr, size_t bytes);
+
+    /**
+     * Advise the system that nBytes at file_offset will be needed soon.
+     * If addr is not NULL it is the mapped address of file_offset.
+     */
+    static void prefetch(jint fd, void* addr, size_t file_offset, size_t bytes);
 };
 
 /**
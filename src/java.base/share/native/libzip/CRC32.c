@@ -33,6 +33,165 @@
 
 #include "java_util_zip_CRC32.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define USE_CLMUL_CRC32 1
+#include <cpuid.h>
+#include <immintrin.h>
+#include <stdint.h>
+#endif
+
+#ifdef USE_CLMUL_CRC32
+
+/*
+ * clmulCRC32 is derived from crc32_sse42_simd_ in Chromium's copy of zlib
+ * (third_party/zlib/crc32_simd.c), whose license is reproduced in
+ * legal/chromium-zlib.md. The original version carried this notice:
+ *
+ * Copyright 2017 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the Chromium source repository LICENSE file.
+ */
+
+/* Inputs shorter than this are left to zlib's table driven crc32 */
+#define CLMUL_CRC32_MIN_LENGTH 64
+
+static int clmul_crc32_supported = -1;
+
+static int
+clmulCRC32Supported()
+{
+    if (clmul_crc32_supported < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        int supported = 0;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            supported = (ecx & bit_PCLMUL) != 0 && (ecx & bit_SSE4_1) != 0;
+        }
+        clmul_crc32_supported = supported;
+    }
+    return clmul_crc32_supported;
+}
+
+/*
+ * Computes the CRC-32 of len bytes at buf, where len is at least 64 and a
+ * multiple of 16, by folding four 128-bit lanes with carry-less multiplies
+ * and finishing with a Barrett reduction. The crc argument and result are
+ * the raw (non-inverted) register values. The constants are the bit-reflected
+ * folding constants for the gzip polynomial from "Fast CRC Computation for
+ * Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009).
+ */
+__attribute__((target("sse4.1,pclmul")))
+static uint32_t
+clmulCRC32(uint32_t crc, const unsigned char *buf, size_t len)
+{
+    static const uint64_t k1k2[] __attribute__((aligned(16))) =
+        { 0x0154442bd4, 0x01c6e41596 };
+    static const uint64_t k3k4[] __attribute__((aligned(16))) =
+        { 0x01751997d0, 0x00ccaa009e };
+    static const uint64_t k5k0[] __attribute__((aligned(16))) =
+        { 0x0163cd6124, 0x0000000000 };
+    static const uint64_t poly[] __attribute__((aligned(16))) =
+        { 0x01db710641, 0x01f7011641 };
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    x0 = _mm_load_si128((const __m128i *)k1k2);
+    buf += 64;
+    len -= 64;
+
+    /* Fold four lanes 64 bytes at a time */
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+        y6 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+        y7 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+        y8 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+        buf += 64;
+        len -= 64;
+    }
+
+    /* Fold the four lanes into one */
+    x0 = _mm_load_si128((const __m128i *)k3k4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold the remaining 16 byte blocks */
+    while (len >= 16) {
+        x2 = _mm_loadu_si128((const __m128i *)buf);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        buf += 16;
+        len -= 16;
+    }
+
+    /* Fold 128 bits to 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduce to 32 bits */
+    x0 = _mm_load_si128((const __m128i *)poly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+#endif /* USE_CLMUL_CRC32 */
+
+/*
+ * Updates crc with len bytes at buf, using carry-less multiplication for
+ * the bulk of large inputs where the CPU supports it.
+ */
+static jint
+updateCRC32(jint crc, const Bytef *buf, jint len)
+{
+#ifdef USE_CLMUL_CRC32
+    if (len >= CLMUL_CRC32_MIN_LENGTH && clmulCRC32Supported()) {
+        size_t chunk = (size_t)len & ~(size_t)15;
+        crc = (jint)~clmulCRC32(~(uint32_t)crc, buf, chunk);
+        buf += chunk;
+        len -= (jint)chunk;
+        if (len == 0) {
+            return crc;
+        }
+    }
+#endif
+    return crc32(crc, buf, len);
+}
+
 JNIEXPORT jint JNICALL
 Java_java_util_zip_CRC32_update(JNIEnv *env, jclass cls, jint crc, jint b)
 {
@@ -48,7 +207,7 @@ Java_java_util_zip_CRC32_updateBytes0(JNIEnv *env, jclass cls, jint crc,
 {
     Bytef *buf = (*env)->GetPrimitiveArrayCritical(env, b, 0);
     if (buf) {
-        crc = crc32(crc, buf + off, len);
+        crc = updateCRC32(crc, buf + off, len);
         (*env)->ReleasePrimitiveArrayCritical(env, b, buf, 0);
     }
     return crc;
@@ -57,7 +216,7 @@ Java_java_util_zip_CRC32_updateBytes0(JNIEnv *env, jclass cls, jint crc,
 JNIEXPORT jint
 ZIP_CRC32(jint crc, const jbyte *buf, jint len)
 {
-    return crc32(crc, (Bytef*)buf, len);
+    return updateCRC32(crc, (Bytef*)buf, len);
 }
 
 JNIEXPORT jint JNICALL
@@ -66,7 +225,7 @@ Java_java_util_zip_CRC32_updateByteBuffer0(JNIEnv *env, jclass cls, jint crc,
 {
     Bytef *buf = (Bytef *)jlong_to_ptr(address);
     if (buf) {
-        crc = crc32(crc, buf + off, len);
+        crc = updateCRC32(crc, buf + off, len);
     }
     return crc;
 }
@@ -454,6 +454,31 @@ hash_append(unsigned int hash, char c)
     return ((int)hash)*31 + c;
 }
 
+/*
+ * Returns the number of hash chain heads for a zip file with the
+ * specified number of entries: about two entries per chain as before,
+ * rounded up to a power of two so that heads can be found by masking
+ * instead of dividing.
+ */
+static jint
+tableLength(jint total)
+{
+    jint len = 1;
+    while (len < total / 2 && len < (1 << 30))
+        len <<= 1;
+    return len;
+}
+
+/*
+ * Scrambles the bits of a name hash before it is masked into the table,
+ * as the low bits of hashN are poorly distributed for similar names.
+ */
+static unsigned int
+indexHash(unsigned int hash)
+{
+    return hash ^ (hash >> 16);
+}
+
 /*
  * Returns true if the specified entry's name begins with the string
  * "META-INF/" irrespective of case.
@@ -689,7 +714,7 @@ readCEN(jzfile *zip, jint knownTotal)
      */
     total = (knownTotal != -1) ? knownTotal : total;
     entries  = zip->entries  = calloc(total, sizeof(entries[0]));
-    tablelen = zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
+    tablelen = zip->tablelen = tableLength(total);
     table    = zip->table    = malloc(tablelen * sizeof(table[0]));
     /* According to ISO C it is perfectly legal for malloc to return zero
      * if called with a zero argument. We check this for 'entries' but not
@@ -737,7 +762,7 @@ readCEN(jzfile *zip, jint knownTotal)
         entries[i].hash = hashN((char *)cp+CENHDR, nlen);
 
         /* Add the entry to the hash table */
-        hsh = entries[i].hash % tablelen;
+        hsh = indexHash(entries[i].hash) & (tablelen - 1);
         entries[i].next = table[hsh];
         table[hsh] = i;
     }
@@ -1187,7 +1212,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         goto Finally;
     }
 
-    idx = zip->table[hsh % zip->tablelen];
+    idx = zip->table[indexHash(hsh) & (zip->tablelen - 1)];
 
     /*
      * This while loop is an optimization where a double lookup
@@ -1258,7 +1283,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         name[ulen++] = '/';
         name[ulen] = '\0';
         hsh = hash_append(hsh, '/');
-        idx = zip->table[hsh % zip->tablelen];
+        idx = zip->table[indexHash(hsh) & (zip->tablelen - 1)];
         addSlash = JNI_FALSE;
     }
 
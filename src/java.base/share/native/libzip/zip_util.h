@@ -225,7 +225,7 @@ typedef struct jzfile {   /* Zip file */
     jzcell *entries;      /* array of hash cells */
     jint total;           /* total number of entries */
     jint *table;          /* Hash chain heads: indexes into entries */
-    jint tablelen;        /* number of hash heads */
+    jint tablelen;        /* number of hash heads, a power of two */
     struct jzfile *next;  /* next zip file in search list */
     jzentry *cache;       /* we cache the most recently freed jzentry */
     /* Information on metadata names in META-INF directory */
@@ -27,6 +27,7 @@
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <fcntl.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -89,6 +90,23 @@ int osSupport::unmap_memory(void *addr, size_t bytes) {
     return munmap((char *) addr, bytes) == 0;
 }
 
+/**
+ * Advise the system that nBytes at file_offset will be needed soon.
+ * If addr is not NULL it is the mapped address of file_offset.
+ */
+void osSupport::prefetch(jint fd, void* addr, size_t file_offset, size_t bytes) {
+    if (addr != NULL) {
+        uintptr_t page_size = (uintptr_t) sysconf(_SC_PAGESIZE);
+        uintptr_t start = (uintptr_t) addr & ~(page_size - 1);
+        uintptr_t end = (uintptr_t) addr + bytes;
+        ::madvise((void*) start, end - start, MADV_WILLNEED);
+    } else {
+#if defined(__linux__)
+        ::posix_fadvise(fd, file_offset, bytes, POSIX_FADV_WILLNEED);
+#endif
+    }
+}
+
 /**
  * A CriticalSection to protect a small section of code.
  */
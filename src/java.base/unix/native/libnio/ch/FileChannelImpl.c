@@ -31,6 +31,7 @@
 
 #if defined(__linux__)
 #include <sys/sendfile.h>
+#include <dlfcn.h>
 #elif defined(_AIX)
 #include <string.h>
 #include <sys/socket.h>
@@ -52,11 +53,29 @@
 
 static jfieldID chan_fd;        /* jobject 'fd' in sun.nio.ch.FileChannelImpl */
 
+#if defined(__linux__)
+/* copy_file_range is only available in glibc 2.27 and newer */
+typedef ssize_t copy_file_range_func(int, loff_t*, int, loff_t*, size_t,
+                                     unsigned int);
+static copy_file_range_func* my_copy_file_range_func = NULL;
+
+static int
+isRegularFile(jint fd)
+{
+    struct stat64 sb;
+    return fstat64(fd, &sb) == 0 && S_ISREG(sb.st_mode);
+}
+#endif
+
 JNIEXPORT jlong JNICALL
 Java_sun_nio_ch_FileChannelImpl_initIDs(JNIEnv *env, jclass clazz)
 {
     jlong pageSize = sysconf(_SC_PAGESIZE);
     chan_fd = (*env)->GetFieldID(env, clazz, "fd", "Ljava/io/FileDescriptor;");
+#if defined(__linux__)
+    my_copy_file_range_func =
+        (copy_file_range_func*) dlsym(RTLD_DEFAULT, "copy_file_range");
+#endif
     return pageSize;
 }
 
@@ -169,7 +188,33 @@ Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
 
 #if defined(__linux__)
     off64_t offset = (off64_t)position;
-    jlong n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
+    jlong n;
+
+    /*
+     * copy_file_range only handles file to file transfers. Transfers to
+     * sockets and pipes always use sendfile.
+     */
+    if (my_copy_file_range_func != NULL && isRegularFile(dstFD)) {
+        loff_t off = (loff_t)position;
+        n = my_copy_file_range_func(srcFD, &off, dstFD, NULL,
+                                    (size_t)count, 0);
+        if (n > 0)
+            return n;
+        if (n < 0 && errno == EINTR)
+            return IOS_INTERRUPTED;
+        /*
+         * Fall back to sendfile for unsupported file system combinations,
+         * and when nothing was copied: some file systems, such as procfs
+         * and sysfs, report 0 bytes instead of failing.
+         */
+        if (n < 0 && errno != EXDEV && errno != ENOSYS && errno != EINVAL &&
+            errno != EOPNOTSUPP && errno != EBADF) {
+            JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+            return IOS_THROWN;
+        }
+    }
+
+    n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
     if (n < 0) {
         if (errno == EAGAIN)
             return IOS_UNAVAILABLE;
@@ -114,6 +114,13 @@ int osSupport::unmap_memory(void* addr, size_t bytes) {
     return result;
 }
 
+/**
+ * Advise the system that nBytes at file_offset will be needed soon.
+ * This is only a hint and is not implemented on Windows.
+ */
+void osSupport::prefetch(jint fd, void* addr, size_t file_offset, size_t bytes) {
+}
+
 /**
  * A CriticalSection to protect a small section of code.
  */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2000, 2005, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2000, 2021, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -33,6 +33,11 @@
 #include "ByteGray.h"
 #include "ByteIndexed.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INTARGBPRE_SSE2_SRCOVER
+#endif
+
 /*
  * This file declares, registers, and defines the various graphics
  * primitive loops to manipulate surfaces of type "IntArgbPre".
@@ -167,7 +172,108 @@ DEFINE_SRCOVER_MASKBLIT(IntArgb, IntArgbPre, 4ByteArgb)
 
 DEFINE_ALPHA_MASKBLIT(IntArgb, IntArgbPre, 4ByteArgb)
 
+#ifdef INTARGBPRE_SSE2_SRCOVER
+
+/*
+ * The unmasked IntArgbPre to IntArgbPre SrcOver blit is the hottest
+ * compositing loop for software rendering, so it gets an SSE2 version
+ * that works on four pixels at a time.  SSE2 is part of the x86_64
+ * baseline so no runtime check is needed.  The masked case and other
+ * platforms use the generic loop, renamed here so that the function
+ * below can delegate to it.
+ */
+#define IntArgbPreToIntArgbPreSrcOverMaskBlit \
+    IntArgbPreToIntArgbPreSrcOverMaskBlitGeneric
+MaskBlitFunc IntArgbPreToIntArgbPreSrcOverMaskBlit;
 DEFINE_SRCOVER_MASKBLIT(IntArgbPre, IntArgbPre, 4ByteArgb)
+#undef IntArgbPreToIntArgbPreSrcOverMaskBlit
+
+/*
+ * Computes MUL8(a, b) for each 16 bit lane.  (x + (x >> 8)) >> 8 with
+ * x = a * b + 128 yields exactly the values stored in mul8table.
+ */
+static __m128i
+mul8_epi16(__m128i a, __m128i b)
+{
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/*
+ * SrcOver for two pixels whose components have been widened to 16 bits:
+ * res = MUL8(extraA, src) + MUL8(0xff - resA, dst), where
+ * resA = MUL8(extraA, srcA).  This matches all branches of the generic
+ * loop for premultiplied data; destination pixels with resA == 0 are
+ * left untouched as in the generic loop.
+ */
+static __m128i
+srcOverPre2(__m128i src, __m128i dst, __m128i extraA)
+{
+    __m128i srcA = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, 0xff), 0xff);
+    __m128i resA = mul8_epi16(extraA, srcA);
+    __m128i dstF = _mm_sub_epi16(_mm_set1_epi16(0xff), resA);
+    __m128i res = _mm_add_epi16(mul8_epi16(extraA, src),
+                                mul8_epi16(dstF, dst));
+    __m128i keep = _mm_cmpeq_epi16(resA, _mm_setzero_si128());
+    return _mm_or_si128(_mm_and_si128(keep, dst),
+                        _mm_andnot_si128(keep, res));
+}
+
+void NAME_SRCOVER_MASKBLIT(IntArgbPre, IntArgbPre)
+    (void *dstBase, void *srcBase,
+     jubyte *pMask, jint maskOff, jint maskScan,
+     jint width, jint height,
+     SurfaceDataRasInfo *pDstInfo,
+     SurfaceDataRasInfo *pSrcInfo,
+     NativePrimitive *pPrim,
+     CompositeInfo *pCompInfo)
+{
+    DeclareAndInitExtraAlphaFor4ByteArgb(extraA)
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    __m128i zero = _mm_setzero_si128();
+    __m128i vextraA;
+
+    if (pMask) {
+        IntArgbPreToIntArgbPreSrcOverMaskBlitGeneric(dstBase, srcBase,
+                                                     pMask, maskOff, maskScan,
+                                                     width, height,
+                                                     pDstInfo, pSrcInfo,
+                                                     pPrim, pCompInfo);
+        return;
+    }
+
+    vextraA = _mm_set1_epi16((short) extraA);
+    do {
+        jint *pSrc = (jint *) srcBase;
+        jint *pDst = (jint *) dstBase;
+        jint w = width;
+
+        for (; w >= 4; w -= 4, pSrc += 4, pDst += 4) {
+            __m128i s = _mm_loadu_si128((__m128i *) pSrc);
+            __m128i d = _mm_loadu_si128((__m128i *) pDst);
+            __m128i lo = srcOverPre2(_mm_unpacklo_epi8(s, zero),
+                                     _mm_unpacklo_epi8(d, zero), vextraA);
+            __m128i hi = srcOverPre2(_mm_unpackhi_epi8(s, zero),
+                                     _mm_unpackhi_epi8(d, zero), vextraA);
+            _mm_storeu_si128((__m128i *) pDst, _mm_packus_epi16(lo, hi));
+        }
+        for (; w > 0; w--, pSrc++, pDst++) {
+            __m128i s = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*pSrc), zero);
+            __m128i d = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*pDst), zero);
+            __m128i r = srcOverPre2(s, d, vextraA);
+            *pDst = _mm_cvtsi128_si32(_mm_packus_epi16(r, zero));
+        }
+        srcBase = PtrAddBytes(srcBase, srcScan);
+        dstBase = PtrAddBytes(dstBase, dstScan);
+    } while (--height > 0);
+}
+
+#else /* !INTARGBPRE_SSE2_SRCOVER */
+
+DEFINE_SRCOVER_MASKBLIT(IntArgbPre, IntArgbPre, 4ByteArgb)
+
+#endif /* INTARGBPRE_SSE2_SRCOVER */
 
 DEFINE_ALPHA_MASKBLIT(IntArgbPre, IntArgbPre, 4ByteArgb)
 
@@ -201,6 +201,7 @@ JDKFontInfo*
                        jfloatArray matrix) {
 
 
+    int i;
     JDKFontInfo *fi = (JDKFontInfo*)malloc(sizeof(JDKFontInfo));
     if (!fi) {
        return NULL;
@@ -217,6 +218,10 @@ JDKFontInfo*
     } else {
         fi->devScale = 1.0f;
     }
+    for (i = 0; i < JDK_HB_CACHE_SIZE; i++) {
+        fi->glyphCacheChars[i] = JDK_HB_CACHE_EMPTY;
+        fi->advanceCacheGlyphs[i] = JDK_HB_CACHE_EMPTY;
+    }
     return fi;
 }
 
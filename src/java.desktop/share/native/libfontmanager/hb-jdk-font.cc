@@ -46,6 +46,11 @@ hb_jdk_get_nominal_glyph (hb_font_t *font HB_UNUSED,
 {
 
     JDKFontInfo *jdkFontInfo = (JDKFontInfo*)font_data;
+    int slot = unicode & (JDK_HB_CACHE_SIZE - 1);
+    if (jdkFontInfo->glyphCacheChars[slot] == unicode) {
+        *glyph = jdkFontInfo->glyphCacheGlyphs[slot];
+        return (*glyph != 0);
+    }
     JNIEnv* env = jdkFontInfo->env;
     jobject font2D = jdkFontInfo->font2D;
     *glyph = (hb_codepoint_t)env->CallIntMethod(
@@ -57,6 +62,8 @@ hb_jdk_get_nominal_glyph (hb_font_t *font HB_UNUSED,
     if ((int)*glyph < 0) {
         *glyph = 0;
     }
+    jdkFontInfo->glyphCacheChars[slot] = unicode;
+    jdkFontInfo->glyphCacheGlyphs[slot] = *glyph;
     return (*glyph != 0);
 }
 
@@ -98,6 +105,10 @@ hb_jdk_get_glyph_h_advance (hb_font_t *font HB_UNUSED,
     }
 
     JDKFontInfo *jdkFontInfo = (JDKFontInfo*)font_data;
+    int slot = glyph & (JDK_HB_CACHE_SIZE - 1);
+    if (jdkFontInfo->advanceCacheGlyphs[slot] == glyph) {
+        return jdkFontInfo->advanceCacheValues[slot];
+    }
     JNIEnv* env = jdkFontInfo->env;
     jobject fontStrike = jdkFontInfo->fontStrike;
     jobject pt = env->CallObjectMethod(fontStrike,
@@ -110,7 +121,9 @@ hb_jdk_get_glyph_h_advance (hb_font_t *font HB_UNUSED,
     fadv *= jdkFontInfo->devScale;
     env->DeleteLocalRef(pt);
 
-    return HBFloatToFixed(fadv);
+    jdkFontInfo->advanceCacheGlyphs[slot] = glyph;
+    jdkFontInfo->advanceCacheValues[slot] = HBFloatToFixed(fadv);
+    return jdkFontInfo->advanceCacheValues[slot];
 }
 
 static hb_position_t
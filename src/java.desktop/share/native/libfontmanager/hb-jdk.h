@@ -34,6 +34,15 @@
 extern "C" {
 #endif
 
+/*
+ * Small direct mapped caches for the char to glyph and glyph advance
+ * up-calls, which HarfBuzz makes for every character of the run.
+ * A JDKFontInfo lives for a single shape() call so the entries never
+ * need to be invalidated. Keys are set to JDK_HB_CACHE_EMPTY when unused.
+ */
+#define JDK_HB_CACHE_SIZE  64 // must be a power of 2
+#define JDK_HB_CACHE_EMPTY ((hb_codepoint_t)0xffffffff)
+
 typedef struct JDKFontInfo_Struct {
     JNIEnv* env;
     jobject font2D;
@@ -43,6 +52,10 @@ typedef struct JDKFontInfo_Struct {
     float xPtSize;
     float yPtSize;
     float devScale; // How much applying the full glyph tx scales x distance.
+    hb_codepoint_t glyphCacheChars[JDK_HB_CACHE_SIZE];
+    hb_codepoint_t glyphCacheGlyphs[JDK_HB_CACHE_SIZE];
+    hb_codepoint_t advanceCacheGlyphs[JDK_HB_CACHE_SIZE];
+    hb_position_t advanceCacheValues[JDK_HB_CACHE_SIZE];
 } JDKFontInfo;
 
 
@@ -46,6 +46,11 @@ typedef struct symtab {
   size_t num_symbols;
   struct elf_symbol *symbols;
   struct hsearch_data *hash_table;
+  // symbols sorted by offset, for address to symbol lookups
+  size_t num_by_offset;
+  struct elf_symbol **by_offset;
+  // max_end[i] is the largest offset + size among by_offset[0..i]
+  uintptr_t *max_end;
 } symtab_t;
 
 
@@ -514,8 +519,58 @@ quit:
   return symtab;
 }
 
+static int compare_by_offset(const void *a, const void *b) {
+  const struct elf_symbol *sa = *(const struct elf_symbol **)a;
+  const struct elf_symbol *sb = *(const struct elf_symbol **)b;
+  if (sa->offset != sb->offset) {
+    return sa->offset < sb->offset ? -1 : 1;
+  }
+  // keep symbol table order for equal offsets
+  return sa < sb ? -1 : (sa > sb ? 1 : 0);
+}
+
+// Build the by-offset index used by nearest_symbol. If memory can't be
+// allocated the index is left empty and nearest_symbol scans linearly.
+static void build_offset_index(struct symtab* symtab) {
+  size_t n, count = 0;
+  uintptr_t end = 0;
+
+  for (n = 0; n < symtab->num_symbols; n++) {
+    if (symtab->symbols[n].name != NULL) count++;
+  }
+  if (count == 0) return;
+
+  symtab->by_offset = (struct elf_symbol **)calloc(count, sizeof(struct elf_symbol *));
+  symtab->max_end = (uintptr_t *)calloc(count, sizeof(uintptr_t));
+  if (symtab->by_offset == NULL || symtab->max_end == NULL) {
+    free(symtab->by_offset);
+    free(symtab->max_end);
+    symtab->by_offset = NULL;
+    symtab->max_end = NULL;
+    return;
+  }
+
+  count = 0;
+  for (n = 0; n < symtab->num_symbols; n++) {
+    if (symtab->symbols[n].name != NULL) {
+      symtab->by_offset[count++] = &(symtab->symbols[n]);
+    }
+  }
+  qsort(symtab->by_offset, count, sizeof(struct elf_symbol *), compare_by_offset);
+  for (n = 0; n < count; n++) {
+    struct elf_symbol* sym = symtab->by_offset[n];
+    if (sym->offset + sym->size > end) end = sym->offset + sym->size;
+    symtab->max_end[n] = end;
+  }
+  symtab->num_by_offset = count;
+}
+
 struct symtab* build_symtab(int fd, const char *filename) {
-  return build_symtab_internal(fd, filename, /* try_debuginfo */ true);
+  struct symtab* symtab = build_symtab_internal(fd, filename, /* try_debuginfo */ true);
+  if (symtab != NULL) {
+    build_offset_index(symtab);
+  }
+  return symtab;
 }
 
 
@@ -523,6 +578,8 @@ void destroy_symtab(struct symtab* symtab) {
   if (!symtab) return;
   if (symtab->strs) free(symtab->strs);
   if (symtab->symbols) free(symtab->symbols);
+  if (symtab->by_offset) free(symtab->by_offset);
+  if (symtab->max_end) free(symtab->max_end);
   if (symtab->hash_table) {
      hdestroy_r(symtab->hash_table);
      free(symtab->hash_table);
@@ -559,6 +616,31 @@ const char* nearest_symbol(struct symtab* symtab, uintptr_t offset,
                            uintptr_t* poffset) {
   int n = 0;
   if (!symtab) return NULL;
+  if (symtab->by_offset != NULL) {
+    // Binary search for the last symbol starting at or below offset, then
+    // walk back over all symbols that may still cover it. Among the
+    // matches, return the first one in symbol table order like the
+    // linear scan below.
+    struct elf_symbol* found = NULL;
+    size_t lo = 0, hi = symtab->num_by_offset;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (symtab->by_offset[mid]->offset <= offset) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    while (lo > 0 && symtab->max_end[lo - 1] > offset) {
+      struct elf_symbol* sym = symtab->by_offset[--lo];
+      if (offset < sym->offset + sym->size && (found == NULL || sym < found)) {
+        found = sym;
+      }
+    }
+    if (found == NULL) return NULL;
+    if (poffset) *poffset = (offset - found->offset);
+    return found->name;
+  }
   for (; n < symtab->num_symbols; n++) {
      struct elf_symbol* sym = &(symtab->symbols[n]);
      if (sym->name != NULL &&
@@ -78,8 +78,9 @@ writeBooleanComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetBooleanArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeBoolean(out, components[i]);
+            components[i] = (components[i] != 0) ? 1 : 0;
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jboolean));
         deleteComponents(components);
     }
 }
@@ -92,11 +93,8 @@ writeByteComponents(JNIEnv *env, PacketOutputStream *out,
 
     components = newComponents(out, length, sizeof(jbyte));
     if (components != NULL) {
-        jint i;
         JNI_FUNC_PTR(env,GetByteArrayRegion)(env, array, index, length, components);
-        for (i = 0; i < length; i++) {
-            (void)outStream_writeByte(out, components[i]);
-        }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jbyte));
         deleteComponents(components);
     }
 }
@@ -112,8 +110,9 @@ writeCharComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetCharArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeChar(out, components[i]);
+            components[i] = HOST_TO_JAVA_CHAR(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jchar));
         deleteComponents(components);
     }
 }
@@ -129,8 +128,9 @@ writeShortComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetShortArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeShort(out, components[i]);
+            components[i] = HOST_TO_JAVA_SHORT(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jshort));
         deleteComponents(components);
     }
 }
@@ -146,8 +146,9 @@ writeIntComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetIntArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeInt(out, components[i]);
+            components[i] = HOST_TO_JAVA_INT(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jint));
         deleteComponents(components);
     }
 }
@@ -163,8 +164,9 @@ writeLongComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetLongArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeLong(out, components[i]);
+            components[i] = HOST_TO_JAVA_LONG(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jlong));
         deleteComponents(components);
     }
 }
@@ -180,8 +182,9 @@ writeFloatComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetFloatArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeFloat(out, components[i]);
+            components[i] = HOST_TO_JAVA_FLOAT(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jfloat));
         deleteComponents(components);
     }
 }
@@ -197,8 +200,9 @@ writeDoubleComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetDoubleArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeDouble(out, components[i]);
+            components[i] = HOST_TO_JAVA_DOUBLE(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(jdouble));
         deleteComponents(components);
     }
 }
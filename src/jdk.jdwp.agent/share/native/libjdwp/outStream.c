@@ -293,6 +293,16 @@ outStream_writeLocation(PacketOutputStream *stream, jlocation val)
     return outStream_writeLong(stream, (jlong)val);
 }
 
+/*
+ * Write 'size' bytes already in Java (network) byte order, without a
+ * length prefix.
+ */
+jdwpError
+outStream_writeBytes(PacketOutputStream *stream, void *source, jint size)
+{
+    return writeBytes(stream, source, size);
+}
+
 jdwpError
 outStream_writeByteArray(PacketOutputStream*stream, jint length,
                          jbyte *bytes)
@@ -145,3 +145,23 @@ public:
 TEST_VM(SymbolTable, test_symbol_refcount_parallel) {
   mt_test_doer<DriverSymbolThread>();
 }
+
+TEST_VM(SymbolTable, test_same_hash_and_length) {
+  JavaThread* THREAD = JavaThread::current();
+  // the thread should be in vm to use locks
+  ThreadInVMfromNative ThreadInVMfromNative(THREAD);
+
+  // "AaAa" and "BBBB" have the same length and String hash code, so the
+  // lookup has to compare the bytes after the hash and length match.
+  TempNewSymbol aa = SymbolTable::new_symbol("AaAa");
+  TempNewSymbol bb = SymbolTable::new_symbol("BBBB");
+  ASSERT_NE((Symbol*)aa, (Symbol*)bb) << "must be different symbols";
+  ASSERT_TRUE(aa->equals("AaAa")) << "lookup must not mix up keys";
+  ASSERT_TRUE(bb->equals("BBBB")) << "lookup must not mix up keys";
+
+  TempNewSymbol aa2 = SymbolTable::probe("AaAa", 4);
+  TempNewSymbol bb2 = SymbolTable::probe("BBBB", 4);
+  ASSERT_EQ((Symbol*)aa, (Symbol*)aa2) << "should find the same symbol";
+  ASSERT_EQ((Symbol*)bb, (Symbol*)bb2) << "should find the same symbol";
+  ASSERT_EQ(SymbolTable::probe("AaBB", 4), (Symbol*)NULL) << "should not be found";
+}
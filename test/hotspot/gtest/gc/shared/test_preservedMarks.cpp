@@ -86,3 +86,28 @@ TEST_VM(PreservedMarks, iterate_and_restore) {
   ASSERT_MARK_WORD_EQ(o3.mark(), FakeOop::changedMark());
   ASSERT_MARK_WORD_EQ(o4.mark(), FakeOop::changedMark());
 }
+
+TEST_VM(PreservedMarksSet, restore_in_chunks) {
+  // Enough entries to span several stack segments in one of the stacks.
+  const size_t num_oops = 1000;
+  FakeOop* oops = new FakeOop[num_oops];
+
+  PreservedMarksSet pms(true /* in_c_heap */);
+  pms.init(2);
+  for (size_t i = 0; i < num_oops; i++) {
+    oops[i].set_mark(FakeOop::changedMark());
+    // Put most of the entries on the first stack.
+    pms.get(i % 10 == 0 ? 1 : 0)->push(oops[i].get_oop(), oops[i].mark());
+    oops[i].set_mark(FakeOop::originalMark());
+  }
+
+  pms.restore(NULL);
+  for (size_t i = 0; i < num_oops; i++) {
+    ASSERT_MARK_WORD_EQ(oops[i].mark(), FakeOop::changedMark());
+  }
+  ASSERT_EQ(pms.get(0)->size(), 0u);
+  ASSERT_EQ(pms.get(1)->size(), 0u);
+
+  pms.reclaim();
+  delete[] oops;
+}
@@ -68,76 +68,48 @@ LOG_LEVEL_LIST
   }
 };
 
-TEST_VM(AsyncLogBufferTest, fifo) {
-  LinkedListDeque<int, mtLogging> fifo;
-  LinkedListImpl<int, ResourceObj::C_HEAP, mtLogging> result;
-
-  fifo.push_back(1);
-  EXPECT_EQ((size_t)1, fifo.size());
-  EXPECT_EQ(1, *(fifo.back()));
-
-  fifo.pop_all(&result);
-  EXPECT_EQ((size_t)0, fifo.size());
-  EXPECT_EQ(NULL, fifo.back());
-  EXPECT_EQ((size_t)1, result.size());
-  EXPECT_EQ(1, *(result.head()->data()));
-  result.clear();
-
-  fifo.push_back(2);
-  fifo.push_back(1);
-  fifo.pop_all(&result);
-  EXPECT_EQ((size_t)2, result.size());
-  EXPECT_EQ(2, *(result.head()->data()));
-  EXPECT_EQ(1, *(result.head()->next()->data()));
-  result.clear();
-  const int N = 1000;
-  for (int i=0; i<N; ++i) {
-    fifo.push_back(i);
-  }
-  fifo.pop_all(&result);
-
-  EXPECT_EQ((size_t)N, result.size());
-  LinkedListIterator<int> it(result.head());
-  for (int i=0; i<N; ++i) {
-    int* e = it.next();
-    EXPECT_EQ(i, *e);
-  }
-}
-
-TEST_VM(AsyncLogBufferTest, deque) {
-  LinkedListDeque<int, mtLogging> deque;
-  const int N = 10;
-
-  EXPECT_EQ(NULL, deque.front());
-  EXPECT_EQ(NULL, deque.back());
-  for (int i = 0; i < N; ++i) {
-    deque.push_back(i);
+TEST_VM_F(AsyncLogTest, logBuffer) {
+  using none = LogTagSetMapping<LogTag::__NO_TAG>;
+  LogDecorations decorations(LogLevel::Warning, none::tagset(), LogDecorators());
+  // The buffer never touches the output, it is only recorded.
+  LogFileOutput output("file=async-buffer-test.log");
+
+  const size_t capacity = 1024;
+  AsyncLogWriter::Buffer* buffer = new AsyncLogWriter::Buffer(capacity);
+  EXPECT_TRUE(buffer->is_empty());
+
+  char text[32];
+  int lines = 0;
+  size_t used = 0;
+  while (true) {
+    jio_snprintf(text, sizeof(text), "line %d", lines);
+    used += AsyncLogWriter::Message::calc_size(strlen(text));
+    bool pushed = buffer->push_back(&output, decorations, text);
+    if (used > capacity) {
+      EXPECT_FALSE(pushed);
+      break;
+    }
+    EXPECT_TRUE(pushed);
+    lines++;
   }
-
-  EXPECT_EQ(0, *(deque.front()));
-  EXPECT_EQ(N-1, *(deque.back()));
-  EXPECT_EQ((size_t)N, deque.size());
-
-  deque.pop_front();
-  EXPECT_EQ((size_t)(N - 1), deque.size());
-  EXPECT_EQ(1, *(deque.front()));
-  EXPECT_EQ(N - 1, *(deque.back()));
-
-  deque.pop_front();
-  EXPECT_EQ((size_t)(N - 2), deque.size());
-  EXPECT_EQ(2, *(deque.front()));
-  EXPECT_EQ(N - 1, *(deque.back()));
-
-
-  for (int i=2; i < N-1; ++i) {
-    deque.pop_front();
+  EXPECT_GT(lines, 0);
+  EXPECT_FALSE(buffer->is_empty());
+
+  AsyncLogWriter::Buffer::Iterator it = buffer->iterator();
+  for (int i = 0; i < lines; i++) {
+    ASSERT_TRUE(it.has_next());
+    const AsyncLogWriter::Message* m = it.next();
+    jio_snprintf(text, sizeof(text), "line %d", i);
+    EXPECT_STREQ(text, m->message());
+    EXPECT_EQ(&output, m->output());
   }
-  EXPECT_EQ((size_t)1, deque.size());
-  EXPECT_EQ(N - 1, *(deque.back()));
-  EXPECT_EQ(deque.back(), deque.front());
+  EXPECT_FALSE(it.has_next());
 
-  deque.pop_front();
-  EXPECT_EQ((size_t)0, deque.size());
+  buffer->reset();
+  EXPECT_TRUE(buffer->is_empty());
+  EXPECT_FALSE(buffer->iterator().has_next());
+  EXPECT_TRUE(buffer->push_back(&output, decorations, ""));
+  delete buffer;
 }
 
 TEST_VM_F(AsyncLogTest, asynclog) {
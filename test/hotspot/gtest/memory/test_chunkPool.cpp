@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/arena.hpp"
+#include "runtime/thread.hpp"
+#include "unittest.hpp"
+
+// Slots of the pools in Thread::cached_chunks(), see ChunkPool::initialize()
+static const size_t pool_lengths[Thread::num_cached_chunks] = {
+  Chunk::size, Chunk::medium_size, Chunk::init_size, Chunk::tiny_size
+};
+
+static Chunk* new_chunk(size_t length) {
+  return new (AllocFailStrategy::EXIT_OOM, length) Chunk(length);
+}
+
+static void expect_no_cached_chunks(Thread* thread) {
+  for (int i = 0; i < Thread::num_cached_chunks; i++) {
+    EXPECT_EQ((Chunk*)NULL, thread->cached_chunks()[i]) << "slot " << i;
+  }
+}
+
+class ChunkPoolTestWorkers : AllStatic {
+  static WorkGang* _work_gang;
+  static WorkGang* work_gang() {
+    if (_work_gang == NULL) {
+      _work_gang = new WorkGang("Chunk Pool Test Workers", MaxWorkers, false, false);
+      _work_gang->initialize_workers();
+      _work_gang->update_active_workers(MaxWorkers);
+    }
+    return _work_gang;
+  }
+
+public:
+  static const uint MaxWorkers = 4;
+  static void run_task(AbstractGangTask* task) {
+    work_gang()->run_task(task);
+  }
+};
+WorkGang* ChunkPoolTestWorkers::_work_gang = NULL;
+
+// Each worker caches one chunk per pool, and reuses it
+class ChunkCacheTask : public AbstractGangTask {
+public:
+  ChunkCacheTask() : AbstractGangTask("Chunk cache") { }
+
+  void work(uint worker_id) {
+    Thread* thread = Thread::current();
+    ASSERT_TRUE(thread->chunk_cache_enabled());
+    Chunk** cache = thread->cached_chunks();
+    for (int i = 0; i < Thread::num_cached_chunks; i++) {
+      size_t length = pool_lengths[i];
+      Chunk* a = new_chunk(length);
+      Chunk* b = new_chunk(length);
+      EXPECT_EQ(length, a->length());
+      EXPECT_NE(a, b);
+
+      // The first free fills the slot, the second goes to the global pool
+      delete a;
+      EXPECT_EQ(a, cache[i]);
+      delete b;
+      EXPECT_EQ(a, cache[i]);
+
+      // Allocation takes the cached chunk first
+      Chunk* c = new_chunk(length);
+      EXPECT_EQ(a, c);
+      EXPECT_EQ((Chunk*)NULL, cache[i]);
+      delete c;
+      EXPECT_EQ(c, cache[i]);
+    }
+
+    // Chunks of other sizes are never cached
+    Chunk* odd = new_chunk(Chunk::non_pool_size);
+    delete odd;
+    for (int i = 0; i < Thread::num_cached_chunks; i++) {
+      EXPECT_NE(odd, cache[i]);
+    }
+  }
+};
+
+// Pruning the global pools leaves the cached chunks alone
+class ChunkCachePruneTask : public AbstractGangTask {
+public:
+  ChunkCachePruneTask() : AbstractGangTask("Chunk cache pruning") { }
+
+  void work(uint worker_id) {
+    Chunk** cache = Thread::current()->cached_chunks();
+    Chunk* cached[Thread::num_cached_chunks];
+    for (int i = 0; i < Thread::num_cached_chunks; i++) {
+      // Put some more chunks into the global pool than the cleaner keeps
+      Chunk* chunks[8];
+      for (int j = 0; j < 8; j++) {
+        chunks[j] = new_chunk(pool_lengths[i]);
+      }
+      for (int j = 0; j < 8; j++) {
+        delete chunks[j];
+      }
+      cached[i] = cache[i];
+      EXPECT_NE((Chunk*)NULL, cached[i]);
+    }
+    Chunk::clean_chunk_pools();
+    for (int i = 0; i < Thread::num_cached_chunks; i++) {
+      EXPECT_EQ(cached[i], cache[i]);
+      Chunk* c = new_chunk(pool_lengths[i]);
+      EXPECT_EQ(cached[i], c);
+      delete c;
+    }
+  }
+};
+
+// The cached chunks are handed back when the thread goes away, and the
+// thread does not cache any more
+class ChunkCacheReleaseTask : public AbstractGangTask {
+public:
+  ChunkCacheReleaseTask() : AbstractGangTask("Chunk cache release") { }
+
+  void work(uint worker_id) {
+    Thread* thread = Thread::current();
+    for (int i = 0; i < Thread::num_cached_chunks; i++) {
+      delete new_chunk(pool_lengths[i]);
+      EXPECT_NE((Chunk*)NULL, thread->cached_chunks()[i]);
+    }
+
+    // This is what ~Thread does
+    Chunk::release_thread_cached_chunks(thread);
+    EXPECT_FALSE(thread->chunk_cache_enabled());
+    expect_no_cached_chunks(thread);
+    for (int i = 0; i < Thread::num_cached_chunks; i++) {
+      delete new_chunk(pool_lengths[i]);
+    }
+    expect_no_cached_chunks(thread);
+
+    // Keep the worker usable for other tests
+    thread->set_chunk_cache_enabled(true);
+  }
+};
+
+TEST_VM(ChunkPool, thread_chunk_cache) {
+  ChunkCacheTask task;
+  ChunkPoolTestWorkers::run_task(&task);
+}
+
+TEST_VM(ChunkPool, thread_chunk_cache_pruning) {
+  ChunkCachePruneTask task;
+  ChunkPoolTestWorkers::run_task(&task);
+}
+
+TEST_VM(ChunkPool, thread_chunk_cache_release) {
+  ChunkCacheReleaseTask task;
+  ChunkPoolTestWorkers::run_task(&task);
+}
+
+TEST_VM(ChunkPool, java_threads_do_not_cache) {
+  JavaThread* thread = JavaThread::current();
+  ASSERT_FALSE(thread->is_Compiler_thread());
+  expect_no_cached_chunks(thread);
+  for (int i = 0; i < Thread::num_cached_chunks; i++) {
+    delete new_chunk(pool_lengths[i]);
+  }
+  expect_no_cached_chunks(thread);
+}
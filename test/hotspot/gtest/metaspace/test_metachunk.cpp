@@ -27,6 +27,7 @@
 #include "memory/metaspace/chunkManager.hpp"
 #include "memory/metaspace/freeChunkList.hpp"
 #include "memory/metaspace/metachunk.hpp"
+#include "memory/metaspace/metachunkList.hpp"
 #include "memory/metaspace/metaspaceSettings.hpp"
 #include "memory/metaspace/virtualSpaceNode.hpp"
 #include "metaspaceGtestCommon.hpp"
@@ -36,6 +37,7 @@
 using metaspace::ChunkManager;
 using metaspace::FreeChunkListVector;
 using metaspace::Metachunk;
+using metaspace::MetachunkList;
 using metaspace::Settings;
 using metaspace::VirtualSpaceNode;
 using namespace metaspace::chunklevel;
@@ -419,3 +421,23 @@ TEST_VM(metaspace, chunk_enlarge_in_place) {
 
 }
 
+
+// Test ChunkManager::return_chunks
+TEST_VM(metaspace, return_chunks) {
+
+  ChunkGtestContext context;
+  MetachunkList list;
+
+  for (chunklevel_t lvl = HIGHEST_CHUNK_LEVEL - 4; lvl <= HIGHEST_CHUNK_LEVEL; lvl++) {
+    Metachunk* c = NULL;
+    context.alloc_chunk_expect_success(&c, lvl);
+    c->set_in_use(); // Forestall assert in cm
+    list.add(c);
+  }
+  EXPECT_EQ(list.count(), 5);
+
+  context.cm().return_chunks(&list);
+  EXPECT_EQ(list.count(), 0);
+  EXPECT_NULL(list.first());
+  DEBUG_ONLY(context.cm().verify();)
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef GTEST_MICROBENCHMARK_INLINE_HPP
+#define GTEST_MICROBENCHMARK_INLINE_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+#include "runtime/semaphore.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+#include "threadHelper.inline.hpp"
+
+// Helper for micro-benchmarking VM internal data structures.
+//
+// A benchmark runs an operation for a number of warmup repetitions, then
+// for a number of measured repetitions, and prints one line of JSON with
+// the time per operation at a few percentiles over the measured
+// repetitions. Benchmarks are registered as DISABLED_ tests so that they
+// don't slow down regular runs. They can be run with
+//
+//   gtestLauncher -jdk:<jdk> --gtest_also_run_disabled_tests \
+//                 --gtest_filter='*DISABLED_bench_*'
+//
+// The operation is a functor called as op(worker_id, ops) which performs
+// 'ops' operations. With more than one thread it is called concurrently
+// from that many JavaTestThreads, and the time of a repetition is the wall
+// time from releasing the workers until all of them have returned.
+class MicroBenchmark : public StackObj {
+  const char* const _name;
+  const size_t _ops;     // Operations per worker and repetition.
+  const uint _threads;
+  const uint _warmup;
+  const uint _reps;
+
+  template <typename OP>
+  class Worker : public JavaTestThread {
+    OP& _op;
+    const uint _id;
+    const size_t _ops;
+    Semaphore* const _ready;
+    Semaphore* const _start;
+    Semaphore* const _finished;
+
+  public:
+    Worker(Semaphore* post, OP& op, uint id, size_t ops,
+           Semaphore* ready, Semaphore* start, Semaphore* finished) :
+      JavaTestThread(post), _op(op), _id(id), _ops(ops),
+      _ready(ready), _start(start), _finished(finished) {}
+
+    void main_run() {
+      _ready->signal();
+      _start->wait();
+      _op(_id, _ops);
+      _finished->signal();
+    }
+  };
+
+  static int compare_jlong(jlong a, jlong b) {
+    return (a < b) ? -1 : ((a == b) ? 0 : 1);
+  }
+
+  template <typename OP>
+  jlong run_once(OP& op) {
+    if (_threads == 1) {
+      jlong start = os::javaTimeNanos();
+      op(0, _ops);
+      return os::javaTimeNanos() - start;
+    }
+
+    Semaphore post, ready, start, finished;
+    for (uint i = 0; i < _threads; i++) {
+      (new Worker<OP>(&post, op, i, _ops, &ready, &start, &finished))->doit();
+    }
+    for (uint i = 0; i < _threads; i++) {
+      ready.wait();
+    }
+    jlong start_time = os::javaTimeNanos();
+    start.signal(_threads);
+    for (uint i = 0; i < _threads; i++) {
+      finished.wait();
+    }
+    jlong elapsed = os::javaTimeNanos() - start_time;
+    // Wait for the workers to exit outside of the measured time.
+    for (uint i = 0; i < _threads; i++) {
+      post.wait();
+    }
+    return elapsed;
+  }
+
+  double ns_per_op(jlong ns) const {
+    return (double)ns / ((double)_ops * _threads);
+  }
+
+public:
+  MicroBenchmark(const char* name, size_t ops, uint threads = 1,
+                 uint warmup = 3, uint reps = 10) :
+    _name(name), _ops(ops), _threads(threads), _warmup(warmup), _reps(reps) {
+    assert(_ops > 0 && _threads > 0 && _reps > 0, "invalid benchmark setup");
+  }
+
+  template <typename OP>
+  void run(OP& op) {
+    for (uint i = 0; i < _warmup; i++) {
+      run_once(op);
+    }
+    jlong* times = NEW_C_HEAP_ARRAY(jlong, _reps, mtTest);
+    for (uint i = 0; i < _reps; i++) {
+      times[i] = run_once(op);
+    }
+    QuickSort::sort(times, _reps, compare_jlong, false);
+
+    tty->print_cr("{\"benchmark\": \"%s\", \"threads\": %u, \"ops\": " SIZE_FORMAT
+                  ", \"reps\": %u, \"ns_per_op\": {\"min\": %.3f, \"p50\": %.3f"
+                  ", \"p90\": %.3f, \"max\": %.3f}}",
+                  _name, _threads, _ops, _reps,
+                  ns_per_op(times[0]),
+                  ns_per_op(times[(_reps - 1) / 2]),
+                  ns_per_op(times[(_reps - 1) * 9 / 10]),
+                  ns_per_op(times[_reps - 1]));
+    FREE_C_HEAP_ARRAY(jlong, times);
+  }
+};
+
+#endif // GTEST_MICROBENCHMARK_INLINE_HPP
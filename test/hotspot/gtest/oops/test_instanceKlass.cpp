@@ -37,3 +37,13 @@ TEST_VM(InstanceKlass, string_klass) {
   InstanceKlass* klass = vmClasses::String_klass();
   ASSERT_TRUE(!klass->is_class_loader_instance_klass());
 }
+
+TEST_VM(InstanceKlass, secondary_supers_bitmap) {
+  InstanceKlass* klass = vmClasses::String_klass();
+  Array<Klass*>* secondaries = klass->secondary_supers();
+  for (int i = 0; i < secondaries->length(); i++) {
+    ASSERT_TRUE(klass->may_be_secondary_super(secondaries->at(i)));
+    ASSERT_TRUE(klass->is_subtype_of(secondaries->at(i)));
+  }
+  ASSERT_FALSE(klass->is_subtype_of(vmClasses::Cloneable_klass()));
+}
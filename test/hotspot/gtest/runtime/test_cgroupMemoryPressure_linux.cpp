@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+
+#ifdef LINUX
+
+#include "cgroupV2Subsystem_linux.hpp"
+#include "runtime/os.hpp"
+#include "unittest.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+  // A cgroup v2 directory with only a memory.pressure file
+  class FakeUnifiedHierarchy {
+    char _dir[64];
+    char _file[128];
+   public:
+    FakeUnifiedHierarchy(const char* contents) {
+      strcpy(_dir, "/tmp/cgroupv2_pressure_XXXXXX");
+      EXPECT_NE(mkdtemp(_dir), (char*)NULL);
+      jio_snprintf(_file, sizeof(_file), "%s/memory.pressure", _dir);
+      if (contents != NULL) {
+        FILE* f = fopen(_file, "w");
+        EXPECT_NE(f, (FILE*)NULL);
+        fputs(contents, f);
+        fclose(f);
+      }
+    }
+    ~FakeUnifiedHierarchy() {
+      unlink(_file);
+      rmdir(_dir);
+    }
+    double memory_pressure() {
+      char cgroup_path[] = "";
+      CgroupV2Controller* unified = new CgroupV2Controller(_dir, cgroup_path);
+      CgroupV2Subsystem subsystem(unified);
+      return subsystem.memory_pressure();
+    }
+  };
+}
+
+TEST(os_linux, cgroupv2_memory_pressure) {
+  FakeUnifiedHierarchy h("some avg10=12.34 avg60=5.00 avg300=1.00 total=123456\n"
+                         "full avg10=3.21 avg60=1.00 avg300=0.50 total=2345\n");
+  EXPECT_DOUBLE_EQ(h.memory_pressure(), 12.34);
+}
+
+TEST(os_linux, cgroupv2_memory_pressure_idle) {
+  FakeUnifiedHierarchy h("some avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"
+                         "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+  EXPECT_DOUBLE_EQ(h.memory_pressure(), 0.0);
+}
+
+TEST(os_linux, cgroupv2_memory_pressure_missing) {
+  // Kernels without PSI have no memory.pressure file
+  FakeUnifiedHierarchy h(NULL);
+  EXPECT_EQ(h.memory_pressure(), (double)OSCONTAINER_ERROR);
+}
+
+#endif // LINUX
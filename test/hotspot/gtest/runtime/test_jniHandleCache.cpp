@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.hpp"
+#include "runtime/jniHandles.hpp"
+#include "concurrentTestRunner.inline.hpp"
+#include "unittest.hpp"
+
+static bool is_allocated(OopStorage* storage, oop* ptr) {
+  return storage->allocation_status(ptr) == OopStorage::ALLOCATED_ENTRY;
+}
+
+TEST_VM(JNIGlobalHandleCache, refill_and_reuse) {
+  JNIGlobalHandleCache cache(true /* weak */, 8);
+  OopStorage* storage = cache.storage();
+  EXPECT_EQ(0u, cache.count());
+
+  // The first allocation refills the whole cache
+  oop* a = cache.allocate();
+  ASSERT_NE((oop*)NULL, a);
+  EXPECT_TRUE(is_allocated(storage, a));
+  EXPECT_EQ((oop*)NULL, (oop*)*a);
+  EXPECT_EQ(7u, cache.count());
+
+  // Released entries are reused first
+  cache.release(a);
+  EXPECT_EQ(8u, cache.count());
+  EXPECT_TRUE(is_allocated(storage, a));
+  EXPECT_EQ(a, cache.allocate());
+  oop* b = cache.allocate();
+  EXPECT_NE(a, b);
+  cache.release(b);
+  cache.release(a);
+  EXPECT_EQ(a, cache.allocate());
+  EXPECT_EQ(b, cache.allocate());
+  cache.release(b);
+  cache.release(a);
+  cache.verify();
+}
+
+TEST_VM(JNIGlobalHandleCache, overflow_and_flush) {
+  const size_t capacity = 4;
+  JNIGlobalHandleCache cache(false /* weak */, capacity);
+  OopStorage* storage = cache.storage();
+
+  // More entries than the cache holds, taken over two refills
+  oop* entries[2 * capacity];
+  for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+    entries[i] = cache.allocate();
+    ASSERT_NE((oop*)NULL, entries[i]);
+    for (size_t j = 0; j < i; j++) {
+      ASSERT_NE(entries[j], entries[i]);
+    }
+  }
+  EXPECT_EQ(0u, cache.count());
+
+  // Releasing into a full cache returns half of it to the storage
+  for (size_t i = 0; i < capacity; i++) {
+    cache.release(entries[i]);
+  }
+  EXPECT_EQ(capacity, cache.count());
+  cache.release(entries[capacity]);
+  EXPECT_EQ(capacity / 2 + 1, cache.count());
+  EXPECT_FALSE(is_allocated(storage, entries[capacity / 2]));
+  EXPECT_FALSE(is_allocated(storage, entries[capacity - 1]));
+  EXPECT_TRUE(is_allocated(storage, entries[0]));
+  EXPECT_TRUE(is_allocated(storage, entries[capacity]));
+  cache.verify();
+
+  for (size_t i = capacity + 1; i < ARRAY_SIZE(entries); i++) {
+    cache.release(entries[i]);
+  }
+  EXPECT_LE(cache.count(), capacity);
+
+  // Flushing returns all cached entries
+  cache.flush();
+  EXPECT_EQ(0u, cache.count());
+  EXPECT_FALSE(is_allocated(storage, entries[0]));
+  EXPECT_FALSE(is_allocated(storage, entries[capacity]));
+}
+
+// Each thread allocates more entries than its cache holds and releases them
+// again, so that the caches refill from and overflow into the shared
+// storage concurrently.
+class JNIGlobalHandleCacheRunnable : public TestRunnable {
+  const bool _weak;
+public:
+  JNIGlobalHandleCacheRunnable(bool weak) : _weak(weak) {}
+
+  void runUnitTest() const {
+    const size_t capacity = 16;
+    JNIGlobalHandleCache cache(_weak, capacity);
+    oop* entries[3 * capacity];
+    for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+      entries[i] = cache.allocate();
+      ASSERT_NE((oop*)NULL, entries[i]);
+      ASSERT_TRUE(is_allocated(cache.storage(), entries[i]));
+      ASSERT_EQ((oop*)NULL, (oop*)*entries[i]);
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+      for (size_t j = 0; j < i; j++) {
+        ASSERT_NE(entries[j], entries[i]);
+      }
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+      cache.release(entries[i]);
+    }
+    cache.verify();
+    // The destructor flushes the rest
+  }
+};
+
+TEST_VM(JNIGlobalHandleCache, concurrent_weak) {
+  JNIGlobalHandleCacheRunnable runnable(true /* weak */);
+  ConcurrentTestRunner runner(&runnable, 4, 1000);
+  runner.run();
+}
+
+TEST_VM(JNIGlobalHandleCache, concurrent_global) {
+  JNIGlobalHandleCacheRunnable runnable(false /* weak */);
+  ConcurrentTestRunner runner(&runnable, 4, 1000);
+  runner.run();
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/lockStack.inline.hpp"
+#include "unittest.hpp"
+
+static unsigned char memory[4 * 16];
+
+static oop fake_object(int i) {
+  return cast_to_oop(&memory[i * 16]);
+}
+
+TEST(LockStack, push_pop) {
+  LockStack ls;
+  ASSERT_TRUE(ls.is_empty());
+  ls.push(fake_object(0));
+  ls.push(fake_object(1));
+  ASSERT_TRUE(ls.contains(fake_object(0)));
+  ASSERT_TRUE(ls.contains(fake_object(1)));
+  ASSERT_FALSE(ls.contains(fake_object(2)));
+
+  ls.pop(fake_object(0));
+  ASSERT_FALSE(ls.contains(fake_object(0)));
+  ASSERT_TRUE(ls.contains(fake_object(1)));
+  ls.pop(fake_object(1));
+  ASSERT_TRUE(ls.is_empty());
+}
+
+TEST(LockStack, recursive_entries) {
+  LockStack ls;
+  ls.push(fake_object(0));
+  ls.push(fake_object(1));
+  ls.push(fake_object(0));
+
+  ls.pop(fake_object(0));
+  ASSERT_TRUE(ls.contains(fake_object(0)));
+  ls.push(fake_object(0));
+
+  ASSERT_EQ(2, ls.remove(fake_object(0)));
+  ASSERT_FALSE(ls.contains(fake_object(0)));
+  ASSERT_EQ(0, ls.remove(fake_object(0)));
+  ASSERT_TRUE(ls.contains(fake_object(1)));
+  ASSERT_EQ(1, ls.remove(fake_object(1)));
+  ASSERT_TRUE(ls.is_empty());
+}
+
+TEST(LockStack, capacity) {
+  LockStack ls;
+  for (int i = 0; i < LockStack::CAPACITY; i++) {
+    ASSERT_TRUE(ls.can_push());
+    ls.push(fake_object(i % 4));
+  }
+  ASSERT_FALSE(ls.can_push());
+  ls.pop(fake_object(0));
+  ASSERT_TRUE(ls.can_push());
+}
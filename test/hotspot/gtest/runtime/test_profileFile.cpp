@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/os.hpp"
+#include "runtime/profileFile.hpp"
+#include "runtime/vm_version.hpp"
+#include "unittest.hpp"
+
+static const char* const profile_name = "test_profileFile.txt";
+
+static void write_profile(const char* content) {
+  FILE* f = os::fopen(profile_name, "w");
+  ASSERT_TRUE(f != NULL);
+  fputs(content, f);
+  fclose(f);
+}
+
+TEST_VM(ProfileFile, write_and_read) {
+  {
+    ProfileFileWriter writer(profile_name, "test profile", 3);
+    ASSERT_TRUE(writer.is_open());
+    writer.print_cr("first entry");
+    writer.print_cr("# a comment");
+    writer.print_cr("second entry");
+  }
+  ProfileFileReader reader(profile_name, "test profile", 3);
+  ASSERT_EQ(ProfileFileReader::ok, reader.status());
+  const char* entry = reader.next_entry();
+  ASSERT_TRUE(entry != NULL);
+  EXPECT_STREQ("first entry", entry);
+  entry = reader.next_entry();
+  ASSERT_TRUE(entry != NULL);
+  EXPECT_STREQ("second entry", entry);
+  EXPECT_TRUE(reader.next_entry() == NULL);
+  remove(profile_name);
+}
+
+TEST_VM(ProfileFile, cannot_open) {
+  remove(profile_name);
+  ProfileFileReader reader(profile_name, "test profile", 3);
+  EXPECT_EQ(ProfileFileReader::cannot_open, reader.status());
+  EXPECT_TRUE(reader.next_entry() == NULL);
+}
+
+TEST_VM(ProfileFile, different_vm) {
+  char header[512];
+
+  // Other version
+  jio_snprintf(header, sizeof(header), "# test profile 2 %s\nentry\n", VM_Version::vm_release());
+  write_profile(header);
+  {
+    ProfileFileReader reader(profile_name, "test profile", 3);
+    EXPECT_EQ(ProfileFileReader::different_vm, reader.status());
+    EXPECT_TRUE(reader.next_entry() == NULL);
+  }
+
+  // Other kind of profile, including one whose name extends the kind
+  jio_snprintf(header, sizeof(header), "# other profile 3 %s\nentry\n", VM_Version::vm_release());
+  write_profile(header);
+  {
+    ProfileFileReader reader(profile_name, "test profile", 3);
+    EXPECT_EQ(ProfileFileReader::different_vm, reader.status());
+  }
+  jio_snprintf(header, sizeof(header), "# test profiles 3 %s\nentry\n", VM_Version::vm_release());
+  write_profile(header);
+  {
+    ProfileFileReader reader(profile_name, "test profile", 3);
+    EXPECT_EQ(ProfileFileReader::different_vm, reader.status());
+  }
+
+  // Other VM release, and no header
+  write_profile("# test profile 3 0.0-other\nentry\n");
+  {
+    ProfileFileReader reader(profile_name, "test profile", 3);
+    EXPECT_EQ(ProfileFileReader::different_vm, reader.status());
+  }
+  write_profile("entry\n");
+  {
+    ProfileFileReader reader(profile_name, "test profile", 3);
+    EXPECT_EQ(ProfileFileReader::different_vm, reader.status());
+  }
+  remove(profile_name);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "utilities/macros.hpp"
+
+#if INCLUDE_NMT
+
+#include "services/mallocTracker.hpp"
+#include "unittest.hpp"
+
+// Allocates and frees from a deeper stack frame, which may select another
+// stripe than the caller.
+static void NOINLINE deallocate_deep(StripedMemoryCounter* c, size_t sz, int depth) {
+  volatile char frame[4 * K];
+  frame[0] = 0;
+  if (depth > 0) {
+    deallocate_deep(c, sz, depth - 1);
+  } else {
+    c->deallocate(sz);
+  }
+  frame[0]++;
+}
+
+TEST(StripedMemoryCounter, fold) {
+  StripedMemoryCounter c;
+  EXPECT_EQ(0u, c.count());
+  EXPECT_EQ(0u, c.size());
+
+  for (int i = 0; i < 10; i++) {
+    c.allocate(100);
+  }
+  c.allocate(0);
+  EXPECT_EQ(11u, c.count());
+  EXPECT_EQ(1000u, c.size());
+
+  // Free on other stripes; the folded values must stay exact.
+  for (int i = 0; i < 10; i++) {
+    deallocate_deep(&c, 100, i);
+  }
+  EXPECT_EQ(1u, c.count());
+  EXPECT_EQ(0u, c.size());
+}
+
+#endif // INCLUDE_NMT
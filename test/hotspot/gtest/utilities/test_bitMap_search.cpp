@@ -256,3 +256,30 @@ TEST(BitMap, search) {
     }
   }
 }
+
+// Searches over runs of uninteresting words of every length, so that all
+// remainders of the multi-word skip in the search loop are covered.
+TEST(BitMap, search_sparse) {
+  CHeapBitMap test_ones(BITMAP_SIZE);
+  CHeapBitMap test_zeros(BITMAP_SIZE);
+  test_ones.clear_range(0, test_ones.size());
+  test_zeros.set_range(0, test_zeros.size());
+
+  for (idx_t start = 0; start < search_chunk_size; start += search_chunk_size - 1) {
+    for (idx_t bit = start + 1; bit < BITMAP_SIZE; bit += search_chunk_size / 2 + 1) {
+      test_ones.set_bit(bit);
+      test_zeros.clear_bit(bit);
+
+      EXPECT_EQ(bit, test_ones.get_next_one_offset(start));
+      EXPECT_EQ(bit, test_zeros.get_next_zero_offset(start));
+      EXPECT_EQ(bit, test_ones.get_next_one_offset(start, bit + 1));
+      EXPECT_EQ(bit, test_zeros.get_next_zero_offset(start, bit + 1));
+      // The bit is outside the searched range.
+      EXPECT_EQ(bit, test_ones.get_next_one_offset(start, bit));
+      EXPECT_EQ(bit, test_zeros.get_next_zero_offset(start, bit));
+
+      test_ones.clear_bit(bit);
+      test_zeros.set_bit(bit);
+    }
+  }
+}
@@ -283,6 +283,35 @@ static void cht_getinsert_bulkdelete_task(Thread* thr) {
   delete cht;
 }
 
+static bool bulkdelete_all_eval(uintptr_t* val) {
+  return true;
+}
+
+static void cht_bulkdelete_task_resume(Thread* thr) {
+  // Two task ranges of 4096 buckets, one value in each.
+  uintptr_t val1 = 1;
+  uintptr_t val2 = ((uintptr_t)1 << 12) + 1;
+  SimpleTestLookup stl1(val1), stl2(val2);
+
+  SimpleTestTable* cht = new SimpleTestTable(13, 13);
+  EXPECT_TRUE(cht->insert(thr, stl1, val1)) << "Insert unique value failed.";
+  EXPECT_TRUE(cht->insert(thr, stl2, val2)) << "Insert unique value failed.";
+
+  SimpleTestTable::BulkDeleteTask bdt(cht);
+  EXPECT_TRUE(bdt.prepare(thr)) << "Prepare should succeed.";
+  EXPECT_EQ(bdt.next_task(), (size_t)0) << "Should start at the first range.";
+  bdt.resume_at(1);
+  EXPECT_TRUE(bdt.do_task(thr, bulkdelete_all_eval, getinsert_bulkdelete_del));
+  EXPECT_EQ(bdt.next_task(), (size_t)2) << "All ranges should be claimed.";
+  EXPECT_FALSE(bdt.do_task(thr, bulkdelete_all_eval, getinsert_bulkdelete_del));
+  bdt.done(thr);
+
+  EXPECT_EQ(cht_get_copy(cht, thr, stl1), val1) << "Skipped range should not be visited.";
+  EXPECT_EQ(cht_get_copy(cht, thr, stl2), (uintptr_t)0) << "Resumed range should be visited.";
+
+  delete cht;
+}
+
 static void cht_reset_shrink(Thread* thr) {
   uintptr_t val1 = 1;
   uintptr_t val2 = 2;
@@ -488,6 +517,10 @@ TEST_VM(ConcurrentHashTable, basic_get_insert_bulk_delete_task) {
   nomt_test_doer(cht_getinsert_bulkdelete_task);
 }
 
+TEST_VM(ConcurrentHashTable, basic_bulk_delete_task_resume) {
+  nomt_test_doer(cht_bulkdelete_task_resume);
+}
+
 TEST_VM(ConcurrentHashTable, basic_reset_shrink) {
   nomt_test_doer(cht_reset_shrink);
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "utilities/events.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "unittest.hpp"
+
+class EventLogTest : public StringEventLog {
+public:
+  // Event logs register themselves for printing at crashes and are never
+  // unregistered, so the test logs are allocated and intentionally leaked.
+  EventLogTest(const char* name, int length) : StringEventLog(name, name, length) {}
+
+  void set_next_seq(uintx seq) { _next_seq = seq; }
+};
+
+static void log_events(EventLogTest* log, int from, int to) {
+  for (int i = from; i < to; i++) {
+    log->log(NULL, "e%d;", i);
+  }
+}
+
+static int count_events(const char* s) {
+  int count = 0;
+  for (const char* p = strstr(s, "Event:"); p != NULL; p = strstr(p + 1, "Event:")) {
+    count++;
+  }
+  return count;
+}
+
+// Checks that the printed log holds exactly the events from..to-1, in order.
+static void check_events(EventLogTest* log, int from, int to) {
+  stringStream ss;
+  log->print_log_on(&ss);
+  const char* s = ss.base();
+  EXPECT_EQ(to - from, count_events(s)) << s;
+  const char* last = s;
+  for (int i = from; i < to; i++) {
+    char buf[16];
+    jio_snprintf(buf, sizeof(buf), "e%d;", i);
+    const char* p = strstr(s, buf);
+    ASSERT_NE(p, (const char*)NULL) << "missing " << buf << " in " << s;
+    EXPECT_GT(p, last) << buf << " out of order in " << s;
+    last = p;
+  }
+  char buf[16];
+  jio_snprintf(buf, sizeof(buf), "e%d;", from - 1);
+  EXPECT_EQ(strstr(s, buf), (const char*)NULL) << "unexpected " << buf << " in " << s;
+}
+
+TEST_VM(EventLog, partially_filled) {
+  EventLogTest* log = new EventLogTest("TestPartial", 8);
+  check_events(log, 0, 0);
+  log_events(log, 0, 3);
+  check_events(log, 0, 3);
+}
+
+TEST_VM(EventLog, overwrites_oldest) {
+  EventLogTest* log = new EventLogTest("TestOverwrite", 8);
+  log_events(log, 0, 20);
+  check_events(log, 12, 20);
+}
+
+TEST_VM(EventLog, sequence_wraps_around) {
+  EventLogTest* log = new EventLogTest("TestWrap", 8);
+  log_events(log, 0, 8);
+  // Continue shortly before the sequence number wraps. Events logged
+  // after the wrap must not be dropped as older than the slot contents.
+  log->set_next_seq(max_uintx - 5);
+  log_events(log, 8, 30);
+  check_events(log, 22, 30);
+}
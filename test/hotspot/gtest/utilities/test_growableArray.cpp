@@ -555,3 +555,42 @@ TEST(GrowableArrayCHeap, sanity) {
     delete a;
   }
 }
+
+TEST_VM(GrowableArrayInline, spill) {
+  // Resource spill
+  {
+    ResourceMark rm;
+    GrowableArrayInline<int, 4> a;
+    ASSERT_TRUE(a.is_empty());
+    ASSERT_EQ(a.max_length(), 4);
+
+    for (int i = 0; i < 4; i++) {
+      a.append(i);
+    }
+    ASSERT_TRUE(a.is_inline());
+
+    a.append(4);
+    ASSERT_FALSE(a.is_inline());
+    ASSERT_EQ(a.length(), 5);
+    for (int i = 0; i < 5; i++) {
+      ASSERT_EQ(a.at(i), i);
+    }
+  }
+
+  // Arena spill
+  {
+    Arena arena(mtTest);
+    GrowableArrayInline<int, 2> a(&arena);
+    a.append(1);
+    a.append(2);
+    ASSERT_TRUE(a.is_inline());
+
+    a.at_put_grow(9, 10, 0);
+    ASSERT_FALSE(a.is_inline());
+    ASSERT_EQ(a.length(), 10);
+    ASSERT_EQ(a.at(0), 1);
+    ASSERT_EQ(a.at(1), 2);
+    ASSERT_EQ(a.at(5), 0);
+    ASSERT_EQ(a.at(9), 10);
+  }
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "microBenchmark.inline.hpp"
+#include "unittest.hpp"
+
+// Micro-benchmarks for VM internal data structures, see
+// microBenchmark.inline.hpp for how to run them and the output format.
+
+static const size_t BenchOps = 1 * M;
+
+class BitMapSetBits {
+  CHeapBitMap& _map;
+public:
+  BitMapSetBits(CHeapBitMap& map) : _map(map) {}
+  void operator()(uint id, size_t ops) {
+    BitMap::idx_t mask = _map.size() - 1;
+    for (size_t i = 0; i < ops; i++) {
+      _map.set_bit((i * 31) & mask);
+    }
+  }
+};
+
+class BitMapSearch {
+  CHeapBitMap& _map;
+public:
+  BitMapSearch(CHeapBitMap& map) : _map(map) {}
+  void operator()(uint id, size_t ops) {
+    BitMap::idx_t cur = 0;
+    size_t found = 0;
+    for (size_t i = 0; i < ops; i++) {
+      cur = _map.get_next_one_offset(cur + 1);
+      if (cur >= _map.size()) {
+        cur = 0;
+      }
+      found += cur;
+    }
+    ASSERT_NE(found, (size_t)0);
+  }
+};
+
+TEST_VM(MicroBenchmark, DISABLED_bench_BitMap) {
+  CHeapBitMap map(64 * K, mtTest);
+  BitMapSetBits set_bits(map);
+  MicroBenchmark("BitMap::set_bit", BenchOps).run(set_bits);
+
+  map.clear();
+  for (BitMap::idx_t i = 0; i < map.size(); i += 97) {
+    map.set_bit(i);
+  }
+  BitMapSearch search(map);
+  MicroBenchmark("BitMap::get_next_one_offset", BenchOps).run(search);
+}
+
+struct BenchCHTConfig : public AllStatic {
+  typedef uintptr_t Value;
+  static uintx get_hash(const Value& value, bool* dead_hash) {
+    return (uintx)value * 0x9E3779B97F4A7C15ULL;
+  }
+  static void* allocate_node(void* context, size_t size, const Value& value) {
+    return AllocateHeap(size, mtTest);
+  }
+  static void free_node(void* context, void* memory, const Value& value) {
+    FreeHeap(memory);
+  }
+};
+
+typedef ConcurrentHashTable<BenchCHTConfig, mtTest> BenchCHT;
+
+struct BenchCHTLookup {
+  uintptr_t _val;
+  BenchCHTLookup(uintptr_t val) : _val(val) {}
+  uintx get_hash() const {
+    return BenchCHTConfig::get_hash(_val, NULL);
+  }
+  bool equals(const uintptr_t* value, bool* is_dead) {
+    return _val == *value;
+  }
+};
+
+class BenchCHTGet {
+  BenchCHT* _table;
+  size_t _entries;
+public:
+  BenchCHTGet(BenchCHT* table, size_t entries) : _table(table), _entries(entries) {}
+  void operator()(uint id, size_t ops) {
+    Thread* thread = Thread::current();
+    uintptr_t found = 0;
+    auto found_f = [&](uintptr_t* value) { found += *value; };
+    for (size_t i = 0; i < ops; i++) {
+      BenchCHTLookup lookup(((id * ops + i) % _entries) + 1);
+      _table->get(thread, lookup, found_f);
+    }
+    ASSERT_NE(found, (uintptr_t)0);
+  }
+};
+
+TEST_VM(MicroBenchmark, DISABLED_bench_ConcurrentHashTable) {
+  const size_t entries = 64 * K;
+  BenchCHT* table = new BenchCHT(16);
+  for (uintptr_t v = 1; v <= entries; v++) {
+    BenchCHTLookup lookup(v);
+    table->insert(JavaThread::current(), lookup, v);
+  }
+  BenchCHTGet get(table, entries);
+  MicroBenchmark("ConcurrentHashTable::get", BenchOps).run(get);
+  MicroBenchmark("ConcurrentHashTable::get", BenchOps, 4).run(get);
+  delete table;
+}
+
+typedef GenericTaskQueue<size_t, mtTest> BenchTaskQueue;
+
+class BenchTaskQueuePushPop {
+  BenchTaskQueue& _queue;
+public:
+  BenchTaskQueuePushPop(BenchTaskQueue& queue) : _queue(queue) {}
+  void operator()(uint id, size_t ops) {
+    size_t task;
+    for (size_t i = 0; i < ops; i++) {
+      _queue.push(i);
+      if ((i & 63) == 63) {
+        while (_queue.pop_local(task)) {}
+      }
+    }
+    while (_queue.pop_local(task)) {}
+  }
+};
+
+TEST_VM(MicroBenchmark, DISABLED_bench_GenericTaskQueue) {
+  BenchTaskQueue* queue = new BenchTaskQueue();
+  queue->initialize();
+  BenchTaskQueuePushPop push_pop(*queue);
+  MicroBenchmark("GenericTaskQueue::push+pop_local", BenchOps).run(push_pop);
+  delete queue;
+}
+
+class BenchOopStorageAllocRelease {
+  OopStorage* _storage;
+public:
+  BenchOopStorageAllocRelease(OopStorage* storage) : _storage(storage) {}
+  void operator()(uint id, size_t ops) {
+    const size_t batch = 64;
+    oop* entries[batch];
+    for (size_t i = 0; i < ops; i += batch) {
+      for (size_t j = 0; j < batch; j++) {
+        entries[j] = _storage->allocate();
+        ASSERT_TRUE(entries[j] != NULL);
+      }
+      for (size_t j = 0; j < batch; j++) {
+        _storage->release(entries[j]);
+      }
+    }
+  }
+};
+
+TEST_VM(MicroBenchmark, DISABLED_bench_OopStorage) {
+  OopStorage storage("Benchmark Storage", mtTest);
+  BenchOopStorageAllocRelease alloc_release(&storage);
+  MicroBenchmark("OopStorage::allocate+release", BenchOps).run(alloc_release);
+  MicroBenchmark("OopStorage::allocate+release", BenchOps, 4).run(alloc_release);
+}
@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Array copies and fills past ArrayCopyNonTemporalThreshold use
+ *          non-temporal stores; check the results for all element types,
+ *          offsets and lengths, including overlapping conjoint copies
+ * @requires vm.compiler2.enabled
+ * @requires os.arch == "amd64" | os.arch == "x86_64"
+ * @run main/othervm -Xbatch -XX:+UnlockDiagnosticVMOptions -XX:ArrayCopyNonTemporalThreshold=256
+ *      -XX:+OptimizeFill compiler.arraycopy.TestArrayCopyNonTemporal
+ * @run main/othervm -Xbatch -XX:+UnlockDiagnosticVMOptions -XX:ArrayCopyNonTemporalThreshold=256
+ *      -XX:AVX3Threshold=0 -XX:+OptimizeFill compiler.arraycopy.TestArrayCopyNonTemporal
+ * @run main/othervm -Xbatch -XX:+UnlockDiagnosticVMOptions -XX:ArrayCopyNonTemporalThreshold=0
+ *      -XX:+OptimizeFill compiler.arraycopy.TestArrayCopyNonTemporal
+ */
+
+package compiler.arraycopy;
+
+public class TestArrayCopyNonTemporal {
+    // Lengths in elements around the small threshold and a few larger ones
+    static final int[] LENGTHS = { 0, 1, 7, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255, 256, 257,
+                                   511, 1000, 1024, 4099, 65_536 + 3 };
+    static final int[] OFFSETS = { 0, 1, 3, 8, 13 };
+    static final int SLACK = 32;
+
+    static void fail(String what, int i, Object expected, Object actual) {
+        throw new RuntimeException(what + " at " + i + ": expected " + expected + " but got " + actual);
+    }
+
+    static byte valueByte(int i) {
+        return (byte)(i * 0x9E3779B1 + 17);
+    }
+
+    static byte[] initByte(int n) {
+        byte[] a = new byte[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = valueByte(i);
+        }
+        return a;
+    }
+
+    static void copyByte(byte[] src, int srcPos, byte[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void fillByte(byte[] a, int from, int to, byte v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void testByte(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        byte[] src = initByte(n);
+        byte[] dst = new byte[n];
+        copyByte(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            byte expected = (i >= dstOff && i < dstOff + len) ? valueByte(i - dstOff + srcOff) : 0;
+            if (dst[i] != expected) {
+                fail("byte disjoint copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+
+        // Overlapping copies within one array, both directions
+        byte[] a = initByte(n);
+        copyByte(a, srcOff, a, dstOff + SLACK / 2, len);
+        for (int i = 0; i < n; i++) {
+            int d = dstOff + SLACK / 2;
+            byte expected = (i >= d && i < d + len) ? valueByte(i - d + srcOff) : valueByte(i);
+            if (a[i] != expected) {
+                fail("byte conjoint copy len " + len + " " + srcOff + " -> " + d, i, expected, a[i]);
+            }
+        }
+        a = initByte(n);
+        copyByte(a, srcOff + SLACK / 2, a, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int s = srcOff + SLACK / 2;
+            byte expected = (i >= dstOff && i < dstOff + len) ? valueByte(i - dstOff + s) : valueByte(i);
+            if (a[i] != expected) {
+                fail("byte conjoint copy len " + len + " " + s + " -> " + dstOff, i, expected, a[i]);
+            }
+        }
+
+        a = initByte(n);
+        byte v = valueByte(-1);
+        fillByte(a, dstOff, dstOff + len, v);
+        for (int i = 0; i < n; i++) {
+            byte expected = (i >= dstOff && i < dstOff + len) ? v : valueByte(i);
+            if (a[i] != expected) {
+                fail("byte fill len " + len + " from " + dstOff, i, expected, a[i]);
+            }
+        }
+    }
+
+    static short valueShort(int i) {
+        return (short)(i * 0x9E3779B1 + 17);
+    }
+
+    static short[] initShort(int n) {
+        short[] a = new short[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = valueShort(i);
+        }
+        return a;
+    }
+
+    static void copyShort(short[] src, int srcPos, short[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void fillShort(short[] a, int from, int to, short v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void testShort(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        short[] src = initShort(n);
+        short[] dst = new short[n];
+        copyShort(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            short expected = (i >= dstOff && i < dstOff + len) ? valueShort(i - dstOff + srcOff) : 0;
+            if (dst[i] != expected) {
+                fail("short disjoint copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+
+        // Overlapping copies within one array, both directions
+        short[] a = initShort(n);
+        copyShort(a, srcOff, a, dstOff + SLACK / 2, len);
+        for (int i = 0; i < n; i++) {
+            int d = dstOff + SLACK / 2;
+            short expected = (i >= d && i < d + len) ? valueShort(i - d + srcOff) : valueShort(i);
+            if (a[i] != expected) {
+                fail("short conjoint copy len " + len + " " + srcOff + " -> " + d, i, expected, a[i]);
+            }
+        }
+        a = initShort(n);
+        copyShort(a, srcOff + SLACK / 2, a, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int s = srcOff + SLACK / 2;
+            short expected = (i >= dstOff && i < dstOff + len) ? valueShort(i - dstOff + s) : valueShort(i);
+            if (a[i] != expected) {
+                fail("short conjoint copy len " + len + " " + s + " -> " + dstOff, i, expected, a[i]);
+            }
+        }
+
+        a = initShort(n);
+        short v = valueShort(-1);
+        fillShort(a, dstOff, dstOff + len, v);
+        for (int i = 0; i < n; i++) {
+            short expected = (i >= dstOff && i < dstOff + len) ? v : valueShort(i);
+            if (a[i] != expected) {
+                fail("short fill len " + len + " from " + dstOff, i, expected, a[i]);
+            }
+        }
+    }
+
+    static char valueChar(int i) {
+        return (char)(i * 0x9E3779B1 + 17);
+    }
+
+    static char[] initChar(int n) {
+        char[] a = new char[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = valueChar(i);
+        }
+        return a;
+    }
+
+    static void copyChar(char[] src, int srcPos, char[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void fillChar(char[] a, int from, int to, char v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void testChar(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        char[] src = initChar(n);
+        char[] dst = new char[n];
+        copyChar(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            char expected = (i >= dstOff && i < dstOff + len) ? valueChar(i - dstOff + srcOff) : 0;
+            if (dst[i] != expected) {
+                fail("char disjoint copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+
+        // Overlapping copies within one array, both directions
+        char[] a = initChar(n);
+        copyChar(a, srcOff, a, dstOff + SLACK / 2, len);
+        for (int i = 0; i < n; i++) {
+            int d = dstOff + SLACK / 2;
+            char expected = (i >= d && i < d + len) ? valueChar(i - d + srcOff) : valueChar(i);
+            if (a[i] != expected) {
+                fail("char conjoint copy len " + len + " " + srcOff + " -> " + d, i, expected, a[i]);
+            }
+        }
+        a = initChar(n);
+        copyChar(a, srcOff + SLACK / 2, a, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int s = srcOff + SLACK / 2;
+            char expected = (i >= dstOff && i < dstOff + len) ? valueChar(i - dstOff + s) : valueChar(i);
+            if (a[i] != expected) {
+                fail("char conjoint copy len " + len + " " + s + " -> " + dstOff, i, expected, a[i]);
+            }
+        }
+
+        a = initChar(n);
+        char v = valueChar(-1);
+        fillChar(a, dstOff, dstOff + len, v);
+        for (int i = 0; i < n; i++) {
+            char expected = (i >= dstOff && i < dstOff + len) ? v : valueChar(i);
+            if (a[i] != expected) {
+                fail("char fill len " + len + " from " + dstOff, i, expected, a[i]);
+            }
+        }
+    }
+
+    static int valueInt(int i) {
+        return (i * 0x9E3779B1 + 17);
+    }
+
+    static int[] initInt(int n) {
+        int[] a = new int[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = valueInt(i);
+        }
+        return a;
+    }
+
+    static void copyInt(int[] src, int srcPos, int[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void fillInt(int[] a, int from, int to, int v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void testInt(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        int[] src = initInt(n);
+        int[] dst = new int[n];
+        copyInt(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int expected = (i >= dstOff && i < dstOff + len) ? valueInt(i - dstOff + srcOff) : 0;
+            if (dst[i] != expected) {
+                fail("int disjoint copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+
+        // Overlapping copies within one array, both directions
+        int[] a = initInt(n);
+        copyInt(a, srcOff, a, dstOff + SLACK / 2, len);
+        for (int i = 0; i < n; i++) {
+            int d = dstOff + SLACK / 2;
+            int expected = (i >= d && i < d + len) ? valueInt(i - d + srcOff) : valueInt(i);
+            if (a[i] != expected) {
+                fail("int conjoint copy len " + len + " " + srcOff + " -> " + d, i, expected, a[i]);
+            }
+        }
+        a = initInt(n);
+        copyInt(a, srcOff + SLACK / 2, a, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int s = srcOff + SLACK / 2;
+            int expected = (i >= dstOff && i < dstOff + len) ? valueInt(i - dstOff + s) : valueInt(i);
+            if (a[i] != expected) {
+                fail("int conjoint copy len " + len + " " + s + " -> " + dstOff, i, expected, a[i]);
+            }
+        }
+
+        a = initInt(n);
+        int v = valueInt(-1);
+        fillInt(a, dstOff, dstOff + len, v);
+        for (int i = 0; i < n; i++) {
+            int expected = (i >= dstOff && i < dstOff + len) ? v : valueInt(i);
+            if (a[i] != expected) {
+                fail("int fill len " + len + " from " + dstOff, i, expected, a[i]);
+            }
+        }
+    }
+
+    static long valueLong(int i) {
+        return (i * 0x9E3779B1 + 17);
+    }
+
+    static long[] initLong(int n) {
+        long[] a = new long[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = valueLong(i);
+        }
+        return a;
+    }
+
+    static void copyLong(long[] src, int srcPos, long[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void fillLong(long[] a, int from, int to, long v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void testLong(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        long[] src = initLong(n);
+        long[] dst = new long[n];
+        copyLong(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            long expected = (i >= dstOff && i < dstOff + len) ? valueLong(i - dstOff + srcOff) : 0;
+            if (dst[i] != expected) {
+                fail("long disjoint copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+
+        // Overlapping copies within one array, both directions
+        long[] a = initLong(n);
+        copyLong(a, srcOff, a, dstOff + SLACK / 2, len);
+        for (int i = 0; i < n; i++) {
+            int d = dstOff + SLACK / 2;
+            long expected = (i >= d && i < d + len) ? valueLong(i - d + srcOff) : valueLong(i);
+            if (a[i] != expected) {
+                fail("long conjoint copy len " + len + " " + srcOff + " -> " + d, i, expected, a[i]);
+            }
+        }
+        a = initLong(n);
+        copyLong(a, srcOff + SLACK / 2, a, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int s = srcOff + SLACK / 2;
+            long expected = (i >= dstOff && i < dstOff + len) ? valueLong(i - dstOff + s) : valueLong(i);
+            if (a[i] != expected) {
+                fail("long conjoint copy len " + len + " " + s + " -> " + dstOff, i, expected, a[i]);
+            }
+        }
+
+        a = initLong(n);
+        long v = valueLong(-1);
+        fillLong(a, dstOff, dstOff + len, v);
+        for (int i = 0; i < n; i++) {
+            long expected = (i >= dstOff && i < dstOff + len) ? v : valueLong(i);
+            if (a[i] != expected) {
+                fail("long fill len " + len + " from " + dstOff, i, expected, a[i]);
+            }
+        }
+    }
+
+    static float valueFloat(int i) {
+        return (float)(i * 0x9E3779B1 + 17);
+    }
+
+    static float[] initFloat(int n) {
+        float[] a = new float[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = valueFloat(i);
+        }
+        return a;
+    }
+
+    static void copyFloat(float[] src, int srcPos, float[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void fillFloat(float[] a, int from, int to, float v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void testFloat(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        float[] src = initFloat(n);
+        float[] dst = new float[n];
+        copyFloat(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            float expected = (i >= dstOff && i < dstOff + len) ? valueFloat(i - dstOff + srcOff) : 0;
+            if (dst[i] != expected) {
+                fail("float disjoint copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+
+        // Overlapping copies within one array, both directions
+        float[] a = initFloat(n);
+        copyFloat(a, srcOff, a, dstOff + SLACK / 2, len);
+        for (int i = 0; i < n; i++) {
+            int d = dstOff + SLACK / 2;
+            float expected = (i >= d && i < d + len) ? valueFloat(i - d + srcOff) : valueFloat(i);
+            if (a[i] != expected) {
+                fail("float conjoint copy len " + len + " " + srcOff + " -> " + d, i, expected, a[i]);
+            }
+        }
+        a = initFloat(n);
+        copyFloat(a, srcOff + SLACK / 2, a, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int s = srcOff + SLACK / 2;
+            float expected = (i >= dstOff && i < dstOff + len) ? valueFloat(i - dstOff + s) : valueFloat(i);
+            if (a[i] != expected) {
+                fail("float conjoint copy len " + len + " " + s + " -> " + dstOff, i, expected, a[i]);
+            }
+        }
+
+        a = initFloat(n);
+        float v = valueFloat(-1);
+        fillFloat(a, dstOff, dstOff + len, v);
+        for (int i = 0; i < n; i++) {
+            float expected = (i >= dstOff && i < dstOff + len) ? v : valueFloat(i);
+            if (a[i] != expected) {
+                fail("float fill len " + len + " from " + dstOff, i, expected, a[i]);
+            }
+        }
+    }
+
+    static double valueDouble(int i) {
+        return (double)(i * 0x9E3779B1 + 17);
+    }
+
+    static double[] initDouble(int n) {
+        double[] a = new double[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = valueDouble(i);
+        }
+        return a;
+    }
+
+    static void copyDouble(double[] src, int srcPos, double[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void fillDouble(double[] a, int from, int to, double v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void testDouble(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        double[] src = initDouble(n);
+        double[] dst = new double[n];
+        copyDouble(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            double expected = (i >= dstOff && i < dstOff + len) ? valueDouble(i - dstOff + srcOff) : 0;
+            if (dst[i] != expected) {
+                fail("double disjoint copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+
+        // Overlapping copies within one array, both directions
+        double[] a = initDouble(n);
+        copyDouble(a, srcOff, a, dstOff + SLACK / 2, len);
+        for (int i = 0; i < n; i++) {
+            int d = dstOff + SLACK / 2;
+            double expected = (i >= d && i < d + len) ? valueDouble(i - d + srcOff) : valueDouble(i);
+            if (a[i] != expected) {
+                fail("double conjoint copy len " + len + " " + srcOff + " -> " + d, i, expected, a[i]);
+            }
+        }
+        a = initDouble(n);
+        copyDouble(a, srcOff + SLACK / 2, a, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            int s = srcOff + SLACK / 2;
+            double expected = (i >= dstOff && i < dstOff + len) ? valueDouble(i - dstOff + s) : valueDouble(i);
+            if (a[i] != expected) {
+                fail("double conjoint copy len " + len + " " + s + " -> " + dstOff, i, expected, a[i]);
+            }
+        }
+
+        a = initDouble(n);
+        double v = valueDouble(-1);
+        fillDouble(a, dstOff, dstOff + len, v);
+        for (int i = 0; i < n; i++) {
+            double expected = (i >= dstOff && i < dstOff + len) ? v : valueDouble(i);
+            if (a[i] != expected) {
+                fail("double fill len " + len + " from " + dstOff, i, expected, a[i]);
+            }
+        }
+    }
+
+    static Object valueObject(int i) {
+        return Integer.valueOf(i);
+    }
+
+    static void copyObject(Object[] src, int srcPos, Object[] dst, int dstPos, int len) {
+        System.arraycopy(src, srcPos, dst, dstPos, len);
+    }
+
+    static void testObject(int len, int srcOff, int dstOff) {
+        int n = len + 2 * SLACK;
+        Object[] src = new Object[n];
+        for (int i = 0; i < n; i++) {
+            src[i] = valueObject(i);
+        }
+        Object[] dst = new Object[n];
+        copyObject(src, srcOff, dst, dstOff, len);
+        for (int i = 0; i < n; i++) {
+            Object expected = (i >= dstOff && i < dstOff + len) ? src[i - dstOff + srcOff] : null;
+            if (dst[i] != expected) {
+                fail("Object copy len " + len + " " + srcOff + " -> " + dstOff, i, expected, dst[i]);
+            }
+        }
+    }
+
+    static void testAll(int len, int srcOff, int dstOff) {
+        testByte(len, srcOff, dstOff);
+        testShort(len, srcOff, dstOff);
+        testChar(len, srcOff, dstOff);
+        testInt(len, srcOff, dstOff);
+        testLong(len, srcOff, dstOff);
+        testFloat(len, srcOff, dstOff);
+        testDouble(len, srcOff, dstOff);
+        testObject(len, srcOff, dstOff);
+    }
+
+    public static void main(String[] args) {
+        // Compile the copies and fills with short arrays first
+        for (int i = 0; i < 10_000; i++) {
+            testAll(i % 300, i % 5, (i / 5) % 5);
+        }
+        for (int len : LENGTHS) {
+            for (int srcOff : OFFSETS) {
+                for (int dstOff : OFFSETS) {
+                    testAll(len, srcOff, dstOff);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary C1 loop invariant code motion must keep loads that a store of
+ *          the same loop may change, and may hoist the others, also in
+ *          methods with several loops
+ * @requires vm.compiler1.enabled
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1
+ *      -XX:CompileCommand=compileonly,compiler.c1.TestLoopInvariantStores::test*
+ *      compiler.c1.TestLoopInvariantStores
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3
+ *      -XX:CompileCommand=compileonly,compiler.c1.TestLoopInvariantStores::test*
+ *      compiler.c1.TestLoopInvariantStores
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1 -XX:-UseLoopInvariantCodeMotion
+ *      -XX:CompileCommand=compileonly,compiler.c1.TestLoopInvariantStores::test*
+ *      compiler.c1.TestLoopInvariantStores
+ */
+
+package compiler.c1;
+
+public class TestLoopInvariantStores {
+    static class Super {
+        int f;
+    }
+
+    static class Holder extends Super {
+        int g;
+        int h;
+        long l;
+    }
+
+    static class Other {
+        int f;
+    }
+
+    // A store to a.f in the first loop must not keep a.f from being
+    // hoisted from the second loop, which does not store it
+    static int testStoreInEarlierLoop(Holder a, int n) {
+        for (int i = 0; i < n; i++) {
+            a.f = i;
+        }
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += a.f + a.g;
+        }
+        return sum;
+    }
+
+    // Stores to another int field do not change a.g, but stores to a.f
+    // through a possibly aliased reference do change a.f
+    static int testAliasedStore(Holder a, Holder b, int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += a.f + a.g;
+            b.f = i;
+            b.h = -i;
+        }
+        return sum;
+    }
+
+    // The store through the subclass and the load through the superclass
+    // hit the same field
+    static int testStoreThroughSubclass(Super s, Holder h, int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += s.f;
+            h.f = i + 1;
+        }
+        return sum;
+    }
+
+    // Same offset, different holder: Other.f does not alias Holder.f
+    static int testOtherHolder(Holder a, Other o, int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += a.f;
+            o.f = i;
+        }
+        return sum;
+    }
+
+    // The lcmp of invariant operands can be hoisted, the one of a changing
+    // field must not be
+    static int testLongCompare(Holder a, long x, int n) {
+        int count = 0;
+        for (int i = 0; i < n; i++) {
+            if (a.l > x) {
+                count++;
+            }
+            a.l = x + 1 - (i & 1) * 2;
+        }
+        return count;
+    }
+
+    // An array store in the first loop, array loads in the second, and an
+    // array store that aliases the loads in the third
+    static int testArrays(int[] a, int[] b, int n) {
+        for (int i = 0; i < n; i++) {
+            a[i % a.length] = i;
+        }
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += b[0];
+        }
+        for (int i = 0; i < n; i++) {
+            sum += a[0];
+            b[0] = i;
+        }
+        return sum;
+    }
+
+    static void check(String name, long actual, long expected) {
+        if (actual != expected) {
+            throw new RuntimeException(name + ": " + actual + " != " + expected);
+        }
+    }
+
+    static long triangle(int n) {
+        return (long)n * (n - 1) / 2;
+    }
+
+    public static void main(String[] args) {
+        final int n = 100;
+        for (int iter = 0; iter < 20_000; iter++) {
+            Holder a = new Holder();
+            a.g = 3;
+            check("testStoreInEarlierLoop", testStoreInEarlierLoop(a, n), (long)n * (n - 1 + 3));
+
+            a = new Holder();
+            a.g = 3;
+            check("testAliasedStore(a, a)", testAliasedStore(a, a, n), triangle(n) - (n - 1) + 3L * n);
+            check("a.h", a.h, -(n - 1));
+            Holder b = new Holder();
+            a.f = 5;
+            check("testAliasedStore(a, b)", testAliasedStore(a, b, n), 8L * n);
+
+            a = new Holder();
+            check("testStoreThroughSubclass", testStoreThroughSubclass(a, a, n), triangle(n));
+
+            a = new Holder();
+            a.f = 7;
+            Other o = new Other();
+            check("testOtherHolder", testOtherHolder(a, o, n), 7L * n);
+
+            a = new Holder();
+            a.l = 10;
+            // a.l alternates between x + 1 and x - 1 after the first iteration
+            check("testLongCompare", testLongCompare(a, 5, n), 1 + (n - 1 + 1) / 2);
+
+            int[] arr = new int[4];
+            int[] other = new int[] { 2 };
+            check("testArrays(a, b)", testArrays(arr, other, n), 2L * n + (long)(n - 4) * n);
+            arr = new int[] { 9 };
+            check("testArrays(a, a)", testArrays(arr, arr, n), (long)(n - 1) * n + triangle(n) - (n - 1) + (n - 1));
+        }
+    }
+}
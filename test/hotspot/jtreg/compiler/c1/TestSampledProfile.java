@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Sampled C1 profiling must keep the invocation and backedge counters exact
+ *          and must still profile both directions of a periodic branch
+ * @requires vm.compiler1.enabled & vm.flagless
+ * @library /test/lib
+ * @run driver compiler.c1.TestSampledProfile
+ */
+
+package compiler.c1;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestSampledProfile {
+
+    private static final Pattern COUNTERS = Pattern.compile(
+        "compiler\\.c1\\.TestSampledProfile\\$Workload::hot\\(I\\)I\\s+" +
+        "interpreter_invocation_count:\\s+\\d+\\s+" +
+        "invocation_counter:\\s+(\\d+)\\s+" +
+        "backedge_counter:\\s+(\\d+)");
+
+    private static final Pattern PERIODIC_BRANCH = Pattern.compile(
+        "compiler\\.c1\\.TestSampledProfile\\$Periodic::test\\(I\\)I[^\\n]*\\n" +
+        "(?:[^\\n]*\\n)*?[^\\n]*BranchData[^\\n]*taken\\((\\d+)\\)[^\\n]*\\n" +
+        "\\s*not taken\\((\\d+)\\)");
+
+    public static void main(String[] args) throws Exception {
+        long[] exact = counters(1);
+        Asserts.assertEQ(exact[0], (long) Workload.CALLS, "invocation_counter");
+        Asserts.assertEQ(exact[1], (long) Workload.CALLS * Workload.ITERATIONS, "backedge_counter");
+
+        for (int interval : new int[] { 2, 8, 64 }) {
+            long[] sampled = counters(interval);
+            Asserts.assertEQ(sampled[0], exact[0], "invocation_counter with C1ProfileSampleInterval=" + interval);
+            Asserts.assertEQ(sampled[1], exact[1], "backedge_counter with C1ProfileSampleInterval=" + interval);
+        }
+
+        for (int interval : new int[] { 16, 32, 64 }) {
+            periodicBranch(interval);
+        }
+
+        OutputAnalyzer output = run(Workload.class, "-XX:C1ProfileSampleInterval=12");
+        output.shouldNotHaveExitValue(0);
+        output.shouldContain("must be a power of two");
+    }
+
+    private static OutputAnalyzer run(Class<?> workload, String... flags) throws Exception {
+        List<String> args = new ArrayList<>(List.of(
+            "-Xbatch",
+            "-XX:TieredStopAtLevel=3",
+            "-XX:CompileCommand=quiet",
+            "-XX:CompileCommand=dontinline,compiler.c1.TestSampledProfile$*::*",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+PrintMethodData"));
+        args.addAll(List.of(flags));
+        args.add(workload.getName());
+        return new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(args).start());
+    }
+
+    private static long[] counters(int interval) throws Exception {
+        OutputAnalyzer output = run(Workload.class, "-XX:C1ProfileSampleInterval=" + interval);
+        output.shouldHaveExitValue(0);
+        Matcher m = COUNTERS.matcher(output.getStdout());
+        Asserts.assertTrue(m.find(), "No profile printed for Workload::hot");
+        return new long[] { Long.parseLong(m.group(1)), Long.parseLong(m.group(2)) };
+    }
+
+    // The rare direction of a branch whose outcome repeats with the same
+    // period as the sampling interval must still be seen, and with about
+    // its real frequency. A fixed sampling period would either never see
+    // it or see only it.
+    private static void periodicBranch(int interval) throws Exception {
+        // Keep the caller's loop interpreted, so that the branch in test()
+        // is the only sampled profile update of each call.
+        OutputAnalyzer output = run(Periodic.class, "-XX:C1ProfileSampleInterval=" + interval,
+                                    "-XX:-UseOnStackReplacement",
+                                    "-DPERIOD=" + interval);
+        output.shouldHaveExitValue(0);
+        Matcher m = PERIODIC_BRANCH.matcher(output.getStdout());
+        Asserts.assertTrue(m.find(), "No branch profile printed for Periodic::test");
+        // The bytecode branch is taken for the common direction
+        long common = Long.parseLong(m.group(1));
+        long rare = Long.parseLong(m.group(2));
+        double expected = (double) (common + rare) / interval;
+        System.out.println("C1ProfileSampleInterval=" + interval + ": taken " + common +
+                           ", not taken " + rare + ", expected not taken " + expected);
+        Asserts.assertGT(common + rare, (long) Periodic.CALLS / 2, "branch profile too small");
+        Asserts.assertGT((double) rare, expected / 2, "rare branch direction under-sampled");
+        Asserts.assertLT((double) rare, expected * 2, "rare branch direction over-sampled");
+    }
+
+    static class Workload {
+        static final int CALLS = 50_000;
+        static final int ITERATIONS = 10;
+
+        static int hot(int x) {
+            int sum = 0;
+            for (int i = 0; i < ITERATIONS; i++) {
+                if ((x & i) != 0) {
+                    sum += i;
+                } else {
+                    sum -= x;
+                }
+            }
+            return sum;
+        }
+
+        public static void main(String[] args) {
+            int sum = 0;
+            for (int i = 0; i < CALLS; i++) {
+                sum += hot(i);
+            }
+            System.out.println(sum);
+        }
+    }
+
+    static class Periodic {
+        static final int CALLS = 1_000_000;
+        static final int PERIOD = Integer.getInteger("PERIOD");
+
+        static int test(int x) {
+            if ((x & (PERIOD - 1)) != 0) {
+                return 1;
+            }
+            return 2;
+        }
+
+        public static void main(String[] args) {
+            int sum = 0;
+            for (int i = 0; i < CALLS; i++) {
+                sum += test(i);
+            }
+            System.out.println(sum);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Write a compilation profile at exit and read it back in a later run
+ * @requires vm.compiler2.enabled & vm.flagless
+ * @library /test/lib
+ * @run driver compiler.c2.TestCompilationProfile
+ */
+
+package compiler.c2;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestCompilationProfile {
+
+    private static final String METHOD = "compiler/c2/TestCompilationProfile$Workload hot (I)I";
+
+    public static void main(String[] args) throws Exception {
+        Path profile = Path.of("compilation.profile").toAbsolutePath();
+
+        // Training run
+        OutputAnalyzer output = run("-XX:DumpCompilationProfileAtExit=" + profile);
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("Wrote [1-9][0-9]* methods to compilation profile");
+
+        List<String> lines = Files.readAllLines(profile);
+        Asserts.assertTrue(lines.get(0).startsWith("# compilation profile "), "Bad header: " + lines.get(0));
+        String entry = lines.stream().filter(l -> l.startsWith(METHOD + " ")).findFirst().orElse(null);
+        Asserts.assertNotNull(entry, "Hot method not in the profile");
+        String[] counts = entry.substring(METHOD.length() + 1).split(" ");
+        Asserts.assertGT(Integer.parseInt(counts[0]) + Integer.parseInt(counts[1]), 0, "No counts: " + entry);
+
+        // Seeded run
+        output = run("-XX:CompilationProfileFile=" + profile);
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("Read [1-9][0-9]* methods from compilation profile");
+
+        // A profile of another VM release is ignored
+        lines.set(0, "# compilation profile 1 not-this-release");
+        Files.write(profile, lines);
+        output = run("-XX:CompilationProfileFile=" + profile);
+        output.shouldHaveExitValue(0);
+        output.shouldContain("written by a different VM");
+    }
+
+    private static OutputAnalyzer run(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            flag,
+            "-Xlog:jit+compilation=info",
+            Workload.class.getName());
+        return new OutputAnalyzer(pb.start());
+    }
+
+    static class Workload {
+        static int hot(int x) {
+            int sum = 0;
+            for (int i = 0; i < 100; i++) {
+                sum += x ^ i;
+            }
+            return sum;
+        }
+
+        public static void main(String[] args) {
+            int sum = 0;
+            for (int i = 0; i < 200_000; i++) {
+                sum += hot(i);
+            }
+            System.out.println(sum);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test id=Z
+ * @summary Leaf methods compiled without return polls must not break
+ *          safepoints, handshakes or concurrent stack processing
+ * @requires vm.compiler2.enabled & vm.gc.Z
+ * @run main/othervm -XX:-TieredCompilation -XX:+UnlockDiagnosticVMOptions
+ *      -XX:+ElideLeafReturnPolls -XX:+UseZGC -Xmx256m
+ *      -XX:CompileCommand=dontinline,compiler.c2.TestElideLeafReturnPolls::leaf*
+ *      compiler.c2.TestElideLeafReturnPolls
+ */
+
+/*
+ * @test id=default
+ * @summary Leaf methods compiled without return polls must not break
+ *          safepoints, handshakes or concurrent stack processing
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -XX:-TieredCompilation -XX:+UnlockDiagnosticVMOptions
+ *      -XX:+ElideLeafReturnPolls -XX:+SafepointALot -XX:GuaranteedSafepointInterval=1
+ *      -XX:CompileCommand=dontinline,compiler.c2.TestElideLeafReturnPolls::leaf*
+ *      compiler.c2.TestElideLeafReturnPolls
+ */
+
+package compiler.c2;
+
+import java.util.concurrent.atomic.AtomicBoolean;
+
+public class TestElideLeafReturnPolls {
+    private static final int WORKERS = 4;
+    private static final long DURATION_MS = 5_000;
+
+    static class Node {
+        Node next;
+        int value;
+
+        Node(Node next, int value) {
+            this.next = next;
+            this.value = value;
+        }
+    }
+
+    // Leaf methods without loops or calls, compiled on their own (not inlined)
+    // and so without a return poll.
+    static Node leafNext(Node n) {
+        return n.next;
+    }
+
+    static int leafValue(Node n, int x) {
+        return n.value * 31 + x;
+    }
+
+    // The caller loops, allocates and so polls; the leaves return into it.
+    static long work(int length, int rounds) {
+        Node head = null;
+        for (int i = 0; i < length; i++) {
+            head = new Node(head, i);
+        }
+        long sum = 0;
+        for (int r = 0; r < rounds; r++) {
+            for (Node n = head; n != null; n = leafNext(n)) {
+                sum += leafValue(n, r);
+            }
+        }
+        return sum;
+    }
+
+    static long expected(int length, int rounds) {
+        long sum = 0;
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < length; i++) {
+                sum += i * 31 + r;
+            }
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) throws Exception {
+        final int length = 1000;
+        final int rounds = 10;
+        final long expected = expected(length, rounds);
+        AtomicBoolean done = new AtomicBoolean();
+        Thread[] workers = new Thread[WORKERS];
+        Throwable[] failure = new Throwable[1];
+        for (int t = 0; t < WORKERS; t++) {
+            workers[t] = new Thread(() -> {
+                while (!done.get()) {
+                    long sum = work(length, rounds);
+                    if (sum != expected) {
+                        throw new RuntimeException("expected " + expected + " but got " + sum);
+                    }
+                }
+            });
+            workers[t].setUncaughtExceptionHandler((th, e) -> failure[0] = e);
+            workers[t].start();
+        }
+
+        // Handshake every worker repeatedly and keep the GC busy.
+        long end = System.currentTimeMillis() + DURATION_MS;
+        while (System.currentTimeMillis() < end) {
+            Thread.getAllStackTraces();
+            for (Thread w : workers) {
+                w.getStackTrace();
+            }
+            System.gc();
+        }
+        done.set(true);
+        for (Thread w : workers) {
+            w.join();
+        }
+        if (failure[0] != null) {
+            throw new RuntimeException("worker failed", failure[0]);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Latin1 String.indexOf(String) around the 32 position block of
+ *          the AVX2 first and last byte filtering kernel
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestLatin1IndexOfBoundary::indexOf
+ *      compiler.c2.TestLatin1IndexOfBoundary
+ */
+
+/**
+ * @test
+ * @requires vm.compiler2.enabled & (os.arch == "amd64" | os.arch == "x86_64")
+ * @requires vm.cpu.features ~= ".*avx2.*"
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:UseAVX=1
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestLatin1IndexOfBoundary::indexOf
+ *      compiler.c2.TestLatin1IndexOfBoundary
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:UseAVX=2
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestLatin1IndexOfBoundary::indexOf
+ *      compiler.c2.TestLatin1IndexOfBoundary
+ */
+
+package compiler.c2;
+
+public class TestLatin1IndexOfBoundary {
+
+    private static final int WARMUP = 20_000;
+
+    static int indexOf(String str, String sub) {
+        return str.indexOf(sub);
+    }
+
+    static int reference(String str, String sub) {
+        outer:
+        for (int i = 0; i + sub.length() <= str.length(); i++) {
+            for (int j = 0; j < sub.length(); j++) {
+                if (str.charAt(i + j) != sub.charAt(j)) {
+                    continue outer;
+                }
+            }
+            return i;
+        }
+        return -1;
+    }
+
+    static String filled(int length, char c) {
+        return String.valueOf(c).repeat(length);
+    }
+
+    static void check(String str, String sub) {
+        int expected = reference(str, sub);
+        int actual = indexOf(str, sub);
+        if (actual != expected) {
+            throw new RuntimeException("indexOf(\"" + str + "\", \"" + sub + "\") = " + actual +
+                                       ", expected " + expected);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < WARMUP; i++) {
+            indexOf("abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz", "xyzab");
+            indexOf("abcdefghijklmnopqrstuvwxyz", "nop");
+        }
+
+        for (int sublen = 1; sublen <= 40; sublen++) {
+            // Needle: first byte 'f', last byte 'l', 'm' in between, so that
+            // haystacks of 'f' and 'l' pass the first or last byte filter only.
+            StringBuilder sb = new StringBuilder("f");
+            for (int k = 1; k < sublen - 1; k++) {
+                sb.append('m');
+            }
+            if (sublen > 1) {
+                sb.append('l');
+            }
+            String sub = sb.toString();
+
+            // Number of start positions below, at and above one and two blocks.
+            for (int positions = 1; positions <= 70; positions++) {
+                int strlen = positions + sublen - 1;
+
+                check(filled(strlen, 'a'), sub);
+                check(filled(strlen, 'f'), sub);
+                check(filled(strlen, 'l'), sub);
+
+                // A match at every start position, including the last one.
+                for (int pos = 0; pos < positions; pos++) {
+                    String str = filled(pos, 'a') + sub + filled(positions - 1 - pos, 'a');
+                    check(str, sub);
+
+                    // A candidate that passes both filters but differs inside.
+                    if (sublen > 2) {
+                        String near = filled(pos, 'a') + "f" + filled(sublen - 2, 'n') + "l" +
+                                      filled(positions - 1 - pos, 'a');
+                        check(near, sub);
+                        check(near + sub, sub);
+                    }
+                }
+            }
+        }
+    }
+}
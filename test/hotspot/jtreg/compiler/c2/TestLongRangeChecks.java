@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Range checks on the iv of long counted loops are turned into int
+ *          range checks of the inner loop; results and exceptions must be
+ *          the same as with the long checks
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestLongRangeChecks::test*
+ *      compiler.c2.TestLongRangeChecks
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:LoopStripMiningIter=0
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestLongRangeChecks::test*
+ *      compiler.c2.TestLongRangeChecks
+ */
+
+package compiler.c2;
+
+import java.util.Objects;
+
+public class TestLongRangeChecks {
+    interface Loop {
+        long run(long start, long stop, long offset, long range);
+    }
+
+    static long testUp(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i < stop; i++) {
+            sum += Objects.checkIndex(i + offset, range);
+        }
+        return sum;
+    }
+
+    static long testUpStride3(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i < stop; i += 3) {
+            sum += Objects.checkIndex(i + offset, range);
+        }
+        return sum;
+    }
+
+    static long testUpScale4(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i < stop; i++) {
+            sum += Objects.checkIndex(4 * i + offset, range);
+        }
+        return sum;
+    }
+
+    // The inner loop only runs a few thousand iterations with such a scale,
+    // so the checks are recomputed for many outer loop iterations.
+    static long testUpShift20(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i < stop; i++) {
+            sum += Objects.checkIndex((i << 20) + offset, range);
+        }
+        return sum;
+    }
+
+    static long testUpScaleMinus1(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i < stop; i++) {
+            sum += Objects.checkIndex(offset - i, range);
+        }
+        return sum;
+    }
+
+    static long testDown(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i > stop; i--) {
+            sum += Objects.checkIndex(i + offset, range);
+        }
+        return sum;
+    }
+
+    static long testDownStride2Scale8(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i > stop; i -= 2) {
+            sum += Objects.checkIndex(8 * i + offset, range);
+        }
+        return sum;
+    }
+
+    // Reference versions, run in the interpreter
+    static long reference(long start, long stop, long stride, long scale, long offset, long range) {
+        long sum = 0;
+        for (long i = start; stride > 0 ? i < stop : i > stop; i += stride) {
+            sum += Objects.checkIndex(scale * i + offset, range);
+        }
+        return sum;
+    }
+
+    static long referenceMinus1(long start, long stop, long offset, long range) {
+        long sum = 0;
+        for (long i = start; i < stop; i++) {
+            sum += Objects.checkIndex(offset - i, range);
+        }
+        return sum;
+    }
+
+    static String result(Loop loop, long start, long stop, long offset, long range) {
+        try {
+            return "sum " + loop.run(start, stop, offset, range);
+        } catch (IndexOutOfBoundsException e) {
+            return e.getMessage();
+        }
+    }
+
+    static void check(String name, Loop test, Loop reference, long start, long stop, long offset, long range) {
+        String expected = result(reference, start, stop, offset, range);
+        String actual = result(test, start, stop, offset, range);
+        if (!expected.equals(actual)) {
+            throw new RuntimeException(name + "(" + start + ", " + stop + ", " + offset + ", " + range +
+                                       "): expected '" + expected + "' but got '" + actual + "'");
+        }
+    }
+
+    static final long MAX = Long.MAX_VALUE;
+    static final long MIN = Long.MIN_VALUE;
+
+    // start, stop, offset, range for loops counting up
+    static final long[][] UP_CASES = {
+        { 0, 1000, 0, 1000 },
+        { 0, 1000, 0, 999 },                 // fails in the last iteration
+        { 0, 1000, -1, 1000 },               // fails in the first iteration
+        { 10, 100_000, 5, 100_000 },         // fails late, after many inner iterations
+        { -50, 1000, 50, 2000 },
+        { MAX - 1000, MAX - 10, -(MAX - 2000), 2000 },
+        { MAX - 1000, MAX - 10, 100, MAX },  // i + offset overflows
+        { MAX - 1000, MAX - 1, -(MAX - 1000), MAX },
+        { MIN, MIN + 1000, MAX, MAX },       // i + offset is -1 at first
+        { MIN + 10, MIN + 1000, MAX, MAX },
+        { 0, 1_000_000, 0, 1_000_000 },
+        { 0, 1_000_000, 0, 999_999 },
+        { (1L << 32) - 100, (1L << 32) + 100, -(1L << 32) + 100, 200 },
+        { (1L << 32) - 100, (1L << 32) + 100, -(1L << 32) + 100, 199 },
+    };
+
+    // start, stop, offset, range for loops counting down
+    static final long[][] DOWN_CASES = {
+        { 1000, 0, 0, 1001 },
+        { 1000, 0, 0, 1000 },                // fails in the first iteration
+        { 1000, -1, 0, 1001 },               // fails in the last iteration
+        { 100_000, 10, -5, 100_000 },
+        { MIN + 1000, MIN + 10, -(MIN + 2000), 2000 },
+        { MIN + 1000, MIN + 10, -100, MAX }, // i + offset overflows
+        { MAX, MAX - 1000, MIN, 1000 },      // i + offset is -1 at first
+        { 1_000_000, 0, 0, 1_000_001 },
+        { (1L << 32) + 100, (1L << 32) - 100, -(1L << 32) + 100, 201 },
+        { (1L << 32) + 100, (1L << 32) - 100, -(1L << 32) + 99, 201 },
+    };
+
+    // start, stop, offset, range for testUpShift20
+    static final long[][] SHIFT_CASES = {
+        { 0, 100_000, 0, 100_000L << 20 },
+        { 0, 100_000, 0, 99_999L << 20 },              // fails in the last iteration
+        { 0, 100_000, 1, (99_999L << 20) + 1 },        // fails in the last iteration
+        { 0, 100_000, -1, 100_000L << 20 },            // fails in the first iteration
+        { 1000, 100_000, -(1000L << 20), 99_000L << 20 },
+        { 1000, 100_000, -(1000L << 20), 50_000L << 20 },
+        { (1L << 43) - 1000, (1L << 43) + 10, 0, MAX }, // i << 20 overflows
+        { -(1L << 43), -(1L << 43) + 1000, MIN, MAX },  // (i << 20) + offset overflows
+    };
+
+    static void checkUp(String name, Loop test, Loop reference) {
+        for (long[] c : UP_CASES) {
+            check(name, test, reference, c[0], c[1], c[2], c[3]);
+        }
+    }
+
+    static void checkDown(String name, Loop test, Loop reference) {
+        for (long[] c : DOWN_CASES) {
+            check(name, test, reference, c[0], c[1], c[2], c[3]);
+        }
+    }
+
+    public static void main(String[] args) {
+        // Warm up without failing checks, then run the cases with the
+        // compiled code, and again after the deoptimizations.
+        for (int i = 0; i < 20; i++) {
+            testUp(0, 10_000, 0, 10_000);
+            testUpStride3(0, 10_000, 0, 10_000);
+            testUpScale4(0, 10_000, 0, 40_000);
+            testUpShift20(0, 10_000, 0, 10_000L << 20);
+            testUpScaleMinus1(0, 10_000, 9_999, 10_000);
+            testDown(10_000, 0, 0, 10_001);
+            testDownStride2Scale8(10_000, 0, 0, 80_001);
+        }
+        for (int round = 0; round < 2; round++) {
+            checkUp("testUp", TestLongRangeChecks::testUp,
+                    (a, b, o, r) -> reference(a, b, 1, 1, o, r));
+            checkUp("testUpStride3", TestLongRangeChecks::testUpStride3,
+                    (a, b, o, r) -> reference(a, b, 3, 1, o, r));
+            checkUp("testUpScale4", TestLongRangeChecks::testUpScale4,
+                    (a, b, o, r) -> reference(a, b, 1, 4, o, r));
+            for (long[] c : SHIFT_CASES) {
+                check("testUpShift20", TestLongRangeChecks::testUpShift20,
+                      (a, b, o, r) -> reference(a, b, 1, 1L << 20, o, r), c[0], c[1], c[2], c[3]);
+            }
+            checkUp("testUpScaleMinus1", TestLongRangeChecks::testUpScaleMinus1,
+                    TestLongRangeChecks::referenceMinus1);
+            checkDown("testDown", TestLongRangeChecks::testDown,
+                      (a, b, o, r) -> reference(a, b, -1, 1, o, r));
+            checkDown("testDownStride2Scale8", TestLongRangeChecks::testDownStride2Scale8,
+                      (a, b, o, r) -> reference(a, b, -2, 8, o, r));
+        }
+    }
+}
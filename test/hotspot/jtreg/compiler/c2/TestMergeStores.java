@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Merging adjacent narrow array stores into wider stores must
+ *          preserve the stored bytes and the exception behavior
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestMergeStores::store*
+ *      compiler.c2.TestMergeStores
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockDiagnosticVMOptions -XX:-UseUnalignedAccesses
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestMergeStores::store*
+ *      compiler.c2.TestMergeStores
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockDiagnosticVMOptions -XX:-MergeStores
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestMergeStores::store*
+ *      compiler.c2.TestMergeStores
+ */
+
+package compiler.c2;
+
+import java.util.Arrays;
+
+public class TestMergeStores {
+    private static final int ITERATIONS = 20_000;
+    private static final int LENGTH = 24;
+
+    private static int ivalue = 0x12345678;
+    private static long lvalue = 0x0123456789abcdefL;
+
+    // Little endian pieces of an int.
+    static byte[] storeBytesLE(byte[] a, int i, int v) {
+        a[i]     = (byte)v;
+        a[i + 1] = (byte)(v >> 8);
+        a[i + 2] = (byte)(v >> 16);
+        a[i + 3] = (byte)(v >>> 24);
+        return a;
+    }
+
+    // Big endian pieces of an int.
+    static byte[] storeBytesBE(byte[] a, int i, int v) {
+        a[i]     = (byte)(v >>> 24);
+        a[i + 1] = (byte)(v >> 16);
+        a[i + 2] = (byte)(v >> 8);
+        a[i + 3] = (byte)v;
+        return a;
+    }
+
+    // Little endian pieces of a long, stored highest address first.
+    static byte[] storeBytesLongReversedOrder(byte[] a, int i, long v) {
+        a[i + 7] = (byte)(v >>> 56);
+        a[i + 6] = (byte)(v >> 48);
+        a[i + 5] = (byte)(v >> 40);
+        a[i + 4] = (byte)(v >> 32);
+        a[i + 3] = (byte)(v >> 24);
+        a[i + 2] = (byte)(v >> 16);
+        a[i + 1] = (byte)(v >> 8);
+        a[i]     = (byte)v;
+        return a;
+    }
+
+    // Big endian pieces of a long.
+    static byte[] storeBytesLongBE(byte[] a, int i, long v) {
+        a[i]     = (byte)(v >>> 56);
+        a[i + 1] = (byte)(v >> 48);
+        a[i + 2] = (byte)(v >> 40);
+        a[i + 3] = (byte)(v >> 32);
+        a[i + 4] = (byte)(v >> 24);
+        a[i + 5] = (byte)(v >> 16);
+        a[i + 6] = (byte)(v >> 8);
+        a[i + 7] = (byte)v;
+        return a;
+    }
+
+    static byte[] storeBytesConstant(byte[] a, int i) {
+        a[i]     = (byte)0x11;
+        a[i + 1] = (byte)0x82;
+        a[i + 2] = (byte)0x33;
+        a[i + 3] = (byte)0xf4;
+        return a;
+    }
+
+    // Constant offsets, aligned.
+    static byte[] storeBytesConstantFixedOffset(byte[] a) {
+        a[8]  = (byte)0xff;
+        a[9]  = (byte)0x01;
+        a[10] = (byte)0x80;
+        a[11] = (byte)0x7f;
+        a[12] = (byte)0x00;
+        a[13] = (byte)0x10;
+        a[14] = (byte)0xee;
+        a[15] = (byte)0x42;
+        return a;
+    }
+
+    static short[] storeShortsFromInt(short[] a, int i, int v) {
+        a[i]     = (short)v;
+        a[i + 1] = (short)(v >> 16);
+        return a;
+    }
+
+    static char[] storeCharsConstant(char[] a, int i) {
+        a[i]     = 'a';
+        a[i + 1] = '\uffff';
+        a[i + 2] = 'c';
+        a[i + 3] = '\u8000';
+        return a;
+    }
+
+    static int[] storeIntsFromLong(int[] a, int i, long v) {
+        a[i]     = (int)v;
+        a[i + 1] = (int)(v >>> 32);
+        return a;
+    }
+
+    static int[] storeIntsConstant(int[] a, int i) {
+        a[i]     = -1;
+        a[i + 1] = 0x7fffffff;
+        return a;
+    }
+
+    // Three stores: at most the first or last two can be merged.
+    static byte[] storeBytesPartialChain(byte[] a, int i, int v) {
+        a[i]     = (byte)v;
+        a[i + 1] = (byte)(v >> 8);
+        a[i + 2] = (byte)(v >> 16);
+        return a;
+    }
+
+    // Five constants: a pair or a quad plus a single store.
+    static byte[] storeBytesConstantPartialChain(byte[] a, int i) {
+        a[i]     = 1;
+        a[i + 1] = 2;
+        a[i + 2] = 3;
+        a[i + 3] = 4;
+        a[i + 4] = 5;
+        return a;
+    }
+
+    // Non-consecutive pieces must not be merged into one piece.
+    static byte[] storeBytesSkippedPiece(byte[] a, int i, int v) {
+        a[i]     = (byte)v;
+        a[i + 1] = (byte)(v >> 16);
+        a[i + 2] = (byte)(v >> 8);
+        a[i + 3] = (byte)(v >>> 24);
+        return a;
+    }
+
+    // Pieces of two different values.
+    static byte[] storeBytesTwoValues(byte[] a, int i, int v, int w) {
+        a[i]     = (byte)v;
+        a[i + 1] = (byte)(w >> 8);
+        a[i + 2] = (byte)(v >> 16);
+        a[i + 3] = (byte)(w >>> 24);
+        return a;
+    }
+
+    // Not adjacent: there is a gap between the pairs.
+    static byte[] storeBytesGap(byte[] a, int i, int v) {
+        a[i]     = (byte)v;
+        a[i + 1] = (byte)(v >> 8);
+        a[i + 3] = (byte)(v >> 16);
+        a[i + 4] = (byte)(v >>> 24);
+        return a;
+    }
+
+    // A range check fails between the stores: the stores before it must
+    // be visible, the ones after it must not happen.
+    static byte[] storeBytesRangeCheck(byte[] a, int i, int v) {
+        try {
+            a[i]     = (byte)v;
+            a[i + 1] = (byte)(v >> 8);
+            a[i + 2] = (byte)(v >> 16);
+            a[i + 3] = (byte)(v >>> 24);
+        } catch (ArrayIndexOutOfBoundsException e) {
+            a[0] = (byte)0xaa;
+        }
+        return a;
+    }
+
+    static char[] storeCharsRangeCheck(char[] a, int i) {
+        try {
+            a[i]     = 'x';
+            a[i + 1] = 'y';
+            a[i + 2] = 'z';
+            a[i + 3] = 'w';
+        } catch (ArrayIndexOutOfBoundsException e) {
+            a[0] = '!';
+        }
+        return a;
+    }
+
+    interface Test {
+        Object run(int round);
+    }
+
+    private static void check(String name, Test test) {
+        // -Xbatch: the first rounds are interpreted and give the expected results.
+        Object[] expected = new Object[LENGTH];
+        for (int round = 0; round < expected.length; round++) {
+            expected[round] = copy(test.run(round));
+        }
+        for (int i = 0; i < ITERATIONS; i++) {
+            int round = i % LENGTH;
+            Object actual = test.run(round);
+            if (!Arrays.deepEquals(new Object[] { expected[round] }, new Object[] { actual })) {
+                throw new RuntimeException(name + " round " + round + ": expected " +
+                                           Arrays.deepToString(new Object[] { expected[round] }) +
+                                           " but got " + Arrays.deepToString(new Object[] { actual }));
+            }
+        }
+    }
+
+    private static Object copy(Object a) {
+        if (a instanceof byte[])  return ((byte[])a).clone();
+        if (a instanceof short[]) return ((short[])a).clone();
+        if (a instanceof char[])  return ((char[])a).clone();
+        if (a instanceof int[])   return ((int[])a).clone();
+        throw new IllegalArgumentException();
+    }
+
+    public static void main(String[] args) {
+        // The start index varies so that stores are unaligned in some rounds;
+        // for the range check tests it also runs past the end of the array.
+        check("storeBytesLE", r -> storeBytesLE(new byte[LENGTH], r % (LENGTH - 3), ivalue + r));
+        check("storeBytesBE", r -> storeBytesBE(new byte[LENGTH], r % (LENGTH - 3), ivalue + r));
+        check("storeBytesLongReversedOrder", r -> storeBytesLongReversedOrder(new byte[LENGTH], r % (LENGTH - 7), lvalue + r));
+        check("storeBytesLongBE", r -> storeBytesLongBE(new byte[LENGTH], r % (LENGTH - 7), lvalue + r));
+        check("storeBytesConstant", r -> storeBytesConstant(new byte[LENGTH], r % (LENGTH - 3)));
+        check("storeBytesConstantFixedOffset", r -> storeBytesConstantFixedOffset(new byte[LENGTH]));
+        check("storeShortsFromInt", r -> storeShortsFromInt(new short[LENGTH], r % (LENGTH - 1), ivalue + r));
+        check("storeCharsConstant", r -> storeCharsConstant(new char[LENGTH], r % (LENGTH - 3)));
+        check("storeIntsFromLong", r -> storeIntsFromLong(new int[LENGTH], r % (LENGTH - 1), lvalue + r));
+        check("storeIntsConstant", r -> storeIntsConstant(new int[LENGTH], r % (LENGTH - 1)));
+        check("storeBytesPartialChain", r -> storeBytesPartialChain(new byte[LENGTH], r % (LENGTH - 2), ivalue + r));
+        check("storeBytesConstantPartialChain", r -> storeBytesConstantPartialChain(new byte[LENGTH], r % (LENGTH - 4)));
+        check("storeBytesSkippedPiece", r -> storeBytesSkippedPiece(new byte[LENGTH], r % (LENGTH - 3), ivalue + r));
+        check("storeBytesTwoValues", r -> storeBytesTwoValues(new byte[LENGTH], r % (LENGTH - 3), ivalue + r, ~ivalue - r));
+        check("storeBytesGap", r -> storeBytesGap(new byte[LENGTH], r % (LENGTH - 4), ivalue + r));
+        check("storeBytesRangeCheck", r -> storeBytesRangeCheck(new byte[LENGTH], r, ivalue + r));
+        check("storeCharsRangeCheck", r -> storeCharsRangeCheck(new char[LENGTH], r));
+    }
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Field loads from a Phi that merges new objects are split so the
+ *          objects can be scalar replaced, but never across aliasing stores
+ * @requires vm.compiler2.enabled
+ * @library /test/lib /
+ * @run driver compiler.c2.TestSplitLoadsThroughAllocationMerges
+ */
+
+package compiler.c2;
+
+import compiler.lib.ir_framework.*;
+import jdk.test.lib.Asserts;
+
+public class TestSplitLoadsThroughAllocationMerges {
+    static class P {
+        int x;
+        int y;
+
+        P(int x) {
+            this.x = x;
+        }
+
+        P(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static P sink;
+
+    public static void main(String[] args) {
+        TestFramework.runWithFlags("-XX:+UnlockDiagnosticVMOptions", "-XX:+SplitLoadsThroughAllocationMerges");
+        TestFramework.runWithFlags("-XX:+UnlockDiagnosticVMOptions", "-XX:-SplitLoadsThroughAllocationMerges");
+    }
+
+    // The only use of the merge is the load, both objects go away
+    @Test
+    @IR(applyIf = {"SplitLoadsThroughAllocationMerges", "true"}, failOn = IRNode.ALLOC)
+    static int merged(boolean c, int a, int b) {
+        P p = c ? new P(a) : new P(b);
+        return p.x;
+    }
+
+    @Run(test = "merged")
+    static void runMerged() {
+        Asserts.assertEQ(merged(true, 1, 2), 1);
+        Asserts.assertEQ(merged(false, 1, 2), 2);
+    }
+
+    // Two fields, one of them only stored on one path
+    @Test
+    @IR(applyIf = {"SplitLoadsThroughAllocationMerges", "true"}, failOn = IRNode.ALLOC)
+    static int mergedTwoFields(boolean c, int a, int b) {
+        P p;
+        if (c) {
+            p = new P(a, b);
+        } else {
+            p = new P(b);
+            p.x += a;
+        }
+        return p.x + p.y;
+    }
+
+    @Run(test = "mergedTwoFields")
+    static void runMergedTwoFields() {
+        Asserts.assertEQ(mergedTwoFields(true, 1, 2), 3);
+        Asserts.assertEQ(mergedTwoFields(false, 1, 2), 3);
+    }
+
+    // A three way merge
+    @Test
+    @IR(applyIf = {"SplitLoadsThroughAllocationMerges", "true"}, failOn = IRNode.ALLOC)
+    static int mergedThreeWays(int i, int a, int b) {
+        P p;
+        if (i == 0) {
+            p = new P(a);
+        } else if (i == 1) {
+            p = new P(b);
+        } else {
+            p = new P(a + b);
+        }
+        return p.x;
+    }
+
+    @Run(test = "mergedThreeWays")
+    static void runMergedThreeWays() {
+        Asserts.assertEQ(mergedThreeWays(0, 1, 2), 1);
+        Asserts.assertEQ(mergedThreeWays(1, 1, 2), 2);
+        Asserts.assertEQ(mergedThreeWays(2, 1, 2), 3);
+    }
+
+    // The store after the merge may write to the merged object, the load
+    // must not be split above it.
+    @Test
+    static int aliasingStore(boolean c, boolean d, P other, int a, int b) {
+        P p = c ? new P(a) : new P(b);
+        P q = d ? p : other;
+        q.x = 42;
+        return p.x;
+    }
+
+    @Run(test = "aliasingStore")
+    static void runAliasingStore() {
+        P other = new P(0);
+        Asserts.assertEQ(aliasingStore(true, true, other, 1, 2), 42);
+        Asserts.assertEQ(aliasingStore(false, true, other, 1, 2), 42);
+        Asserts.assertEQ(aliasingStore(true, false, other, 1, 2), 1);
+        Asserts.assertEQ(aliasingStore(false, false, other, 1, 2), 2);
+        Asserts.assertEQ(other.x, 42);
+    }
+
+    // A store to an unrelated object of the same class between the merge
+    // and the load also blocks the split.
+    @Test
+    static int unrelatedStore(boolean c, P other, int a, int b) {
+        P p = c ? new P(a) : new P(b);
+        other.x = 42;
+        return p.x;
+    }
+
+    @Run(test = "unrelatedStore")
+    static void runUnrelatedStore() {
+        P other = new P(0);
+        Asserts.assertEQ(unrelatedStore(true, other, 1, 2), 1);
+        Asserts.assertEQ(unrelatedStore(false, other, 1, 2), 2);
+        Asserts.assertEQ(other.x, 42);
+    }
+
+    // The merged object escapes, and is modified through the escaped
+    // reference by a call between the merge and the load.
+    @DontInline
+    static void modifySink(int v) {
+        sink.x = v;
+    }
+
+    @Test
+    @IR(counts = {IRNode.ALLOC, "2"})
+    static int escapedAndModified(boolean c, int a, int b) {
+        P p = c ? new P(a) : new P(b);
+        sink = p;
+        modifySink(42);
+        return p.x;
+    }
+
+    @Run(test = "escapedAndModified")
+    static void runEscapedAndModified() {
+        Asserts.assertEQ(escapedAndModified(true, 1, 2), 42);
+        Asserts.assertEQ(escapedAndModified(false, 1, 2), 42);
+    }
+
+    // Merge of a new object with an existing one, the load must not be split
+    @Test
+    static int mergedWithParameter(boolean c, P other, int a) {
+        P p = c ? new P(a) : other;
+        return p.x;
+    }
+
+    @Run(test = "mergedWithParameter")
+    static void runMergedWithParameter() {
+        P other = new P(7);
+        Asserts.assertEQ(mergedWithParameter(true, other, 1), 1);
+        Asserts.assertEQ(mergedWithParameter(false, other, 1), 7);
+    }
+
+    // Merge in a loop, the objects of earlier iterations are modified
+    @Test
+    static int mergedInLoop(int n) {
+        P p = new P(0);
+        for (int i = 0; i < n; i++) {
+            P prev = p;
+            p = (i & 1) == 0 ? new P(prev.x + 1) : new P(prev.x + 2);
+            prev.x = -1;
+        }
+        return p.x;
+    }
+
+    @Run(test = "mergedInLoop")
+    static void runMergedInLoop() {
+        Asserts.assertEQ(mergedInLoop(0), 0);
+        Asserts.assertEQ(mergedInLoop(1), 1);
+        Asserts.assertEQ(mergedInLoop(4), 6);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Vectors carried around loops through nested and cyclic Phis
+ *          must keep their values once the boxes are merged through the Phis
+ * @requires vm.compiler2.enabled
+ * @modules jdk.incubator.vector
+ * @run main/othervm -XX:-TieredCompilation -Xbatch
+ *      -XX:+UnlockExperimentalVMOptions -XX:+EnableVectorReboxing -XX:+EnableVectorAggressiveReboxing
+ *      -XX:CompileCommand=compileonly,compiler.c2.TestVectorBoxPhiLoop::test*
+ *      compiler.c2.TestVectorBoxPhiLoop
+ * @run main/othervm -XX:-TieredCompilation -Xbatch
+ *      -XX:+UnlockExperimentalVMOptions -XX:+EnableVectorReboxing -XX:-EnableVectorAggressiveReboxing
+ *      compiler.c2.TestVectorBoxPhiLoop
+ */
+
+package compiler.c2;
+
+import jdk.incubator.vector.IntVector;
+import jdk.incubator.vector.VectorOperators;
+import jdk.incubator.vector.VectorSpecies;
+
+public class TestVectorBoxPhiLoop {
+    private static final VectorSpecies<Integer> SPECIES = IntVector.SPECIES_PREFERRED;
+    private static final int ITERATIONS = 20_000;
+
+    private static final int[] a = new int[1024];
+    private static final boolean[] flags = new boolean[a.length];
+
+    // The accumulator Phi of the loop has an inner Phi from the if/else
+    // as its backedge input.
+    static int testIfElse(int[] a, boolean[] flags) {
+        IntVector acc = IntVector.zero(SPECIES);
+        for (int i = 0; i < SPECIES.loopBound(a.length); i += SPECIES.length()) {
+            IntVector v = IntVector.fromArray(SPECIES, a, i);
+            if (flags[i]) {
+                acc = acc.add(v);
+            } else {
+                acc = acc.sub(v);
+            }
+        }
+        return acc.reduceLanes(VectorOperators.ADD);
+    }
+
+    // Only one path updates the accumulator, so the inner Phi also takes
+    // the loop Phi itself as an input: a cycle through the backedge.
+    static int testConditionalUpdate(int[] a, boolean[] flags) {
+        IntVector acc = IntVector.zero(SPECIES);
+        for (int i = 0; i < SPECIES.loopBound(a.length); i += SPECIES.length()) {
+            if (flags[i]) {
+                acc = acc.add(IntVector.fromArray(SPECIES, a, i));
+            }
+        }
+        return acc.reduceLanes(VectorOperators.ADD);
+    }
+
+    // The accumulator is carried around two nested loops.
+    static int testNestedLoops(int[] a, boolean[] flags) {
+        IntVector acc = IntVector.broadcast(SPECIES, 1);
+        for (int j = 0; j < 4; j++) {
+            for (int i = 0; i < SPECIES.loopBound(a.length); i += SPECIES.length()) {
+                IntVector v = IntVector.fromArray(SPECIES, a, i);
+                acc = flags[i] ? acc.add(v) : acc.mul(2);
+            }
+            acc = acc.lanewise(VectorOperators.ASHR, 1);
+        }
+        return acc.reduceLanes(VectorOperators.ADD);
+    }
+
+    static int referenceIfElse(int[] a, boolean[] flags) {
+        int[] acc = new int[SPECIES.length()];
+        for (int i = 0; i < SPECIES.loopBound(a.length); i += SPECIES.length()) {
+            for (int l = 0; l < acc.length; l++) {
+                acc[l] = flags[i] ? acc[l] + a[i + l] : acc[l] - a[i + l];
+            }
+        }
+        return sum(acc);
+    }
+
+    static int referenceConditionalUpdate(int[] a, boolean[] flags) {
+        int[] acc = new int[SPECIES.length()];
+        for (int i = 0; i < SPECIES.loopBound(a.length); i += SPECIES.length()) {
+            for (int l = 0; l < acc.length; l++) {
+                if (flags[i]) {
+                    acc[l] += a[i + l];
+                }
+            }
+        }
+        return sum(acc);
+    }
+
+    static int referenceNestedLoops(int[] a, boolean[] flags) {
+        int[] acc = new int[SPECIES.length()];
+        java.util.Arrays.fill(acc, 1);
+        for (int j = 0; j < 4; j++) {
+            for (int i = 0; i < SPECIES.loopBound(a.length); i += SPECIES.length()) {
+                for (int l = 0; l < acc.length; l++) {
+                    acc[l] = flags[i] ? acc[l] + a[i + l] : acc[l] * 2;
+                }
+            }
+            for (int l = 0; l < acc.length; l++) {
+                acc[l] >>= 1;
+            }
+        }
+        return sum(acc);
+    }
+
+    private static int sum(int[] acc) {
+        int s = 0;
+        for (int x : acc) {
+            s += x;
+        }
+        return s;
+    }
+
+    private static void check(String name, int expected, int actual) {
+        if (expected != actual) {
+            throw new RuntimeException(name + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i * 31 - 7;
+            flags[i] = (i / SPECIES.length()) % 3 != 0;
+        }
+        int expectedIfElse = referenceIfElse(a, flags);
+        int expectedConditionalUpdate = referenceConditionalUpdate(a, flags);
+        int expectedNestedLoops = referenceNestedLoops(a, flags);
+        for (int i = 0; i < ITERATIONS; i++) {
+            check("testIfElse", expectedIfElse, testIfElse(a, flags));
+            check("testConditionalUpdate", expectedConditionalUpdate, testConditionalUpdate(a, flags));
+            check("testNestedLoops", expectedNestedLoops, testNestedLoops(a, flags));
+        }
+    }
+}
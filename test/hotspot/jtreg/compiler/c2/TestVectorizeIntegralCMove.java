@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary With UseVectorCmov, SuperWord vectorizes int and long selects
+ *          into VectorMaskCmp and VectorBlend
+ * @requires vm.compiler2.enabled & vm.flagless
+ * @requires os.arch == "x86_64" | os.arch == "amd64"
+ * @requires vm.cpu.features ~= ".*avx2.*"
+ * @library /test/lib /
+ * @run driver compiler.c2.TestVectorizeIntegralCMove
+ */
+
+package compiler.c2;
+
+import compiler.lib.ir_framework.*;
+import jdk.test.lib.Asserts;
+
+public class TestVectorizeIntegralCMove {
+    static final String VECTOR_MASK_CMP = "(\\d+(\\s){2}(VectorMaskCmp.*)+(\\s){2}===.*)";
+    static final String VECTOR_BLEND = "(\\d+(\\s){2}(VectorBlend.*)+(\\s){2}===.*)";
+    static final int SIZE = 1024;
+
+    static int[] ia = new int[SIZE];
+    static int[] ic = new int[SIZE];
+    static int[] ib = new int[SIZE];
+    static long[] la = new long[SIZE];
+    static long[] lc = new long[SIZE];
+    static long[] lb = new long[SIZE];
+
+    static {
+        for (int i = 0; i < SIZE; i++) {
+            ia[i] = (i * 7919) % 200 - 100;
+            ic[i] = i;
+            la[i] = ((long)i * 7919) % 200 - 100;
+            lc[i] = -i;
+        }
+    }
+
+    public static void main(String[] args) {
+        TestFramework.runWithFlags("-XX:+UseCMoveUnconditionally", "-XX:+UseVectorCmov");
+        TestFramework.runWithFlags("-XX:+UseCMoveUnconditionally", "-XX:-UseVectorCmov");
+    }
+
+    // The compared value is one of the selected ones, the other is a scalar
+    @Test
+    @IR(applyIf = {"UseVectorCmov", "true"}, counts = {VECTOR_MASK_CMP, ">= 1", VECTOR_BLEND, ">= 1"})
+    @IR(applyIf = {"UseVectorCmov", "false"}, failOn = {VECTOR_MASK_CMP, VECTOR_BLEND})
+    static void selectIntAboveThreshold(int[] a, int[] c, int[] b, int t) {
+        for (int i = 0; i < a.length; i++) {
+            b[i] = a[i] > t ? a[i] : c[i];
+        }
+    }
+
+    @Run(test = "selectIntAboveThreshold")
+    static void runSelectIntAboveThreshold() {
+        selectIntAboveThreshold(ia, ic, ib, 10);
+        for (int i = 0; i < SIZE; i++) {
+            Asserts.assertEQ(ib[i], ia[i] > 10 ? ia[i] : ic[i]);
+        }
+    }
+
+    // Both compared values come from arrays that are not selected
+    @Test
+    @IR(applyIf = {"UseVectorCmov", "true"}, counts = {VECTOR_MASK_CMP, ">= 1", VECTOR_BLEND, ">= 1"})
+    @IR(applyIf = {"UseVectorCmov", "false"}, failOn = {VECTOR_MASK_CMP, VECTOR_BLEND})
+    static void selectIntEqual(int[] a, int[] c, int[] b) {
+        for (int i = 0; i < a.length; i++) {
+            b[i] = a[i] == c[i] ? c[i] + 1 : a[i] - 1;
+        }
+    }
+
+    @Run(test = "selectIntEqual")
+    static void runSelectIntEqual() {
+        selectIntEqual(ia, ic, ib);
+        for (int i = 0; i < SIZE; i++) {
+            Asserts.assertEQ(ib[i], ia[i] == ic[i] ? ic[i] + 1 : ia[i] - 1);
+        }
+    }
+
+    @Test
+    @IR(applyIf = {"UseVectorCmov", "true"}, counts = {VECTOR_MASK_CMP, ">= 1", VECTOR_BLEND, ">= 1"})
+    @IR(applyIf = {"UseVectorCmov", "false"}, failOn = {VECTOR_MASK_CMP, VECTOR_BLEND})
+    static void selectLongBelowThreshold(long[] a, long[] c, long[] b, long t) {
+        for (int i = 0; i < a.length; i++) {
+            b[i] = a[i] <= t ? a[i] : c[i];
+        }
+    }
+
+    @Run(test = "selectLongBelowThreshold")
+    static void runSelectLongBelowThreshold() {
+        selectLongBelowThreshold(la, lc, lb, -5);
+        for (int i = 0; i < SIZE; i++) {
+            Asserts.assertEQ(lb[i], la[i] <= -5 ? la[i] : lc[i]);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary CHA must ignore a class whose itable is pending and deoptimize
+ *          when the class is initialized
+ * @requires vm.compiler2.enabled & vm.flagless
+ * @library /test/lib /
+ * @build sun.hotspot.WhiteBox
+ * @run driver jdk.test.lib.helpers.ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+LazyItableInitialization
+ *                   -XX:-BackgroundCompilation -XX:-UseOnStackReplacement
+ *                   -XX:-UseTypeProfile -XX:+UseVtableBasedCHA
+ *                   compiler.cha.TestLazyItableCHA
+ */
+
+package compiler.cha;
+
+import java.lang.reflect.Method;
+
+import jdk.test.lib.Asserts;
+import sun.hotspot.WhiteBox;
+
+public class TestLazyItableCHA {
+
+    private static final WhiteBox WHITE_BOX = WhiteBox.getWhiteBox();
+    private static final int COMP_LEVEL_FULL_OPTIMIZATION = 4;
+
+    interface I {
+        int m();
+    }
+
+    static class A implements I {
+        public int m() { return 1; }
+    }
+
+    static class B implements I {
+        public int m() { return 2; }
+    }
+
+    static int call(I i) {
+        return i.m();
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Link B without initializing it, which leaves its itable pending
+        B.class.getDeclaredMethods();
+
+        Method call = TestLazyItableCHA.class.getDeclaredMethod("call", I.class);
+        I a = new A();
+        for (int i = 0; i < 20_000; i++) {
+            Asserts.assertEQ(call(a), 1);
+        }
+        WHITE_BOX.enqueueMethodForCompilation(call, COMP_LEVEL_FULL_OPTIMIZATION);
+        Asserts.assertTrue(WHITE_BOX.isMethodCompiled(call), "call is not compiled");
+
+        // A is the only concrete implementation with instances, so CHA binds
+        // the call to A.m. Initializing B fills in its itable and must
+        // invalidate that code.
+        I b = new B();
+        Asserts.assertFalse(WHITE_BOX.isMethodCompiled(call), "call was not deoptimized");
+        Asserts.assertEQ(call(b), 2);
+        Asserts.assertEQ(call(a), 1);
+    }
+}
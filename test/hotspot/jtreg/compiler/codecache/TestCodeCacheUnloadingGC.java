@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary With CodeCacheUnloadingGC, a code cache filling up with the code
+ *          of dead classes requests a GC that unloads them
+ * @requires vm.flagless
+ * @library /test/lib
+ * @run driver compiler.codecache.TestCodeCacheUnloadingGC
+ */
+
+package compiler.codecache;
+
+import java.io.InputStream;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestCodeCacheUnloadingGC {
+    static final String REQUEST = "Code cache is running low, requesting a GC to unload code";
+    static final String CAUSE = "CodeCache GC Threshold";
+
+    public static class Hot {
+        public static int work(int n) {
+            int sum = 0;
+            for (int i = 0; i < n; i++) {
+                sum += i * 31 + (sum >>> 3);
+            }
+            return sum;
+        }
+    }
+
+    static class ByteLoader extends ClassLoader {
+        Class<?> define(String name, byte[] bytes) {
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    // Defines Hot in many loaders that are dropped right away, so that the
+    // code cache fills up with the code of dead classes.
+    public static class Workload {
+        public static void main(String[] args) throws Exception {
+            int copies = Integer.parseInt(args[0]);
+            byte[] bytes;
+            try (InputStream in = Hot.class.getResourceAsStream("TestCodeCacheUnloadingGC$Hot.class")) {
+                bytes = in.readAllBytes();
+            }
+            for (int c = 0; c < copies; c++) {
+                Class<?> k = new ByteLoader().define(Hot.class.getName(), bytes);
+                Method work = k.getMethod("work", int.class);
+                work.invoke(null, 100);
+            }
+            System.out.println("OK");
+        }
+    }
+
+    static OutputAnalyzer run(String... opts) throws Exception {
+        List<String> cmd = new ArrayList<>(Arrays.asList(opts));
+        cmd.addAll(Arrays.asList(
+            // Every copy of Hot.work is compiled on its first call
+            "-Xcomp", "-XX:TieredStopAtLevel=1",
+            "-XX:CompileCommand=quiet",
+            "-XX:CompileCommand=compileonly," + Hot.class.getName() + "::work",
+            "-XX:-SegmentedCodeCache", "-XX:ReservedCodeCacheSize=8m",
+            "-XX:+UseSerialGC", "-Xmx256m",
+            "-Xlog:gc,codecache=info,class+unload=info",
+            Workload.class.getName(), "20000"));
+        OutputAnalyzer output = ProcessTools.executeTestJvm(cmd.toArray(new String[0]));
+        output.shouldHaveExitValue(0);
+        output.shouldContain("OK");
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Off by default: the sweeper does not ask for a GC
+        OutputAnalyzer output = run();
+        output.shouldNotContain(REQUEST);
+        output.shouldNotContain(CAUSE);
+
+        // With the flag, the sweeper requests a full collection, which
+        // unloads the dead copies of Hot and frees their code
+        output = run("-XX:+CodeCacheUnloadingGC");
+        output.shouldContain(REQUEST);
+        output.shouldMatch("Pause Full \\(" + CAUSE + "\\)");
+        output.shouldMatch("unloading class .*TestCodeCacheUnloadingGC\\$Hot");
+    }
+}
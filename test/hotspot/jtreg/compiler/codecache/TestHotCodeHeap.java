@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary The hot code heap is sized from HotCodeHeapSize, holds the C2
+ *          code of hot methods, falls back to the non-profiled heap when it
+ *          is full, and shows up in Compiler.codecache and the MXBeans
+ * @requires vm.compiler2.enabled
+ * @library /test/lib
+ * @modules java.management
+ * @run driver compiler.codecache.TestHotCodeHeap
+ */
+
+package compiler.codecache;
+
+import java.io.InputStream;
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.JDKToolFinder;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestHotCodeHeap {
+    static final String HOT_HEAP = "CodeHeap 'hot nmethods'";
+    static final long M = 1024 * 1024;
+
+    public static class Hot {
+        public static int work(int n) {
+            int sum = 0;
+            for (int i = 0; i < n; i++) {
+                sum += i * 31 + (sum >>> 3);
+            }
+            return sum;
+        }
+    }
+
+    static class ByteLoader extends ClassLoader {
+        Class<?> define(String name, byte[] bytes) {
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    // Runs with the flags given by the driver. Makes 'copies' distinct hot
+    // methods by defining Hot in as many loaders, then reports the code heaps.
+    public static class Workload {
+        public static void main(String[] args) throws Exception {
+            int copies = Integer.parseInt(args[0]);
+            byte[] bytes;
+            try (InputStream in = Hot.class.getResourceAsStream("TestHotCodeHeap$Hot.class")) {
+                bytes = in.readAllBytes();
+            }
+            List<Class<?>> classes = new ArrayList<>();
+            for (int c = 0; c < copies; c++) {
+                Class<?> k = new ByteLoader().define(Hot.class.getName(), bytes);
+                classes.add(k);
+                Method work = k.getMethod("work", int.class);
+                for (int i = 0; i < 20_000; i++) {
+                    work.invoke(null, 100);
+                }
+            }
+
+            long used = -1;
+            for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+                if (pool.getName().equals(HOT_HEAP)) {
+                    used = pool.getUsage().getUsed();
+                }
+            }
+            System.out.println("MXBean used=" + used);
+
+            String pid = Long.toString(ProcessHandle.current().pid());
+            ProcessBuilder pb = new ProcessBuilder(JDKToolFinder.getJDKTool("jcmd"), pid, "Compiler.codecache");
+            OutputAnalyzer output = new OutputAnalyzer(pb.start());
+            output.shouldHaveExitValue(0);
+            System.out.println(output.getStdout());
+        }
+    }
+
+    static long flag(OutputAnalyzer output, String name) {
+        Matcher m = Pattern.compile("\\b" + name + "\\s+= (\\d+)").matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No value for " + name);
+        }
+        return Long.parseLong(m.group(1));
+    }
+
+    static OutputAnalyzer flags(String... opts) throws Exception {
+        List<String> cmd = new ArrayList<>(Arrays.asList(opts));
+        cmd.add("-XX:+PrintFlagsFinal");
+        cmd.add("-XX:+PrintCodeCache");
+        cmd.add("-version");
+        OutputAnalyzer output = ProcessTools.executeTestJvm(cmd);
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    static void checkSum(OutputAnalyzer output, long reserved) {
+        long sum = flag(output, "NonNMethodCodeHeapSize") + flag(output, "ProfiledCodeHeapSize") +
+                   flag(output, "NonProfiledCodeHeapSize") + flag(output, "HotCodeHeapSize");
+        if (sum != reserved) {
+            throw new RuntimeException("Code heap sizes add up to " + sum + " instead of " + reserved);
+        }
+    }
+
+    static void sizing() throws Exception {
+        // The requested size is taken from the non-profiled heap
+        OutputAnalyzer output = flags("-XX:+SegmentedCodeCache", "-XX:ReservedCodeCacheSize=64m",
+                                      "-XX:HotCodeHeapSize=8m");
+        if (flag(output, "HotCodeHeapSize") != 8 * M) {
+            throw new RuntimeException("HotCodeHeapSize is not 8m");
+        }
+        checkSum(output, 64 * M);
+        output.shouldContain(HOT_HEAP + ": size=8192Kb");
+
+        // The non-profiled heap keeps at least half of its size
+        output = flags("-XX:+SegmentedCodeCache", "-XX:ReservedCodeCacheSize=64m",
+                       "-XX:HotCodeHeapSize=1g");
+        if (flag(output, "HotCodeHeapSize") > flag(output, "NonProfiledCodeHeapSize")) {
+            throw new RuntimeException("Hot code heap larger than the non-profiled heap");
+        }
+        checkSum(output, 64 * M);
+        output.shouldContain(HOT_HEAP);
+
+        // No hot heap unless requested, without segmentation, and without C2
+        output = flags("-XX:+SegmentedCodeCache", "-XX:ReservedCodeCacheSize=64m");
+        output.shouldNotContain(HOT_HEAP);
+        checkSum(output, 64 * M);
+        flags("-XX:-SegmentedCodeCache", "-XX:HotCodeHeapSize=8m").shouldNotContain(HOT_HEAP);
+        flags("-XX:+SegmentedCodeCache", "-XX:HotCodeHeapSize=8m", "-Xint").shouldNotContain(HOT_HEAP);
+    }
+
+    static OutputAnalyzer workload(int copies, String... opts) throws Exception {
+        List<String> cmd = new ArrayList<>();
+        cmd.add("-XX:+SegmentedCodeCache");
+        // Small pages, so that the hot heap is not aligned away
+        cmd.add("-XX:-UseLargePages");
+        cmd.add("-XX:-TieredCompilation");
+        cmd.add("-Xbatch");
+        cmd.add("-XX:+UnlockDiagnosticVMOptions");
+        cmd.addAll(Arrays.asList(opts));
+        cmd.add(Workload.class.getName());
+        cmd.add(Integer.toString(copies));
+        OutputAnalyzer output = ProcessTools.executeTestJvm(cmd);
+        output.shouldHaveExitValue(0);
+        output.shouldNotContain("CodeCache is full");
+        output.shouldContain("compilation: enabled");
+        output.shouldMatch("full_count=0");
+        return output;
+    }
+
+    static long used(OutputAnalyzer output, String heap) {
+        Matcher m = Pattern.compile(Pattern.quote(heap) + ": size=\\d+Kb used=(\\d+)Kb").matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No line for " + heap);
+        }
+        return Long.parseLong(m.group(1));
+    }
+
+    static long mxbeanUsed(OutputAnalyzer output) {
+        Matcher m = Pattern.compile("MXBean used=(-?\\d+)").matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No MXBean usage");
+        }
+        return Long.parseLong(m.group(1));
+    }
+
+    static void placement() throws Exception {
+        // Hot methods go to the hot heap
+        OutputAnalyzer output = workload(8, "-XX:HotCodeHeapSize=4m", "-XX:HotCodeHeapThreshold=1000");
+        if (used(output, HOT_HEAP) == 0 || mxbeanUsed(output) <= 0) {
+            throw new RuntimeException("Hot code heap is empty");
+        }
+
+        // Nothing reaches a threshold that is too high
+        output = workload(8, "-XX:HotCodeHeapSize=4m", "-XX:HotCodeHeapThreshold=" + Integer.MAX_VALUE);
+        if (used(output, HOT_HEAP) != 0 || mxbeanUsed(output) != 0) {
+            throw new RuntimeException("Hot code heap used below the threshold");
+        }
+    }
+
+    static void full() throws Exception {
+        // A hot heap of a few pages fills up quickly. The other
+        // hot methods go to the non-profiled heap, without reporting a full
+        // code cache or stopping compilation.
+        OutputAnalyzer output = workload(200, "-XX:HotCodeHeapSize=64k", "-XX:HotCodeHeapThreshold=1000");
+        long hot = used(output, HOT_HEAP);
+        long nonProfiled = used(output, "CodeHeap 'non-profiled nmethods'");
+        if (hot == 0 || nonProfiled < hot) {
+            throw new RuntimeException("No fallback to the non-profiled heap: hot=" + hot +
+                                       "Kb non-profiled=" + nonProfiled + "Kb");
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        sizing();
+        placement();
+        full();
+    }
+}
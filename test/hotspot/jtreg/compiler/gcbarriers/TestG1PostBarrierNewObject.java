@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary G1 post barriers are removed for stores into new objects past
+ *          branches, but kept when a call separates the store from the
+ *          allocation
+ * @requires vm.gc.G1 & vm.compiler2.enabled
+ * @library /test/lib /
+ * @run driver compiler.gcbarriers.TestG1PostBarrierNewObject
+ */
+
+package compiler.gcbarriers;
+
+import compiler.lib.ir_framework.*;
+import jdk.test.lib.Asserts;
+
+public class TestG1PostBarrierNewObject {
+    // The card mark store emitted by the G1 post barrier
+    static final String STORE_CM = "(\\d+(\\s){2}(StoreCM.*)+(\\s){2}===.*)";
+
+    static class Holder {
+        Object f;
+        Object g;
+    }
+
+    static Object sink;
+    static int isink;
+
+    public static void main(String[] args) {
+        TestFramework.runWithFlags("-XX:+UseG1GC", "-XX:+ReduceInitialCardMarks");
+        TestFramework.runWithFlags("-XX:+UseG1GC", "-XX:-ReduceInitialCardMarks");
+    }
+
+    // A null check of the argument between the allocation and the store
+    @Test
+    @IR(applyIf = {"ReduceInitialCardMarks", "true"}, failOn = STORE_CM)
+    @IR(applyIf = {"ReduceInitialCardMarks", "false"}, counts = {STORE_CM, ">= 1"})
+    static Holder storeAfterNullCheck(Object o) {
+        Holder h = new Holder();
+        if (o != null) {
+            h.f = o;
+        }
+        return h;
+    }
+
+    @Run(test = "storeAfterNullCheck")
+    static void runStoreAfterNullCheck() {
+        Object o = new Object();
+        Asserts.assertEQ(storeAfterNullCheck(o).f, o);
+        Asserts.assertNull(storeAfterNullCheck(null).f);
+    }
+
+    // Several branches on the arguments before the stores
+    @Test
+    @IR(applyIf = {"ReduceInitialCardMarks", "true"}, failOn = STORE_CM)
+    static Holder storeAfterBranches(Object a, Object b, int i) {
+        Holder h = new Holder();
+        if (i > 0) {
+            h.f = a;
+        }
+        if (i > 10) {
+            h.g = b;
+        }
+        return h;
+    }
+
+    @Run(test = "storeAfterBranches")
+    static void runStoreAfterBranches() {
+        Object a = new Object();
+        Object b = new Object();
+        Holder h = storeAfterBranches(a, b, 20);
+        Asserts.assertEQ(h.f, a);
+        Asserts.assertEQ(h.g, b);
+        h = storeAfterBranches(a, b, 5);
+        Asserts.assertEQ(h.f, a);
+        Asserts.assertNull(h.g);
+    }
+
+    @DontInline
+    static void call() {
+        sink = null;
+    }
+
+    // The call can safepoint, the object may no longer be young
+    @Test
+    @IR(counts = {STORE_CM, ">= 1"})
+    static Holder storeAfterCall(Object o) {
+        Holder h = new Holder();
+        call();
+        h.f = o;
+        return h;
+    }
+
+    @Run(test = "storeAfterCall")
+    static void runStoreAfterCall() {
+        Object o = new Object();
+        Asserts.assertEQ(storeAfterCall(o).f, o);
+    }
+
+    // A merge point ends the search even without a safepoint
+    @Test
+    @IR(counts = {STORE_CM, ">= 1"})
+    static Holder storeAfterMerge(Object o, int i) {
+        Holder h = new Holder();
+        if (i > 0) {
+            isink = i;
+        }
+        h.f = o;
+        return h;
+    }
+
+    @Run(test = "storeAfterMerge")
+    static void runStoreAfterMerge() {
+        Object o = new Object();
+        Asserts.assertEQ(storeAfterMerge(o, 1).f, o);
+        Asserts.assertEQ(storeAfterMerge(o, 0).f, o);
+    }
+}
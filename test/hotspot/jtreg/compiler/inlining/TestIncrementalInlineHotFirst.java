@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary With IncrementalInlineHotFirst, a frequent call site that is
+ *          reached after the inlining budget is used up is still inlined
+ * @requires vm.compiler2.enabled & vm.flagless
+ * @library /test/lib
+ * @run driver compiler.inlining.TestIncrementalInlineHotFirst
+ */
+
+package compiler.inlining;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestIncrementalInlineHotFirst {
+
+    private static final String HOT_CALLEE = "TestIncrementalInlineHotFirst\\$Workload::hotCallee";
+
+    public static void main(String[] args) throws Exception {
+        // The default leaves the inlining limits as they were
+        run(null).shouldMatch(HOT_CALLEE + ".*size > DesiredMethodLimit");
+        run(false).shouldMatch(HOT_CALLEE + ".*size > DesiredMethodLimit");
+
+        OutputAnalyzer output = run(true);
+        output.shouldNotMatch(HOT_CALLEE + ".*size > DesiredMethodLimit");
+        output.shouldMatch(HOT_CALLEE + ".*inline \\(hot\\)");
+    }
+
+    private static OutputAnalyzer run(Boolean hotFirst) throws Exception {
+        List<String> command = new ArrayList<>();
+        command.add("-XX:-TieredCompilation");
+        command.add("-XX:-BackgroundCompilation");
+        // Only the full compilation of test() reaches hotCallee with the budget used up
+        command.add("-XX:-UseOnStackReplacement");
+        command.add("-XX:+UnlockDiagnosticVMOptions");
+        command.add("-XX:+PrintInlining");
+        command.add("-XX:CompileCommand=quiet");
+        command.add("-XX:CompileCommand=compileonly," + Workload.class.getName() + "::test");
+        if (hotFirst != null) {
+            command.add("-XX:" + (hotFirst ? "+" : "-") + "IncrementalInlineHotFirst");
+        }
+        command.add(Workload.class.getName());
+        OutputAnalyzer output = ProcessTools.executeTestJvm(command.toArray(new String[0]));
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Workload::filler");
+        return output;
+    }
+
+    static class Workload {
+        // Close to FreqInlineSize, so that the calls below use up
+        // DesiredMethodLimit before hotCallee is reached.
+        static int filler(int x) {
+            x = x * 31 + 7;
+            x = x * 33 + 8;
+            x = x * 35 + 9;
+            x = x * 37 + 10;
+            x = x * 39 + 11;
+            x = x * 41 + 12;
+            x = x * 43 + 13;
+            x = x * 45 + 14;
+            x = x * 47 + 15;
+            x = x * 49 + 16;
+            x = x * 51 + 17;
+            x = x * 53 + 18;
+            x = x * 55 + 19;
+            x = x * 57 + 20;
+            x = x * 59 + 21;
+            x = x * 61 + 22;
+            x = x * 63 + 23;
+            x = x * 65 + 24;
+            x = x * 67 + 25;
+            x = x * 69 + 26;
+            x = x * 71 + 27;
+            x = x * 73 + 28;
+            x = x * 75 + 29;
+            x = x * 77 + 30;
+            x = x * 79 + 31;
+            x = x * 81 + 32;
+            x = x * 83 + 33;
+            x = x * 85 + 34;
+            x = x * 87 + 35;
+            x = x * 89 + 36;
+            x = x * 31 + 37;
+            x = x * 33 + 38;
+            x = x * 35 + 39;
+            x = x * 37 + 40;
+            x = x * 39 + 41;
+            x = x * 41 + 42;
+            return x;
+        }
+
+        static int hotCallee(int x) {
+            int y = x ^ (x >>> 7);
+            y = y * 0x9E3779B9 + (x << 3);
+            y = (y ^ (y >>> 11)) * 0x85EBCA6B;
+            y = (y ^ (y >>> 15)) * 0xC2B2AE35;
+            return y ^ (y >>> 16) ^ x;
+        }
+
+        static int test(int n) {
+            int s = n;
+            s += filler(s + 0);
+            s += filler(s + 1);
+            s += filler(s + 2);
+            s += filler(s + 3);
+            s += filler(s + 4);
+            s += filler(s + 5);
+            s += filler(s + 6);
+            s += filler(s + 7);
+            s += filler(s + 8);
+            s += filler(s + 9);
+            s += filler(s + 10);
+            s += filler(s + 11);
+            s += filler(s + 12);
+            s += filler(s + 13);
+            s += filler(s + 14);
+            s += filler(s + 15);
+            s += filler(s + 16);
+            s += filler(s + 17);
+            s += filler(s + 18);
+            s += filler(s + 19);
+            s += filler(s + 20);
+            s += filler(s + 21);
+            s += filler(s + 22);
+            s += filler(s + 23);
+            s += filler(s + 24);
+            s += filler(s + 25);
+            s += filler(s + 26);
+            s += filler(s + 27);
+            s += filler(s + 28);
+            s += filler(s + 29);
+            for (int i = 0; i < 1_000; i++) {
+                s += hotCallee(s + i);
+            }
+            return s;
+        }
+
+        public static void main(String[] args) {
+            int s = 0;
+            for (int i = 0; i < 20_000; i++) {
+                s += test(i);
+            }
+            System.out.println(s);
+        }
+    }
+}
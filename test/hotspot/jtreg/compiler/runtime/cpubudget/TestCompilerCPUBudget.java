@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary CompilerCPUBudget caps the C2 compiler threads only, and the
+ *          compilation CPU time per tier is exposed per compiler thread
+ *          and in the sun.ci performance counters
+ * @requires vm.compiler1.enabled & vm.compiler2.enabled
+ * @requires vm.flagless
+ * @library /test/lib
+ * @run driver compiler.runtime.cpubudget.TestCompilerCPUBudget
+ */
+
+package compiler.runtime.cpubudget;
+
+import java.io.InputStream;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.JDKToolFinder;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestCompilerCPUBudget {
+
+    public static class Hot {
+        public static int work(int n) {
+            int sum = 0;
+            for (int i = 0; i < n; i++) {
+                sum += i * 31 + (sum >>> 3);
+            }
+            return sum;
+        }
+    }
+
+    static class ByteLoader extends ClassLoader {
+        Class<?> define(String name, byte[] bytes) {
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    // Compiles distinct copies of Hot through all tiers, then reports the
+    // performance counters and the compiler threads of this VM.
+    public static class Workload {
+        public static void main(String[] args) throws Exception {
+            byte[] bytes;
+            try (InputStream in = Hot.class.getResourceAsStream("TestCompilerCPUBudget$Hot.class")) {
+                bytes = in.readAllBytes();
+            }
+            List<Class<?>> classes = new ArrayList<>();
+            for (int c = 0; c < 50; c++) {
+                Class<?> k = new ByteLoader().define(Hot.class.getName(), bytes);
+                classes.add(k);
+                Method work = k.getMethod("work", int.class);
+                for (int i = 0; i < 20_000; i++) {
+                    work.invoke(null, 100);
+                }
+            }
+            String pid = Long.toString(ProcessHandle.current().pid());
+            for (String cmd : new String[] { "PerfCounter.print", "Thread.print" }) {
+                ProcessBuilder pb = new ProcessBuilder(JDKToolFinder.getJDKTool("jcmd"), pid, cmd);
+                OutputAnalyzer output = new OutputAnalyzer(pb.start());
+                output.shouldHaveExitValue(0);
+                System.out.println(output.getStdout());
+            }
+        }
+    }
+
+    static OutputAnalyzer workload(String... opts) throws Exception {
+        List<String> cmd = new ArrayList<>(Arrays.asList(opts));
+        cmd.add("-Xbatch");
+        cmd.add("-XX:+CITime");
+        cmd.add(Workload.class.getName());
+        OutputAnalyzer output = ProcessTools.executeTestJvm(cmd);
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    static long counter(OutputAnalyzer output, String name) {
+        Matcher m = Pattern.compile(Pattern.quote(name) + "=(\\d+)").matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No counter " + name);
+        }
+        return Long.parseLong(m.group(1));
+    }
+
+    static int count(OutputAnalyzer output, String regex) {
+        Matcher m = Pattern.compile(regex).matcher(output.getStdout());
+        int n = 0;
+        while (m.find()) {
+            n++;
+        }
+        return n;
+    }
+
+    static void checkCpuTime(OutputAnalyzer output) {
+        // Tier 3 and tier 4 compilations happened and took CPU time
+        if (counter(output, "sun.ci.tier3CpuTime") <= 0) {
+            throw new RuntimeException("No tier 3 CPU time");
+        }
+        if (counter(output, "sun.ci.tier4CpuTime") <= 0) {
+            throw new RuntimeException("No tier 4 CPU time");
+        }
+        counter(output, "sun.ci.tier1CpuTime");
+        counter(output, "sun.ci.tier2CpuTime");
+
+        // Every compiler thread reports its own share per tier
+        int threads = count(output, "\"C[12] CompilerThread\\d+\"");
+        int reports = count(output, "Compilation CPU time: tier1=\\d+\\.\\d{3}s tier2=\\d+\\.\\d{3}s " +
+                                    "tier3=\\d+\\.\\d{3}s tier4=\\d+\\.\\d{3}s");
+        if (threads == 0 || threads != reports) {
+            throw new RuntimeException(threads + " compiler threads but " + reports + " CPU time reports");
+        }
+
+        // CITime prints the CPU time per tier
+        output.shouldMatch("Tier4 \\{.*cpu: +\\d+\\.\\d+ s\\}");
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessTools.executeTestJvm("-XX:CompilerCPUBudget=101", "-version")
+                    .shouldNotHaveExitValue(0)
+                    .shouldContain("outside the allowed range");
+
+        // No budget
+        checkCpuTime(workload("-XX:ActiveProcessorCount=8"));
+
+        // A budget of 1% of 8 processors allows a single C2 thread, but does
+        // not cap the C1 threads. The tier 4 compilations are delayed, never
+        // dropped.
+        OutputAnalyzer output = workload("-XX:ActiveProcessorCount=8",
+                                         "-XX:+UseDynamicNumberOfCompilerThreads",
+                                         "-XX:CompilerCPUBudget=1");
+        checkCpuTime(output);
+        int c2 = count(output, "\"C2 CompilerThread\\d+\"");
+        if (c2 != 1) {
+            throw new RuntimeException(c2 + " C2 compiler threads under a CompilerCPUBudget of 1%");
+        }
+        if (count(output, "\"C1 CompilerThread\\d+\"") < 1) {
+            throw new RuntimeException("No C1 compiler thread");
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.epsilon;
+
+/**
+ * @test TestResetTop
+ * @requires vm.gc.Epsilon
+ * @summary Epsilon with EpsilonResetTop must reclaim the unreachable heap
+ *          tail on System.gc() without corrupting reachable objects
+ * @library /test/lib
+ * @modules java.management
+ * @run main/othervm -Xmx256m -Xlog:gc
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC -XX:+EpsilonResetTop
+ *                   gc.epsilon.TestResetTop
+ * @run main/othervm -Xmx256m -Xlog:gc -XX:-UseTLAB
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC -XX:+EpsilonResetTop
+ *                   gc.epsilon.TestResetTop
+ */
+
+import java.lang.management.ManagementFactory;
+import java.util.ArrayList;
+import java.util.List;
+import javax.management.ObjectName;
+
+public class TestResetTop {
+    private static final int EPOCHS = 40;
+    // Each epoch allocates more than a quarter of the heap, so the test runs
+    // out of memory unless the space is reclaimed.
+    private static final int GARBAGE_PER_EPOCH = 64 * 1024 * 1024;
+
+    static class Item {
+        final int id;
+        final byte[] payload;
+        Item next;
+
+        Item(int id, int size) {
+            this.id = id;
+            this.payload = new byte[size];
+            for (int i = 0; i < size; i++) {
+                payload[i] = (byte)(id + i);
+            }
+        }
+
+        void verify() {
+            for (int i = 0; i < payload.length; i++) {
+                if (payload[i] != (byte)(id + i)) {
+                    throw new RuntimeException("item " + id + " corrupted at " + i);
+                }
+            }
+        }
+    }
+
+    static List<Item> live = new ArrayList<>();
+    static Object sink;
+
+    private static void verifyLive() {
+        for (int i = 0; i < live.size(); i++) {
+            Item item = live.get(i);
+            if (item.id != i) {
+                throw new RuntimeException("item " + i + " has id " + item.id);
+            }
+            item.verify();
+            if (item.next != null) {
+                item.next.verify();
+            }
+        }
+    }
+
+    private static long used() {
+        Runtime rt = Runtime.getRuntime();
+        return rt.totalMemory() - rt.freeMemory();
+    }
+
+    // Walks the whole heap, which requires the unreachable objects below
+    // the reset top to have been turned into well-formed fillers.
+    private static void walkHeap() throws Exception {
+        ManagementFactory.getPlatformMBeanServer().invoke(
+            new ObjectName("com.sun.management:type=DiagnosticCommand"),
+            "gcClassHistogram",
+            new Object[] { new String[0] },
+            new String[] { String[].class.getName() });
+    }
+
+    private static long gc(String what, long minReclaimed) {
+        long before = used();
+        System.gc();
+        long after = used();
+        System.out.println(what + ": used " + before + " -> " + after);
+        if (before - after < minReclaimed) {
+            throw new RuntimeException(what + ": only " + (before - after) + " bytes reclaimed");
+        }
+        return after;
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Reachable items at the bottom of the heap, with garbage between
+        // them that has to be filled rather than reclaimed.
+        for (int i = 0; i < 100; i++) {
+            live.add(new Item(i, 100 + i));
+            sink = new byte[10 * 1024];
+        }
+        for (int i = 0; i < 100; i += 10) {
+            live.get(i).next = new Item(i + 1000, 50);
+        }
+        sink = null;
+        long baseline = gc("Initial", 0);
+        verifyLive();
+        walkHeap();
+
+        for (int epoch = 0; epoch < EPOCHS; epoch++) {
+            // Garbage, with one object kept reachable in the middle of it:
+            // only the upper half can be reclaimed by the first GC.
+            Item pinned = null;
+            for (int allocated = 0; allocated < GARBAGE_PER_EPOCH; allocated += 1024) {
+                sink = new byte[1024 - 16];
+                if (allocated == GARBAGE_PER_EPOCH / 2) {
+                    pinned = new Item(epoch, 1000);
+                }
+            }
+            sink = null;
+
+            gc("Epoch " + epoch + " pinned", GARBAGE_PER_EPOCH / 4);
+            pinned.verify();
+            verifyLive();
+            walkHeap();
+
+            // With the pinning object gone, the fillers are reclaimed too.
+            pinned = null;
+            long after = gc("Epoch " + epoch + " unpinned", 0);
+            if (after - baseline > GARBAGE_PER_EPOCH / 8) {
+                throw new RuntimeException("Epoch " + epoch + ": " + (after - baseline) +
+                                           " bytes not reclaimed");
+            }
+            verifyLive();
+            walkHeap();
+        }
+    }
+}
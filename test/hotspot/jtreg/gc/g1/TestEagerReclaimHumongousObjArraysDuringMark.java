@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestEagerReclaimHumongousObjArraysDuringMark
+ * @summary Test to make sure that a humongous object array allocated during concurrent
+ * marking is eagerly reclaimed by a young GC within the marking cycle, and that the young
+ * objects it referenced are not corrupted.
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @build sun.hotspot.WhiteBox
+ * @run driver jdk.test.lib.helpers.ClassFileInstaller sun.hotspot.WhiteBox
+ * @run driver gc.g1.TestEagerReclaimHumongousObjArraysDuringMark
+ */
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+import sun.hotspot.WhiteBox;
+
+class TestEagerReclaimHumongousObjArraysDuringMarkReclaim {
+    private static final WhiteBox WB = WhiteBox.getWhiteBox();
+
+    public static final int M = 1024*1024;
+
+    // Young objects referenced by the large object, also kept alive from here.
+    static Object[] young = new Object[16];
+
+    public static void main(String[] args) {
+        WB.concurrentGCAcquireControl();
+        try {
+            WB.concurrentGCRunTo(WB.AFTER_MARKING_STARTED);
+            Asserts.assertTrue(WB.g1InConcurrentMark(), "must be in concurrent mark");
+
+            // Allocated after the start of marking, so above TAMS.
+            Object[] large = new Object[2 * M];
+            Asserts.assertTrue(WB.g1IsHumongous(large), "must be humongous");
+            for (int i = 0; i < young.length; i++) {
+                young[i] = new int[i + 1];
+                large[i * (large.length / young.length)] = young[i];
+            }
+            System.out.println(String.format("Humongous object array @ 0x%016x", WB.getObjectAddress(large)));
+            large = null;
+
+            WB.youngGC();
+            Asserts.assertTrue(WB.g1InConcurrentMark(), "must still be in concurrent mark");
+
+            for (int i = 0; i < young.length; i++) {
+                Asserts.assertEQ(((int[])young[i]).length, i + 1, "corrupted young object");
+            }
+            WB.concurrentGCRunToIdle();
+        } finally {
+            WB.concurrentGCReleaseControl();
+        }
+        WB.youngGC();
+    }
+}
+
+public class TestEagerReclaimHumongousObjArraysDuringMark {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xbootclasspath/a:.",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+WhiteBoxAPI",
+            "-XX:+UseG1GC",
+            "-Xms128M",
+            "-Xmx128M",
+            "-XX:G1HeapRegionSize=1M",
+            "-XX:+VerifyBeforeGC",
+            "-XX:+VerifyAfterGC",
+            "-Xlog:gc+humongous=debug",
+            TestEagerReclaimHumongousObjArraysDuringMarkReclaim.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+
+        String address = output.firstMatch("Humongous object array @ (0x[0-9a-f]+)", 1);
+        Asserts.assertNotNull(address, "address of the humongous object array not printed");
+        output.shouldMatch("Reclaimed humongous region [0-9]+ \\(object size [0-9]+ @ " + address + "\\)");
+    }
+}
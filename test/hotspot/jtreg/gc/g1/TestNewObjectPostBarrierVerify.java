@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestNewObjectPostBarrierVerify
+ * @summary Stores into new objects past branches keep the remembered sets
+ *          complete when the post barrier is elided by C2
+ * @requires vm.gc.G1 & vm.compiler2.enabled
+ * @run main/othervm -XX:+UseG1GC -Xmx128m -Xmn8m -XX:G1HeapRegionSize=1m
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *                   -XX:+G1VerifyRSetsDuringFullGC -XX:-BackgroundCompilation
+ *                   gc.g1.TestNewObjectPostBarrierVerify
+ */
+
+// Compiled code allocates holders, branches on its arguments, and then
+// stores young objects into them. The holders are kept alive in an array
+// so they are promoted, and large holder arrays are humongous so they are
+// allocated outside eden by the slow path. Heap verification checks that
+// every old-to-young reference is covered by a remembered set entry.
+public class TestNewObjectPostBarrierVerify {
+
+    static final int Iterations = 200_000;
+    static final int Retained = 4096;
+    // Larger than half a region, so allocated as humongous
+    static final int HumongousLength = 1024 * 1024 / 4;
+
+    static class Holder {
+        Object f;
+        Object g;
+    }
+
+    static Object[] retained = new Object[Retained];
+
+    static Holder newHolder(Object a, Object b, int i) {
+        Holder h = new Holder();
+        if (a != null) {
+            h.f = a;
+        }
+        if ((i & 1) == 0) {
+            h.g = b;
+        }
+        return h;
+    }
+
+    static Object[] newArray(int length, Object a, int i) {
+        Object[] array = new Object[length];
+        if (a != null && i >= 0) {
+            array[i % length] = a;
+            array[length - 1] = a;
+        }
+        return array;
+    }
+
+    static void check(Holder h, Object a, Object b, int i) {
+        if (h.f != a || ((i & 1) == 0 && h.g != b)) {
+            throw new RuntimeException("Lost store at iteration " + i);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < Iterations; i++) {
+            Object a = new int[8];
+            Object b = new Object();
+            Holder h = newHolder(a, b, i);
+            check(h, a, b, i);
+            retained[i % Retained] = h;
+
+            Object[] small = newArray(16, b, i);
+            retained[(i + 1) % Retained] = small;
+
+            if (i % 5_000 == 0) {
+                Object[] large = newArray(HumongousLength, b, i);
+                retained[(i + 2) % Retained] = large;
+            }
+            if (i % 50_000 == 0) {
+                System.gc();
+            }
+        }
+
+        for (Object o : retained) {
+            if (o instanceof Holder && ((Holder)o).f == null) {
+                throw new RuntimeException("Holder lost its field");
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/* @test TestPinJNIArrayElements
+ * @summary test that Get<Type>ArrayElements pins and Release<Type>ArrayElements unpins the array
+ * @requires vm.gc.Shenandoah
+ * @library /test/lib
+ * @modules java.management
+ *
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+PinJNIArrayElements -XX:+UseShenandoahGC
+ *      -Xmx128m -XX:ShenandoahRegionSize=1m
+ *      TestPinJNIArrayElements
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+PinJNIArrayElements -XX:+UseShenandoahGC
+ *      -Xmx128m -XX:ShenandoahRegionSize=1m -Xcheck:jni
+ *      TestPinJNIArrayElements
+ */
+
+import java.lang.management.ManagementFactory;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.JMXExecutor;
+
+public class TestPinJNIArrayElements {
+    static {
+        System.loadLibrary("PinJNIArrayElements");
+    }
+
+    // Release modes, see jni.h
+    private static final int MODE_COPY_FREE = 0;
+    private static final int JNI_COMMIT     = 1;
+    private static final int JNI_ABORT      = 2;
+
+    // Small arrays share a region with other objects, large ones are humongous.
+    private static final int[] SIZES = { 16, 4 * 1024 * 1024 / Integer.BYTES };
+
+    private static final Pattern PIN_COUNT = Pattern.compile("\\|CP\\s+(\\d+)");
+    private static final Pattern PINNED_REGION = Pattern.compile("\\|(P  |HP |CSP)\\|");
+
+    // Gets the elements, stores value into each of them and keeps them
+    // until release() is called. Returns the isCopy result.
+    private static native boolean acquire(int[] a, int value);
+    private static native void release(int[] a, int mode);
+
+    private static boolean checkJNI;
+
+    public static void main(String[] args) {
+        checkJNI = ManagementFactory.getRuntimeMXBean().getInputArguments().contains("-Xcheck:jni");
+        for (int size : SIZES) {
+            testCopyFree(size);
+            testCommit(size);
+            testAbort(size);
+        }
+    }
+
+    private static void testCopyFree(int size) {
+        int[] a = new int[size];
+        acquireElements(a, 1);
+        assertPinned();
+        release(a, MODE_COPY_FREE);
+        assertUnpinned();
+        assertContents(a, 1);
+    }
+
+    private static void testCommit(int size) {
+        int[] a = new int[size];
+        acquireElements(a, 2);
+        release(a, JNI_COMMIT);
+        // The elements are written back, but still held by native code.
+        assertContents(a, 2);
+        assertPinned();
+        System.gc();
+        assertPinned();
+        release(a, MODE_COPY_FREE);
+        assertUnpinned();
+        assertContents(a, 2);
+    }
+
+    private static void testAbort(int size) {
+        int[] a = new int[size];
+        acquireElements(a, 3);
+        assertPinned();
+        release(a, JNI_ABORT);
+        assertUnpinned();
+        // Without a copy, there is nothing to discard.
+        assertContents(a, checkJNI ? 0 : 3);
+    }
+
+    private static void acquireElements(int[] a, int value) {
+        boolean isCopy = acquire(a, value);
+        if (!checkJNI) {
+            // -Xcheck:jni hands out a guarded copy of the pinned elements
+            Asserts.assertFalse(isCopy, "elements should not be copied");
+        }
+    }
+
+    private static void assertContents(int[] a, int value) {
+        for (int i = 0; i < a.length; i++) {
+            Asserts.assertEquals(a[i], value, "a[" + i + "]");
+        }
+    }
+
+    private static void assertPinned() {
+        Asserts.assertGT(pinCount(false), 0, "region should be pinned");
+    }
+
+    private static void assertUnpinned() {
+        Asserts.assertEquals(pinCount(false), 0, "region should be unpinned");
+        // The region state follows the pin count at the next pause.
+        System.gc();
+        Asserts.assertEquals(pinCount(true), 0, "region should not be in a pinned state");
+    }
+
+    private static int pinCount(boolean states) {
+        String out = new JMXExecutor().execute("VM.info").getStdout();
+        Matcher m = (states ? PINNED_REGION : PIN_COUNT).matcher(out);
+        int count = 0;
+        while (m.find()) {
+            count += states ? 1 : Integer.parseInt(m.group(1));
+        }
+        return count;
+    }
+}
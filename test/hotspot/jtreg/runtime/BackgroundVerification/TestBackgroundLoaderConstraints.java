@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Loader constraint violations are reported on the linking thread
+ *          with the same message when application classes are linked in
+ *          the background
+ * @library /test/lib
+ * @modules java.base/jdk.internal.org.objectweb.asm
+ * @run driver TestBackgroundLoaderConstraints
+ */
+
+import jdk.internal.org.objectweb.asm.ClassWriter;
+import jdk.internal.org.objectweb.asm.MethodVisitor;
+import static jdk.internal.org.objectweb.asm.Opcodes.*;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestBackgroundLoaderConstraints {
+
+    public static class Foo {
+    }
+
+    public static class AppSuper {
+        public void m(Foo f) {
+        }
+    }
+
+    static final String FOO = Foo.class.getName().replace('.', '/');
+    static final String APP_SUPER = AppSuper.class.getName().replace('.', '/');
+
+    // Another class named like Foo
+    static byte[] foo() {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_MAXS | ClassWriter.COMPUTE_FRAMES);
+        cw.visit(V11, ACC_PUBLIC | ACC_SUPER, FOO, null, "java/lang/Object", null);
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC, "<init>", "()V", null, null);
+        mv.visitCode();
+        mv.visitVarInsn(ALOAD, 0);
+        mv.visitMethodInsn(INVOKESPECIAL, "java/lang/Object", "<init>", "()V", false);
+        mv.visitInsn(RETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    // "class Sub extends AppSuper { public void m(Foo f) {} }", where Foo
+    // is resolved by the defining loader of Sub
+    static byte[] sub() {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_MAXS | ClassWriter.COMPUTE_FRAMES);
+        cw.visit(V11, ACC_PUBLIC | ACC_SUPER, "Sub", null, APP_SUPER, null);
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC, "<init>", "()V", null, null);
+        mv.visitCode();
+        mv.visitVarInsn(ALOAD, 0);
+        mv.visitMethodInsn(INVOKESPECIAL, APP_SUPER, "<init>", "()V", false);
+        mv.visitInsn(RETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        mv = cw.visitMethod(ACC_PUBLIC, "m", "(L" + FOO + ";)V", null, null);
+        mv.visitCode();
+        mv.visitInsn(RETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    static class ByteLoader extends ClassLoader {
+        ByteLoader() {
+            super("ByteLoader", ClassLoader.getSystemClassLoader());
+        }
+
+        Class<?> define(String name, byte[] bytes) {
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    public static class Child {
+        public static void main(String[] args) throws Exception {
+            // AppSuper and Foo are linked in the background, if at all
+            ClassLoader app = ClassLoader.getSystemClassLoader();
+            Class.forName(AppSuper.class.getName(), false, app);
+            Class.forName(Foo.class.getName(), false, app);
+            Thread.sleep(1000);
+
+            ByteLoader loader = new ByteLoader();
+            loader.define(FOO.replace('/', '.'), foo());
+            Class<?> sub = loader.define("Sub", sub());
+            System.out.println("Defined");
+            for (int i = 0; i < 2; i++) {
+                try {
+                    sub.getDeclaredConstructor().newInstance();
+                    throw new RuntimeException("No LinkageError");
+                } catch (LinkageError e) {
+                    System.out.println("Attempt " + i + ": " + e.getClass().getName() + ": " + e.getMessage());
+                }
+            }
+
+            // The application classes themselves are fine
+            new AppSuper().m(new Foo());
+        }
+    }
+
+    static String run(int threads) throws Exception {
+        OutputAnalyzer output = ProcessTools.executeTestJvm(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:BackgroundVerificationThreads=" + threads,
+            Child.class.getName());
+        output.shouldHaveExitValue(0);
+        output.stdoutShouldMatch("(?s)Defined.*Attempt 0: .*loader constraint violation.*Attempt 1: ");
+        output.shouldNotContain("Exception in thread");
+        String out = output.getStdout();
+        // The message names the loader instances by identity hash
+        return out.substring(out.indexOf("Attempt 0: ")).replaceAll("@[0-9a-f]+", "@");
+    }
+
+    public static void main(String[] args) throws Exception {
+        String expected = run(0);
+        for (int threads : new int[] { 1, 4 }) {
+            String actual = run(threads);
+            if (!actual.equals(expected)) {
+                throw new RuntimeException("Different errors with " + threads + " threads:\n" +
+                                           actual + "\ninstead of\n" + expected);
+            }
+        }
+    }
+}
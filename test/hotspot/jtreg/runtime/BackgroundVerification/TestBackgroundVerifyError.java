@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary A VerifyError found by a background verification thread is
+ *          thrown on the thread that links the class, when it links it
+ * @library /test/lib
+ * @modules java.base/jdk.internal.org.objectweb.asm
+ * @run driver TestBackgroundVerifyError
+ */
+
+import java.io.File;
+import java.io.FileOutputStream;
+
+import jdk.internal.org.objectweb.asm.ClassWriter;
+import jdk.internal.org.objectweb.asm.MethodVisitor;
+import static jdk.internal.org.objectweb.asm.Opcodes.*;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestBackgroundVerifyError {
+
+    // "public static int get() { return "bad"; }", which fails verification
+    static byte[] bad() {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_MAXS);
+        cw.visit(V11, ACC_PUBLIC | ACC_SUPER, "Bad", null, "java/lang/Object", null);
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC | ACC_STATIC, "get", "()I", null, null);
+        mv.visitCode();
+        mv.visitLdcInsn("bad");
+        mv.visitInsn(IRETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    public static class Good {
+        public static int get() { return 42; }
+    }
+
+    public static class Child {
+        public static void main(String[] args) throws Exception {
+            ClassLoader loader = ClassLoader.getSystemClassLoader();
+            // Loaded but not linked, so they are queued for the background threads
+            Class<?> good = Class.forName(Good.class.getName(), false, loader);
+            Class.forName("Bad", false, loader);
+            Thread.sleep(1000);
+            System.out.println("Loaded");
+
+            if ((Integer)good.getMethod("get").invoke(null) != 42) {
+                throw new RuntimeException("Good class is broken");
+            }
+            // The error is thrown here, and again on every attempt to link
+            for (int i = 0; i < 2; i++) {
+                try {
+                    Class.forName("Bad", true, loader);
+                    throw new RuntimeException("No VerifyError");
+                } catch (VerifyError e) {
+                    System.out.println("Attempt " + i + ": " + e.getMessage());
+                }
+            }
+        }
+    }
+
+    static OutputAnalyzer run(int threads) throws Exception {
+        String cp = "bad" + File.pathSeparator + System.getProperty("test.class.path");
+        OutputAnalyzer output = ProcessTools.executeTestJvm(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:BackgroundVerificationThreads=" + threads,
+            "-cp", cp,
+            Child.class.getName());
+        output.shouldHaveExitValue(0);
+        output.stdoutShouldMatch("(?s)Loaded.*Attempt 0: .*Bad.*Attempt 1: .*Bad");
+        output.shouldNotContain("Exception in thread");
+        return output;
+    }
+
+    static String attempts(OutputAnalyzer output) {
+        String out = output.getStdout();
+        return out.substring(out.indexOf("Attempt 0: "));
+    }
+
+    public static void main(String[] args) throws Exception {
+        new File("bad").mkdir();
+        try (FileOutputStream out = new FileOutputStream(new File("bad", "Bad.class"))) {
+            out.write(bad());
+        }
+        String expected = attempts(run(0));
+        for (int threads : new int[] { 1, 4 }) {
+            String actual = attempts(run(threads));
+            if (!actual.equals(expected)) {
+                throw new RuntimeException("Different errors with " + threads + " threads:\n" +
+                                           actual + "\ninstead of\n" + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Boot classes named in the class list are prefetched from the
+ *          runtime image, skipping those in a mapped CDS archive
+ * @requires vm.cds
+ * @library /test/lib
+ * @run driver TestPrefetchBootClasses
+ */
+
+import java.io.File;
+import java.io.PrintWriter;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestPrefetchBootClasses {
+    static final Pattern RESULT =
+        Pattern.compile("Prefetched (\\d+) class list entries from (.*), (\\d+) are archived");
+
+    public static class Load {
+        public static void main(String[] args) throws Exception {
+            // Boot classes that are rarely in the default archive
+            Class.forName("java.util.concurrent.ConcurrentSkipListMap");
+            Class.forName("java.util.concurrent.Exchanger");
+            System.out.println("Loaded");
+            // The prefetcher logs once it is through the class list
+            Thread.sleep(1000);
+        }
+    }
+
+    static OutputAnalyzer run(String... opts) throws Exception {
+        List<String> cmd = new ArrayList<>();
+        cmd.add("-XX:+UnlockExperimentalVMOptions");
+        cmd.add("-XX:+PrefetchBootClasses");
+        cmd.add("-Xlog:class+load=info");
+        cmd.add("-Xlog:cds=info");
+        cmd.addAll(Arrays.asList(opts));
+        cmd.add(Load.class.getName());
+        OutputAnalyzer output = ProcessTools.executeTestJvm(cmd);
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Loaded");
+        return output;
+    }
+
+    static boolean archiveMapped(OutputAnalyzer output) {
+        return Pattern.compile("Mapped static\\s+region").matcher(output.getStdout()).find();
+    }
+
+    static Matcher result(OutputAnalyzer output) {
+        Matcher m = RESULT.matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No prefetch result in the output");
+        }
+        return m;
+    }
+
+    public static void main(String[] args) throws Exception {
+        File classlist = new File("prefetch.classlist");
+        try (PrintWriter out = new PrintWriter(classlist)) {
+            out.println("# comment");
+            out.println("java/lang/Object");
+            out.println("java/lang/String id: 1");
+            out.println("java/util/concurrent/ConcurrentSkipListMap");
+            out.println("java/util/concurrent/Exchanger");
+            out.println("does/not/Exist");
+            out.println("@lambda-proxy java/lang/Object run");
+            out.println("java/util/concurrent/Exchanger");
+        }
+        String list = "-XX:SharedClassListFile=" + classlist.getPath();
+
+        // Without an archive all entries are read from the runtime image
+        OutputAnalyzer output = run("-Xshare:off", list);
+        Matcher m = result(output);
+        if (Integer.parseInt(m.group(1)) != 6 || Integer.parseInt(m.group(3)) != 0) {
+            throw new RuntimeException("Unexpected counts: " + m.group());
+        }
+
+        // The default class list is used without an archive
+        output = run("-Xshare:off");
+        m = result(output);
+        if (Integer.parseInt(m.group(1)) == 0) {
+            throw new RuntimeException("Nothing prefetched from the default class list: " + m.group());
+        }
+
+        // With the default archive mapped, the archived classes are skipped
+        // and the others are still prefetched
+        output = run("-Xshare:auto", list);
+        if (archiveMapped(output)) {
+            m = result(output);
+            int prefetched = Integer.parseInt(m.group(1));
+            int archived = Integer.parseInt(m.group(3));
+            // Object and String are always archived, does/not/Exist never is
+            if (archived < 2 || prefetched < 1 || prefetched + archived != 6) {
+                throw new RuntimeException("Unexpected counts with CDS: " + m.group());
+            }
+
+            // The default class list names only archived classes
+            output = run("-Xshare:auto");
+            output.shouldNotMatch(RESULT.pattern());
+        } else {
+            System.out.println("No archive mapped, skipping the CDS cases");
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary The class prefetcher asks the runtime image to read ahead the
+ *          listed class files in coalesced ranges
+ * @library /test/lib
+ * @run driver TestPrefetchReadahead
+ */
+
+import java.io.File;
+import java.io.PrintWriter;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestPrefetchReadahead {
+    static final Pattern ADVISED =
+        Pattern.compile("Advised readahead of (\\d+) class list entries in (\\d+) ranges");
+
+    public static class Load {
+        public static void main(String[] args) throws Exception {
+            Class.forName("java.util.concurrent.ConcurrentSkipListMap");
+            System.out.println("Loaded");
+            // The prefetcher logs once it is through the class list
+            Thread.sleep(1000);
+        }
+    }
+
+    static Matcher advised(String... opts) throws Exception {
+        String[] cmd = new String[opts.length + 4];
+        cmd[0] = "-XX:+UnlockExperimentalVMOptions";
+        cmd[1] = "-XX:+PrefetchBootClasses";
+        cmd[2] = "-Xlog:class+load=info";
+        System.arraycopy(opts, 0, cmd, 3, opts.length);
+        cmd[cmd.length - 1] = Load.class.getName();
+        OutputAnalyzer output = ProcessTools.executeTestJvm(cmd);
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Loaded");
+        Matcher m = ADVISED.matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No readahead advice in the output");
+        }
+        return m;
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Nested classes are stored next to each other in the image, and
+        // the missing class has no range at all.
+        File classlist = new File("readahead.classlist");
+        try (PrintWriter out = new PrintWriter(classlist)) {
+            out.println("java/util/concurrent/ConcurrentSkipListMap");
+            out.println("java/util/concurrent/ConcurrentSkipListMap$Node");
+            out.println("java/util/concurrent/ConcurrentSkipListMap$Index");
+            out.println("java/util/concurrent/ConcurrentSkipListMap$KeySet");
+            out.println("does/not/Exist");
+        }
+        Matcher m = advised("-Xshare:off", "-XX:SharedClassListFile=" + classlist.getPath());
+        int entries = Integer.parseInt(m.group(1));
+        int ranges = Integer.parseInt(m.group(2));
+        if (entries != 5 || ranges < 1 || ranges > 4) {
+            throw new RuntimeException("Unexpected readahead: " + m.group());
+        }
+
+        // The whole default class list takes far fewer ranges than entries
+        m = advised("-Xshare:off");
+        entries = Integer.parseInt(m.group(1));
+        ranges = Integer.parseInt(m.group(2));
+        if (entries < 100 || ranges < 1 || ranges > entries / 2) {
+            throw new RuntimeException("Ranges are not coalesced: " + m.group());
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Write a field layout profile at exit and read it back in a later run
+ * @requires vm.flagless
+ * @library /test/lib
+ * @run driver TestFieldLayoutProfile
+ */
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestFieldLayoutProfile {
+
+    private static final String HOLDER = "TestFieldLayoutProfile$Wide";
+
+    public static void main(String[] args) throws Exception {
+        Path profile = Path.of("fieldlayout.profile").toAbsolutePath();
+
+        // Training run
+        OutputAnalyzer output = run("-XX:DumpFieldLayoutProfileAtExit=" + profile);
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("Wrote [1-9][0-9]* fields to field layout profile");
+
+        List<String> lines = Files.readAllLines(profile);
+        Asserts.assertTrue(lines.get(0).startsWith("# field layout profile "), "Bad header: " + lines.get(0));
+        Asserts.assertTrue(lines.contains(HOLDER + " hot"), "Hot field not in the profile");
+        Asserts.assertFalse(lines.contains(HOLDER + " f0"), "Unused field in the profile");
+
+        // Run with the profile; the hot field moves in front of the others
+        output = run("-XX:FieldLayoutProfileFile=" + profile);
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("Read [1-9][0-9]* fields from field layout profile");
+
+        // A profile of another VM release is ignored
+        lines.set(0, "# field layout profile 1 not-this-release");
+        Files.write(profile, lines);
+        output = run("-XX:FieldLayoutProfileFile=" + profile);
+        output.shouldHaveExitValue(0);
+        output.shouldContain("written by a different VM");
+    }
+
+    private static OutputAnalyzer run(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            flag,
+            "-Xlog:class=info",
+            Workload.class.getName());
+        return new OutputAnalyzer(pb.start());
+    }
+
+    // Larger than a cache line, with the hot field declared last
+    static class Wide {
+        long f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11;
+        long hot;
+    }
+
+    static class Workload {
+        static long touch(Wide w, int i) {
+            w.hot += i;
+            return w.hot;
+        }
+
+        static long once(Wide w, long sum) {
+            w.f11 = sum;
+            return w.f11;
+        }
+
+        public static void main(String[] args) {
+            Wide w = new Wide();
+            long sum = 0;
+            for (int i = 0; i < 100_000; i++) {
+                sum += touch(w, i);
+            }
+            System.out.println(once(w, sum));
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test id=deferred
+ * @summary Test that MetaspaceUncommitDelay defers the metaspace purge to the service thread
+ * @library /test/lib
+ * @modules java.management
+ * @run main/othervm -XX:+UseG1GC -XX:MetaspaceUncommitDelay=3000 TestDeferredMetaspacePurge deferred
+ */
+
+/*
+ * @test id=immediate
+ * @summary Test that metaspace is purged during class unloading by default
+ * @library /test/lib
+ * @modules java.management
+ * @run main/othervm -XX:+UseG1GC TestDeferredMetaspacePurge immediate
+ */
+
+import java.io.InputStream;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.JMXExecutor;
+
+public class TestDeferredMetaspacePurge {
+
+    private static final int NUM_LOADERS = 500;
+    private static final long TIMEOUT_MS = 60_000;
+
+    public static class Loadee {
+        public static int value() { return 42; }
+    }
+
+    // Defines its own copy of Loadee, so that the class is unloaded
+    // together with the loader.
+    static class OneShotLoader extends ClassLoader {
+        private final byte[] bytes;
+
+        OneShotLoader(byte[] bytes) {
+            super(null);
+            this.bytes = bytes;
+        }
+
+        @Override
+        protected Class<?> findClass(String name) throws ClassNotFoundException {
+            if (name.equals(Loadee.class.getName())) {
+                return defineClass(name, bytes, 0, bytes.length);
+            }
+            throw new ClassNotFoundException(name);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        boolean deferred = args[0].equals("deferred");
+        byte[] bytes = loadeeBytes();
+
+        long purges = counter("num_purges");
+        long deferredPurges = counter("num_purges_deferred");
+
+        loadAndUnload(bytes);
+
+        if (deferred) {
+            // The purge is only requested during class unloading ...
+            Asserts.assertGT(counter("num_purges_deferred"), deferredPurges, "purge should be requested");
+            Asserts.assertEquals(counter("num_purges"), purges, "purge should be deferred");
+
+            // ... and done by the service thread once the delay has passed.
+            long deadline = System.currentTimeMillis() + TIMEOUT_MS;
+            while (counter("num_purges") == purges) {
+                Asserts.assertLT(System.currentTimeMillis(), deadline, "deferred purge did not happen");
+                Thread.sleep(100);
+            }
+
+            // Later unloading requests another purge.
+            purges = counter("num_purges");
+            deferredPurges = counter("num_purges_deferred");
+            loadAndUnload(bytes);
+            Asserts.assertGT(counter("num_purges_deferred"), deferredPurges, "purge should be requested again");
+            deadline = System.currentTimeMillis() + TIMEOUT_MS;
+            while (counter("num_purges") == purges) {
+                Asserts.assertLT(System.currentTimeMillis(), deadline, "second deferred purge did not happen");
+                Thread.sleep(100);
+            }
+        } else {
+            Asserts.assertGT(counter("num_purges"), purges, "purge should happen during class unloading");
+            Asserts.assertEquals(counter("num_purges_deferred"), deferredPurges, "purge should not be deferred");
+        }
+    }
+
+    private static byte[] loadeeBytes() throws Exception {
+        String resource = Loadee.class.getName().replace('.', '/') + ".class";
+        try (InputStream in = TestDeferredMetaspacePurge.class.getClassLoader().getResourceAsStream(resource)) {
+            return in.readAllBytes();
+        }
+    }
+
+    private static void loadAndUnload(byte[] bytes) throws Exception {
+        for (int i = 0; i < NUM_LOADERS; i++) {
+            Class<?> c = Class.forName(Loadee.class.getName(), true, new OneShotLoader(bytes));
+            Asserts.assertNotEquals(c, Loadee.class);
+            Asserts.assertEquals(c.getMethod("value").invoke(null), 42);
+        }
+        // A full GC unloads the loaders and their metaspace arenas.
+        System.gc();
+    }
+
+    private static long counter(String name) {
+        String out = new JMXExecutor().execute("VM.metaspace").getStdout();
+        Matcher m = Pattern.compile("^" + name + ": (\\d+)\\.$", Pattern.MULTILINE).matcher(out);
+        Asserts.assertTrue(m.find(), name + " is not printed by VM.metaspace");
+        return Long.parseLong(m.group(1));
+    }
+}
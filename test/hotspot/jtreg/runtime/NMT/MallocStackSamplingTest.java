@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Sampled malloc call stacks must give unbiased per site estimates,
+ *          also for allocation patterns with the period of the sample interval
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @build sun.hotspot.WhiteBox
+ * @run driver jdk.test.lib.helpers.ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:NativeMemoryTracking=detail -XX:NMTMallocStackSamplingInterval=16
+ *                   MallocStackSamplingTest
+ */
+
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.JDKToolFinder;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+import sun.hotspot.WhiteBox;
+
+public class MallocStackSamplingTest {
+    static final int PERIODS = 4096;
+    static final int SMALL = 15;   // small blocks per period
+    static final int LARGE = 4096; // size of the one large block per period
+
+    public static void main(String args[]) throws Exception {
+        WhiteBox wb = WhiteBox.getWhiteBox();
+        long[] addrs = new long[PERIODS * (SMALL + 1)];
+        int n = 0;
+        // One large block followed by 15 small ones: with a fixed stride of 16
+        // every sample would see the same kind of block.
+        for (int i = 0; i < PERIODS; i++) {
+            addrs[n++] = wb.NMTMalloc(LARGE);
+            for (int j = 0; j < SMALL; j++) {
+                addrs[n++] = wb.NMTMalloc(1);
+            }
+        }
+
+        String pid = Long.toString(ProcessTools.getProcessId());
+        ProcessBuilder pb = new ProcessBuilder();
+        pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid, "VM.native_memory", "detail", "scale=KB" });
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Malloc call stacks sampled once in 16 allocations on average");
+
+        // The summary figure is exact
+        Matcher m = Pattern.compile("Test \\(reserved=(\\d+)KB").matcher(output.getStdout());
+        if (!m.find()) {
+            throw new RuntimeException("No summary line for the Test category");
+        }
+        long exact = Long.parseLong(m.group(1));
+
+        // The per site figures are estimates, sum them over all sites of the category
+        long estimate = 0;
+        m = Pattern.compile("\\(malloc=(\\d+)KB type=Test").matcher(output.getStdout());
+        while (m.find()) {
+            estimate += Long.parseLong(m.group(1));
+        }
+
+        System.out.println("exact: " + exact + "KB, estimate: " + estimate + "KB");
+        if (estimate < exact / 2 || estimate > exact * 2) {
+            throw new RuntimeException("Estimate " + estimate + "KB too far from the exact " + exact + "KB");
+        }
+
+        for (int i = 0; i < n; i++) {
+            wb.NMTFree(addrs[i]);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Load the archived heap objects into the heap with Serial and Parallel GC
+ * @requires vm.cds.write.archived.java.heap & vm.flagless
+ * @library /test/lib
+ * @run driver TestLoadedArchivedHeap
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestLoadedArchivedHeap {
+
+    public static void main(String[] args) throws Exception {
+        String archive = "TestLoadedArchivedHeap.jsa";
+        OutputAnalyzer output = ProcessTools.executeTestJvm(
+            "-XX:+UseG1GC",
+            "-XX:SharedArchiveFile=" + archive,
+            "-Xshare:dump",
+            "-Xlog:cds");
+        output.shouldHaveExitValue(0);
+
+        for (String gc : new String[] { "-XX:+UseSerialGC", "-XX:+UseParallelGC" }) {
+            output = ProcessTools.executeTestJvm(
+                gc,
+                "-XX:SharedArchiveFile=" + archive,
+                "-Xshare:auto",
+                "-XX:+UnlockDiagnosticVMOptions",
+                "-XX:+VerifySharedSpaces",
+                "-XX:+VerifyBeforeGC",
+                "-XX:+VerifyAfterGC",
+                "-Xlog:cds",
+                Workload.class.getName());
+            output.shouldHaveExitValue(0);
+            // Every used closed and open region is loaded and registered
+            output.shouldMatch("Loading heap data: region\\[[0-9]+\\]");
+            output.shouldMatch("Loaded [0-9]+ bytes of CDS heap data");
+            output.shouldNotContain("Unable to load heap region");
+            output.shouldContain("OK");
+        }
+    }
+
+    static class Workload {
+        public static void main(String[] args) {
+            // Archived objects reached through patched pointers from both
+            // closed (strings) and open (mirrors, Integer cache) regions
+            if (Integer.valueOf(127) != Integer.valueOf(127)) {
+                throw new RuntimeException("Integer cache is broken");
+            }
+            if ("java.lang.Object".intern() != Object.class.getName().intern()) {
+                throw new RuntimeException("Interned strings are broken");
+            }
+            System.gc();
+            if (!Object.class.getName().equals("java.lang.Object")) {
+                throw new RuntimeException("Archived mirror is broken after GC");
+            }
+            System.out.println("OK");
+        }
+    }
+}
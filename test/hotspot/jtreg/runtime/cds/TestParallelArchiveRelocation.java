@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Relocate the CDS archive with and without the GC worker threads
+ * @requires vm.cds & vm.flagless
+ * @library /test/lib
+ * @run driver TestParallelArchiveRelocation
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestParallelArchiveRelocation {
+
+    private static final String RELOCATED =
+        "Relocated static archive pointers by -?[0-9]+ bytes in [0-9.]+ ms using ";
+
+    public static void main(String[] args) throws Exception {
+        String archive = "TestParallelArchiveRelocation.jsa";
+        OutputAnalyzer output = ProcessTools.executeTestJvm(
+            "-XX:SharedArchiveFile=" + archive,
+            "-Xshare:dump",
+            "-Xlog:cds");
+        output.shouldHaveExitValue(0);
+
+        // Serial has no worker gang and always relocates on the main thread
+        run(archive, "-XX:+UseSerialGC", true, false);
+        for (String gc : new String[] { "-XX:+UseG1GC", "-XX:+UseParallelGC" }) {
+            run(archive, gc, true, true);
+            run(archive, gc, false, false);
+        }
+    }
+
+    private static void run(String archive, String gc, boolean parallel, boolean expectWorkers) throws Exception {
+        OutputAnalyzer output = ProcessTools.executeTestJvm(
+            gc,
+            "-XX:ParallelGCThreads=4",
+            "-XX:SharedArchiveFile=" + archive,
+            "-Xshare:on",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:ArchiveRelocationMode=1",
+            "-XX:" + (parallel ? "+" : "-") + "UseParallelArchiveRelocation",
+            "-XX:+VerifySharedSpaces",
+            "-XX:+VerifyBeforeGC",
+            "-XX:+VerifyAfterGC",
+            "-Xlog:cds",
+            Workload.class.getName());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("ArchiveRelocationMode == 1: always map archive(s) at an alternative address");
+        if (expectWorkers) {
+            output.shouldMatch(RELOCATED + "4 threads");
+        } else {
+            output.shouldMatch(RELOCATED + "1 thread$");
+        }
+        output.shouldContain("OK");
+    }
+
+    static class Workload {
+        public static void main(String[] args) throws Exception {
+            // Archived classes and their metadata are reached through the
+            // relocated pointers
+            for (Class<?> c : new Class<?>[] { Object.class, String.class, java.util.HashMap.class,
+                                               java.util.concurrent.ConcurrentHashMap.class }) {
+                if (c.getDeclaredMethods().length == 0 || c.getName().isEmpty()) {
+                    throw new RuntimeException("Archived class " + c + " is broken");
+                }
+            }
+            java.util.Map<String, Integer> m = new java.util.concurrent.ConcurrentHashMap<>();
+            for (int i = 0; i < 1000; i++) {
+                m.put(Integer.toString(i), i);
+            }
+            System.gc();
+            if (m.get("999") != 999) {
+                throw new RuntimeException("Relocated metadata is broken after GC");
+            }
+            System.out.println("OK");
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary A jsr method whose backward goto is widened by the oop map
+ *          conflict rewriting must still run its loop correctly
+ * @modules java.base/jdk.internal.org.objectweb.asm
+ * @run main/othervm -Xint -XX:+RewriteFrequentPairs TestIincGotoWithJsr
+ * @run main/othervm -Xint -XX:-RewriteFrequentPairs TestIincGotoWithJsr
+ */
+
+import java.lang.reflect.Method;
+
+import jdk.internal.org.objectweb.asm.ClassWriter;
+import jdk.internal.org.objectweb.asm.Label;
+import jdk.internal.org.objectweb.asm.MethodVisitor;
+
+import static jdk.internal.org.objectweb.asm.Opcodes.*;
+
+public class TestIincGotoWithJsr {
+
+    // Fills the loop body so that its backward goto has the largest short
+    // offset. The rewriting widens the two stores and loads of local 1 in
+    // the loop, which then needs a goto_w.
+    private static final int PADDING = 32746;
+
+    // static int loop(int n) {
+    //   int v = 5; jsr sub;
+    //   for (int i = 0; i < n; i++) { Object v = "x"; jsr sub; v; <padding> }
+    //   return i;
+    // }
+    //
+    // Local 1 is an int at one jsr and a reference at the other, so the
+    // subroutine merges them and the aload of local 1 after the second jsr
+    // is a ref/value conflict that moves the reference to a new local.
+    private static byte[] generate() {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_MAXS);
+        cw.visit(V1_4, ACC_PUBLIC | ACC_SUPER, "JsrLoop", null, "java/lang/Object", null);
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC | ACC_STATIC, "loop", "(I)I", null, null);
+        mv.visitCode();
+        Label sub = new Label();
+        Label loop = new Label();
+        Label body = new Label();
+        Label end = new Label();
+
+        mv.visitInsn(ICONST_5);
+        mv.visitVarInsn(ISTORE, 1);
+        mv.visitJumpInsn(JSR, sub);
+        mv.visitInsn(ICONST_0);
+        mv.visitVarInsn(ISTORE, 2);
+
+        mv.visitLabel(loop);
+        mv.visitVarInsn(ILOAD, 2);
+        mv.visitVarInsn(ILOAD, 0);
+        mv.visitJumpInsn(IF_ICMPLT, body);
+        mv.visitJumpInsn(GOTO, end);
+        mv.visitLabel(body);
+        mv.visitLdcInsn("x");
+        mv.visitVarInsn(ASTORE, 1);
+        mv.visitJumpInsn(JSR, sub);
+        mv.visitVarInsn(ALOAD, 1);
+        mv.visitInsn(POP);
+        for (int i = 0; i < PADDING; i++) {
+            mv.visitInsn(NOP);
+        }
+        mv.visitIincInsn(2, 1);
+        mv.visitJumpInsn(GOTO, loop);
+
+        mv.visitLabel(end);
+        mv.visitVarInsn(ILOAD, 2);
+        mv.visitInsn(IRETURN);
+
+        mv.visitLabel(sub);
+        mv.visitVarInsn(ASTORE, 3);
+        mv.visitVarInsn(RET, 3);
+
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    static class Loader extends ClassLoader {
+        Class<?> define(byte[] b) {
+            return defineClass("JsrLoop", b, 0, b.length);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Class<?> c = new Loader().define(generate());
+        Method loop = c.getMethod("loop", int.class);
+        for (int n = 0; n < 20; n++) {
+            int result = (Integer) loop.invoke(null, n);
+            if (result != n) {
+                throw new RuntimeException("loop(" + n + ") returned " + result);
+            }
+        }
+    }
+}
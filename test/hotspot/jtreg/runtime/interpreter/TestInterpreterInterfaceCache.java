@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary The interpreter's invokeinterface inline cache must dispatch to
+ *          the same methods and throw the same errors as the itable lookup
+ * @requires vm.bits == 64
+ * @library /test/lib
+ * @modules java.base/jdk.internal.org.objectweb.asm
+ *          java.compiler
+ *          java.instrument
+ * @run main RedefineClassHelper
+ * @run main/othervm -Xint -XX:+UnlockExperimentalVMOptions -XX:+UseInterpreterInterfaceCache
+ *      -javaagent:redefineagent.jar TestInterpreterInterfaceCache
+ * @run main/othervm -Xint -XX:+UnlockExperimentalVMOptions -XX:-UseInterpreterInterfaceCache
+ *      -javaagent:redefineagent.jar TestInterpreterInterfaceCache
+ */
+
+import jdk.internal.org.objectweb.asm.ClassWriter;
+import jdk.internal.org.objectweb.asm.MethodVisitor;
+import static jdk.internal.org.objectweb.asm.Opcodes.*;
+
+public class TestInterpreterInterfaceCache {
+    public interface I {
+        int m();
+    }
+
+    public interface J {
+        int n();
+    }
+
+    static final String I_NAME = I.class.getName().replace('.', '/');
+    static final String J_NAME = J.class.getName().replace('.', '/');
+
+    // I is at a different itable position in each of these
+    static class A implements I {
+        public int m() { return 1; }
+    }
+
+    static class B implements J, I {
+        public int n() { return 20; }
+        public int m() { return 2; }
+    }
+
+    static class C extends B implements Comparable<C> {
+        public int compareTo(C c) { return 0; }
+        public int m() { return 3; }
+    }
+
+    static class D implements Runnable, J, I {
+        public void run() {}
+        public int n() { return 40; }
+        public int m() { return 4; }
+    }
+
+    static class E extends A {
+        public int m() { return 5; }
+    }
+
+    // The call site of all the tests
+    static int callI(I i) {
+        return i.m();
+    }
+
+    static void check(int actual, int expected, String what) {
+        if (actual != expected) {
+            throw new RuntimeException(what + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    static void monomorphic() {
+        A a = new A();
+        for (int i = 0; i < 10_000; i++) {
+            check(callI(a), 1, "monomorphic A");
+        }
+        // The site changes its receiver class for good
+        B b = new B();
+        for (int i = 0; i < 10_000; i++) {
+            check(callI(b), 2, "monomorphic B");
+        }
+    }
+
+    static void megamorphic() {
+        I[] receivers = { new A(), new B(), new C(), new D(), new E() };
+        for (int i = 0; i < 10_000; i++) {
+            for (int j = 0; j < receivers.length; j++) {
+                check(callI(receivers[j]), j + 1, "megamorphic");
+            }
+        }
+        // Alternate between two receivers that miss each other's cache
+        for (int i = 0; i < 10_000; i++) {
+            I r = receivers[(i & 1) == 0 ? 1 : 3];
+            check(callI(r), (i & 1) == 0 ? 2 : 4, "alternating");
+        }
+    }
+
+    static class ByteLoader extends ClassLoader {
+        ByteLoader() {
+            super(TestInterpreterInterfaceCache.class.getClassLoader());
+        }
+
+        Class<?> define(String name, byte[] bytes) {
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    // A class implementing the interfaces, with m returning value unless
+    // withM is false.
+    static byte[] implementation(String name, String[] interfaces, boolean withM, int value) {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_FRAMES | ClassWriter.COMPUTE_MAXS);
+        cw.visit(V11, ACC_PUBLIC | ACC_SUPER, name, null, "java/lang/Object", interfaces);
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC, "<init>", "()V", null, null);
+        mv.visitCode();
+        mv.visitVarInsn(ALOAD, 0);
+        mv.visitMethodInsn(INVOKESPECIAL, "java/lang/Object", "<init>", "()V", false);
+        mv.visitInsn(RETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        for (String itf : interfaces) {
+            String method = itf.equals(I_NAME) ? "m" : "n";
+            if (method.equals("m") && !withM) {
+                continue;
+            }
+            mv = cw.visitMethod(ACC_PUBLIC, method, "()I", null, null);
+            mv.visitCode();
+            mv.visitLdcInsn(method.equals("m") ? value : -value);
+            mv.visitInsn(IRETURN);
+            mv.visitMaxs(0, 0);
+            mv.visitEnd();
+        }
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    // A class with "static int call(Object o) { return ((I)o).m(); }"
+    // without the checkcast, which the verifier allows for interfaces.
+    static byte[] caller(String name) {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_FRAMES | ClassWriter.COMPUTE_MAXS);
+        cw.visit(V11, ACC_PUBLIC | ACC_SUPER, name, null, "java/lang/Object", null);
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC | ACC_STATIC, "call", "(Ljava/lang/Object;)I", null, null);
+        mv.visitCode();
+        mv.visitVarInsn(ALOAD, 0);
+        mv.visitMethodInsn(INVOKEINTERFACE, I_NAME, "m", "()I", true);
+        mv.visitInsn(IRETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    static int call(java.lang.reflect.Method call, Object receiver) throws Throwable {
+        try {
+            return (Integer)call.invoke(null, receiver);
+        } catch (java.lang.reflect.InvocationTargetException e) {
+            throw e.getCause();
+        }
+    }
+
+    // A receiver missing the method, and one not implementing the
+    // interface, get their errors at a site cached for another receiver.
+    static void errors() throws Throwable {
+        ByteLoader loader = new ByteLoader();
+        java.lang.reflect.Method call = loader.define("Caller", caller("Caller")).getMethod("call", Object.class);
+        Object good = loader.define("Good", implementation("Good", new String[] { J_NAME, I_NAME }, true, 7))
+                            .getDeclaredConstructor().newInstance();
+        Object missing = loader.define("Missing", implementation("Missing", new String[] { J_NAME, I_NAME }, false, 0))
+                               .getDeclaredConstructor().newInstance();
+        Object notI = loader.define("NotI", implementation("NotI", new String[] { J_NAME }, true, 0))
+                            .getDeclaredConstructor().newInstance();
+
+        for (int round = 0; round < 100; round++) {
+            for (int i = 0; i < 100; i++) {
+                check(call(call, good), 7, "good receiver");
+            }
+            try {
+                call(call, missing);
+                throw new RuntimeException("no AbstractMethodError");
+            } catch (AbstractMethodError e) {
+                // expected
+            }
+            check(call(call, good), 7, "good receiver after AbstractMethodError");
+            try {
+                call(call, notI);
+                throw new RuntimeException("no IncompatibleClassChangeError");
+            } catch (AbstractMethodError e) {
+                throw new RuntimeException("AbstractMethodError instead of IncompatibleClassChangeError", e);
+            } catch (IncompatibleClassChangeError e) {
+                // expected
+            }
+        }
+        // The missing method stays missing however often it is called
+        for (int i = 0; i < 1000; i++) {
+            try {
+                call(call, missing);
+                throw new RuntimeException("no AbstractMethodError");
+            } catch (AbstractMethodError e) {
+                // expected
+            }
+        }
+    }
+
+    // Receiver classes are unloaded while cached, the metadata of later
+    // classes may then be allocated at the same address with a different
+    // itable layout.
+    static void unloading() throws Exception {
+        for (int k = 0; k < 200; k++) {
+            String[] interfaces = (k & 1) == 0 ? new String[] { I_NAME } : new String[] { J_NAME, I_NAME };
+            I r = (I)new ByteLoader().define("Gen", implementation("Gen", interfaces, true, k))
+                                     .getDeclaredConstructor().newInstance();
+            for (int i = 0; i < 100; i++) {
+                check(callI(r), k, "unloaded receivers");
+            }
+            r = null;
+            if (k % 10 == 9) {
+                System.gc();
+            }
+        }
+    }
+
+    // Redefinition replaces the method in the cached itable slot
+    static void redefinition() throws Exception {
+        I r = new Redefined();
+        for (int i = 0; i < 1000; i++) {
+            check(callI(r), 1, "before redefinition");
+        }
+        RedefineClassHelper.redefineClass(Redefined.class,
+            "class Redefined implements TestInterpreterInterfaceCache.I { public int m() { return 2; } }");
+        for (int i = 0; i < 1000; i++) {
+            check(callI(r), 2, "after redefinition");
+        }
+    }
+
+    public static void main(String[] args) throws Throwable {
+        monomorphic();
+        megamorphic();
+        errors();
+        unloading();
+        redefinition();
+        // The site still works for the first receivers again
+        monomorphic();
+    }
+}
+
+class Redefined implements TestInterpreterInterfaceCache.I {
+    public int m() { return 1; }
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Interface calls through the itable selector table find the same
+ *          methods as the linear itable scan, also when interfaces collide
+ *          in the table, and still throw AbstractMethodError and
+ *          IncompatibleClassChangeError
+ * @modules java.base/jdk.internal.org.objectweb.asm
+ * @run main/othervm -Xbatch TestItableSelectorTable
+ * @run main/othervm -Xbatch -XX:+UnlockExperimentalVMOptions -XX:+UseItableSelectorTable
+ *                   TestItableSelectorTable
+ * @run main/othervm -Xint -XX:+UnlockExperimentalVMOptions -XX:+UseItableSelectorTable
+ *                   TestItableSelectorTable
+ * @run main/othervm -Xbatch -XX:+UnlockExperimentalVMOptions -XX:+UseItableSelectorTable
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+StressItableSelectorCollisions
+ *                   TestItableSelectorTable
+ * @run main/othervm -Xbatch -XX:+UnlockExperimentalVMOptions -XX:+UseItableSelectorTable
+ *                   -XX:ItableSelectorTableMinInterfaces=1
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+StressItableSelectorCollisions
+ *                   TestItableSelectorTable
+ */
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.util.HashMap;
+import java.util.Map;
+
+import jdk.internal.org.objectweb.asm.ClassWriter;
+import jdk.internal.org.objectweb.asm.MethodVisitor;
+import static jdk.internal.org.objectweb.asm.Opcodes.*;
+
+public class TestItableSelectorTable {
+    // Well above ItableSelectorTableMinInterfaces, so that the classes
+    // implementing all of them get a selector table
+    static final int N = 24;
+    static final int IMPLS = 4;
+
+    // "public interface I<k> { int m<k>(); }"
+    static byte[] iface(int k) {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_MAXS);
+        cw.visit(V11, ACC_PUBLIC | ACC_ABSTRACT | ACC_INTERFACE, "I" + k, null, "java/lang/Object", null);
+        cw.visitMethod(ACC_PUBLIC | ACC_ABSTRACT, "m" + k, "()I", null, null).visitEnd();
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    // A class implementing I<from> to I<to - 1>, where m<k> returns k * 100 + r.
+    // m<missing> is left out.
+    static byte[] impl(String name, int from, int to, int r, int missing) {
+        String[] interfaces = new String[to - from];
+        for (int k = from; k < to; k++) {
+            interfaces[k - from] = "I" + k;
+        }
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_MAXS);
+        cw.visit(V11, ACC_PUBLIC | ACC_SUPER, name, null, "java/lang/Object", interfaces);
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC, "<init>", "()V", null, null);
+        mv.visitCode();
+        mv.visitVarInsn(ALOAD, 0);
+        mv.visitMethodInsn(INVOKESPECIAL, "java/lang/Object", "<init>", "()V", false);
+        mv.visitInsn(RETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        for (int k = from; k < to; k++) {
+            if (k == missing) {
+                continue;
+            }
+            mv = cw.visitMethod(ACC_PUBLIC, "m" + k, "()I", null, null);
+            mv.visitCode();
+            mv.visitLdcInsn(k * 100 + r);
+            mv.visitInsn(IRETURN);
+            mv.visitMaxs(0, 0);
+            mv.visitEnd();
+        }
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    // "static int call<k>(Object o) { return ((I<k>)o).m<k>(); }" without
+    // the checkcast, and "static int all(Object o)" summing all of them
+    static byte[] caller() {
+        ClassWriter cw = new ClassWriter(ClassWriter.COMPUTE_MAXS);
+        cw.visit(V11, ACC_PUBLIC | ACC_SUPER, "Caller", null, "java/lang/Object", null);
+        for (int k = 0; k < N; k++) {
+            MethodVisitor mv = cw.visitMethod(ACC_PUBLIC | ACC_STATIC, "call" + k, "(Ljava/lang/Object;)I", null, null);
+            mv.visitCode();
+            mv.visitVarInsn(ALOAD, 0);
+            mv.visitMethodInsn(INVOKEINTERFACE, "I" + k, "m" + k, "()I", true);
+            mv.visitInsn(IRETURN);
+            mv.visitMaxs(0, 0);
+            mv.visitEnd();
+        }
+        MethodVisitor mv = cw.visitMethod(ACC_PUBLIC | ACC_STATIC, "all", "(Ljava/lang/Object;)I", null, null);
+        mv.visitCode();
+        mv.visitInsn(ICONST_0);
+        for (int k = 0; k < N; k++) {
+            mv.visitVarInsn(ALOAD, 0);
+            mv.visitMethodInsn(INVOKEINTERFACE, "I" + k, "m" + k, "()I", true);
+            mv.visitInsn(IADD);
+        }
+        mv.visitInsn(IRETURN);
+        mv.visitMaxs(0, 0);
+        mv.visitEnd();
+        cw.visitEnd();
+        return cw.toByteArray();
+    }
+
+    static class ByteLoader extends ClassLoader {
+        final Map<String, byte[]> classes = new HashMap<>();
+
+        @Override
+        protected Class<?> findClass(String name) throws ClassNotFoundException {
+            byte[] bytes = classes.get(name);
+            if (bytes == null) {
+                throw new ClassNotFoundException(name);
+            }
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    static Method[] call = new Method[N];
+    static Method all;
+
+    static int call(int k, Object o) throws Throwable {
+        try {
+            return (Integer)call[k].invoke(null, o);
+        } catch (InvocationTargetException e) {
+            throw e.getCause();
+        }
+    }
+
+    static void expectError(Class<?> expected, int k, Object o) throws Throwable {
+        try {
+            call(k, o);
+            throw new RuntimeException("No " + expected.getName() + " calling m" + k + " on " + o.getClass().getName());
+        } catch (IncompatibleClassChangeError e) {
+            // AbstractMethodError is a subclass, so compare exactly
+            if (e.getClass() != expected) {
+                throw new RuntimeException("Expected " + expected.getName() + " calling m" + k, e);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Throwable {
+        ByteLoader loader = new ByteLoader();
+        for (int k = 0; k < N; k++) {
+            loader.classes.put("I" + k, iface(k));
+        }
+        for (int r = 0; r < IMPLS; r++) {
+            loader.classes.put("Impl" + r, impl("Impl" + r, 0, N, r, -1));
+        }
+        // Has a table, but not for I<N/2> to I<N-1>
+        loader.classes.put("Half", impl("Half", 0, N / 2, 7, -1));
+        // Too few interfaces for a table, unless the minimum is lowered
+        loader.classes.put("Small", impl("Small", 0, 3, 8, -1));
+        // Claims I<N-1> but does not implement m<N-1>
+        loader.classes.put("Partial", impl("Partial", 0, N, 9, N - 1));
+        loader.classes.put("Caller", caller());
+
+        Class<?> callerClass = loader.loadClass("Caller");
+        for (int k = 0; k < N; k++) {
+            call[k] = callerClass.getMethod("call" + k, Object.class);
+        }
+        all = callerClass.getMethod("all", Object.class);
+
+        Object[] impls = new Object[IMPLS];
+        for (int r = 0; r < IMPLS; r++) {
+            impls[r] = loader.loadClass("Impl" + r).getConstructor().newInstance();
+        }
+        Object half = loader.loadClass("Half").getConstructor().newInstance();
+        Object small = loader.loadClass("Small").getConstructor().newInstance();
+        Object partial = loader.loadClass("Partial").getConstructor().newInstance();
+
+        MethodHandle[] handles = new MethodHandle[N];
+        for (int k = 0; k < N; k++) {
+            handles[k] = MethodHandles.lookup()
+                                      .findVirtual(loader.loadClass("I" + k), "m" + k, MethodType.methodType(int.class))
+                                      .asType(MethodType.methodType(int.class, Object.class));
+        }
+
+        int expectedSum = 0;
+        for (int k = 0; k < N; k++) {
+            expectedSum += k * 100;
+        }
+
+        // The call sites see several receiver classes, so they go megamorphic
+        // and use the itable stubs once compiled
+        for (int i = 0; i < 20_000; i++) {
+            int r = i % IMPLS;
+            int sum = (Integer)all.invoke(null, impls[r]);
+            if (sum != expectedSum + N * r) {
+                throw new RuntimeException("all(Impl" + r + ") = " + sum);
+            }
+            int k = i % N;
+            int v = call(k, impls[r]);
+            if (v != k * 100 + r) {
+                throw new RuntimeException("Impl" + r + ".m" + k + " = " + v);
+            }
+            v = (int)handles[k].invokeExact(impls[r]);
+            if (v != k * 100 + r) {
+                throw new RuntimeException("Impl" + r + ".m" + k + " through a method handle = " + v);
+            }
+            if (k < N / 2 && call(k, half) != k * 100 + 7) {
+                throw new RuntimeException("Half.m" + k);
+            }
+            if (k < 3 && call(k, small) != k * 100 + 8) {
+                throw new RuntimeException("Small.m" + k);
+            }
+            if (k < N - 1 && call(k, partial) != k * 100 + 9) {
+                throw new RuntimeException("Partial.m" + k);
+            }
+        }
+
+        for (int k = N / 2; k < N; k++) {
+            expectError(IncompatibleClassChangeError.class, k, half);
+        }
+        for (int k = 3; k < N; k++) {
+            expectError(IncompatibleClassChangeError.class, k, small);
+        }
+        expectError(AbstractMethodError.class, N - 1, partial);
+    }
+}
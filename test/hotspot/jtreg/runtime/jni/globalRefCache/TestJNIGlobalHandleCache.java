@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Global and weak global JNI references stay correct when their
+ *          entries are cached and reused per thread, also when they are
+ *          deleted by another thread than the one that created them
+ * @requires vm.opt.ExplicitGCInvokesConcurrent != true
+ * @run main/othervm/native TestJNIGlobalHandleCache
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions
+ *                          -XX:JNIGlobalHandleCacheSize=16 -XX:JNIWeakGlobalHandleCacheSize=16
+ *                          TestJNIGlobalHandleCache
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions
+ *                          -XX:JNIGlobalHandleCacheSize=16 -XX:JNIWeakGlobalHandleCacheSize=16
+ *                          -Xcheck:jni TestJNIGlobalHandleCache
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions
+ *                          -XX:JNIGlobalHandleCacheSize=1 -XX:JNIWeakGlobalHandleCacheSize=64
+ *                          -XX:+UnlockDiagnosticVMOptions -XX:GuaranteedSafepointInterval=1
+ *                          TestJNIGlobalHandleCache
+ */
+
+import java.util.concurrent.SynchronousQueue;
+
+public class TestJNIGlobalHandleCache {
+    static {
+        System.loadLibrary("JNIGlobalHandleCache");
+    }
+
+    static native long newRef(Object o, boolean weak);
+    static native void deleteRef(long ref, boolean weak);
+    static native Object get(long ref);
+    // Creates, checks and deletes n references to o, and returns the
+    // number of references that did not refer to o
+    static native int churn(Object o, int n, boolean weak);
+
+    static void check(boolean condition, String message) {
+        if (!condition) {
+            throw new RuntimeException(message);
+        }
+    }
+
+    static void churnOnThreads(boolean weak) throws Exception {
+        Thread[] threads = new Thread[8];
+        int[] failures = new int[threads.length];
+        for (int t = 0; t < threads.length; t++) {
+            final int id = t;
+            threads[t] = new Thread(() -> {
+                Object o = new Object();
+                for (int i = 0; i < 20; i++) {
+                    failures[id] += churn(o, 10_000, weak);
+                }
+            });
+            threads[t].start();
+        }
+        for (int i = 0; i < 10; i++) {
+            System.gc();
+        }
+        for (int t = 0; t < threads.length; t++) {
+            threads[t].join();
+            check(failures[t] == 0, failures[t] + " bad references on thread " + t);
+        }
+    }
+
+    // References created by one thread are checked and deleted by another,
+    // which then creates its own, so entries move between the caches
+    static void handOver(boolean weak) throws Exception {
+        final int n = 1000;
+        Object[] objects = new Object[n];
+        for (int i = 0; i < n; i++) {
+            objects[i] = Integer.valueOf(i * 3);
+        }
+        SynchronousQueue<long[]> toOther = new SynchronousQueue<>();
+        SynchronousQueue<long[]> back = new SynchronousQueue<>();
+        Thread other = new Thread(() -> {
+            try {
+                for (int round = 0; round < 20; round++) {
+                    long[] refs = toOther.take();
+                    for (int i = 0; i < n; i++) {
+                        check(get(refs[i]) == objects[i], "bad reference from the main thread");
+                        deleteRef(refs[i], weak);
+                    }
+                    for (int i = 0; i < n; i++) {
+                        refs[i] = newRef(objects[n - 1 - i], weak);
+                    }
+                    back.put(refs);
+                }
+            } catch (InterruptedException e) {
+                throw new RuntimeException(e);
+            }
+        });
+        other.start();
+        for (int round = 0; round < 20; round++) {
+            long[] refs = new long[n];
+            for (int i = 0; i < n; i++) {
+                refs[i] = newRef(objects[i], weak);
+            }
+            toOther.put(refs);
+            refs = back.take();
+            if (round % 5 == 0) {
+                System.gc();
+            }
+            for (int i = 0; i < n; i++) {
+                check(get(refs[i]) == objects[n - 1 - i], "bad reference from the other thread");
+                deleteRef(refs[i], weak);
+            }
+        }
+        other.join();
+    }
+
+    // A reused weak entry refers to its new object, not to a cleared or
+    // stale one
+    static void weakReuse() {
+        for (int i = 0; i < 100; i++) {
+            long dead = newRef(new Object(), true);
+            System.gc();
+            check(get(dead) == null, "weak reference not cleared");
+            deleteRef(dead, true);
+            Object o = new Object();
+            long live = newRef(o, true);
+            System.gc();
+            check(get(live) == o, "reused weak reference cleared");
+            deleteRef(live, true);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (boolean weak : new boolean[] { false, true }) {
+            check(churn(new Object(), 100_000, weak) == 0, "bad references");
+            churnOnThreads(weak);
+            handOver(weak);
+        }
+        weakReuse();
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stdint.h>
+#include "jni.h"
+
+static jobject new_ref(JNIEnv* env, jobject o, jboolean weak) {
+  return weak ? (*env)->NewWeakGlobalRef(env, o) : (*env)->NewGlobalRef(env, o);
+}
+
+static void delete_ref(JNIEnv* env, jobject ref, jboolean weak) {
+  if (weak) {
+    (*env)->DeleteWeakGlobalRef(env, ref);
+  } else {
+    (*env)->DeleteGlobalRef(env, ref);
+  }
+}
+
+JNIEXPORT jlong JNICALL
+Java_TestJNIGlobalHandleCache_newRef(JNIEnv* env, jclass clazz, jobject o, jboolean weak) {
+  return (jlong)(intptr_t)new_ref(env, o, weak);
+}
+
+JNIEXPORT void JNICALL
+Java_TestJNIGlobalHandleCache_deleteRef(JNIEnv* env, jclass clazz, jlong ref, jboolean weak) {
+  delete_ref(env, (jobject)(intptr_t)ref, weak);
+}
+
+JNIEXPORT jobject JNICALL
+Java_TestJNIGlobalHandleCache_get(JNIEnv* env, jclass clazz, jlong ref) {
+  jobject r = (jobject)(intptr_t)ref;
+  // A local reference also works for a weak reference
+  return (*env)->NewLocalRef(env, r);
+}
+
+JNIEXPORT jint JNICALL
+Java_TestJNIGlobalHandleCache_churn(JNIEnv* env, jclass clazz, jobject o, jint n, jboolean weak) {
+  jint failures = 0;
+  jint i;
+  for (i = 0; i < n; i++) {
+    jobject ref = new_ref(env, o, weak);
+    if (ref == NULL || !(*env)->IsSameObject(env, ref, o)) {
+      failures++;
+    }
+    if (ref != NULL) {
+      delete_ref(env, ref, weak);
+    }
+  }
+  return failures;
+}
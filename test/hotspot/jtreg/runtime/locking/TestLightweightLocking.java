@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test id=interpreter
+ * @summary Exercise Java monitors with lightweight locking in the interpreter
+ * @requires os.arch=="amd64" | os.arch=="x86_64" | os.arch=="aarch64"
+ * @library /test/lib
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking
+ *      -Xint
+ *      TestLightweightLocking
+ */
+
+/*
+ * @test id=c1
+ * @summary Exercise Java monitors with lightweight locking in C1 compiled code
+ * @requires os.arch=="amd64" | os.arch=="x86_64" | os.arch=="aarch64"
+ * @requires vm.compiler1.enabled
+ * @library /test/lib
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking
+ *      -Xcomp -XX:TieredStopAtLevel=1 -XX:CompileCommand=compileonly,TestLightweightLocking*::*
+ *      TestLightweightLocking
+ */
+
+/*
+ * @test id=c2
+ * @summary Exercise Java monitors with lightweight locking in C2 compiled code
+ * @requires os.arch=="amd64" | os.arch=="x86_64" | os.arch=="aarch64"
+ * @requires vm.compiler2.enabled
+ * @library /test/lib
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking
+ *      -Xcomp -XX:-TieredCompilation -XX:CompileCommand=compileonly,TestLightweightLocking*::*
+ *      TestLightweightLocking
+ */
+
+/*
+ * @test id=default
+ * @summary Exercise Java monitors with lightweight locking
+ * @requires os.arch=="amd64" | os.arch=="x86_64" | os.arch=="aarch64"
+ * @library /test/lib
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+UseLightweightLocking
+ *      TestLightweightLocking
+ */
+
+import jdk.test.lib.Asserts;
+
+public class TestLightweightLocking {
+    static {
+        System.loadLibrary("LightweightLocking");
+    }
+
+    // Deeper than the lock stack, so that both recursive and nested
+    // locking run into lock stack overflow.
+    private static final int MAX_DEPTH = 20;
+    private static final int ROUNDS = 1000;
+    private static final int THREADS = 4;
+    private static final int INCREMENTS = 10_000;
+
+    private int count;
+
+    private synchronized void increment() {
+        count++;
+    }
+
+    // Increments count through JNI, which exercises the locking in the
+    // native wrapper.
+    private synchronized native void nativeIncrement();
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < 10; i++) {
+            testRecursion();
+            testNesting();
+            testInterleaved();
+            testHashCode();
+            testWaitNotify();
+            testContention();
+        }
+    }
+
+    private static int recurse(Object o, int depth) {
+        if (depth == 0) {
+            return 0;
+        }
+        synchronized (o) {
+            Asserts.assertTrue(Thread.holdsLock(o), "must hold lock");
+            return recurse(o, depth - 1) + 1;
+        }
+    }
+
+    private static void testRecursion() {
+        Object o = new Object();
+        for (int i = 0; i < ROUNDS; i++) {
+            int depth = i % MAX_DEPTH;
+            Asserts.assertEquals(recurse(o, depth), depth);
+            Asserts.assertFalse(Thread.holdsLock(o), "must not hold lock");
+        }
+    }
+
+    private static void lockAll(Object[] objs, int i, TestLightweightLocking counter) {
+        if (i == objs.length) {
+            for (Object o : objs) {
+                Asserts.assertTrue(Thread.holdsLock(o), "must hold lock");
+            }
+            // Lock from a full lock stack.
+            counter.increment();
+            counter.nativeIncrement();
+            return;
+        }
+        synchronized (objs[i]) {
+            lockAll(objs, i + 1, counter);
+        }
+    }
+
+    private static void testNesting() {
+        TestLightweightLocking counter = new TestLightweightLocking();
+        for (int i = 0; i < ROUNDS; i++) {
+            Object[] objs = new Object[i % MAX_DEPTH];
+            for (int j = 0; j < objs.length; j++) {
+                objs[j] = new Object();
+            }
+            lockAll(objs, 0, counter);
+            for (Object o : objs) {
+                Asserts.assertFalse(Thread.holdsLock(o), "must not hold lock");
+            }
+        }
+        Asserts.assertEquals(counter.count, 2 * ROUNDS);
+    }
+
+    // A recursive enter that is not the innermost lock stack entry.
+    private static void testInterleaved() {
+        Object a = new Object();
+        Object b = new Object();
+        for (int i = 0; i < ROUNDS; i++) {
+            synchronized (a) {
+                synchronized (b) {
+                    synchronized (a) {
+                        Asserts.assertTrue(Thread.holdsLock(a), "must hold lock");
+                        Asserts.assertTrue(Thread.holdsLock(b), "must hold lock");
+                    }
+                    Asserts.assertTrue(Thread.holdsLock(a), "must hold lock");
+                }
+                Asserts.assertTrue(Thread.holdsLock(a), "must hold lock");
+                Asserts.assertFalse(Thread.holdsLock(b), "must not hold lock");
+            }
+            Asserts.assertFalse(Thread.holdsLock(a), "must not hold lock");
+        }
+    }
+
+    // The header stays in place, so hashing a locked object must not
+    // disturb the lock.
+    private static void testHashCode() {
+        for (int i = 0; i < ROUNDS; i++) {
+            Object o = new Object();
+            int hash;
+            synchronized (o) {
+                hash = o.hashCode();
+                synchronized (o) {
+                    Asserts.assertEquals(o.hashCode(), hash);
+                }
+                Asserts.assertTrue(Thread.holdsLock(o), "must hold lock");
+            }
+            Asserts.assertFalse(Thread.holdsLock(o), "must not hold lock");
+            Asserts.assertEquals(System.identityHashCode(o), hash);
+            synchronized (o) {
+                Asserts.assertEquals(o.hashCode(), hash);
+            }
+        }
+    }
+
+    private static boolean done;
+
+    // Waiting inflates the monitor, also when held recursively.
+    private static void testWaitNotify() throws Exception {
+        Object o = new Object();
+        done = false;
+        Thread waiter = new Thread(() -> {
+            synchronized (o) {
+                synchronized (o) {
+                    while (!done) {
+                        try {
+                            o.wait();
+                        } catch (InterruptedException e) {
+                            throw new RuntimeException(e);
+                        }
+                    }
+                    Asserts.assertTrue(Thread.holdsLock(o), "must hold lock");
+                }
+                Asserts.assertTrue(Thread.holdsLock(o), "must hold lock");
+            }
+        });
+        waiter.start();
+        synchronized (o) {
+            o.notify();
+            done = true;
+            o.notifyAll();
+        }
+        waiter.join();
+        Asserts.assertFalse(Thread.holdsLock(o), "must not hold lock");
+    }
+
+    // Contended locking inflates fast-locked objects owned by another thread.
+    private static void testContention() throws Exception {
+        TestLightweightLocking counter = new TestLightweightLocking();
+        Thread[] threads = new Thread[THREADS];
+        for (int i = 0; i < THREADS; i++) {
+            threads[i] = new Thread(() -> {
+                for (int j = 0; j < INCREMENTS; j++) {
+                    switch (j % 4) {
+                    case 0:
+                        synchronized (counter) {
+                            counter.count++;
+                        }
+                        break;
+                    case 1:
+                        counter.increment();
+                        break;
+                    case 2:
+                        counter.nativeIncrement();
+                        break;
+                    default:
+                        synchronized (counter) {
+                            counter.nativeIncrement();
+                        }
+                        break;
+                    }
+                }
+            });
+        }
+        for (Thread t : threads) {
+            t.start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        Asserts.assertEquals(counter.count, THREADS * INCREMENTS);
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import org.testng.annotations.Test;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+
+/*
+ * @test
+ * @summary Test of diagnostic command GC.class_histogram -baseline and -diff
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run testng/othervm -XX:+UseG1GC ClassHistogramDiffTest
+ * @run testng/othervm -XX:+UseParallelGC ClassHistogramDiffTest
+ */
+public class ClassHistogramDiffTest {
+    private static final int INSTANCES = 10_000;
+
+    // Matches the diff row of Marker, capturing the instance and byte deltas
+    private static final Pattern MARKER_ROW =
+        Pattern.compile("\\s*\\d+:\\s+(-?\\d+)\\s+(-?\\d+)\\s+ClassHistogramDiffTest\\$Marker\\s*");
+
+    private static final Pattern BASELINE =
+        Pattern.compile("Baseline: (\\d+) classes, (\\d+) instances, (\\d+) bytes");
+
+    static class Marker {
+        long payload;
+    }
+
+    static List<Marker> markers;
+
+    private static long[] markerRow(OutputAnalyzer output) {
+        for (String line : output.asLines()) {
+            Matcher m = MARKER_ROW.matcher(line);
+            if (m.matches()) {
+                return new long[] { Long.parseLong(m.group(1)), Long.parseLong(m.group(2)) };
+            }
+        }
+        return null;
+    }
+
+    private static void checkBaseline(OutputAnalyzer output) {
+        Matcher m = BASELINE.matcher(output.getOutput());
+        Asserts.assertTrue(m.find(), "No baseline summary");
+        Asserts.assertGT(Long.parseLong(m.group(1)), 0L);
+        Asserts.assertGT(Long.parseLong(m.group(2)), 0L);
+        Asserts.assertGT(Long.parseLong(m.group(3)), 0L);
+        // A baseline is recorded, not printed
+        output.shouldNotContain("class name");
+    }
+
+    private static void checkDiff(OutputAnalyzer output) {
+        output.shouldContain(" num    #instances(+/-)      #bytes(+/-)  class name");
+        output.shouldMatch("Total\\s+-?\\d+\\s+-?\\d+");
+        output.shouldMatch("\\d+ classes unchanged");
+    }
+
+    public void run(CommandExecutor executor) {
+        // Without a baseline, the first -diff records one
+        OutputAnalyzer output = executor.execute("GC.class_histogram -diff");
+        output.shouldContain("No baseline histogram recorded; using the current histogram as the baseline");
+        checkBaseline(output);
+
+        executor.execute("GC.class_histogram -baseline -diff")
+                .shouldContain("Only one of -baseline and -diff can be specified");
+
+        checkBaseline(executor.execute("GC.class_histogram -baseline"));
+
+        markers = new ArrayList<>();
+        for (int i = 0; i < INSTANCES; i++) {
+            markers.add(new Marker());
+        }
+        output = executor.execute("GC.class_histogram -diff");
+        checkDiff(output);
+        long[] row = markerRow(output);
+        Asserts.assertNotNull(row, "Marker not in the diff");
+        Asserts.assertEQ(row[0], (long)INSTANCES);
+        Asserts.assertGT(row[1], 0L);
+        long bytes = row[1];
+
+        // The diff became the baseline, and Marker did not change since
+        output = executor.execute("GC.class_histogram -diff -parallel=4");
+        checkDiff(output);
+        Asserts.assertNull(markerRow(output), "Unchanged Marker in the diff");
+
+        // The full GC before the inspection collects the dropped markers
+        markers = null;
+        output = executor.execute("GC.class_histogram -diff -parallel=4");
+        checkDiff(output);
+        row = markerRow(output);
+        Asserts.assertNotNull(row, "Collected Marker instances not in the diff");
+        Asserts.assertEQ(row[0], (long)-INSTANCES);
+        Asserts.assertEQ(row[1], -bytes);
+
+        // A plain histogram is unaffected by the baseline
+        executor.execute("GC.class_histogram").shouldContain("#instances         #bytes  class name");
+    }
+
+    @Test
+    public void jmx() {
+        run(new JMXExecutor());
+    }
+}
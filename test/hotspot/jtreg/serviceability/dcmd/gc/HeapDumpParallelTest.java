@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.hprof.model.JavaClass;
+import jdk.test.lib.hprof.model.Snapshot;
+import jdk.test.lib.hprof.parser.Reader;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+/*
+ * @test
+ * @summary Test of diagnostic command GC.heap_dump -parallel: the heap is
+ *          walked by the requested number of threads where the GC supports
+ *          it, and the merged dump is a valid HPROF file with all objects
+ * @requires vm.flagless
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver HeapDumpParallelTest
+ */
+public class HeapDumpParallelTest {
+    private static final int INSTANCES = 5000;
+    private static final Pattern DUMPER_THREADS = Pattern.compile("Using (\\d+) heap dumper threads");
+
+    public static class Marker {
+    }
+
+    // Dumps its own heap with the given GC.heap_dump options
+    public static class Target {
+        static List<Marker> markers = new ArrayList<>();
+
+        public static void main(String[] args) throws Exception {
+            for (int i = 0; i < INSTANCES; i++) {
+                markers.add(new Marker());
+            }
+            String options = args.length > 1 ? args[1] : "";
+            new JMXExecutor().execute("GC.heap_dump " + options + " " + args[0]).shouldContain("Heap dump file created");
+            Asserts.assertEQ(markers.size(), INSTANCES);
+        }
+    }
+
+    static int dump(String options, String... vmOpts) throws Exception {
+        File file = new File("parallel-" + System.nanoTime() + ".hprof");
+        List<String> cmd = new ArrayList<>(Arrays.asList(vmOpts));
+        cmd.add("-Xlog:heapdump=debug");
+        cmd.add(Target.class.getName());
+        cmd.add(file.getAbsolutePath());
+        cmd.add(options);
+        OutputAnalyzer output = ProcessTools.executeTestJvm(cmd);
+        output.shouldHaveExitValue(0);
+
+        Matcher m = DUMPER_THREADS.matcher(output.getStdout());
+        Asserts.assertTrue(m.find(), "No heap dumper thread count logged");
+        int threads = Integer.parseInt(m.group(1));
+
+        // The segments of all dumper threads make up one valid file
+        Snapshot snapshot = Reader.readFile(file.getAbsolutePath(), true, 0);
+        snapshot.resolve(true);
+        JavaClass marker = snapshot.findClass(Marker.class.getName());
+        Asserts.assertNotNull(marker, "Marker class not in the dump");
+        Asserts.assertEQ(marker.getInstancesCount(false), INSTANCES);
+        file.delete();
+        return threads;
+    }
+
+    public static void main(String[] args) throws Exception {
+        String[] g1 = { "-XX:+UseG1GC", "-XX:ParallelGCThreads=8", "-XX:-UseDynamicNumberOfGCThreads" };
+
+        // The default is the serial walk
+        Asserts.assertEQ(dump("", g1), 1);
+        Asserts.assertEQ(dump("-parallel=1", g1), 1);
+
+        // The VM thread and all but one gang worker may dump
+        int threads = dump("-parallel=4", g1);
+        Asserts.assertTrue(threads > 1 && threads <= 4, threads + " dumper threads for -parallel=4");
+        threads = dump("-parallel=100", g1);
+        Asserts.assertTrue(threads > 1 && threads <= 8, threads + " dumper threads for -parallel=100");
+        threads = dump("-parallel=0", g1);
+        Asserts.assertTrue(threads >= 1 && threads <= 8, threads + " dumper threads for -parallel=0");
+
+        // Compression runs on the remaining workers
+        threads = dump("-parallel=4 -gz=1", g1);
+        Asserts.assertTrue(threads > 1 && threads <= 4, threads + " dumper threads for -parallel=4 -gz=1");
+
+        // Serial has no parallel object iterator and falls back to one thread
+        Asserts.assertEQ(dump("-parallel=4", "-XX:+UseSerialGC"), 1);
+
+        OutputAnalyzer output = new JMXExecutor().execute("GC.heap_dump -parallel=-1 never-written.hprof");
+        output.shouldContain("Parallel thread number out of range (>=0): -1");
+        Asserts.assertFalse(new File("never-written.hprof").exists(), "Dump written for a bad -parallel");
+    }
+}
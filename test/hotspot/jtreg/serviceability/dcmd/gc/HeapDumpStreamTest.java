@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.InputStream;
+import java.net.StandardProtocolFamily;
+import java.net.UnixDomainSocketAddress;
+import java.nio.channels.Channels;
+import java.nio.channels.ServerSocketChannel;
+import java.nio.channels.SocketChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.hprof.model.JavaClass;
+import jdk.test.lib.hprof.model.Snapshot;
+import jdk.test.lib.hprof.parser.Reader;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+/*
+ * @test
+ * @summary Test of diagnostic command GC.heap_dump and HeapDumpPath with
+ *          UNIX domain socket, named pipe and file descriptor targets,
+ *          which receive a complete HPROF stream
+ * @requires os.family == "linux"
+ * @requires vm.flagless
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver HeapDumpStreamTest
+ */
+public class HeapDumpStreamTest {
+    private static final int INSTANCES = 5000;
+
+    public static class Marker {
+    }
+
+    static List<Marker> markers = new ArrayList<>();
+
+    static void makeMarkers() {
+        for (int i = 0; i < INSTANCES; i++) {
+            markers.add(new Marker());
+        }
+    }
+
+    // Dumps its own heap to the target given as the first argument, with
+    // the GC.heap_dump options given as the second
+    public static class Target {
+        public static void main(String[] args) throws Exception {
+            makeMarkers();
+            String options = args.length > 1 ? args[1] : "";
+            System.out.println(new JMXExecutor().execute("GC.heap_dump " + options + " " + args[0]).getOutput());
+        }
+    }
+
+    // Dumps its own heap to a file descriptor it opened for the file given
+    // as the argument. The VM must not close it.
+    public static class FdTarget {
+        public static void main(String[] args) throws Exception {
+            makeMarkers();
+            File file = new File(args[0]);
+            try (FileOutputStream out = new FileOutputStream(file)) {
+                int fd = -1;
+                for (File link : new File("/proc/self/fd").listFiles()) {
+                    try {
+                        if (Files.isSameFile(link.toPath(), file.toPath())) {
+                            fd = Integer.parseInt(link.getName());
+                        }
+                    } catch (Exception e) {
+                        // Not a file, or already closed
+                    }
+                }
+                Asserts.assertTrue(fd >= 0, "No descriptor for " + file);
+                System.out.println(new JMXExecutor().execute("GC.heap_dump fd:" + fd).getOutput());
+                // Still open
+                out.write(new byte[0]);
+                out.getFD().sync();
+            }
+        }
+    }
+
+    // Fills the Java heap, dumping it through HeapDumpPath
+    public static class OOMTarget {
+        public static void main(String[] args) {
+            makeMarkers();
+            List<Object> list = new ArrayList<>();
+            try {
+                while (true) {
+                    list.add(new long[1024 * 1024]);
+                }
+            } catch (OutOfMemoryError e) {
+                list = null;
+                System.out.println("OOM");
+            }
+        }
+    }
+
+    static void checkDump(Path dump) throws Exception {
+        Snapshot snapshot = Reader.readFile(dump.toString(), true, 0);
+        snapshot.resolve(true);
+        JavaClass marker = snapshot.findClass(Marker.class.getName());
+        Asserts.assertNotNull(marker, "Marker class not in the dump");
+        Asserts.assertEQ(marker.getInstancesCount(false), INSTANCES);
+        Files.delete(dump);
+    }
+
+    static OutputAnalyzer run(String... args) throws Exception {
+        OutputAnalyzer output = ProcessTools.executeTestJvm(args);
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    // Accepts one connection on a UNIX domain socket while the target
+    // runs, and copies what it receives to a file
+    static Path throughSocket(String... args) throws Exception {
+        Path socket = Path.of("heapdump-" + ProcessHandle.current().pid() + ".sock").toAbsolutePath();
+        Path dump = Path.of("socket-" + System.nanoTime() + ".hprof");
+        Files.deleteIfExists(socket);
+        ExecutorService reader = Executors.newSingleThreadExecutor();
+        try (ServerSocketChannel server = ServerSocketChannel.open(StandardProtocolFamily.UNIX)) {
+            server.bind(UnixDomainSocketAddress.of(socket));
+            Future<Long> received = reader.submit(() -> {
+                try (SocketChannel channel = server.accept();
+                     InputStream in = Channels.newInputStream(channel)) {
+                    return Files.copy(in, dump);
+                }
+            });
+            List<String> cmd = new ArrayList<>();
+            for (String arg : args) {
+                cmd.add(arg.replace("%s", "unix:" + socket));
+            }
+            run(cmd.toArray(new String[0])).shouldContain("Heap dump file created");
+            Asserts.assertGT(received.get(), 0L, "Nothing received");
+        } finally {
+            reader.shutdown();
+            Files.deleteIfExists(socket);
+        }
+        return dump;
+    }
+
+    // Reads a named pipe while the target runs
+    static Path throughPipe(String options) throws Exception {
+        Path pipe = Path.of("heapdump-" + ProcessHandle.current().pid() + ".fifo").toAbsolutePath();
+        Path dump = Path.of("pipe-" + System.nanoTime() + ".hprof");
+        Files.deleteIfExists(pipe);
+        Asserts.assertEQ(new ProcessBuilder("mkfifo", pipe.toString()).start().waitFor(), 0, "mkfifo failed");
+        ExecutorService reader = Executors.newSingleThreadExecutor();
+        try {
+            Future<Long> received = reader.submit(() -> {
+                try (InputStream in = Files.newInputStream(pipe)) {
+                    return Files.copy(in, dump);
+                }
+            });
+            run(Target.class.getName(), pipe.toString(), options).shouldContain("Heap dump file created");
+            Asserts.assertGT(received.get(), 0L, "Nothing received");
+        } finally {
+            reader.shutdown();
+            Files.deleteIfExists(pipe);
+        }
+        return dump;
+    }
+
+    public static void main(String[] args) throws Exception {
+        checkDump(throughSocket(Target.class.getName(), "%s"));
+        checkDump(throughSocket(Target.class.getName(), "%s", "-gz=1"));
+        checkDump(throughPipe(""));
+        checkDump(throughPipe("-gz=6"));
+
+        Path file = Path.of("fd-" + System.nanoTime() + ".hprof").toAbsolutePath();
+        run(FdTarget.class.getName(), file.toString()).shouldContain("Heap dump file created");
+        checkDump(file);
+
+        // HeapDumpPath streams to the socket as well
+        Path dump = throughSocket("-Xmx64m", "-XX:+HeapDumpOnOutOfMemoryError", "-XX:HeapDumpPath=%s",
+                                  OOMTarget.class.getName());
+        checkDump(dump);
+
+        // Targets that cannot be opened fail the dump, and nothing is created
+        run(Target.class.getName(), "unix:" + Path.of("no-such.sock").toAbsolutePath())
+            .shouldContain("Unable to create unix:")
+            .shouldNotContain("Heap dump file created");
+        run(Target.class.getName(), "fd:bad")
+            .shouldContain("Unable to create fd:bad: Invalid file descriptor");
+        Asserts.assertFalse(new File("fd:bad").exists(), "fd:bad created as a file");
+    }
+}
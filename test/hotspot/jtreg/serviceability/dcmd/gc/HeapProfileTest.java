@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import java.io.InputStream;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import org.testng.annotations.Test;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.dcmd.PidJcmdExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+
+/*
+ * @test
+ * @summary Test of diagnostic command GC.heap_profile
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run testng/othervm -XX:+HeapProfileSampling HeapProfileTest
+ */
+public class HeapProfileTest {
+    // Matches a row of the profile for the sampled Payload arrays, capturing
+    // the sample count and the live sample count.
+    private static final Pattern PAYLOAD_ROW =
+        Pattern.compile("\\s*\\d+:\\s+(\\d+)\\s+\\d+\\s+(\\d+)\\s+\\d+\\s+.*HeapProfileTest\\$Payload.*");
+
+    // Matches a row for the Loaded arrays, capturing the live sample count
+    // and the loader.
+    private static final Pattern LOADED_ROW =
+        Pattern.compile("\\s*\\d+:\\s+\\d+\\s+\\d+\\s+(\\d+)\\s+\\d+\\s+.*HeapProfileTest\\$Loaded.* \\((.*)\\)");
+
+    private static final Pattern RECORDED =
+        Pattern.compile("Heap profile: \\d+ samples retained of (\\d+) recorded.*");
+
+    // Capacity of the sample ring in the VM
+    private static final int RING_CAPACITY = 16 * 1024;
+
+    static class Payload {
+    }
+
+    // Defined separately by two loaders
+    public static class Loaded {
+        public static Object allocate() {
+            return new Loaded[64 * 1024];
+        }
+    }
+
+    // Defines Loaded itself instead of delegating
+    static class DefiningLoader extends ClassLoader {
+        DefiningLoader(String name) {
+            super(name, HeapProfileTest.class.getClassLoader());
+        }
+
+        @Override
+        protected Class<?> loadClass(String name, boolean resolve) throws ClassNotFoundException {
+            if (!name.equals(Loaded.class.getName())) {
+                return super.loadClass(name, resolve);
+            }
+            synchronized (getClassLoadingLock(name)) {
+                Class<?> c = findLoadedClass(name);
+                if (c == null) {
+                    String file = name.replace('.', '/') + ".class";
+                    try (InputStream in = getParent().getResourceAsStream(file)) {
+                        byte[] bytes = in.readAllBytes();
+                        c = defineClass(name, bytes, 0, bytes.length);
+                    } catch (Exception e) {
+                        throw new ClassNotFoundException(name, e);
+                    }
+                }
+                return c;
+            }
+        }
+    }
+
+    // Keeps some of the sampled arrays reachable
+    static List<Payload[]> retained = new ArrayList<>();
+
+    private static void allocate() {
+        retained.clear();
+        // 64M of Payload arrays, well above the default 512K sampling interval
+        for (int i = 0; i < 64 * 1024; i++) {
+            Payload[] array = new Payload[256];
+            if (i % 4 == 0) {
+                retained.add(array);
+            }
+        }
+    }
+
+    private static long[] payloadRow(OutputAnalyzer output) {
+        for (String line : output.asLines()) {
+            Matcher m = PAYLOAD_ROW.matcher(line);
+            if (m.matches()) {
+                return new long[] { Long.parseLong(m.group(1)), Long.parseLong(m.group(2)) };
+            }
+        }
+        return null;
+    }
+
+    public void run(CommandExecutor executor) {
+        executor.execute("GC.heap_profile -reset");
+        allocate();
+
+        OutputAnalyzer output = executor.execute("GC.heap_profile -max=1000");
+        output.shouldContain("Heap profile:");
+        long[] row = payloadRow(output);
+        Asserts.assertNotNull(row, "no samples for the Payload arrays");
+        Asserts.assertGT(row[0], 0L, "no Payload samples");
+        Asserts.assertGT(row[1], 0L, "no live Payload samples");
+        Asserts.assertLTE(row[1], row[0], "more live samples than samples");
+
+        // Once the arrays are unreachable and collected, their samples are no longer live
+        retained.clear();
+        System.gc();
+        output = executor.execute("GC.heap_profile -live -max=1000");
+        Asserts.assertNull(payloadRow(output), "dead Payload arrays reported as live");
+
+        output = executor.execute("GC.heap_profile -max=1000 -reset");
+        Asserts.assertNotNull(payloadRow(output), "samples of dead Payload arrays were dropped");
+
+        output = executor.execute("GC.heap_profile -max=1000");
+        Asserts.assertNull(payloadRow(output), "samples not discarded by -reset");
+    }
+
+    private static long recorded(OutputAnalyzer output) {
+        for (String line : output.asLines()) {
+            Matcher m = RECORDED.matcher(line);
+            if (m.matches()) {
+                return Long.parseLong(m.group(1));
+            }
+        }
+        throw new RuntimeException("no profile header");
+    }
+
+    // Live samples must survive being pushed out of the ring by later allocations
+    @Test
+    public void evicted() {
+        CommandExecutor executor = new JMXExecutor();
+        executor.execute("GC.heap_profile -reset");
+        allocate();
+        long sink = 0;
+        OutputAnalyzer output;
+        do {
+            for (int i = 0; i < 4096; i++) {
+                byte[] garbage = new byte[512 * 1024];
+                sink += garbage.length;
+            }
+            output = executor.execute("GC.heap_profile -live -max=1000");
+        } while (recorded(output) < 2 * RING_CAPACITY);
+        long[] row = payloadRow(output);
+        Asserts.assertNotNull(row, "evicted live Payload arrays not reported");
+        Asserts.assertEQ(row[0], 0L, "Payload samples still in the ring");
+        Asserts.assertGT(row[1], 0L, "no live Payload samples");
+
+        // Dead samples are pruned from the live set
+        retained.clear();
+        System.gc();
+        output = executor.execute("GC.heap_profile -live -max=1000");
+        Asserts.assertNull(payloadRow(output), "dead Payload arrays reported as live");
+        System.out.println(sink);
+    }
+
+    // The same class name from two loaders is reported as two classes
+    @Test
+    public void loaders() throws Exception {
+        CommandExecutor executor = new JMXExecutor();
+        executor.execute("GC.heap_profile -reset");
+        List<Object> live = new ArrayList<>();
+        for (String name : new String[] { "first", "second" }) {
+            Class<?> c = Class.forName(Loaded.class.getName(), true, new DefiningLoader(name));
+            Asserts.assertNE(c, Loaded.class, "Loaded not defined by " + name);
+            // 256K arrays of 64K references, each is sampled
+            for (int i = 0; i < 64; i++) {
+                live.add(c.getMethod("allocate").invoke(null));
+            }
+        }
+
+        OutputAnalyzer output = executor.execute("GC.heap_profile -live -max=1000");
+        List<String> loaders = new ArrayList<>();
+        for (String line : output.asLines()) {
+            Matcher m = LOADED_ROW.matcher(line);
+            if (m.matches()) {
+                Asserts.assertGT(Long.parseLong(m.group(1)), 0L, "no live samples: " + line);
+                loaders.add(m.group(2));
+            }
+        }
+        Asserts.assertEQ(loaders.size(), 2, "expected a row per loader: " + loaders);
+        Asserts.assertTrue(loaders.get(0).contains("first") != loaders.get(1).contains("first"),
+                           "rows not split by loader: " + loaders);
+        Asserts.assertTrue(live.size() > 0);
+    }
+
+    @Test
+    public void jmx() {
+        run(new JMXExecutor());
+    }
+
+    @Test
+    public void cli() {
+        run(new PidJcmdExecutor());
+    }
+}
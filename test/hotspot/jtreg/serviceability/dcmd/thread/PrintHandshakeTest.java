@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+import org.testng.annotations.Test;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+import sun.management.HotspotRuntimeMBean;
+import sun.management.ManagementFactoryHelper;
+
+/*
+ * @test
+ * @summary Test of diagnostic command Thread.print -handshake
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management/sun.management
+ * @run testng/othervm -XX:+UnlockDiagnosticVMOptions -XX:GuaranteedSafepointInterval=0 PrintHandshakeTest
+ */
+public class PrintHandshakeTest {
+    private static final int DUMPS = 10;
+
+    private static final Object lock = new Object();
+    private static volatile boolean stop;
+
+    static void waitingMethod(CountDownLatch started) {
+        synchronized (lock) {
+            started.countDown();
+            while (!stop) {
+                try {
+                    lock.wait();
+                } catch (InterruptedException e) {
+                }
+            }
+        }
+    }
+
+    static void spinningMethod(CountDownLatch started) {
+        started.countDown();
+        long n = 0;
+        while (!stop) {
+            n++;
+        }
+    }
+
+    private static Thread start(String name, Runnable r) {
+        Thread t = new Thread(r, name);
+        t.setDaemon(true);
+        t.start();
+        return t;
+    }
+
+    public void run(CommandExecutor executor) throws Exception {
+        CountDownLatch started = new CountDownLatch(2);
+        Thread waiter = start("HandshakeDumpWaiter", () -> waitingMethod(started));
+        Thread spinner = start("HandshakeDumpSpinner", () -> spinningMethod(started));
+        started.await();
+
+        try {
+            OutputAnalyzer output = executor.execute("Thread.print -handshake");
+            output.shouldContain("Full thread dump");
+            output.shouldContain("captured per thread:");
+            // Each thread is printed with its own stack
+            output.shouldMatch("\"HandshakeDumpWaiter\" #\\d+ daemon");
+            output.shouldContain("PrintHandshakeTest.waitingMethod");
+            output.shouldMatch("\"HandshakeDumpSpinner\" #\\d+ daemon");
+            output.shouldContain("PrintHandshakeTest.spinningMethod");
+            output.shouldContain("\"main\"");
+            // Parts that need all threads stopped at once are left out
+            output.shouldNotContain("JNI global refs");
+            output.shouldNotContain("Found one Java-level deadlock");
+            output.shouldNotContain("\"VM Thread\"");
+            output.shouldNotContain("Locked ownable synchronizers");
+
+            // -l is ignored, -e still adds the extended information
+            executor.execute("Thread.print -handshake -l").shouldNotContain("Locked ownable synchronizers");
+            executor.execute("Thread.print -handshake -e").shouldMatch("allocated=\\d+");
+
+            // The regular dump is unchanged
+            output = executor.execute("Thread.print -l");
+            output.shouldContain("JNI global refs");
+            output.shouldContain("\"VM Thread\"");
+            output.shouldContain("Locked ownable synchronizers");
+            output.shouldNotContain("captured per thread:");
+
+            // Each regular dump needs two safepoints, one to print and one to
+            // look for deadlocks. The handshake dumps need none, but leave
+            // some slack for GCs and other safepoints in the meantime.
+            HotspotRuntimeMBean runtime = ManagementFactoryHelper.getHotspotRuntimeMBean();
+            long before = runtime.getSafepointCount();
+            for (int i = 0; i < DUMPS; i++) {
+                executor.execute("Thread.print");
+            }
+            long regular = runtime.getSafepointCount() - before;
+            Asserts.assertGTE(regular, 2L * DUMPS, "safepoints for regular dumps");
+
+            before = runtime.getSafepointCount();
+            for (int i = 0; i < DUMPS; i++) {
+                executor.execute("Thread.print -handshake").shouldContain("HandshakeDumpSpinner");
+            }
+            long handshake = runtime.getSafepointCount() - before;
+            Asserts.assertLT(handshake, (long)DUMPS, "safepoints for handshake dumps");
+        } finally {
+            stop = true;
+            synchronized (lock) {
+                lock.notifyAll();
+            }
+            waiter.join();
+            spinner.join();
+        }
+    }
+
+    @Test
+    public void jmx() throws Exception {
+        run(new JMXExecutor());
+    }
+}
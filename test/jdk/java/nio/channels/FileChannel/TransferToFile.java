@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/* @test
+ * @summary Test FileChannel.transferTo between two files, which uses
+ *          copy_file_range on Linux, at various positions and lengths
+ * @library /test/lib
+ * @build jdk.test.lib.RandomFactory
+ * @run main TransferToFile
+ * @key randomness
+ */
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import java.util.Random;
+import jdk.test.lib.RandomFactory;
+
+import static java.nio.file.StandardOpenOption.*;
+
+public class TransferToFile {
+    private static final Random RAND = RandomFactory.getRandom();
+
+    private static final int[] SIZES = { 0, 1, 4095, 4096, 65537, 1024 * 1024 + 17 };
+
+    public static void main(String[] args) throws Exception {
+        Path dir = Files.createTempDirectory(Path.of("."), "TransferToFile");
+        for (int size : SIZES) {
+            byte[] data = new byte[size];
+            RAND.nextBytes(data);
+            Path src = dir.resolve("src-" + size);
+            Files.write(src, data);
+
+            test(src, data, dir, 0, size, 0);
+            test(src, data, dir, 0, size + 100, 0);
+            if (size > 1) {
+                test(src, data, dir, size / 3, size / 2, 0);
+                test(src, data, dir, size - 1, 10, 7);
+                test(src, data, dir, 1, size - 2, 4096);
+            }
+            // Position beyond the end of the source file
+            test(src, data, dir, size + 1, 10, 0);
+        }
+    }
+
+    // Transfers count bytes of src from position into a new file whose
+    // position is dstPosition, and checks the result.
+    private static void test(Path src, byte[] data, Path dir,
+                             long position, long count, int dstPosition)
+        throws IOException
+    {
+        Path dst = Files.createTempFile(dir, "dst", null);
+        long expected = Math.max(0, Math.min(count, data.length - position));
+        try (FileChannel in = FileChannel.open(src, READ);
+             FileChannel out = FileChannel.open(dst, READ, WRITE)) {
+            if (dstPosition > 0) {
+                out.write(ByteBuffer.allocate(dstPosition));
+            }
+            long transferred = 0;
+            while (transferred < expected) {
+                long n = in.transferTo(position + transferred,
+                                       count - transferred, out);
+                if (n <= 0) {
+                    break;
+                }
+                transferred += n;
+            }
+            if (transferred != expected) {
+                throw new RuntimeException("transferTo(" + position + ", " + count +
+                                           ") of " + data.length + " bytes: " +
+                                           transferred + " transferred, " +
+                                           expected + " expected");
+            }
+            if (in.position() != 0) {
+                throw new RuntimeException("Source position changed to " + in.position());
+            }
+            if (out.position() != dstPosition + expected) {
+                throw new RuntimeException("Target position is " + out.position() +
+                                           ", expected " + (dstPosition + expected));
+            }
+        }
+
+        byte[] result = Files.readAllBytes(dst);
+        byte[] expectedBytes = new byte[dstPosition + (int)expected];
+        System.arraycopy(data, (int)Math.min(position, data.length),
+                         expectedBytes, dstPosition, (int)expected);
+        if (!Arrays.equals(result, expectedBytes)) {
+            throw new RuntimeException("Contents differ after transferTo(" + position +
+                                       ", " + count + ") of " + data.length + " bytes");
+        }
+        Files.delete(dst);
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Check the native CRC32 updates, including the carry-less multiply
+ *          path for large inputs, against a table driven CRC32 for all
+ *          lengths and alignments around the folding block sizes
+ * @run main/othervm TestCRC32Tails
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:-UseCRC32Intrinsics TestCRC32Tails
+ */
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+import java.util.zip.CRC32;
+
+public class TestCRC32Tails {
+    private static final int MAX_LENGTH = 1200;
+    private static final int MAX_OFFSET = 16;
+
+    private static final int[] TABLE = new int[256];
+    static {
+        for (int n = 0; n < 256; n++) {
+            int c = n;
+            for (int k = 0; k < 8; k++) {
+                c = ((c & 1) != 0) ? (0xedb88320 ^ (c >>> 1)) : (c >>> 1);
+            }
+            TABLE[n] = c;
+        }
+    }
+
+    private static long referenceCRC32(long initial, byte[] b, int off, int len) {
+        int c = ~(int)initial;
+        for (int i = off; i < off + len; i++) {
+            c = TABLE[(c ^ b[i]) & 0xff] ^ (c >>> 8);
+        }
+        return ~c & 0xffffffffL;
+    }
+
+    public static void main(String[] args) {
+        Random random = new Random(42);
+        byte[] data = new byte[MAX_OFFSET + MAX_LENGTH];
+        random.nextBytes(data);
+        ByteBuffer direct = ByteBuffer.allocateDirect(data.length);
+        direct.put(data);
+
+        for (int off = 0; off < MAX_OFFSET; off++) {
+            for (int len = 0; len <= MAX_LENGTH; len++) {
+                long expected = referenceCRC32(0, data, off, len);
+
+                CRC32 crc = new CRC32();
+                crc.update(data, off, len);
+                check(expected, crc.getValue(), "byte[]", off, len);
+
+                crc.reset();
+                crc.update(direct.duplicate().position(off).limit(off + len));
+                check(expected, crc.getValue(), "direct ByteBuffer", off, len);
+
+                // The second update continues from a non-zero crc
+                int split = len / 3;
+                crc.reset();
+                crc.update(data, off, split);
+                crc.update(data, off + split, len - split);
+                check(expected, crc.getValue(), "split byte[]", off, len);
+            }
+        }
+    }
+
+    private static void check(long expected, long actual, String kind, int off, int len) {
+        if (expected != actual) {
+            throw new RuntimeException(kind + " offset " + off + " length " + len +
+                                       ": expected " + Long.toHexString(expected) +
+                                       " but got " + Long.toHexString(actual));
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.jfr.event.runtime;
+
+import java.time.Duration;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordedFrame;
+import jdk.jfr.consumer.RecordedStackTrace;
+import jdk.jfr.consumer.RecordedThread;
+import jdk.test.lib.Asserts;
+import jdk.test.lib.jfr.Events;
+
+/**
+ * @test
+ * @summary The owner stack trace is recorded when contention on a monitor
+ *          starts, and at most once per monitor every 20 ms
+ * @key jfr
+ * @requires vm.hasJFR
+ * @library /test/lib
+ * @run main/othervm jdk.jfr.event.runtime.TestJavaMonitorContendedOwnerEvent
+ */
+public class TestJavaMonitorContendedOwnerEvent {
+
+    private static final String EVENT_NAME = "jdk.JavaMonitorContendedOwner";
+    private static final long INTERVAL_MS = 20;
+    private static final long EPISODE_DURATION_MS = 1000;
+
+    static class Lock {
+    }
+
+    static final Lock lock = new Lock();
+    static volatile boolean stop;
+
+    public static void main(String[] args) throws Throwable {
+        singleEpisode();
+        throttled();
+    }
+
+    // The owner holds the lock in holdLock() while one contender blocks
+    static void holdLock(CountDownLatch locked, CountDownLatch release) throws InterruptedException {
+        synchronized (lock) {
+            locked.countDown();
+            release.await();
+        }
+    }
+
+    static void singleEpisode() throws Throwable {
+        try (Recording recording = new Recording()) {
+            recording.enable(EVENT_NAME).withThreshold(Duration.ZERO);
+            recording.start();
+
+            CountDownLatch locked = new CountDownLatch(1);
+            CountDownLatch release = new CountDownLatch(1);
+            Thread owner = new Thread(() -> {
+                try {
+                    holdLock(locked, release);
+                } catch (InterruptedException e) {
+                    throw new RuntimeException(e);
+                }
+            }, "Owner");
+            owner.start();
+            locked.await();
+
+            Thread contender = new Thread(() -> {
+                synchronized (lock) {
+                }
+            }, "Contender");
+            contender.start();
+            while (contender.getState() != Thread.State.BLOCKED) {
+                Thread.sleep(1);
+            }
+            release.countDown();
+            owner.join();
+            contender.join();
+            recording.stop();
+
+            List<RecordedEvent> events = Events.fromRecording(recording);
+            Events.hasEvents(events);
+            RecordedEvent event = events.get(0);
+            Asserts.assertEQ(event.getClass("monitorClass").getName(), Lock.class.getName());
+            RecordedThread ownerThread = event.getValue("owner");
+            Asserts.assertEQ(ownerThread.getJavaName(), "Owner");
+            RecordedStackTrace stackTrace = event.getValue("ownerStackTrace");
+            Asserts.assertNotNull(stackTrace, "Missing owner stack trace");
+            boolean found = false;
+            for (RecordedFrame frame : stackTrace.getFrames()) {
+                if (frame.getMethod().getName().equals("holdLock")) {
+                    found = true;
+                }
+            }
+            Asserts.assertTrue(found, "holdLock() not on the owner stack: " + stackTrace);
+        }
+    }
+
+    // Two threads ping-pong the lock and start a new episode on nearly
+    // every acquisition. The number of events is bounded by the interval.
+    static void throttled() throws Throwable {
+        try (Recording recording = new Recording()) {
+            recording.enable(EVENT_NAME).withThreshold(Duration.ZERO);
+            recording.start();
+
+            Runnable contend = () -> {
+                while (!stop) {
+                    synchronized (lock) {
+                        for (int i = 0; i < 1000; i++) {
+                            Thread.onSpinWait();
+                        }
+                    }
+                }
+            };
+            Thread[] threads = new Thread[4];
+            for (int i = 0; i < threads.length; i++) {
+                threads[i] = new Thread(contend, "Contender-" + i);
+                threads[i].start();
+            }
+            long start = System.nanoTime();
+            Thread.sleep(EPISODE_DURATION_MS);
+            stop = true;
+            for (Thread t : threads) {
+                t.join();
+            }
+            long elapsedMs = (System.nanoTime() - start) / 1_000_000;
+            recording.stop();
+
+            List<RecordedEvent> events = Events.fromRecording(recording);
+            long max = elapsedMs / INTERVAL_MS + 2;
+            System.out.println(events.size() + " events in " + elapsedMs + " ms, at most " + max + " expected");
+            Asserts.assertLTE((long)events.size(), max, "Owner stack samples are not throttled");
+        }
+    }
+}
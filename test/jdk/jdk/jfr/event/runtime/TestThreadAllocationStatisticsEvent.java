@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.jfr.event.runtime;
+
+import java.time.Duration;
+import java.util.List;
+
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordedThread;
+import jdk.test.lib.Asserts;
+import jdk.test.lib.jfr.Events;
+
+/**
+ * @test
+ * @summary The TLAB figures of the ThreadAllocationStatistics event count
+ *          since thread start, and do not go back at GC
+ * @key jfr
+ * @requires vm.hasJFR
+ * @library /test/lib
+ * @run main/othervm -XX:+UseTLAB -XX:-ResizeTLAB -XX:TLABSize=32k
+ *      jdk.jfr.event.runtime.TestThreadAllocationStatisticsEvent
+ */
+public class TestThreadAllocationStatisticsEvent {
+
+    private static final String EVENT_NAME = "jdk.ThreadAllocationStatistics";
+    private static final String THREAD_NAME = "Allocator";
+    private static final int ROUNDS = 10;
+
+    static volatile Object sink;
+
+    // Small allocations refill the TLAB, and the large ones do not fit into
+    // the rest of it, which is too big to be retired.
+    static void allocate() {
+        for (int i = 0; i < 10_000; i++) {
+            sink = new byte[64];
+            if (i % 100 == 0) {
+                sink = new byte[16 * 1024];
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Throwable {
+        try (Recording recording = new Recording()) {
+            recording.enable(EVENT_NAME).withPeriod(Duration.ofMillis(50));
+            recording.start();
+
+            Thread allocator = new Thread(() -> {
+                try {
+                    for (int i = 0; i < ROUNDS; i++) {
+                        allocate();
+                        // Reset the per-GC TLAB statistics, and give
+                        // the periodic event a chance to sample.
+                        System.gc();
+                        Thread.sleep(200);
+                    }
+                } catch (InterruptedException e) {
+                    throw new RuntimeException(e);
+                }
+            }, THREAD_NAME);
+            allocator.start();
+            allocator.join();
+
+            recording.stop();
+
+            long allocated = 0;
+            long refills = 0;
+            long slowAllocations = 0;
+            long refillWaste = 0;
+            int samples = 0;
+            List<RecordedEvent> events = Events.fromRecording(recording);
+            events.sort((a, b) -> a.getEndTime().compareTo(b.getEndTime()));
+            for (RecordedEvent event : events) {
+                RecordedThread thread = event.getValue("thread");
+                if (thread == null || !THREAD_NAME.equals(thread.getJavaName())) {
+                    continue;
+                }
+                System.out.println(event);
+                long a = Events.assertField(event, "allocated").atLeast(allocated).getValue();
+                long r = Events.assertField(event, "tlabRefills").atLeast(refills).getValue();
+                long s = Events.assertField(event, "slowAllocations").atLeast(slowAllocations).getValue();
+                long w = Events.assertField(event, "tlabRefillWaste").atLeast(refillWaste).getValue();
+                allocated = a;
+                refills = r;
+                slowAllocations = s;
+                refillWaste = w;
+                samples++;
+            }
+            // Samples taken in different rounds are separated by a GC
+            Asserts.assertGreaterThan(samples, ROUNDS / 2, "too few samples for " + THREAD_NAME);
+            Asserts.assertGreaterThan(allocated, 0L, "allocated");
+            Asserts.assertGreaterThan(refills, (long)ROUNDS, "tlabRefills");
+            Asserts.assertGreaterThan(slowAllocations, 0L, "slowAllocations");
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.java.lang;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Latin1 String.indexOf(String) with a non-constant needle found at the end
+ * of the haystack. Compare the AVX2 first and last byte filtering kernel
+ * with the pcmpestri kernel by running with -XX:UseAVX=2 and -XX:UseAVX=1.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 5, time = 1, timeUnit = TimeUnit.SECONDS)
+@Measurement(iterations = 5, time = 1, timeUnit = TimeUnit.SECONDS)
+@Fork(3)
+public class StringIndexOfLatin1 {
+
+    @Param({"64", "1024", "16384"})
+    public int haystackLength;
+
+    @Param({"4", "16", "64"})
+    public int needleLength;
+
+    // The haystack repeats the needle's first byte, so that a first byte
+    // only filter has a candidate at every position.
+    private String haystack;
+    private String needle;
+    private String needleMiss;
+
+    @Setup
+    public void setup() {
+        needle = "a" + "b".repeat(needleLength - 2) + "c";
+        needleMiss = "a" + "b".repeat(needleLength - 2) + "d";
+        haystack = "a".repeat(haystackLength - needleLength) + needle;
+    }
+
+    @Benchmark
+    public int found() {
+        return haystack.indexOf(needle);
+    }
+
+    @Benchmark
+    public int notFound() {
+        return haystack.indexOf(needleMiss);
+    }
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.vm.gc;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.ref.Reference;
+import java.lang.ref.SoftReference;
+import java.lang.ref.WeakReference;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.TimeUnit;
+
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordingFile;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Measures collection pauses over reproducible synthetic heap shapes.
+ *
+ * Each shape is built once per trial and kept live while the benchmark
+ * requests collections with System.gc(). JMH reports the time per
+ * collection. In addition the pause phases recorded by the collector
+ * (the jdk.GCPhasePause and jdk.GCPhasePauseLevel1 JFR events, which are
+ * fed by G1GCPhaseTimes, ZStat and ShenandoahPhaseTimings) are summed per
+ * iteration and printed, so that a regression can be attributed to a
+ * phase.
+ *
+ * The nested classes run the benchmark with each collector.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 2, timeUnit = TimeUnit.SECONDS)
+@Measurement(iterations = 5, time = 2, timeUnit = TimeUnit.SECONDS)
+public abstract class HeapShapes {
+
+    @Param({"linkedList", "wideArray", "humongous", "refCache", "classLoaders"})
+    public String shape;
+
+    private Object root;
+    private Recording recording;
+
+    static class Node {
+        Node next;
+        long payload;
+    }
+
+    static class Leaf {
+        long payload;
+    }
+
+    // Copies of this class are defined by the loaders of the classLoaders shape.
+    static class Holder {
+        static Object[] data = new Object[16];
+    }
+
+    @Setup(Level.Trial)
+    public void buildShape() throws IOException {
+        switch (shape) {
+            case "linkedList":   root = linkedList(4_000_000);            break;
+            case "wideArray":    root = wideArray(4_000_000);             break;
+            case "humongous":    root = humongous(128, 4 * 1024 * 1024);  break;
+            case "refCache":     root = refCache(1_000_000);              break;
+            case "classLoaders": root = classLoaders(2_000);              break;
+            default: throw new IllegalArgumentException("Unknown shape: " + shape);
+        }
+    }
+
+    @TearDown(Level.Trial)
+    public void dropShape() {
+        root = null;
+    }
+
+    @Setup(Level.Iteration)
+    public void startRecording() {
+        recording = new Recording();
+        recording.enable("jdk.GCPhasePause");
+        recording.enable("jdk.GCPhasePauseLevel1");
+        recording.start();
+    }
+
+    @TearDown(Level.Iteration)
+    public void reportPhases() throws IOException {
+        recording.stop();
+        Path file = Files.createTempFile("HeapShapes", ".jfr");
+        try {
+            recording.dump(file);
+            // phase name -> { count, total nanos }
+            Map<String, long[]> phases = new TreeMap<>();
+            for (RecordedEvent e : RecordingFile.readAllEvents(file)) {
+                String name = e.getEventType().getName() + ":" + e.getString("name");
+                long[] sum = phases.computeIfAbsent(name, k -> new long[2]);
+                sum[0]++;
+                sum[1] += e.getDuration().toNanos();
+            }
+            System.out.println();
+            for (Map.Entry<String, long[]> phase : phases.entrySet()) {
+                long[] sum = phase.getValue();
+                System.out.printf("  gc phase %-60s count %6d  avg %10.3f ms%n",
+                                  phase.getKey(), sum[0], sum[1] / (sum[0] * 1e6));
+            }
+        } finally {
+            recording.close();
+            Files.deleteIfExists(file);
+        }
+    }
+
+    @Benchmark
+    public void systemGC() {
+        System.gc();
+    }
+
+    private static Node linkedList(int length) {
+        Node head = null;
+        for (int i = 0; i < length; i++) {
+            Node n = new Node();
+            n.next = head;
+            n.payload = i;
+            head = n;
+        }
+        return head;
+    }
+
+    private static Object[] wideArray(int length) {
+        Object[] array = new Object[length];
+        for (int i = 0; i < length; i++) {
+            Leaf l = new Leaf();
+            l.payload = i;
+            array[i] = l;
+        }
+        return array;
+    }
+
+    private static long[][] humongous(int count, int bytes) {
+        long[][] arrays = new long[count][];
+        for (int i = 0; i < count; i++) {
+            arrays[i] = new long[bytes / Long.BYTES];
+        }
+        return arrays;
+    }
+
+    // Soft and weak references whose referents stay strongly reachable, so
+    // that reference processing has to discover and keep all of them.
+    private static Object[] refCache(int count) {
+        Object[] referents = new Object[count];
+        Reference<?>[] refs = new Reference<?>[count];
+        for (int i = 0; i < count; i++) {
+            referents[i] = new Leaf();
+            refs[i] = (i % 2 == 0) ? new SoftReference<>(referents[i])
+                                   : new WeakReference<>(referents[i]);
+        }
+        return new Object[] { referents, refs };
+    }
+
+    private static List<Class<?>> classLoaders(int count) throws IOException {
+        String name = Holder.class.getName();
+        byte[] bytes;
+        String resource = name.substring(name.lastIndexOf('.') + 1) + ".class";
+        try (InputStream in = Holder.class.getResourceAsStream(resource)) {
+            bytes = in.readAllBytes();
+        }
+        List<Class<?>> classes = new ArrayList<>(count);
+        for (int i = 0; i < count; i++) {
+            classes.add(new HolderLoader().define(name, bytes));
+        }
+        return classes;
+    }
+
+    static class HolderLoader extends ClassLoader {
+        HolderLoader() {
+            super(HeapShapes.class.getClassLoader());
+        }
+
+        Class<?> define(String name, byte[] bytes) {
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseSerialGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Serial extends HeapShapes {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseParallelGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Parallel extends HeapShapes {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseG1GC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class G1 extends HeapShapes {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseZGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Z extends HeapShapes {}
+
+    @Fork(value = 1, jvmArgsAppend = {"-XX:+UseShenandoahGC", "-Xms2g", "-Xmx2g", "-XX:+AlwaysPreTouch"})
+    public static class Shenandoah extends HeapShapes {}
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.vm.lang;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Measures the SymbolTable lookups done while loading classes.
+ *
+ * defineClass parses the constant pool of the same class bytes into a new
+ * loader every time. All of its names and signatures are already in the
+ * SymbolTable, so the cost is dominated by lookups that hit, which is what
+ * class loading at startup mostly does. forName looks up already loaded
+ * classes by name, which goes through the SymbolTable as well.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 5, time = 1, timeUnit = TimeUnit.SECONDS)
+@Measurement(iterations = 5, time = 1, timeUnit = TimeUnit.SECONDS)
+@Fork(3)
+public class SymbolTableLookup {
+
+    // Names of loaded classes that have the same length, so that the
+    // cached length does not reject them and the hash has to.
+    private static final String[] NAMES = {
+        "java.util.ArrayList",
+        "java.util.Hashtable",
+        "java.lang.Character",
+        "java.util.Formatter",
+        "java.lang.Exception",
+        "java.lang.Throwable",
+    };
+
+    private byte[] payloadBytes;
+
+    @Setup
+    public void setup() throws IOException {
+        String resource = Payload.class.getName().replace('.', '/') + ".class";
+        try (InputStream in = Payload.class.getClassLoader().getResourceAsStream(resource)) {
+            payloadBytes = in.readAllBytes();
+        }
+    }
+
+    @Benchmark
+    public Class<?> defineClass() {
+        return new PayloadLoader().define(Payload.class.getName(), payloadBytes);
+    }
+
+    @Benchmark
+    public int forName() throws ClassNotFoundException {
+        int h = 0;
+        for (String name : NAMES) {
+            h += Class.forName(name, false, null).hashCode();
+        }
+        return h;
+    }
+
+    static class PayloadLoader extends ClassLoader {
+        PayloadLoader() {
+            super(null);
+        }
+
+        Class<?> define(String name, byte[] bytes) {
+            return defineClass(name, bytes, 0, bytes.length);
+        }
+    }
+
+    // A class with a constant pool of typical size.
+    public static class Payload {
+        private int count;
+        private long total;
+        private String name;
+        private Object[] values;
+        private java.util.Map<String, Object> properties;
+
+        public Payload(String name, int count) {
+            this.name = name;
+            this.count = count;
+            this.values = new Object[count];
+            this.properties = new java.util.HashMap<>();
+        }
+
+        public int getCount()                { return count; }
+        public long getTotal()               { return total; }
+        public String getName()              { return name; }
+        public Object[] getValues()          { return values; }
+        public void setName(String name)     { this.name = name; }
+        public void setTotal(long total)     { this.total = total; }
+
+        public Object getProperty(String key) {
+            return properties.get(key);
+        }
+
+        public void putProperty(String key, Object value) {
+            properties.put(key, value);
+        }
+
+        public void add(Object value) {
+            values[count++ % values.length] = value;
+            total += value.hashCode();
+        }
+
+        @Override
+        public String toString() {
+            return "Payload[" + name + ", " + count + ", " + total + "]";
+        }
+
+        @Override
+        public int hashCode() {
+            return java.util.Objects.hash(name, count, total);
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            return o instanceof Payload p && p.count == count && p.total == total
+                    && java.util.Objects.equals(p.name, name);
+        }
+    }
+}